@@ -119,7 +119,10 @@ define_pd_global(intx, InlineSmallCode,          1000);
   product(uint, OnSpinWaitInstCount, 1, DIAGNOSTIC,                     \
           "The number of OnSpinWaitInst instructions to generate."      \
           "It cannot be used with OnSpinWaitInst=none.")                \
-          range(1, 99)
+          range(1, 99)                                                  \
+  product(bool, IgnoreCPUFeatures, false, RESTORE_SETTABLE | EXPERIMENTAL, \
+          "Do not refuse to run after -XX:CRaCRestoreFrom finds out some " \
+          "CPU features are missing")
 
 // end of ARCH_FLAGS
 
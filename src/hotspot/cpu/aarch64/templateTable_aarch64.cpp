@@ -600,8 +600,8 @@ void TemplateTable::iload_internal(RewriteControl rc) {
 
     // if _iload, wait to rewrite to iload2.  We only want to rewrite the
     // last two iloads in a pair.  Comparing against fast_iload means that
-    // the next bytecode is neither an iload or a caload, and therefore
-    // an iload pair.
+    // the next bytecode is neither an iload, a caload nor a baload, and
+    // therefore an iload pair.
     __ cmpw(r1, Bytecodes::_iload);
     __ br(Assembler::EQ, done);
 
@@ -615,6 +615,11 @@ void TemplateTable::iload_internal(RewriteControl rc) {
     __ movw(bc, Bytecodes::_fast_icaload);
     __ br(Assembler::EQ, rewrite);
 
+    // if _baload rewrite to _fast_ibaload
+    __ cmpw(r1, Bytecodes::_baload);
+    __ movw(bc, Bytecodes::_fast_ibaload);
+    __ br(Assembler::EQ, rewrite);
+
     // else rewrite to _fast_iload
     __ movw(bc, Bytecodes::_fast_iload);
 
@@ -827,6 +832,22 @@ void TemplateTable::baload()
   __ access_load_at(T_BYTE, IN_HEAP | IS_ARRAY, r0, Address(r0, r1, Address::uxtw(0)), noreg, noreg);
 }
 
+void TemplateTable::fast_ibaload()
+{
+  transition(vtos, itos);
+  // load index out of locals
+  locals_index(r2);
+  __ ldr(r1, iaddress(r2));
+
+  __ pop_ptr(r0);
+
+  // r0: array
+  // r1: index
+  index_check(r0, r1); // leaves index in r1, kills rscratch1
+  __ add(r1, r1, arrayOopDesc::base_offset_in_bytes(T_BYTE) >> 0);
+  __ access_load_at(T_BYTE, IN_HEAP | IS_ARRAY, r0, Address(r0, r1, Address::uxtw(0)), noreg, noreg);
+}
+
 void TemplateTable::caload()
 {
   transition(itos, itos);
@@ -32,6 +32,7 @@
 #include "runtime/vm_version.hpp"
 #include "utilities/formatBuffer.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/ostream.hpp"
 
 #include OS_HEADER_INLINE(os)
 
@@ -46,6 +47,7 @@ int VM_Version::_zva_length;
 int VM_Version::_dcache_line_size;
 int VM_Version::_icache_line_size;
 int VM_Version::_initial_sve_vector_length;
+bool VM_Version::_crac_restore_missing_features;
 
 SpinWait VM_Version::_spin_wait;
 
@@ -517,6 +519,60 @@ void VM_Version::initialize() {
   UNSUPPORTED_OPTION(CriticalJNINatives);
 }
 
+// The stubs and the compiled code of the snapshot were generated for the
+// features, the SVE vector length and the DC ZVA block size of the CPU the
+// checkpoint was made on. Refuse to continue if this CPU lacks any of them.
+void VM_Version::crac_restore() {
+  assert(CRaCCheckpointTo != NULL, "");
+
+  // Set from the CPU model in initialize(), they only affect the tuning.
+  const uint64_t tuning_features = CPU_STXR_PREFETCH | CPU_A53MAC;
+  const uint64_t features_saved = _features;
+  const int zva_length_saved = _zva_length;
+
+  get_os_cpu_info();
+
+  const uint64_t features_missing = features_saved & ~_features & ~tuning_features;
+  _features |= features_saved & tuning_features;
+  _crac_restore_missing_features = false;
+
+  if (features_missing != 0) {
+    char buf[512] = "";
+#define ADD_FEATURE_IF_MISSING(id, name, bit) if (features_missing & CPU_##id) strcat(buf, ", " name);
+    CPU_FEATURE_FLAGS(ADD_FEATURE_IF_MISSING)
+#undef ADD_FEATURE_IF_MISSING
+    // +2 to skip the first ", ".
+    tty->print_cr("Specified -XX:CRaCRestoreFrom file uses CPU features missing on this CPU: %s", buf + 2);
+    _crac_restore_missing_features = true;
+  }
+
+  if (UseSVE > 0 && (_features & CPU_SVE) != 0) {
+    int vl = get_current_sve_vector_length();
+    if (vl != _initial_sve_vector_length) {
+      tty->print_cr("Specified -XX:CRaCRestoreFrom file uses SVE vector length %d while this CPU has %d",
+                    _initial_sve_vector_length, vl);
+      _crac_restore_missing_features = true;
+    }
+  }
+
+  if (UseBlockZeroing && zva_length_saved != _zva_length) {
+    tty->print_cr("Specified -XX:CRaCRestoreFrom file uses DC ZVA block size %d while this CPU has %d",
+                  zva_length_saved, _zva_length);
+    _crac_restore_missing_features = true;
+  }
+
+  if (_crac_restore_missing_features) {
+    tty->print_cr("If you are sure it will not crash you can override this check by "
+                  "-XX:+UnlockExperimentalVMOptions -XX:+IgnoreCPUFeatures .");
+  }
+}
+
+void VM_Version::crac_restore_finalize() {
+  if (_crac_restore_missing_features && !IgnoreCPUFeatures) {
+    vm_exit_during_initialization();
+  }
+}
+
 #if defined(LINUX)
 static bool check_info_file(const char* fpath,
                             const char* virt1, VirtualizationType vt1,
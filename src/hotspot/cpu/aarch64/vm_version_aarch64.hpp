@@ -46,6 +46,8 @@ protected:
   static int _icache_line_size;
   static int _initial_sve_vector_length;
 
+  static bool _crac_restore_missing_features;
+
   static SpinWait _spin_wait;
 
   // Read additional info using OS-specific interfaces
@@ -60,8 +62,8 @@ protected:
 public:
   // Initialization
   static void initialize();
-  static void crac_restore() {}
-  static void crac_restore_finalize() {}
+  static void crac_restore();
+  static void crac_restore_finalize();
   static void check_virtualizations();
 
   static void print_platform_virtualization_info(outputStream*);
@@ -1167,6 +1167,10 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
 
     __ ldr(mark, Address(sync_obj, oopDesc::mark_offset_in_bytes()));
     __ sub(disp_hdr, FP, lock_slot_fp_offset);
+    if (UseLightweightLocking) {
+      // Lightweight locking is done in the runtime
+      __ b(slow_lock);
+    }
     __ tst(mark, markWord::unlocked_value);
     __ b(fast_lock, ne);
 
@@ -1248,6 +1252,11 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
       __ sub(disp_hdr, FP, lock_slot_fp_offset);
     }
 
+    if (UseLightweightLocking) {
+      // Lightweight unlocking is done in the runtime
+      __ b(slow_unlock);
+    }
+
     // See C1_MacroAssembler::unlock_object() for more comments
     __ ldr(R2, Address(disp_hdr, BasicLock::displaced_header_offset_in_bytes()));
     __ cbz(R2, unlock_done);
@@ -636,8 +636,8 @@ void TemplateTable::iload_internal(RewriteControl rc) {
     __ ldrb(next_bytecode, at_bcp(Bytecodes::length_for(Bytecodes::_iload)));
     // if _iload, wait to rewrite to iload2.  We only want to rewrite the
     // last two iloads in a pair.  Comparing against fast_iload means that
-    // the next bytecode is neither an iload or a caload, and therefore
-    // an iload pair.
+    // the next bytecode is neither an iload, a caload nor a baload, and
+    // therefore an iload pair.
     __ cmp(next_bytecode, Bytecodes::_iload);
     __ b(done, eq);
 
@@ -650,6 +650,11 @@ void TemplateTable::iload_internal(RewriteControl rc) {
     __ mov(target_bytecode, Bytecodes::_fast_icaload);
     __ b(rewrite, eq);
 
+    // if _baload, rewrite to fast_ibaload
+    __ cmp(next_bytecode, Bytecodes::_baload);
+    __ mov(target_bytecode, Bytecodes::_fast_ibaload);
+    __ b(rewrite, eq);
+
     // rewrite so iload doesn't check again.
     __ mov(target_bytecode, Bytecodes::_fast_iload);
 
@@ -926,6 +931,26 @@ void TemplateTable::fast_icaload() {
 }
 
 
+void TemplateTable::fast_ibaload() {
+  transition(vtos, itos);
+  const Register Rlocal_index = R1_tmp;
+  const Register Rarray = R1_tmp;
+  const Register Rindex = R4_tmp; // index_check prefers index on R4
+  assert_different_registers(Rlocal_index, Rindex);
+  assert_different_registers(Rarray, Rindex);
+
+  // load index out of locals
+  locals_index(Rlocal_index);
+  Address local = load_iaddress(Rlocal_index, Rtemp);
+  __ ldr_s32(Rindex, local);
+
+  // get array element
+  index_check(Rarray, Rindex);
+  Address addr = get_array_elem_addr_same_base(T_BYTE, Rarray, Rindex, Rtemp);
+  __ access_load_at(T_BYTE, IN_HEAP | IS_ARRAY, addr, R0_tos, noreg, noreg, noreg);
+}
+
+
 void TemplateTable::saload() {
   transition(itos, itos);
   const Register Rarray = R1_tmp;
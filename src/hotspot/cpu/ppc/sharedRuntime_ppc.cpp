@@ -2162,10 +2162,12 @@ nmethod *SharedRuntime::generate_native_wrapper(MacroAssembler *masm,
     }
 #   endif // ASSERT
 
-    // Try fastpath for locking.
+    // Try fastpath for locking. Lightweight locking is done in the runtime.
     // fast_lock kills r_temp_1, r_temp_2, r_temp_3.
-    __ compiler_fast_lock_object(r_flag, r_oop, r_box, r_temp_1, r_temp_2, r_temp_3);
-    __ beq(r_flag, locked);
+    if (!UseLightweightLocking) {
+      __ compiler_fast_lock_object(r_flag, r_oop, r_box, r_temp_1, r_temp_2, r_temp_3);
+      __ beq(r_flag, locked);
+    }
 
     // None of the above fast optimizations worked so we have to get into the
     // slow case of monitor enter. Inline a special case of call_VM that
@@ -2393,9 +2395,11 @@ nmethod *SharedRuntime::generate_native_wrapper(MacroAssembler *masm,
     }
     __ addi(r_box, R1_SP, lock_offset);
 
-    // Try fastpath for unlocking.
-    __ compiler_fast_unlock_object(r_flag, r_oop, r_box, r_temp_1, r_temp_2, r_temp_3);
-    __ beq(r_flag, done);
+    // Try fastpath for unlocking. Lightweight unlocking is done in the runtime.
+    if (!UseLightweightLocking) {
+      __ compiler_fast_unlock_object(r_flag, r_oop, r_box, r_temp_1, r_temp_2, r_temp_3);
+      __ beq(r_flag, done);
+    }
 
     // Save and restore any potential method result value around the unlocking operation.
     save_native_result(masm, ret_type, workspace_slot_offset);
@@ -502,6 +502,7 @@ void TemplateTable::iload_internal(RewriteControl rc) {
 
   // Rewrite iload,iload  pair into fast_iload2
   //         iload,caload pair into fast_icaload
+  //         iload,baload pair into fast_ibaload
   if (RewriteFrequentPairs && rc == may_rewrite) {
     Label Lrewrite, Ldone;
     Register Rnext_byte  = R3_ARG1,
@@ -513,8 +514,8 @@ void TemplateTable::iload_internal(RewriteControl rc) {
 
     // if _iload, wait to rewrite to iload2. We only want to rewrite the
     // last two iloads in a pair. Comparing against fast_iload means that
-    // the next bytecode is neither an iload or a caload, and therefore
-    // an iload pair.
+    // the next bytecode is neither an iload, a caload nor a baload, and
+    // therefore an iload pair.
     __ cmpwi(CCR0, Rnext_byte, (unsigned int)(unsigned char)Bytecodes::_iload);
     __ beq(CCR0, Ldone);
 
@@ -526,6 +527,10 @@ void TemplateTable::iload_internal(RewriteControl rc) {
     __ li(Rrewrite_to, (unsigned int)(unsigned char)Bytecodes::_fast_icaload);
     __ beq(CCR0, Lrewrite);
 
+    __ cmpwi(CCR0, Rnext_byte, (unsigned int)(unsigned char)Bytecodes::_baload);
+    __ li(Rrewrite_to, (unsigned int)(unsigned char)Bytecodes::_fast_ibaload);
+    __ beq(CCR0, Lrewrite);
+
     __ li(Rrewrite_to, (unsigned int)(unsigned char)Bytecodes::_fast_iload);
 
     __ bind(Lrewrite);
@@ -727,6 +732,20 @@ void TemplateTable::fast_icaload() {
   __ lhz(R17_tos, arrayOopDesc::base_offset_in_bytes(T_CHAR), Rload_addr);
 }
 
+void TemplateTable::fast_ibaload() {
+  transition(vtos, itos);
+
+  const Register Rload_addr = R3_ARG1,
+                 Rarray     = R4_ARG2,
+                 Rtemp      = R11_scratch1;
+
+  locals_index(R17_tos);
+  __ load_local_int(R17_tos, Rtemp, R17_tos);
+  __ index_check(Rarray, R17_tos /* index */, 0, Rtemp, Rload_addr);
+  __ lbz(R17_tos, arrayOopDesc::base_offset_in_bytes(T_BYTE), Rload_addr);
+  __ extsb(R17_tos, R17_tos);
+}
+
 void TemplateTable::saload() {
   transition(itos, itos);
 
@@ -1687,6 +1687,11 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
     // Load the oop from the handle
     __ ld(obj_reg, Address(oop_handle_reg, 0));
 
+    if (UseLightweightLocking) {
+      // Lightweight locking is done in the runtime
+      __ j(slow_path_lock);
+    }
+
     if (UseBiasedLocking) {
       __ biased_locking_enter(lock_reg, obj_reg, swap_reg, tmp, false, lock_done, &slow_path_lock);
     }
@@ -1834,6 +1839,11 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
       save_native_result(masm, ret_type, stack_slots);
     }
 
+    if (UseLightweightLocking) {
+      // Lightweight unlocking is done in the runtime
+      __ j(slow_path_unlock);
+    }
+
     // get address of the stack lock
     __ la(x10, Address(sp, lock_slot_offset * VMRegImpl::stack_slot_size));
     //  get old displaced header
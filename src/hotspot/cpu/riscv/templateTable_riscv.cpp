@@ -590,8 +590,8 @@ void TemplateTable::iload_internal(RewriteControl rc) {
 
     // if _iload, wait to rewrite to iload2.  We only want to rewrite the
     // last two iloads in a pair.  Comparing against fast_iload means that
-    // the next bytecode is neither an iload or a caload, and therefore
-    // an iload pair.
+    // the next bytecode is neither an iload, a caload nor a baload, and
+    // therefore an iload pair.
     __ mv(t1, Bytecodes::_iload);
     __ beq(x11, t1, done);
 
@@ -605,6 +605,11 @@ void TemplateTable::iload_internal(RewriteControl rc) {
     __ mv(bc, Bytecodes::_fast_icaload);
     __ beq(x11, t1, rewrite);
 
+    // if _baload rewrite to _fast_ibaload
+    __ mv(t1, Bytecodes::_baload);
+    __ mv(bc, Bytecodes::_fast_ibaload);
+    __ beq(x11, t1, rewrite);
+
     // else rewrite to _fast_iload
     __ mv(bc, Bytecodes::_fast_iload);
 
@@ -851,6 +856,22 @@ void TemplateTable::fast_icaload()
   __ access_load_at(T_CHAR, IN_HEAP | IS_ARRAY, x10, Address(x10), noreg, noreg);
 }
 
+void TemplateTable::fast_ibaload()
+{
+  transition(vtos, itos);
+  // load index out of locals
+  locals_index(x12);
+  __ lw(x11, iaddress(x12, x11, _masm));
+  __ pop_ptr(x10);
+
+  // x10: array
+  // x11: index
+  index_check(x10, x11); // leaves index in x11, kills t0
+  __ add(x11, x11, arrayOopDesc::base_offset_in_bytes(T_BYTE) >> 0);
+  __ shadd(x10, x11, x10, t0, 0);
+  __ access_load_at(T_BYTE, IN_HEAP | IS_ARRAY, x10, Address(x10), noreg, noreg);
+}
+
 void TemplateTable::saload()
 {
   transition(itos, itos);
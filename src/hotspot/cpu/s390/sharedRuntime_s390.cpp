@@ -1880,10 +1880,12 @@ nmethod *SharedRuntime::generate_native_wrapper(MacroAssembler *masm,
       __ z_stg(r_box, 0, r_box);
 #endif // ASSERT
 
-    // Try fastpath for locking.
+    // Try fastpath for locking. Lightweight locking is done in the runtime.
     // Fast_lock kills r_temp_1, r_temp_2. (Don't use R1 as temp, won't work!)
-    __ compiler_fast_lock_object(r_oop, r_box, r_tmp1, r_tmp2);
-    __ z_bre(done);
+    if (!UseLightweightLocking) {
+      __ compiler_fast_lock_object(r_oop, r_box, r_tmp1, r_tmp2);
+      __ z_bre(done);
+    }
 
     //-------------------------------------------------------------------------
     // None of the above fast optimizations worked so we have to get into the
@@ -2091,9 +2093,11 @@ nmethod *SharedRuntime::generate_native_wrapper(MacroAssembler *masm,
     // ... and address of lock object box.
     __ add2reg(r_box, lock_offset, Z_SP);
 
-    // Try fastpath for unlocking.
-    __ compiler_fast_unlock_object(r_oop, r_box, r_tmp1, r_tmp2); // Don't use R1 as temp.
-    __ z_bre(done);
+    // Try fastpath for unlocking. Lightweight unlocking is done in the runtime.
+    if (!UseLightweightLocking) {
+      __ compiler_fast_unlock_object(r_oop, r_box, r_tmp1, r_tmp2); // Don't use R1 as temp.
+      __ z_bre(done);
+    }
 
     // Slow path for unlocking.
     // Save and restore any potential method result value around the unlocking operation.
@@ -652,8 +652,8 @@ void TemplateTable::iload_internal(RewriteControl rc) {
 
     // If _iload, wait to rewrite to iload2. We only want to rewrite the
     // last two iloads in a pair. Comparing against fast_iload means that
-    // the next bytecode is neither an iload or a caload, and therefore
-    // an iload pair.
+    // the next bytecode is neither an iload, a caload nor a baload, and
+    // therefore an iload pair.
     __ compareU32_and_branch(Z_R1_scratch, Bytecodes::_iload,
                              Assembler::bcondEqual, done);
 
@@ -666,6 +666,11 @@ void TemplateTable::iload_internal(RewriteControl rc) {
     __ compareU32_and_branch(Z_R1_scratch, Bytecodes::_caload,
                              Assembler::bcondEqual, rewrite);
 
+    // If _baload, rewrite to fast_ibaload.
+    __ load_const_optimized(bc, Bytecodes::_fast_ibaload);
+    __ compareU32_and_branch(Z_R1_scratch, Bytecodes::_baload,
+                             Assembler::bcondEqual, rewrite);
+
     // Rewrite so iload doesn't check again.
     __ load_const_optimized(bc, Bytecodes::_fast_iload);
 
@@ -898,6 +903,20 @@ void TemplateTable::fast_icaload() {
             Address(Z_tmp_2, Z_ARG3, arrayOopDesc::base_offset_in_bytes(T_CHAR)));
 }
 
+void TemplateTable::fast_ibaload() {
+  transition(vtos, itos);
+
+  // Load index out of locals.
+  locals_index(Z_R1_scratch);
+  __ mem2reg_opt(Z_ARG3, iaddress(_masm, Z_R1_scratch), false);
+  // Z_ARG3  : index
+  // Z_tmp_2 : array
+  __ pop_ptr(Z_tmp_2);
+  index_check(Z_tmp_2, Z_ARG3, 0);
+  __ z_lb(Z_tos,
+          Address(Z_tmp_2, Z_ARG3, arrayOopDesc::base_offset_in_bytes(T_BYTE)));
+}
+
 void TemplateTable::saload() {
   transition(itos, itos);
 
@@ -1936,6 +1936,28 @@ void C2_MacroAssembler::reduce8L(int opcode, Register dst, Register src1, XMMReg
   reduce4L(opcode, dst, src1, vtmp2, vtmp1, vtmp2);
 }
 
+void C2_MacroAssembler::reduce_minmaxL_avx(int opcode, int vlen, Register dst, Register src1, XMMRegister src2,
+                                           XMMRegister vtmp1, XMMRegister vtmp2, XMMRegister vtmp3) {
+  assert(opcode == Op_MinReductionV || opcode == Op_MaxReductionV, "sanity");
+  assert(UseAVX > 0, "required");
+  assert_different_registers(src2, vtmp1, vtmp2, vtmp3);
+  // vpminmax() compares with vpcmpgtq and selects with vblendvpd for longs
+  int minmax = (opcode == Op_MinReductionV) ? Op_MinV : Op_MaxV;
+  XMMRegister src = src2;
+  if (vlen == 4) {
+    vextracti128_high(vtmp1, src2);
+    vpminmax(minmax, T_LONG, vtmp2, vtmp1, src2, Assembler::AVX_128bit);
+    src = vtmp2;
+  } else {
+    assert(vlen == 2, "wrong vector length");
+  }
+  pshufd(vtmp1, src, 0xE);
+  vpminmax(minmax, T_LONG, vtmp3, vtmp1, src, Assembler::AVX_128bit);
+  movdq(vtmp1, src1);
+  vpminmax(minmax, T_LONG, vtmp2, vtmp1, vtmp3, Assembler::AVX_128bit);
+  movdq(dst, vtmp2);
+}
+
 void C2_MacroAssembler::genmask(KRegister dst, Register len, Register temp) {
   assert(ArrayOperationPartialInlineSize > 0 && ArrayOperationPartialInlineSize <= 64, "invalid");
   mov64(temp, -1L);
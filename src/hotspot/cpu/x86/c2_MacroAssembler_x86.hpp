@@ -158,6 +158,9 @@ public:
   void reduceI(int opcode, int vlen, Register dst, Register src1, XMMRegister src2, XMMRegister vtmp1, XMMRegister vtmp2);
 #ifdef _LP64
   void reduceL(int opcode, int vlen, Register dst, Register src1, XMMRegister src2, XMMRegister vtmp1, XMMRegister vtmp2);
+  // Long min/max reduction without vpminsq/vpmaxsq (no AVX512VL)
+  void reduce_minmaxL_avx(int opcode, int vlen, Register dst, Register src1, XMMRegister src2,
+                          XMMRegister vtmp1, XMMRegister vtmp2, XMMRegister vtmp3);
   void genmask(KRegister dst, Register len, Register temp);
 #endif // _LP64
 
@@ -1822,6 +1822,11 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
     // Load the oop from the handle
     __ movptr(obj_reg, Address(oop_handle_reg, 0));
 
+    if (UseLightweightLocking) {
+      // Lightweight locking is done in the runtime
+      __ jmp(slow_path_lock);
+    }
+
     if (UseBiasedLocking) {
       // Note that oop_handle_reg is trashed during this call
       __ biased_locking_enter(lock_reg, obj_reg, swap_reg, oop_handle_reg, noreg, false, lock_done, &slow_path_lock);
@@ -2006,6 +2011,11 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
       save_native_result(masm, ret_type, stack_slots);
     }
 
+    if (UseLightweightLocking) {
+      // Lightweight unlocking is done in the runtime
+      __ jmp(slow_path_unlock);
+    }
+
     //  get old displaced header
     __ movptr(rbx, Address(rbp, lock_slot_rbp_offset));
 
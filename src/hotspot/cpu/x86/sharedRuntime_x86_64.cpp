@@ -2071,6 +2071,11 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
     // Load the oop from the handle
     __ movptr(obj_reg, Address(oop_handle_reg, 0));
 
+    if (UseLightweightLocking) {
+      // Lightweight locking is done in the runtime
+      __ jmp(slow_path_lock);
+    }
+
     if (UseBiasedLocking) {
       __ biased_locking_enter(lock_reg, obj_reg, swap_reg, rscratch1, rscratch2, false, lock_done, &slow_path_lock);
     }
@@ -2240,6 +2245,10 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
       save_native_result(masm, ret_type, stack_slots);
     }
 
+    if (UseLightweightLocking) {
+      // Lightweight unlocking is done in the runtime
+      __ jmp(slow_path_unlock);
+    }
 
     // get address of the stack lock
     __ lea(rax, Address(rsp, lock_slot_offset * VMRegImpl::stack_slot_size));
@@ -7729,6 +7729,11 @@ address generate_avx_ghash_processBlocks() {
     char dll_name[JVM_MAXPATHLEN];
     if (os::dll_locate_lib(dll_name, sizeof(dll_name), Arguments::get_dll_dir(), "jsvml")) {
       libjsvml = os::dll_load(dll_name, ebuf, sizeof ebuf);
+      if (libjsvml == NULL) {
+        log_info(library)("Failed to load library %s: %s", dll_name, ebuf);
+      }
+    } else {
+      log_info(library)("Library " JNI_LIB_PREFIX "jsvml" JNI_LIB_SUFFIX " not found, vector math operations use scalar code");
     }
     if (libjsvml != NULL) {
       // SVML method naming convention
@@ -727,9 +727,46 @@ void TemplateInterpreterGenerator::bang_stack_shadow_pages(bool native_call) {
   const int page_size = os::vm_page_size();
   const int n_shadow_pages = ((int)StackOverflow::stack_shadow_zone_size()) / page_size;
   const int start_page = native_call ? n_shadow_pages : 1;
+
+  // The shadow zone above the watermark has been banged already, so deep
+  // recursion only bangs when it grows the stack (see StackOverflow).
+  const Register thread = NOT_LP64(rsi) LP64_ONLY(r15_thread);
+#ifndef _LP64
+  __ push(thread);
+  __ get_thread(thread);
+#endif
+  const Address safe_limit(thread, JavaThread::shadow_zone_safe_limit_offset());
+  const Address watermark(thread, JavaThread::shadow_zone_growth_watermark_offset());
+
+#ifdef ASSERT
+  Label limit_okay;
+  __ cmpptr(safe_limit, (int32_t)NULL_WORD);
+  __ jcc(Assembler::notEqual, limit_okay);
+  __ stop("shadow zone safe limit is not initialized");
+  __ bind(limit_okay);
+#endif
+
+  Label done;
+  __ cmpptr(rsp, watermark);
+  __ jcc(Assembler::above, done);
+
   for (int pages = start_page; pages <= n_shadow_pages; pages++) {
     __ bang_stack_with_offset(pages*page_size);
   }
+
+  // A native call bangs only the last page, so it does not move the
+  // watermark. Close to the guard zone every frame must bang, keep the
+  // watermark above that.
+  if (!native_call) {
+    __ cmpptr(rsp, safe_limit);
+    __ jcc(Assembler::belowEqual, done);
+    __ movptr(watermark, rsp);
+  }
+
+  __ bind(done);
+#ifndef _LP64
+  __ pop(thread);
+#endif
 }
 
 // Interpreter stub for calling a native method. (asm interpreter)
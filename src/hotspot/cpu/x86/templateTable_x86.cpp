@@ -631,8 +631,8 @@ void TemplateTable::iload_internal(RewriteControl rc) {
                           at_bcp(Bytecodes::length_for(Bytecodes::_iload)));
     // if _iload, wait to rewrite to iload2.  We only want to rewrite the
     // last two iloads in a pair.  Comparing against fast_iload means that
-    // the next bytecode is neither an iload or a caload, and therefore
-    // an iload pair.
+    // the next bytecode is neither an iload, a caload nor a baload, and
+    // therefore an iload pair.
     __ cmpl(rbx, Bytecodes::_iload);
     __ jcc(Assembler::equal, done);
 
@@ -646,6 +646,11 @@ void TemplateTable::iload_internal(RewriteControl rc) {
     __ movl(bc, Bytecodes::_fast_icaload);
     __ jccb(Assembler::equal, rewrite);
 
+    // if _baload, rewrite to fast_ibaload
+    __ cmpl(rbx, Bytecodes::_baload);
+    __ movl(bc, Bytecodes::_fast_ibaload);
+    __ jccb(Assembler::equal, rewrite);
+
     // rewrite so iload doesn't check again.
     __ movl(bc, Bytecodes::_fast_iload);
 
@@ -839,6 +844,20 @@ void TemplateTable::baload() {
                     noreg, noreg);
 }
 
+void TemplateTable::fast_ibaload() {
+  transition(vtos, itos);
+  // load index out of locals
+  locals_index(rbx);
+  __ movl(rax, iaddress(rbx));
+
+  // rax: index
+  // rdx: array
+  index_check(rdx, rax); // kills rbx
+  __ access_load_at(T_BYTE, IN_HEAP | IS_ARRAY, rax,
+                    Address(rdx, rax, Address::times_1, arrayOopDesc::base_offset_in_bytes(T_BYTE)),
+                    noreg, noreg);
+}
+
 void TemplateTable::caload() {
   transition(itos, itos);
   // rax: index
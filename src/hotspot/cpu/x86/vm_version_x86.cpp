@@ -27,12 +27,15 @@
 #include "asm/macroAssembler.hpp"
 #include "asm/macroAssembler.inline.hpp"
 #include "code/codeBlob.hpp"
+#include "code/codeCache.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/resourceArea.hpp"
+#include "runtime/deoptimization.hpp"
 #include "runtime/globals_extension.hpp"
 #include "runtime/java.hpp"
 #include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
 #include "runtime/stubCodeGenerator.hpp"
 #include "runtime/vm_version.hpp"
 #include "utilities/formatBuffer.hpp"
@@ -671,6 +674,7 @@ uint64_t VM_Version::CPUFeatures_parse(uint64_t &glibc_features) {
 
 bool VM_Version::_ignore_glibc_not_using = false;
 bool VM_Version::_crac_restore_missing_features;
+uint64_t VM_Version::_crac_restore_new_features;
 #ifdef LINUX
 const char VM_Version::glibc_prefix[] = ":glibc.cpu.hwcaps=";
 const size_t VM_Version::glibc_prefix_len = strlen(glibc_prefix);
@@ -2406,6 +2410,14 @@ void VM_Version::crac_restore() {
   // Workaround JDK-8311164: CPU_HT is set randomly on hybrid CPUs like Alder Lake.
   features_missing &= ~CPU_HT;
 
+  _crac_restore_new_features = _features & ~features_saved & ~CPU_HT;
+  if (_crac_restore_new_features != 0 && log_is_enabled(Info, crac)) {
+    char buf[512] = "";
+    insert_features_names(buf, sizeof(buf), _crac_restore_new_features & (MAX_CPU - 1));
+    // +1 to skip the first ','.
+    log_info(crac)("This CPU has features not used by the snapshot:%s", buf[0] != '\0' ? buf + 1 : "");
+  }
+
   _crac_restore_missing_features = features_missing || glibc_features_missing;
   if (_crac_restore_missing_features) {
     static const char part1[] = "You have to specify -XX:CPUFeatures=";
@@ -2442,6 +2454,36 @@ void VM_Version::crac_restore_finalize() {
   if (_crac_restore_missing_features && !IgnoreCPUFeatures) {
     vm_exit_during_initialization();
   }
+  if (CRaCUseNewCPUFeatures && _crac_restore_new_features != 0) {
+    crac_enable_new_features();
+  }
+}
+
+// Only instructions the compilers select through a flag at compile time are
+// turned on. UseSSE/UseAVX stay as they were: stubs, the interpreter and
+// the register save areas of the safepoint blobs were generated for them.
+void VM_Version::crac_enable_new_features() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be");
+  bool changed = false;
+#define ENABLE_IF_NEW(feature, flag)                                    \
+  if ((_crac_restore_new_features & (feature)) != 0 &&                  \
+      FLAG_IS_DEFAULT(flag) && !flag) {                                 \
+    log_info(crac)("Enabling " #flag " on restore");                    \
+    FLAG_SET_ERGO(flag, true);                                          \
+    changed = true;                                                     \
+  }
+  ENABLE_IF_NEW(CPU_LZCNT,  UseCountLeadingZerosInstruction)
+  ENABLE_IF_NEW(CPU_BMI1,   UseBMI1Instructions)
+  ENABLE_IF_NEW(CPU_BMI1,   UseCountTrailingZerosInstruction)
+  ENABLE_IF_NEW(CPU_BMI2,   UseBMI2Instructions)
+  ENABLE_IF_NEW(CPU_POPCNT, UsePopCountInstruction)
+#undef ENABLE_IF_NEW
+
+  if (changed) {
+    // Let the compilers regenerate code with the new instructions.
+    CodeCache::mark_all_nmethods_for_deoptimization();
+    Deoptimization::deoptimize_all_marked();
+  }
 }
 
 
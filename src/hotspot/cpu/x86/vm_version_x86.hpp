@@ -783,6 +783,9 @@ enum Extended_Family {
   // C++17: Make _ignore_glibc_not_using inline.
   static bool _ignore_glibc_not_using;
   static bool _crac_restore_missing_features;
+  // Features of the restoring CPU not present when the snapshot was made
+  static uint64_t _crac_restore_new_features;
+  static void crac_enable_new_features();
   static void nonlibc_tty_print_uint64(uint64_t num);
   static void nonlibc_tty_print_uint64_comma_uint64(uint64_t num1, uint64_t num2);
   static void print_using_features_cr();
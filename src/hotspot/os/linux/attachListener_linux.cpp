@@ -26,6 +26,7 @@
 #include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.inline.hpp"
 #include "services/attachListener.hpp"
 #include "attachListener_linux.hpp"
@@ -61,6 +62,8 @@ char LinuxAttachListener::_path[UNIX_PATH_MAX];
 bool LinuxAttachListener::_has_path;
 volatile int LinuxAttachListener::_listener = -1;
 bool LinuxAttachListener::_atexit_registered = false;
+bool LinuxAttachListener::_suspended = false;
+volatile int LinuxAttachListener::_restore_count = 0;
 LinuxAttachOperation* LinuxAttachListener::_current_op = NULL;
 
 // Supporting class to help split a buffer into individual components
@@ -285,8 +288,12 @@ LinuxAttachOperation* LinuxAttachListener::dequeue() {
     // wait for client to connect
     struct sockaddr addr;
     socklen_t len = sizeof(addr);
+    int restores = restore_count();
     RESTARTABLE(::accept(listener(), &addr, &len), s);
     if (s == -1) {
+      if (wait_for_restore(restores)) {
+        continue;       // the listener was closed for a checkpoint and is open again
+      }
       return NULL;      // log a warning?
     }
 
@@ -318,6 +325,14 @@ LinuxAttachOperation* LinuxAttachListener::dequeue() {
   }
 }
 
+bool LinuxAttachListener::wait_for_restore(int restores) {
+  MonitorLocker ml(AttachListener_lock, Mutex::_no_safepoint_check_flag);
+  while (is_suspended()) {
+    ml.wait();
+  }
+  return restore_count() != restores && listener() != -1;
+}
+
 // write the given buffer to the socket
 int LinuxAttachListener::write_fully(int s, char* buf, int len) {
   do {
@@ -520,6 +535,38 @@ void AttachListener::abort() {
   listener_cleanup();
 }
 
+// The listening socket cannot be checkpointed, so it is closed before the
+// checkpoint. Instead of exiting, the listener thread then waits for the
+// restore, which binds a new socket to the path of the restored process id,
+// so that a client attaching right after restore is served at once. The
+// state stays AL_INITIALIZING meanwhile, which makes the signal thread
+// ignore attach triggers.
+void AttachListener::before_checkpoint() {
+  if (transit_state(AL_INITIALIZING, AL_INITIALIZED) != AL_INITIALIZED) {
+    return;               // not started, the listener is created on demand after restore
+  }
+  MonitorLocker ml(AttachListener_lock, Mutex::_no_safepoint_check_flag);
+  LinuxAttachListener::set_suspended(true);
+  listener_cleanup();
+}
+
+void AttachListener::after_restore() {
+  MonitorLocker ml(AttachListener_lock, Mutex::_no_safepoint_check_flag);
+  if (!LinuxAttachListener::is_suspended()) {
+    return;
+  }
+  LinuxAttachListener::set_suspended(false);
+  if (LinuxAttachListener::init() == 0) {
+    LinuxAttachListener::inc_restore_count();
+    set_initialized();
+    log_debug(attach)("Attach listener re-opened at %s", LinuxAttachListener::path());
+  } else {
+    // The listener thread exits when it finds no socket and resets the state
+    log_debug(attach)("Failed to re-open the attach listener after restore");
+  }
+  ml.notify_all();
+}
+
 void AttachListener::pd_data_dump() {
   os::signal_notify(SIGQUIT);
 }
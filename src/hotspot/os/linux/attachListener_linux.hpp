@@ -31,6 +31,7 @@ class LinuxAttachListener;
 #if INCLUDE_SERVICES
 
 #include "linuxAttachOperation.hpp"
+#include "runtime/atomic.hpp"
 #include "services/attachListener.hpp"
 
 #include <sys/un.h>
@@ -50,6 +51,11 @@ class LinuxAttachListener: AllStatic {
 
   static bool _atexit_registered;
 
+  // set while the listener is closed for a checkpoint
+  static bool _suspended;
+  // the number of times the listener was re-opened after restore
+  static volatile int _restore_count;
+
   // this is for proper reporting JDK.Chekpoint processing to jcmd peer
   static LinuxAttachOperation* _current_op;
 
@@ -88,6 +94,15 @@ class LinuxAttachListener: AllStatic {
   // write the given buffer to a socket
   static int write_fully(int s, char* buf, int len);
 
+  static void set_suspended(bool suspended)     { _suspended = suspended; }
+  static bool is_suspended()                    { return _suspended; }
+  static int restore_count()                    { return Atomic::load(&_restore_count); }
+  static void inc_restore_count()               { Atomic::inc(&_restore_count); }
+
+  // waits while the listener is closed for a checkpoint, returns true if
+  // it was re-opened after the given restore count was read
+  static bool wait_for_restore(int restore_count);
+
   static LinuxAttachOperation* dequeue();
   static LinuxAttachOperation* get_current_op();
   static void reset_current_op();
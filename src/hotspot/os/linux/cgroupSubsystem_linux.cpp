@@ -482,10 +482,6 @@ void CgroupSubsystemFactory::cleanup(CgroupInfo* cg_infos) {
  *    number of CPUs
  */
 int CgroupSubsystem::active_processor_count() {
-  int quota_count = 0, share_count = 0;
-  int cpu_count, limit_count;
-  int result;
-
   // We use a cache with a timeout to avoid performing expensive
   // computations in the event this function is called frequently.
   // [See 8227006].
@@ -497,6 +493,25 @@ int CgroupSubsystem::active_processor_count() {
     return val;
   }
 
+  int result = compute_active_processor_count();
+
+  // Update cached metric to avoid re-reading container settings too often
+  cpu_limit->set_value(result, OSCONTAINER_CACHE_TIMEOUT);
+
+  return result;
+}
+
+int CgroupSubsystem::refresh_active_processor_count() {
+  int result = compute_active_processor_count();
+  cpu_controller()->metrics_cache()->set_value(result);
+  return result;
+}
+
+int CgroupSubsystem::compute_active_processor_count() {
+  int quota_count = 0, share_count = 0;
+  int cpu_count, limit_count;
+  int result;
+
   cpu_count = limit_count = os::Linux::active_processor_count();
   int quota  = cpu_quota();
   int period = cpu_period();
@@ -532,10 +547,6 @@ int CgroupSubsystem::active_processor_count() {
 
   result = MIN2(cpu_count, limit_count);
   log_trace(os, container)("OSContainer::active_processor_count: %d", result);
-
-  // Update cached metric to avoid re-reading container settings too often
-  cpu_limit->set_value(result, OSCONTAINER_CACHE_TIMEOUT);
-
   return result;
 }
 
@@ -554,6 +565,20 @@ jlong CgroupSubsystem::memory_limit_in_bytes() {
   if (!memory_limit->should_check_metric()) {
     return memory_limit->value();
   }
+  jlong mem_limit = compute_memory_limit_in_bytes();
+
+  // Update cached metric to avoid re-reading container settings too often
+  memory_limit->set_value(mem_limit, OSCONTAINER_CACHE_TIMEOUT);
+  return mem_limit;
+}
+
+jlong CgroupSubsystem::refresh_memory_limit_in_bytes() {
+  jlong mem_limit = compute_memory_limit_in_bytes();
+  memory_controller()->metrics_cache()->set_value(mem_limit);
+  return mem_limit;
+}
+
+jlong CgroupSubsystem::compute_memory_limit_in_bytes() {
   jlong phys_mem = os::Linux::physical_memory();
   log_trace(os, container)("total physical memory: " JLONG_FORMAT, phys_mem);
   jlong mem_limit = read_memory_limit_in_bytes();
@@ -577,9 +602,6 @@ jlong CgroupSubsystem::memory_limit_in_bytes() {
     log_debug(os, container)("container memory limit %s: " JLONG_FORMAT ", using host value " JLONG_FORMAT,
                              reason, read_mem_limit, phys_mem);
   }
-
-  // Update cached metric to avoid re-reading container settings too often
-  memory_limit->set_value(mem_limit, OSCONTAINER_CACHE_TIMEOUT);
   return mem_limit;
 }
 
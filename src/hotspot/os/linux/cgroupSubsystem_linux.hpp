@@ -234,6 +234,15 @@ class CachedMetric : public CHeapObj<mtInternal>{
       // metric config
       _next_check_counter = os::elapsed_counter() + timeout;
     }
+    // Keeps the value until invalidated, for metrics that are
+    // refreshed when the cgroup limit files change
+    void set_value(jlong value) {
+      _metric = value;
+      _next_check_counter = max_jlong;
+    }
+    void invalidate() {
+      _next_check_counter = min_jlong;
+    }
 };
 
 class CachingCgroupController : public CHeapObj<mtInternal> {
@@ -252,11 +261,19 @@ class CachingCgroupController : public CHeapObj<mtInternal> {
 };
 
 class CgroupSubsystem: public CHeapObj<mtInternal> {
+  private:
+    jlong compute_memory_limit_in_bytes();
+    int compute_active_processor_count();
+
   public:
     jlong memory_limit_in_bytes();
     int active_processor_count();
     jlong limit_from_str(char* limit_str);
 
+    // Re-read the limits and cache them until invalidated
+    jlong refresh_memory_limit_in_bytes();
+    int refresh_active_processor_count();
+
     virtual int cpu_quota() = 0;
     virtual int cpu_period() = 0;
     virtual int cpu_shares() = 0;
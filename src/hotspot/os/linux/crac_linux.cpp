@@ -33,8 +33,21 @@
 #include "logging/log.hpp"
 #include "logging/logConfiguration.hpp"
 #include "classfile/classLoader.hpp"
+#include "code/codeCache.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "memory/metaspace.hpp"
+#include "memory/universe.hpp"
+#include "runtime/nonJavaThread.hpp"
+#include "runtime/threadSMR.hpp"
+#if INCLUDE_CDS
+#include "cds/filemap.hpp"
+#endif
 
+#include <inttypes.h>
 #include <netinet/in.h>
+#include <resolv.h>
+#include <sys/mman.h>
+#include <sys/sysmacros.h>
 
 class FdsInfo {
 public:
@@ -64,6 +77,22 @@ private:
   // params are indices into _fdinfos
   bool same_fd(int i1, int i2);
 
+  struct fdkey {
+    dev_t dev;
+    ino_t ino;
+    int index;
+  };
+
+  static int compare_fdkeys(fdkey* k1, fdkey* k2) {
+    if (k1->dev != k2->dev) {
+      return k1->dev < k2->dev ? -1 : 1;
+    }
+    if (k1->ino != k2->ino) {
+      return k1->ino < k2->ino ? -1 : 1;
+    }
+    return k1->index - k2->index;
+  }
+
   bool _inited;
   GrowableArray<fdinfo> _fdinfos;
 
@@ -216,15 +245,38 @@ void FdsInfo::initialize() {
   closedir(dir);
   _inited = true;
 
+  // Only descriptors of the same file can be duplicates of each other. Sort
+  // them by file to compare each one only with the preceding descriptors of
+  // that file, instead of with all preceding descriptors.
+  GrowableArray<fdkey> keys(_fdinfos.length(), mtInternal);
   for (int i = 0; i < _fdinfos.length(); ++i) {
-    fdinfo *info = _fdinfos.adr_at(i);
-    for (int j = 0; j < i; ++j) {
-      if (get_state(j) == ROOT && same_fd(i, j)) {
-        info->state = (state_t)(DUP_OF_0 + j);
-        break;
+    fdkey key = { _fdinfos.at(i).stat.st_dev, _fdinfos.at(i).stat.st_ino, i };
+    keys.append(key);
+  }
+  keys.sort(compare_fdkeys);
+
+  for (int first = 0; first < keys.length(); ) {
+    int last = first + 1;
+    while (last < keys.length() &&
+           keys.at(last).dev == keys.at(first).dev &&
+           keys.at(last).ino == keys.at(first).ino) {
+      ++last;
+    }
+    for (int k = first + 1; k < last; ++k) {
+      int i = keys.at(k).index;
+      for (int l = first; l < k; ++l) {
+        int j = keys.at(l).index;
+        if (get_state(j) == ROOT && same_fd(i, j)) {
+          _fdinfos.adr_at(i)->state = (state_t)(DUP_OF_0 + j);
+          break;
+        }
       }
     }
+    first = last;
+  }
 
+  for (int i = 0; i < _fdinfos.length(); ++i) {
+    fdinfo *info = _fdinfos.adr_at(i);
     if (info->state == ROOT) {
       char fdpath[PATH_MAX];
       int r = readfdlink(info->fd, fdpath, sizeof(fdpath));
@@ -293,6 +345,26 @@ void VM_Crac::report_ok_to_jcmd_if_any() {
 #endif
 }
 
+static bool is_allowed_open_file(const char* path) {
+  if (CRAllowedOpenFilePrefixes == nullptr) {
+    return false;
+  }
+  const char *prefix = CRAllowedOpenFilePrefixes;
+  // JDK appends to ccstrlist using newline, on command line that would be comma
+  size_t prefix_length = strcspn(prefix, ",\n");
+  while (prefix_length > 0) {
+    if (!strncmp(path, prefix, prefix_length)) {
+      return true;
+    }
+    if (prefix[prefix_length] == '\0') {
+      break;
+    }
+    prefix += prefix_length + 1;
+    prefix_length = strcspn(prefix, ",\n");
+  }
+  return false;
+}
+
 bool VM_Crac::check_fds() {
 
   AttachListener::abort();
@@ -339,26 +411,9 @@ bool VM_Crac::check_fds() {
       }
     }
 
-    if (CRAllowedOpenFilePrefixes != nullptr) {
-      const char *prefix = CRAllowedOpenFilePrefixes;
-      // JDK appends to ccstrlist using newline, on command line that would be comma
-      size_t prefix_length = strcspn(prefix, ",\n");
-      bool matched = false;
-      while (prefix_length > 0) {
-        if (!strncmp(details, prefix, prefix_length)) {
-          matched = true;
-          break;
-        }
-        if (prefix[prefix_length] == '\0') {
-          break;
-        }
-        prefix += prefix_length + 1;
-        prefix_length = strcspn(prefix, ",\n");
-      }
-      if (matched) {
-        print_resources("OK: allowed in -XX:CRAllowedOpenFilePrefixes\n");
-        continue;
-      }
+    if (is_allowed_open_file(details)) {
+      print_resources("OK: allowed in -XX:CRAllowedOpenFilePrefixes\n");
+      continue;
     }
 
     print_resources("BAD: opened by application\n");
@@ -375,65 +430,453 @@ bool VM_Crac::check_fds() {
   return ok;
 }
 
-bool VM_Crac::memory_checkpoint() {
-  return PerfMemoryLinux::checkpoint();
+// Lists the descriptors check_fds() would find, except those the JVM closes
+// itself before the checkpoint.
+void crac::print_blocking_fds(outputStream* st, int jcmd_fd) {
+  DIR* dir = opendir("/proc/self/fd");
+  if (dir == nullptr) {
+    st->print_cr("  cannot list file descriptors: %s", os::strerror(errno));
+    return;
+  }
+  int count = 0;
+  struct dirent* dp;
+  while ((dp = readdir(dir)) != nullptr) {
+    if (dp->d_name[0] == '.') {
+      continue;
+    }
+    int fd = atoi(dp->d_name);
+    if (fd == dirfd(dir) || fd == jcmd_fd || LogConfiguration::is_fd_used(fd) ||
+        _vm_inited_fds.find_state(fd, FdsInfo::CLOSED) != FdsInfo::CLOSED) {
+      continue;
+    }
+#if INCLUDE_SERVICES
+    if (fd == LinuxAttachListener::listener()) {
+      continue;
+    }
+#endif
+    struct stat fd_st;
+    if (fstat(fd, &fd_st) != 0) {
+      continue;
+    }
+    char details[PATH_MAX];
+    const char* path = readfdlink(fd, details, sizeof(details)) > 0 ? details : "";
+    if (is_allowed_open_file(path)) {
+      continue;
+    }
+    st->print_cr("  fd=%d type=%s path=\"%s\"", fd, stat2strtype(fd_st.st_mode), path);
+    count++;
+  }
+  closedir(dir);
+  if (count == 0) {
+    st->print_cr("  none");
+  }
 }
 
-void VM_Crac::memory_restore() {
-  PerfMemoryLinux::restore();
+// What a mapping contributes to the image, by what it holds. The engine
+// writes anonymous pages, including privately modified file pages, whether
+// resident or swapped, and the contents of shared memory not backed by a
+// file. Clean file pages are mapped again from the files on restore.
+class ImageEstimate : public StackObj {
+public:
+  enum Category {
+    heap,
+    metaspace,
+    code_cache,
+    thread_stacks,
+    native,
+    mapped_files,
+    num_categories
+  };
+
+private:
+  struct StackRange {
+    address _low;
+    address _high;
+  };
+
+  static int compare_stack_ranges(StackRange* r1, StackRange* r2) {
+    return r1->_low < r2->_low ? -1 : (r1->_low > r2->_low ? 1 : 0);
+  }
+
+  GrowableArray<StackRange> _stacks;
+  size_t _bytes[num_categories];
+
+  void add_stack(Thread* t) {
+    if (t->stack_base() != nullptr && t->stack_size() > 0) {
+      StackRange r = { t->stack_end(), t->stack_base() };
+      _stacks.append(r);
+    }
+  }
+
+  bool overlaps_stack(address start, address end) const {
+    // The last stack starting below end is the only one that can overlap
+    int lo = 0;
+    int hi = _stacks.length();
+    while (lo < hi) {
+      int mid = (lo + hi) / 2;
+      if (_stacks.at(mid)._low < end) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo > 0 && _stacks.at(lo - 1)._high > start;
+  }
+
+  Category categorize(address start, address end, const char* path) const {
+    if (Universe::heap()->is_in(start) || strncmp(path, "/memfd:java_heap", 16) == 0) {
+      return heap;
+    } else if (CodeCache::contains(start)) {
+      return code_cache;
+    } else if (Metaspace::contains(start)) {
+      return metaspace;
+    } else if (overlaps_stack(start, end) || strcmp(path, "[stack]") == 0) {
+      return thread_stacks;
+    } else if (path[0] == '/' && strncmp(path, "/memfd:", 7) != 0 &&
+               strncmp(path, "/SYSV", 5) != 0 && strncmp(path, "/dev/zero", 9) != 0) {
+      return mapped_files;
+    }
+    return native;
+  }
+
+public:
+  ImageEstimate() : _stacks(64, mtInternal) {
+    for (int i = 0; i < num_categories; i++) {
+      _bytes[i] = 0;
+    }
+    for (JavaThreadIteratorWithHandle jtiwh; JavaThread* t = jtiwh.next(); ) {
+      add_stack(t);
+    }
+    for (NonJavaThread::Iterator njti; !njti.end(); njti.step()) {
+      add_stack(njti.current());
+    }
+    _stacks.sort(compare_stack_ranges);
+  }
+
+  size_t bytes(Category c) const { return _bytes[c]; }
+
+  size_t total() const {
+    size_t sum = 0;
+    for (int i = 0; i < num_categories; i++) {
+      sum += _bytes[i];
+    }
+    return sum;
+  }
+
+  bool read_smaps() {
+    FILE* smaps = os::fopen("/proc/self/smaps", "r");
+    if (smaps == nullptr) {
+      return false;
+    }
+    Category category = native;
+    bool shared_memory = false;
+    char line[JVM_MAXPATHLEN + 128];
+    while (fgets(line, sizeof(line), smaps) != nullptr) {
+      uintptr_t start, end;
+      char perms[5];
+      int path_pos = 0;
+      unsigned long kb;
+      if (sscanf(line, "%" SCNxPTR "-%" SCNxPTR " %4s %*x %*x:%*x %*u %n",
+                 &start, &end, perms, &path_pos) == 3 && path_pos > 0) {
+        char* path = line + path_pos;
+        path[strcspn(path, "\n")] = '\0';
+        category = categorize((address)start, (address)end, path);
+        shared_memory = perms[3] == 's' && category != mapped_files;
+      } else if (sscanf(line, shared_memory ? "Rss: %lu kB" : "Anonymous: %lu kB", &kb) == 1 ||
+                 sscanf(line, "Swap: %lu kB", &kb) == 1) {
+        _bytes[category] += kb * K;
+      }
+    }
+    fclose(smaps);
+    return true;
+  }
+};
+
+void crac::print_image_estimate(outputStream* st) {
+  static const char* const names[] = {
+    "Java heap",
+    "Metaspace",
+    "Code cache",
+    "Thread stacks",
+    "Malloc and other native memory",
+    "Modified pages of mapped files"
+  };
+  STATIC_ASSERT(ARRAY_SIZE(names) == ImageEstimate::num_categories);
+
+  ImageEstimate estimate;
+  if (!estimate.read_smaps()) {
+    st->print_cr("  cannot read /proc/self/smaps: %s", os::strerror(errno));
+    return;
+  }
+  for (int i = 0; i < ImageEstimate::num_categories; i++) {
+    st->print_cr("  %-32s " SIZE_FORMAT_W(10) "K", names[i], estimate.bytes((ImageEstimate::Category)i) / K);
+  }
+  st->print_cr("  %-32s " SIZE_FORMAT_W(10) "K", "Total", estimate.total() / K);
 }
 
 static char modules_path[JVM_MAXPATHLEN] = { '\0' };
 
-static bool is_fd_ignored(int fd, const char *path) {
-  const char *list = CRaCIgnoredFileDescriptors;
-  while (list && *list) {
-    const char *end = strchr(list, ',');
-    if (!end) {
-      end = list + strlen(list);
-    }
-    char *invalid;
-    int ignored_fd = strtol(list, &invalid, 10);
-    if (invalid == end) { // entry was integer -> file descriptor
-      if (fd == ignored_fd) {
-        log_trace(os)("CRaC not closing file descriptor %d (%s) as it is marked as ignored.", fd, path);
+static void init_modules_path() {
+  if (modules_path[0] == '\0') {
+    const char* fileSep = os::file_separator();
+    jio_snprintf(modules_path, JVM_MAXPATHLEN, "%s%slib%s" MODULES_IMAGE_NAME, Arguments::get_java_home(), fileSep, fileSep);
+  }
+}
+
+// Read-only files mapped by the JVM, whose pages are better left in the page
+// cache than copied into the image: lib/modules and the CDS archives.
+class ReadOnlyFiles : public StackObj {
+  static const int MAX_FILES = 3;
+  dev_t _dev[MAX_FILES];
+  ino_t _ino[MAX_FILES];
+  int _count;
+
+  void add(const char* path) {
+    struct stat st;
+    if (path != nullptr && _count < MAX_FILES && os::stat(path, &st) == 0) {
+      _dev[_count] = st.st_dev;
+      _ino[_count] = st.st_ino;
+      _count++;
+    }
+  }
+
+public:
+  ReadOnlyFiles() : _count(0) {
+    init_modules_path();
+    add(modules_path);
+#if INCLUDE_CDS
+    if (FileMapInfo::current_info() != nullptr) {
+      add(FileMapInfo::current_info()->full_path());
+    }
+    if (FileMapInfo::dynamic_info() != nullptr) {
+      add(FileMapInfo::dynamic_info()->full_path());
+    }
+#endif
+  }
+
+  bool is_empty() const { return _count == 0; }
+
+  bool contains(unsigned int dev_major, unsigned int dev_minor, ino_t ino) const {
+    for (int i = 0; i < _count; i++) {
+      if (_ino[i] == ino && major(_dev[i]) == dev_major && minor(_dev[i]) == dev_minor) {
         return true;
       }
-    } else { // interpret entry as path
-      int path_len = path ? strlen(path) : -1;
-      if (path_len != -1 && path_len == end - list && !strncmp(path, list, end - list)) {
-        log_trace(os)("CRaC not closing file descriptor %d (%s) as it is marked as ignored.", fd, path);
-        return true;
+    }
+    return false;
+  }
+};
+
+#define PM_PRESENT (1ULL << 63)
+#define PM_SWAP    (1ULL << 62)
+#define PM_FILE    (1ULL << 61)
+
+// Drops the pages of [start, end) that are clean copies of the file, so the
+// engine leaves them out of the image and they fault in from the page cache
+// after restore. Pages privately modified since mapping are kept.
+class FilePagesDropper : public StackObj {
+  address _run_start;
+  size_t _run_present;
+  size_t _dropped;
+
+public:
+  FilePagesDropper() : _run_start(nullptr), _run_present(0), _dropped(0) {}
+
+  size_t dropped() const { return _dropped; }
+
+  void extend(address p, bool present) {
+    if (_run_start == nullptr) {
+      _run_start = p;
+    }
+    if (present) {
+      _run_present++;
+    }
+  }
+
+  void flush(address p) {
+    if (_run_start != nullptr && _run_present > 0 &&
+        ::madvise(_run_start, p - _run_start, MADV_DONTNEED) == 0) {
+      _dropped += _run_present * os::vm_page_size();
+    }
+    _run_start = nullptr;
+    _run_present = 0;
+  }
+
+  void drop(int pagemap_fd, address start, address end) {
+    const size_t page = os::vm_page_size();
+    const size_t batch = 512;
+    uint64_t entries[batch];
+
+    address a = start;
+    while (a < end) {
+      size_t n = MIN2(batch, (size_t)(end - a) / page);
+      off_t off = (off_t)((uintptr_t)a / page * sizeof(uint64_t));
+      if (pread(pagemap_fd, entries, n * sizeof(uint64_t), off) != (ssize_t)(n * sizeof(uint64_t))) {
+        break;
+      }
+      for (size_t i = 0; i < n; i++, a += page) {
+        bool anon = (entries[i] & PM_SWAP) || ((entries[i] & PM_PRESENT) && !(entries[i] & PM_FILE));
+        if (anon) {
+          flush(a);
+        } else {
+          extend(a, (entries[i] & PM_PRESENT) != 0);
+        }
       }
     }
-    if (*end) {
-      list = end + 1;
-    } else {
-      break;
+    flush(a);
+  }
+};
+
+static void drop_read_only_file_pages() {
+  ReadOnlyFiles files;
+  if (files.is_empty()) {
+    return;
+  }
+  FILE* maps = os::fopen("/proc/self/maps", "r");
+  if (maps == nullptr) {
+    return;
+  }
+  int pagemap_fd = os::open("/proc/self/pagemap", O_RDONLY, 0);
+  if (pagemap_fd < 0) {
+    fclose(maps);
+    return;
+  }
+
+  FilePagesDropper dropper;
+  char line[JVM_MAXPATHLEN + 128];
+  while (fgets(line, sizeof(line), maps) != nullptr) {
+    uintptr_t start, end;
+    char perms[5];
+    unsigned int dev_major, dev_minor;
+    unsigned long ino;
+    if (sscanf(line, "%" SCNxPTR "-%" SCNxPTR " %4s %*x %x:%x %lu",
+               &start, &end, perms, &dev_major, &dev_minor, &ino) != 6) {
+      continue;
+    }
+    // Only private read-only mappings: writes to shared ones reach the file
+    // anyway, and writable ones may be modified concurrently
+    if (perms[1] != '-' || perms[3] != 'p' || !files.contains(dev_major, dev_minor, (ino_t)ino)) {
+      continue;
     }
+    dropper.drop(pagemap_fd, (address)start, (address)end);
   }
 
-  if (os::same_files(modules_path, path)) {
-    // Path to the modules directory is opened early when JVM is booted up and won't be closed.
-    // We can ignore this for purposes of CRaC.
-    return true;
+  ::close(pagemap_fd);
+  fclose(maps);
+  log_info(crac)("Left " SIZE_FORMAT "K of read-only file mappings to the page cache", dropper.dropped() / K);
+}
+
+bool VM_Crac::memory_checkpoint() {
+  if (CRaCShareReadOnlyFiles) {
+    drop_read_only_file_pages();
   }
+  return PerfMemoryLinux::checkpoint();
+}
 
-  if (LogConfiguration::is_fd_used(fd)) {
-    return true;
+void VM_Crac::memory_restore() {
+  PerfMemoryLinux::restore();
+}
+
+void VM_Crac::host_restore() {
+  // The resolver configuration is that of the checkpointing host. glibc
+  // reloads it only when resolv.conf looks changed, which a file bind
+  // mounted by a container runtime may not. res_init makes every thread
+  // reload it on its next lookup.
+  if (res_init() != 0) {
+    log_warning(crac)("Failed to reload the resolver configuration");
   }
+}
 
-  return false;
+static int compare_ints(const int& a, const int& b) {
+  return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+static int compare_int_ptrs(int* a, int* b) {
+  return compare_ints(*a, *b);
+}
+
+static int compare_strs(const char* const& a, const char* const& b) {
+  return strcmp(a, b);
+}
+
+static int compare_str_ptrs(const char** a, const char** b) {
+  return strcmp(*a, *b);
 }
 
+// CRaCIgnoredFileDescriptors parsed once into sorted descriptor numbers and
+// paths, rather than for each descriptor found open.
+class IgnoredFds : public StackObj {
+  GrowableArray<int> _fds;
+  GrowableArray<const char*> _paths;
+  struct stat _modules_stat;
+  bool _has_modules_stat;
+
+public:
+  IgnoredFds() : _fds(16, mtInternal), _paths(16, mtInternal), _has_modules_stat(false) {
+    const char *list = CRaCIgnoredFileDescriptors;
+    while (list && *list) {
+      const char *end = strchr(list, ',');
+      if (!end) {
+        end = list + strlen(list);
+      }
+      char *invalid;
+      int ignored_fd = strtol(list, &invalid, 10);
+      if (invalid == end) { // entry was integer -> file descriptor
+        _fds.append(ignored_fd);
+      } else { // interpret entry as path
+        char* path = NEW_C_HEAP_ARRAY(char, end - list + 1, mtInternal);
+        strncpy(path, list, end - list);
+        path[end - list] = '\0';
+        _paths.append(path);
+      }
+      if (*end) {
+        list = end + 1;
+      } else {
+        break;
+      }
+    }
+    _fds.sort(compare_int_ptrs);
+    _paths.sort(compare_str_ptrs);
+    _has_modules_stat = os::stat(modules_path, &_modules_stat) == 0;
+  }
+
+  ~IgnoredFds() {
+    for (int i = 0; i < _paths.length(); ++i) {
+      FREE_C_HEAP_ARRAY(char, _paths.at(i));
+    }
+  }
+
+  bool is_ignored(int fd, const char *path) {
+    bool found;
+    _fds.find_sorted<int, compare_ints>(fd, found);
+    if (!found && path != nullptr) {
+      _paths.find_sorted<const char*, compare_strs>(path, found);
+    }
+    if (found) {
+      log_trace(os)("CRaC not closing file descriptor %d (%s) as it is marked as ignored.", fd, path);
+      return true;
+    }
+
+    struct stat st;
+    if (path != nullptr && _has_modules_stat && fstat(fd, &st) == 0 && same_stat(&st, &_modules_stat)) {
+      // Path to the modules directory is opened early when JVM is booted up and won't be closed.
+      // We can ignore this for purposes of CRaC.
+      return true;
+    }
+
+    if (LogConfiguration::is_fd_used(fd)) {
+      return true;
+    }
+
+    return false;
+  }
+};
+
 static void close_extra_descriptors() {
   // Path to the modules directory is opened early when JVM is booted up and won't be closed.
   // We can ignore this for purposes of CRaC.
-  if (modules_path[0] == '\0') {
-    const char* fileSep = os::file_separator();
-    jio_snprintf(modules_path, JVM_MAXPATHLEN, "%s%slib%s" MODULES_IMAGE_NAME, Arguments::get_java_home(), fileSep, fileSep);
-  }
+  init_modules_path();
 
+  IgnoredFds ignored;
   char path[PATH_MAX];
   struct dirent *dp;
 
@@ -442,7 +885,7 @@ static void close_extra_descriptors() {
     int fd = atoi(dp->d_name);
     if (fd > 2 && fd != dirfd(dir)) {
       int r = readfdlink(fd, path, sizeof(path));
-      if (!is_fd_ignored(fd, r != -1 ? path : nullptr)) {
+      if (!ignored.is_ignored(fd, r != -1 ? path : nullptr)) {
         log_warning(os)("CRaC closing file descriptor %d: %s", fd, path);
         close(fd);
       }
@@ -68,6 +68,32 @@
           " of quotas (if set), when true. Otherwise, use the CPU"      \
           " shares value, provided it is less than quota.")             \
                                                                         \
+  product(bool, UseContainerLimitsWatcher, false,                       \
+          "Watch the cgroup limit files from a background thread, which" \
+          " keeps the cached container limits, SoftMaxHeapSize and the" \
+          " active GC worker limit up to date")                         \
+                                                                        \
+  product(uint, ContainerLimitsWatcherInterval, 1000,                   \
+          "Milliseconds between re-reads of the cgroup limits by the"   \
+          " watcher, for changes that raise no file event (e.g. made"   \
+          " from another cgroup namespace)")                            \
+          range(1, max_jint)                                            \
+                                                                        \
+  product(bool, UseMemoryPressureUncommit, false,                       \
+          "Return unused Java heap and C heap memory to the OS when the" \
+          " memory pressure (PSI) of the container or of the host"      \
+          " exceeds MemoryPressureStallThreshold, or when the container" \
+          " reaches its memory.high or memory.max limit")               \
+                                                                        \
+  product(uint, MemoryPressureStallThreshold, 200,                      \
+          "Milliseconds some tasks may stall on memory within a 2"      \
+          " second window before UseMemoryPressureUncommit frees memory") \
+          range(1, 2000)                                                \
+                                                                        \
+  product(uint, MemoryPressureUncommitInterval, 10000,                  \
+          "Minimum milliseconds between two memory pressure reactions") \
+          range(0, max_jint)                                            \
+                                                                        \
   product(bool, AdjustStackSizeForTLS, false,                           \
           "Increase the thread stack size to include space for glibc "  \
           "static thread-local storage (TLS) if true")                  \
@@ -107,6 +133,14 @@
           "thread stacks. When disabled, the absence of this mitigation"\
           "allows THPs to form in thread stacks.")                      \
                                                                         \
+  product(int, NativeThreadPoolSize, 0, EXPERIMENTAL,                   \
+          "Maximum number of native threads kept parked after their "   \
+          "Java thread terminated, so that a new Java thread with the " \
+          "same stack size is started on an already mapped stack "      \
+          "instead of a new pthread. A reused native thread keeps the " \
+          "CPU time it accumulated before. 0 disables the pool.")       \
+          range(0, 1024)                                                \
+                                                                        \
   develop(bool, DelayThreadStartALot, false,                            \
           "Artificially delay thread starts randomly for testing.")     \
                                                                         \
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "jvm_io.h"
+#include "logging/log.hpp"
+#include "memory/universe.hpp"
+#include "memoryPressure_linux.hpp"
+#include "osContainer_linux.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/nonJavaThread.hpp"
+#include "runtime/os.inline.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+// Waits for memory pressure and answers it by uncommitting the free parts
+// of the Java heap and trimming the C heap, rather than keeping the peak
+// footprint until the OOM killer steps in. Pressure is reported by a PSI
+// trigger, on the memory.pressure of the cgroup v2 of the process or else
+// on /proc/pressure/memory, and by the high and max counters of the cgroup
+// v2 memory.events, which grow when the container hits its limits.
+class MemoryPressureMonitorThread : public NamedThread {
+  // Unprivileged PSI triggers need a window that is a multiple of 2s
+  static const uint psi_window_us = 2 * 1000 * 1000;
+
+  Monitor* const _lock;
+  bool _suspended;
+  int _psi_fd;
+  int _events_fd;
+  // Closing the write end wakes up the thread when it is suspended
+  int _wakeup_fds[2];
+
+  jlong _events;
+  jlong _last_uncommit;
+  uint64_t _num_uncommits;
+
+  static int open_psi_trigger(const char* path) {
+    int fd = ::open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+      return -1;
+    }
+    char trigger[64];
+    jio_snprintf(trigger, sizeof(trigger), "some %u %u", MemoryPressureStallThreshold * 1000, psi_window_us);
+    if (::write(fd, trigger, strlen(trigger) + 1) < 0) {
+      log_debug(os)("Cannot set a memory pressure trigger on %s: %s", path, os::strerror(errno));
+      ::close(fd);
+      return -1;
+    }
+    log_debug(os)("Memory pressure trigger \"%s\" set on %s", trigger, path);
+    return fd;
+  }
+
+  // Sum of the high and max counters, or -1
+  static jlong read_events(int fd) {
+    char buf[512];
+    // Reading from the start also re-arms the notification
+    ssize_t len = ::pread(fd, buf, sizeof(buf) - 1, 0);
+    if (len <= 0) {
+      return -1;
+    }
+    buf[len] = '\0';
+    jlong events = 0;
+    for (char* line = buf; line != NULL && *line != '\0'; ) {
+      julong count;
+      if (sscanf(line, "high " JULONG_FORMAT, &count) == 1 ||
+          sscanf(line, "max " JULONG_FORMAT, &count) == 1) {
+        events += (jlong)count;
+      }
+      line = strchr(line, '\n');
+      if (line != NULL) {
+        line++;
+      }
+    }
+    return events;
+  }
+
+  void open_files() {
+    assert(_lock->owned_by_self(), "Must be");
+    if (OSContainer::is_containerized() && strcmp(OSContainer::container_type(), "cgroupv2") == 0 &&
+        OSContainer::memory_controller_path() != NULL) {
+      char path[JVM_MAXPATHLEN];
+      jio_snprintf(path, sizeof(path), "%s/memory.pressure", OSContainer::memory_controller_path());
+      _psi_fd = open_psi_trigger(path);
+      jio_snprintf(path, sizeof(path), "%s/memory.events", OSContainer::memory_controller_path());
+      _events_fd = ::open(path, O_RDONLY | O_CLOEXEC);
+      if (_events_fd >= 0) {
+        _events = read_events(_events_fd);
+      }
+    }
+    if (_psi_fd < 0) {
+      _psi_fd = open_psi_trigger("/proc/pressure/memory");
+    }
+    if (::pipe2(_wakeup_fds, O_CLOEXEC) != 0) {
+      _wakeup_fds[0] = _wakeup_fds[1] = -1;
+    }
+  }
+
+  static void close_fd(int* fd) {
+    if (*fd >= 0) {
+      ::close(*fd);
+      *fd = -1;
+    }
+  }
+
+  void close_files() {
+    assert(_lock->owned_by_self(), "Must be");
+    close_fd(&_wakeup_fds[1]);
+    close_fd(&_wakeup_fds[0]);
+    close_fd(&_psi_fd);
+    close_fd(&_events_fd);
+  }
+
+  void uncommit() {
+    const jlong now = os::javaTimeNanos();
+    if (_num_uncommits > 0 &&
+        now - _last_uncommit < (jlong)MemoryPressureUncommitInterval * NANOSECS_PER_MILLISEC) {
+      log_debug(os)("Memory pressure, last uncommit " JLONG_FORMAT " ms ago",
+                    nanos_to_millis(now - _last_uncommit));
+      return;
+    }
+    _last_uncommit = now;
+    _num_uncommits++;
+
+    const size_t capacity_before = Universe::heap()->capacity();
+    Universe::heap()->uncommit_unused_memory();
+    // Without the size change, as reading it opens files the checkpoint may see
+    const bool trimmed = os::can_trim_native_heap() && os::trim_native_heap(NULL);
+    const size_t capacity_after = Universe::heap()->capacity();
+    log_info(os)("Memory pressure (" UINT64_FORMAT "): heap " SIZE_FORMAT "M->" SIZE_FORMAT "M%s",
+                 _num_uncommits, capacity_before / M, capacity_after / M,
+                 trimmed ? ", native heap trimmed" : "");
+  }
+
+  void run() override {
+    while (true) {
+      struct pollfd fds[3];
+      {
+        MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+        while (_suspended) {
+          ml.wait(0);
+        }
+        fds[0] = { _psi_fd, POLLPRI, 0 };
+        fds[1] = { _events_fd, POLLPRI, 0 };
+        fds[2] = { _wakeup_fds[0], POLLIN, 0 };
+      }
+
+      // The descriptors may be closed by a checkpoint while we wait on them
+      if (::poll(fds, 3, -1) <= 0) {
+        continue;
+      }
+
+      bool pressure = false;
+      {
+        MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+        if (_suspended) {
+          continue;
+        }
+        if (fds[0].fd == _psi_fd && (fds[0].revents & POLLPRI) != 0) {
+          pressure = true;
+        }
+        if (fds[1].fd == _events_fd && (fds[1].revents & POLLPRI) != 0) {
+          jlong events = read_events(_events_fd);
+          pressure |= _events >= 0 && events > _events;
+          _events = events;
+        }
+        if (fds[0].fd == _psi_fd && (fds[0].revents & POLLERR) != 0) {
+          // The cgroup is gone
+          log_info(os)("Memory pressure trigger lost");
+          close_fd(&_psi_fd);
+        }
+      }
+      if (pressure) {
+        uncommit();
+      }
+    }
+  }
+
+public:
+  MemoryPressureMonitorThread() :
+    _lock(new (std::nothrow) PaddedMonitor(Mutex::leaf, "MemoryPressureMonitor_lock", true, Mutex::_safepoint_check_never)),
+    _suspended(false),
+    _psi_fd(-1),
+    _events_fd(-1),
+    _events(-1),
+    _last_uncommit(0),
+    _num_uncommits(0)
+  {
+    _wakeup_fds[0] = _wakeup_fds[1] = -1;
+    set_name("Memory Pressure Monitor");
+  }
+
+  // Returns false if the kernel reports no memory pressure to us
+  bool open() {
+    MutexLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    open_files();
+    if (_psi_fd < 0 && _events_fd < 0) {
+      close_files();
+      return false;
+    }
+    return true;
+  }
+
+  // The checkpoint cannot keep the descriptors. An uncommit in progress
+  // is not waited for, it may be queued behind the checkpoint.
+  void suspend() {
+    MutexLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    assert(!_suspended, "Must be");
+    _suspended = true;
+    close_files();
+  }
+
+  void resume() {
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    assert(_suspended, "Must be");
+    open_files();
+    _suspended = false;
+    ml.notify_all();
+  }
+};
+
+static MemoryPressureMonitorThread* _monitor = NULL;
+
+void MemoryPressureMonitor::initialize() {
+  assert(_monitor == NULL, "Only once");
+  if (!UseMemoryPressureUncommit) {
+    return;
+  }
+  MemoryPressureMonitorThread* monitor = new MemoryPressureMonitorThread();
+  if (!monitor->open()) {
+    log_warning(os)("Memory pressure information is not available, UseMemoryPressureUncommit is ignored");
+    return;
+  }
+  if (!os::create_thread(monitor, os::vm_thread)) {
+    log_warning(os)("Failed to start the memory pressure monitor");
+    return;
+  }
+  os::start_thread(monitor);
+  _monitor = monitor;
+}
+
+void MemoryPressureMonitor::before_checkpoint() {
+  if (_monitor != NULL) {
+    _monitor->suspend();
+  }
+}
+
+void MemoryPressureMonitor::after_restore() {
+  if (_monitor != NULL) {
+    _monitor->resume();
+  }
+}
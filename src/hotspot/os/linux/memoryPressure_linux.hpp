@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef OS_LINUX_MEMORYPRESSURE_LINUX_HPP
+#define OS_LINUX_MEMORYPRESSURE_LINUX_HPP
+
+#include "memory/allocation.hpp"
+
+// Returns unused memory to the OS when the container or the host of the
+// process runs short of it (see UseMemoryPressureUncommit).
+class MemoryPressureMonitor : AllStatic {
+public:
+  static void initialize();
+  static void before_checkpoint();
+  static void after_restore();
+};
+
+#endif // OS_LINUX_MEMORYPRESSURE_LINUX_HPP
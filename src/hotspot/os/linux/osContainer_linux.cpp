@@ -25,7 +25,15 @@
 #include <string.h>
 #include <math.h>
 #include <errno.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include "gc/shared/gcArguments.hpp"
+#include "gc/shared/workerPolicy.hpp"
 #include "runtime/globals.hpp"
+#include "runtime/globals_extension.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/nonJavaThread.hpp"
 #include "runtime/os.hpp"
 #include "logging/log.hpp"
 #include "osContainer_linux.hpp"
@@ -66,6 +74,11 @@ const char * OSContainer::container_type() {
   return cgroup_subsystem->container_type();
 }
 
+const char * OSContainer::memory_controller_path() {
+  assert(cgroup_subsystem != NULL, "cgroup subsystem not available");
+  return cgroup_subsystem->memory_controller()->controller()->subsystem_path();
+}
+
 jlong OSContainer::memory_limit_in_bytes() {
   assert(cgroup_subsystem != NULL, "cgroup subsystem not available");
   return cgroup_subsystem->memory_limit_in_bytes();
@@ -158,3 +171,187 @@ void OSContainer::print_container_helper(outputStream* st, jlong j, const char*
     st->print_cr("%s", j == OSCONTAINER_ERROR ? "not supported" : "unlimited");
   }
 }
+
+// Refreshes the cached memory limit and processor count when the cgroup
+// limit files change, so that callers never have to read them, and lets
+// the GC follow the new limits. Writes from another cgroup namespace (e.g.
+// by the container engine) raise no event on our mount of the files, so
+// they are also re-read every ContainerLimitsWatcherInterval.
+class CgroupLimitsWatcher : public NamedThread {
+  Monitor* const _lock;
+  // The inotify instance, -1 while suspended or if it could not be set up
+  int _fd;
+  bool _suspended;
+  // Reading the limits, which must not happen during a checkpoint
+  bool _busy;
+
+  jlong _memory_limit;
+  int _processor_count;
+
+  void add_watch(int fd, CachingCgroupController* contrl) {
+    const char* path = contrl->controller()->subsystem_path();
+    if (path != NULL && inotify_add_watch(fd, path, IN_MODIFY) < 0) {
+      log_debug(os, container)("Cannot watch %s: %s", path, os::strerror(errno));
+    }
+  }
+
+  void open_watches() {
+    assert(_lock->owned_by_self(), "Must be");
+    _fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_fd < 0) {
+      log_info(os, container)("Cannot watch the cgroup limits, re-reading them every %u ms: %s",
+                              ContainerLimitsWatcherInterval, os::strerror(errno));
+      return;
+    }
+    // A memory and cpu controller sharing the cgroup v2 directory get a single watch
+    add_watch(_fd, cgroup_subsystem->memory_controller());
+    add_watch(_fd, cgroup_subsystem->cpu_controller());
+  }
+
+  void close_watches() {
+    assert(_lock->owned_by_self(), "Must be");
+    if (_fd >= 0) {
+      ::close(_fd);
+      _fd = -1;
+    }
+  }
+
+  void drain(int fd) {
+    char buf[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    while (::read(fd, buf, sizeof(buf)) > 0) {}
+  }
+
+  void refresh() {
+    jlong memory_limit = cgroup_subsystem->refresh_memory_limit_in_bytes();
+    int processor_count = cgroup_subsystem->refresh_active_processor_count();
+    if (memory_limit != _memory_limit) {
+      log_info(os, container)("Container memory limit changed: " JLONG_FORMAT " -> " JLONG_FORMAT,
+                              _memory_limit, memory_limit);
+      _memory_limit = memory_limit;
+      memory_limit_changed();
+    }
+    if (processor_count != _processor_count) {
+      log_info(os, container)("Container processor count changed: %d -> %d",
+                              _processor_count, processor_count);
+      _processor_count = processor_count;
+      WorkerPolicy::set_active_workers_limit((uint)processor_count);
+    }
+  }
+
+  // ZGC and Shenandoah follow SoftMaxHeapSize, the other collectors keep
+  // the heap they have.
+  void memory_limit_changed() {
+    if (FLAG_IS_CMDLINE(SoftMaxHeapSize)) {
+      return;
+    }
+    size_t soft_max = GCArguments::soft_max_heap_size_for(os::physical_memory());
+    if (soft_max != SoftMaxHeapSize) {
+      log_info(os, container)("SoftMaxHeapSize " SIZE_FORMAT "M -> " SIZE_FORMAT "M",
+                              SoftMaxHeapSize / M, soft_max / M);
+      FLAG_SET_ERGO(SoftMaxHeapSize, soft_max);
+    }
+  }
+
+  void run() override {
+    // The limits the VM started with need no update
+    _memory_limit = cgroup_subsystem->refresh_memory_limit_in_bytes();
+    _processor_count = cgroup_subsystem->refresh_active_processor_count();
+
+    while (true) {
+      int fd;
+      bool resumed = false;
+      {
+        MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+        _busy = false;
+        ml.notify_all();
+        while (_suspended) {
+          ml.wait(0);
+          resumed = true;
+        }
+        // The limits may be different after restore
+        _busy = resumed;
+        fd = _fd;
+      }
+
+      if (!resumed) {
+        // The descriptor may be closed by a checkpoint while we wait on it
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        int ret = ::poll(&pfd, 1, (int)ContainerLimitsWatcherInterval);
+
+        MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+        if (_suspended) {
+          continue;
+        }
+        if (ret > 0 && fd == _fd) {
+          drain(fd);
+        }
+        _busy = true;
+      }
+      refresh();
+    }
+  }
+
+public:
+  CgroupLimitsWatcher() :
+    _lock(new (std::nothrow) PaddedMonitor(Mutex::leaf, "CgroupLimitsWatcher_lock", true, Mutex::_safepoint_check_never)),
+    _fd(-1),
+    _suspended(false),
+    _busy(true),
+    _memory_limit(-1),
+    _processor_count(0)
+  {
+    set_name("Cgroup Limits Watcher");
+    MutexLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    open_watches();
+  }
+
+  // Closes the inotify instance, which the checkpoint cannot keep, and
+  // waits for a refresh in progress to finish reading the cgroup files.
+  void suspend() {
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    _suspended = true;
+    close_watches();
+    while (_busy) {
+      ml.wait(0);
+    }
+  }
+
+  void resume() {
+    MonitorLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    assert(_suspended, "Must be");
+    open_watches();
+    _suspended = false;
+    ml.notify_all();
+  }
+};
+
+static CgroupLimitsWatcher* _watcher = NULL;
+
+void OSContainer::init_watcher() {
+  assert(_watcher == NULL, "Only once");
+  if (!UseContainerLimitsWatcher || !is_containerized()) {
+    return;
+  }
+  CgroupLimitsWatcher* watcher = new CgroupLimitsWatcher();
+  if (!os::create_thread(watcher, os::vm_thread)) {
+    log_warning(os, container)("Failed to start the cgroup limits watcher");
+    return;
+  }
+  os::start_thread(watcher);
+  _watcher = watcher;
+}
+
+void OSContainer::before_checkpoint() {
+  if (_watcher != NULL) {
+    _watcher->suspend();
+    // Until the watcher resumes, read the limits as without it
+    cgroup_subsystem->memory_controller()->metrics_cache()->invalidate();
+    cgroup_subsystem->cpu_controller()->metrics_cache()->invalidate();
+  }
+}
+
+void OSContainer::after_restore() {
+  if (_watcher != NULL) {
+    _watcher->resume();
+  }
+}
@@ -44,11 +44,16 @@ class OSContainer: AllStatic {
 
  public:
   static void init();
+  // Starts the thread that refreshes the cached limits on cgroup changes
+  static void init_watcher();
+  static void before_checkpoint();
+  static void after_restore();
   static void print_version_specific_info(outputStream* st);
   static void print_container_helper(outputStream* st, jlong j, const char* metrics);
 
   static inline bool is_containerized();
   static const char * container_type();
+  static const char * memory_controller_path();
 
   static jlong memory_limit_in_bytes();
   static jlong memory_and_swap_limit_in_bytes();
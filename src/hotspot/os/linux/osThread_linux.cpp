@@ -37,6 +37,7 @@ void OSThread::pd_initialize() {
   _ucontext = NULL;
   _expanding_stack = 0;
   _alt_sig_stack = NULL;
+  _stack_size = 0;
 
   sigemptyset(&_caller_sigmask);
 
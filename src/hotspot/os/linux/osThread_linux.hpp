@@ -45,8 +45,13 @@
 
   sigset_t _caller_sigmask; // Caller's signal mask
 
+  size_t _stack_size;       // Stack size the pthread was created with
+
  public:
 
+  size_t stack_size() const              { return _stack_size; }
+  void   set_stack_size(size_t size)     { _stack_size = size; }
+
   // Methods to save/restore caller's signal mask
   sigset_t  caller_sigmask() const       { return _caller_sigmask; }
   void    set_caller_sigmask(sigset_t sigmask)  { _caller_sigmask = sigmask; }
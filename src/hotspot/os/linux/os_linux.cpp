@@ -389,6 +389,10 @@ void os::Linux::initialize_system_info() {
       fclose(fp);
     }
   }
+  initialize_physical_memory();
+}
+
+void os::Linux::initialize_physical_memory() {
   _physical_memory = (julong)sysconf(_SC_PHYS_PAGES) * (julong)sysconf(_SC_PAGESIZE);
 }
 
@@ -669,26 +673,123 @@ bool os::Linux::manually_expand_stack(JavaThread * t, address addr) {
 //////////////////////////////////////////////////////////////////////////////
 // create new thread
 
-// Thread start routine for all newly created threads
-static void *thread_native_entry(Thread *thread) {
+// Native threads whose Java thread terminated, parked for reuse by
+// os::create_thread(), see NativeThreadPoolSize. A parked thread keeps its
+// stack, guard page and TLS mapped, so starting a new Java thread on it
+// is a handoff instead of a pthread_create() and a fresh stack mmap.
+//
+// Parked threads are not Threads: Thread::current() is unset and they are
+// not on any threads list, so they synchronize with a PlatformMonitor.
+class NativeThreadPool : AllStatic {
+  struct Waiter {
+    Waiter* _next;
+    pthread_t _tid;
+    size_t _stack_size;
+    Thread* _thread;         // The next thread to run, set by hand_over()
+  };
 
-  thread->record_stack_base_and_size();
+  // A parked thread exits if no Java thread was started on it for this long.
+  static const jlong IdleTimeoutMillis = 60 * 1000;
 
-#ifndef __GLIBC__
-  // Try to randomize the cache line index of hot stack frames.
-  // This helps when threads of the same stack traces evict each other's
-  // cache lines. The threads can be either from the same JVM instance, or
-  // from different JVM instances. The benefit is especially true for
-  // processors with hyperthreading technology.
-  // This code is not needed anymore in glibc because it has MULTI_PAGE_ALIASING
-  // and we did not see any degradation in performance without `alloca()`.
-  static int counter = 0;
-  int pid = os::current_process_id();
-  int random = ((pid ^ counter++) & 7) * 128;
-  void *stackmem = alloca(random != 0 ? random : 1); // ensure we allocate > 0
-  // Ensure the alloca result is used in a way that prevents the compiler from eliding it.
-  *(char *)stackmem = 1;
-#endif
+  static os::PlatformMonitor* _lock;
+  static Waiter* _idle;
+  static int _idle_count;
+
+  static void unlink(Waiter* waiter);
+
+ public:
+  static void initialize();
+
+  // Parks the current native thread, whose stack has stack_size bytes.
+  // Returns the next Thread to run on it, or NULL if the thread should exit.
+  static Thread* park(size_t stack_size);
+
+  // Hands thread to a parked native thread with a stack of stack_size
+  // bytes. Returns false if there is none.
+  static bool hand_over(Thread* thread, size_t stack_size, pthread_t* tid);
+};
+
+os::PlatformMonitor* NativeThreadPool::_lock = NULL;
+NativeThreadPool::Waiter* NativeThreadPool::_idle = NULL;
+int NativeThreadPool::_idle_count = 0;
+
+void NativeThreadPool::initialize() {
+  if (NativeThreadPoolSize > 0) {
+    _lock = new os::PlatformMonitor();
+  }
+}
+
+void NativeThreadPool::unlink(Waiter* waiter) {
+  for (Waiter** p = &_idle; *p != NULL; p = &(*p)->_next) {
+    if (*p == waiter) {
+      *p = waiter->_next;
+      _idle_count--;
+      return;
+    }
+  }
+  ShouldNotReachHere();
+}
+
+Thread* NativeThreadPool::park(size_t stack_size) {
+  if (_lock == NULL || stack_size == 0) {
+    return NULL;
+  }
+  Waiter waiter;
+  waiter._tid = pthread_self();
+  waiter._stack_size = stack_size;
+  waiter._thread = NULL;
+
+  _lock->lock();
+  if (_idle_count >= NativeThreadPoolSize) {
+    _lock->unlock();
+    return NULL;
+  }
+  waiter._next = _idle;
+  _idle = &waiter;
+  _idle_count++;
+
+  // Do not show the name of the terminated thread while parked.
+  os::set_native_thread_name("Pooled thread");
+
+  const jlong deadline = os::javaTimeNanos() + IdleTimeoutMillis * NANOSECS_PER_MILLISEC;
+  while (waiter._thread == NULL) {
+    jlong remaining = deadline - os::javaTimeNanos();
+    if (remaining <= 0) {
+      unlink(&waiter);
+      break;
+    }
+    _lock->wait(MAX2(remaining / NANOSECS_PER_MILLISEC, (jlong)1));
+  }
+  _lock->unlock();
+  return waiter._thread;
+}
+
+bool NativeThreadPool::hand_over(Thread* thread, size_t stack_size, pthread_t* tid) {
+  if (_lock == NULL) {
+    return false;
+  }
+  _lock->lock();
+  Waiter* waiter = _idle;
+  while (waiter != NULL && waiter->_stack_size != stack_size) {
+    waiter = waiter->_next;
+  }
+  if (waiter != NULL) {
+    unlink(waiter);
+    waiter->_thread = thread;
+    *tid = waiter->_tid;
+    // Waiters are few; the ones not handed a thread just wait again.
+    _lock->notify_all();
+  }
+  _lock->unlock();
+  return waiter != NULL;
+}
+
+// Runs thread on the current native thread. Returns the stack size under
+// which the native thread may be parked in the NativeThreadPool afterwards,
+// or 0 if it must not be reused.
+static size_t run_native_thread(Thread* thread) {
+
+  thread->record_stack_base_and_size();
 
   thread->initialize_thread_current();
 
@@ -732,6 +833,9 @@ static void *thread_native_entry(Thread *thread) {
     os::naked_short_sleep(100);
   }
 
+  // Only Java threads are pooled, they are the ones started at high rates.
+  size_t pooled_stack_size = osthread->thread_type() == os::java_thread ? osthread->stack_size() : 0;
+
   // call one more level start routine
   thread->call_run();
 
@@ -742,6 +846,35 @@ static void *thread_native_entry(Thread *thread) {
   log_info(os, thread)("Thread finished (tid: " UINTX_FORMAT ", pthread id: " UINTX_FORMAT ").",
     os::current_thread_id(), (uintx) pthread_self());
 
+  return pooled_stack_size;
+}
+
+// Thread start routine for all newly created threads
+static void *thread_native_entry(Thread *thread) {
+
+#ifndef __GLIBC__
+  // Try to randomize the cache line index of hot stack frames.
+  // This helps when threads of the same stack traces evict each other's
+  // cache lines. The threads can be either from the same JVM instance, or
+  // from different JVM instances. The benefit is especially true for
+  // processors with hyperthreading technology.
+  // This code is not needed anymore in glibc because it has MULTI_PAGE_ALIASING
+  // and we did not see any degradation in performance without `alloca()`.
+  static int counter = 0;
+  int pid = os::current_process_id();
+  int random = ((pid ^ counter++) & 7) * 128;
+  void *stackmem = alloca(random != 0 ? random : 1); // ensure we allocate > 0
+  // Ensure the alloca result is used in a way that prevents the compiler from eliding it.
+  *(char *)stackmem = 1;
+#endif
+
+  // Run thread, then every Thread handed to this native thread while it
+  // is parked in the NativeThreadPool.
+  do {
+    size_t pooled_stack_size = run_native_thread(thread);
+    thread = NativeThreadPool::park(pooled_stack_size);
+  } while (thread != NULL);
+
   return 0;
 }
 
@@ -914,6 +1047,8 @@ bool os::create_thread(Thread* thread, ThreadType thr_type,
     return false;
   }
 
+  osthread->set_stack_size(stack_size);
+
   ThreadState state;
 
   {
@@ -921,12 +1056,19 @@ bool os::create_thread(Thread* thread, ThreadType thr_type,
     pthread_t tid;
     int ret = 0;
     int limit = 3;
-    do {
-      ret = pthread_create(&tid, &attr, (void* (*)(void*)) thread_native_entry, thread);
-    } while (ret == EAGAIN && limit-- > 0);
+    bool reused = thr_type == os::java_thread &&
+                  NativeThreadPool::hand_over(thread, stack_size, &tid);
+    if (!reused) {
+      do {
+        ret = pthread_create(&tid, &attr, (void* (*)(void*)) thread_native_entry, thread);
+      } while (ret == EAGAIN && limit-- > 0);
+    }
 
     char buf[64];
-    if (ret == 0) {
+    if (reused) {
+      log_info(os, thread)("Thread \"%s\" started on pooled native thread (pthread id: " UINTX_FORMAT ", attributes: %s). ",
+                           thread->name(), (uintx) tid, os::Posix::describe_pthread_attr(buf, sizeof(buf), &attr));
+    } else if (ret == 0) {
       log_info(os, thread)("Thread \"%s\" started (pthread id: " UINTX_FORMAT ", attributes: %s). ",
                            thread->name(), (uintx) tid, os::Posix::describe_pthread_attr(buf, sizeof(buf), &attr));
 
@@ -2914,6 +3056,14 @@ void os::pd_realign_memory(char *addr, size_t bytes, size_t alignment_hint) {
   }
 }
 
+bool os::Linux::collapse_huge_pages(char* addr, size_t bytes) {
+#ifndef MADV_COLLAPSE
+#define MADV_COLLAPSE 25
+#endif
+  // Older kernels fail with EINVAL, khugepaged still collapses the range eventually
+  return ::madvise(addr, bytes, MADV_COLLAPSE) == 0;
+}
+
 void os::pd_free_memory(char *addr, size_t bytes, size_t alignment_hint) {
   // This method works by doing an mmap over an existing mmaping and effectively discarding
   // the existing pages. However it won't work for SHM-based large pages that cannot be
@@ -4642,6 +4792,8 @@ jint os::init_2(void) {
   init_adjust_stacksize_for_guard_pages();
 #endif
 
+  NativeThreadPool::initialize();
+
   if (UseNUMA || UseNUMAInterleaving) {
     Linux::numa_init();
   }
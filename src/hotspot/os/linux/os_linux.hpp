@@ -108,6 +108,10 @@ class Linux {
 
   static void initialize_time_counters(void);
   static int active_processor_count();
+
+  // Synchronously collapse populated small pages of a range advised for
+  // transparent huge pages (MADV_COLLAPSE, Linux 6.1 and later).
+  static bool collapse_huge_pages(char* addr, size_t bytes);
   // which_logical_cpu=-1 returns accumulated ticks for all cpus.
   static bool get_tick_information(CPUPerfTicks* pticks, int which_logical_cpu);
   static bool _stack_is_executable;
@@ -320,6 +324,8 @@ class Linux {
     }
   }
 
+  static void initialize_physical_memory();
+
   static bool is_running_in_interleave_mode() {
     return _current_numa_policy == Interleave;
   }
@@ -23,11 +23,17 @@
 
 // no precompiled headers
 #include "jvm.h"
-#include "os_posix.hpp"
+#include "os_posix.inline.hpp"
 #include "runtime/crac.hpp"
 #include "runtime/crac_structs.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+#include "utilities/ostream.hpp"
 
+#include <poll.h>
 #include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
 
 int CracSHM::open(int mode) {
   int shmfd = shm_open(_path, mode, 0600);
@@ -45,6 +51,85 @@ void crac::initialize_time_counters() {
   os::Linux::initialize_time_counters();
 }
 
+// The CRaCCoordinator protocol is one line from the VM, answered by one line
+// from the coordinator, on a new connection each:
+//   "ready <pid> <image dir>"  -> "commit" or "abort", before the engine runs
+//   "restored <pid>"           -> "release", after restore
+// The connection is closed before the engine runs, so it is not checkpointed.
+static bool coordinator_exchange(const char* request, char* answer, size_t answer_len) {
+  struct sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (strlen(CRaCCoordinator) >= sizeof(addr.sun_path)) {
+    warning("CRaCCoordinator path is too long: %s", CRaCCoordinator);
+    return false;
+  }
+  strcpy(addr.sun_path, CRaCCoordinator);
+
+  int s = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (s == -1) {
+    warning("cannot create a socket for CRaCCoordinator: %s", os::strerror(errno));
+    return false;
+  }
+  int ret;
+  RESTARTABLE(::connect(s, (struct sockaddr*)&addr, sizeof(addr)), ret);
+  if (ret == -1) {
+    warning("cannot connect to CRaCCoordinator %s: %s", CRaCCoordinator, os::strerror(errno));
+    ::close(s);
+    return false;
+  }
+
+  bool ok = ::send(s, request, strlen(request), MSG_NOSIGNAL) == (ssize_t)strlen(request);
+  size_t len = 0;
+  const jlong deadline = os::javaTimeMillis() + CRaCCoordinatorTimeout;
+  while (ok && len < answer_len - 1 && memchr(answer, '\n', len) == NULL) {
+    jlong timeout = deadline - os::javaTimeMillis();
+    struct pollfd pfd = { s, POLLIN, 0 };
+    if (timeout <= 0 || ::poll(&pfd, 1, (int)timeout) == 0) {
+      warning("no answer from CRaCCoordinator in " UINTX_FORMAT " ms", CRaCCoordinatorTimeout);
+      ok = false;
+      break;
+    }
+    ssize_t n = ::recv(s, answer + len, answer_len - 1 - len, 0);
+    if (n > 0) {
+      len += n;
+    } else if (n == 0 || errno != EINTR) {
+      ok = false;
+    }
+  }
+  ::close(s);
+  answer[len] = '\0';
+  answer[strcspn(answer, "\n")] = '\0';
+  return ok;
+}
+
+bool VM_Crac::coordinator_prepare() {
+  if (CRaCCoordinator == NULL) {
+    return true;
+  }
+  char request[JVM_MAXPATHLEN + 32];
+  jio_snprintf(request, sizeof(request), "ready %d %s\n", os::current_process_id(), CRaCCheckpointTo);
+  char answer[64];
+  if (coordinator_exchange(request, answer, sizeof(answer)) && strcmp(answer, "commit") == 0) {
+    trace_cr("Checkpoint committed by coordinator");
+    return true;
+  }
+  _failures->append(CracFailDep(JVM_CR_FAIL, os::strdup_check_oom("Checkpoint not committed by CRaCCoordinator")));
+  return false;
+}
+
+void VM_Crac::coordinator_release() {
+  if (CRaCCoordinator == NULL) {
+    return;
+  }
+  char request[32];
+  jio_snprintf(request, sizeof(request), "restored %d\n", os::current_process_id());
+  char answer[64];
+  if (!coordinator_exchange(request, answer, sizeof(answer)) || strcmp(answer, "release") != 0) {
+    warning("Restore not released by CRaCCoordinator, resuming");
+  }
+}
+
 #ifndef LINUX
 void crac::vm_create_start() {
 }
@@ -56,6 +141,14 @@ bool VM_Crac::check_fds() {
   return true;
 }
 
+void crac::print_blocking_fds(outputStream* st, int jcmd_fd) {
+  st->print_cr("  not available on this platform");
+}
+
+void crac::print_image_estimate(outputStream* st) {
+  st->print_cr("  not available on this platform");
+}
+
 bool VM_Crac::memory_checkpoint() {
   return true;
 }
@@ -63,6 +156,9 @@ bool VM_Crac::memory_checkpoint() {
 void VM_Crac::memory_restore() {
 }
 
+void VM_Crac::host_restore() {
+}
+
 bool crac::read_bootid(char *dest) {
   return true;
 }
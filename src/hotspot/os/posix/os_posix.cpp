@@ -55,6 +55,9 @@
 #include <dirent.h>
 #include <dlfcn.h>
 #include <grp.h>
+#ifdef LINUX
+#include <linux/futex.h>
+#endif
 #include <locale.h>
 #include <netdb.h>
 #include <pwd.h>
@@ -63,6 +66,9 @@
 #include <sys/mman.h>
 #include <sys/resource.h>
 #include <sys/socket.h>
+#ifdef LINUX
+#include <sys/syscall.h>
+#endif
 #include <sys/types.h>
 #include <sys/utsname.h>
 #include <sys/wait.h>
@@ -1243,12 +1249,13 @@ bool os::Posix::matches_effective_uid_and_gid_or_root(uid_t uid, gid_t gid) {
     return is_root(uid) || (geteuid() == uid && getegid() == gid);
 }
 
-Thread* os::ThreadCrashProtection::_protected_thread = NULL;
-os::ThreadCrashProtection* os::ThreadCrashProtection::_crash_protection = NULL;
+os::ThreadCrashProtection::ThreadCrashProtection() : _protected_thread(Thread::current()) {
+  assert(_protected_thread->is_JfrSampler_thread() || _protected_thread->is_Java_thread(),
+         "should be JFRSampler or a Java thread sampling itself");
+}
 
-os::ThreadCrashProtection::ThreadCrashProtection() {
-  _protected_thread = Thread::current();
-  assert(_protected_thread->is_JfrSampler_thread(), "should be JFRSampler");
+bool os::ThreadCrashProtection::is_crash_protected(Thread* thr) {
+  return thr != NULL && thr->crash_protection() != NULL;
 }
 
 /*
@@ -1267,22 +1274,20 @@ bool os::ThreadCrashProtection::call(os::CrashProtectionCallback& cb) {
   if (sigsetjmp(_jmpbuf, 0) == 0) {
     // make sure we can see in the signal handler that we have crash protection
     // installed
-    _crash_protection = this;
+    _protected_thread->set_crash_protection(this);
     cb.call();
     // and clear the crash protection
-    _crash_protection = NULL;
-    _protected_thread = NULL;
+    _protected_thread->set_crash_protection(NULL);
     return true;
   }
   // this happens when we siglongjmp() back
   pthread_sigmask(SIG_SETMASK, &saved_sig_mask, NULL);
-  _crash_protection = NULL;
-  _protected_thread = NULL;
+  _protected_thread->set_crash_protection(NULL);
   return false;
 }
 
 void os::ThreadCrashProtection::restore() {
-  assert(_crash_protection != NULL, "must have crash protection");
+  assert(_protected_thread->crash_protection() == this, "must have crash protection");
   siglongjmp(_jmpbuf, 1);
 }
 
@@ -1290,11 +1295,10 @@ void os::ThreadCrashProtection::check_crash_protection(int sig,
     Thread* thread) {
 
   if (thread != NULL &&
-      thread == _protected_thread &&
-      _crash_protection != NULL) {
+      thread->crash_protection() != NULL) {
 
     if (sig == SIGSEGV || sig == SIGBUS) {
-      _crash_protection->restore();
+      thread->crash_protection()->restore();
     }
   }
 }
@@ -1538,7 +1542,8 @@ void os::javaTimeNanos_info(jvmtiTimerInfo *info_ptr) {
 
 #endif // ! APPLE && !AIX
 
-// Shared pthread_mutex/cond based PlatformEvent implementation.
+// Shared pthread_mutex/cond based PlatformEvent implementation, futex
+// based on Linux.
 // Not currently usable by Solaris.
 
 
@@ -1557,6 +1562,123 @@ void os::javaTimeNanos_info(jvmtiTimerInfo *info_ptr) {
 //    Having three states allows for some detection of bad usage - see
 //    comments on unpark().
 
+#ifdef LINUX
+
+// futex(2) based PlatformEvent and Parker. The permit word is the futex
+// word, so there is no mutex or condition variable: blocking is one
+// FUTEX_WAIT, waking a blocked thread is one FUTEX_WAKE, and an unpark of
+// a running thread is a plain atomic exchange.
+
+// Waits while *addr == val, until woken, interrupted by a signal, or
+// abstime (if not NULL) has passed. abstime is absolute, on the realtime
+// clock if realtime is true and on the monotonic clock otherwise.
+static int futex_wait(volatile int* addr, int val, const timespec* abstime, bool realtime) {
+  int op = FUTEX_WAIT_BITSET_PRIVATE | (realtime ? FUTEX_CLOCK_REALTIME : 0);
+  int s = syscall(SYS_futex, addr, op, val, abstime, NULL, FUTEX_BITSET_MATCH_ANY);
+  assert(s == 0 || errno == EAGAIN || errno == EINTR || errno == ETIMEDOUT,
+         "futex FUTEX_WAIT failed: %s", os::errno_name(errno));
+  return s;
+}
+
+static void futex_wake_one(volatile int* addr) {
+  int s = syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+  guarantee(s > -1, "futex FUTEX_WAKE failed: %s", os::errno_name(errno));
+}
+
+// The clock to_abstime() picks for a timeout.
+static bool abstime_is_realtime(bool isAbsolute) {
+  return isAbsolute || !_use_clock_monotonic_condattr;
+}
+
+os::PlatformEvent::PlatformEvent() {
+  _event   = 0;
+  _nParked = 0;
+}
+
+void os::PlatformEvent::park() {       // AKA "down()"
+  // Same transitions for _event as the pthread based version below.
+
+  // Invariant: Only the thread associated with the PlatformEvent
+  // may call park().
+  assert(_nParked == 0, "invariant");
+
+  int v;
+
+  // atomically decrement _event
+  for (;;) {
+    v = _event;
+    if (Atomic::cmpxchg(&_event, v, v - 1) == v) break;
+  }
+  guarantee(v >= 0, "invariant");
+
+  if (v == 0) { // Do this the hard way by blocking ...
+    _nParked = 1;
+    while (Atomic::load_acquire(&_event) < 0) {
+      // Spurious wakeups and EINTR are ignored; EAGAIN means unparked.
+      futex_wait(&_event, -1, NULL, false);
+    }
+    _nParked = 0;
+
+    _event = 0;
+    // Paranoia to ensure our locked and lock-free paths interact
+    // correctly with each other.
+    OrderAccess::fence();
+  }
+  guarantee(_event >= 0, "invariant");
+}
+
+int os::PlatformEvent::park(jlong millis) {
+  // Same transitions for _event as the pthread based version below.
+
+  // Invariant: Only the thread associated with the Event/PlatformEvent
+  // may call park().
+  assert(_nParked == 0, "invariant");
+
+  int v;
+  // atomically decrement _event
+  for (;;) {
+    v = _event;
+    if (Atomic::cmpxchg(&_event, v, v - 1) == v) break;
+  }
+  guarantee(v >= 0, "invariant");
+
+  if (v == 0) { // Do this the hard way by blocking ...
+    struct timespec abst;
+    to_abstime(&abst, millis_to_nanos_bounded(millis), false, false);
+    const bool realtime = abstime_is_realtime(false);
+
+    _nParked = 1;
+    while (Atomic::load_acquire(&_event) < 0) {
+      int s = futex_wait(&_event, -1, &abst, realtime);
+      // OS-level "spurious wakeups" are ignored unless the archaic
+      // FilterSpuriousWakeups is set false. That flag should be obsoleted.
+      if (!FilterSpuriousWakeups) break;
+      if (s != 0 && errno == ETIMEDOUT) break;
+    }
+    _nParked = 0;
+
+    // Consuming the permit with xchg also catches an unpark() that raced
+    // with the timeout.
+    int ret = Atomic::xchg(&_event, 0) >= 0 ? OS_OK : OS_TIMEOUT;
+    // Paranoia to ensure our locked and lock-free paths interact
+    // correctly with each other.
+    OrderAccess::fence();
+    return ret;
+  }
+  return OS_OK;
+}
+
+void os::PlatformEvent::unpark() {
+  // Same transitions for _event as the pthread based version below. Only
+  // a -1 => 1 transition has a thread to wake, and since events are
+  // immortal the futex word stays valid even if the owner already returned.
+  if (Atomic::xchg(&_event, 1) >= 0) return;
+
+  futex_wake_one(&_event);
+}
+
+#else // LINUX
+
 os::PlatformEvent::PlatformEvent() {
   int status = pthread_cond_init(_cond, _condAttr);
   assert_status(status == 0, status, "cond_init");
@@ -1703,8 +1825,90 @@ void os::PlatformEvent::unpark() {
   }
 }
 
+#endif // LINUX
+
 // JSR166 support
 
+#ifdef LINUX
+
+os::PlatformParker::PlatformParker() : _counter(0) {}
+
+os::PlatformParker::~PlatformParker() {}
+
+// Parker::park consumes the permit if there is one, else spins briefly
+// and then waits on _counter. unpark sets the permit and, if the owner
+// announced that it blocks by setting _counter to -1, wakes it. Spurious
+// returns are fine, so there is no need to track notifications.
+
+// Iterations of SpinPause() in Parker::park before blocking. A handoff
+// between executor threads often completes within this window, and
+// catching it avoids both the futex wait and the wake.
+static const int ParkSpinLimit = 64;
+
+void Parker::park(bool isAbsolute, jlong time) {
+
+  // Optional fast-path check:
+  // Return immediately if a permit is available.
+  // We depend on Atomic::xchg() having full barrier semantics
+  // since we are doing a lock-free update to _counter.
+  if (Atomic::xchg(&_counter, 0) > 0) return;
+
+  JavaThread *jt = JavaThread::current();
+
+  // Optional optimization -- avoid state transitions if there's
+  // an interrupt pending.
+  if (jt->is_interrupted(false)) {
+    return;
+  }
+
+  // Next, demultiplex/decode time arguments
+  struct timespec absTime;
+  if (time < 0 || (isAbsolute && time == 0)) { // don't wait at all
+    return;
+  }
+  if (time > 0) {
+    to_abstime(&absTime, time, isAbsolute, false);
+  }
+
+  // Enter safepoint region. Unlike the pthread based version there is no
+  // lock to deadlock on, see 6317397.
+  ThreadBlockInVM tbivm(jt);
+
+  // Can't access interrupt state now that we are _thread_blocked. If we've
+  // been interrupted since we checked above then _counter will be > 0.
+
+  for (int i = 0; i < ParkSpinLimit; i++) {
+    if (Atomic::load(&_counter) > 0) {
+      break;
+    }
+    SpinPause();
+  }
+
+  // Announce that we block. If this fails an unpark() set the permit.
+  if (Atomic::cmpxchg(&_counter, 0, -1) == 0) {
+    OSThreadWaitState osts(jt->osthread(), false /* not Object.wait() */);
+    // A wakeup, timeout, signal or unpark() before the wait all end it.
+    futex_wait(&_counter, -1, time == 0 ? NULL : &absTime, abstime_is_realtime(isAbsolute));
+  }
+
+  // Consume the permit, or withdraw the -1 if we were not unparked.
+  Atomic::xchg(&_counter, 0);
+  // Paranoia to ensure our locked and lock-free paths interact
+  // correctly with each other and Java-level accesses.
+  OrderAccess::fence();
+}
+
+void Parker::unpark() {
+  // Callers keep the owning JavaThread alive with a ThreadsListHandle, so
+  // waking on _counter after the owner returned from park() is benign.
+  if (Atomic::xchg(&_counter, 1) < 0) {
+    // thread is definitely parked
+    futex_wake_one(&_counter);
+  }
+}
+
+#else // LINUX
+
  os::PlatformParker::PlatformParker() : _counter(0), _cur_index(-1) {
   int status = pthread_cond_init(&_cond[REL_INDEX], _condAttr);
   assert_status(status == 0, status, "cond_init rel");
@@ -1832,6 +2036,8 @@ void Parker::unpark() {
   }
 }
 
+#endif // LINUX
+
 // Platform Mutex/Monitor implementation
 
 #if PLATFORM_MONITOR_IMPL_INDIRECT
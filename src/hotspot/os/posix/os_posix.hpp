@@ -111,9 +111,11 @@ public:
 };
 
 /*
- * Crash protection for the JfrSampler thread. Wrap the callback
+ * Crash protection for stack walking by the JfrSampler thread, or by a
+ * thread sampling its own stack from a signal handler. Wrap the callback
  * with a sigsetjmp and in case of a SIGSEGV/SIGBUS we siglongjmp
- * back.
+ * back. The protection is per-thread, so several threads can be protected
+ * at the same time.
  * To be able to use this - don't take locks, don't rely on destructors,
  * don't make OS library calls, don't allocate memory, don't print,
  * don't call code that could leave the heap / memory in an inconsistent state,
@@ -121,17 +123,14 @@ public:
  */
 class ThreadCrashProtection : public StackObj {
 public:
-  static bool is_crash_protected(Thread* thr) {
-    return _crash_protection != NULL && _protected_thread == thr;
-  }
+  static bool is_crash_protected(Thread* thr);
 
   ThreadCrashProtection();
   bool call(os::CrashProtectionCallback& cb);
 
   static void check_crash_protection(int signal, Thread* thread);
 private:
-  static Thread* _protected_thread;
-  static ThreadCrashProtection* _crash_protection;
+  Thread* const _protected_thread;
   void restore();
   sigjmp_buf _jmpbuf;
 };
@@ -148,8 +147,10 @@ class PlatformEvent : public CHeapObj<mtSynchronizer> {
   double cachePad[4];        // Increase odds that _mutex is sole occupant of cache line
   volatile int _event;       // Event count/permit: -1, 0 or 1
   volatile int _nParked;     // Indicates if associated thread is blocked: 0 or 1
+#ifndef LINUX
   pthread_mutex_t _mutex[1]; // Native mutex for locking
   pthread_cond_t  _cond[1];  // Native condition variable for blocking
+#endif
   double postPad[2];
 
  protected:       // TODO-FIXME: make dtor private
@@ -177,10 +178,18 @@ class PlatformEvent : public CHeapObj<mtSynchronizer> {
 // were more like ObjectMonitor we could use PlatformEvent in both (with some
 // API updates of course). But Parker methods use fastpaths that break that
 // level of encapsulation - so combining the two remains a future project.
+//
+// On Linux both block with futex(2) on the permit word itself, so an
+// unpark of a parked thread is a single FUTEX_WAKE and park needs no lock.
 
 class PlatformParker {
   NONCOPYABLE(PlatformParker);
  protected:
+#ifdef LINUX
+  // Permit: 1 if available, 0 if not, and -1 if not and the owner is
+  // blocked (or about to block) in a futex wait on it.
+  volatile int _counter;
+#else
   enum {
     REL_INDEX = 0,
     ABS_INDEX = 1
@@ -189,6 +198,7 @@ class PlatformParker {
   int _cur_index;  // which cond is in use: -1, 0, 1
   pthread_mutex_t _mutex[1];
   pthread_cond_t  _cond[2]; // one for relative times and one for absolute
+#endif // LINUX
 
  public:
   PlatformParker();
@@ -57,13 +57,14 @@
 #endif
 
 static char* backing_store_file_name = NULL;  // name of the backing store
+static int backing_store_fd = -1;             // kept open while the region can grow
                                               // file, if successfully created.
 
 // Standard Memory Implementation Details
 
 // create the PerfData memory region in standard memory.
 //
-static char* create_standard_memory(size_t size) {
+static char* create_standard_memory(size_t size, size_t initial_size) {
 
   // allocate an aligned chuck of memory
   char* mapAddress = os::reserve_memory(size);
@@ -73,7 +74,7 @@ static char* create_standard_memory(size_t size) {
   }
 
   // commit memory
-  if (!os::commit_memory(mapAddress, size, !ExecMem)) {
+  if (!os::commit_memory(mapAddress, initial_size, !ExecMem)) {
     if (PrintMiscellaneous && Verbose) {
       warning("Could not commit PerfData memory\n");
     }
@@ -845,13 +846,33 @@ static bool make_user_tmp_dir(const char* dirname) {
   return true;
 }
 
+// Verify that we have enough disk space for the given part of the file.
+// We'll get random SIGBUS crashes on memory accesses if we don't.
+//
+static bool zero_fill_file(int fd, size_t from, size_t to, const char* filename) {
+  for (size_t seekpos = from; seekpos < to; seekpos += os::vm_page_size()) {
+    int zero_int = 0;
+    if (os::seek_to_file_offset(fd, (jlong)(seekpos)) == -1) {
+      return false;
+    }
+    if (!os::write(fd, &zero_int, 1)) {
+      if (errno == ENOSPC) {
+        warning("Insufficient space for shared memory file:\n   %s\nTry using the -Djava.io.tmpdir= option to select an alternate temp location.\n", filename);
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
 // create the shared memory file
 //
-// This method creates the shared memory file with the given size
+// This method creates the shared memory file with the given size, of which
+// the first initial_size bytes are backed by disk space.
 // This method also creates the user specific temporary directory, if
 // it does not yet exist.
 //
-static int create_sharedmem_file(const char* dirname, const char* filename, size_t size) {
+static int create_sharedmem_file(const char* dirname, const char* filename, size_t size, size_t initial_size) {
 
   // make the user temporary directory
   if (!make_user_tmp_dir(dirname)) {
@@ -943,23 +964,7 @@ static int create_sharedmem_file(const char* dirname, const char* filename, size
     return -1;
   }
 
-  // Verify that we have enough disk space for this file.
-  // We'll get random SIGBUS crashes on memory accesses if
-  // we don't.
-  for (size_t seekpos = 0; seekpos < size; seekpos += os::vm_page_size()) {
-    int zero_int = 0;
-    result = (int)os::seek_to_file_offset(fd, (jlong)(seekpos));
-    if (result == -1 ) break;
-    if (!os::write(fd, &zero_int, 1)) {
-      if (errno == ENOSPC) {
-        warning("Insufficient space for shared memory file:\n   %s\nTry using the -Djava.io.tmpdir= option to select an alternate temp location.\n", filename);
-      }
-      result = OS_ERR;
-      break;
-    }
-  }
-
-  if (result != -1) {
+  if (zero_fill_file(fd, 0, initial_size, filename)) {
     return fd;
   } else {
     os::close(fd);
@@ -1013,7 +1018,7 @@ static int open_sharedmem_file(const char* filename, int oflags, TRAPS) {
 // created and terminating JVMs by watching the file system name space
 // for files being created or removed.
 //
-static char* mmap_create_shared(size_t size) {
+static char* mmap_create_shared(size_t size, size_t initial_size) {
 
   int result;
   int fd;
@@ -1044,7 +1049,7 @@ static char* mmap_create_shared(size_t size) {
          "unexpected PerfMemory region size");
 
   log_info(perf, memops)("Trying to open %s/%s", dirname, short_filename);
-  fd = create_sharedmem_file(dirname, short_filename, size);
+  fd = create_sharedmem_file(dirname, short_filename, size, initial_size);
 
   FREE_C_HEAP_ARRAY(char, user_name);
   FREE_C_HEAP_ARRAY(char, dirname);
@@ -1056,8 +1061,13 @@ static char* mmap_create_shared(size_t size) {
 
   mapAddress = (char*)::mmap((char*)0, size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
 
-  result = ::close(fd);
-  assert(result != OS_ERR, "could not close file");
+  if (mapAddress != MAP_FAILED && size > initial_size) {
+    // the rest of the file gets disk space when the region grows
+    backing_store_fd = fd;
+  } else {
+    result = ::close(fd);
+    assert(result != OS_ERR, "could not close file");
+  }
 
   if (mapAddress == MAP_FAILED) {
     if (PrintMiscellaneous && Verbose) {
@@ -1072,7 +1082,7 @@ static char* mmap_create_shared(size_t size) {
   backing_store_file_name = filename;
 
   // clear the shared memory region
-  (void)::memset((void*) mapAddress, 0, size);
+  (void)::memset((void*) mapAddress, 0, initial_size);
 
   // it does not go through os api, the operation has to record from here
   MemTracker::record_virtual_memory_reserve_and_commit((address)mapAddress, size, CURRENT_PC, mtInternal);
@@ -1098,10 +1108,10 @@ static void unmap_shared(char* addr, size_t bytes) {
 
 // create the PerfData memory region in shared memory.
 //
-static char* create_shared_memory(size_t size) {
+static char* create_shared_memory(size_t size, size_t initial_size) {
 
   // create the shared memory region.
-  return mmap_create_shared(size);
+  return mmap_create_shared(size, initial_size);
 }
 
 // delete the shared PerfData memory region
@@ -1277,14 +1287,14 @@ static void mmap_attach_shared(const char* user, int vmid, PerfMemory::PerfMemor
 // data for the JVM. The memory may be created in standard or
 // shared memory.
 //
-void PerfMemory::create_memory_region(size_t size) {
+void PerfMemory::create_memory_region(size_t size, size_t initial_size) {
 
   if (PerfDisableSharedMem) {
     // do not share the memory for the performance data.
-    _start = create_standard_memory(size);
+    _start = create_standard_memory(size, initial_size);
   }
   else {
-    _start = create_shared_memory(size);
+    _start = create_shared_memory(size, initial_size);
     if (_start == NULL) {
 
       // creation of the shared memory region failed, attempt
@@ -1294,7 +1304,7 @@ void PerfMemory::create_memory_region(size_t size) {
         warning("Reverting to non-shared PerfMemory region.\n");
       }
       PerfDisableSharedMem = true;
-      _start = create_standard_memory(size);
+      _start = create_standard_memory(size, initial_size);
     }
   }
 
@@ -1302,6 +1312,22 @@ void PerfMemory::create_memory_region(size_t size) {
 
 }
 
+// grow the usable part of the PerfData memory region
+//
+bool PerfMemory::expand_memory_region(size_t old_size, size_t new_size) {
+
+  assert(new_size > old_size && new_size <= capacity(), "verify proper state");
+
+  if (PerfDisableSharedMem) {
+    return os::commit_memory(start() + old_size, new_size - old_size, !ExecMem);
+  }
+  if (backing_store_fd == -1) {
+    return false;
+  }
+  // the file pages read as zeros, which the mapping shares
+  return zero_fill_file(backing_store_fd, old_size, new_size, backing_store_file_name);
+}
+
 // delete the PerfData memory region
 //
 // This method deletes the memory region used to store performance
@@ -1403,6 +1429,10 @@ bool PerfMemoryLinux::checkpoint() {
   }
 
   remove_file(backing_store_file_name);
+  if (backing_store_fd != -1) {
+    ::close(backing_store_fd);
+    backing_store_fd = -1;
+  }
 
   return true;
 }
@@ -1435,13 +1465,25 @@ bool PerfMemoryLinux::restore() {
     return false;
   }
 
+  // The region keeps the size it had grown to before the checkpoint
+  size_t usable = PerfMemory::end() - PerfMemory::start();
+  if (!zero_fill_file(fd, 0, usable, backing_store_file_name)) {
+    tty->print_cr("Cannot restore perfdata file disk space: %s", os::strerror(errno));
+    ::close(fd);
+    return false;
+  }
+
   void* shared = ::mmap(nullptr, PerfMemory::capacity(), PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
   if (MAP_FAILED == shared) {
     tty->print_cr("cannot mmap shared perfdata file: %s", os::strerror(errno));
     ::close(fd);
     return false;
   }
-  ::close(fd);
+  if (PerfMemory::capacity() > usable) {
+    backing_store_fd = fd;
+  } else {
+    ::close(fd);
+  }
 
   // Here is another place where we might lose the update
   memcpy(shared, PerfMemory::start(), PerfMemory::used());
@@ -25,6 +25,7 @@
 
 #include "jvm.h"
 #include "runtime/crac_structs.hpp"
+#include "utilities/ostream.hpp"
 
 void crac::vm_create_start() {
 }
@@ -36,6 +37,14 @@ bool VM_Crac::check_fds() {
   return true;
 }
 
+void crac::print_blocking_fds(outputStream* st, int jcmd_fd) {
+  st->print_cr("  not available on this platform");
+}
+
+void crac::print_image_estimate(outputStream* st) {
+  st->print_cr("  not available on this platform");
+}
+
 bool VM_Crac::memory_checkpoint() {
   return true;
 }
@@ -43,6 +52,16 @@ bool VM_Crac::memory_checkpoint() {
 void VM_Crac::memory_restore() {
 }
 
+bool VM_Crac::coordinator_prepare() {
+  return true;
+}
+
+void VM_Crac::coordinator_release() {
+}
+
+void VM_Crac::host_restore() {
+}
+
 int CracSHM::open(int mode) {
   return -1;
 }
@@ -1729,7 +1729,7 @@ void delete_shared_memory(char* addr, size_t size) {
 // data for the JVM. The memory may be created in standard or
 // shared memory.
 //
-void PerfMemory::create_memory_region(size_t size) {
+void PerfMemory::create_memory_region(size_t size, size_t initial_size) {
 
   if (PerfDisableSharedMem) {
     // do not share the memory for the performance data.
@@ -1755,6 +1755,13 @@ void PerfMemory::create_memory_region(size_t size) {
 
 }
 
+// The whole region is created usable on Windows, so there is nothing to do
+// when it grows.
+//
+bool PerfMemory::expand_memory_region(size_t old_size, size_t new_size) {
+  return true;
+}
+
 // delete the PerfData memory region
 //
 // This method deletes the memory region used to store performance
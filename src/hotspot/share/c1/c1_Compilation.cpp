@@ -267,7 +267,13 @@ void Compilation::emit_lir() {
     LinearScan* allocator = new LinearScan(hir(), &gen, frame_map());
     set_allocator(allocator);
     // Assign physical registers to LIR operands using a linear scan algorithm.
+    elapsedTimer regalloc_time;
+    regalloc_time.start();
     allocator->do_linear_scan();
+    regalloc_time.stop();
+    if (env()->task() != NULL) {
+      env()->task()->add_regalloc_time(regalloc_time);
+    }
     CHECK_BAILOUT();
 
     _max_spills = allocator->max_spills();
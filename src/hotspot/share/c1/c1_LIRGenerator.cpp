@@ -627,6 +627,16 @@ void LIRGenerator::monitor_enter(LIR_Opr object, LIR_Opr lock, LIR_Opr hdr, LIR_
   // for slow path, use debug info for state after successful locking
   CodeStub* slow_path = new MonitorEnterStub(object, lock, info);
   __ load_stack_address_monitor(monitor_no, lock);
+  if (UseLightweightLocking) {
+    // There is no lightweight locking fast path in compiled code, the
+    // runtime fast-locks without a thread state transition.
+    if (info_for_exception != NULL) {
+      __ null_check(object, info_for_exception);
+    }
+    __ jump(slow_path);
+    __ branch_destination(slow_path->continuation());
+    return;
+  }
   // for handling NullPointerException, use debug info representing just the lock stack before this monitorenter
   __ lock_object(hdr, object, lock, scratch, slow_path, info_for_exception);
 }
@@ -639,6 +649,11 @@ void LIRGenerator::monitor_exit(LIR_Opr object, LIR_Opr lock, LIR_Opr new_hdr, L
   lock = new_hdr;
   CodeStub* slow_path = new MonitorExitStub(lock, UseFastLocking, monitor_no);
   __ load_stack_address_monitor(monitor_no, lock);
+  if (UseLightweightLocking) {
+    __ jump(slow_path);
+    __ branch_destination(slow_path->continuation());
+    return;
+  }
   __ unlock_object(hdr, object, lock, scratch, slow_path);
 }
 
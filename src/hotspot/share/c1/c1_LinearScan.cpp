@@ -86,6 +86,7 @@ LinearScan::LinearScan(IR* ir, LIRGenerator* gen, FrameMap* frame_map)
  , _new_intervals_from_allocation(NULL)
  , _sorted_intervals(NULL)
  , _needs_full_resort(false)
+ , _fast_mode((C1FastLinearScanLevels & (1 << ir->compilation()->env()->comp_level())) != 0)
  , _lir_ops(0)     // initialized later with correct length
  , _block_of_op(0) // initialized later with correct length
  , _has_info(0)
@@ -3154,7 +3155,9 @@ void LinearScan::do_linear_scan() {
 #ifndef RISCV
   // Disable these optimizations on riscv temporarily, because it does not
   // work when the comparison operands are bound to branches or cmoves.
-  { TIME_LINEAR_SCAN(timer_optimize_lir);
+  // Skipped in fast mode, the code they improve is short-lived.
+  if (!fast_mode()) {
+    TIME_LINEAR_SCAN(timer_optimize_lir);
 
     EdgeMoveOptimizer::optimize(ir()->code());
     ControlFlowOptimizer::optimize(ir()->code());
@@ -5171,8 +5174,9 @@ int LinearScanWalker::find_optimal_split_pos(Interval* it, int min_split_pos, in
     BlockBegin* max_block = allocator()->block_of_op_with_id(max_split_pos - 1);
 
     assert(min_block->linear_scan_number() <= max_block->linear_scan_number(), "invalid order");
-    if (min_block == max_block) {
-      // split position cannot be moved to block boundary, so split as late as possible
+    if (min_block == max_block || allocator()->fast_mode()) {
+      // split position cannot be moved to block boundary (or searching for one is not
+      // worth it in fast mode), so split as late as possible
       TRACE_LINEAR_SCAN(4, tty->print_cr("      cannot move split pos to block boundary because min_pos and max_pos are in same block"));
       optimal_split_pos = max_split_pos;
 
@@ -312,6 +312,12 @@
   develop(bool, ComputeExactFPURegisterUsage, true,                         \
           "Compute additional live set for fpu registers to simplify fpu stack merge (Intel only)") \
                                                                             \
+  product(intx, C1FastLinearScanLevels, 0,                                  \
+          "Bit mask of compilation levels (bit N for level N) for which "   \
+          "the linear scan register allocator skips split position "        \
+          "optimization and the LIR move and control flow optimizers")      \
+          range(0, 15)                                                      \
+                                                                            \
   product(bool, C1ProfileCalls, true,                                       \
           "Profile calls when generating code for updating MDOs")           \
                                                                             \
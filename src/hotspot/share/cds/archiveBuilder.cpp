@@ -32,16 +32,20 @@
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionaryShared.hpp"
 #include "classfile/vmClasses.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "interpreter/abstractInterpreter.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allStatic.hpp"
 #include "memory/memRegion.hpp"
 #include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
 #include "oops/instanceKlass.hpp"
 #include "oops/objArrayKlass.hpp"
 #include "oops/oopHandle.inline.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/globals_extension.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/thread.hpp"
@@ -665,7 +669,44 @@ address ArchiveBuilder::get_dumped_addr(address src_obj) const {
   return p->dumped_addr();
 }
 
+// Each object's pointers only depend on the source object table, which is
+// no longer modified, so the objects can be relocated in any order and the
+// archive stays the same.
+class RelocateEmbeddedPointersTask : public AbstractGangTask {
+  static const int ChunkSize = 256;
+  ArchiveBuilder* _builder;
+  ArchiveBuilder::SourceObjList* _src_objs;
+  volatile int _next;
+public:
+  RelocateEmbeddedPointersTask(ArchiveBuilder* builder, ArchiveBuilder::SourceObjList* src_objs) :
+    AbstractGangTask("Relocate embedded pointers"), _builder(builder), _src_objs(src_objs), _next(0) {}
+
+  static bool is_worth_it(ArchiveBuilder::SourceObjList* src_objs) {
+    return src_objs->objs()->length() > 4 * ChunkSize;
+  }
+
+  void work(uint worker_id) {
+    int len = _src_objs->objs()->length();
+    for (int start = Atomic::fetch_and_add(&_next, ChunkSize); start < len;
+         start = Atomic::fetch_and_add(&_next, ChunkSize)) {
+      int end = MIN2(start + ChunkSize, len);
+      for (int i = start; i < end; i++) {
+        _src_objs->relocate(i, _builder);
+      }
+    }
+  }
+};
+
 void ArchiveBuilder::relocate_embedded_pointers(ArchiveBuilder::SourceObjList* src_objs) {
+  WorkGang* workers = Universe::heap()->safepoint_workers();
+  if (workers != NULL && workers->active_workers() > 1 &&
+      RelocateEmbeddedPointersTask::is_worth_it(src_objs)) {
+    RelocateEmbeddedPointersTask task(this, src_objs);
+    ArchivePtrMarker::begin_parallel_marking();
+    workers->run_task(&task);
+    ArchivePtrMarker::end_parallel_marking();
+    return;
+  }
   for (int i = 0; i < src_objs->objs()->length(); i++) {
     src_objs->relocate(i, this);
   }
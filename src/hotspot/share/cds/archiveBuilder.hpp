@@ -249,6 +249,7 @@ private:
 
   void update_special_refs();
   void relocate_embedded_pointers(SourceObjList* src_objs);
+  friend class RelocateEmbeddedPointersTask;
 
   bool is_excluded(Klass* k);
   void clean_up_src_obj_table();
@@ -44,6 +44,7 @@ CHeapBitMap* ArchivePtrMarker::_ptrmap = NULL;
 VirtualSpace* ArchivePtrMarker::_vs;
 
 bool ArchivePtrMarker::_compacted;
+bool ArchivePtrMarker::_parallel = false;
 
 void ArchivePtrMarker::initialize(CHeapBitMap* ptrmap, VirtualSpace* vs) {
   assert(_ptrmap == NULL, "initialize only once");
@@ -77,6 +78,11 @@ void ArchivePtrMarker::mark_pointer(address* ptr_loc) {
     if (value != NULL) {
       assert(uintx(ptr_loc) % sizeof(intptr_t) == 0, "pointers must be stored in aligned addresses");
       size_t idx = ptr_loc - ptr_base();
+      if (_parallel) {
+        assert(idx < _ptrmap->size(), "sized by begin_parallel_marking");
+        _ptrmap->par_set_bit(idx);
+        return;
+      }
       if (_ptrmap->size() <= idx) {
         _ptrmap->resize((idx + 1) * 2);
       }
@@ -87,6 +93,19 @@ void ArchivePtrMarker::mark_pointer(address* ptr_loc) {
   }
 }
 
+void ArchivePtrMarker::begin_parallel_marking() {
+  assert(!_compacted, "cannot mark anymore");
+  size_t size = ptr_end() - ptr_base();
+  if (_ptrmap->size() < size) {
+    _ptrmap->resize(size);
+  }
+  _parallel = true;
+}
+
+void ArchivePtrMarker::end_parallel_marking() {
+  _parallel = false;
+}
+
 void ArchivePtrMarker::clear_pointer(address* ptr_loc) {
   assert(_ptrmap != NULL, "not initialized");
   assert(!_compacted, "cannot clear anymore");
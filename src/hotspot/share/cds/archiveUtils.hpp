@@ -47,6 +47,9 @@ class ArchivePtrMarker : AllStatic {
   // avoid unintentional copy operations after the bitmap has been finalized and written.
   static bool         _compacted;
 
+  // While set, pointers may be marked by several threads at once.
+  static bool         _parallel;
+
   static address* ptr_base() { return (address*)_vs->low();  } // committed lower bound (inclusive)
   static address* ptr_end()  { return (address*)_vs->high(); } // committed upper bound (exclusive)
 
@@ -57,6 +60,11 @@ public:
   static void compact(address relocatable_base, address relocatable_end);
   static void compact(size_t max_non_null_offset);
 
+  // Sizes the bitmap for the whole committed buffer, so that no resizing
+  // is needed until end_parallel_marking().
+  static void begin_parallel_marking();
+  static void end_parallel_marking();
+
   template <typename T>
   static void mark_pointer(T* ptr_loc) {
     mark_pointer((address*)ptr_loc);
@@ -1543,13 +1543,26 @@ MapArchiveResult FileMapInfo::map_regions(int regions[], int num_regions, char*
   return MAP_ARCHIVE_SUCCESS;
 }
 
-bool FileMapInfo::read_region(int i, char* base, size_t size) {
-  assert(MetaspaceShared::use_windows_memory_mapping(), "used by windows only");
+// Large pages are anonymous memory committed into the ReservedSpace that
+// covers the archives, so we can only use them when one was reserved.
+static bool read_into_large_pages(ReservedSpace rs) {
+#ifdef LINUX
+  return SharedArchiveLargePages && UseTransparentHugePages && rs.is_reserved();
+#else
+  return false;
+#endif
+}
+
+bool FileMapInfo::read_region(int i, char* base, size_t size, bool large_pages) {
+  assert(MetaspaceShared::use_windows_memory_mapping() || large_pages, "used by windows or for large pages only");
   FileMapRegion* si = space_at(i);
-  log_info(cds)("Commit %s region #%d at base " INTPTR_FORMAT " top " INTPTR_FORMAT " (%s)%s",
+  log_info(cds)("Commit %s region #%d at base " INTPTR_FORMAT " top " INTPTR_FORMAT " (%s)%s%s",
                 is_static() ? "static " : "dynamic", i, p2i(base), p2i(base + size),
-                shared_region_name[i], si->allow_exec() ? " exec" : "");
-  if (!os::commit_memory(base, size, si->allow_exec())) {
+                shared_region_name[i], si->allow_exec() ? " exec" : "", large_pages ? " large pages" : "");
+  // The alignment hint makes os::commit_memory() madvise the range for
+  // transparent huge pages before read_bytes() faults it in.
+  size_t alignment_hint = large_pages ? os::large_page_size() : os::vm_page_size();
+  if (!os::commit_memory(base, size, alignment_hint, si->allow_exec())) {
     log_error(cds)("Failed to commit %s region #%d (%s)", is_static() ? "static " : "dynamic",
                    i, shared_region_name[i]);
     return false;
@@ -1571,9 +1584,11 @@ MapArchiveResult FileMapInfo::map_region(int i, intx addr_delta, char* mapped_ba
 
   si->set_mapped_from_file(false);
 
-  if (MetaspaceShared::use_windows_memory_mapping()) {
+  bool large_pages = read_into_large_pages(rs);
+  if (MetaspaceShared::use_windows_memory_mapping() || large_pages) {
     // Windows cannot remap read-only shared memory to read-write when required for
     // RedefineClasses, which is also used by JFR.  Always map windows regions as RW.
+    // Regions read into large pages are anonymous memory and are RW as well.
     si->set_read_only(false);
   } else if (JvmtiExport::can_modify_any_class() || JvmtiExport::can_walk_any_space() ||
              Arguments::has_jfr_option()) {
@@ -1588,11 +1603,19 @@ MapArchiveResult FileMapInfo::map_region(int i, intx addr_delta, char* mapped_ba
     // that covers all the FileMapRegions to ensure all regions can be mapped. However, Windows
     // can't mmap into a ReservedSpace, so we just os::read() the data. We're going to patch all the
     // regions anyway, so there's no benefit for mmap anyway.
-    if (!read_region(i, requested_addr, size)) {
+    if (!read_region(i, requested_addr, size, false)) {
       log_info(cds)("Failed to read %s shared space into reserved space at " INTPTR_FORMAT,
                     shared_region_name[i], p2i(requested_addr));
       return MAP_ARCHIVE_OTHER_FAILURE; // oom or I/O error.
     }
+  } else if (large_pages) {
+    // Copy the region into THP-backed memory instead of mapping the file with
+    // small pages. This gives up sharing the archive pages between processes.
+    if (!read_region(i, requested_addr, size, true)) {
+      log_info(cds)("Failed to read %s shared space into large pages at " INTPTR_FORMAT,
+                    shared_region_name[i], p2i(requested_addr));
+      return MAP_ARCHIVE_OTHER_FAILURE; // oom or I/O error.
+    }
   } else {
     // Note that this may either be a "fresh" mapping into unreserved address
     // space (Windows, first mapping attempt), or a mapping into pre-reserved
@@ -149,6 +149,10 @@ class HeapShared: AllStatic {
   static DumpedInternedStrings *_dumped_interned_strings;
 
 public:
+  // Sizes of the dump time object tables, which grow with the heap archived
+  static const unsigned INITIAL_TABLE_SIZE = 15889; // prime number
+  static const unsigned MAX_TABLE_SIZE     = 1000000;
+
   static bool oop_equals(oop const& p1, oop const& p2) {
     return p1 == p2;
   }
@@ -158,10 +162,9 @@ public:
   }
 
 private:
-  typedef ResourceHashtable<oop, oop,
+  typedef ResizeableResourceHashtable<oop, oop,
       HeapShared::oop_hash,
       HeapShared::oop_equals,
-      15889, // prime number
       ResourceObj::C_HEAP> ArchivedObjectCache;
   static ArchivedObjectCache* _archived_object_cache;
 
@@ -230,10 +233,9 @@ private:
   static address _narrow_oop_base;
   static int     _narrow_oop_shift;
 
-  typedef ResourceHashtable<oop, bool,
+  typedef ResizeableResourceHashtable<oop, bool,
       HeapShared::oop_hash,
       HeapShared::oop_equals,
-      15889, // prime number
       ResourceObj::C_HEAP> SeenObjectsTable;
 
   static SeenObjectsTable *_seen_objects_table;
@@ -244,7 +246,8 @@ private:
 
   static void init_seen_objects_table() {
     assert(_seen_objects_table == NULL, "must be");
-    _seen_objects_table = new (ResourceObj::C_HEAP, mtClass)SeenObjectsTable();
+    // Most subgraphs are small, start small
+    _seen_objects_table = new (ResourceObj::C_HEAP, mtClass)SeenObjectsTable(137, MAX_TABLE_SIZE);
   }
   static void delete_seen_objects_table() {
     assert(_seen_objects_table != NULL, "must be");
@@ -286,7 +289,7 @@ private:
   static void reset_archived_object_states(TRAPS);
   static void create_archived_object_cache() {
     _archived_object_cache =
-      new (ResourceObj::C_HEAP, mtClass)ArchivedObjectCache();
+      new (ResourceObj::C_HEAP, mtClass)ArchivedObjectCache(INITIAL_TABLE_SIZE, MAX_TABLE_SIZE);
   }
   static void destroy_archived_object_cache() {
     delete _archived_object_cache;
@@ -407,12 +410,19 @@ private:
 
 #if INCLUDE_CDS_JAVA_HEAP
 class DumpedInternedStrings :
-  public ResourceHashtable<oop, bool,
-                           HeapShared::string_oop_hash,
-                           HeapShared::oop_equals,
-                           15889, // prime number
-                           ResourceObj::C_HEAP>
-{};
+  public ResizeableResourceHashtable<oop, bool,
+                                     HeapShared::string_oop_hash,
+                                     HeapShared::oop_equals,
+                                     ResourceObj::C_HEAP>
+{
+public:
+  DumpedInternedStrings() :
+    ResizeableResourceHashtable<oop, bool,
+                                HeapShared::string_oop_hash,
+                                HeapShared::oop_equals,
+                                ResourceObj::C_HEAP>(HeapShared::INITIAL_TABLE_SIZE,
+                                                     HeapShared::MAX_TABLE_SIZE) {}
+};
 #endif
 
 #endif // SHARE_CDS_HEAPSHARED_HPP
@@ -63,10 +63,14 @@
 #include "oops/oopHandle.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/nonJavaThread.hpp"
 #include "runtime/os.hpp"
+#include "runtime/perfData.hpp"
 #include "runtime/safepointVerifiers.hpp"
 #include "runtime/sharedRuntime.hpp"
+#include "runtime/timer.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vmOperations.hpp"
 #include "utilities/align.hpp"
@@ -868,9 +872,70 @@ bool MetaspaceShared::is_shared_dynamic(void* p) {
   }
 }
 
+// Touches every page of the mapped archive(s) once, so that the page faults
+// are taken on this thread rather than by the threads using the classes.
+class SharedArchivePrefaultThread : public NamedThread {
+  char* _base[2];
+  char* _end[2];
+  int _count;
+
+ public:
+  SharedArchivePrefaultThread() : NamedThread(), _count(0) {
+    set_name("CDS Prefault Thread");
+  }
+
+  void add(FileMapInfo* mapinfo) {
+    assert(_count < 2, "static and dynamic archive only");
+    _base[_count] = mapinfo->mapped_base();
+    _end[_count] = mapinfo->mapped_end();
+    _count++;
+  }
+
+  bool is_empty() const { return _count == 0; }
+
+  virtual void run() {
+    elapsedTimer timer;
+    timer.start();
+    size_t touched = 0;
+    for (int i = 0; i < _count; i++) {
+      for (char* p = _base[i]; p < _end[i]; p += os::vm_page_size()) {
+        Atomic::load(p);
+      }
+      touched += pointer_delta(_end[i], _base[i], 1);
+    }
+    timer.stop();
+    log_info(cds)("Prefaulted " SIZE_FORMAT "K of shared archive(s) in %.3f ms",
+                  touched / K, timer.seconds() * 1000.0);
+  }
+
+  virtual void post_run() {
+    NamedThread::post_run();
+    delete this;
+  }
+};
+
+static void start_prefault_thread(FileMapInfo* static_mapinfo, FileMapInfo* dynamic_mapinfo) {
+  SharedArchivePrefaultThread* thread = new SharedArchivePrefaultThread();
+  FileMapInfo* infos[] = { static_mapinfo, dynamic_mapinfo };
+  for (FileMapInfo* mapinfo : infos) {
+    // Regions read from the file rather than mapped are already populated.
+    if (mapinfo != NULL && mapinfo->is_mapped() &&
+        mapinfo->space_at(MetaspaceShared::rw)->mapped_from_file()) {
+      thread->add(mapinfo);
+    }
+  }
+  if (!thread->is_empty() && os::create_thread(thread, os::os_thread)) {
+    os::start_thread(thread);
+  } else {
+    delete thread;
+  }
+}
+
 void MetaspaceShared::initialize_runtime_shared_and_meta_spaces() {
   assert(UseSharedSpaces, "Must be called when UseSharedSpaces is enabled");
   MapArchiveResult result = MAP_ARCHIVE_OTHER_FAILURE;
+  elapsedTimer map_timer;
+  map_timer.start();
 
   FileMapInfo* static_mapinfo = open_static_archive();
   FileMapInfo* dynamic_mapinfo = NULL;
@@ -889,6 +954,15 @@ void MetaspaceShared::initialize_runtime_shared_and_meta_spaces() {
     }
   }
 
+  map_timer.stop();
+  log_info(cds)("Mapping shared archive(s) took %.3f ms", map_timer.seconds() * 1000.0);
+  if (UsePerfData) {
+    EXCEPTION_MARK;
+    PerfDataManager::create_constant(SUN_CLS, "sharedArchiveMapTime", PerfData::U_Ticks,
+                                     map_timer.ticks(), THREAD);
+    CLEAR_PENDING_EXCEPTION;
+  }
+
   if (result == MAP_ARCHIVE_SUCCESS) {
     bool dynamic_mapped = (dynamic_mapinfo != NULL && dynamic_mapinfo->is_mapped());
     char* cds_base = static_mapinfo->mapped_base();
@@ -901,6 +975,9 @@ void MetaspaceShared::initialize_runtime_shared_and_meta_spaces() {
     } else {
       FileMapInfo::set_shared_path_table(static_mapinfo);
     }
+    if (SharedArchivePrefault) {
+      start_prefault_thread(static_mapinfo, dynamic_mapinfo);
+    }
   } else {
     set_shared_metaspace_range(NULL, NULL, NULL);
     UseSharedSpaces = false;
@@ -1362,6 +1439,8 @@ class CountSharedSymbols : public SymbolClosure {
   void do_symbol(Symbol** sym) {
     _count++;
   }
+
+  bool is_empty() const { return _count == 0; }
   int total() { return _count; }
 
 };
@@ -33,6 +33,9 @@
 // This class is used to determine the frequently called method
 // at some call site
 class ciCallProfile : StackObj {
+public:
+  enum { ReceiverLimit = 8 }; // Max receivers recorded, the TypeProfileWidth range
+
 private:
   // Fields are initialized directly by ciMethod::call_profile_at_bci.
   friend class ciMethod;
@@ -42,8 +45,8 @@ private:
   int  _limit;                // number of receivers have been determined
   int  _morphism;             // determined call site's morphism
   int  _count;                // # times has this call been executed
-  int  _receiver_count[MorphismLimit + 1]; // # times receivers have been seen
-  ciKlass*  _receiver[MorphismLimit + 1];  // receivers (exact)
+  int  _receiver_count[ReceiverLimit + 1]; // # times receivers have been seen
+  ciKlass*  _receiver[ReceiverLimit + 1];  // receivers (exact)
 
   ciCallProfile() {
     _limit = 0;
@@ -62,15 +65,15 @@ public:
 
   int       count() const             { return _count; }
   int       receiver_count(int i)  {
-    assert(i < _limit, "out of Call Profile MorphismLimit");
+    assert(i < _limit, "out of Call Profile ReceiverLimit");
     return _receiver_count[i];
   }
   float     receiver_prob(int i)  {
-    assert(i < _limit, "out of Call Profile MorphismLimit");
+    assert(i < _limit, "out of Call Profile ReceiverLimit");
     return (float)_receiver_count[i]/(float)_count;
   }
   ciKlass*  receiver(int i)        {
-    assert(i < _limit, "out of Call Profile MorphismLimit");
+    assert(i < _limit, "out of Call Profile ReceiverLimit");
     return _receiver[i];
   }
 };
@@ -29,6 +29,7 @@
 #include "classfile/classFileStream.hpp"
 #include "classfile/classLoader.inline.hpp"
 #include "classfile/classLoaderData.inline.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
 #include "classfile/classLoaderExt.hpp"
 #include "classfile/classLoadInfo.hpp"
 #include "classfile/javaClasses.hpp"
@@ -60,11 +61,13 @@
 #include "oops/symbol.hpp"
 #include "prims/jvm_misc.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/init.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/java.hpp"
 #include "runtime/javaCalls.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "runtime/perfData.hpp"
 #include "runtime/threadCritical.hpp"
@@ -123,6 +126,9 @@ PerfCounter*    ClassLoader::_perf_class_verify_selftime = NULL;
 PerfCounter*    ClassLoader::_perf_classes_linked = NULL;
 PerfCounter*    ClassLoader::_perf_class_link_time = NULL;
 PerfCounter*    ClassLoader::_perf_class_link_selftime = NULL;
+PerfCounter*    ClassLoader::_perf_classes_parsed = NULL;
+PerfCounter*    ClassLoader::_perf_class_parse_time = NULL;
+PerfCounter*    ClassLoader::_perf_class_parse_selftime = NULL;
 PerfCounter*    ClassLoader::_perf_sys_class_lookup_time = NULL;
 PerfCounter*    ClassLoader::_perf_shared_classload_time = NULL;
 PerfCounter*    ClassLoader::_perf_sys_classload_time = NULL;
@@ -781,15 +787,19 @@ ClassPathZipEntry* ClassLoader::create_class_path_zip_entry(const char *path, bo
 // The boot append entries are added with a lock, and read lock free.
 void ClassLoader::add_to_boot_append_entries(ClassPathEntry *new_entry) {
   if (new_entry != NULL) {
-    MutexLocker ml(Bootclasspath_lock, Mutex::_no_safepoint_check_flag);
-    if (_last_append_entry == NULL) {
-      _last_append_entry = new_entry;
-      assert(first_append_entry() == NULL, "boot loader's append class path entry list not empty");
-      Atomic::release_store(&_first_append_entry_list, new_entry);
-    } else {
-      _last_append_entry->set_next(new_entry);
-      _last_append_entry = new_entry;
+    {
+      MutexLocker ml(Bootclasspath_lock, Mutex::_no_safepoint_check_flag);
+      if (_last_append_entry == NULL) {
+        _last_append_entry = new_entry;
+        assert(first_append_entry() == NULL, "boot loader's append class path entry list not empty");
+        Atomic::release_store(&_first_append_entry_list, new_entry);
+      } else {
+        _last_append_entry->set_next(new_entry);
+        _last_append_entry = new_entry;
+      }
     }
+    // The boot loader may now find classes it failed to find before.
+    SystemDictionary::clear_boot_loader_misses();
   }
 }
 
@@ -1384,6 +1394,9 @@ void ClassLoader::initialize(TRAPS) {
     NEWPERFEVENTCOUNTER(_perf_classes_inited, SUN_CLS, "initializedClasses");
     NEWPERFEVENTCOUNTER(_perf_classes_linked, SUN_CLS, "linkedClasses");
     NEWPERFEVENTCOUNTER(_perf_classes_verified, SUN_CLS, "verifiedClasses");
+    NEWPERFTICKCOUNTER(_perf_class_parse_time, SUN_CLS, "classParseTime");
+    NEWPERFTICKCOUNTER(_perf_class_parse_selftime, SUN_CLS, "classParseTime.self");
+    NEWPERFEVENTCOUNTER(_perf_classes_parsed, SUN_CLS, "parsedClasses");
 
     NEWPERFTICKCOUNTER(_perf_sys_class_lookup_time, SUN_CLS, "lookupSysClassTime");
     NEWPERFTICKCOUNTER(_perf_shared_classload_time, SUN_CLS, "sharedClassLoadTime");
@@ -1631,9 +1644,98 @@ PerfClassTraceTime::~PerfClassTraceTime() {
   if (_selftimep != NULL) {
     _selftimep->inc(selftime);
   }
+  if (_loader_data != NULL) {
+    _loader_data->add_class_event_ticks(_event_type, selftime);
+  }
   // add all class loading related event selftime to the accumulated time counter
   ClassLoader::perf_accumulated_time()->inc(selftime);
 
   // reset the timer
   _timers[_event_type].reset();
 }
+
+STATIC_ASSERT(ClassLoaderData::class_event_type_count == PerfClassTraceTime::EVENT_TYPE_COUNT);
+
+// The slowest class initializers so far, slowest first. The names are kept
+// alive by a refcount, and the loader names are copied, so that entries
+// outlive the unloading of their classes.
+struct SlowClassInit {
+  Symbol* _name;
+  char*   _loader;
+  jlong   _ticks;
+};
+
+static const int slow_class_init_count = 10;
+static SlowClassInit _slow_class_inits[slow_class_init_count];
+// Time of the last entry, for filtering without the lock.
+static volatile jlong _slow_class_init_min_ticks = 0;
+
+void ClassLoader::record_class_init_time(InstanceKlass* ik, jlong ticks) {
+  if (ticks <= Atomic::load(&_slow_class_init_min_ticks)) {
+    return;
+  }
+  ResourceMark rm;
+  const char* loader = ik->class_loader_data()->loader_name_and_id();
+  MutexLocker ml(ClassInitTimes_lock, Mutex::_no_safepoint_check_flag);
+  int i = slow_class_init_count - 1;
+  if (ticks <= _slow_class_inits[i]._ticks) {
+    return;
+  }
+  if (_slow_class_inits[i]._name != NULL) {
+    _slow_class_inits[i]._name->decrement_refcount();
+    os::free(_slow_class_inits[i]._loader);
+  }
+  for (; i > 0 && _slow_class_inits[i - 1]._ticks < ticks; i--) {
+    _slow_class_inits[i] = _slow_class_inits[i - 1];
+  }
+  ik->name()->increment_refcount();
+  _slow_class_inits[i]._name = ik->name();
+  _slow_class_inits[i]._loader = os::strdup(loader, mtClass);
+  _slow_class_inits[i]._ticks = ticks;
+  Atomic::store(&_slow_class_init_min_ticks, _slow_class_inits[slow_class_init_count - 1]._ticks);
+}
+
+class PrintClassLoadTimesClosure : public CLDClosure {
+  outputStream* _st;
+ public:
+  PrintClassLoadTimesClosure(outputStream* st) : _st(st) {}
+
+  void do_cld(ClassLoaderData* cld) {
+    static const int types[] = { PerfClassTraceTime::CLASS_PARSE, PerfClassTraceTime::CLASS_LINK,
+                                 PerfClassTraceTime::CLASS_VERIFY, PerfClassTraceTime::CLASS_CLINIT };
+    jlong total = 0;
+    for (int type : types) {
+      total += cld->class_event_ticks(type);
+    }
+    if (total == 0) {
+      return;
+    }
+    for (int type : types) {
+      _st->print("%10.3f ", TimeHelper::counter_to_millis(cld->class_event_ticks(type)));
+    }
+    _st->print_cr(" %s", cld->loader_name_and_id());
+  }
+};
+
+void ClassLoader::print_class_load_times(outputStream* st) {
+  if (!UsePerfData) {
+    st->print_cr("Class loading times are only recorded with -XX:+UsePerfData");
+    return;
+  }
+  ResourceMark rm;
+  st->print_cr("Exclusive class loading times per class loader (ms):");
+  st->print_cr("%10s %10s %10s %10s  %s", "Parse", "Link", "Verify", "Init", "Loader");
+  {
+    MutexLocker ml(ClassLoaderDataGraph_lock);
+    PrintClassLoadTimesClosure cl(st);
+    ClassLoaderDataGraph::loaded_cld_do(&cl);
+  }
+
+  st->cr();
+  st->print_cr("Slowest class initializers (ms, including the classes they initialize):");
+  MutexLocker ml(ClassInitTimes_lock, Mutex::_no_safepoint_check_flag);
+  for (int i = 0; i < slow_class_init_count && _slow_class_inits[i]._name != NULL; i++) {
+    st->print_cr("%10.3f  %s (%s)", TimeHelper::counter_to_millis(_slow_class_inits[i]._ticks),
+                 _slow_class_inits[i]._name->as_C_string(), _slow_class_inits[i]._loader);
+  }
+}
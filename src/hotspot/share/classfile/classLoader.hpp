@@ -169,6 +169,9 @@ class ClassLoader: AllStatic {
   static PerfCounter* _perf_classes_linked;
   static PerfCounter* _perf_class_link_time;
   static PerfCounter* _perf_class_link_selftime;
+  static PerfCounter* _perf_classes_parsed;
+  static PerfCounter* _perf_class_parse_time;
+  static PerfCounter* _perf_class_parse_selftime;
   static PerfCounter* _perf_sys_class_lookup_time;
   static PerfCounter* _perf_shared_classload_time;
   static PerfCounter* _perf_sys_classload_time;
@@ -276,6 +279,12 @@ class ClassLoader: AllStatic {
                                            bool from_class_path_attr);
   static void print_bootclasspath();
 
+  // Remember the time the class initializer of ik took if it is among the
+  // slowest so far.
+  static void record_class_init_time(InstanceKlass* ik, jlong ticks);
+  // Print the per-loader class loading times and the slowest class initializers.
+  static void print_class_load_times(outputStream* st);
+
   // Timing
   static PerfCounter* perf_accumulated_time()         { return _perf_accumulated_time; }
   static PerfCounter* perf_classes_inited()           { return _perf_classes_inited; }
@@ -287,6 +296,9 @@ class ClassLoader: AllStatic {
   static PerfCounter* perf_classes_linked()           { return _perf_classes_linked; }
   static PerfCounter* perf_class_link_time()          { return _perf_class_link_time; }
   static PerfCounter* perf_class_link_selftime()      { return _perf_class_link_selftime; }
+  static PerfCounter* perf_classes_parsed()           { return _perf_classes_parsed; }
+  static PerfCounter* perf_class_parse_time()         { return _perf_class_parse_time; }
+  static PerfCounter* perf_class_parse_selftime()     { return _perf_class_parse_selftime; }
   static PerfCounter* perf_sys_class_lookup_time()    { return _perf_sys_class_lookup_time; }
   static PerfCounter* perf_shared_classload_time()    { return _perf_shared_classload_time; }
   static PerfCounter* perf_sys_classload_time()       { return _perf_sys_classload_time; }
@@ -416,7 +428,8 @@ class PerfClassTraceTime {
     CLASS_VERIFY = 2,
     CLASS_CLINIT = 3,
     DEFINE_CLASS = 4,
-    EVENT_TYPE_COUNT = 5
+    CLASS_PARSE  = 5,
+    EVENT_TYPE_COUNT = 6
   };
  protected:
   // _t tracks time from initialization to destruction of this timer instance
@@ -434,6 +447,9 @@ class PerfClassTraceTime {
   elapsedTimer*    _timers;
   int              _event_type;
   int              _prev_active_event;
+  // loader whose per-loader times get the exclusive time, see
+  // ClassLoaderData::class_event_ticks()
+  ClassLoaderData* _loader_data;
 
  public:
 
@@ -442,15 +458,18 @@ class PerfClassTraceTime {
                             PerfLongCounter* eventp,    /* event counter */
                             int* recursion_counters,    /* thread-local recursion counter array */
                             elapsedTimer* timers,       /* thread-local timer array */
-                            int type                    /* event type */ ) :
-      _timep(timep), _selftimep(selftimep), _eventp(eventp), _recursion_counters(recursion_counters), _timers(timers), _event_type(type) {
+                            int type,                   /* event type */
+                            ClassLoaderData* loader_data = NULL /* loader of the class */ ) :
+      _timep(timep), _selftimep(selftimep), _eventp(eventp), _recursion_counters(recursion_counters), _timers(timers), _event_type(type),
+      _loader_data(loader_data) {
     initialize();
   }
 
   inline PerfClassTraceTime(PerfLongCounter* timep,     /* counter incremented with inclusive time */
                             elapsedTimer* timers,       /* thread-local timer array */
                             int type                    /* event type */ ) :
-      _timep(timep), _selftimep(NULL), _eventp(NULL), _recursion_counters(NULL), _timers(timers), _event_type(type) {
+      _timep(timep), _selftimep(NULL), _eventp(NULL), _recursion_counters(NULL), _timers(timers), _event_type(type),
+      _loader_data(NULL) {
     initialize();
   }
 
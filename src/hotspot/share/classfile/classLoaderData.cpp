@@ -176,6 +176,10 @@ ClassLoaderData::ClassLoaderData(Handle h_class_loader, bool has_class_mirror_ho
 
   NOT_PRODUCT(_dependency_count = 0); // number of class loader dependencies
 
+  for (int i = 0; i < class_event_type_count; i++) {
+    _class_event_ticks[i] = 0;
+  }
+
   JFR_ONLY(INIT_ID(this);)
 }
 
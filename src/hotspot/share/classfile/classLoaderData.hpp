@@ -159,6 +159,16 @@ class ClassLoaderData : public CHeapObj<mtClass> {
   Symbol* _name_and_id;
   JFR_ONLY(DEFINE_TRACE_ID_FIELD;)
 
+ public:
+  // Number of PerfClassTraceTime event types.
+  static const int class_event_type_count = 6;
+
+ private:
+  // Exclusive time in ticks spent on the class loading events of the classes
+  // of this loader, indexed by PerfClassTraceTime event type. Recorded only
+  // with UsePerfData.
+  volatile jlong _class_event_ticks[class_event_type_count];
+
   void set_next(ClassLoaderData* next) { _next = next; }
   ClassLoaderData* next() const        { return Atomic::load(&_next); }
 
@@ -326,6 +336,11 @@ class ClassLoaderData : public CHeapObj<mtClass> {
     return (unsigned)((uintptr_t)this >> 3);
   }
 
+  void add_class_event_ticks(int type, jlong ticks) {
+    Atomic::add(&_class_event_ticks[type], ticks, memory_order_relaxed);
+  }
+  jlong class_event_ticks(int type) const { return Atomic::load(&_class_event_ticks[type]); }
+
   JFR_ONLY(DEFINE_TRACE_ID_METHODS;)
 };
 
@@ -79,6 +79,10 @@ void ClassLoaderStatsClosure::do_cld(ClassLoaderData* cld) {
   }
   _total_classes += csc._num_classes;
 
+  for (int i = 0; i < ClassLoaderData::class_event_type_count; i++) {
+    cls->_class_event_ticks[i] += cld->class_event_ticks(i);
+  }
+
   ClassLoaderMetaspace* ms = cld->metaspace_or_null();
   if (ms != NULL) {
     size_t used_bytes, capacity_bytes;
@@ -81,6 +81,9 @@ public:
   size_t            _hidden_block_sz;
   uintx             _hidden_classes_count;
 
+  // Summed ClassLoaderData::class_event_ticks(), including hidden classes.
+  jlong             _class_event_ticks[ClassLoaderData::class_event_type_count];
+
   ClassLoaderStats() :
     _cld(0),
     _class_loader(0),
@@ -91,6 +94,9 @@ public:
     _hidden_chunk_sz(0),
     _hidden_block_sz(0),
     _hidden_classes_count(0) {
+    for (int i = 0; i < ClassLoaderData::class_event_type_count; i++) {
+      _class_event_ticks[i] = 0;
+    }
   }
 };
 
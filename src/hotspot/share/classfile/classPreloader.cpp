@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jvm_io.h"
+#include "classfile/classPreloader.hpp"
+#include "classfile/javaClasses.hpp"
+#include "classfile/symbolTable.hpp"
+#include "classfile/systemDictionary.hpp"
+#include "classfile/vmClasses.hpp"
+#include "classfile/vmSymbols.hpp"
+#include "logging/log.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
+#include "oops/instanceKlass.hpp"
+#include "runtime/arguments.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/javaCalls.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.inline.hpp"
+#include "utilities/growableArray.hpp"
+
+// Written once by initialize, then handed out to the threads in order.
+static Symbol** _classes = NULL;
+static int _class_count = 0;
+static volatile int _next_class = 0;
+
+static volatile uint _active_threads = 0;
+static jlong _start_nanos = 0;
+
+static volatile int _loaded_count = 0;
+static volatile int _linked_count = 0;
+static volatile int _failed_count = 0;
+
+// Reads the class names from a class list: the first word of each line,
+// skipping comments and the '@' lines of CDS class lists.
+static GrowableArray<Symbol*>* parse(FILE* f) {
+  GrowableArray<Symbol*>* classes = new GrowableArray<Symbol*>(1024);
+  char line[4 * 1024];
+  while (fgets(line, sizeof(line), f) != NULL) {
+    if (line[0] == '#' || line[0] == '@') {
+      continue;
+    }
+    size_t len = strcspn(line, " \t\r\n");
+    if (len == 0) {
+      continue;
+    }
+    line[len] = '\0';
+    for (char* p = line; *p != '\0'; p++) {
+      if (*p == '.') {
+        *p = '/';
+      }
+    }
+    // Released once all threads are done.
+    classes->append(SymbolTable::new_symbol(line));
+  }
+  return classes;
+}
+
+static void preload(Symbol* name, TRAPS) {
+  Handle loader(THREAD, SystemDictionary::java_system_loader());
+  Klass* k = SystemDictionary::resolve_or_null(name, loader, Handle(), CHECK);
+  if (k == NULL) {
+    Atomic::inc(&_failed_count);
+    return;
+  }
+  Atomic::inc(&_loaded_count);
+  if (k->is_instance_klass() && !InstanceKlass::cast(k)->is_linked()) {
+    InstanceKlass::cast(k)->link_class(CHECK);
+    Atomic::inc(&_linked_count);
+  }
+}
+
+static void finish() {
+  log_info(class, preload)("Loaded %d and linked %d classes of %s in " JLONG_FORMAT " ms, %d failed",
+                           _loaded_count, _linked_count, PreloadClassListFile,
+                           nanos_to_millis(os::javaTimeNanos() - _start_nanos), _failed_count);
+  for (int i = 0; i < _class_count; i++) {
+    _classes[i]->decrement_refcount();
+  }
+  FREE_C_HEAP_ARRAY(Symbol*, _classes);
+  _classes = NULL;
+}
+
+static void preload_thread_entry(JavaThread* thread, TRAPS) {
+  for (int i = Atomic::fetch_and_add(&_next_class, 1); i < _class_count;
+       i = Atomic::fetch_and_add(&_next_class, 1)) {
+    HandleMark hm(THREAD);
+    ResourceMark rm(THREAD);
+    preload(_classes[i], THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      if (log_is_enabled(Debug, class, preload)) {
+        log_debug(class, preload)("Failed to preload %s: %s", _classes[i]->as_C_string(),
+                                  PENDING_EXCEPTION->klass()->external_name());
+      }
+      // The application gets the error if it loads the class itself.
+      CLEAR_PENDING_EXCEPTION;
+      Atomic::inc(&_failed_count);
+    }
+  }
+  if (Atomic::sub(&_active_threads, 1u) == 0) {
+    finish();
+  }
+}
+
+static void create_thread(uint id, TRAPS) {
+  char name[64];
+  jio_snprintf(name, sizeof(name), "Class Preload Thread#%u", id);
+  Handle string = java_lang_String::create_from_str(name, CHECK);
+
+  // Initialize thread_oop to put it into the system threadGroup
+  Handle thread_group (THREAD, Universe::system_thread_group());
+  Handle thread_oop = JavaCalls::construct_new_instance(
+                          vmClasses::Thread_klass(),
+                          vmSymbols::threadgroup_string_void_signature(),
+                          thread_group,
+                          string,
+                          CHECK);
+
+  JavaThread* thread = new JavaThread(&preload_thread_entry);
+  JavaThread::vm_exit_on_osthread_failure(thread);
+
+  JavaThread::start_internal_daemon(THREAD, thread, thread_oop, NormPriority);
+}
+
+void ClassPreloader::initialize(TRAPS) {
+  if (PreloadClassListFile == NULL || Arguments::is_dumping_archive()) {
+    return;
+  }
+  FILE* f = os::fopen(PreloadClassListFile, "r");
+  if (f == NULL) {
+    log_warning(class, preload)("Failed to open %s", PreloadClassListFile);
+    return;
+  }
+  _start_nanos = os::javaTimeNanos();
+  {
+    ResourceMark rm(THREAD);
+    GrowableArray<Symbol*>* classes = parse(f);
+    _class_count = classes->length();
+    _classes = NEW_C_HEAP_ARRAY(Symbol*, MAX2(_class_count, 1), mtClass);
+    for (int i = 0; i < _class_count; i++) {
+      _classes[i] = classes->at(i);
+    }
+  }
+  fclose(f);
+  log_info(class, preload)("Preloading %d classes of %s on %u threads",
+                           _class_count, PreloadClassListFile, PreloadClassThreads);
+
+  _active_threads = PreloadClassThreads;
+  for (uint i = 0; i < PreloadClassThreads; i++) {
+    create_thread(i, CHECK);
+  }
+}
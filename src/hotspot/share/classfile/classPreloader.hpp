@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_CLASSFILE_CLASSPRELOADER_HPP
+#define SHARE_CLASSFILE_CLASSPRELOADER_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/exceptions.hpp"
+
+// Loads and links the classes named in -XX:PreloadClassListFile on
+// PreloadClassThreads background threads during startup, in list order.
+// The threads run ahead of the application, so that by the time it needs
+// a listed class, the class has been parsed, and verified when linked,
+// on another core.  A class is loaded through the system class loader,
+// so it ends up where the application would have loaded it from, and is
+// found there by the application's own load request.
+//
+// Loading and linking without initialization are allowed to happen at
+// any time.  Failures are ignored: errors are thrown when and where the
+// application itself loads or links the class.
+class ClassPreloader : AllStatic {
+public:
+  // Read PreloadClassListFile and start the threads.  Called once the
+  // system class loader is set up.
+  static void initialize(TRAPS);
+};
+
+#endif // SHARE_CLASSFILE_CLASSPRELOADER_HPP
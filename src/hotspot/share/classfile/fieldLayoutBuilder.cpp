@@ -26,6 +26,8 @@
 #include "jvm.h"
 #include "classfile/classFileParser.hpp"
 #include "classfile/fieldLayoutBuilder.hpp"
+#include "classfile/symbolTable.hpp"
+#include "logging/log.hpp"
 #include "memory/resourceArea.hpp"
 #include "oops/array.hpp"
 #include "oops/fieldStreams.inline.hpp"
@@ -33,6 +35,8 @@
 #include "oops/instanceKlass.inline.hpp"
 #include "oops/klass.inline.hpp"
 #include "runtime/fieldDescriptor.inline.hpp"
+#include "runtime/os.hpp"
+#include "utilities/resourceHash.hpp"
 
 
 LayoutRawBlock::LayoutRawBlock(Kind kind, int size) :
@@ -506,6 +510,8 @@ FieldLayoutBuilder::FieldLayoutBuilder(const Symbol* classname, const InstanceKl
   _fields(fields),
   _info(info),
   _root_group(NULL),
+  _hot_group(NULL),
+  _hot_field_names(NULL),
   _contended_groups(GrowableArray<FieldGroup*>(8)),
   _static_fields(NULL),
   _layout(NULL),
@@ -516,6 +522,67 @@ FieldLayoutBuilder::FieldLayoutBuilder(const Symbol* classname, const InstanceKl
   _is_contended(is_contended) {}
 
 
+// Hot field names by class name. Both are permanent symbols, so the
+// table can be keyed by address. Written once during VM startup.
+typedef ResourceHashtable<Symbol*, GrowableArray<Symbol*>*,
+                          primitive_hash<Symbol*>, primitive_equals<Symbol*>,
+                          1031, ResourceObj::C_HEAP, mtClass> HotFieldTable;
+static HotFieldTable* _hot_fields = NULL;
+
+void FieldLayoutBuilder::load_hot_fields() {
+  if (HotFieldsFile == NULL) {
+    return;
+  }
+  FILE* f = os::fopen(HotFieldsFile, "r");
+  if (f == NULL) {
+    log_warning(class)("Failed to open HotFieldsFile %s", HotFieldsFile);
+    return;
+  }
+  _hot_fields = new (ResourceObj::C_HEAP, mtClass) HotFieldTable();
+  int field_count = 0;
+  int class_count = 0;
+  char line[4 * 1024];
+  while (fgets(line, sizeof(line), f) != NULL) {
+    if (line[0] == '#') {
+      continue;
+    }
+    char* class_name = line + strspn(line, " \t");
+    size_t len = strcspn(class_name, " \t\r\n");
+    if (len == 0) {
+      continue;
+    }
+    char* field_name = class_name + len;
+    field_name += strspn(field_name, " \t");
+    class_name[len] = '\0';
+    len = strcspn(field_name, " \t\r\n");
+    if (len == 0) {
+      log_warning(class)("No field name for %s in HotFieldsFile %s", class_name, HotFieldsFile);
+      continue;
+    }
+    field_name[len] = '\0';
+    for (char* p = class_name; *p != '\0'; p++) {
+      if (*p == '.') {
+        *p = '/';
+      }
+    }
+    Symbol* klass = SymbolTable::new_permanent_symbol(class_name);
+    GrowableArray<Symbol*>** fields = _hot_fields->get(klass);
+    if (fields == NULL) {
+      _hot_fields->put(klass, new (ResourceObj::C_HEAP, mtClass) GrowableArray<Symbol*>(4, mtClass));
+      fields = _hot_fields->get(klass);
+      class_count++;
+    }
+    (*fields)->append_if_missing(SymbolTable::new_permanent_symbol(field_name));
+    field_count++;
+  }
+  fclose(f);
+  log_info(class)("Read %d hot fields of %d classes from %s", field_count, class_count, HotFieldsFile);
+}
+
+bool FieldLayoutBuilder::is_hot_field(AllFieldStream& fs) const {
+  return _hot_field_names != NULL && _hot_field_names->contains(fs.name());
+}
+
 FieldGroup* FieldLayoutBuilder::get_or_create_contended_group(int g) {
   assert(g > 0, "must only be called for named contended groups");
   FieldGroup* fg = NULL;
@@ -539,6 +606,14 @@ void FieldLayoutBuilder::prologue() {
   _static_layout->initialize_static_layout();
   _static_fields = new FieldGroup();
   _root_group = new FieldGroup();
+  // Classes that are padded as a whole are left alone.
+  if (_hot_fields != NULL && !_is_contended) {
+    GrowableArray<Symbol*>** names = _hot_fields->get(const_cast<Symbol*>(_classname));
+    if (names != NULL) {
+      _hot_field_names = *names;
+      _hot_group = new FieldGroup();
+    }
+  }
 }
 
 // Field sorting for regular classes:
@@ -546,6 +621,7 @@ void FieldLayoutBuilder::prologue() {
 //   - non-static fields are also sorted according to their contention group
 //     (support of the @Contended annotation)
 //   - @Contended annotation is ignored for static fields
+//   - non-contended instance fields named in HotFieldsFile form their own group
 void FieldLayoutBuilder::regular_field_sorting() {
   for (AllFieldStream fs(_fields, _constant_pool); !fs.done(); fs.next()) {
     FieldGroup* group = NULL;
@@ -561,6 +637,8 @@ void FieldLayoutBuilder::regular_field_sorting() {
         } else {
           group = get_or_create_contended_group(g);
         }
+      } else if (_hot_group != NULL && is_hot_field(fs)) {
+        group = _hot_group;
       } else {
         group = _root_group;
       }
@@ -588,6 +666,9 @@ void FieldLayoutBuilder::regular_field_sorting() {
     }
   }
   _root_group->sort_by_size();
+  if (_hot_group != NULL) {
+    _hot_group->sort_by_size();
+  }
   _static_fields->sort_by_size();
   if (!_contended_groups.is_empty()) {
     for (int i = 0; i < _contended_groups.length(); i++) {
@@ -608,6 +689,8 @@ void FieldLayoutBuilder::insert_contended_padding(LayoutRawBlock* slot) {
 //   - primitive fields are allocated first (from the biggest to the smallest)
 //   - then oop fields are allocated, either in existing gaps or at the end of
 //     the layout
+//   - fields named in HotFieldsFile are allocated before all others, so they
+//     share the first cache line(s) of the class' fields
 void FieldLayoutBuilder::compute_regular_layout() {
   bool need_tail_padding = false;
   prologue();
@@ -620,6 +703,10 @@ void FieldLayoutBuilder::compute_regular_layout() {
     insert_contended_padding(_layout->start());
     need_tail_padding = true;
   }
+  if (_hot_group != NULL) {
+    _layout->add(_hot_group->primitive_fields());
+    _layout->add(_hot_group->oop_fields());
+  }
   _layout->add(_root_group->primitive_fields());
   _layout->add(_root_group->oop_fields());
 
@@ -663,6 +750,13 @@ void FieldLayoutBuilder::epilogue() {
     }
   }
 
+  if (_hot_group != NULL && _hot_group->oop_fields() != NULL) {
+    for (int i = 0; i < _hot_group->oop_fields()->length(); i++) {
+      LayoutRawBlock* b = _hot_group->oop_fields()->at(i);
+      nonstatic_oop_maps->add(b->offset(), 1);
+    }
+  }
+
   if (!_contended_groups.is_empty()) {
     for (int i = 0; i < _contended_groups.length(); i++) {
       FieldGroup* cg = _contended_groups.at(i);
@@ -233,6 +233,8 @@ class FieldLayoutBuilder : public ResourceObj {
   Array<u2>* _fields;
   FieldLayoutInfo* _info;
   FieldGroup* _root_group;
+  FieldGroup* _hot_group;
+  const GrowableArray<Symbol*>* _hot_field_names; // from HotFieldsFile
   GrowableArray<FieldGroup*> _contended_groups;
   FieldGroup* _static_fields;
   FieldLayout* _layout;
@@ -251,6 +253,9 @@ class FieldLayoutBuilder : public ResourceObj {
     return _alignment;
   }
 
+  // Reads HotFieldsFile, once the SymbolTable exists.
+  static void load_hot_fields();
+
   void build_layout();
   void compute_regular_layout();
   void insert_contended_padding(LayoutRawBlock* slot);
@@ -260,6 +265,7 @@ class FieldLayoutBuilder : public ResourceObj {
   void epilogue();
   void regular_field_sorting();
   FieldGroup* get_or_create_contended_group(int g);
+  bool is_hot_field(AllFieldStream& fs) const;
 };
 
 #endif // SHARE_CLASSFILE_FIELDLAYOUTBUILDER_HPP
@@ -36,6 +36,7 @@
 #include "prims/jvmtiRedefineClasses.hpp"
 #include "runtime/arguments.hpp"
 #include "runtime/handles.inline.hpp"
+#include "services/threadService.hpp"
 #include "utilities/macros.hpp"
 #if INCLUDE_JFR
 #include "jfr/support/jfrKlassExtension.hpp"
@@ -191,6 +192,15 @@ InstanceKlass* KlassFactory::create_from_stream(ClassFileStream* stream,
                                         CHECK_NULL);
   }
 
+  // Timer includes the loading of the super types, but not recursive parsing.
+  PerfClassTraceTime timer(ClassLoader::perf_class_parse_time(),
+                           ClassLoader::perf_class_parse_selftime(),
+                           ClassLoader::perf_classes_parsed(),
+                           THREAD->get_thread_stat()->perf_recursion_counts_addr(),
+                           THREAD->get_thread_stat()->perf_timers_addr(),
+                           PerfClassTraceTime::CLASS_PARSE,
+                           loader_data);
+
   ClassFileParser parser(stream,
                          name,
                          loader_data,
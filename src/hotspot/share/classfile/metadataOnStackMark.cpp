@@ -26,12 +26,18 @@
 #include "classfile/metadataOnStackMark.hpp"
 #include "code/codeCache.hpp"
 #include "compiler/compileBroker.hpp"
+#include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/workgroup.hpp"
+#include "memory/universe.hpp"
 #include "oops/metadata.hpp"
 #include "prims/jvmtiImpl.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/synchronizer.hpp"
 #include "runtime/thread.hpp"
+#include "runtime/threadSMR.hpp"
 #include "services/threadService.hpp"
 #include "utilities/chunkedList.hpp"
+#include "utilities/growableArray.hpp"
 #if INCLUDE_JVMCI
 #include "jvmci/jvmci.hpp"
 #endif
@@ -46,6 +52,69 @@ class MetadataOnStackClosure : public MetadataClosure {
   void do_metadata(Metadata* m) { Metadata::mark_on_stack(m); }
 };
 
+// Collects the metadata on the stacks of the Java threads a worker claims.
+// Setting and recording the on-stack bits is not thread-safe, so the
+// caller marks the collected metadata once all workers are done.
+class MetadataCollectClosure : public MetadataClosure {
+  GrowableArray<Metadata*>* _found;
+ public:
+  MetadataCollectClosure(GrowableArray<Metadata*>* found) : _found(found) {}
+  void do_metadata(Metadata* m) {
+    if (!m->on_stack() && (_found->is_empty() || _found->last() != m)) {
+      _found->append(m);
+    }
+  }
+};
+
+class ParallelThreadsMetadataTask : public AbstractGangTask {
+  ThreadsList* const _threads;
+  GrowableArray<Metadata*>** const _found;
+  volatile uint _claimed;
+ public:
+  ParallelThreadsMetadataTask(ThreadsList* threads, GrowableArray<Metadata*>** found) :
+    AbstractGangTask("Parallel Threads Metadata"),
+    _threads(threads), _found(found), _claimed(0) {}
+
+  void work(uint worker_id) {
+    MetadataCollectClosure cl(_found[worker_id]);
+    for (uint i = Atomic::fetch_and_add(&_claimed, 1u);
+         i < _threads->length();
+         i = Atomic::fetch_and_add(&_claimed, 1u)) {
+      _threads->thread_at(i)->metadata_do(&cl);
+    }
+  }
+};
+
+// Below this many Java threads the stacks are walked by the VM thread alone.
+static const uint ParallelThreadsMetadataMinThreads = 256;
+
+static void threads_metadata_do(MetadataClosure* f) {
+  ThreadsList* threads = ThreadsSMRSupport::get_java_thread_list();
+  WorkGang* workers = Universe::heap()->safepoint_workers();
+  if (workers == NULL || workers->active_workers() < 2 ||
+      threads->length() < ParallelThreadsMetadataMinThreads) {
+    Threads::metadata_do(f);
+    return;
+  }
+
+  const uint num_workers = workers->active_workers();
+  GrowableArray<Metadata*>** found = NEW_C_HEAP_ARRAY(GrowableArray<Metadata*>*, num_workers, mtClass);
+  for (uint i = 0; i < num_workers; i++) {
+    found[i] = new (ResourceObj::C_HEAP, mtClass) GrowableArray<Metadata*>(1024, mtClass);
+  }
+
+  ParallelThreadsMetadataTask task(threads, found);
+  workers->run_task(&task, num_workers);
+
+  for (uint i = 0; i < num_workers; i++) {
+    for (int j = 0; j < found[i]->length(); j++) {
+      f->do_metadata(found[i]->at(j));
+    }
+    delete found[i];
+  }
+  FREE_C_HEAP_ARRAY(GrowableArray<Metadata*>*, found);
+}
+
 // Walk metadata on the stack and mark it so that redefinition doesn't delete
 // it.  Class unloading only deletes in-error class files, methods created by
 // the relocator and dummy constant pools.  None of these appear anywhere except
@@ -62,7 +131,7 @@ MetadataOnStackMark::MetadataOnStackMark(bool walk_all_metadata, bool redefiniti
 
   if (walk_all_metadata) {
     MetadataOnStackClosure md_on_stack;
-    Threads::metadata_do(&md_on_stack);
+    threads_metadata_do(&md_on_stack);
     if (redefinition_walk) {
       // We have to walk the whole code cache during redefinition.
       CodeCache::metadata_do(&md_on_stack);
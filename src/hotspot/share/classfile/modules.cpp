@@ -452,6 +452,11 @@ void Modules::define_module(Handle module, jboolean is_open, jstring version,
     ClassLoader::add_to_exploded_build_list(THREAD, module_symbol);
   }
 
+  // The boot loader may now find classes in the packages of the new module.
+  if (h_loader.is_null()) {
+    SystemDictionary::clear_boot_loader_misses();
+  }
+
 #ifdef COMPILER2
   // Special handling of jdk.incubator.vector
   if (strcmp(module_name, "jdk.incubator.vector") == 0) {
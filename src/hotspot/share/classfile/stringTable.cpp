@@ -34,6 +34,7 @@
 #include "gc/shared/oopStorage.inline.hpp"
 #include "gc/shared/oopStorageSet.hpp"
 #include "gc/shared/stringdedup/stringDedup.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/allocation.inline.hpp"
@@ -489,8 +490,38 @@ void StringTable::do_concurrent_work(JavaThread* jt) {
   Atomic::release_store(&_has_work, false);
 }
 
+// Moves the nodes of a table to its rehashed successor on all workers.
+class StringTableRehashTask : public AbstractGangTask {
+  StringTableHash::MoveTask* _move_task;
+ public:
+  StringTableRehashTask(StringTableHash::MoveTask* move_task) :
+    AbstractGangTask("StringTable rehash"), _move_task(move_task) {}
+
+  void work(uint worker_id) {
+    Thread* thread = Thread::current();
+    while (_move_task->do_task(thread)) {
+      // Continue moving.
+    }
+  }
+};
+
+static bool move_nodes(StringTableHash* from, StringTableHash* to, WorkGang* workers) {
+  Thread* thread = Thread::current();
+  if (workers == nullptr) {
+    return from->try_move_nodes_to(thread, to);
+  }
+  StringTableHash::MoveTask move_task(from, to);
+  if (!move_task.prepare(thread)) {
+    return false;
+  }
+  StringTableRehashTask task(&move_task);
+  workers->run_task(&task);
+  move_task.done(thread);
+  return true;
+}
+
 // Rehash
-bool StringTable::do_rehash() {
+bool StringTable::do_rehash(WorkGang* workers) {
   if (!_local_table->is_safepoint_safe()) {
     return false;
   }
@@ -500,7 +531,7 @@ bool StringTable::do_rehash() {
   StringTableHash* new_table = new StringTableHash(new_size, END_SIZE, REHASH_LEN);
   // Use alt hash from now on
   _alt_hash = true;
-  if (!_local_table->try_move_nodes_to(Thread::current(), new_table)) {
+  if (!move_nodes(_local_table, new_table, workers)) {
     _alt_hash = false;
     delete new_table;
     return false;
@@ -541,7 +572,7 @@ bool StringTable::rehash_table_expects_safepoint_rehashing() {
   return true;
 }
 
-void StringTable::rehash_table() {
+void StringTable::rehash_table(WorkGang* workers) {
   log_debug(stringtable)("Table imbalanced, rehashing called.");
 
   // Grow instead of rehash.
@@ -561,7 +592,7 @@ void StringTable::rehash_table() {
 
   _alt_hash_seed = AltHashing::compute_seed();
   {
-    if (do_rehash()) {
+    if (do_rehash(workers)) {
       _rehashed = true;
     } else {
       log_info(stringtable)("Resizes in progress rehashing skipped.");
@@ -35,6 +35,7 @@ class CompactHashtableWriter;
 class DumpedInternedStrings;
 class JavaThread;
 class SerializeClosure;
+class WorkGang;
 
 class StringTable;
 class StringTableConfig;
@@ -74,7 +75,7 @@ class StringTable : public CHeapObj<mtSymbol>{
 
   static void print_table_statistics(outputStream* st, const char* table_name);
 
-  static bool do_rehash();
+  static bool do_rehash(WorkGang* workers);
 
  public:
   static size_t table_size();
@@ -100,7 +101,8 @@ private:
 
 public:
   static bool rehash_table_expects_safepoint_rehashing();
-  static void rehash_table();
+  // Moves the entries on the given workers, if any.
+  static void rehash_table(WorkGang* workers = nullptr);
   static bool needs_rehashing() { return _needs_rehashing; }
   static inline void update_needs_rehash(bool rehash) {
     if (rehash) {
@@ -30,6 +30,7 @@
 #include "classfile/compactHashtable.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/symbolTable.hpp"
+#include "gc/shared/workgroup.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/metaspaceClosure.hpp"
 #include "memory/resourceArea.hpp"
@@ -792,8 +793,38 @@ void SymbolTable::do_concurrent_work(JavaThread* jt) {
   _has_work = false;
 }
 
+// Moves the nodes of a table to its rehashed successor on all workers.
+class SymbolTableRehashTask : public AbstractGangTask {
+  SymbolTableHash::MoveTask* _move_task;
+ public:
+  SymbolTableRehashTask(SymbolTableHash::MoveTask* move_task) :
+    AbstractGangTask("SymbolTable rehash"), _move_task(move_task) {}
+
+  void work(uint worker_id) {
+    Thread* thread = Thread::current();
+    while (_move_task->do_task(thread)) {
+      // Continue moving.
+    }
+  }
+};
+
+static bool move_nodes(SymbolTableHash* from, SymbolTableHash* to, WorkGang* workers) {
+  Thread* thread = Thread::current();
+  if (workers == nullptr) {
+    return from->try_move_nodes_to(thread, to);
+  }
+  SymbolTableHash::MoveTask move_task(from, to);
+  if (!move_task.prepare(thread)) {
+    return false;
+  }
+  SymbolTableRehashTask task(&move_task);
+  workers->run_task(&task);
+  move_task.done(thread);
+  return true;
+}
+
 // Rehash
-bool SymbolTable::do_rehash() {
+bool SymbolTable::do_rehash(WorkGang* workers) {
   if (!_local_table->is_safepoint_safe()) {
     return false;
   }
@@ -803,7 +834,7 @@ bool SymbolTable::do_rehash() {
   SymbolTableHash* new_table = new SymbolTableHash(new_size, END_SIZE, REHASH_LEN);
   // Use alt hash from now on
   _alt_hash = true;
-  if (!_local_table->try_move_nodes_to(Thread::current(), new_table)) {
+  if (!move_nodes(_local_table, new_table, workers)) {
     _alt_hash = false;
     delete new_table;
     return false;
@@ -844,7 +875,7 @@ bool SymbolTable::rehash_table_expects_safepoint_rehashing() {
   return true;
 }
 
-void SymbolTable::rehash_table() {
+void SymbolTable::rehash_table(WorkGang* workers) {
   log_debug(symboltable)("Table imbalanced, rehashing called.");
 
   // Grow instead of rehash.
@@ -865,7 +896,7 @@ void SymbolTable::rehash_table() {
 
   _alt_hash_seed = AltHashing::compute_seed();
 
-  if (do_rehash()) {
+  if (do_rehash(workers)) {
     _rehashed = true;
   } else {
     log_info(symboltable)("Resizes in progress rehashing skipped.");
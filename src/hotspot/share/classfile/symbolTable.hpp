@@ -105,6 +105,7 @@ public:
 
 class CompactHashtableWriter;
 class SerializeClosure;
+class WorkGang;
 
 class SymbolTableConfig;
 class SymbolTableCreateEntry;
@@ -166,7 +167,7 @@ class SymbolTable : public AllStatic {
   static void print_table_statistics(outputStream* st, const char* table_name);
 
   static void try_rehash_table();
-  static bool do_rehash();
+  static bool do_rehash(WorkGang* workers);
 
 public:
   // The symbol table
@@ -217,7 +218,8 @@ private:
 
 public:
   static bool rehash_table_expects_safepoint_rehashing();
-  static void rehash_table();
+  // Moves the entries on the given workers, if any.
+  static void rehash_table(WorkGang* workers = nullptr);
   static bool needs_rehashing() { return _needs_rehashing; }
   static inline void update_needs_rehash(bool rehash) {
     if (rehash) {
@@ -68,6 +68,7 @@
 #include "prims/jvmtiExport.hpp"
 #include "prims/methodHandles.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/java.hpp"
@@ -108,6 +109,79 @@ static PlaceholderTable*   placeholders() { return _placeholders; }
 // Constraints on class loaders
 const int _loader_constraint_size = 107;                     // number of entries in constraint table
 static LoaderConstraintTable*  _loader_constraints;
+
+// Names the boot loader failed to find. Frameworks probing for optional
+// classes make the builtin loaders ask their parents, and so the boot loader,
+// for the same missing names over and over. A cached miss returns before the
+// placeholder table is locked and the boot class path is searched again.
+//
+// The boot loader only finds more classes when one is defined to it, or its
+// modules or append path grow; each of these bumps _epoch. A miss is only
+// recorded if the epoch did not change while the class was being looked for.
+// The cache holds a refcount on its names, so a name's address cannot be
+// reused and lookups compare pointers without taking the lock.
+class BootLoaderMissCache : AllStatic {
+  static const int _size = 1024;
+  static Symbol* volatile _names[_size];
+  static volatile uint _epoch;
+
+  static int index_for(Symbol* name) { return name->identity_hash() & (_size - 1); }
+
+  static void clear_at(int index) {
+    assert_lock_strong(BootLoaderMissCache_lock);
+    Symbol* old = _names[index];
+    if (old != NULL) {
+      Atomic::store(&_names[index], (Symbol*)NULL);
+      old->decrement_refcount();
+    }
+  }
+
+ public:
+  static bool is_enabled() {
+    // Visibility of the boot loader changes while the module system is initialized.
+    return CacheBootLoaderMisses && Universe::is_module_initialized();
+  }
+
+  static uint epoch() { return Atomic::load_acquire(&_epoch); }
+
+  static bool contains(Symbol* name) {
+    return Atomic::load(&_names[index_for(name)]) == name;
+  }
+
+  static void add(Symbol* name, uint epoch) {
+    MutexLocker ml(BootLoaderMissCache_lock, Mutex::_no_safepoint_check_flag);
+    int index = index_for(name);
+    if (_epoch == epoch && _names[index] != name) {
+      clear_at(index);
+      name->increment_refcount();
+      Atomic::store(&_names[index], name);
+    }
+  }
+
+  static void remove(Symbol* name) {
+    MutexLocker ml(BootLoaderMissCache_lock, Mutex::_no_safepoint_check_flag);
+    Atomic::release_store(&_epoch, _epoch + 1);
+    int index = index_for(name);
+    if (_names[index] == name) {
+      clear_at(index);
+    }
+  }
+
+  static void clear() {
+    MutexLocker ml(BootLoaderMissCache_lock, Mutex::_no_safepoint_check_flag);
+    Atomic::release_store(&_epoch, _epoch + 1);
+    for (int i = 0; i < _size; i++) {
+      clear_at(i);
+    }
+  }
+};
+
+Symbol* volatile BootLoaderMissCache::_names[BootLoaderMissCache::_size] = { NULL };
+volatile uint BootLoaderMissCache::_epoch = 0;
+
+void SystemDictionary::clear_boot_loader_misses() {
+  BootLoaderMissCache::clear();
+}
 static LoaderConstraintTable* constraints() { return _loader_constraints; }
 
 // ----------------------------------------------------------------------------
@@ -608,6 +682,15 @@ InstanceKlass* SystemDictionary::resolve_instance_class_or_null(Symbol* name,
   InstanceKlass* probe = dictionary->find(name_hash, name, protection_domain);
   if (probe != NULL) return probe;
 
+  bool cache_miss = class_loader.is_null() && BootLoaderMissCache::is_enabled();
+  uint miss_epoch = 0;
+  if (cache_miss) {
+    miss_epoch = BootLoaderMissCache::epoch();
+    if (BootLoaderMissCache::contains(name)) {
+      return NULL;
+    }
+  }
+
   // Non-bootstrap class loaders will call out to class loader and
   // define via jvm/jni_DefineClass which will acquire the
   // class loader object lock to protect against multiple threads
@@ -734,6 +817,9 @@ InstanceKlass* SystemDictionary::resolve_instance_class_or_null(Symbol* name,
   }
 
   if (HAS_PENDING_EXCEPTION || loaded_class == NULL) {
+    if (cache_miss && !HAS_PENDING_EXCEPTION) {
+      BootLoaderMissCache::add(name, miss_epoch);
+    }
     return NULL;
   }
 
@@ -1745,6 +1831,10 @@ void SystemDictionary::update_dictionary(unsigned int hash,
     }
     SystemDictionary_lock->notify_all();
   }
+
+  if (loader_data->is_boot_class_loader_data()) {
+    BootLoaderMissCache::remove(name);
+  }
 }
 
 
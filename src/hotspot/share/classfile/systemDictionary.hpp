@@ -220,6 +220,10 @@ public:
   // Register a new class loader
   static ClassLoaderData* register_loader(Handle class_loader, bool create_mirror_cld = false);
 
+  // Forget the names the boot loader failed to find, after it can find more
+  // classes than before, e.g. because its append path grew.
+  static void clear_boot_loader_misses();
+
 public:
   static Symbol* check_signature_loaders(Symbol* signature, Klass* klass_being_linked,
                                          Handle loader1, Handle loader2, bool is_method);
@@ -182,7 +182,8 @@ bool Verifier::verify(InstanceKlass* klass, bool should_verify_class, TRAPS) {
                            ClassLoader::perf_classes_verified(),
                            jt->get_thread_stat()->perf_recursion_counts_addr(),
                            jt->get_thread_stat()->perf_timers_addr(),
-                           PerfClassTraceTime::CLASS_VERIFY);
+                           PerfClassTraceTime::CLASS_VERIFY,
+                           klass->class_loader_data());
 
   // If the class should be verified, first see if we can use the split
   // verifier.  If not, or if verification fails and can failover, then
@@ -172,6 +172,7 @@ GrowableArray<CodeHeap*>* CodeCache::_heaps = new(ResourceObj::C_HEAP, mtCode) G
 GrowableArray<CodeHeap*>* CodeCache::_compiled_heaps = new(ResourceObj::C_HEAP, mtCode) GrowableArray<CodeHeap*> (CodeBlobType::All, mtCode);
 GrowableArray<CodeHeap*>* CodeCache::_nmethod_heaps = new(ResourceObj::C_HEAP, mtCode) GrowableArray<CodeHeap*> (CodeBlobType::All, mtCode);
 GrowableArray<CodeHeap*>* CodeCache::_allocable_heaps = new(ResourceObj::C_HEAP, mtCode) GrowableArray<CodeHeap*> (CodeBlobType::All, mtCode);
+CodeHeap* CodeCache::_hot_heap = NULL;
 
 void CodeCache::check_heap_sizes(size_t non_nmethod_size, size_t profiled_size, size_t non_profiled_size, size_t cache_size, bool all_set) {
   size_t total_size = non_nmethod_size + profiled_size + non_profiled_size;
@@ -324,18 +325,30 @@ void CodeCache::initialize_heaps() {
   profiled_size    = align_down(profiled_size, alignment);
   non_profiled_size = align_down(non_profiled_size, alignment);
 
+  // The hot code heap is taken from the non-profiled code heap, leaving it at least half
+  size_t hot_size = 0;
+  if (HotCodeHeapSize > 0 && heap_available(CodeBlobType::MethodNonProfiled)) {
+    hot_size = align_down(MIN2((size_t)HotCodeHeapSize, non_profiled_size / 2), alignment);
+  }
+  FLAG_SET_ERGO(HotCodeHeapSize, hot_size);
+
   // Reserve one continuous chunk of memory for CodeHeaps and split it into
   // parts for the individual heaps. The memory layout looks like this:
   // ---------- high -----------
   //    Non-profiled nmethods
+  //        Hot nmethods
   //         Non-nmethods
   //      Profiled nmethods
   // ---------- low ------------
+  // Hot nmethods are kept together, next to the stubs they call, to reduce
+  // iTLB and instruction cache misses.
   ReservedCodeSpace rs = reserve_heap_memory(cache_size, ps);
   ReservedSpace profiled_space      = rs.first_part(profiled_size);
   ReservedSpace rest                = rs.last_part(profiled_size);
   ReservedSpace non_method_space    = rest.first_part(non_nmethod_size);
-  ReservedSpace non_profiled_space  = rest.last_part(non_nmethod_size);
+  ReservedSpace nmethod_space       = rest.last_part(non_nmethod_size);
+  ReservedSpace hot_space           = nmethod_space.first_part(hot_size);
+  ReservedSpace non_profiled_space  = nmethod_space.last_part(hot_size);
 
   // Non-nmethods (stubs, adapters, ...)
   add_heap(non_method_space, "CodeHeap 'non-nmethods'", CodeBlobType::NonNMethod);
@@ -343,6 +356,12 @@ void CodeCache::initialize_heaps() {
   add_heap(profiled_space, "CodeHeap 'profiled nmethods'", CodeBlobType::MethodProfiled);
   // Tier 1 and tier 4 (non-profiled) methods and native methods
   add_heap(non_profiled_space, "CodeHeap 'non-profiled nmethods'", CodeBlobType::MethodNonProfiled);
+  // Tier 4 nmethods of hot methods. They are also non-profiled, so only
+  // allocate_hot() places code here (see get_code_heap(int)).
+  if (hot_size > 0) {
+    add_heap(hot_space, "CodeHeap 'hot nmethods'", CodeBlobType::MethodNonProfiled);
+    _hot_heap = get_code_heap_containing(hot_space.base());
+  }
 }
 
 size_t CodeCache::page_size(bool aligned, size_t min_pages) {
@@ -477,7 +496,7 @@ CodeHeap* CodeCache::get_code_heap(const CodeBlob* cb) {
 
 CodeHeap* CodeCache::get_code_heap(int code_blob_type) {
   FOR_ALL_HEAPS(heap) {
-    if ((*heap)->accepts(code_blob_type)) {
+    if ((*heap)->accepts(code_blob_type) && *heap != _hot_heap) {
       return *heap;
     }
   }
@@ -584,6 +603,51 @@ CodeBlob* CodeCache::allocate(int size, int code_blob_type, bool handle_alloc_fa
   return cb;
 }
 
+// Advise the committed part of each code heap for large pages again and,
+// where the OS supports it, collapse already populated small pages.
+void CodeCache::realign_to_large_pages() {
+  const size_t ps = page_size(false, 8);
+  if (ps <= (size_t)os::vm_page_size()) {
+    return;
+  }
+  MutexLocker mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+  FOR_ALL_HEAPS(heap) {
+    char* start = align_up((char*)(*heap)->low_boundary(), ps);
+    char* end = align_down((char*)(*heap)->high(), ps);
+    if (start < end) {
+      os::realign_memory(start, end - start, ps);
+      bool collapsed = LINUX_ONLY(os::Linux::collapse_huge_pages(start, end - start)) NOT_LINUX(false);
+      log_info(codecache)("%s: " SIZE_FORMAT "K advised for " SIZE_FORMAT "K pages%s",
+                          (*heap)->name(), (size_t)(end - start) / K, ps / K, collapsed ? ", collapsed" : "");
+    }
+  }
+}
+
+CodeBlob* CodeCache::allocate_hot(int size) {
+  assert_locked_or_safepoint(CodeCache_lock);
+  if (_hot_heap != NULL && size > 0) {
+    CodeBlob* cb;
+    while ((cb = (CodeBlob*)_hot_heap->allocate(size)) == NULL) {
+      if (!_hot_heap->expand_by(CodeCacheExpansionSize)) {
+        break;
+      }
+    }
+    if (cb != NULL) {
+      NMethodSweeper::report_allocation();
+      print_trace("allocation", cb, size);
+      return cb;
+    }
+  }
+  // The hot code heap is full, place the code with the other non-profiled nmethods
+  return allocate(size, CodeBlobType::MethodNonProfiled);
+}
+
+bool CodeCache::is_hot_method(Method* method, int comp_level) {
+  return _hot_heap != NULL &&
+         comp_level == CompLevel_full_optimization &&
+         method->invocation_count() >= HotCodeMinInvocations;
+}
+
 void CodeCache::free(CodeBlob* cb) {
   assert_locked_or_safepoint(CodeCache_lock);
   CodeHeap* heap = get_code_heap(cb);
@@ -908,6 +972,15 @@ size_t CodeCache::unallocated_capacity() {
   return unallocated_cap;
 }
 
+size_t CodeCache::discard_free_memory() {
+  assert_locked_or_safepoint(CodeCache_lock);
+  size_t discarded = 0;
+  FOR_ALL_HEAPS(heap) {
+    discarded += (*heap)->discard_free_memory();
+  }
+  return discarded;
+}
+
 size_t CodeCache::max_capacity() {
   size_t max_cap = 0;
   FOR_ALL_ALLOCABLE_HEAPS(heap) {
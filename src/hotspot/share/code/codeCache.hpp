@@ -90,6 +90,7 @@ class CodeCache : AllStatic {
   static GrowableArray<CodeHeap*>* _compiled_heaps;
   static GrowableArray<CodeHeap*>* _nmethod_heaps;
   static GrowableArray<CodeHeap*>* _allocable_heaps;
+  static CodeHeap* _hot_heap;                           // Non-profiled heap reserved for hot methods, see HotCodeHeapSize
 
   static address _low_bound;                            // Lower bound of CodeHeap addresses
   static address _high_bound;                           // Upper bound of CodeHeap addresses
@@ -137,6 +138,9 @@ class CodeCache : AllStatic {
 
   // Allocation/administration
   static CodeBlob* allocate(int size, int code_blob_type, bool handle_alloc_failure = true, int orig_code_blob_type = CodeBlobType::All); // allocates a new CodeBlob
+  static void realign_to_large_pages();                    // re-advise committed code heap memory for large pages
+  static CodeBlob* allocate_hot(int size);                 // allocates in the hot code heap, or the non-profiled heap when it is full
+  static bool is_hot_method(Method* method, int comp_level); // should the nmethod be placed in the hot code heap
   static void commit(CodeBlob* cb);                        // called when the allocated CodeBlob has been filled
   static int  alignment_unit();                            // guaranteed alignment of all CodeBlobs
   static int  alignment_offset();                          // guaranteed offset of first CodeBlob byte within alignment unit (i.e., allocation header)
@@ -211,6 +215,9 @@ class CodeCache : AllStatic {
   static size_t unallocated_capacity();
   static size_t max_capacity();
 
+  // Drop the pages of unused code heap space, e.g. before a checkpoint
+  static size_t discard_free_memory();
+
   static double reverse_free_ratio();
 
   static size_t max_distance_to_non_nmethod();
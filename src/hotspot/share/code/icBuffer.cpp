@@ -36,6 +36,7 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/perfData.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/vmOperations.hpp"
@@ -47,6 +48,11 @@ StubQueue* InlineCacheBuffer::_buffer    = NULL;
 CompiledICHolder* InlineCacheBuffer::_pending_released = NULL;
 int InlineCacheBuffer::_pending_count = 0;
 
+PerfCounter* InlineCacheBuffer::_transition_stubs       = NULL;
+PerfCounter* InlineCacheBuffer::_reclaimed_stubs        = NULL;
+PerfCounter* InlineCacheBuffer::_buffer_full_safepoints = NULL;
+PerfCounter* InlineCacheBuffer::_buffer_full_coalesced  = NULL;
+
 #ifdef ASSERT
 ICRefillVerifier::ICRefillVerifier()
   : _refill_requested(false),
@@ -142,6 +148,18 @@ void InlineCacheBuffer::initialize() {
   if (_buffer != NULL) return; // already initialized
   _buffer = new StubQueue(new ICStubInterface, checked_cast<int>(InlineCacheBufferSize), InlineCacheBuffer_lock, "InlineCacheBuffer");
   assert (_buffer != NULL, "cannot allocate InlineCacheBuffer");
+
+  if (UsePerfData) {
+    EXCEPTION_MARK;
+    _transition_stubs =
+      PerfDataManager::create_counter(SUN_CI, "icTransitionStubs", PerfData::U_Events, CHECK);
+    _reclaimed_stubs =
+      PerfDataManager::create_counter(SUN_CI, "icReclaimedStubs", PerfData::U_Events, CHECK);
+    _buffer_full_safepoints =
+      PerfDataManager::create_counter(SUN_CI, "icBufferFullSafepoints", PerfData::U_Events, CHECK);
+    _buffer_full_coalesced =
+      PerfDataManager::create_counter(SUN_CI, "icBufferFullCoalesced", PerfData::U_Events, CHECK);
+  }
 }
 
 
@@ -155,8 +173,22 @@ void InlineCacheBuffer::refill_ic_stubs() {
   ICRefillVerifier* verifier = current_ic_refill_verifier();
   verifier->request_remembered();
 #endif
+  // Threads that ran out of stubs at the same time all get here. The first
+  // safepoint empties the buffer for all of them, so the others only retry.
+  {
+    MutexLocker ml(InlineCacheBuffer_lock, Mutex::_no_safepoint_check_flag);
+    if (buffer()->available_space() >= buffer()->total_space() / 2) {
+      if (UsePerfData) {
+        _buffer_full_coalesced->inc();
+      }
+      return;
+    }
+  }
   // we ran out of inline cache buffer space; must enter safepoint.
   // We do this by forcing a safepoint
+  if (UsePerfData) {
+    _buffer_full_safepoints->inc();
+  }
   VM_ICBufferFull ibf;
   VMThread::execute(&ibf);
 }
@@ -180,6 +212,9 @@ void InlineCacheBuffer::update_inline_caches() {
     if (TraceICBuffer) {
       tty->print_cr("[updating inline caches with %d stubs]", buffer()->number_of_stubs());
     }
+    if (UsePerfData) {
+      _reclaimed_stubs->inc(buffer()->number_of_stubs());
+    }
     buffer()->remove_all();
   }
   release_pending_icholders();
@@ -225,6 +260,9 @@ bool InlineCacheBuffer::create_transition_stub(CompiledIC *ic, void* cached_valu
   }
 
   ic_stub->set_stub(ic, cached_value, entry);
+  if (UsePerfData) {
+    _transition_stubs->inc();
+  }
 
   // Update inline cache in nmethod to point to new "out-of-line" allocated inline cache
   ic->set_ic_destination(ic_stub);
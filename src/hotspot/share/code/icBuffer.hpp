@@ -36,6 +36,7 @@
 
 class CompiledIC;
 class CompiledICHolder;
+class PerfCounter;
 
 //
 // For CompiledIC's:
@@ -146,6 +147,12 @@ class InlineCacheBuffer: public AllStatic {
   static CompiledICHolder* _pending_released;
   static int _pending_count;
 
+  // PerfData counters of IC transitions through the buffer
+  static PerfCounter* _transition_stubs;
+  static PerfCounter* _reclaimed_stubs;
+  static PerfCounter* _buffer_full_safepoints;
+  static PerfCounter* _buffer_full_coalesced;
+
   static StubQueue* buffer()                         { return _buffer;         }
 
   static ICStub* new_ic_stub();
@@ -576,7 +576,7 @@ nmethod* nmethod::new_nmethod(const methodHandle& method,
 #endif
       + align_up(debug_info->data_size()           , oopSize);
 
-    nm = new (nmethod_size, comp_level)
+    nm = new (nmethod_size, comp_level, CodeCache::is_hot_method(method(), comp_level))
     nmethod(method(), compiler->type(), nmethod_size, compile_id, entry_bci, offsets,
             orig_pc_offset, debug_info, dependencies, code_buffer, frame_size,
             oop_maps,
@@ -749,7 +749,10 @@ nmethod::nmethod(
   }
 }
 
-void* nmethod::operator new(size_t size, int nmethod_size, int comp_level) throw () {
+void* nmethod::operator new(size_t size, int nmethod_size, int comp_level, bool hot) throw () {
+  if (hot) {
+    return CodeCache::allocate_hot(nmethod_size);
+  }
   return CodeCache::allocate(nmethod_size, CodeCache::get_code_blob_type(comp_level));
 }
 
@@ -57,6 +57,7 @@ class CompilerStatistics {
   Data _osr;       // stats for OSR compilations
   int _nmethods_size; //
   int _nmethods_code_size;
+  elapsedTimer _regalloc_time; // time spent in register allocation, where the compiler reports it
 
   double total_time() { return _standard._time.seconds() + _osr._time.seconds(); }
 
@@ -234,6 +234,9 @@ public:
     if (CompilerOracle::has_option_value(method, CompileCommand::CompileThresholdScaling, threshold_scaling)) {
       scale *= threshold_scaling;
     }
+    if (cur_level == CompLevel_full_profile && method->is_recorded_hot()) {
+      scale *= PrecompiledTier4ThresholdScaling;
+    }
     switch(cur_level) {
     case CompLevel_none:
     case CompLevel_limited_profile:
@@ -272,6 +275,9 @@ public:
     if (CompilerOracle::has_option_value(method, CompileCommand::CompileThresholdScaling, threshold_scaling)) {
       scale *= threshold_scaling;
     }
+    if (cur_level == CompLevel_full_profile && method->is_recorded_hot()) {
+      scale *= PrecompiledTier4ThresholdScaling;
+    }
     switch(cur_level) {
     case CompLevel_none:
     case CompLevel_limited_profile:
@@ -638,14 +644,14 @@ CompileTask* CompilationPolicy::select_task(CompileQueue* compile_queue) {
       continue;
     }
     update_rate(t, mh);
-    if (max_task == NULL || compare_methods(method, max_method)) {
+    if (max_task == NULL || compare_tasks(task, max_task)) {
       // Select a method with the highest rate
       max_task = task;
       max_method = method;
     }
 
     if (task->is_blocking()) {
-      if (max_blocking_task == NULL || compare_methods(method, max_blocking_task->method())) {
+      if (max_blocking_task == NULL || compare_tasks(task, max_blocking_task)) {
         max_blocking_task = task;
       }
     }
@@ -791,6 +797,13 @@ void CompilationPolicy::compile(const methodHandle& mh, int bci, CompLevel level
   if (bci != InvocationEntryBci && mh->is_not_osr_compilable(level)) {
     return;
   }
+  if (level == CompLevel_full_optimization && DeoptimizationStormWindow > 0) {
+    // Keep running the current code while a deoptimization storm backs off
+    MethodData* mdo = mh->method_data();
+    if (mdo != NULL && mdo->is_recompile_backoff(nanos_to_millis(os::javaTimeNanos()))) {
+      return;
+    }
+  }
   if (!CompileBroker::compilation_is_in_queue(mh)) {
     if (PrintTieredEvents) {
       print_event(COMPILE, mh(), mh(), bci, level);
@@ -880,6 +893,34 @@ bool CompilationPolicy::compare_methods(Method* x, Method* y) {
   return false;
 }
 
+// The invocation rate times the bytecodes one invocation executes in the
+// interpreter, estimated from the method size and the backedges taken per
+// invocation.
+double CompilationPolicy::latency_weight(Method* method) {
+  double backedges_per_invocation = (double)(method->backedge_count() + 1) / (method->invocation_count() + 1);
+  return (double)(method->rate() + 1) * method->code_size() * (1.0 + backedges_per_invocation);
+}
+
+bool CompilationPolicy::compare_tasks(CompileTask* x, CompileTask* y) {
+  if (!TieredLatencyAwareSelection) {
+    return compare_methods(x->method(), y->method());
+  }
+  // A long-running loop keeps executing in the interpreter until its OSR
+  // method is installed, so OSR compilations are urgent.
+  bool x_osr = x->osr_bci() != InvocationEntryBci;
+  bool y_osr = y->osr_bci() != InvocationEntryBci;
+  if (x_osr != y_osr) {
+    return x_osr;
+  }
+  Method* xm = x->method();
+  Method* ym = y->method();
+  if (xm->highest_comp_level() != ym->highest_comp_level()) {
+    // recompilation after deopt
+    return xm->highest_comp_level() > ym->highest_comp_level();
+  }
+  return latency_weight(xm) > latency_weight(ym);
+}
+
 // Is method profiled enough?
 bool CompilationPolicy::is_method_profiled(const methodHandle& method) {
   MethodData* mdo = method->method_data();
@@ -196,6 +196,10 @@ class CompilationPolicy : AllStatic {
   inline static double weight(Method* method);
   // Apply heuristics and return true if x should be compiled before y
   inline static bool compare_methods(Method* x, Method* y);
+  // Estimate the interpreted time per millisecond a compilation of the method would save
+  inline static double latency_weight(Method* method);
+  // Apply heuristics and return true if task x should be compiled before task y
+  inline static bool compare_tasks(CompileTask* x, CompileTask* y);
   // Compute event rate for a given method. The rate is the number of event (invocations + backedges)
   // per millisecond.
   inline static void update_rate(jlong t, const methodHandle& method);
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
+#include "classfile/symbolTable.hpp"
+#include "code/codeCache.hpp"
+#include "code/nmethod.hpp"
+#include "compiler/compilationPolicy.hpp"
+#include "compiler/compilationRecorder.hpp"
+#include "compiler/compileBroker.hpp"
+#include "compiler/compilerDefinitions.hpp"
+#include "compiler/compiler_globals.hpp"
+#include "logging/log.hpp"
+#include "memory/iterator.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/method.hpp"
+#include "runtime/abstract_vm_version.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/resourceHash.hpp"
+
+// The file has a header line identifying the VM that wrote it, followed by
+// one "<level> <class> <method> <signature>" line per compiled method.
+// Methods compiled by a different VM build are not necessarily compilable
+// the same way, so files from other builds are ignored.
+
+struct RecordedMethod {
+  Symbol* _name;
+  Symbol* _signature;
+  int _level;
+};
+
+typedef GrowableArrayCHeap<RecordedMethod, mtCompiler> RecordedMethods;
+typedef ResourceHashtable<Symbol*, RecordedMethods*,
+                          primitive_hash<Symbol*>,
+                          primitive_equals<Symbol*>,
+                          1009,
+                          ResourceObj::C_HEAP,
+                          mtCompiler> RecordedClasses;
+
+// Written once by initialize and read-only afterwards.
+static RecordedClasses* _recorded_classes = NULL;
+
+static const char* header_prefix = "# ";
+
+void CompilationRecorder::dump() {
+  if (DumpCompiledMethodsFile == NULL) {
+    return;
+  }
+  fileStream fs(DumpCompiledMethodsFile, "w");
+  if (!fs.is_open()) {
+    log_warning(jit, compilation)("Failed to create %s", DumpCompiledMethodsFile);
+    return;
+  }
+  fs.print_cr("%s%s", header_prefix, Abstract_VM_Version::internal_vm_info_string());
+
+  int count = 0;
+  MutexLocker mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+  NMethodIterator iter(NMethodIterator::only_alive_and_not_unloading);
+  while (iter.next()) {
+    nmethod* nm = iter.method();
+    Method* m = nm->method();
+    if (!nm->is_in_use() || nm->is_osr_method() || nm->is_native_method() ||
+        m->is_method_handle_intrinsic() || m->method_holder()->is_hidden()) {
+      continue;
+    }
+    ResourceMark rm;
+    fs.print_cr("%d %s %s %s", nm->comp_level(),
+                m->klass_name()->as_C_string(),
+                m->name()->as_C_string(),
+                m->signature()->as_C_string());
+    count++;
+  }
+  log_info(jit, compilation)("Recorded %d compiled methods in %s", count, DumpCompiledMethodsFile);
+}
+
+static RecordedClasses* parse(FILE* f) {
+  char line[3 * 1024 + 32];
+  if (fgets(line, sizeof(line), f) == NULL ||
+      strncmp(line, header_prefix, strlen(header_prefix)) != 0) {
+    log_warning(jit, compilation)("%s is not a compiled methods file", PrecompileMethodsFile);
+    return NULL;
+  }
+  line[strcspn(line, "\n")] = '\0';
+  if (strcmp(line + strlen(header_prefix), Abstract_VM_Version::internal_vm_info_string()) != 0) {
+    log_warning(jit, compilation)("%s was written by a different VM, ignored", PrecompileMethodsFile);
+    return NULL;
+  }
+
+  RecordedClasses* table = new (ResourceObj::C_HEAP, mtCompiler) RecordedClasses();
+  int count = 0;
+  while (fgets(line, sizeof(line), f) != NULL) {
+    int level;
+    char klass[1024];
+    char name[1024];
+    char signature[1024];
+    if (sscanf(line, "%d %1023s %1023s %1023s", &level, klass, name, signature) != 4 ||
+        level <= CompLevel_none || level > CompLevel_full_optimization) {
+      continue;
+    }
+    // The symbols are kept for the life of the VM.
+    RecordedMethod recorded = { SymbolTable::new_symbol(name), SymbolTable::new_symbol(signature), level };
+    bool created;
+    RecordedMethods** methods = table->put_if_absent(SymbolTable::new_symbol(klass), NULL, &created);
+    if (created) {
+      *methods = new RecordedMethods(4);
+    }
+    (*methods)->append(recorded);
+    count++;
+  }
+  log_info(jit, compilation)("Read %d compiled methods from %s", count, PrecompileMethodsFile);
+  return table;
+}
+
+// Without a profile C2 code is mostly uncommon traps, hence methods that
+// were at the highest tier are started in profiled C1 code.  They are
+// marked recorded hot, so CompilationPolicy moves them on to C2 after a
+// shortened profiling period, see PrecompiledTier4ThresholdScaling.
+static int precompile_level(int recorded_level) {
+  int level = MIN2(recorded_level, (int)CompilationPolicy::highest_compile_level());
+  if (level == CompLevel_full_optimization && CompilerConfig::is_c1_profiling()) {
+    level = CompLevel_full_profile;
+  }
+  return level;
+}
+
+static void precompile(InstanceKlass* ik, const RecordedMethods* methods, TRAPS) {
+  for (int i = 0; i < methods->length(); i++) {
+    const RecordedMethod& r = methods->at(i);
+    Method* m = ik->find_method(r._name, r._signature);
+    if (m == NULL || m->is_abstract() || m->is_native()) {
+      continue;
+    }
+    methodHandle mh(THREAD, m);
+    int level = precompile_level(r._level);
+    if (r._level == CompLevel_full_optimization) {
+      mh->set_recorded_hot(true);
+    }
+    if (mh->code() != NULL || CompileBroker::compiler(level) == NULL ||
+        !CompilationPolicy::can_be_compiled(mh, level)) {
+      continue;
+    }
+    CompileBroker::compile_method(mh, InvocationEntryBci, level, mh, 0,
+                                  CompileTask::Reason_Precompile, THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      // The methods are only hints, do not fail class initialization.
+      CLEAR_PENDING_EXCEPTION;
+    }
+  }
+}
+
+class CollectRecordedClasses : public KlassClosure {
+  RecordedClasses* _table;
+  GrowableArray<InstanceKlass*>* _classes;
+public:
+  CollectRecordedClasses(RecordedClasses* table, GrowableArray<InstanceKlass*>* classes) :
+    _table(table), _classes(classes) {}
+
+  void do_klass(Klass* k) {
+    if (k->is_instance_klass() &&
+        InstanceKlass::cast(k)->is_initialized() &&
+        _table->get(k->name()) != NULL) {
+      _classes->append(InstanceKlass::cast(k));
+    }
+  }
+};
+
+void CompilationRecorder::initialize(TRAPS) {
+  if (PrecompileMethodsFile == NULL || !UseCompiler) {
+    return;
+  }
+  FILE* f = os::fopen(PrecompileMethodsFile, "r");
+  if (f == NULL) {
+    log_warning(jit, compilation)("Failed to open %s", PrecompileMethodsFile);
+    return;
+  }
+  RecordedClasses* table = parse(f);
+  fclose(f);
+  if (table == NULL) {
+    return;
+  }
+  Atomic::release_store(&_recorded_classes, table);
+
+  // Classes initialized from now on are handled by class_initialized, the
+  // ones initialized so far are looked up here.  A class caught by both
+  // is handled twice, which is harmless as CompileBroker does not queue
+  // a method twice.
+  ResourceMark rm(THREAD);
+  GrowableArray<InstanceKlass*> classes;
+  {
+    MutexLocker ml(THREAD, ClassLoaderDataGraph_lock);
+    CollectRecordedClasses cl(table, &classes);
+    ClassLoaderDataGraph::loaded_classes_do(&cl);
+  }
+  for (int i = 0; i < classes.length(); i++) {
+    precompile(classes.at(i), *table->get(classes.at(i)->name()), THREAD);
+  }
+}
+
+void CompilationRecorder::class_initialized(InstanceKlass* ik, TRAPS) {
+  RecordedClasses* table = Atomic::load_acquire(&_recorded_classes);
+  if (table == NULL) {
+    return;
+  }
+  RecordedMethods** methods = table->get(ik->name());
+  if (methods != NULL) {
+    precompile(ik, *methods, THREAD);
+  }
+}
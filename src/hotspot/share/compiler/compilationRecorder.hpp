@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_COMPILER_COMPILATIONRECORDER_HPP
+#define SHARE_COMPILER_COMPILATIONRECORDER_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/exceptions.hpp"
+
+class InstanceKlass;
+
+// Records the methods that have compiled code at VM exit into
+// -XX:DumpCompiledMethodsFile, and requests compilation of the methods
+// recorded in -XX:PrecompileMethodsFile as soon as their classes are
+// initialized in a later run.  The methods then skip most of their time
+// in the interpreter; the compiled code itself is not saved.
+class CompilationRecorder : AllStatic {
+public:
+  // Read PrecompileMethodsFile and request compilations for the classes
+  // that are already initialized.  Called once the compilers are up.
+  static void initialize(TRAPS);
+
+  // Request compilations for the recorded methods of ik.
+  static void class_initialized(InstanceKlass* ik, TRAPS);
+
+  // Write DumpCompiledMethodsFile.
+  static void dump();
+};
+
+#endif // SHARE_COMPILER_COMPILATIONRECORDER_HPP
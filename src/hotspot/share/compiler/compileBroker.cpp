@@ -165,6 +165,12 @@ PerfVariable*       CompileBroker::_perf_last_compile_size = NULL;
 PerfVariable*       CompileBroker::_perf_last_failed_type = NULL;
 PerfVariable*       CompileBroker::_perf_last_invalidated_type = NULL;
 
+PerfCounter*        CompileBroker::_perf_queue_wait[CompLevel_full_optimization][queue_wait_buckets];
+
+// Upper bounds in milliseconds of the queue wait histogram buckets, the last one is unbounded
+static const jlong queue_wait_bucket_limits[] = { 1, 10, 100, 1000 };
+static const char* queue_wait_bucket_names[] = { "Under1ms", "Under10ms", "Under100ms", "Under1s", "Over1s" };
+
 // Timers and counters for generating statistics
 elapsedTimer CompileBroker::_t_total_compilation;
 elapsedTimer CompileBroker::_t_osr_compilation;
@@ -568,6 +574,34 @@ void CompileBroker::print_compile_queues(outputStream* st) {
   }
 }
 
+bool CompileBroker::is_compilation_in_progress() {
+  for (JavaThreadIteratorWithHandle jtiwh; JavaThread* jt = jtiwh.next(); ) {
+    if (jt->is_Compiler_thread() && jt->as_CompilerThread()->task() != NULL) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool CompileBroker::wait_for_compile_queues_empty(jlong timeout_ms, TRAPS) {
+  assert(THREAD->is_Java_thread() && !THREAD->is_Compiler_thread(), "must be");
+  const jlong deadline = os::javaTimeMillis() + timeout_ms;
+  MonitorLocker ml(THREAD, MethodCompileQueue_lock);
+  for (;;) {
+    bool queued = (_c1_compile_queue != NULL && !_c1_compile_queue->is_empty()) ||
+                  (_c2_compile_queue != NULL && !_c2_compile_queue->is_empty());
+    if (!queued && !is_compilation_in_progress()) {
+      return true;
+    }
+    const jlong remaining = deadline - os::javaTimeMillis();
+    if (remaining <= 0) {
+      return false;
+    }
+    // Compiler threads do not notify when a task completes, so poll.
+    ml.wait(MIN2(remaining, (jlong)10));
+  }
+}
+
 void CompileQueue::print(outputStream* st) {
   assert_locked_or_safepoint(MethodCompileQueue_lock);
   st->print_cr("%s:", name());
@@ -788,6 +822,17 @@ void CompileBroker::compilation_init_phase1(JavaThread* THREAD) {
                                           PerfData::U_None,
                                           (jlong)CompileBroker::no_compile,
                                           CHECK);
+
+    STATIC_ASSERT(ARRAY_SIZE(queue_wait_bucket_names) == queue_wait_buckets);
+    STATIC_ASSERT(ARRAY_SIZE(queue_wait_bucket_limits) == queue_wait_buckets - 1);
+    char name[64];
+    for (int tier = CompLevel_simple; tier <= CompLevel_full_optimization; tier++) {
+      for (int i = 0; i < queue_wait_buckets; i++) {
+        os::snprintf_checked(name, sizeof(name), "tier%d.queueWait%s", tier, queue_wait_bucket_names[i]);
+        _perf_queue_wait[tier - 1][i] =
+             PerfDataManager::create_counter(SUN_CI, name, PerfData::U_Events, CHECK);
+      }
+    }
   }
 }
 
@@ -2245,6 +2290,7 @@ void CompileBroker::invoke_compiler_on_method(CompileTask* task) {
     // Update compile information when using perfdata.
     if (UsePerfData) {
       update_compile_perf_data(thread, method, is_osr);
+      update_queue_wait_perf_data(task);
     }
 
     DTRACE_METHOD_COMPILE_BEGIN_PROBE(method, compiler_name(task_level));
@@ -2403,6 +2449,9 @@ void CompileBroker::invoke_compiler_on_method(CompileTask* task) {
   if (nm != NULL) {
     nm->maybe_print_nmethod(directive);
   }
+  if (!directive->is_exclusive_copy()) {
+    directive->directive()->record_compile(time, nm != NULL ? nm->insts_size() : 0);
+  }
   DirectivesStack::release(directive);
 
   if (PrintCompilation && PrintCompilation2) {
@@ -2493,6 +2542,23 @@ void CompileBroker::handle_full_code_cache(int code_blob_type) {
   }
 }
 
+// ------------------------------------------------------------------
+// CompileBroker::update_queue_wait_perf_data
+//
+// Count the time the task waited in the queue in the histogram of its tier.
+void CompileBroker::update_queue_wait_perf_data(CompileTask* task) {
+  int level = task->comp_level();
+  if (level <= CompLevel_none || level > CompLevel_full_optimization || task->time_queued() == 0) {
+    return;
+  }
+  jlong wait_ms = (jlong)TimeHelper::counter_to_millis(os::elapsed_counter() - task->time_queued());
+  int bucket = 0;
+  while (bucket < queue_wait_buckets - 1 && wait_ms >= queue_wait_bucket_limits[bucket]) {
+    bucket++;
+  }
+  _perf_queue_wait[level - 1][bucket]->inc();
+}
+
 // ------------------------------------------------------------------
 // CompileBroker::update_compile_perf_data
 //
@@ -2638,6 +2704,7 @@ void CompileBroker::collect_statistics(CompilerThread* thread, elapsedTimer time
         }
         stats->_nmethods_size += code->total_size();
         stats->_nmethods_code_size += code->insts_size();
+        stats->_regalloc_time.add(task->regalloc_time());
       } else {
         assert(false, "CompilerStatistics object does not exist for compilation level %d", comp_level);
       }
@@ -2717,11 +2784,12 @@ jlong CompileBroker::total_compilation_ticks() {
 }
 
 void CompileBroker::print_times(const char* name, CompilerStatistics* stats) {
-  tty->print_cr("  %s {speed: %6.3f bytes/s; standard: %6.3f s, %d bytes, %d methods; osr: %6.3f s, %d bytes, %d methods; nmethods_size: %d bytes; nmethods_code_size: %d bytes}",
+  tty->print_cr("  %s {speed: %6.3f bytes/s; standard: %6.3f s, %d bytes, %d methods; osr: %6.3f s, %d bytes, %d methods; nmethods_size: %d bytes; nmethods_code_size: %d bytes; regalloc: %6.3f s}",
                 name, stats->bytes_per_second(),
                 stats->_standard._time.seconds(), stats->_standard._bytes, stats->_standard._count,
                 stats->_osr._time.seconds(), stats->_osr._bytes, stats->_osr._count,
-                stats->_nmethods_size, stats->_nmethods_code_size);
+                stats->_nmethods_size, stats->_nmethods_code_size,
+                stats->_regalloc_time.seconds());
 }
 
 void CompileBroker::print_times(bool per_compiler, bool aggregate) {
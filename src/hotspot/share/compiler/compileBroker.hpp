@@ -204,6 +204,10 @@ class CompileBroker: AllStatic {
   static PerfVariable*       _perf_last_failed_type;
   static PerfVariable*       _perf_last_invalidated_type;
 
+  // Histogram of the time tasks waited in a compile queue, per tier
+  enum { queue_wait_buckets = 5 };
+  static PerfCounter* _perf_queue_wait[CompLevel_full_optimization][queue_wait_buckets];
+
   // Timers and counters for generating statistics
   static elapsedTimer _t_total_compilation;
   static elapsedTimer _t_osr_compilation;
@@ -259,6 +263,7 @@ class CompileBroker: AllStatic {
   static void post_compile(CompilerThread* thread, CompileTask* task, bool success, ciEnv* ci_env,
                            int compilable, const char* failure_reason);
   static void update_compile_perf_data(CompilerThread *thread, const methodHandle& method, bool is_osr);
+  static void update_queue_wait_perf_data(CompileTask* task);
 
   static void push_jni_handle_block();
   static void pop_jni_handle_block();
@@ -292,6 +297,11 @@ public:
   static bool compilation_is_complete(const methodHandle& method, int osr_bci, int comp_level);
   static bool compilation_is_in_queue(const methodHandle& method);
   static void print_compile_queues(outputStream* st);
+  // Waits until both compile queues are empty and no compilation is in
+  // progress, or the timeout expires. Returns false on timeout.
+  static bool wait_for_compile_queues_empty(jlong timeout_ms, TRAPS);
+  // Whether a compiler thread is working on a task
+  static bool is_compilation_in_progress();
   static int queue_size(int comp_level) {
     CompileQueue *q = compile_queue(comp_level);
     return q != NULL ? q->size() : 0;
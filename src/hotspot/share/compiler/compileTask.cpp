@@ -106,6 +106,7 @@ void CompileTask::initialize(int compile_id,
   JVMCI_ONLY(_blocking_jvmci_compile_state = NULL;)
   _comp_level = comp_level;
   _num_inlined_bytecodes = 0;
+  _regalloc_time.reset();
 
   _is_complete = false;
   _is_success = false;
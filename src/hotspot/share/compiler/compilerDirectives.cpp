@@ -25,14 +25,19 @@
 #include "precompiled.hpp"
 #include "ci/ciMethod.hpp"
 #include "ci/ciUtilities.inline.hpp"
+#include "code/codeCache.hpp"
 #include "compiler/abstractCompiler.hpp"
 #include "compiler/compilerDirectives.hpp"
 #include "compiler/compilerOracle.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/resourceArea.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/deoptimization.hpp"
 #include "runtime/globals_extension.hpp"
+#include "runtime/timer.hpp"
 
-CompilerDirectives::CompilerDirectives() : _next(NULL), _match(NULL), _ref_count(0) {
+CompilerDirectives::CompilerDirectives() : _next(NULL), _match(NULL), _ref_count(0),
+                                           _compile_count(0), _deopt_count(0), _compile_ticks(0), _code_size(0) {
   _c1_store = new DirectiveSet(this);
   _c1_store->init_control_intrinsic();
   _c2_store = new DirectiveSet(this);
@@ -75,6 +80,9 @@ void CompilerDirectives::print(outputStream* st) {
       tmp = tmp->next();
     }
     st->cr();
+    st->print_cr(" statistics: %u compiles, %.3f ms, " SIZE_FORMAT " bytes of code, %u deopts",
+                 Atomic::load(&_compile_count), TimeHelper::counter_to_millis(Atomic::load(&_compile_ticks)),
+                 Atomic::load(&_code_size), Atomic::load(&_deopt_count));
   } else {
     assert(0, "There should always be a match");
   }
@@ -127,6 +135,16 @@ void DirectiveSet::finalize(outputStream* st) {
   }
 }
 
+void CompilerDirectives::record_compile(const elapsedTimer& time, int code_size) {
+  Atomic::inc(&_compile_count);
+  Atomic::add(&_compile_ticks, time.ticks());
+  Atomic::add(&_code_size, (size_t)code_size);
+}
+
+void CompilerDirectives::record_deopt() {
+  Atomic::inc(&_deopt_count);
+}
+
 CompilerDirectives* CompilerDirectives::next() {
   return _next;
 }
@@ -577,6 +595,11 @@ DirectiveSet* DirectivesStack::getDefaultDirective(AbstractCompiler* comp) {
 
 void DirectivesStack::push(CompilerDirectives* directive) {
   MutexLocker locker(DirectivesStack_lock, Mutex::_no_safepoint_check_flag);
+  push_inner(directive);
+}
+
+void DirectivesStack::push_inner(CompilerDirectives* directive) {
+  assert(DirectivesStack_lock->owned_by_self(), "");
 
   directive->inc_refcount();
   if (_top == NULL) {
@@ -610,9 +633,72 @@ void DirectivesStack::pop_inner() {
   DirectivesStack::release(tmp);
 }
 
-bool DirectivesStack::check_capacity(int request_size, outputStream* st) {
-  if ((request_size + _depth) > CompilerDirectivesLimit) {
-    st->print_cr("Could not add %i more directives. Currently %i/%i directives.", request_size, _depth, CompilerDirectivesLimit);
+// Deoptimizes the compiled methods matching any of the directives, so that
+// they are recompiled with the directives now on the stack.
+static int deoptimize_matching(GrowableArray<CompilerDirectives*>* directives) {
+  Thread* thread = Thread::current();
+  int marked = 0;
+  {
+    MutexLocker mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+    CompiledMethodIterator iter(CompiledMethodIterator::only_alive_and_not_unloading);
+    while (iter.next()) {
+      CompiledMethod* cm = iter.method();
+      if (cm->is_native_method() || cm->is_marked_for_deoptimization()) {
+        continue;
+      }
+      methodHandle mh(thread, cm->method());
+      for (int i = 0; i < directives->length(); i++) {
+        if (directives->at(i)->match(mh)) {
+          cm->mark_for_deoptimization();
+          marked++;
+          break;
+        }
+      }
+    }
+  }
+  if (marked > 0) {
+    Deoptimization::deoptimize_all_marked();
+  }
+  return marked;
+}
+
+// Replaces all directives but the default one in a single step, so that no
+// compilation sees a mix of old and new directives. Returns the number of
+// compiled methods deoptimized because an old or a new directive matches them.
+int DirectivesStack::replace(CompilerDirectives** directives, int count) {
+  ResourceMark rm;
+  GrowableArray<CompilerDirectives*> affected;
+  {
+    MutexLocker locker(DirectivesStack_lock, Mutex::_no_safepoint_check_flag);
+    // Keep the replaced directives until the methods they match are deoptimized
+    for (CompilerDirectives* dir = _top; !dir->is_default_directive(); dir = dir->next()) {
+      dir->inc_refcount();
+      affected.append(dir);
+    }
+    while (_top->next() != NULL) {
+      pop_inner();
+    }
+    for (int i = 0; i < count; i++) {
+      push_inner(directives[i]);
+      directives[i]->inc_refcount();
+      affected.append(directives[i]);
+    }
+  }
+
+  int deoptimized = deoptimize_matching(&affected);
+
+  MutexLocker locker(DirectivesStack_lock, Mutex::_no_safepoint_check_flag);
+  for (int i = 0; i < affected.length(); i++) {
+    release(affected.at(i));
+  }
+  return deoptimized;
+}
+
+bool DirectivesStack::check_capacity(int request_size, outputStream* st, bool replace) {
+  // A replace keeps only the default directive
+  int depth = replace ? 1 : _depth;
+  if ((request_size + depth) > CompilerDirectivesLimit) {
+    st->print_cr("Could not add %i more directives. Currently %i/%i directives.", request_size, depth, CompilerDirectivesLimit);
     return false;
   }
   return true;
@@ -657,6 +743,18 @@ void DirectivesStack::release(CompilerDirectives* dir) {
   }
 }
 
+// Accounts a deoptimization of a compiled frame of the method to the first
+// directive matching the method.
+void DirectivesStack::record_deoptimization(const methodHandle& method) {
+  MutexLocker locker(DirectivesStack_lock, Mutex::_no_safepoint_check_flag);
+  for (CompilerDirectives* dir = _top; dir != NULL; dir = dir->next()) {
+    if (dir->match(method)) {
+      dir->record_deopt();
+      return;
+    }
+  }
+}
+
 DirectiveSet* DirectivesStack::getMatchingDirective(const methodHandle& method, AbstractCompiler *comp) {
   assert(_depth > 0, "Must never be empty");
 
@@ -81,6 +81,7 @@ NOT_PRODUCT(cflags(IGVPrintLevel,       intx, PrintIdealGraphLevel, IGVPrintLeve
 class AbstractCompiler;
 class CompilerDirectives;
 class DirectiveSet;
+class elapsedTimer;
 
 class DirectivesStack : AllStatic {
 private:
@@ -88,6 +89,7 @@ private:
   static CompilerDirectives* _bottom;
   static int _depth;
 
+  static void push_inner(CompilerDirectives* directive); // no lock version of push
   static void pop_inner(); // no lock version of pop
 public:
   static void init();
@@ -95,11 +97,13 @@ public:
   static DirectiveSet* getDefaultDirective(AbstractCompiler* comp);
   static void push(CompilerDirectives* directive);
   static void pop(int count);
-  static bool check_capacity(int request_size, outputStream* st);
+  static int  replace(CompilerDirectives** directives, int count);
+  static bool check_capacity(int request_size, outputStream* st, bool replace = false);
   static void clear();
   static void print(outputStream* st);
   static void release(DirectiveSet* set);
   static void release(CompilerDirectives* dir);
+  static void record_deoptimization(const methodHandle& method);
 };
 
 class DirectiveSet : public CHeapObj<mtCompiler> {
@@ -230,6 +234,12 @@ private:
   BasicMatcher* _match;
   int _ref_count;
 
+  // Statistics of the compilations done with this directive
+  volatile uint   _compile_count;
+  volatile uint   _deopt_count;
+  volatile jlong  _compile_ticks;
+  volatile size_t _code_size;
+
 public:
 
   CompilerDirectives();
@@ -246,6 +256,9 @@ public:
   bool is_default_directive() { return _next == NULL; }
   void finalize(outputStream* st);
 
+  void record_compile(const elapsedTimer& time, int code_size);
+  void record_deopt();
+
   void inc_refcount();
   void dec_refcount();
   int refcount();
@@ -43,6 +43,8 @@ CompilerThread::CompilerThread(CompileQueue* queue,
 
   // Compiler uses resource area for compilation, let's bias it to mtCompiler
   resource_area()->bias_to(mtCompiler);
+  // Compilations churn through arena chunks, keep some of them at hand
+  chunk_cache()->enable();
 
 #ifndef PRODUCT
   _ideal_graph_printer = NULL;
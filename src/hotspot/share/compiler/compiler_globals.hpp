@@ -258,6 +258,10 @@
           "cache is filled by the specified percentage")                    \
           range(0, 99)                                                      \
                                                                             \
+  product(bool, TieredLatencyAwareSelection, false,                         \
+          "Select queued compilations by invocation rate times estimated "  \
+          "interpreted time per invocation, with OSR compilations first")   \
+                                                                            \
   product(intx, TieredRateUpdateMinTime, 1,                                 \
           "Minimum rate sampling interval (in milliseconds)")               \
           range(0, max_intx)                                                \
@@ -301,6 +305,19 @@
   product(ccstrlist, CompileCommand, "",                                    \
           "Prepend to .hotspot_compiler; e.g. log,java/lang/String.<init>") \
                                                                             \
+  product(ccstr, DumpCompiledMethodsFile, NULL,                             \
+          "At exit, write the methods that have compiled code to this "     \
+          "file, for use with PrecompileMethodsFile")                       \
+                                                                            \
+  product(ccstr, PrecompileMethodsFile, NULL,                               \
+          "Compile the methods listed in this file, as written by "         \
+          "DumpCompiledMethodsFile, when their classes are initialized")    \
+                                                                            \
+  product(double, PrecompiledTier4ThresholdScaling, 0.1,                   \
+          "Factor for the tier 4 thresholds of methods that were compiled " \
+          "at tier 4 according to PrecompileMethodsFile")                   \
+          range(0.0, 1.0)                                                   \
+                                                                            \
   develop(bool, ReplayCompiles, false,                                      \
           "Enable replay of compilations from ReplayDataFile")              \
                                                                             \
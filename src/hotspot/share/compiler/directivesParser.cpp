@@ -56,10 +56,10 @@ void DirectivesParser::clean_tmp() {
   assert(_tmp_depth == 0, "Consistency");
 }
 
-int DirectivesParser::parse_string(const char* text, outputStream* st) {
+int DirectivesParser::parse_string(const char* text, outputStream* st, bool replace) {
   DirectivesParser cd(text, st, false);
   if (cd.valid()) {
-    return cd.install_directives();
+    return cd.install_directives(replace);
   } else {
     cd.clean_tmp();
     st->flush();
@@ -76,16 +76,16 @@ bool DirectivesParser::parse_from_flag() {
   return parse_from_file(CompilerDirectivesFile, tty);
 }
 
-bool DirectivesParser::parse_from_file(const char* filename, outputStream* st) {
+bool DirectivesParser::parse_from_file(const char* filename, outputStream* st, bool replace) {
   assert(filename != NULL, "Test before calling this");
-  if (!parse_from_file_inner(filename, st)) {
+  if (!parse_from_file_inner(filename, st, replace)) {
     st->print_cr("Could not load file: %s", filename);
     return false;
   }
   return true;
 }
 
-bool DirectivesParser::parse_from_file_inner(const char* filename, outputStream* stream) {
+bool DirectivesParser::parse_from_file_inner(const char* filename, outputStream* stream, bool replace) {
   struct stat st;
   ResourceMark rm;
   if (os::stat(filename, &st) == 0) {
@@ -99,20 +99,40 @@ bool DirectivesParser::parse_from_file_inner(const char* filename, outputStream*
         buffer[num_read] = '\0';
         // close file
         os::close(file_handle);
-        return parse_string(buffer, stream) > 0;
+        return parse_string(buffer, stream, replace) > 0;
       }
     }
   }
   return false;
 }
 
-int DirectivesParser::install_directives() {
+int DirectivesParser::install_directives(bool replace) {
   // Check limit
-  if (!DirectivesStack::check_capacity(_tmp_depth, _st)) {
+  if (!DirectivesStack::check_capacity(_tmp_depth, _st, replace)) {
     clean_tmp();
     return 0;
   }
 
+  if (replace) {
+    if (_tmp_depth == 0) {
+      _st->print_cr("No directives in file");
+      return 0;
+    }
+    // Pop from internal temporary stack and replace the compileBroker's stack at once.
+    ResourceMark rm;
+    CompilerDirectives** dirs = NEW_RESOURCE_ARRAY(CompilerDirectives*, _tmp_depth);
+    int i = 0;
+    for (CompilerDirectives* tmp = pop_tmp(); tmp != NULL; tmp = pop_tmp()) {
+      dirs[i++] = tmp;
+    }
+    int deoptimized = DirectivesStack::replace(dirs, i);
+    _st->print_cr("%i compiler directives installed, %i compiled methods deoptimized", i, deoptimized);
+    if (CompilerDirectivesPrint) {
+      DirectivesStack::print(_st);
+    }
+    return i;
+  }
+
   // Pop from internal temporary stack and push to compileBroker.
   CompilerDirectives* tmp = pop_tmp();
   int i = 0;
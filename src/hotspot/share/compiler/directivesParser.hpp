@@ -55,16 +55,16 @@ class DirectivesParser : public JSON {
  public:
   static bool has_file();
   static bool parse_from_flag();
-  static bool parse_from_file(const char* filename, outputStream* st);
-  static int  parse_string(const char* string, outputStream* st);
-  int install_directives();
+  static bool parse_from_file(const char* filename, outputStream* st, bool replace = false);
+  static int  parse_string(const char* string, outputStream* st, bool replace = false);
+  int install_directives(bool replace = false);
 
  private:
   DirectivesParser(const char* text, outputStream* st, bool silent);
   ~DirectivesParser();
 
   bool callback(JSON_TYPE t, JSON_VAL* v, uint level);
-  static bool parse_from_file_inner(const char* filename, outputStream* st);
+  static bool parse_from_file_inner(const char* filename, outputStream* st, bool replace);
 
   // types of "keys". i.e recognized <key>:<value> pairs in our JSON syntax
   typedef enum {
@@ -24,19 +24,27 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
+#include "code/codeCache.hpp"
 #include "gc/epsilon/epsilonHeap.hpp"
 #include "gc/epsilon/epsilonInitLogger.hpp"
 #include "gc/epsilon/epsilonMemoryPool.hpp"
 #include "gc/epsilon/epsilonThreadLocalData.hpp"
 #include "gc/shared/gcArguments.hpp"
 #include "gc/shared/locationPrinter.inline.hpp"
+#include "gc/shared/oopStorageSet.inline.hpp"
+#include "gc/shared/spaceDecorator.inline.hpp"
+#include "gc/shared/weakProcessor.hpp"
 #include "memory/allocation.hpp"
 #include "memory/allocation.inline.hpp"
+#include "memory/iterator.inline.hpp"
 #include "memory/metaspaceUtils.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
+#include "oops/access.inline.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/globals.hpp"
+#include "runtime/thread.hpp"
 
 jint EpsilonHeap::initialize() {
   size_t align = HeapAlignment;
@@ -296,6 +304,111 @@ void EpsilonHeap::object_iterate(ObjectClosure *cl) {
   _space->object_iterate(cl);
 }
 
+void EpsilonHeap::after_restore() {
+  if (!EpsilonResetToWatermark) {
+    return;
+  }
+  assert(SafepointSynchronize::is_at_safepoint(), "Expected at safepoint");
+  // Retire the TLABs, so that everything allocated from now on is above
+  // the watermark, and everything below it is parseable.
+  ensure_parsability(true /* retire_tlabs */);
+  _watermark = _space->top();
+  log_info(gc)("Heap watermark set at " SIZE_FORMAT "%s used",
+               byte_size_in_proper_unit(used()), proper_unit_for_byte_size(used()));
+}
+
+// Finds references to objects at or above the watermark.
+class EpsilonFindAboveWatermarkClosure : public BasicOopIterateClosure {
+  HeapWord* const _watermark;
+  size_t _found;
+  const void* _first_location;
+
+  template <class T>
+  void do_oop_work(T* p) {
+    oop obj = RawAccess<>::oop_load(p);
+    if (obj != NULL && cast_from_oop<HeapWord*>(obj) >= _watermark) {
+      if (_found++ == 0) {
+        _first_location = p;
+      }
+    }
+  }
+
+public:
+  EpsilonFindAboveWatermarkClosure(HeapWord* watermark) :
+    _watermark(watermark), _found(0), _first_location(NULL) {}
+
+  virtual void do_oop(oop* p)       { do_oop_work(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_work(p); }
+
+  size_t found() const                { return _found; }
+  const void* first_location() const  { return _first_location; }
+};
+
+class EpsilonBelowWatermarkIsAliveClosure : public BoolObjectClosure {
+  HeapWord* const _watermark;
+public:
+  EpsilonBelowWatermarkIsAliveClosure(HeapWord* watermark) : _watermark(watermark) {}
+  bool do_object_b(oop obj) { return cast_from_oop<HeapWord*>(obj) < _watermark; }
+};
+
+bool EpsilonHeap::reset_to_watermark(outputStream* st) {
+  assert(SafepointSynchronize::is_at_safepoint(), "Expected at safepoint");
+  if (_watermark == NULL) {
+    st->print_cr("No heap watermark, requires -XX:+EpsilonResetToWatermark and a restore from a checkpoint");
+    return false;
+  }
+
+  // Make the heap above the watermark parseable too, and make the threads
+  // take new TLABs once allocation resumes.
+  ensure_parsability(true /* retire_tlabs */);
+
+  // Everything below the watermark survives, so nothing below it may refer
+  // to the objects about to be dropped: neither objects, nor strong roots.
+  EpsilonFindAboveWatermarkClosure cl(_watermark);
+  for (HeapWord* p = _space->bottom(); p < _watermark; ) {
+    oop obj = cast_to_oop(p);
+    obj->oop_iterate(&cl);
+    p += obj->size();
+  }
+  size_t from_heap = cl.found();
+
+  CLDToOopClosure cld_cl(&cl, ClassLoaderData::_claim_none);
+  CodeBlobToOopClosure code_cl(&cl, !CodeBlobToOopClosure::FixRelocations);
+  ClassLoaderDataGraph::cld_do(&cld_cl);
+  Threads::oops_do(&cl, NULL);
+  OopStorageSet::strong_oops_do(&cl);
+  CodeCache::blobs_do(&code_cl);
+
+  if (cl.found() > 0) {
+    st->print_cr("Heap not reset: " SIZE_FORMAT " references from below the watermark, " SIZE_FORMAT
+                 " of them from roots, first at " PTR_FORMAT,
+                 cl.found(), cl.found() - from_heap, p2i(cl.first_location()));
+    return false;
+  }
+
+  // Weak references to the dropped objects are cleared as for dead objects.
+  EpsilonBelowWatermarkIsAliveClosure is_alive(_watermark);
+  DoNothingClosure keep_alive;
+  WeakProcessor::weak_oops_do(&is_alive, &keep_alive);
+
+  size_t used_before = used();
+  if (ZapUnusedHeapArea) {
+    SpaceMangler::mangle_region(MemRegion(_watermark, _space->top()));
+  }
+  _space->set_top(_watermark);
+
+  size_t used_after = used();
+  _last_counter_update = used_after;
+  _last_heap_print = used_after;
+  _monitoring_support->update_counters();
+
+  log_info(gc)("Heap reset to watermark: " SIZE_FORMAT "%s -> " SIZE_FORMAT "%s",
+               byte_size_in_proper_unit(used_before), proper_unit_for_byte_size(used_before),
+               byte_size_in_proper_unit(used_after), proper_unit_for_byte_size(used_after));
+  st->print_cr("Heap reset to watermark, released " SIZE_FORMAT "K", (used_before - used_after) / K);
+  return true;
+}
+
 void EpsilonHeap::print_on(outputStream *st) const {
   st->print_cr("Epsilon Heap");
 
@@ -47,13 +47,15 @@ private:
   int64_t _decay_time_ns;
   volatile size_t _last_counter_update;
   volatile size_t _last_heap_print;
+  HeapWord* _watermark;
 
 public:
   static EpsilonHeap* heap();
 
   EpsilonHeap() :
           _memory_manager("Epsilon Heap"),
-          _space(NULL) {};
+          _space(NULL),
+          _watermark(NULL) {};
 
   virtual Name kind() const {
     return CollectedHeap::Epsilon;
@@ -106,6 +108,11 @@ public:
   // Heap walking support
   virtual void object_iterate(ObjectClosure* cl);
 
+  // Reset to checkpoint watermark support
+  virtual void after_restore();
+  HeapWord* watermark() const { return _watermark; }
+  bool reset_to_watermark(outputStream* st);
+
   // Object pinning support: every object is implicitly pinned
   virtual bool supports_object_pinning() const           { return true; }
   virtual oop pin_object(JavaThread* thread, oop obj)    { return obj; }
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/epsilon/epsilonHeap.hpp"
+#include "gc/epsilon/epsilonResetDCmd.hpp"
+#include "gc/shared/gc_globals.hpp"
+#include "runtime/vmOperation.hpp"
+#include "runtime/vmThread.hpp"
+#include "utilities/ostream.hpp"
+
+class VM_EpsilonResetToWatermark : public VM_Operation {
+  outputStream* const _out;
+
+public:
+  VM_EpsilonResetToWatermark(outputStream* out) : _out(out) { }
+  VMOp_Type type() const { return VMOp_EpsilonResetToWatermark; }
+
+  void doit() {
+    EpsilonHeap::heap()->reset_to_watermark(_out);
+  }
+};
+
+void EpsilonResetDCmd::execute(DCmdSource source, TRAPS) {
+  if (!UseEpsilonGC) {
+    output()->print_cr("Epsilon GC is not enabled");
+    return;
+  }
+  VM_EpsilonResetToWatermark op(output());
+  VMThread::execute(&op);
+}
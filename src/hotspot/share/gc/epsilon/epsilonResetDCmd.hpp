@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_EPSILON_EPSILONRESETDCMD_HPP
+#define SHARE_GC_EPSILON_EPSILONRESETDCMD_HPP
+
+#include "services/diagnosticCommand.hpp"
+
+class outputStream;
+
+// Drops all objects allocated since the restore from a checkpoint, given
+// -XX:+EpsilonResetToWatermark. Fails without changing the heap if any
+// object or root below the watermark refers to an object above it.
+class EpsilonResetDCmd : public DCmd {
+public:
+  EpsilonResetDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
+  static const char* name() {
+    return "GC.epsilon_reset";
+  }
+  static const char* description() {
+    return "Reset the Epsilon heap to the watermark recorded on restore from a checkpoint.";
+  }
+  static const char* impact() {
+    return "High: Requires a safepoint, walks the heap below the watermark and all roots.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "control", NULL};
+    return p;
+  }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+#endif // SHARE_GC_EPSILON_EPSILONRESETDCMD_HPP
@@ -86,7 +86,12 @@
   product(size_t, EpsilonMinHeapExpand, 128 * M, EXPERIMENTAL,              \
           "Min expansion step for heap. Larger value improves performance " \
           "at the potential expense of memory waste.")                      \
-          range(1, max_intx)
+          range(1, max_intx)                                                \
+                                                                            \
+  product(bool, EpsilonResetToWatermark, false, EXPERIMENTAL,               \
+          "Record the heap top on restore from a checkpoint as watermark, " \
+          "and allow GC.epsilon_reset to drop all objects allocated above " \
+          "it, provided no object or root below refers to them.")
 
 // end of GC_EPSILON_FLAGS
 
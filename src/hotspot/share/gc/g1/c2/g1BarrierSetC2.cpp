@@ -401,6 +401,10 @@ void G1BarrierSetC2::post_barrier(GraphKit* kit,
     return;
   }
 
+  if (use_ReduceInitialCardMarks() && is_allocated_without_safepoint(kit, obj)) {
+    return;
+  }
+
   if (!use_precise) {
     // All card marks for a (non-array) instance are in one place:
     adr = obj;
@@ -33,6 +33,7 @@
 #include "gc/g1/heapRegion.inline.hpp"
 #include "gc/g1/heapRegionSet.inline.hpp"
 #include "gc/g1/heapRegionType.hpp"
+#include "gc/shared/gc_globals.hpp"
 #include "gc/shared/tlab_globals.hpp"
 #include "utilities/align.hpp"
 
@@ -44,8 +45,9 @@ G1Allocator::G1Allocator(G1CollectedHeap* heap) :
   _num_alloc_regions(_numa->num_active_nodes()),
   _mutator_alloc_regions(NULL),
   _survivor_gc_alloc_regions(NULL),
-  _old_gc_alloc_region(heap->alloc_buffer_stats(G1HeapRegionAttr::Old)),
-  _retained_old_gc_alloc_region(NULL) {
+  _num_old_alloc_regions(G1NUMAOldGenEvacuation && _numa->is_enabled() ? _numa->num_active_nodes() : 1),
+  _old_gc_alloc_regions(NULL),
+  _retained_old_gc_alloc_regions(NULL) {
 
   _mutator_alloc_regions = NEW_C_HEAP_ARRAY(MutatorAllocRegion, _num_alloc_regions, mtGC);
   _survivor_gc_alloc_regions = NEW_C_HEAP_ARRAY(SurvivorGCAllocRegion, _num_alloc_regions, mtGC);
@@ -55,6 +57,16 @@ G1Allocator::G1Allocator(G1CollectedHeap* heap) :
     ::new(_mutator_alloc_regions + i) MutatorAllocRegion(i);
     ::new(_survivor_gc_alloc_regions + i) SurvivorGCAllocRegion(stat, i);
   }
+
+  _old_gc_alloc_regions = NEW_C_HEAP_ARRAY(OldGCAllocRegion, _num_old_alloc_regions, mtGC);
+  _retained_old_gc_alloc_regions = NEW_C_HEAP_ARRAY(HeapRegion*, _num_old_alloc_regions, mtGC);
+  G1EvacStats* old_stat = heap->alloc_buffer_stats(G1HeapRegionAttr::Old);
+
+  for (uint i = 0; i < _num_old_alloc_regions; i++) {
+    // A single old alloc region takes regions from any node.
+    ::new(_old_gc_alloc_regions + i) OldGCAllocRegion(old_stat, _num_old_alloc_regions > 1 ? i : G1NUMA::AnyNodeIndex);
+    _retained_old_gc_alloc_regions[i] = NULL;
+  }
 }
 
 G1Allocator::~G1Allocator() {
@@ -62,8 +74,13 @@ G1Allocator::~G1Allocator() {
     _mutator_alloc_regions[i].~MutatorAllocRegion();
     _survivor_gc_alloc_regions[i].~SurvivorGCAllocRegion();
   }
+  for (uint i = 0; i < _num_old_alloc_regions; i++) {
+    _old_gc_alloc_regions[i].~OldGCAllocRegion();
+  }
   FREE_C_HEAP_ARRAY(MutatorAllocRegion, _mutator_alloc_regions);
   FREE_C_HEAP_ARRAY(SurvivorGCAllocRegion, _survivor_gc_alloc_regions);
+  FREE_C_HEAP_ARRAY(OldGCAllocRegion, _old_gc_alloc_regions);
+  FREE_C_HEAP_ARRAY(HeapRegion*, _retained_old_gc_alloc_regions);
 }
 
 #ifdef ASSERT
@@ -88,12 +105,16 @@ void G1Allocator::release_mutator_alloc_regions() {
 }
 
 bool G1Allocator::is_retained_old_region(HeapRegion* hr) {
-  return _retained_old_gc_alloc_region == hr;
+  for (uint i = 0; i < _num_old_alloc_regions; i++) {
+    if (_retained_old_gc_alloc_regions[i] == hr) {
+      return true;
+    }
+  }
+  return false;
 }
 
-void G1Allocator::reuse_retained_old_region(G1EvacuationInfo* evacuation_info,
-                                            OldGCAllocRegion* old,
-                                            HeapRegion** retained_old) {
+size_t G1Allocator::reuse_retained_old_region(OldGCAllocRegion* old,
+                                              HeapRegion** retained_old) {
   HeapRegion* retained_region = *retained_old;
   *retained_old = NULL;
   assert(retained_region == NULL || !retained_region->is_archive(),
@@ -120,8 +141,9 @@ void G1Allocator::reuse_retained_old_region(G1EvacuationInfo* evacuation_info,
     _g1h->old_set_remove(retained_region);
     old->set(retained_region);
     _g1h->hr_printer()->reuse(retained_region);
-    evacuation_info->set_alloc_regions_used_before(retained_region->used());
+    return retained_region->used();
   }
+  return 0;
 }
 
 void G1Allocator::init_gc_alloc_regions(G1EvacuationInfo* evacuation_info) {
@@ -134,10 +156,13 @@ void G1Allocator::init_gc_alloc_regions(G1EvacuationInfo* evacuation_info) {
     survivor_gc_alloc_region(i)->init();
   }
 
-  _old_gc_alloc_region.init();
-  reuse_retained_old_region(evacuation_info,
-                            &_old_gc_alloc_region,
-                            &_retained_old_gc_alloc_region);
+  size_t used_before = 0;
+  for (uint i = 0; i < _num_old_alloc_regions; i++) {
+    _old_gc_alloc_regions[i].init();
+    used_before += reuse_retained_old_region(&_old_gc_alloc_regions[i],
+                                             &_retained_old_gc_alloc_regions[i]);
+  }
+  evacuation_info->set_alloc_regions_used_before(used_before);
 }
 
 void G1Allocator::release_gc_alloc_regions(G1EvacuationInfo* evacuation_info) {
@@ -146,23 +171,26 @@ void G1Allocator::release_gc_alloc_regions(G1EvacuationInfo* evacuation_info) {
     survivor_region_count += survivor_gc_alloc_region(node_index)->count();
     survivor_gc_alloc_region(node_index)->release();
   }
-  evacuation_info->set_allocation_regions(survivor_region_count +
-                                          old_gc_alloc_region()->count());
-
-  // If we have an old GC alloc region to release, we'll save it in
-  // _retained_old_gc_alloc_region. If we don't
-  // _retained_old_gc_alloc_region will become NULL. This is what we
-  // want either way so no reason to check explicitly for either
-  // condition.
-  _retained_old_gc_alloc_region = old_gc_alloc_region()->release();
+  uint old_region_count = 0;
+  for (uint i = 0; i < _num_old_alloc_regions; i++) {
+    old_region_count += _old_gc_alloc_regions[i].count();
+    // If we have an old GC alloc region to release, we'll save it in
+    // _retained_old_gc_alloc_regions. If we don't the entry
+    // will become NULL. This is what we want either way so no reason
+    // to check explicitly for either condition.
+    _retained_old_gc_alloc_regions[i] = _old_gc_alloc_regions[i].release();
+  }
+  evacuation_info->set_allocation_regions(survivor_region_count + old_region_count);
 }
 
 void G1Allocator::abandon_gc_alloc_regions() {
   for (uint i = 0; i < _num_alloc_regions; i++) {
     assert(survivor_gc_alloc_region(i)->get() == NULL, "pre-condition");
   }
-  assert(old_gc_alloc_region()->get() == NULL, "pre-condition");
-  _retained_old_gc_alloc_region = NULL;
+  for (uint i = 0; i < _num_old_alloc_regions; i++) {
+    assert(_old_gc_alloc_regions[i].get() == NULL, "pre-condition");
+    _retained_old_gc_alloc_regions[i] = NULL;
+  }
 }
 
 bool G1Allocator::survivor_is_full() const {
@@ -232,7 +260,7 @@ HeapWord* G1Allocator::par_allocate_during_gc(G1HeapRegionAttr dest,
     case G1HeapRegionAttr::Young:
       return survivor_attempt_allocation(min_word_size, desired_word_size, actual_word_size, node_index);
     case G1HeapRegionAttr::Old:
-      return old_attempt_allocation(min_word_size, desired_word_size, actual_word_size);
+      return old_attempt_allocation(min_word_size, desired_word_size, actual_word_size, node_index);
     default:
       ShouldNotReachHere();
       return NULL; // Keep some compilers happy
@@ -266,18 +294,19 @@ HeapWord* G1Allocator::survivor_attempt_allocation(size_t min_word_size,
 
 HeapWord* G1Allocator::old_attempt_allocation(size_t min_word_size,
                                               size_t desired_word_size,
-                                              size_t* actual_word_size) {
+                                              size_t* actual_word_size,
+                                              uint node_index) {
   assert(!_g1h->is_humongous(desired_word_size),
          "we should not be seeing humongous-size allocations in this path");
 
-  HeapWord* result = old_gc_alloc_region()->attempt_allocation(min_word_size,
-                                                               desired_word_size,
-                                                               actual_word_size);
+  HeapWord* result = old_gc_alloc_region(node_index)->attempt_allocation(min_word_size,
+                                                                         desired_word_size,
+                                                                         actual_word_size);
   if (result == NULL && !old_is_full()) {
     MutexLocker x(FreeList_lock, Mutex::_no_safepoint_check_flag);
-    result = old_gc_alloc_region()->attempt_allocation_locked(min_word_size,
-                                                              desired_word_size,
-                                                              actual_word_size);
+    result = old_gc_alloc_region(node_index)->attempt_allocation_locked(min_word_size,
+                                                                        desired_word_size,
+                                                                        actual_word_size);
     if (result == NULL) {
       set_old_full();
     }
@@ -287,13 +316,23 @@ HeapWord* G1Allocator::old_attempt_allocation(size_t min_word_size,
 
 G1PLABAllocator::G1PLABAllocator(G1Allocator* allocator) :
   _g1h(G1CollectedHeap::heap()),
-  _allocator(allocator) {
+  _allocator(allocator),
+  // The last PLAB of a thread is wasted at worst.  After this many refills
+  // that is within TargetPLABWastePct of what the thread allocated in PLABs
+  // even for a PLAB of twice the size.
+  _tolerated_refills(MAX2(100 / MAX2(TargetPLABWastePct, (uintx)1), (uintx)1)) {
   for (region_type_t state = 0; state < G1HeapRegionAttr::Num; state++) {
     _direct_allocated[state] = 0;
+    size_t plab_size = _g1h->desired_plab_sz(state);
+    if (ResizePLAB && G1PerWorkerPLABResize) {
+      plab_size = MAX2(plab_size / 2, PLAB::min_size());
+    }
+    _cur_plab_size[state] = plab_size;
+    _plab_fill_counter[state] = _tolerated_refills;
     uint length = alloc_buffers_length(state);
     _alloc_buffers[state] = NEW_C_HEAP_ARRAY(PLAB*, length, mtGC);
     for (uint node_index = 0; node_index < length; node_index++) {
-      _alloc_buffers[state][node_index] = new PLAB(_g1h->desired_plab_sz(state));
+      _alloc_buffers[state][node_index] = new PLAB(plab_size);
     }
     _num_plab_fills[state] = 0;
     _num_direct_allocations[state] = 0;
@@ -314,11 +353,24 @@ bool G1PLABAllocator::may_throw_away_buffer(size_t const allocation_word_sz, siz
   return (allocation_word_sz * 100 < buffer_size * ParallelGCBufferWastePct);
 }
 
+void G1PLABAllocator::update_plab_size(region_type_t dest) {
+  if (!ResizePLAB || !G1PerWorkerPLABResize) {
+    return;
+  }
+  if (--_plab_fill_counter[dest] > 0) {
+    return;
+  }
+  _plab_fill_counter[dest] = _tolerated_refills;
+  // Same limit as G1CollectedHeap::desired_plab_sz: no humongous PLABs.
+  size_t max_size = MIN2(PLAB::max_size(), G1CollectedHeap::humongous_threshold_for(HeapRegion::GrainWords));
+  _cur_plab_size[dest] = MIN2(_cur_plab_size[dest] * 2, max_size);
+}
+
 HeapWord* G1PLABAllocator::allocate_direct_or_new_plab(G1HeapRegionAttr dest,
                                                        size_t word_sz,
                                                        bool* plab_refill_failed,
                                                        uint node_index) {
-  size_t plab_word_size = _g1h->desired_plab_sz(dest);
+  size_t plab_word_size = _cur_plab_size[dest.type()];
   size_t required_in_plab = PLAB::size_required_for_allocation(word_sz);
 
   // Only get a new PLAB if the allocation fits and it would not waste more than
@@ -330,6 +382,7 @@ HeapWord* G1PLABAllocator::allocate_direct_or_new_plab(G1HeapRegionAttr dest,
     alloc_buf->retire();
 
     _num_plab_fills[dest.type()]++;
+    update_plab_size(dest.type());
 
     size_t actual_plab_size = 0;
     HeapWord* buf = _allocator->par_allocate_during_gc(dest,
@@ -395,6 +448,14 @@ size_t G1PLABAllocator::waste() const {
   return result;
 }
 
+size_t G1PLABAllocator::num_plab_fills() const {
+  size_t result = 0;
+  for (region_type_t state = 0; state < G1HeapRegionAttr::Num; state++) {
+    result += _num_plab_fills[state];
+  }
+  return result;
+}
+
 size_t G1PLABAllocator::undo_waste() const {
   size_t result = 0;
   for (region_type_t state = 0; state < G1HeapRegionAttr::Num; state++) {
@@ -56,11 +56,15 @@ private:
   // survivor objects.
   SurvivorGCAllocRegion* _survivor_gc_alloc_regions;
 
+  // The number of OldGCAllocRegions used, one per memory node with
+  // G1NUMAOldGenEvacuation, otherwise one.
+  uint _num_old_alloc_regions;
+
   // Alloc region used to satisfy allocation requests by the GC for
   // old objects.
-  OldGCAllocRegion _old_gc_alloc_region;
+  OldGCAllocRegion* _old_gc_alloc_regions;
 
-  HeapRegion* _retained_old_gc_alloc_region;
+  HeapRegion** _retained_old_gc_alloc_regions;
 
   bool survivor_is_full() const;
   bool old_is_full() const;
@@ -68,14 +72,14 @@ private:
   void set_survivor_full();
   void set_old_full();
 
-  void reuse_retained_old_region(G1EvacuationInfo* evacuation_info,
-                                 OldGCAllocRegion* old,
-                                 HeapRegion** retained);
+  // Returns the bytes used in the retained region if it is reused.
+  size_t reuse_retained_old_region(OldGCAllocRegion* old,
+                                   HeapRegion** retained);
 
   // Accessors to the allocation regions.
   inline MutatorAllocRegion* mutator_alloc_region(uint node_index);
   inline SurvivorGCAllocRegion* survivor_gc_alloc_region(uint node_index);
-  inline OldGCAllocRegion* old_gc_alloc_region();
+  inline OldGCAllocRegion* old_gc_alloc_region(uint node_index);
 
   // Allocation attempt during GC for a survivor object / PLAB.
   HeapWord* survivor_attempt_allocation(size_t min_word_size,
@@ -86,7 +90,8 @@ private:
   // Allocation attempt during GC for an old object / PLAB.
   HeapWord* old_attempt_allocation(size_t min_word_size,
                                    size_t desired_word_size,
-                                   size_t* actual_word_size);
+                                   size_t* actual_word_size,
+                                   uint node_index);
 
   // Node index of current thread.
   inline uint current_node_index() const;
@@ -97,6 +102,13 @@ public:
 
   uint num_nodes() { return (uint)_num_alloc_regions; }
 
+  uint num_old_alloc_regions() const { return _num_old_alloc_regions; }
+
+  // Index of the old alloc region and PLAB used for objects from the given node.
+  uint old_alloc_region_index(uint node_index) const {
+    return node_index < _num_old_alloc_regions ? node_index : 0;
+  }
+
 #ifdef ASSERT
   // Do we currently have an active mutator region to allocate into?
   bool has_mutator_alloc_region();
@@ -165,13 +177,23 @@ private:
   size_t _num_plab_fills[G1HeapRegionAttr::Num];
   size_t _num_direct_allocations[G1HeapRegionAttr::Num];
 
+  // PLAB size used by this thread.  With G1PerWorkerPLABResize, it starts
+  // below the size computed from the global statistics and is doubled
+  // every _tolerated_refills refills, so that lightly loaded threads waste
+  // less and heavily loaded ones refill less often.
+  size_t _cur_plab_size[G1HeapRegionAttr::Num];
+  size_t _plab_fill_counter[G1HeapRegionAttr::Num];
+  size_t _tolerated_refills;
+
+  void update_plab_size(region_type_t dest);
+
   void flush_and_retire_stats();
   inline PLAB* alloc_buffer(G1HeapRegionAttr dest, uint node_index) const;
   inline PLAB* alloc_buffer(region_type_t dest, uint node_index) const;
 
   // Returns the number of allocation buffers for the given dest.
-  // There is only 1 buffer for Old while Young may have multiple buffers depending on
-  // active NUMA nodes.
+  // Young may have multiple buffers depending on active NUMA nodes. There is only
+  // 1 buffer for Old unless G1NUMAOldGenEvacuation is set.
   inline uint alloc_buffers_length(region_type_t dest) const;
 
   bool may_throw_away_buffer(size_t const allocation_word_sz, size_t const buffer_size) const;
@@ -181,6 +203,7 @@ public:
 
   size_t waste() const;
   size_t undo_waste() const;
+  size_t num_plab_fills() const;
 
   // Allocate word_sz words in dest, either directly into the regions or by
   // allocating a new PLAB. Returns the address of the allocated memory, NULL if
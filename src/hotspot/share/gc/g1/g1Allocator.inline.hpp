@@ -45,8 +45,8 @@ inline SurvivorGCAllocRegion* G1Allocator::survivor_gc_alloc_region(uint node_in
   return &_survivor_gc_alloc_regions[node_index];
 }
 
-inline OldGCAllocRegion* G1Allocator::old_gc_alloc_region() {
-  return &_old_gc_alloc_region;
+inline OldGCAllocRegion* G1Allocator::old_gc_alloc_region(uint node_index) {
+  return &_old_gc_alloc_regions[old_alloc_region_index(node_index)];
 }
 
 inline HeapWord* G1Allocator::attempt_allocation(size_t min_word_size,
@@ -103,7 +103,7 @@ inline PLAB* G1PLABAllocator::alloc_buffer(region_type_t dest, uint node_index)
            "Allocation buffer index out of bounds: %u, %u", dest, node_index);
     return _alloc_buffers[dest][node_index];
   } else {
-    return _alloc_buffers[dest][0];
+    return _alloc_buffers[dest][_allocator->old_alloc_region_index(node_index)];
   }
 }
 
@@ -111,7 +111,7 @@ inline uint G1PLABAllocator::alloc_buffers_length(region_type_t dest) const {
   if (dest == G1HeapRegionAttr::Young) {
     return _allocator->num_nodes();
   } else {
-    return 1;
+    return _allocator->num_old_alloc_regions();
   }
 }
 
@@ -101,6 +101,7 @@
 #include "oops/compressedOops.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/crac.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/init.hpp"
 #include "runtime/java.hpp"
@@ -1145,6 +1146,16 @@ bool G1CollectedHeap::upgrade_to_full_collection() {
   return success;
 }
 
+class G1CleanupFreeRegionClosure : public HeapRegionClosure {
+public:
+  bool do_heap_region(HeapRegion* r) {
+    if (r->is_free()) {
+      os::cleanup_memory((char*)r->bottom(), HeapRegion::GrainBytes);
+    }
+    return false;
+  }
+};
+
 void G1CollectedHeap::resize_heap_if_necessary() {
   assert_at_safepoint_on_vm_thread();
 
@@ -1152,12 +1163,18 @@ void G1CollectedHeap::resize_heap_if_necessary() {
   size_t resize_amount = _heap_sizing_policy->full_collection_resize_amount(should_expand);
 
   if (resize_amount == 0) {
-    return;
+    // Nothing to resize
   } else if (should_expand) {
     expand(resize_amount, _workers);
   } else {
     shrink(resize_amount);
   }
+
+  if (do_cleanup_unused()) {
+    // Free regions retained to honor MinHeapSize still hold garbage pages.
+    G1CleanupFreeRegionClosure cl;
+    heap_region_iterate(&cl);
+  }
 }
 
 HeapWord* G1CollectedHeap::satisfy_failed_allocation_helper(size_t word_size,
@@ -1735,6 +1752,7 @@ jint G1CollectedHeap::initialize() {
   // Create and schedule the periodic gc task on the service thread.
   _periodic_gc_task = new G1PeriodicGCTask("Periodic GC Task");
   _service_thread->register_task(_periodic_gc_task);
+  crac::register_time_jump_func(&G1CollectedHeap::time_jumped);
 
   {
     G1DirtyCardQueueSet& dcqs = G1BarrierSet::dirty_card_queue_set();
@@ -1761,7 +1779,7 @@ jint G1CollectedHeap::initialize() {
   // values in the heap have been properly initialized.
   _g1mm = new G1MonitoringSupport(this);
 
-  _preserved_marks_set.init(ParallelGCThreads);
+  _preserved_marks_set.init(ParallelGCThreads, G1RetainedPreservedMarksSize);
 
   _collection_set.initialize(max_reserved_regions());
 
@@ -1772,6 +1790,18 @@ jint G1CollectedHeap::initialize() {
   return JNI_OK;
 }
 
+void G1CollectedHeap::after_restore() {
+  _numa->request_committed_memory_on_nodes(&_hrm);
+}
+
+void G1CollectedHeap::time_jumped(jlong jump_nanos) {
+  G1CollectedHeap* g1h = heap();
+  // The checkpoint starts with a full collection, so the restored VM has
+  // just collected, rather than a whole downtime ago.
+  g1h->_collection_pause_end = Ticks::now();
+  g1h->_service_thread->time_jumped(jump_nanos);
+}
+
 void G1CollectedHeap::stop() {
   // Stop all concurrent threads. We do this to make sure these threads
   // do not continue to execute and access resources (e.g. logging)
@@ -2195,6 +2225,12 @@ bool G1CollectedHeap::try_collect_concurrently(GCCause::Cause cause,
   }
 }
 
+void G1CollectedHeap::uncommit_unused_memory() {
+  // The Remark or Full GC of a periodic collection shrinks the heap as far
+  // as MaxHeapFreeRatio allows and uncommits the free regions.
+  try_collect(GCCause::_g1_periodic_collection);
+}
+
 bool G1CollectedHeap::try_collect(GCCause::Cause cause) {
   assert_heap_not_locked();
 
@@ -2361,6 +2397,19 @@ bool G1CollectedHeap::supports_concurrent_gc_breakpoints() const {
   return true;
 }
 
+bool G1CollectedHeap::can_pin_object(oop obj) const {
+  return heap_region_containing(obj)->is_pinned();
+}
+
+oop G1CollectedHeap::pin_object(JavaThread* thread, oop obj) {
+  assert(can_pin_object(obj), "only objects that never move");
+  return obj;
+}
+
+void G1CollectedHeap::unpin_object(JavaThread* thread, oop obj) {
+  assert(can_pin_object(obj), "only objects that never move");
+}
+
 bool G1CollectedHeap::is_archived_object(oop object) const {
   return object != NULL && heap_region_containing(object)->is_archive();
 }
@@ -3428,10 +3477,14 @@ class G1PrepareEvacuationTask : public AbstractGangTask {
       // structures don't support efficiently performing the needed
       // additional tests or scrubbing of the mark stack.
       //
-      // However, we presently only nominate is_typeArray() objects.
       // A humongous object containing references induces remembered
-      // set entries on other regions.  In order to reclaim such an
-      // object, those remembered sets would need to be cleaned up.
+      // set entries on other regions.  Those entries become stale once
+      // the object is reclaimed, just like the entries of evacuated old
+      // regions: the region is scanned only after it has been reused
+      // and is parsable again.  With G1EagerReclaimHumongousObjArrays
+      // we therefore also nominate is_objArray() objects, but only if
+      // no concurrent marking or remembered set rebuild is in
+      // progress, so that the SATB constraints above trivially hold.
       //
       // We also treat is_typeArray() objects specially, allowing them
       // to be reclaimed even if allocated before the start of
@@ -3443,7 +3496,12 @@ class G1PrepareEvacuationTask : public AbstractGangTask {
       // important use case for eager reclaim, and this special handling
       // may reduce needed headroom.
 
-      return obj->is_typeArray() &&
+      if (obj->is_typeArray()) {
+        return _g1h->is_potential_eager_reclaim_candidate(region);
+      }
+      return G1EagerReclaimHumongousObjArrays &&
+             obj->is_objArray() &&
+             !_g1h->collector_state()->mark_or_rebuild_in_progress() &&
              _g1h->is_potential_eager_reclaim_candidate(region);
     }
 
@@ -291,6 +291,12 @@ private:
     G1UncommitRegionTask::finish_collection();
   }
 
+  virtual void uncommit_unused_memory() override;
+
+  virtual void after_restore() override;
+  // Registered with crac, called at the safepoint of the checkpoint.
+  static void time_jumped(jlong jump_nanos);
+
   // indicates whether we are in young or mixed GC mode
   G1CollectorState _collector_state;
 
@@ -1443,6 +1449,12 @@ public:
   // WhiteBox testing support.
   virtual bool supports_concurrent_gc_breakpoints() const;
 
+  // Objects in humongous and archive regions are never moved, so JNI
+  // critical sections on them need not lock out GCs.
+  virtual bool can_pin_object(oop obj) const;
+  virtual oop pin_object(JavaThread* thread, oop obj);
+  virtual void unpin_object(JavaThread* thread, oop obj);
+
   virtual WorkGang* safepoint_workers() { return _workers; }
 
   virtual bool is_archived_object(oop object) const;
@@ -35,6 +35,7 @@
 #include "gc/g1/g1RemSet.hpp"
 #include "gc/g1/g1ThreadLocalData.hpp"
 #include "gc/g1/heapRegionRemSet.hpp"
+#include "gc/shared/gc_globals.hpp"
 #include "gc/shared/suspendibleThreadSet.hpp"
 #include "memory/iterator.hpp"
 #include "runtime/atomic.hpp"
@@ -420,13 +421,16 @@ class G1RefineBufferedCards : public StackObj {
   bool refine_cleaned_cards(size_t start_index) {
     bool result = true;
     size_t i = start_index;
+    // Flushed when going out of scope, before the caller yields.
+    G1RefineReferenceBatch batch(_worker_id);
+    G1RefineReferenceBatch* batch_or_null = G1BatchRefinementByRegion ? &batch : NULL;
     for ( ; i < _node_buffer_size; ++i) {
       if (SuspendibleThreadSet::should_yield()) {
         redirty_unrefined_cards(i);
         result = false;
         break;
       }
-      _g1rs->refine_card_concurrently(_node_buffer[i], _worker_id);
+      _g1rs->refine_card_concurrently(_node_buffer[i], _worker_id, batch_or_null);
     }
     _node->set_index(i);
     _stats->inc_refined_cards(i - start_index);
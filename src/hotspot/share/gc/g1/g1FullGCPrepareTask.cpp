@@ -37,6 +37,7 @@
 #include "logging/log.hpp"
 #include "memory/iterator.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "utilities/ticks.hpp"
 
 template<bool is_humongous>
@@ -74,10 +75,11 @@ bool G1FullGCPrepareTask::G1CalculatePointersClosure::do_heap_region(HeapRegion*
     } else if (hr->is_closed_archive()) {
       // nothing to do with closed archive region
     } else {
-      assert(MarkSweepDeadRatio > 0,
-             "only skip compaction for other regions when MarkSweepDeadRatio > 0");
+      assert(MarkSweepDeadRatio > 0 || G1FullGCMaxCompactionPercent < 100,
+             "only skip compaction for other regions when MarkSweepDeadRatio > 0 "
+             "or the compaction budget is limited");
 
-      // Too many live objects; skip compacting it.
+      // Too many live objects, or out of compaction budget; skip compacting it.
       _collector->update_from_compacting_to_skip_compacting(hr->hrm_index());
       if (hr->is_young()) {
         // G1 updates the BOT for old region contents incrementally, but young regions
@@ -100,7 +102,31 @@ bool G1FullGCPrepareTask::G1CalculatePointersClosure::do_heap_region(HeapRegion*
 G1FullGCPrepareTask::G1FullGCPrepareTask(G1FullCollector* collector) :
     G1FullGCTask("G1 Prepare Compact Task", collector),
     _freed_regions(false),
-    _hrclaimer(collector->workers()) {
+    _hrclaimer(collector->workers()),
+    _compaction_budget(initial_compaction_budget(collector)) {
+}
+
+size_t G1FullGCPrepareTask::initial_compaction_budget(G1FullCollector* collector) {
+  if (G1FullGCMaxCompactionPercent == 100 || collector->scope()->do_maximal_compaction()) {
+    return SIZE_MAX;
+  }
+  size_t capacity_words = G1CollectedHeap::heap()->capacity() / HeapWordSize;
+  return capacity_words / 100 * G1FullGCMaxCompactionPercent;
+}
+
+bool G1FullGCPrepareTask::claim_compaction_budget(size_t live_words) {
+  size_t budget = Atomic::load(&_compaction_budget);
+  if (budget == SIZE_MAX) {
+    return true;
+  }
+  while (budget >= live_words) {
+    size_t prev = Atomic::cmpxchg(&_compaction_budget, budget, budget - live_words);
+    if (prev == budget) {
+      return true;
+    }
+    budget = prev;
+  }
+  return false;
 }
 
 void G1FullGCPrepareTask::set_freed_regions() {
@@ -116,7 +142,7 @@ bool G1FullGCPrepareTask::has_freed_regions() {
 void G1FullGCPrepareTask::work(uint worker_id) {
   Ticks start = Ticks::now();
   G1FullGCCompactionPoint* compaction_point = collector()->compaction_point(worker_id);
-  G1CalculatePointersClosure closure(collector(), compaction_point);
+  G1CalculatePointersClosure closure(collector(), compaction_point, this);
   G1CollectedHeap::heap()->heap_region_par_iterate_from_start(&closure, &_hrclaimer);
 
   compaction_point->update();
@@ -129,11 +155,13 @@ void G1FullGCPrepareTask::work(uint worker_id) {
 }
 
 G1FullGCPrepareTask::G1CalculatePointersClosure::G1CalculatePointersClosure(G1FullCollector* collector,
-                                                                            G1FullGCCompactionPoint* cp) :
+                                                                            G1FullGCCompactionPoint* cp,
+                                                                            G1FullGCPrepareTask* task) :
     _g1h(G1CollectedHeap::heap()),
     _collector(collector),
     _bitmap(collector->mark_bitmap()),
     _cp(cp),
+    _task(task),
     _regions_freed(false) { }
 
 bool G1FullGCPrepareTask::G1CalculatePointersClosure::should_compact(HeapRegion* hr) {
@@ -143,7 +171,12 @@ bool G1FullGCPrepareTask::G1CalculatePointersClosure::should_compact(HeapRegion*
   size_t live_words = _collector->live_words(hr->hrm_index());
   size_t live_words_threshold = _collector->scope()->region_compaction_threshold();
   // High live ratio region will not be compacted.
-  return live_words <= live_words_threshold;
+  if (live_words > live_words_threshold) {
+    return false;
+  }
+  // Regions without live objects are freed at no cost. Others are compacted
+  // while the budget lasts; the rest are left to later mixed collections.
+  return live_words == 0 || _task->claim_compaction_budget(live_words);
 }
 
 void G1FullGCPrepareTask::G1CalculatePointersClosure::reset_region_metadata(HeapRegion* hr) {
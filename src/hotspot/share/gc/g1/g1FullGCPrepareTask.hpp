@@ -39,15 +39,23 @@ class G1FullGCPrepareTask : public G1FullGCTask {
 protected:
   volatile bool     _freed_regions;
   HeapRegionClaimer _hrclaimer;
+  // Live words that may still be moved, see G1FullGCMaxCompactionPercent.
+  volatile size_t   _compaction_budget;
 
   void set_freed_regions();
 
+  static size_t initial_compaction_budget(G1FullCollector* collector);
+
 public:
   G1FullGCPrepareTask(G1FullCollector* collector);
   void work(uint worker_id);
   void prepare_serial_compaction();
   bool has_freed_regions();
 
+  // Returns whether moving the given number of live words is within the budget,
+  // and if so takes them from it.
+  bool claim_compaction_budget(size_t live_words);
+
 protected:
   class G1CalculatePointersClosure : public HeapRegionClosure {
   private:
@@ -58,6 +66,7 @@ protected:
     G1FullCollector* _collector;
     G1CMBitMap* _bitmap;
     G1FullGCCompactionPoint* _cp;
+    G1FullGCPrepareTask* _task;
     bool _regions_freed;
 
     bool should_compact(HeapRegion* hr);
@@ -68,7 +77,8 @@ protected:
 
   public:
     G1CalculatePointersClosure(G1FullCollector* collector,
-                               G1FullGCCompactionPoint* cp);
+                               G1FullGCCompactionPoint* cp,
+                               G1FullGCPrepareTask* task);
 
     bool do_heap_region(HeapRegion* hr);
     bool freed_regions();
@@ -57,6 +57,7 @@ class G1FullGCScope : public StackObj {
   ClearedAllSoftRefs      _soft_refs;
   G1MonitoringScope       _monitoring_scope;
   G1HeapPrinterMark       _heap_printer;
+  bool                    _do_maximal_compaction;
   size_t                  _region_compaction_threshold;
 
 public:
@@ -74,6 +75,7 @@ public:
   G1FullGCTracer* tracer();
   G1HeapTransition* heap_transition();
   size_t region_compaction_threshold();
+  bool do_maximal_compaction() const { return _do_maximal_compaction; }
 };
 
 #endif // SHARE_GC_G1_G1FULLGCSCOPE_HPP
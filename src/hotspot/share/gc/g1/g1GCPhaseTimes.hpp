@@ -125,7 +125,8 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   enum GCMergePSSWorkItems {
     MergePSSCopiedBytes,
     MergePSSLABWasteBytes,
-    MergePSSLABUndoWasteBytes
+    MergePSSLABUndoWasteBytes,
+    MergePSSLABRefills
   };
 
   enum GCEagerlyReclaimHumongousObjectsItems {
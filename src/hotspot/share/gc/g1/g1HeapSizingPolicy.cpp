@@ -237,6 +237,21 @@ size_t G1HeapSizingPolicy::full_collection_resize_amount(bool& expand) {
   // we'll try to make the capacity smaller than it, not greater).
   maximum_desired_capacity =  MAX2(maximum_desired_capacity, MinHeapSize);
 
+  if (_g1h->do_cleanup_unused()) {
+    // Checkpoint is about to be taken: keep only as much as is live, but
+    // never go below the minimum heap size.
+    const size_t target_capacity = MAX2(align_up(used_after_gc, HeapRegion::GrainBytes), MinHeapSize);
+    if (capacity_after_gc > target_capacity) {
+      log_debug(gc, ergo, heap)("Attempt heap shrinking (cleanup unused). "
+                                "Capacity: " SIZE_FORMAT "B occupancy: " SIZE_FORMAT "B target: " SIZE_FORMAT "B",
+                                capacity_after_gc, used_after_gc, target_capacity);
+      expand = false;
+      return capacity_after_gc - target_capacity;
+    }
+    expand = true; // Does not matter.
+    return 0;
+  }
+
   // Don't expand unless it's significant; prefer expansion to shrinking.
   if (capacity_after_gc < minimum_desired_capacity) {
     size_t expand_bytes = minimum_desired_capacity - capacity_after_gc;
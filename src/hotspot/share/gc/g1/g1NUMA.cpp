@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc/g1/g1NUMA.hpp"
+#include "gc/g1/heapRegionManager.inline.hpp"
 #include "logging/logStream.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/os.hpp"
@@ -222,6 +223,26 @@ void G1NUMA::request_memory_on_node(void* aligned_address, size_t size_in_bytes,
   os::numa_make_local((char*)aligned_address, size_in_bytes, _node_ids[node_index]);
 }
 
+void G1NUMA::request_committed_memory_on_nodes(const HeapRegionManager* hrm) {
+  if (!is_enabled()) {
+    return;
+  }
+
+  // Memory is requested per page, see request_memory_on_node.
+  const size_t step = MAX2(page_size(), region_size());
+  const uint regions_per_step = (uint)(step / region_size());
+  char* const bottom = (char*)hrm->reserved().start();
+
+  for (uint i = 0; i < hrm->reserved_length(); i += regions_per_step) {
+    for (uint j = i; j < MIN2(i + regions_per_step, hrm->reserved_length()); j++) {
+      if (hrm->is_available(j)) {
+        request_memory_on_node(bottom + (size_t)i * region_size(), step, i);
+        break;
+      }
+    }
+  }
+}
+
 uint G1NUMA::max_search_depth() const {
   // Multiple of 3 is just random number to limit iterations.
   // There would be some cases that 1 page may be consisted of multiple HeapRegions.
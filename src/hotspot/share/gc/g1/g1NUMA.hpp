@@ -30,6 +30,7 @@
 #include "memory/allocation.hpp"
 #include "runtime/os.hpp"
 
+class HeapRegionManager;
 class LogStream;
 
 class G1NUMA: public CHeapObj<mtGC> {
@@ -112,6 +113,11 @@ public:
   // Requests the given memory area to be located at the given node index.
   void request_memory_on_node(void* aligned_address, size_t size_in_bytes, uint region_index);
 
+  // Requests the committed memory of the heap to be located at the preferred
+  // nodes of its regions again. The memory policy set when the regions were
+  // committed is lost when the process is restored from a checkpoint.
+  void request_committed_memory_on_nodes(const HeapRegionManager* hrm);
+
   // Returns maximum search depth which is used to limit heap region search iterations.
   // The number of active nodes, page size and heap region size are considered.
   uint max_search_depth() const;
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc/g1/g1NUMAStats.hpp"
+#include "gc/shared/gc_globals.hpp"
 #include "logging/logStream.hpp"
 
 double G1NUMAStats::Stat::rate() const {
@@ -157,6 +158,8 @@ static const char* phase_to_explanatory_string(G1NUMAStats::NodeDataItems phase)
       return "Placement match ratio";
     case G1NUMAStats::LocalObjProcessAtCopyToSurv:
       return "Worker task locality match ratio";
+    case G1NUMAStats::LocalObjProcessAtCopyToOld:
+      return "Worker task locality match ratio (old)";
     default:
       return "";
   }
@@ -227,4 +230,7 @@ void G1NUMAStats::print_statistics() {
   print_mutator_alloc_stat_debug();
 
   print_info(LocalObjProcessAtCopyToSurv);
+  if (G1NUMAOldGenEvacuation) {
+    print_info(LocalObjProcessAtCopyToOld);
+  }
 }
@@ -31,6 +31,7 @@
 
 class HeapRegion;
 class G1CollectedHeap;
+class G1RefineReferenceBatch;
 class G1RemSet;
 class G1ConcurrentMark;
 class DirtyCardToOopClosure;
@@ -204,11 +205,13 @@ public:
 class G1ConcurrentRefineOopClosure: public BasicOopIterateClosure {
   G1CollectedHeap* _g1h;
   uint _worker_id;
+  G1RefineReferenceBatch* _batch;
 
 public:
-  G1ConcurrentRefineOopClosure(G1CollectedHeap* g1h, uint worker_id) :
+  G1ConcurrentRefineOopClosure(G1CollectedHeap* g1h, uint worker_id, G1RefineReferenceBatch* batch = NULL) :
     _g1h(g1h),
-    _worker_id(worker_id) {
+    _worker_id(worker_id),
+    _batch(batch) {
   }
 
   virtual ReferenceIterationMode reference_iteration_mode() { return DO_FIELDS; }
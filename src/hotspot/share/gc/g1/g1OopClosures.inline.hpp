@@ -157,7 +157,11 @@ inline void G1ConcurrentRefineOopClosure::do_oop_work(T* p) {
 
   assert(to_rem_set != NULL, "Need per-region 'into' remsets.");
   if (to_rem_set->is_tracked()) {
-    to_rem_set->add_reference(p, _worker_id);
+    if (_batch != NULL) {
+      _batch->add(to_rem_set, (OopOrNarrowOopStar)p);
+    } else {
+      to_rem_set->add_reference(p, _worker_id);
+    }
   }
 }
 
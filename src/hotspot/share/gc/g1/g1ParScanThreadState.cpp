@@ -31,6 +31,7 @@
 #include "gc/g1/g1RootClosures.hpp"
 #include "gc/g1/g1StringDedup.hpp"
 #include "gc/g1/g1Trace.hpp"
+#include "gc/shared/gc_globals.hpp"
 #include "gc/shared/partialArrayTaskStepper.inline.hpp"
 #include "gc/shared/stringdedup/stringDedup.hpp"
 #include "gc/shared/taskqueue.inline.hpp"
@@ -79,7 +80,8 @@ G1ParScanThreadState::G1ParScanThreadState(G1CollectedHeap* g1h,
     _string_dedup_requests(),
     _num_optional_regions(optional_cset_length),
     _numa(g1h->numa()),
-    _obj_alloc_stat(NULL)
+    _obj_alloc_stat(NULL),
+    _old_obj_alloc_stat(NULL)
 {
   // We allocate number of young gen regions in the collection set plus one
   // entries, since entry 0 keeps track of surviving bytes for non-young regions.
@@ -127,6 +129,7 @@ G1ParScanThreadState::~G1ParScanThreadState() {
   FREE_C_HEAP_ARRAY(size_t, _surviving_young_words_base);
   delete[] _oops_into_optional_regions;
   FREE_C_HEAP_ARRAY(size_t, _obj_alloc_stat);
+  FREE_C_HEAP_ARRAY(size_t, _old_obj_alloc_stat);
 }
 
 size_t G1ParScanThreadState::lab_waste_words() const {
@@ -137,6 +140,10 @@ size_t G1ParScanThreadState::lab_undo_waste_words() const {
   return _plab_allocator->undo_waste();
 }
 
+size_t G1ParScanThreadState::lab_refills() const {
+  return _plab_allocator->num_plab_fills();
+}
+
 #ifdef ASSERT
 void G1ParScanThreadState::verify_task(narrowOop* task) const {
   assert(task != NULL, "invariant");
@@ -395,7 +402,7 @@ HeapWord* G1ParScanThreadState::allocate_copy_slow(G1HeapRegionAttr* dest_attr,
     }
   }
   if (obj_ptr != NULL) {
-    update_numa_stats(node_index);
+    update_numa_stats(*dest_attr, node_index);
     if (_g1h->_gc_tracer_stw->should_report_promotion_events()) {
       // The events are checked individually as part of the actual commit
       report_promotion_event(*dest_attr, old, word_sz, age, obj_ptr, node_index);
@@ -564,11 +571,13 @@ void G1ParScanThreadStateSet::flush() {
     // because it resets the PLAB allocator where we get this info from.
     size_t lab_waste_bytes = pss->lab_waste_words() * HeapWordSize;
     size_t lab_undo_waste_bytes = pss->lab_undo_waste_words() * HeapWordSize;
+    size_t lab_refills = pss->lab_refills();
     size_t copied_bytes = pss->flush(_surviving_young_words_total) * HeapWordSize;
 
     p->record_or_add_thread_work_item(G1GCPhaseTimes::MergePSS, worker_id, copied_bytes, G1GCPhaseTimes::MergePSSCopiedBytes);
     p->record_or_add_thread_work_item(G1GCPhaseTimes::MergePSS, worker_id, lab_waste_bytes, G1GCPhaseTimes::MergePSSLABWasteBytes);
     p->record_or_add_thread_work_item(G1GCPhaseTimes::MergePSS, worker_id, lab_undo_waste_bytes, G1GCPhaseTimes::MergePSSLABUndoWasteBytes);
+    p->record_or_add_thread_work_item(G1GCPhaseTimes::MergePSS, worker_id, lab_refills, G1GCPhaseTimes::MergePSSLABRefills);
 
     delete pss;
     _states[worker_id] = NULL;
@@ -629,6 +638,10 @@ void G1ParScanThreadState::initialize_numa_stats() {
       // Record only if there are multiple active nodes.
       _obj_alloc_stat = NEW_C_HEAP_ARRAY(size_t, num_nodes, mtGC);
       memset(_obj_alloc_stat, 0, sizeof(size_t) * num_nodes);
+      if (G1NUMAOldGenEvacuation) {
+        _old_obj_alloc_stat = NEW_C_HEAP_ARRAY(size_t, num_nodes, mtGC);
+        memset(_old_obj_alloc_stat, 0, sizeof(size_t) * num_nodes);
+      }
     }
   }
 }
@@ -637,12 +650,19 @@ void G1ParScanThreadState::flush_numa_stats() {
   if (_obj_alloc_stat != NULL) {
     uint node_index = _numa->index_of_current_thread();
     _numa->copy_statistics(G1NUMAStats::LocalObjProcessAtCopyToSurv, node_index, _obj_alloc_stat);
+    if (_old_obj_alloc_stat != NULL) {
+      _numa->copy_statistics(G1NUMAStats::LocalObjProcessAtCopyToOld, node_index, _old_obj_alloc_stat);
+    }
   }
 }
 
-void G1ParScanThreadState::update_numa_stats(uint node_index) {
-  if (_obj_alloc_stat != NULL) {
-    _obj_alloc_stat[node_index]++;
+void G1ParScanThreadState::update_numa_stats(G1HeapRegionAttr dest_attr, uint node_index) {
+  if (!dest_attr.is_old()) {
+    if (_obj_alloc_stat != NULL) {
+      _obj_alloc_stat[node_index]++;
+    }
+  } else if (_old_obj_alloc_stat != NULL) {
+    _old_obj_alloc_stat[node_index]++;
   }
 }
 
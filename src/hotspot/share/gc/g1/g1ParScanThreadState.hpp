@@ -105,6 +105,8 @@ class G1ParScanThreadState : public CHeapObj<mtGC> {
   // Only starts recording when log of gc+heap+numa is enabled and its data is
   // transferred when flushed.
   size_t* _obj_alloc_stat;
+  // The same for copies to old, when those are NUMA-aware.
+  size_t* _old_obj_alloc_stat;
 
 public:
   G1ParScanThreadState(G1CollectedHeap* g1h,
@@ -162,6 +164,7 @@ public:
 
   size_t lab_waste_words() const;
   size_t lab_undo_waste_words() const;
+  size_t lab_refills() const;
 
   // Pass locally gathered statistics to global state. Returns the total number of
   // HeapWords copied.
@@ -215,7 +218,7 @@ private:
   // NUMA statistics related methods.
   void initialize_numa_stats();
   void flush_numa_stats();
-  inline void update_numa_stats(uint node_index);
+  inline void update_numa_stats(G1HeapRegionAttr dest_attr, uint node_index);
 
 public:
   oop copy_to_survivor_space(G1HeapRegionAttr region_attr, oop obj, markWord old_mark);
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/g1/g1CollectedHeap.hpp"
+#include "gc/g1/g1RegionStatsDCmd.hpp"
+#include "gc/g1/heapRegion.inline.hpp"
+#include "gc/g1/heapRegionRemSet.hpp"
+#include "gc/shared/gc_globals.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/markWord.hpp"
+#include "runtime/vmOperation.hpp"
+#include "runtime/vmThread.hpp"
+#include "utilities/ostream.hpp"
+
+// Walks the regions and writes the JSON document. utilities/json.hpp only
+// parses, so the output is assembled by hand; all values are numbers or
+// fixed identifiers and need no escaping.
+class G1RegionStatsClosure : public HeapRegionClosure {
+  static const uint NumOccupancyBuckets = 10;
+  static const uint NumAgeBuckets = markWord::max_age + 1;
+
+  outputStream* const _out;
+  const bool _all;
+  bool _first;
+
+  uint _num_regions;
+  uint _num_free;
+  size_t _used;
+  size_t _live;
+  size_t _remset_mem_size;
+  size_t _code_roots_mem_size;
+  uint _occupancy[NumOccupancyBuckets];
+  uint _age[NumAgeBuckets];
+
+  static void print_histogram(outputStream* out, const char* name, const uint* buckets, uint n) {
+    out->print("\"%s\":[", name);
+    for (uint i = 0; i < n; i++) {
+      out->print("%s%u", i == 0 ? "" : ",", buckets[i]);
+    }
+    out->print("]");
+  }
+
+public:
+  G1RegionStatsClosure(outputStream* out, bool all) :
+    _out(out), _all(all), _first(true),
+    _num_regions(0), _num_free(0), _used(0), _live(0),
+    _remset_mem_size(0), _code_roots_mem_size(0) {
+    memset(_occupancy, 0, sizeof(_occupancy));
+    memset(_age, 0, sizeof(_age));
+  }
+
+  bool do_heap_region(HeapRegion* r) {
+    _num_regions++;
+    uint bucket = (uint)(r->used() * NumOccupancyBuckets / HeapRegion::GrainBytes);
+    _occupancy[MIN2(bucket, NumOccupancyBuckets - 1)]++;
+
+    if (r->is_free()) {
+      _num_free++;
+      if (!_all) {
+        return false;
+      }
+    }
+
+    HeapRegionRemSet* rem_set = r->rem_set();
+    // HeapRegionRemSet::mem_size() includes the code root set, which is
+    // reported separately.
+    size_t code_roots_mem_size = rem_set->strong_code_roots_mem_size();
+    size_t remset_mem_size = rem_set->mem_size() - code_roots_mem_size;
+    _used += r->used();
+    _live += r->live_bytes();
+    _remset_mem_size += remset_mem_size;
+    _code_roots_mem_size += code_roots_mem_size;
+
+    _out->print("%s{\"index\":%u,\"type\":\"%s\",\"bottom\":\"" PTR_FORMAT "\","
+                "\"used\":" SIZE_FORMAT ",\"live\":" SIZE_FORMAT ",\"garbage\":" SIZE_FORMAT ","
+                "\"remset\":{\"state\":\"%s\",\"cards\":" SIZE_FORMAT ",\"mem_size\":" SIZE_FORMAT ","
+                "\"sparse\":" SIZE_FORMAT ",\"fine\":" SIZE_FORMAT ",\"coarse\":" SIZE_FORMAT "},"
+                "\"code_roots\":{\"count\":" SIZE_FORMAT ",\"mem_size\":" SIZE_FORMAT "}",
+                _first ? "" : ",\n",
+                r->hrm_index(), r->get_short_type_str(), p2i(r->bottom()),
+                r->used(), r->live_bytes(), r->garbage_bytes(),
+                rem_set->get_state_str(), rem_set->occupied(), remset_mem_size,
+                rem_set->num_sparse_regions(), rem_set->num_fine_regions(), rem_set->num_coarse_regions(),
+                rem_set->strong_code_roots_list_length(), code_roots_mem_size);
+    if (r->has_surv_rate_group() && r->has_valid_age_in_surv_rate()) {
+      int age = r->age_in_surv_rate_group();
+      _age[MIN2((uint)age, NumAgeBuckets - 1)]++;
+      _out->print(",\"age\":%d", age);
+    }
+    _out->print("}");
+    _first = false;
+    return false;
+  }
+
+  void print_totals() {
+    _out->print_cr("%s],", _first ? "" : "\n");
+    _out->print("\"totals\":{\"regions\":%u,\"free\":%u,\"used\":" SIZE_FORMAT ",\"live\":" SIZE_FORMAT ","
+                "\"remset_mem_size\":" SIZE_FORMAT ",\"code_roots_mem_size\":" SIZE_FORMAT ",",
+                _num_regions, _num_free, _used, _live, _remset_mem_size, _code_roots_mem_size);
+    print_histogram(_out, "occupancy_histogram", _occupancy, NumOccupancyBuckets);
+    _out->print(",");
+    print_histogram(_out, "age_histogram", _age, NumAgeBuckets);
+    _out->print_cr("}");
+  }
+};
+
+class VM_G1PrintRegionStats : public VM_Operation {
+  outputStream* const _out;
+  const bool          _all;
+
+public:
+  VM_G1PrintRegionStats(outputStream* out, bool all) : _out(out), _all(all) { }
+  VMOp_Type type() const { return VMOp_G1PrintRegionStats; }
+
+  void doit() {
+    G1CollectedHeap* g1h = G1CollectedHeap::heap();
+    _out->print_cr("{\"region_size\":" SIZE_FORMAT ",\"regions\":[", HeapRegion::GrainBytes);
+    G1RegionStatsClosure cl(_out, _all);
+    g1h->heap_region_iterate(&cl);
+    cl.print_totals();
+    _out->print_cr("}");
+  }
+};
+
+G1RegionStatsDCmd::G1RegionStatsDCmd(outputStream* output, bool heap) :
+  DCmdWithParser(output, heap),
+  _all("all", "Also list free regions.", "BOOLEAN", false, "false")
+{
+  _dcmdparser.add_dcmd_option(&_all);
+}
+
+int G1RegionStatsDCmd::num_arguments() {
+  ResourceMark rm;
+  G1RegionStatsDCmd* dcmd = new G1RegionStatsDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
+void G1RegionStatsDCmd::execute(DCmdSource source, TRAPS) {
+  if (!UseG1GC) {
+    output()->print_cr("G1 GC is not enabled");
+    return;
+  }
+  VM_G1PrintRegionStats op(output(), _all.value());
+  VMThread::execute(&op);
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_G1_G1REGIONSTATSDCMD_HPP
+#define SHARE_GC_G1_G1REGIONSTATSDCMD_HPP
+
+#include "services/diagnosticCommand.hpp"
+
+class outputStream;
+
+// Prints a JSON document describing every committed G1 heap region: its
+// type, occupancy, liveness as of the last marking, remembered set and
+// code root footprint, and the age of young regions, followed by heap-wide
+// occupancy and age histograms.
+class G1RegionStatsDCmd : public DCmdWithParser {
+  DCmdArgument<bool> _all;
+public:
+  G1RegionStatsDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "GC.g1_region_stats";
+  }
+  static const char* description() {
+    return "Print per-region occupancy and remembered set statistics of the G1 heap as JSON.";
+  }
+  static const char* impact() {
+    return "Medium: Requires a safepoint, depends on the number of heap regions.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+#endif // SHARE_GC_G1_G1REGIONSTATSDCMD_HPP
@@ -59,6 +59,7 @@
 #include "utilities/align.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/powerOfTwo.hpp"
+#include "utilities/quickSort.hpp"
 #include "utilities/stack.inline.hpp"
 #include "utilities/ticks.hpp"
 #include CPU_HEADER(gc/g1/g1Globals)
@@ -661,6 +662,36 @@ private:
     return value == G1CardTable::WordAllDirty;
   }
 
+  // Large areas of the card table are usually all clean or all dirty, so skip
+  // them a block of words at a time. The block is combined without branches,
+  // which the compiler turns into vector loads and operations.
+  static const size_t WordsPerBlock = 4;
+  static const size_t CardsPerBlock = WordsPerBlock * sizeof(size_t);
+
+  bool cur_block_available() const {
+    return pointer_delta(_end_addr, _cur_addr, sizeof(CardValue)) >= CardsPerBlock;
+  }
+
+  bool cur_block_of_cards_contains_any_dirty_card() const {
+    assert(cur_addr_aligned(), "Current address should be aligned");
+    const size_t* words = (const size_t*)_cur_addr;
+    size_t value = words[0];
+    for (size_t i = 1; i < WordsPerBlock; i++) {
+      value &= words[i];
+    }
+    return (~value & ExpandedToScanMask) != 0;
+  }
+
+  bool cur_block_of_cards_all_dirty_cards() const {
+    assert(cur_addr_aligned(), "Current address should be aligned");
+    const size_t* words = (const size_t*)_cur_addr;
+    size_t value = words[0];
+    for (size_t i = 1; i < WordsPerBlock; i++) {
+      value |= words[i];
+    }
+    return value == G1CardTable::WordAllDirty;
+  }
+
   size_t get_and_advance_pos() {
     _cur_addr++;
     return pointer_delta(_cur_addr, _base_addr, sizeof(CardValue)) - 1;
@@ -686,6 +717,10 @@ public:
 
     assert(cur_addr_aligned(), "Current address should be aligned now.");
     while (_cur_addr != _end_addr) {
+      if (cur_block_available() && !cur_block_of_cards_contains_any_dirty_card()) {
+        _cur_addr += CardsPerBlock;
+        continue;
+      }
       if (cur_word_of_cards_contains_any_dirty_card()) {
         for (size_t i = 0; i < sizeof(size_t); i++) {
           if (cur_card_is_dirty()) {
@@ -712,6 +747,10 @@ public:
 
     assert(cur_addr_aligned(), "Current address should be aligned now.");
     while (_cur_addr != _end_addr) {
+      if (cur_block_available() && cur_block_of_cards_all_dirty_cards()) {
+        _cur_addr += CardsPerBlock;
+        continue;
+      }
       if (!cur_word_of_cards_all_dirty_cards()) {
         for (size_t i = 0; i < sizeof(size_t); i++) {
           if (!cur_card_is_dirty()) {
@@ -1667,7 +1706,8 @@ bool G1RemSet::clean_card_before_refine(CardValue** const card_ptr_addr) {
 }
 
 void G1RemSet::refine_card_concurrently(CardValue* const card_ptr,
-                                        const uint worker_id) {
+                                        const uint worker_id,
+                                        G1RefineReferenceBatch* batch) {
   assert(!_g1h->is_gc_active(), "Only call concurrently");
   check_card_ptr(card_ptr, _ct);
 
@@ -1690,7 +1730,7 @@ void G1RemSet::refine_card_concurrently(CardValue* const card_ptr,
   MemRegion dirty_region(start, MIN2(scan_limit, end));
   assert(!dirty_region.is_empty(), "sanity");
 
-  G1ConcurrentRefineOopClosure conc_refine_cl(_g1h, worker_id);
+  G1ConcurrentRefineOopClosure conc_refine_cl(_g1h, worker_id, batch);
   if (r->oops_on_memregion_seq_iterate_careful<false>(dirty_region, &conc_refine_cl) != NULL) {
     return;
   }
@@ -1716,6 +1756,26 @@ void G1RemSet::refine_card_concurrently(CardValue* const card_ptr,
   G1BarrierSet::shared_dirty_card_queue().enqueue(card_ptr);
 }
 
+int G1RefineReferenceBatch::compare_entries(const Entry& e1, const Entry& e2) {
+  if (e1._rem_set != e2._rem_set) {
+    return e1._rem_set < e2._rem_set ? -1 : 1;
+  }
+  if (e1._from != e2._from) {
+    return e1._from < e2._from ? -1 : 1;
+  }
+  return 0;
+}
+
+void G1RefineReferenceBatch::flush() {
+  // Within a remembered set, references in address order let the from card
+  // cache filter repeated references from the same card.
+  QuickSort::sort(_entries, _length, compare_entries, false);
+  for (uint i = 0; i < _length; i++) {
+    _entries[i]._rem_set->add_reference(_entries[i]._from, _worker_id);
+  }
+  _length = 0;
+}
+
 void G1RemSet::print_periodic_summary_info(const char* header, uint period_count) {
   if ((G1SummarizeRSetStatsPeriod > 0) && log_is_enabled(Trace, gc, remset) &&
       (period_count % G1SummarizeRSetStatsPeriod == 0)) {
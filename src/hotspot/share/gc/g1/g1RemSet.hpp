@@ -52,6 +52,7 @@ class G1RemSetSamplingTask;
 class G1ScanCardClosure;
 class G1ServiceThread;
 class HeapRegionClaimer;
+class HeapRegionRemSet;
 
 // A G1RemSet in which each heap region has a rem set that records the
 // external heap references into it.  Uses a mod ref bs to track updates,
@@ -132,9 +133,11 @@ public:
   bool clean_card_before_refine(CardValue** const card_ptr_addr);
   // Refine the region corresponding to "card_ptr". Must be called after
   // being filtered by clean_card_before_refine(), and after proper
-  // fence/synchronization.
+  // fence/synchronization. If "batch" is given, the references found are
+  // added to the remembered sets when the batch is flushed.
   void refine_card_concurrently(CardValue* const card_ptr,
-                                const uint worker_id);
+                                const uint worker_id,
+                                G1RefineReferenceBatch* batch = NULL);
 
   // Print accumulated summary info from the start of the VM.
   void print_summary_info();
@@ -147,4 +150,39 @@ public:
   void rebuild_rem_set(G1ConcurrentMark* cm, WorkGang* workers, uint worker_id_offset);
 };
 
+// References found by concurrent refinement of a buffer of cards. The cards
+// are refined in address order, so consecutive references usually point into
+// unrelated regions. The batch adds them to the remembered sets sorted by
+// the region referenced, so each remembered set is updated once per batch.
+// The batch must be flushed before the refining thread yields.
+class G1RefineReferenceBatch : public StackObj {
+  struct Entry {
+    HeapRegionRemSet* _rem_set;
+    OopOrNarrowOopStar _from;
+  };
+
+  static const uint Capacity = 256;
+
+  Entry _entries[Capacity];
+  uint _length;
+  const uint _worker_id;
+
+  static int compare_entries(const Entry& e1, const Entry& e2);
+
+public:
+  G1RefineReferenceBatch(uint worker_id) : _length(0), _worker_id(worker_id) { }
+  ~G1RefineReferenceBatch() { flush(); }
+
+  void add(HeapRegionRemSet* rem_set, OopOrNarrowOopStar from) {
+    if (_length == Capacity) {
+      flush();
+    }
+    _entries[_length]._rem_set = rem_set;
+    _entries[_length]._from = from;
+    _length++;
+  }
+
+  void flush();
+};
+
 #endif // SHARE_GC_G1_G1REMSET_HPP
@@ -79,6 +79,10 @@ static void print_before_rebuild(HeapRegion* r, bool selected_for_rebuild, size_
                                   r->get_type_str());
 }
 
+static bool is_eager_reclaim_type(oop obj) {
+  return obj->is_typeArray() || (G1EagerReclaimHumongousObjArrays && obj->is_objArray());
+}
+
 bool G1RemSetTrackingPolicy::update_humongous_before_rebuild(HeapRegion* r, bool is_live) {
   assert(SafepointSynchronize::is_at_safepoint(), "should be at safepoint");
   assert(r->is_humongous(), "Region %u should be humongous", r->hrm_index());
@@ -92,8 +96,9 @@ bool G1RemSetTrackingPolicy::update_humongous_before_rebuild(HeapRegion* r, bool
   bool selected_for_rebuild = false;
   // For humongous regions, to be of interest for rebuilding the remembered set the following must apply:
   // - We always try to update the remembered sets of humongous regions containing
-  // type arrays as they might have been reset after full gc.
-  if (is_live && cast_to_oop(r->humongous_start_region()->bottom())->is_typeArray() && !r->rem_set()->is_tracked()) {
+  // type arrays as they might have been reset after full gc. The same applies to
+  // object arrays if they may be eagerly reclaimed.
+  if (is_live && is_eager_reclaim_type(cast_to_oop(r->humongous_start_region()->bottom())) && !r->rem_set()->is_tracked()) {
     r->rem_set()->set_state_updating();
     selected_for_rebuild = true;
   }
@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "gc/g1/g1ServiceThread.hpp"
 #include "logging/log.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/timer.hpp"
 #include "runtime/os.hpp"
@@ -44,7 +45,8 @@ G1ServiceThread::G1ServiceThread() :
              "G1ServiceThread monitor",
              true,
              Monitor::_safepoint_check_never),
-    _task_queue() {
+    _task_queue(),
+    _time_jump_nanos(0) {
   set_name("G1 Service");
   create_and_start();
 }
@@ -80,6 +82,7 @@ void G1ServiceThread::schedule(G1ServiceTask* task, jlong delay_ms) {
   task->set_time(os::elapsed_counter() + delay);
 
   MutexLocker ml(&_monitor, Mutex::_no_safepoint_check_flag);
+  apply_time_jump();
   _task_queue.add_ordered(task);
 
   log_trace(gc, task)("G1 Service Thread (%s) (schedule) @%1.3fs",
@@ -91,10 +94,24 @@ void G1ServiceThread::schedule_task(G1ServiceTask* task, jlong delay_ms) {
   notify();
 }
 
+void G1ServiceThread::time_jumped(jlong jump_nanos) {
+  Atomic::add(&_time_jump_nanos, jump_nanos);
+}
+
+void G1ServiceThread::apply_time_jump() {
+  assert(_monitor.owned_by_self(), "Must be owner of lock");
+  jlong jump_nanos = Atomic::xchg(&_time_jump_nanos, (jlong)0);
+  if (jump_nanos != 0 && !_task_queue.is_empty()) {
+    _task_queue.shift(TimeHelper::millis_to_counter(jump_nanos / NANOSECS_PER_MILLISEC));
+  }
+}
+
 int64_t G1ServiceThread::time_to_next_task_ms() {
   assert(_monitor.owned_by_self(), "Must be owner of lock");
   assert(!_task_queue.is_empty(), "Should not be called for empty list");
 
+  apply_time_jump();
+
   jlong time_diff = _task_queue.peek()->time() - os::elapsed_counter();
   if (time_diff < 0) {
     // Run without sleeping.
@@ -229,6 +246,12 @@ bool G1ServiceTaskQueue::is_empty() {
   return &_sentinel == _sentinel.next();
 }
 
+void G1ServiceTaskQueue::shift(jlong delta) {
+  for (G1ServiceTask* task = _sentinel.next(); task != &_sentinel; task = task->next()) {
+    task->_time += delta;
+  }
+}
+
 void G1ServiceTaskQueue::add_ordered(G1ServiceTask* task) {
   assert(task != NULL, "not a valid task");
   assert(task->next() == NULL, "invariant");
@@ -91,6 +91,8 @@ public:
   G1ServiceTask* peek();
   void add_ordered(G1ServiceTask* task);
   bool is_empty();
+  // Moves the time of all tasks by delta, keeping their order.
+  void shift(jlong delta);
 };
 
 // The G1ServiceThread is used to periodically do a number of different tasks:
@@ -103,6 +105,11 @@ class G1ServiceThread: public ConcurrentGCThread {
   // and allow other threads to signal the service thread to wake up.
   Monitor _monitor;
   G1ServiceTaskQueue _task_queue;
+  // Time the clocks jumped over a checkpoint, not yet applied to the queue.
+  volatile jlong _time_jump_nanos;
+
+  // Moves the queued tasks by the time jump, requires the monitor.
+  void apply_time_jump();
 
   void run_service();
   void stop_service();
@@ -135,6 +142,10 @@ public:
   // Schedule an already-registered task to run in at least `delay_ms` time,
   // and notify the service thread.
   void schedule_task(G1ServiceTask* task, jlong delay_ms);
+
+  // The clocks jumped forward over a checkpoint. The delays of the queued
+  // tasks are kept, instead of all of them becoming due at once.
+  void time_jumped(jlong jump_nanos);
 };
 
 #endif // SHARE_GC_G1_G1SERVICETHREAD_HPP
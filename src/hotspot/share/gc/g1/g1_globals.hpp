@@ -82,6 +82,18 @@
                "percent.")                                                  \
                range(0.001, 100.0)                                          \
                                                                             \
+  product(size_t, G1RetainedPreservedMarksSize, 0,                          \
+          "Amount of memory per GC thread used for recording preserved "    \
+          "marks during evacuation failure that is kept for reuse in "      \
+          "later pauses, instead of being freed after each pause.")         \
+          range(0, max_uintx)                                               \
+                                                                            \
+  product(bool, G1PerWorkerPLABResize, false, EXPERIMENTAL,                 \
+          "Start each GC worker with a PLAB of half the size computed "     \
+          "from the statistics of previous GCs, and double the PLAB size "  \
+          "of a worker every 100/TargetPLABWastePct refills during a GC. "  \
+          "Requires ResizePLAB.")                                           \
+                                                                            \
   product(size_t, G1SATBBufferSize, 1*K,                                    \
           "Number of entries in an SATB log buffer.")                       \
           range(1, max_uintx)                                               \
@@ -106,6 +118,23 @@
           "Size of an update buffer")                                       \
           range(1, NOT_LP64(32*M) LP64_ONLY(1*G))                           \
                                                                             \
+  product(uintx, G1FullGCMaxCompactionPercent, 100, EXPERIMENTAL,           \
+          "Maximum amount of live data, in percent of the heap capacity, "  \
+          "that a full GC moves. Further regions are not compacted and are "\
+          "left to later mixed collections. Does not apply to the full GC " \
+          "with maximal compaction done before throwing OutOfMemoryError.") \
+          range(1, 100)                                                     \
+                                                                            \
+  product(bool, G1NUMAOldGenEvacuation, false, EXPERIMENTAL,                \
+          "With UseNUMA, copy objects promoted during evacuation into old " \
+          "regions on the node of the region they are evacuated from, as "  \
+          "is done for survivors.")                                         \
+                                                                            \
+  product(bool, G1BatchRefinementByRegion, false, EXPERIMENTAL,             \
+          "Concurrent refinement collects the references found in an "      \
+          "update buffer and adds them to the remembered sets grouped by "  \
+          "the region referenced.")                                         \
+                                                                            \
   product(size_t, G1ConcRefinementYellowZone, 0,                            \
           "Number of enqueued update buffers that will "                    \
           "trigger concurrent processing. Will be selected ergonomically "  \
@@ -240,6 +269,10 @@
           "Try to reclaim dead large objects that have a few stale "        \
           "references at every young GC.")                                  \
                                                                             \
+  product(bool, G1EagerReclaimHumongousObjArrays, false, EXPERIMENTAL,      \
+          "Also try to reclaim dead large object arrays at young GCs that " \
+          "are not part of a concurrent marking cycle.")                    \
+                                                                            \
   product(uint, G1EagerReclaimRemSetThreshold, 0, EXPERIMENTAL,             \
           "Maximum number of remembered set entries a humongous region "    \
           "otherwise eligible for eager reclaim may have to be a candidate "\
@@ -307,6 +307,14 @@ size_t OtherRegionsTable::occupied() const {
   return _num_occupied;
 }
 
+size_t OtherRegionsTable::num_sparse_regions() const {
+  return _sparse_table.num_regions();
+}
+
+size_t OtherRegionsTable::num_coarse_regions() const {
+  return _has_coarse_entries ? _coarse_map.count_one_bits() : 0;
+}
+
 size_t OtherRegionsTable::mem_size() const {
   size_t sum = 0;
   // all PRTs are of the same size so it is sufficient to query only one of them.
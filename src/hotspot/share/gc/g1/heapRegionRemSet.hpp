@@ -144,6 +144,12 @@ public:
 
   static jint n_coarsenings() { return _n_coarsenings; }
 
+  // Returns the number of source regions tracked by the sparse, fine and
+  // coarse containers respectively.
+  size_t num_sparse_regions() const;
+  size_t num_fine_regions() const { return _n_fine_entries; }
+  size_t num_coarse_regions() const;
+
   // Returns size of the actual remembered set containers in bytes.
   size_t mem_size() const;
   // Returns the size of static data in bytes.
@@ -317,6 +323,10 @@ public:
     return _other_regions.occupied();
   }
 
+  size_t num_sparse_regions() const { return _other_regions.num_sparse_regions(); }
+  size_t num_fine_regions() const   { return _other_regions.num_fine_regions(); }
+  size_t num_coarse_regions() const { return _other_regions.num_coarse_regions(); }
+
   static jint n_coarsenings() { return OtherRegionsTable::n_coarsenings(); }
 
 private:
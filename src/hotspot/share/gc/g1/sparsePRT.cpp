@@ -269,6 +269,10 @@ size_t SparsePRT::mem_size() const {
   return sizeof(SparsePRT) + _table->mem_size();
 }
 
+size_t SparsePRT::num_regions() const {
+  return _table->occupied_entries();
+}
+
 SparsePRT::AddCardResult SparsePRT::add_card(RegionIdx_t region_id, CardIdx_t card_index) {
   if (_table->should_expand()) {
     expand();
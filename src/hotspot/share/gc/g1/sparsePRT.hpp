@@ -54,6 +54,8 @@ public:
   ~SparsePRT();
 
   size_t mem_size() const;
+  // The number of regions with an entry in this table.
+  size_t num_regions() const;
 
   enum AddCardResult {
     overflow, // The table is full, could not add the card to the table.
@@ -184,6 +186,7 @@ public:
   static RSHashTable empty_table;
 
   bool should_expand() const { return _occupied_entries == _num_entries; }
+  size_t occupied_entries() const { return _occupied_entries; }
 
   // Attempts to ensure that the given card_index in the given region is in
   // the sparse table.  If successful (because the card was already
@@ -29,6 +29,7 @@
 #include "gc/shared/adaptiveSizePolicy.hpp"
 #include "gc/shared/gcArguments.hpp"
 #include "gc/shared/genArguments.hpp"
+#include "gc/shared/tlab_globals.hpp"
 #include "gc/shared/workerPolicy.hpp"
 #include "logging/log.hpp"
 #include "runtime/globals.hpp"
@@ -89,6 +90,12 @@ void ParallelArguments::initialize() {
   if (FLAG_IS_DEFAULT(ParallelRefProcEnabled) && ParallelGCThreads > 1) {
     FLAG_SET_DEFAULT(ParallelRefProcEnabled, true);
   }
+
+  // Only pages entirely within an old LAB are placed on the node of the
+  // promoting worker, so use LABs that span a good number of pages.
+  if (UseNUMA && PSNUMALocalPromotion && FLAG_IS_DEFAULT(OldPLABSize)) {
+    FLAG_SET_ERGO(OldPLABSize, 16 * K);
+  }
 }
 
 // The alignment used for boundary between young gen and old gen
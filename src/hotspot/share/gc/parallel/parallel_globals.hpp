@@ -56,7 +56,12 @@
           range(0, 100)                                                     \
                                                                             \
   product(bool, PSChunkLargeArrays, true,                                   \
-          "Process large arrays in chunks")
+          "Process large arrays in chunks")                                 \
+                                                                            \
+  product(bool, PSNUMALocalPromotion, false,                                \
+          "With UseNUMA, place the untouched pages of each old generation " \
+          "promotion LAB on the NUMA node of the GC worker filling it "     \
+          "instead of interleaving them")
 
 // end of GC_PARALLEL_FLAGS
 
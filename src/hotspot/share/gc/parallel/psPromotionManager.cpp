@@ -41,6 +41,8 @@
 #include "memory/resourceArea.hpp"
 #include "oops/access.inline.hpp"
 #include "oops/compressedOops.inline.hpp"
+#include "runtime/os.hpp"
+#include "utilities/align.hpp"
 
 PaddedEnd<PSPromotionManager>* PSPromotionManager::_manager_array = NULL;
 PSPromotionManager::PSScannerTasksQueueSet* PSPromotionManager::_stack_array_depth = NULL;
@@ -295,6 +297,19 @@ void PSPromotionManager::flush_labs() {
   }
 }
 
+// Prefer the node of the promoting worker for the pages entirely within
+// a new old LAB. The old generation is otherwise interleaved. Only pages
+// that are not yet backed by memory are affected; pages that already held
+// objects before the last compaction stay where they are.
+void PSPromotionManager::numa_bind_old_lab(HeapWord* lab_base, size_t lab_word_size) {
+  size_t page_size = UseLargePages ? old_gen()->object_space()->alignment() : os::vm_page_size();
+  char* start = align_up((char*)lab_base, page_size);
+  char* end = align_down((char*)(lab_base + lab_word_size), page_size);
+  if (end > start) {
+    os::numa_make_local(start, pointer_delta(end, start, sizeof(char)), os::numa_get_group_id());
+  }
+}
+
 template <class T> void PSPromotionManager::process_array_chunk_work(
                                                  oop obj,
                                                  int start, int end) {
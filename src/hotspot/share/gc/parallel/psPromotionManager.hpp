@@ -104,6 +104,8 @@ class PSPromotionManager {
 
   void push_depth(ScannerTask task);
 
+  void numa_bind_old_lab(HeapWord* lab_base, size_t lab_word_size);
+
   inline void promotion_trace_event(oop new_obj, oop old_obj, size_t obj_size,
                                     uint age, bool tenured,
                                     const PSPromotionLAB* lab);
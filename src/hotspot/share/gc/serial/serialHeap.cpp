@@ -44,6 +44,8 @@ SerialHeap::SerialHeap() :
     _old_pool(NULL) {
   _young_manager = new GCMemoryManager("Copy");
   _old_manager = new GCMemoryManager("MarkSweepCompact");
+  // The generations resize and clean up after a full GC as for a checkpoint.
+  set_cleanup_unused(SerialFootprintMode);
 }
 
 void SerialHeap::initialize_serviceability() {
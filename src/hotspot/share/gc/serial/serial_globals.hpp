@@ -31,7 +31,13 @@
                         product_pd,  \
                         notproduct,  \
                         range,       \
-                        constraint)
+                        constraint)  \
+                                                                            \
+  product(bool, SerialFootprintMode, false,                                 \
+          "Minimize the committed and resident heap: after every full GC "  \
+          "shrink the old generation to its used size and the young "       \
+          "generation down to its minimum size, and release the memory "    \
+          "of unused space to the operating system")
 
 // end of GC_SERIAL_FLAGS
 
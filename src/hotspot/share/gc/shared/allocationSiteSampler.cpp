@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/allocationSiteSampler.hpp"
+#include "gc/shared/tlab_globals.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/method.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/threadSMR.hpp"
+#include "runtime/vframe.inline.hpp"
+#include "runtime/vmOperation.hpp"
+#include "runtime/vmThread.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/ostream.hpp"
+#include "utilities/powerOfTwo.hpp"
+
+AllocationSiteTable::AllocationSiteTable(size_t capacity) :
+    _entries(NEW_C_HEAP_ARRAY(Entry, round_up_power_of_2(capacity), mtGC)),
+    _capacity(round_up_power_of_2(capacity)),
+    _dropped_samples(0),
+    _dropped_bytes(0) {
+  memset(_entries, 0, sizeof(Entry) * _capacity);
+}
+
+AllocationSiteTable::~AllocationSiteTable() {
+  reset();
+  FREE_C_HEAP_ARRAY(Entry, _entries);
+}
+
+void AllocationSiteTable::reset() {
+  for (size_t i = 0; i < _capacity; i++) {
+    os::free(_entries[i]._site);
+  }
+  memset(_entries, 0, sizeof(Entry) * _capacity);
+  _dropped_samples = 0;
+  _dropped_bytes = 0;
+}
+
+AllocationSiteTable::Entry* AllocationSiteTable::find_or_insert(uint64_t hash, bool* inserted) {
+  const size_t mask = _capacity - 1;
+  // Linear probing, bounded by the table size. A full table returns NULL.
+  for (size_t i = 0, index = (size_t)hash & mask; i < _capacity; i++, index = (index + 1) & mask) {
+    Entry* const entry = &_entries[index];
+    if (entry->_hash == hash) {
+      *inserted = false;
+      return entry;
+    }
+    if (entry->_hash == 0) {
+      entry->_hash = hash;
+      *inserted = true;
+      return entry;
+    }
+  }
+  return NULL;
+}
+
+uint64_t AllocationSiteSampler::stack_hash(JavaThread* thread, Method** methods, int* bcis, uint* depth) {
+  // The walk only reads Method* and bci, so the frames need not be processed.
+  vframeStream vfst(thread, false /* stop_at_java_call_stub */, false /* process_frames */);
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  uint n = 0;
+  for (; !vfst.at_end() && n < AllocationSiteSamplingDepth; vfst.next(), n++) {
+    methods[n] = vfst.method();
+    bcis[n] = vfst.bci();
+    hash = (hash ^ (uint64_t)(uintptr_t)methods[n]) * 0x100000001b3ULL;
+    hash = (hash ^ (uint64_t)(uint)bcis[n]) * 0x100000001b3ULL;
+  }
+  *depth = n;
+  // Zero marks an empty slot.
+  return hash != 0 ? hash : 1;
+}
+
+char* AllocationSiteSampler::format_site(Method** methods, int* bcis, uint depth) {
+  ResourceMark rm;
+  char buf[1024];
+  stringStream ss(buf, sizeof(buf));
+  for (uint i = 0; i < depth; i++) {
+    ss.print("%s%s.%s@%d", i == 0 ? "" : " <- ",
+             methods[i]->method_holder()->external_name(),
+             methods[i]->name()->as_C_string(), bcis[i]);
+  }
+  return os::strdup(ss.base(), mtGC);
+}
+
+void AllocationSiteSampler::sample(JavaThread* thread, size_t bytes) {
+  if (!thread->has_last_Java_frame()) {
+    return;
+  }
+
+  AllocationSiteTable* table = thread->allocation_sites();
+  if (table == NULL) {
+    table = new AllocationSiteTable(AllocationSiteTableSize);
+    thread->set_allocation_sites(table);
+  }
+
+  Method* methods[AllocationSiteTable::MaxDepth];
+  int bcis[AllocationSiteTable::MaxDepth];
+  uint depth = 0;
+  const uint64_t hash = stack_hash(thread, methods, bcis, &depth);
+
+  bool inserted = false;
+  AllocationSiteTable::Entry* const entry = table->find_or_insert(hash, &inserted);
+  if (entry == NULL) {
+    table->_dropped_samples++;
+    table->_dropped_bytes += bytes;
+    return;
+  }
+  if (inserted) {
+    // Resolve the names now, so the table never refers to metadata that
+    // might be unloaded before it is printed.
+    entry->_site = format_site(methods, bcis, depth);
+  }
+  entry->_samples++;
+  entry->_bytes += bytes;
+}
+
+static int compare_hash(AllocationSiteTable::Entry* a, AllocationSiteTable::Entry* b) {
+  return a->_hash < b->_hash ? -1 : (a->_hash > b->_hash ? 1 : 0);
+}
+
+static int compare_bytes(AllocationSiteTable::Entry* a, AllocationSiteTable::Entry* b) {
+  return a->_bytes > b->_bytes ? -1 : (a->_bytes < b->_bytes ? 1 : 0);
+}
+
+// Merges the tables of all threads and reports the sites with the most
+// sampled bytes, either to a stream or as JFR events.
+class VM_PrintAllocationSites : public VM_Operation {
+  outputStream* const _out;
+  const uint _top;
+  const bool _reset;
+
+public:
+  VM_PrintAllocationSites(outputStream* out, uint top, bool reset) :
+    _out(out), _top(top), _reset(reset) {}
+
+  VMOp_Type type() const { return VMOp_PrintAllocationSites; }
+
+  void doit() {
+    ResourceMark rm;
+    GrowableArray<AllocationSiteTable::Entry> sites;
+    uint64_t dropped_samples = 0;
+    uint64_t dropped_bytes = 0;
+    uint64_t total_bytes = 0;
+
+    for (JavaThreadIteratorWithHandle jtiwh; JavaThread* jt = jtiwh.next(); ) {
+      AllocationSiteTable* const table = jt->allocation_sites();
+      if (table == NULL) {
+        continue;
+      }
+      for (size_t i = 0; i < table->_capacity; i++) {
+        if (table->_entries[i]._hash != 0) {
+          sites.append(table->_entries[i]);
+        }
+      }
+      dropped_samples += table->_dropped_samples;
+      dropped_bytes += table->_dropped_bytes;
+    }
+
+    // Combine the entries of the same site recorded by different threads.
+    sites.sort(compare_hash);
+    int merged = 0;
+    for (int i = 0; i < sites.length(); i++) {
+      if (merged > 0 && sites.at(merged - 1)._hash == sites.at(i)._hash) {
+        sites.adr_at(merged - 1)->_samples += sites.at(i)._samples;
+        sites.adr_at(merged - 1)->_bytes += sites.at(i)._bytes;
+      } else {
+        sites.at_put(merged++, sites.at(i));
+      }
+      total_bytes += sites.at(i)._bytes;
+    }
+    sites.trunc_to(merged);
+    sites.sort(compare_bytes);
+
+    const uint n = MIN2(_top, (uint)sites.length());
+    if (_out != NULL) {
+      _out->print_cr("Allocation sites: %d, sampled " UINT64_FORMAT " bytes, dropped " UINT64_FORMAT
+                     " samples (" UINT64_FORMAT " bytes)",
+                     sites.length(), total_bytes, dropped_samples, dropped_bytes);
+      for (uint i = 0; i < n; i++) {
+        const AllocationSiteTable::Entry& e = sites.at(i);
+        _out->print_cr("%4u: " UINT64_FORMAT_W(14) " bytes %5.1f%% " UINT64_FORMAT_W(8) " samples  %s",
+                       i + 1, e._bytes, total_bytes > 0 ? e._bytes * 100.0 / total_bytes : 0.0,
+                       e._samples, e._site);
+      }
+    } else {
+      for (uint i = 0; i < n; i++) {
+        const AllocationSiteTable::Entry& e = sites.at(i);
+        EventAllocationSiteStatistics event;
+        event.set_rank(i + 1);
+        event.set_site(e._site);
+        event.set_bytes(e._bytes);
+        event.set_samples(e._samples);
+        event.commit();
+      }
+    }
+
+    // The copies in sites share the site strings, so reset last.
+    if (_reset) {
+      for (JavaThreadIteratorWithHandle jtiwh; JavaThread* jt = jtiwh.next(); ) {
+        if (jt->allocation_sites() != NULL) {
+          jt->allocation_sites()->reset();
+        }
+      }
+    }
+  }
+};
+
+void AllocationSiteSampler::print_top(outputStream* out, uint top, bool reset) {
+  VM_PrintAllocationSites op(out, top, reset);
+  VMThread::execute(&op);
+}
+
+void AllocationSiteSampler::send_events() {
+  if (!AllocationSiteSampling) {
+    return;
+  }
+  VM_PrintAllocationSites op(NULL, NumEventSites, false /* reset */);
+  VMThread::execute(&op);
+}
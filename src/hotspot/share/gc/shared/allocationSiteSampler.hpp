@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_SHARED_ALLOCATIONSITESAMPLER_HPP
+#define SHARE_GC_SHARED_ALLOCATIONSITESAMPLER_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class JavaThread;
+class Method;
+class outputStream;
+
+// Sampled allocation sites of one thread. Only the owning thread adds to
+// the table, so no synchronization is needed; it is read at safepoints.
+class AllocationSiteTable : public CHeapObj<mtGC> {
+  friend class AllocationSiteSampler;
+  friend class VM_PrintAllocationSites;
+
+public:
+  static const uint MaxDepth = 8;
+
+  struct Entry {
+    uint64_t _hash;     // Stack hash, 0 for an empty slot
+    char*    _site;     // Formatted frames, set when the site is first seen
+    uint64_t _samples;
+    uint64_t _bytes;
+  };
+
+private:
+  Entry* const _entries;
+  const size_t _capacity;
+  uint64_t     _dropped_samples;
+  uint64_t     _dropped_bytes;
+
+  Entry* find_or_insert(uint64_t hash, bool* inserted);
+
+public:
+  AllocationSiteTable(size_t capacity);
+  ~AllocationSiteTable();
+
+  void reset();
+};
+
+// Allocation profiler sampling the allocating site on TLAB refills and on
+// allocations outside of TLABs. A TLAB refill is attributed the size of
+// the new TLAB, so the recorded bytes estimate the allocation volume per
+// site. Sites are identified by a hash of the top frames and are only
+// formatted the first time a thread sees them.
+class AllocationSiteSampler : AllStatic {
+  static const uint NumEventSites = 20;
+
+  static uint64_t stack_hash(JavaThread* thread, Method** methods, int* bcis, uint* depth);
+  static char* format_site(Method** methods, int* bcis, uint depth);
+
+public:
+  // Called after an allocation that refilled the TLAB or bypassed it.
+  static void sample(JavaThread* thread, size_t bytes);
+
+  // Print the top sites of all threads, optionally clearing the tables.
+  static void print_top(outputStream* out, uint top, bool reset);
+
+  // Send the top sites as AllocationSiteStatistics events.
+  static void send_events();
+};
+
+#endif // SHARE_GC_SHARED_ALLOCATIONSITESAMPLER_HPP
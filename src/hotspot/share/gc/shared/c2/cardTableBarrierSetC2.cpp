@@ -46,6 +46,56 @@ Node* CardTableBarrierSetC2::byte_map_base_node(GraphKit* kit) const {
    }
 }
 
+bool CardTableBarrierSetC2::is_allocated_without_safepoint(GraphKit* kit, Node* obj) const {
+  if (!ReduceCardMarksForNewObjects) {
+    return false;
+  }
+  AllocateNode* alloc = AllocateNode::Ideal_allocation(obj, &kit->gvn());
+  if (alloc == NULL) {
+    return false;
+  }
+  InitializeNode* init = alloc->initialization();
+  if (init == NULL) {
+    return false;
+  }
+  // Walk the control paths backwards from the store up to the allocation.
+  // Give up on safepoints and calls, on paths that bypass the allocation,
+  // and on regions that are not completely parsed yet, such as the head of
+  // a loop whose back edge is still missing.
+  const uint max_visited = 100;
+  ResourceMark rm;
+  Unique_Node_List visited;
+  Node_List worklist;
+  worklist.push(kit->control());
+  while (worklist.size() > 0) {
+    Node* n = worklist.pop();
+    if (n == init || visited.member(n)) {
+      continue;
+    }
+    visited.push(n);
+    if (visited.size() > max_visited ||
+        n->is_top() || n->is_Start() || n->is_Root() || n->is_SafePoint()) {
+      return false;
+    }
+    uint start = n->is_Region() ? 1 : 0;
+    uint end = n->is_Region() ? n->req() : 1;
+    for (uint i = start; i < end; i++) {
+      Node* in = n->in(i);
+      if (in == NULL) {
+        return false;
+      }
+      worklist.push(in);
+    }
+  }
+#ifndef PRODUCT
+  if (PrintEliminateCardMarks) {
+    tty->print_cr("++++ Eliminated: card mark for %d %s", alloc->_idx,
+                  alloc->is_AllocateArray() ? "AllocateArray" : "Allocate");
+  }
+#endif
+  return true;
+}
+
 // vanilla post barrier
 // Insert a write-barrier store.  This is to let generational GC work; we have
 // to flag all oop-stores before the next GC point.
@@ -76,6 +126,10 @@ void CardTableBarrierSetC2::post_barrier(GraphKit* kit,
     return;
   }
 
+  if (use_ReduceInitialCardMarks() && is_allocated_without_safepoint(kit, obj)) {
+    return;
+  }
+
   if (!use_precise) {
     // All card marks for a (non-array) instance are in one place:
     adr = obj;
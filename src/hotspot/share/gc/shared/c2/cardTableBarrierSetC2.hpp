@@ -41,6 +41,13 @@ protected:
 
   Node* byte_map_base_node(GraphKit* kit) const;
 
+  // Returns true if obj was allocated in this compilation and there is no
+  // safepoint or call on any control path from the allocation to the current
+  // control.  For such an object the card marks are either not needed, as
+  // the object is young, or covered by the card mark the allocation slow
+  // path applies or defers until the next safepoint or slow path allocation.
+  bool is_allocated_without_safepoint(GraphKit* kit, Node* obj) const;
+
 public:
   virtual void clone(GraphKit* kit, Node* src, Node* dst, Node* size, bool is_array) const;
   virtual bool is_gc_barrier_node(Node* node) const;
@@ -615,6 +615,10 @@ bool CollectedHeap::supports_object_pinning() const {
   return false;
 }
 
+bool CollectedHeap::can_pin_object(oop obj) const {
+  return supports_object_pinning();
+}
+
 oop CollectedHeap::pin_object(JavaThread* thread, oop obj) {
   ShouldNotReachHere();
   return NULL;
@@ -380,6 +380,13 @@ class CollectedHeap : public CHeapObj<mtGC> {
   // G1UncommitRegionTask may be still pending after collect() has returned.
   virtual void finish_collection() {}
 
+  // Returns unused heap memory to the OS right away, e.g. when the system
+  // runs short of it. May start a collection. Called outside of safepoints.
+  virtual void uncommit_unused_memory() {}
+
+  // Called at a safepoint after the VM is restored from a checkpoint.
+  virtual void after_restore() {}
+
   // Total number of GC collections (started)
   unsigned int total_collections() const { return _total_collections; }
   unsigned int total_full_collections() const { return _total_full_collections;}
@@ -497,6 +504,9 @@ class CollectedHeap : public CHeapObj<mtGC> {
   // and Release*Critical() family of functions. If supported, the GC
   // must guarantee that pinned objects never move.
   virtual bool supports_object_pinning() const;
+  // Whether obj can be pinned even if the GC does not support pinning
+  // in general. Other objects are protected by the GCLocker.
+  virtual bool can_pin_object(oop obj) const;
   virtual oop pin_object(JavaThread* thread, oop obj);
   virtual void unpin_object(JavaThread* thread, oop obj);
 
@@ -30,6 +30,7 @@
 #include "runtime/arguments.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/globals_extension.hpp"
+#include "utilities/align.hpp"
 #include "utilities/macros.hpp"
 
 size_t HeapAlignment = 0;
@@ -84,6 +85,17 @@ size_t GCArguments::compute_heap_alignment() {
   return alignment;
 }
 
+size_t GCArguments::soft_max_heap_size_for(julong phys_mem) {
+  if (!FLAG_IS_DEFAULT(MaxRAM)) {
+    phys_mem = MIN2(phys_mem, (julong)MaxRAM);
+  }
+  julong target = (julong)((phys_mem * MaxRAMPercentage) / 100);
+  if (FLAG_IS_CMDLINE(MaxHeapSize) || target > MaxHeapSize) {
+    target = MaxHeapSize;
+  }
+  return MAX2(align_down((size_t)target, HeapAlignment), MinHeapSize);
+}
+
 #ifdef ASSERT
 void GCArguments::assert_flags() {
   assert(InitialHeapSize <= MaxHeapSize, "Ergonomics decided on incompatible initial and maximum heap sizes");
@@ -61,6 +61,10 @@ public:
   void initialize_heap_sizes();
 
   static size_t compute_heap_alignment();
+
+  // The SoftMaxHeapSize that heap sizing ergonomics would pick for the
+  // given amount of memory, within the reserved MaxHeapSize.
+  static size_t soft_max_heap_size_for(julong phys_mem);
 };
 
 #endif // SHARE_GC_SHARED_GCARGUMENTS_HPP
@@ -279,6 +279,12 @@
   product(uintx, WorkStealingSpinToYieldRatio, 10, EXPERIMENTAL,            \
           "Ratio of hard spins to calls to yield")                          \
                                                                             \
+  product(uintx, WorkStealingBatchSize, 1, EXPERIMENTAL,                    \
+          "Maximum number of tasks moved from a victim queue to the "       \
+          "stealing queue in one steal, at most half of the victim's "      \
+          "tasks; 1 steals a single task")                                  \
+          range(1, 1024)                                                    \
+                                                                            \
   develop(uintx, ObjArrayMarkingStride, 2048,                               \
           "Number of object array elements to push onto the marking stack " \
           "before pushing a continuation entry")                            \
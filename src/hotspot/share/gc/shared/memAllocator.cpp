@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "classfile/javaClasses.hpp"
 #include "gc/shared/allocTracer.hpp"
+#include "gc/shared/allocationSiteSampler.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/memAllocator.hpp"
 #include "gc/shared/threadLocalAllocBuffer.inline.hpp"
@@ -59,6 +60,7 @@ class MemAllocator::Allocation: StackObj {
   void notify_allocation_low_memory_detector();
   void notify_allocation_jfr_sampler();
   void notify_allocation_dtrace_sampler();
+  void notify_allocation_site_sampler();
 #ifdef ASSERT
   void check_for_valid_allocation_state() const;
 #endif
@@ -226,10 +228,22 @@ void MemAllocator::Allocation::notify_allocation_dtrace_sampler() {
   }
 }
 
+void MemAllocator::Allocation::notify_allocation_site_sampler() {
+  if (AllocationSiteSampling) {
+    if (_allocated_outside_tlab) {
+      AllocationSiteSampler::sample(_thread, _allocator._word_size * HeapWordSize);
+    } else if (_allocated_tlab_size != 0) {
+      // TLAB was refilled
+      AllocationSiteSampler::sample(_thread, _allocated_tlab_size * HeapWordSize);
+    }
+  }
+}
+
 void MemAllocator::Allocation::notify_allocation() {
   notify_allocation_low_memory_detector();
   notify_allocation_jfr_sampler();
   notify_allocation_dtrace_sampler();
+  notify_allocation_site_sampler();
   notify_allocation_jvmti_sampler();
 }
 
@@ -1072,9 +1072,9 @@ OopStorage::BasicParState::BasicParState(const OopStorage* storage,
   _storage(storage),
   _active_array(_storage->obtain_active_array()),
   _block_count(0),              // initialized properly below
-  _next_block(0),
   _estimated_thread_count(estimated_thread_count),
   _concurrent(concurrent),
+  _next_block(0),
   _num_dead(0)
 {
   assert(estimated_thread_count > 0, "estimated thread count must be positive");
@@ -1114,8 +1114,10 @@ bool OopStorage::BasicParState::claim_next_segment(IterationData* data) {
   // quantity, get delayed, and then end up claiming most or all of
   // the remaining largish amount of work, leaving nothing for other
   // threads to do.  But too small a step can lead to contention
-  // over _next_block, esp. when the work per block is small.
-  size_t max_step = 10;
+  // over _next_block, esp. when the work per block is small.  So let
+  // the cap grow with the number of blocks per thread in large storages,
+  // while still leaving several claims per thread.
+  size_t max_step = MAX2(MinClaimStep, _block_count / (_estimated_thread_count * ClaimsPerThread));
   size_t remaining = _block_count - start;
   size_t step = MIN2(max_step, 1 + (remaining / _estimated_thread_count));
   // Atomic::add with possible overshoot.  This can perform better
@@ -1132,6 +1134,7 @@ bool OopStorage::BasicParState::claim_next_segment(IterationData* data) {
     // Record claimed segment for iteration.
     data->_segment_start = start;
     data->_segment_end = end;
+    data->_claims++;
     return true;                // Success.
   } else {
     // No more blocks to claim.
@@ -1142,9 +1145,9 @@ bool OopStorage::BasicParState::claim_next_segment(IterationData* data) {
 bool OopStorage::BasicParState::finish_iteration(const IterationData* data) const {
   log_info(oopstorage, blocks, stats)
           ("Parallel iteration on %s: blocks = " SIZE_FORMAT
-           ", processed = " SIZE_FORMAT " (%2.f%%)",
+           ", processed = " SIZE_FORMAT " (%2.f%%), claims = " SIZE_FORMAT,
            _storage->name(), _block_count, data->_processed,
-           percent_of(data->_processed, _block_count));
+           percent_of(data->_processed, _block_count), data->_claims);
   return false;
 }
 
@@ -26,6 +26,7 @@
 #define SHARE_GC_SHARED_OOPSTORAGEPARSTATE_HPP
 
 #include "gc/shared/oopStorage.hpp"
+#include "memory/padded.hpp"
 #include "utilities/globalDefinitions.hpp"
 
 #include <type_traits>
@@ -132,15 +133,25 @@ class OopStorage::BasicParState {
   const OopStorage* _storage;
   ActiveArray* _active_array;
   size_t _block_count;
-  volatile size_t _next_block;
   uint _estimated_thread_count;
   bool _concurrent;
+  // The claim counter and the dead count are updated by all workers, so
+  // keep them off the cache line of the read-mostly fields above.
+  DEFINE_PAD_MINUS_SIZE(0, DEFAULT_CACHE_LINE_SIZE, 0);
+  volatile size_t _next_block;
+  DEFINE_PAD_MINUS_SIZE(1, DEFAULT_CACHE_LINE_SIZE, sizeof(size_t));
   volatile size_t _num_dead;
+  DEFINE_PAD_MINUS_SIZE(2, DEFAULT_CACHE_LINE_SIZE, sizeof(size_t));
 
   NONCOPYABLE(BasicParState);
 
   struct IterationData;
 
+  // Smallest cap on the number of blocks claimed at once.
+  static const size_t MinClaimStep = 10;
+  // Least number of claims per thread when the cap is above MinClaimStep.
+  static const size_t ClaimsPerThread = 4;
+
   void update_concurrent_iteration_count(int value);
   bool claim_next_segment(IterationData* data);
   bool finish_iteration(const IterationData* data) const;
@@ -28,6 +28,7 @@
 #include "gc/shared/oopStorageParState.hpp"
 
 #include "gc/shared/oopStorage.inline.hpp"
+#include "runtime/prefetch.inline.hpp"
 #include "utilities/macros.hpp"
 
 #include <type_traits>
@@ -47,6 +48,7 @@ struct OopStorage::BasicParState::IterationData {
   size_t _segment_start;
   size_t _segment_end;
   size_t _processed;
+  size_t _claims;
 };
 
 template<bool is_const, typename F>
@@ -61,6 +63,11 @@ inline void OopStorage::BasicParState::iterate(F f) {
     size_t i = data._segment_start;
     do {
       BlockPtr block = _active_array->at(i);
+      // Blocks are scattered in memory, fetch the header of the next one
+      // while this one is processed.
+      if (i + 1 < data._segment_end) {
+        Prefetch::read(_active_array->at(i + 1), 0);
+      }
       block->iterate(atf_f);
     } while (++i < data._segment_end);
   }
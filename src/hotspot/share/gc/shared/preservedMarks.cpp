@@ -64,7 +64,7 @@ void PreservedMarks::restore_and_increment(volatile size_t* const total_size_add
 void PreservedMarks::assert_empty() {
   assert(_stack.is_empty(), "stack expected to be empty, size = " SIZE_FORMAT,
          _stack.size());
-  assert(_stack.cache_size() == 0,
+  assert(_stack.max_cache_size() > 0 || _stack.cache_size() == 0,
          "stack expected to have no cached segments, cache size = " SIZE_FORMAT,
          _stack.cache_size());
 }
@@ -76,7 +76,7 @@ void RemoveForwardedPointerClosure::do_object(oop obj) {
   }
 }
 
-void PreservedMarksSet::init(uint num) {
+void PreservedMarksSet::init(uint num, size_t max_cache_bytes) {
   assert(_stacks == nullptr && _num == 0, "do not re-initialize");
   assert(num > 0, "pre-condition");
   if (_in_c_heap) {
@@ -85,7 +85,7 @@ void PreservedMarksSet::init(uint num) {
     _stacks = NEW_RESOURCE_ARRAY(Padded<PreservedMarks>, num);
   }
   for (uint i = 0; i < num; i += 1) {
-    ::new (_stacks + i) PreservedMarks();
+    ::new (_stacks + i) PreservedMarks(max_cache_bytes);
   }
   _num = num;
 
@@ -69,10 +69,13 @@ public:
   void restore_and_increment(volatile size_t* const _total_size_addr);
   inline static void init_forwarded_mark(oop obj);
 
-  // Assert the stack is empty and has no cached segments.
+  // Assert the stack is empty and has no cached segments, unless caching
+  // has been enabled.
   void assert_empty() PRODUCT_RETURN;
 
-  inline PreservedMarks();
+  // By default segments are freed as soon as they are no longer used.
+  // Otherwise up to max_cache_bytes of segments are retained for reuse.
+  inline PreservedMarks(size_t max_cache_bytes = 0);
   ~PreservedMarks() { assert_empty(); }
 };
 
@@ -107,8 +110,10 @@ public:
     return (_stacks + i);
   }
 
-  // Allocate stack array.
-  void init(uint num);
+  // Allocate stack array.  Each stack retains up to max_cache_bytes of
+  // its segments when emptied, so they can be reused without allocation
+  // the next time the set is used.
+  void init(uint num, size_t max_cache_bytes = 0);
 
   // Iterate over all stacks, restore all preserved marks, and reclaim
   // the memory taken up by the stack segments using the given WorkGang. If the WorkGang
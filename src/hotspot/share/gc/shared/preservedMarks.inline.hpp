@@ -57,13 +57,13 @@ inline void PreservedMarks::init_forwarded_mark(oop obj) {
   obj->init_mark();
 }
 
-inline PreservedMarks::PreservedMarks()
+inline PreservedMarks::PreservedMarks(size_t max_cache_bytes)
     : _stack(OopAndMarkWordStack::default_segment_size(),
              // This stack should be used very infrequently so there's
-             // no point in caching stack segments (there will be a
-             // waste of space most of the time). So we set the max
-             // cache size to 0.
-             0 /* max_cache_size */) { }
+             // usually no point in caching stack segments (there will be a
+             // waste of space most of the time). Users that see bursts of
+             // preserved marks can ask for a cache though.
+             max_cache_bytes / (OopAndMarkWordStack::default_segment_size() * sizeof(OopAndMarkWord))) { }
 
 void PreservedMarks::OopAndMarkWord::set_mark() const {
   _o->set_mark(_m);
@@ -126,11 +126,21 @@ void StringDedup::Processor::cleanup_table(SuspendibleThreadSetJoiner* joiner,
   }
 }
 
+// Requests are processed in small batches.  The table lookups for a batch
+// are preceded by computing the hash codes and prefetching the buckets, so
+// the table cache misses for the strings in the batch overlap rather than
+// being taken one at a time.  There must be no yield between loading the
+// strings of a batch and deduplicating them, so table growth that is found
+// needed while processing a batch is deferred to the end of the batch.
 class StringDedup::Processor::ProcessRequest final : public OopClosure {
+  static const size_t BatchSize = 8;
+
   OopStorage* _storage;
   SuspendibleThreadSetJoiner* _joiner;
   size_t _release_index;
+  size_t _batch_length;
   oop* _bulk_release[OopStorage::bulk_allocate_limit];
+  oop* _batch[BatchSize];
 
   void release_ref(oop* ref) {
     assert(_release_index < ARRAY_SIZE(_bulk_release), "invariant");
@@ -142,40 +152,69 @@ class StringDedup::Processor::ProcessRequest final : public OopClosure {
     }
   }
 
+  void process_batch() {
+    size_t length = _batch_length;
+    _batch_length = 0;
+    if (length == 0 ||
+        !_processor->yield_or_continue(_joiner, Stat::Phase::process)) {
+      return;
+    }
+    oop strings[BatchSize];
+    uint hash_codes[BatchSize];
+    size_t count = 0;
+    for (size_t i = 0; i < length; ++i) {
+      oop java_string = NativeAccess<ON_PHANTOM_OOP_REF>::oop_load(_batch[i]);
+      release_ref(_batch[i]);
+      // Dedup java_string, after checking for various reasons to skip it.
+      if (java_string == nullptr) {
+        // String became unreachable before we got a chance to process it.
+        _cur_stat.inc_skipped_dead();
+      } else if (java_lang_String::value(java_string) == nullptr) {
+        // Request during String construction, before its value array has
+        // been initialized.
+        _cur_stat.inc_skipped_incomplete();
+      } else {
+        strings[count] = java_string;
+        hash_codes[count] = Table::prefetch(java_lang_String::value(java_string));
+        ++count;
+      }
+    }
+    for (size_t i = 0; i < count; ++i) {
+      Table::prefetch_entries(hash_codes[i]);
+    }
+    bool grow_needed = false;
+    for (size_t i = 0; i < count; ++i) {
+      Table::deduplicate(strings[i], hash_codes[i]);
+      grow_needed = grow_needed || Table::is_grow_needed();
+    }
+    if (grow_needed) {
+      _cur_stat.report_process_pause();
+      _processor->cleanup_table(_joiner, true /* grow_only */, false /* force */);
+      _cur_stat.report_process_resume();
+    }
+  }
+
 public:
   ProcessRequest(OopStorage* storage, SuspendibleThreadSetJoiner* joiner) :
     _storage(storage),
     _joiner(joiner),
     _release_index(0),
-    _bulk_release()
+    _batch_length(0),
+    _bulk_release(),
+    _batch()
   {}
 
   ~ProcessRequest() {
+    process_batch();
     _storage->release(_bulk_release, _release_index);
   }
 
   virtual void do_oop(narrowOop*) { ShouldNotReachHere(); }
 
   virtual void do_oop(oop* ref) {
-    if (_processor->yield_or_continue(_joiner, Stat::Phase::process)) {
-      oop java_string = NativeAccess<ON_PHANTOM_OOP_REF>::oop_load(ref);
-      release_ref(ref);
-      // Dedup java_string, after checking for various reasons to skip it.
-      if (java_string == nullptr) {
-        // String became unreachable before we got a chance to process it.
-        _cur_stat.inc_skipped_dead();
-      } else if (java_lang_String::value(java_string) == nullptr) {
-        // Request during String construction, before its value array has
-        // been initialized.
-        _cur_stat.inc_skipped_incomplete();
-      } else {
-        Table::deduplicate(java_string);
-        if (Table::is_grow_needed()) {
-          _cur_stat.report_process_pause();
-          _processor->cleanup_table(_joiner, true /* grow_only */, false /* force */);
-          _cur_stat.report_process_resume();
-        }
-      }
+    _batch[_batch_length++] = ref;
+    if (_batch_length == BatchSize) {
+      process_batch();
     }
   }
 };
@@ -223,5 +262,6 @@ void StringDedup::Processor::log_statistics() {
     _total_stat.log_statistics(true);
     Table::log_statistics();
   }
+  _cur_stat.send_event();
   _cur_stat = Stat{};
 }
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc/shared/stringdedup/stringDedupStat.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "logging/log.hpp"
 #include "utilities/globalDefinitions.hpp"
 
@@ -259,3 +260,19 @@ void StringDedup::Stat::log_statistics(bool total) const {
   log_debug(stringdedup)("    Skipped: %zu (dead), %zu (incomplete), %zu (shared)",
                          _skipped_dead, _skipped_incomplete, _skipped_shared);
 }
+
+void StringDedup::Stat::send_event() const {
+  EventStringDeduplication e;
+  if (e.should_commit()) {
+    e.set_inspected(_inspected);
+    e.set_known(_known);
+    e.set_added(_new);
+    e.set_addedBytes(_new_bytes);
+    e.set_deduplicated(_deduped);
+    e.set_deduplicatedBytes(_deduped_bytes);
+    e.set_skipped(_skipped_dead + _skipped_incomplete);
+    e.set_processTime(_process_elapsed);
+    e.set_concurrentTime(_concurrent_elapsed);
+    e.commit();
+  }
+}
@@ -161,6 +161,7 @@ public:
 
   void add(const Stat* const stat);
   void log_statistics(bool total) const;
+  void send_event() const;
 
   static void log_summary(const Stat* last_stat, const Stat* total_stat);
 };
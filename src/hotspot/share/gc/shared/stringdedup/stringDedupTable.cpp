@@ -43,6 +43,7 @@
 #include "oops/typeArrayOop.inline.hpp"
 #include "oops/weakHandle.inline.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/prefetch.inline.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/growableArray.hpp"
@@ -110,6 +111,12 @@ public:
   bool is_empty() const { return _hashes.length() == 0; }
   int length() const { return _hashes.length(); }
 
+  void prefetch_hashes() const {
+    if (!is_empty()) {
+      Prefetch::read(_hashes.adr_at(0), 0);
+    }
+  }
+
   void add(uint hash_code, TableValue value) {
     expand_if_full();
     _hashes.push(hash_code);
@@ -632,7 +639,24 @@ bool StringDedup::Table::deduplicate_if_permitted(oop java_string,
   }
 }
 
+// The bucket is usually a cache miss, and so is its hashes array.  The
+// latter can't be prefetched until the former has arrived, hence the two
+// steps.
+uint StringDedup::Table::prefetch(typeArrayOop value) {
+  uint hash_code = compute_hash(value);
+  Prefetch::read(&_buckets[hash_to_index(hash_code)], 0);
+  return hash_code;
+}
+
+void StringDedup::Table::prefetch_entries(uint hash_code) {
+  _buckets[hash_to_index(hash_code)].prefetch_hashes();
+}
+
 void StringDedup::Table::deduplicate(oop java_string) {
+  deduplicate(java_string, compute_hash(java_lang_String::value(java_string)));
+}
+
+void StringDedup::Table::deduplicate(oop java_string, uint hash_code) {
   assert(java_lang_String::is_instance(java_string), "precondition");
   _cur_stat.inc_inspected();
   if ((StringTable::shared_entry_count() > 0) &&
@@ -640,7 +664,7 @@ void StringDedup::Table::deduplicate(oop java_string) {
     return;                     // Done if deduplicated against shared StringTable.
   }
   typeArrayOop value = java_lang_String::value(java_string);
-  uint hash_code = compute_hash(value);
+  assert(hash_code == compute_hash(value), "hash code mismatch");
   TableValue tv = find(value, hash_code);
   if (tv.is_empty()) {
     // Not in table.  Create a new table entry.
@@ -117,6 +117,20 @@ public:
   // Otherwise, add the string's data array to the table.
   static void deduplicate(oop java_string);
 
+  // Compute the hash code for value and prefetch the table bucket it maps
+  // to.  Returns the hash code, to be passed to deduplicate.  Used with
+  // prefetch_entries to overlap the table cache misses for a batch of
+  // strings.
+  static uint prefetch(typeArrayOop value);
+
+  // Prefetch the entries of the bucket hash_code maps to.  The bucket
+  // should already have been prefetched by prefetch.
+  static void prefetch_entries(uint hash_code);
+
+  // Same as deduplicate(java_string), with hash_code being the result of
+  // prefetch for the string's current value array.
+  static void deduplicate(oop java_string, uint hash_code);
+
   // Returns true if table needs to grow.
   static bool is_grow_needed();
 
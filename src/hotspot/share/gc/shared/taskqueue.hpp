@@ -460,6 +460,7 @@ private:
   T** _queues;
 
   bool steal_best_of_2(uint queue_num, E& t);
+  void steal_batch(T* local_queue, T* victim, uint victim_size);
 
 public:
   GenericTaskQueueSet(uint n);
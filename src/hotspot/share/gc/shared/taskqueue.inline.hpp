@@ -27,6 +27,7 @@
 
 #include "gc/shared/taskqueue.hpp"
 
+#include "gc/shared/gc_globals.hpp"
 #include "memory/allocation.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
@@ -266,6 +267,27 @@ int GenericTaskQueue<E, F, N>::next_random_queue_id() {
   return randomParkAndMiller(&_seed);
 }
 
+// After a successful steal, move up to half of the tasks the victim had
+// when it was sampled, at most WorkStealingBatchSize including the stolen
+// one, into the local queue. Every task is still claimed with its own
+// pop_global, as pop_local relies on thieves taking a single task at a
+// time; the gain is that further work is found without a new victim
+// selection, and other thieves can steal it from the local queue.
+// Only called by the owner of local_queue, so the pushes cannot fail:
+// concurrent steals from local_queue only make room.
+template<class T, MEMFLAGS F> void
+GenericTaskQueueSet<T, F>::steal_batch(T* local_queue, T* victim, uint victim_size) {
+  uint batch = MIN2(victim_size / 2, (uint)WorkStealingBatchSize);
+  for (uint i = 1; i < batch && local_queue->size() < local_queue->max_elems(); i++) {
+    E t;
+    if (!victim->pop_global(t)) {
+      break;
+    }
+    bool pushed = local_queue->push(t);
+    assert(pushed, "local queue must have room");
+  }
+}
+
 template<class T, MEMFLAGS F> bool
 GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
   if (_n > 2) {
@@ -302,6 +324,7 @@ GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
 
     if (suc) {
       local_queue->set_last_stolen_queue_id(sel_k);
+      steal_batch(local_queue, _queues[sel_k], MAX2(sz1, sz2));
     } else {
       local_queue->invalidate_last_stolen_queue_id();
     }
@@ -310,7 +333,12 @@ GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, E& t) {
   } else if (_n == 2) {
     // Just try the other one.
     uint k = (queue_num + 1) % 2;
-    return _queues[k]->pop_global(t);
+    uint sz = _queues[k]->size();
+    if (_queues[k]->pop_global(t)) {
+      steal_batch(_queues[queue_num], _queues[k], sz);
+      return true;
+    }
+    return false;
   } else {
     assert(_n == 1, "can't be zero.");
     return false;
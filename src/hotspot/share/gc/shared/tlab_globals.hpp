@@ -88,6 +88,18 @@
           range(0, max_jint)                                                \
           constraint(TLABWasteIncrementConstraintFunc,AfterMemoryInit)      \
                                                                             \
+  product(bool, AllocationSiteSampling, false, MANAGEABLE,                  \
+          "Sample the allocation site on TLAB refills and allocations "     \
+          "outside TLABs, see GC.allocation_sites")                         \
+                                                                            \
+  product(uintx, AllocationSiteSamplingDepth, 4,                            \
+          "Number of Java frames identifying a sampled allocation site")    \
+          range(1, 8)                                                       \
+                                                                            \
+  product(uintx, AllocationSiteTableSize, 256,                              \
+          "Maximum number of allocation sites recorded per thread")         \
+          range(16, 65536)                                                  \
+                                                                            \
 
 // end of TLAB_FLAGS
 
@@ -48,13 +48,6 @@ void notify_jvmti_tagmaps() {
   // the tagmap's oopstorage notification handler to not care whether it's
   // invoked by STW or concurrent reference processing.
   JvmtiTagMap::set_needs_cleaning();
-
-  // Notify JVMTI tagmaps that a STW collection may have moved objects, so
-  // the tagmaps need rehashing.  This isn't the right place for this, but
-  // is convenient because all the STW collectors use WeakProcessor.  One
-  // problem is that the end of a G1 concurrent collection also comes here,
-  // possibly triggering unnecessary rehashes.
-  JvmtiTagMap::set_needs_rehashing();
 #endif // INCLUDE_JVMTI
 }
 
@@ -33,6 +33,7 @@
 
 uint WorkerPolicy::_parallel_worker_threads = 0;
 bool WorkerPolicy::_parallel_worker_threads_initialized = false;
+uint WorkerPolicy::_active_workers_limit = UINT_MAX;
 
 uint WorkerPolicy::nof_parallel_worker_threads(uint num,
                                                uint den,
@@ -83,6 +84,11 @@ uint WorkerPolicy::parallel_worker_threads() {
   return _parallel_worker_threads;
 }
 
+void WorkerPolicy::set_active_workers_limit(uint limit) {
+  assert(limit > 0, "Always need at least 1");
+  _active_workers_limit = limit;
+}
+
 //  If the number of GC threads was set on the command line, use it.
 //  Else
 //    Calculate the number of GC threads based on the number of Java threads.
@@ -162,6 +168,7 @@ uint WorkerPolicy::calc_active_workers(uintx total_workers,
                                                      active_workers,
                                                      application_workers);
   }
+  new_active_workers = MIN2(new_active_workers, _active_workers_limit);
   assert(new_active_workers > 0, "Always need at least 1");
   return new_active_workers;
 }
@@ -169,13 +176,14 @@ uint WorkerPolicy::calc_active_workers(uintx total_workers,
 uint WorkerPolicy::calc_active_conc_workers(uintx total_workers,
                                             uintx active_workers,
                                             uintx application_workers) {
+  uint no_of_gc_threads;
   if (!UseDynamicNumberOfGCThreads || !FLAG_IS_DEFAULT(ConcGCThreads)) {
-    return ConcGCThreads;
+    no_of_gc_threads = ConcGCThreads;
   } else {
-    uint no_of_gc_threads = calc_default_active_workers(total_workers,
-                                                        1, /* Minimum number of workers */
-                                                        active_workers,
-                                                        application_workers);
-    return no_of_gc_threads;
+    no_of_gc_threads = calc_default_active_workers(total_workers,
+                                                   1, /* Minimum number of workers */
+                                                   active_workers,
+                                                   application_workers);
   }
+  return MIN2(no_of_gc_threads, _active_workers_limit);
 }
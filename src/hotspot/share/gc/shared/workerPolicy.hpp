@@ -34,6 +34,9 @@ class WorkerPolicy : public AllStatic {
   static bool _debug_perturbation;
   static uint _parallel_worker_threads;
   static bool _parallel_worker_threads_initialized;
+  // Upper bound for the active workers of a gang, e.g. the number of
+  // processors of the host a CRaC image has been restored on.
+  static uint _active_workers_limit;
 
   static uint nof_parallel_worker_threads(uint num,
                                           uint den,
@@ -50,6 +53,9 @@ public:
   // command line.
   static uint parallel_worker_threads();
 
+  static uint active_workers_limit() { return _active_workers_limit; }
+  static void set_active_workers_limit(uint limit);
+
   // Return number default GC threads to use in the next GC.
   static uint calc_default_active_workers(uintx total_workers,
                                           const uintx min_workers,
@@ -1164,6 +1164,19 @@ void ShenandoahHeap::do_full_collection(bool clear_all_soft_refs) {
   //assert(false, "Shouldn't need to do full collections");
 }
 
+void ShenandoahHeap::finish_collection() {
+  uncommit_unused_memory();
+}
+
+void ShenandoahHeap::uncommit_unused_memory() {
+  if (!ShenandoahUncommit) {
+    return;
+  }
+  // Uncommit every empty region right away instead of waiting for
+  // ShenandoahUncommitDelay to expire in the control thread.
+  op_uncommit(os::elapsedTime(), min_capacity());
+}
+
 HeapWord* ShenandoahHeap::block_start(const void* addr) const {
   ShenandoahHeapRegion* r = heap_region_containing(addr);
   if (r != NULL) {
@@ -479,6 +479,8 @@ public:
 
   void collect(GCCause::Cause cause);
   void do_full_collection(bool clear_all_soft_refs);
+  void finish_collection();
+  void uncommit_unused_memory();
 
   // Used for parsing heap during error printing
   HeapWord* block_start(const void* addr) const;
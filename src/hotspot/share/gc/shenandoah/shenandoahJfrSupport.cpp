@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "gc/shared/gcId.hpp"
 #include "gc/shenandoah/shenandoahHeap.inline.hpp"
 #include "gc/shenandoah/shenandoahHeapRegion.hpp"
 #include "gc/shenandoah/shenandoahJfrSupport.hpp"
@@ -53,6 +54,22 @@ void ShenandoahJFRSupport::register_jfr_type_serializers() {
 }
 #endif
 
+void ShenandoahJFRSupport::send_pacing_delay_histogram(const size_t* buckets, uint num_buckets) {
+  for (uint i = 0; i < num_buckets; i++) {
+    if (buckets[i] == 0) {
+      continue;
+    }
+    EventShenandoahPacingDelay evt;
+    if (evt.should_commit()) {
+      evt.set_gcId(GCId::current_or_undefined());
+      evt.set_minDelay(i == 0 ? 0 : ((jlong)1 << (i - 1)));
+      evt.set_maxDelay(i == num_buckets - 1 ? max_jlong : ((jlong)1 << i));
+      evt.set_count(buckets[i]);
+      evt.commit();
+    }
+  }
+}
+
 class ShenandoahDumpHeapRegionInfoClosure : public ShenandoahHeapRegionClosure {
 public:
   virtual void heap_region_do(ShenandoahHeapRegion* r) {
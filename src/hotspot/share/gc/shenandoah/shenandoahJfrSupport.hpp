@@ -36,6 +36,10 @@ public:
 class ShenandoahJFRSupport {
 public:
   static void register_jfr_type_serializers();
+
+  // Sends one ShenandoahPacingDelay event per non-empty bucket of the
+  // power-of-two millisecond histogram collected by ShenandoahPacer.
+  static void send_pacing_delay_histogram(const size_t* buckets, uint num_buckets);
 };
 
 #endif // SHARE_VM_GC_SHENANDOAH_SHENANDOAHJFRSUPPORT_HPP
@@ -26,6 +26,7 @@
 
 #include "gc/shenandoah/shenandoahFreeSet.hpp"
 #include "gc/shenandoah/shenandoahHeap.inline.hpp"
+#include "gc/shenandoah/shenandoahJfrSupport.hpp"
 #include "gc/shenandoah/shenandoahPacer.hpp"
 #include "gc/shenandoah/shenandoahPhaseTimings.hpp"
 #include "runtime/atomic.hpp"
@@ -182,6 +183,8 @@ void ShenandoahPacer::restart_with(size_t non_taxable_bytes, double tax_rate) {
   STATIC_ASSERT(sizeof(size_t) <= sizeof(intptr_t));
   Atomic::xchg(&_budget, (intptr_t)initial, memory_order_relaxed);
   Atomic::store(&_tax_rate, tax_rate);
+  Atomic::store(&_epoch_alloc_words, (size_t)0);
+  Atomic::store(&_epoch_alloc_threads, (size_t)0);
   Atomic::inc(&_epoch);
 
   // Shake up stalled waiters after budget update.
@@ -222,9 +225,50 @@ intptr_t ShenandoahPacer::epoch() {
   return Atomic::load(&_epoch);
 }
 
+double ShenandoahPacer::record_thread_alloc(JavaThread* thread, size_t words) {
+  // Account the allocation to the thread and to the epoch. Threads track
+  // the epoch they last allocated in, and start over when it changes.
+  intptr_t epoch = Atomic::load(&_epoch);
+  size_t thread_words = words;
+  if (ShenandoahThreadLocalData::pacing_epoch(thread) != epoch) {
+    ShenandoahThreadLocalData::set_pacing_epoch(thread, epoch);
+    Atomic::inc(&_epoch_alloc_threads, memory_order_relaxed);
+  } else {
+    thread_words += ShenandoahThreadLocalData::pacing_alloc_words(thread);
+  }
+  ShenandoahThreadLocalData::set_pacing_alloc_words(thread, thread_words);
+
+  size_t total_words = Atomic::add(&_epoch_alloc_words, words, memory_order_relaxed);
+  size_t threads = MAX2<size_t>(1, Atomic::load(&_epoch_alloc_threads));
+
+  // Share of this thread relative to the average allocating thread. The
+  // counters are reset racily on epoch change, so guard against a stale
+  // total that is smaller than the thread's own allocations.
+  return 1.0 * thread_words * threads / MAX2(total_words, thread_words);
+}
+
+void ShenandoahPacer::record_delay(double delay_ms) {
+  uint bucket = 0;
+  for (size_t ms = (size_t)delay_ms; ms > 0 && bucket < DelayHistogramBuckets - 1; ms >>= 1) {
+    bucket++;
+  }
+  Atomic::inc(&_delay_histogram[bucket], memory_order_relaxed);
+}
+
 void ShenandoahPacer::pace_for_alloc(size_t words) {
   assert(ShenandoahPacing, "Only be here when pacing is enabled");
 
+  JavaThread* const thread = JavaThread::current();
+  size_t max_ms = ShenandoahPacingMaxDelay;
+
+  if (ShenandoahPacingPerThread) {
+    // Distribute the stall in proportion to the allocations: threads that
+    // allocated less than the average in this epoch wait for a
+    // proportionally shorter time, heavy allocators wait for the full delay.
+    double share = record_thread_alloc(thread, words);
+    max_ms = (size_t)(max_ms * MIN2(1.0, share));
+  }
+
   // Fast path: try to allocate right away
   bool claimed = claim_for_alloc(words, false);
   if (claimed) {
@@ -241,13 +285,17 @@ void ShenandoahPacer::pace_for_alloc(size_t words) {
   // Threads that are attaching should not block at all: they are not
   // fully initialized yet. Blocking them would be awkward.
   // This is probably the path that allocates the thread oop itself.
-  if (JavaThread::current()->is_attaching_via_jni()) {
+  if (thread->is_attaching_via_jni()) {
+    return;
+  }
+
+  if (max_ms == 0) {
+    // This thread's share of the delay rounds down to nothing
     return;
   }
 
   double start = os::elapsedTime();
 
-  size_t max_ms = ShenandoahPacingMaxDelay;
   size_t total_ms = 0;
 
   while (true) {
@@ -264,7 +312,8 @@ void ShenandoahPacer::pace_for_alloc(size_t words) {
       //     Breaking out and allocating anyway, which may mean we outpace GC,
       //     and start Degenerated GC cycle.
       //  b) The budget had been replenished, which means our claim is satisfied.
-      ShenandoahThreadLocalData::add_paced_time(JavaThread::current(), end - start);
+      ShenandoahThreadLocalData::add_paced_time(thread, end - start);
+      record_delay((end - start) * 1000);
       break;
     }
   }
@@ -292,6 +341,12 @@ void ShenandoahPacer::flush_stats_to_cycle() {
     sum += ShenandoahThreadLocalData::paced_time(t);
   }
   ShenandoahHeap::heap()->phase_timings()->record_phase_time(ShenandoahPhaseTimings::pacing, sum);
+
+  size_t histogram[DelayHistogramBuckets];
+  for (uint i = 0; i < DelayHistogramBuckets; i++) {
+    histogram[i] = Atomic::xchg(&_delay_histogram[i], (size_t)0);
+  }
+  ShenandoahJFRSupport::send_pacing_delay_histogram(histogram, DelayHistogramBuckets);
 }
 
 void ShenandoahPacer::print_cycle_on(outputStream* out) {
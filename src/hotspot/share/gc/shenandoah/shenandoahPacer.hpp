@@ -41,6 +41,11 @@ class ShenandoahHeap;
  * credit, allocating thread spend the credit, or stall when credit is not available.
  */
 class ShenandoahPacer : public CHeapObj<mtGC> {
+public:
+  // Pacing delays are counted in power-of-two millisecond buckets:
+  // [0, 1), [1, 2), [2, 4), ..., with the last bucket open-ended.
+  static const uint DelayHistogramBuckets = 12;
+
 private:
   ShenandoahHeap* _heap;
   double _last_time;
@@ -62,6 +67,14 @@ private:
   volatile intptr_t _progress;
   shenandoah_padding(3);
 
+  // Allocations in the current epoch, used by ShenandoahPacingPerThread
+  shenandoah_padding(4);
+  volatile size_t _epoch_alloc_words;
+  volatile size_t _epoch_alloc_threads;
+  shenandoah_padding(5);
+
+  volatile size_t _delay_histogram[DelayHistogramBuckets];
+
 public:
   ShenandoahPacer(ShenandoahHeap* heap) :
           _heap(heap),
@@ -71,7 +84,13 @@ public:
           _epoch(0),
           _tax_rate(1),
           _budget(0),
-          _progress(PACING_PROGRESS_UNINIT) {}
+          _progress(PACING_PROGRESS_UNINIT),
+          _epoch_alloc_words(0),
+          _epoch_alloc_threads(0) {
+    for (uint i = 0; i < DelayHistogramBuckets; i++) {
+      _delay_histogram[i] = 0;
+    }
+  }
 
   void setup_for_idle();
   void setup_for_mark();
@@ -106,6 +125,9 @@ private:
 
   size_t update_and_get_progress_history();
 
+  double record_thread_alloc(JavaThread* thread, size_t words);
+  void record_delay(double delay_ms);
+
   void wait(size_t time_ms);
 };
 
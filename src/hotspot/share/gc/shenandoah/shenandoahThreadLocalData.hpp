@@ -50,6 +50,8 @@ private:
   uint  _worker_id;
   int  _disarmed_value;
   double _paced_time;
+  intptr_t _pacing_epoch;
+  size_t _pacing_alloc_words;
 
   ShenandoahThreadLocalData() :
     _gc_state(0),
@@ -60,7 +62,9 @@ private:
     _gclab_size(0),
     _worker_id(INVALID_WORKER_ID),
     _disarmed_value(0),
-    _paced_time(0) {
+    _paced_time(0),
+    _pacing_epoch(0),
+    _pacing_alloc_words(0) {
 
     // At least on x86_64, nmethod entry barrier encodes _disarmed_value offset
     // in instruction as disp8 immed
@@ -145,6 +149,22 @@ public:
     data(thread)->_paced_time = 0;
   }
 
+  static intptr_t pacing_epoch(Thread* thread) {
+    return data(thread)->_pacing_epoch;
+  }
+
+  static void set_pacing_epoch(Thread* thread, intptr_t epoch) {
+    data(thread)->_pacing_epoch = epoch;
+  }
+
+  static size_t pacing_alloc_words(Thread* thread) {
+    return data(thread)->_pacing_alloc_words;
+  }
+
+  static void set_pacing_alloc_words(Thread* thread, size_t words) {
+    data(thread)->_pacing_alloc_words = words;
+  }
+
   static void set_disarmed_value(Thread* thread, int value) {
     data(thread)->_disarmed_value = value;
   }
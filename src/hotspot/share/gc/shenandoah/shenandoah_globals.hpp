@@ -255,6 +255,11 @@
           "GC effectively stall the threads indefinitely instead of going " \
           "to degenerated or Full GC.")                                     \
                                                                             \
+  product(bool, ShenandoahPacingPerThread, false, EXPERIMENTAL,             \
+          "Scale the pacing delay of each thread by its share of the "      \
+          "allocations in the current pacing phase, so that threads that "  \
+          "allocate little are not stalled along with heavy allocators.")   \
+                                                                            \
   product(uintx, ShenandoahPacingIdleSlack, 2, EXPERIMENTAL,                \
           "How much of heap counted as non-taxable allocations during idle "\
           "phases. Larger value makes the pacing milder when collector is " \
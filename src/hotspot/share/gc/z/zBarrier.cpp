@@ -23,6 +23,7 @@
 
 #include "precompiled.hpp"
 #include "classfile/javaClasses.hpp"
+#include "gc/shared/gc_globals.hpp"
 #include "gc/z/zBarrier.inline.hpp"
 #include "gc/z/zHeap.inline.hpp"
 #include "gc/z/zOop.inline.hpp"
@@ -127,7 +128,15 @@ uintptr_t ZBarrier::relocate_or_remap(uintptr_t addr) {
 // Load barrier
 //
 uintptr_t ZBarrier::load_barrier_on_oop_slow_path(uintptr_t addr) {
-  return relocate_or_mark(addr);
+  const uintptr_t good_addr = relocate_or_mark(addr);
+
+  if (ZRelocateHotObjectsApart && during_mark() && !ZThread::is_worker()) {
+    // Remember the objects the application loads during marking, so that
+    // relocation can place them apart from the other survivors.
+    ZHeap::heap()->mark_object_hot(good_addr);
+  }
+
+  return good_addr;
 }
 
 uintptr_t ZBarrier::load_barrier_on_invisible_root_oop_slow_path(uintptr_t addr) {
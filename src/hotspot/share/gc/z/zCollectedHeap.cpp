@@ -206,6 +206,14 @@ void ZCollectedHeap::do_full_collection(bool clear_all_soft_refs) {
   ShouldNotReachHere();
 }
 
+void ZCollectedHeap::finish_collection() {
+  uncommit_unused_memory();
+}
+
+void ZCollectedHeap::uncommit_unused_memory() {
+  _heap.uncommit_unused();
+}
+
 size_t ZCollectedHeap::tlab_capacity(Thread* ignored) const {
   return _heap.tlab_capacity();
 }
@@ -52,6 +52,12 @@ static void sample_allocation_rate() {
                        ZStatAllocRate::sd() / M);
 }
 
+static double spike_tolerance() {
+  // The boost is 1.0 unless ZAdaptiveSpikeTolerance is enabled and
+  // recent cycles were triggered by allocation stalls.
+  return ZAllocationSpikeTolerance * ZStatCycle::spike_tolerance_boost();
+}
+
 static ZDriverRequest rule_allocation_stall() {
   // Perform GC if we've observed at least one allocation stall since
   // the last GC started.
@@ -191,7 +197,7 @@ ZDriverRequest rule_allocation_rate_dynamic() {
   const double alloc_rate_avg = ZStatAllocRate::avg();
   const double alloc_rate_sd = ZStatAllocRate::sd();
   const double alloc_rate_sd_percent = alloc_rate_sd / (alloc_rate_avg + 1.0);
-  const double alloc_rate = (MAX2(alloc_rate_predict, alloc_rate_avg) * ZAllocationSpikeTolerance) + (alloc_rate_sd * one_in_1000) + 1.0;
+  const double alloc_rate = (MAX2(alloc_rate_predict, alloc_rate_avg) * spike_tolerance()) + (alloc_rate_sd * one_in_1000) + 1.0;
   const double time_until_oom = (free / alloc_rate) / (1.0 + alloc_rate_sd_percent);
 
   // Calculate max serial/parallel times of a GC cycle. The times are
@@ -215,10 +221,11 @@ ZDriverRequest rule_allocation_rate_dynamic() {
   const double time_until_gc = time_until_oom - actual_gc_duration - sample_interval;
 
   log_debug(gc, director)("Rule: Allocation Rate (Dynamic GC Workers), "
-                          "MaxAllocRate: %.1fMB/s (+/-%.1f%%), Free: " SIZE_FORMAT "MB, GCCPUTime: %.3f, "
+                          "MaxAllocRate: %.1fMB/s (+/-%.1f%%), SpikeTolerance: %.2f, Free: " SIZE_FORMAT "MB, GCCPUTime: %.3f, "
                           "GCDuration: %.3fs, TimeUntilOOM: %.3fs, TimeUntilGC: %.3fs, GCWorkers: %u -> %u",
                           alloc_rate / M,
                           alloc_rate_sd_percent * 100,
+                          spike_tolerance(),
                           free / M,
                           serial_gc_time + parallelizable_gc_time,
                           serial_gc_time + (parallelizable_gc_time / actual_gc_workers),
@@ -259,7 +266,7 @@ static ZDriverRequest rule_allocation_rate_static() {
   // phase changes in the allocate rate. We then add ~3.3 sigma to account for
   // the allocation rate variance, which means the probability is 1 in 1000
   // that a sample is outside of the confidence interval.
-  const double max_alloc_rate = (ZStatAllocRate::avg() * ZAllocationSpikeTolerance) + (ZStatAllocRate::sd() * one_in_1000);
+  const double max_alloc_rate = (ZStatAllocRate::avg() * spike_tolerance()) + (ZStatAllocRate::sd() * one_in_1000);
   const double time_until_oom = free / (max_alloc_rate + 1.0); // Plus 1.0B/s to avoid division by zero
 
   // Calculate max serial/parallel times of a GC cycle. The times are
@@ -275,8 +282,8 @@ static ZDriverRequest rule_allocation_rate_static() {
   // time and end up starting the GC too late in the next interval.
   const double time_until_gc = time_until_oom - gc_duration - sample_interval;
 
-  log_debug(gc, director)("Rule: Allocation Rate (Static GC Workers), MaxAllocRate: %.1fMB/s, Free: " SIZE_FORMAT "MB, GCDuration: %.3fs, TimeUntilGC: %.3fs",
-                          max_alloc_rate / M, free / M, gc_duration, time_until_gc);
+  log_debug(gc, director)("Rule: Allocation Rate (Static GC Workers), MaxAllocRate: %.1fMB/s, SpikeTolerance: %.2f, Free: " SIZE_FORMAT "MB, GCDuration: %.3fs, TimeUntilGC: %.3fs",
+                          max_alloc_rate / M, spike_tolerance(), free / M, gc_duration, time_until_gc);
 
   if (time_until_gc > 0) {
     return GCCause::_no_gc;
@@ -365,6 +372,23 @@ static ZDriverRequest rule_proactive() {
   return GCCause::_z_proactive;
 }
 
+static void request_pre_commit() {
+  if (!ZPreCommit || !ZStatCycle::is_time_trustable()) {
+    return;
+  }
+
+  // Keep enough committed and pre-touched memory in the page cache to cover
+  // the predicted allocations of the next two sample intervals, bounded by
+  // the memory still available below the soft max capacity.
+  const size_t soft_max_capacity = ZHeap::heap()->soft_max_capacity();
+  const size_t used = ZHeap::heap()->used();
+  const size_t available = soft_max_capacity - MIN2(soft_max_capacity, used);
+  const double alloc_rate = MAX2(ZStatAllocRate::predict(), ZStatAllocRate::avg());
+  const size_t reserve = MIN2((size_t)(alloc_rate * sample_interval * 2), available);
+
+  ZHeap::heap()->request_pre_commit(reserve);
+}
+
 static ZDriverRequest make_gc_decision() {
   // List of rules
   using ZDirectorRule = ZDriverRequest (*)();
@@ -392,6 +416,7 @@ void ZDirector::run_service() {
   // Main loop
   while (_metronome.wait_for_tick()) {
     sample_allocation_rate();
+    request_pre_commit();
     if (!_driver->is_busy()) {
       const ZDriverRequest request = make_gc_decision();
       if (request.cause() != GCCause::_no_gc) {
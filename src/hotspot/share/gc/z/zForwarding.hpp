@@ -67,6 +67,7 @@ public:
   size_t size() const;
   size_t object_alignment_shift() const;
   void object_iterate(ObjectClosure *cl);
+  bool is_object_hot(uintptr_t addr) const;
 
   bool retain_page();
   ZPage* claim_page();
@@ -83,6 +83,10 @@ inline void ZForwarding::object_iterate(ObjectClosure *cl) {
   return _page->object_iterate(cl);
 }
 
+inline bool ZForwarding::is_object_hot(uintptr_t addr) const {
+  return _page->is_object_hot(addr);
+}
+
 inline void ZForwarding::set_in_place() {
   _in_place = true;
 }
@@ -105,6 +105,18 @@ size_t ZHeap::unused() const {
   return _page_allocator.unused();
 }
 
+void ZHeap::uncommit_unused() {
+  const size_t uncommitted = _page_allocator.uncommit_unused();
+  if (uncommitted > 0) {
+    log_info(gc, heap)("Uncommitted: " SIZE_FORMAT "M(%.0f%%)",
+                       uncommitted / M, percent_of(uncommitted, max_capacity()));
+  }
+}
+
+void ZHeap::request_pre_commit(size_t reserve) {
+  _page_allocator.request_pre_commit(reserve);
+}
+
 size_t ZHeap::tlab_capacity() const {
   return capacity();
 }
@@ -420,9 +432,6 @@ void ZHeap::relocate_start() {
 
   // Update statistics
   ZStatHeap::set_at_relocate_start(_page_allocator.stats());
-
-  // Notify JVMTI
-  JvmtiTagMap::set_needs_rehashing();
 }
 
 void ZHeap::relocate() {
@@ -84,6 +84,9 @@ public:
   size_t used() const;
   size_t unused() const;
 
+  void uncommit_unused();
+  void request_pre_commit(size_t reserve);
+
   size_t tlab_capacity() const;
   size_t tlab_used() const;
   size_t max_tlab_size() const;
@@ -122,6 +125,7 @@ public:
   bool is_object_live(uintptr_t addr) const;
   bool is_object_strongly_live(uintptr_t addr) const;
   template <bool gc_thread, bool follow, bool finalizable, bool publish> void mark_object(uintptr_t addr);
+  void mark_object_hot(uintptr_t addr);
   void mark_start();
   void mark(bool initial);
   void mark_flush_and_free(Thread* thread);
@@ -58,6 +58,11 @@ inline bool ZHeap::is_object_strongly_live(uintptr_t addr) const {
   return page->is_object_strongly_live(addr);
 }
 
+inline void ZHeap::mark_object_hot(uintptr_t addr) {
+  ZPage* page = _page_table.get(addr);
+  page->mark_object_hot(addr);
+}
+
 template <bool gc_thread, bool follow, bool finalizable, bool publish>
 inline void ZHeap::mark_object(uintptr_t addr) {
   assert(ZGlobalPhase == ZPhaseMark, "Mark not allowed");
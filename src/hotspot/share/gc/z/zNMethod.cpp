@@ -54,7 +54,7 @@ static void set_gc_data(nmethod* nm, ZNMethodData* data) {
 }
 
 void ZNMethod::attach_gc_data(nmethod* nm) {
-  GrowableArray<oop*> immediate_oops;
+  GrowableArrayWithInline<oop*, 8> immediate_oops;
   bool non_immediate_oops = false;
 
   // Find all oop relocations
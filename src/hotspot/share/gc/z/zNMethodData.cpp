@@ -31,7 +31,7 @@
 #include "utilities/debug.hpp"
 #include "utilities/growableArray.hpp"
 
-ZNMethodDataOops* ZNMethodDataOops::create(const GrowableArray<oop*>& immediates, bool has_non_immediates) {
+ZNMethodDataOops* ZNMethodDataOops::create(const GrowableArrayView<oop*>& immediates, bool has_non_immediates) {
   return ::new (AttachedArray::alloc(immediates.length())) ZNMethodDataOops(immediates, has_non_immediates);
 }
 
@@ -39,7 +39,7 @@ void ZNMethodDataOops::destroy(ZNMethodDataOops* oops) {
   AttachedArray::free(oops);
 }
 
-ZNMethodDataOops::ZNMethodDataOops(const GrowableArray<oop*>& immediates, bool has_non_immediates) :
+ZNMethodDataOops::ZNMethodDataOops(const GrowableArrayView<oop*>& immediates, bool has_non_immediates) :
     _immediates(immediates.length()),
     _has_non_immediates(has_non_immediates) {
   // Save all immediate oops
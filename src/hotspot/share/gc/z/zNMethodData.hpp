@@ -31,7 +31,7 @@
 #include "utilities/globalDefinitions.hpp"
 
 class nmethod;
-template <typename T> class GrowableArray;
+template <typename T> class GrowableArrayView;
 
 class ZNMethodDataOops {
 private:
@@ -40,10 +40,10 @@ private:
   const AttachedArray _immediates;
   const bool          _has_non_immediates;
 
-  ZNMethodDataOops(const GrowableArray<oop*>& immediates, bool has_non_immediates);
+  ZNMethodDataOops(const GrowableArrayView<oop*>& immediates, bool has_non_immediates);
 
 public:
-  static ZNMethodDataOops* create(const GrowableArray<oop*>& immediates, bool has_non_immediates);
+  static ZNMethodDataOops* create(const GrowableArrayView<oop*>& immediates, bool has_non_immediates);
   static void destroy(ZNMethodDataOops* oops);
 
   size_t immediates_count() const;
@@ -22,10 +22,12 @@
  */
 
 #include "precompiled.hpp"
+#include "gc/shared/gc_globals.hpp"
 #include "gc/z/zList.inline.hpp"
 #include "gc/z/zPage.inline.hpp"
 #include "gc/z/zPhysicalMemory.inline.hpp"
 #include "gc/z/zVirtualMemory.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "utilities/align.hpp"
 #include "utilities/debug.hpp"
 
@@ -39,13 +41,18 @@ ZPage::ZPage(uint8_t type, const ZVirtualMemory& vmem, const ZPhysicalMemory& pm
     _virtual(vmem),
     _top(start()),
     _livemap(object_max_count()),
+    _hot(NULL),
+    _hot_seqnum(0),
     _last_used(0),
     _physical(pmem),
     _node() {
   assert_initialized();
+  resize_hot();
 }
 
-ZPage::~ZPage() {}
+ZPage::~ZPage() {
+  delete _hot;
+}
 
 void ZPage::assert_initialized() const {
   assert(!_virtual.is_null(), "Should not be null");
@@ -73,6 +80,7 @@ ZPage* ZPage::retype(uint8_t type) {
   assert(_type != type, "Invalid retype");
   _type = type;
   _livemap.resize(object_max_count());
+  resize_hot();
   return this;
 }
 
@@ -89,6 +97,7 @@ ZPage* ZPage::split(uint8_t type, size_t size) {
   _type = type_from_size(_virtual.size());
   _top = start();
   _livemap.resize(object_max_count());
+  resize_hot();
 
   // Create new page, inherit _seqnum and _last_used
   ZPage* const page = new ZPage(type, vmem, pmem);
@@ -113,11 +122,40 @@ ZPage* ZPage::split_committed() {
   _type = type_from_size(_virtual.size());
   _top = start();
   _livemap.resize(object_max_count());
+  resize_hot();
 
   // Create new page
   return new ZPage(vmem, pmem);
 }
 
+// Only small pages track hot objects. The map is allocated with the page,
+// rather than when first marking, to keep allocation out of the barriers.
+void ZPage::resize_hot() {
+  delete _hot;
+  _hot = NULL;
+  _hot_seqnum = 0;
+  if (ZRelocateHotObjectsApart && _type == ZPageTypeSmall) {
+    _hot = new CHeapBitMap(object_max_count(), mtGC, false /* clear */);
+  }
+}
+
+void ZPage::reset_hot() {
+  const uint32_t seqnum_initializing = (uint32_t)-1;
+
+  // Multiple threads can enter here, make sure only one of them
+  // clears the hot bits while the others busy wait.
+  for (uint32_t seqnum = Atomic::load_acquire(&_hot_seqnum);
+       seqnum != ZGlobalSeqNum;
+       seqnum = Atomic::load_acquire(&_hot_seqnum)) {
+    if ((seqnum != seqnum_initializing) &&
+        (Atomic::cmpxchg(&_hot_seqnum, seqnum, seqnum_initializing) == seqnum)) {
+      _hot->clear_large();
+      Atomic::release_store(&_hot_seqnum, ZGlobalSeqNum);
+      break;
+    }
+  }
+}
+
 void ZPage::print_on(outputStream* out) const {
   out->print_cr(" %-6s  " PTR_FORMAT " " PTR_FORMAT " " PTR_FORMAT " %s%s",
                 type_to_string(), start(), top(), end(),
@@ -29,6 +29,7 @@
 #include "gc/z/zPhysicalMemory.hpp"
 #include "gc/z/zVirtualMemory.hpp"
 #include "memory/allocation.hpp"
+#include "utilities/bitMap.hpp"
 
 class ZPage : public CHeapObj<mtGC> {
   friend class VMStructs;
@@ -41,6 +42,8 @@ private:
   ZVirtualMemory     _virtual;
   volatile uintptr_t _top;
   ZLiveMap           _livemap;
+  CHeapBitMap*       _hot;
+  volatile uint32_t  _hot_seqnum;
   uint64_t           _last_used;
   ZPhysicalMemory    _physical;
   ZListNode<ZPage>   _node;
@@ -53,6 +56,9 @@ private:
   bool is_object_marked(uintptr_t addr) const;
   bool is_object_strongly_marked(uintptr_t addr) const;
 
+  void resize_hot();
+  void reset_hot();
+
 public:
   ZPage(const ZVirtualMemory& vmem, const ZPhysicalMemory& pmem);
   ZPage(uint8_t type, const ZVirtualMemory& vmem, const ZPhysicalMemory& pmem);
@@ -97,6 +103,9 @@ public:
   bool is_object_strongly_live(uintptr_t addr) const;
   bool mark_object(uintptr_t addr, bool finalizable, bool& inc_live);
 
+  void mark_object_hot(uintptr_t addr);
+  bool is_object_hot(uintptr_t addr) const;
+
   void inc_live(uint32_t objects, size_t bytes);
   uint32_t live_objects() const;
   size_t live_bytes() const;
@@ -206,6 +206,32 @@ inline bool ZPage::mark_object(uintptr_t addr, bool finalizable, bool& inc_live)
   return _livemap.set(index, finalizable, inc_live);
 }
 
+inline void ZPage::mark_object_hot(uintptr_t addr) {
+  if (_hot == NULL || !is_relocatable()) {
+    // Not tracked, or allocated in this cycle and not a relocation candidate
+    return;
+  }
+
+  if (Atomic::load_acquire(&_hot_seqnum) != ZGlobalSeqNum) {
+    reset_hot();
+  }
+
+  const size_t index = (ZAddress::offset(addr) - start()) >> object_alignment_shift();
+  if (!_hot->at(index)) {
+    _hot->par_set_bit(index);
+  }
+}
+
+inline bool ZPage::is_object_hot(uintptr_t addr) const {
+  if (_hot == NULL || Atomic::load_acquire(&_hot_seqnum) != ZGlobalSeqNum) {
+    // Not tracked, or no object marked hot in this cycle
+    return false;
+  }
+
+  const size_t index = (ZAddress::offset(addr) - start()) >> object_alignment_shift();
+  return _hot->at(index);
+}
+
 inline void ZPage::inc_live(uint32_t objects, size_t bytes) {
   _livemap.inc_live(objects, bytes);
 }
@@ -32,6 +32,7 @@
 #include "gc/z/zPage.inline.hpp"
 #include "gc/z/zPageAllocator.inline.hpp"
 #include "gc/z/zPageCache.hpp"
+#include "gc/z/zPreCommitter.hpp"
 #include "gc/z/zSafeDelete.inline.hpp"
 #include "gc/z/zStat.hpp"
 #include "gc/z/zTask.hpp"
@@ -48,6 +49,7 @@
 
 static const ZStatCounter       ZCounterAllocationRate("Memory", "Allocation Rate", ZStatUnitBytesPerSecond);
 static const ZStatCounter       ZCounterPageCacheFlush("Memory", "Page Cache Flush", ZStatUnitBytesPerSecond);
+static const ZStatCounter       ZCounterPageCacheMiss("Memory", "Page Cache Miss", ZStatUnitOpsPerSecond);
 static const ZStatCriticalPhase ZCriticalPhaseAllocationStall("Allocation Stall");
 
 enum ZPageAllocationStall {
@@ -149,6 +151,7 @@ ZPageAllocator::ZPageAllocator(ZWorkers* workers,
     _satisfied(),
     _unmapper(new ZUnmapper(this)),
     _uncommitter(new ZUncommitter(this)),
+    _precommitter(new ZPreCommitter(this)),
     _safe_delete(),
     _initialized(false) {
 
@@ -661,6 +664,11 @@ retry:
     ZStatInc(ZStatAllocRate::counter(), bytes);
   }
 
+  // Count allocations that had to commit memory on the allocating thread
+  if (allocation.committed() > 0) {
+    ZStatInc(ZCounterPageCacheMiss);
+  }
+
   // Send event
   event.commit(type, size, allocation.flushed(), allocation.committed(),
                page->physical_memory().nsegments(), flags.non_blocking());
@@ -724,7 +732,7 @@ void ZPageAllocator::free_pages(const ZArray<ZPage*>* pages, bool reclaimed) {
   satisfy_stalled();
 }
 
-size_t ZPageAllocator::uncommit(uint64_t* timeout) {
+size_t ZPageAllocator::uncommit(uint64_t* timeout, bool ignore_delay) {
   // We need to join the suspendible thread set while manipulating capacity and
   // used, to make sure GC safepoints will have a consistent view. However, when
   // ZVerifyViews is enabled we need to join at a broader scope to also make sure
@@ -747,7 +755,7 @@ size_t ZPageAllocator::uncommit(uint64_t* timeout) {
     const size_t flush = MIN2(release, limit);
 
     // Flush pages to uncommit
-    flushed = _cache.flush_for_uncommit(flush, &pages, timeout);
+    flushed = _cache.flush_for_uncommit(flush, &pages, timeout, ignore_delay);
     if (flushed == 0) {
       // Nothing flushed
       return 0;
@@ -777,6 +785,105 @@ size_t ZPageAllocator::uncommit(uint64_t* timeout) {
   return flushed;
 }
 
+size_t ZPageAllocator::pre_commit(size_t reserve) {
+  // Join the suspendible thread set for the same reasons as in uncommit()
+  SuspendibleThreadSetJoiner joiner(ZVerifyViews);
+  size_t size;
+
+  {
+    SuspendibleThreadSetJoiner joiner(!ZVerifyViews);
+    ZLocker<ZLock> locker(&_lock);
+
+    // Memory in the page cache is committed, mapped and unused. Pre-commit
+    // chunks of at most 64M until the cache holds the requested reserve,
+    // so that allocating threads are not kept waiting on the lock.
+    const size_t cached = _capacity - _used - _claimed;
+    if (cached >= reserve) {
+      // Nothing to do
+      return 0;
+    }
+
+    const size_t limit = MIN2(align_up(reserve - cached, ZGranuleSize), 64 * M);
+    size = increase_capacity(limit);
+    if (size == 0) {
+      // At max capacity
+      return 0;
+    }
+
+    // Record the new capacity as claimed until it is in the page cache
+    Atomic::add(&_claimed, size);
+  }
+
+  ZPage* page = NULL;
+  bool commit_failed = false;
+  const ZVirtualMemory vmem = _virtual.alloc(size, false /* force_low_address */);
+  if (!vmem.is_null()) {
+    ZPhysicalMemory pmem;
+    _physical.alloc(pmem, size);
+    ZPage* const new_page = new ZPage(vmem, pmem);
+
+    if (commit_page(new_page)) {
+      page = new_page;
+    } else {
+      // Keep any successfully committed part of the page
+      commit_failed = true;
+      page = new_page->split_committed();
+      destroy_page(new_page);
+    }
+
+    if (page != NULL) {
+      // Map and pre-touch, so that the first allocation in this memory
+      // does not take the page faults
+      map_page(page);
+      _physical.pretouch(page->start(), page->size());
+    }
+  }
+
+  const size_t committed = (page != NULL) ? page->size() : 0;
+
+  {
+    SuspendibleThreadSetJoiner joiner(!ZVerifyViews);
+    ZLocker<ZLock> locker(&_lock);
+
+    Atomic::sub(&_claimed, size);
+
+    if (committed < size) {
+      // Adjust capacity to reflect the failed capacity increase. Only a
+      // failed commit lowers the max capacity, running out of address
+      // space does not.
+      decrease_capacity(size - committed, commit_failed /* set_max_capacity */);
+    }
+
+    if (page != NULL) {
+      // Cache page
+      page->set_last_used();
+      _cache.free_page(page);
+    }
+
+    // Try satisfy stalled allocations
+    satisfy_stalled();
+  }
+
+  return committed;
+}
+
+void ZPageAllocator::request_pre_commit(size_t reserve) {
+  _precommitter->request(reserve);
+}
+
+size_t ZPageAllocator::uncommit_unused() {
+  if (!ZUncommit) {
+    return 0;
+  }
+
+  uint64_t timeout;
+  size_t uncommitted = 0;
+  for (size_t flushed; (flushed = uncommit(&timeout, true /* ignore_delay */)) > 0;) {
+    uncommitted += flushed;
+  }
+  return uncommitted;
+}
+
 void ZPageAllocator::enable_deferred_delete() const {
   _safe_delete.enable_deferred_delete();
 }
@@ -835,4 +942,5 @@ void ZPageAllocator::check_out_of_memory() {
 void ZPageAllocator::threads_do(ThreadClosure* tc) const {
   tc->do_thread(_unmapper);
   tc->do_thread(_uncommitter);
+  tc->do_thread(_precommitter);
 }
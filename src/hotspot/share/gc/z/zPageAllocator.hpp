@@ -36,6 +36,7 @@
 class ThreadClosure;
 class ZPageAllocation;
 class ZPageAllocatorStats;
+class ZPreCommitter;
 class ZWorkers;
 class ZUncommitter;
 class ZUnmapper;
@@ -43,6 +44,7 @@ class ZUnmapper;
 class ZPageAllocator {
   friend class VMStructs;
   friend class ZUnmapper;
+  friend class ZPreCommitter;
   friend class ZUncommitter;
 
 private:
@@ -64,6 +66,7 @@ private:
   ZList<ZPageAllocation>     _satisfied;
   ZUnmapper*                 _unmapper;
   ZUncommitter*              _uncommitter;
+  ZPreCommitter*             _precommitter;
   mutable ZSafeDelete<ZPage> _safe_delete;
   bool                       _initialized;
 
@@ -97,7 +100,8 @@ private:
 
   void free_page_inner(ZPage* page, bool reclaimed);
 
-  size_t uncommit(uint64_t* timeout);
+  size_t uncommit(uint64_t* timeout, bool ignore_delay = false);
+  size_t pre_commit(size_t reserve);
 
 public:
   ZPageAllocator(ZWorkers* workers,
@@ -122,6 +126,9 @@ public:
   void free_page(ZPage* page, bool reclaimed);
   void free_pages(const ZArray<ZPage*>* pages, bool reclaimed);
 
+  size_t uncommit_unused();
+  void request_pre_commit(size_t reserve);
+
   void enable_deferred_delete() const;
   void disable_deferred_delete() const;
 
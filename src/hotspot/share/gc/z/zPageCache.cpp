@@ -307,8 +307,9 @@ public:
   }
 };
 
-size_t ZPageCache::flush_for_uncommit(size_t requested, ZList<ZPage>* to, uint64_t* timeout) {
-  const uint64_t now = os::elapsedTime();
+size_t ZPageCache::flush_for_uncommit(size_t requested, ZList<ZPage>* to, uint64_t* timeout, bool ignore_delay) {
+  // Pretending all pages expired long ago flushes them regardless of ZUncommitDelay
+  const uint64_t now = ignore_delay ? max_uintx : (uint64_t)os::elapsedTime();
   const uint64_t expires = _last_commit + ZUncommitDelay;
   if (expires > now) {
     // Delay uncommit, set next timeout
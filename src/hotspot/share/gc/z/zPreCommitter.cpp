@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc/shared/gc_globals.hpp"
+#include "gc/z/zHeap.inline.hpp"
+#include "gc/z/zLock.inline.hpp"
+#include "gc/z/zPreCommitter.hpp"
+#include "gc/z/zStat.hpp"
+#include "logging/log.hpp"
+
+static const ZStatCounter ZCounterPreCommit("Memory", "Pre-commit", ZStatUnitBytesPerSecond);
+
+ZPreCommitter::ZPreCommitter(ZPageAllocator* page_allocator) :
+    _page_allocator(page_allocator),
+    _lock(),
+    _reserve(0),
+    _stop(false) {
+  set_name("ZPreCommitter");
+  create_and_start();
+}
+
+bool ZPreCommitter::wait(size_t* reserve) {
+  ZLocker<ZConditionLock> locker(&_lock);
+  while (_reserve == 0 && !_stop) {
+    _lock.wait();
+  }
+
+  *reserve = _reserve;
+  _reserve = 0;
+
+  return !_stop;
+}
+
+bool ZPreCommitter::should_continue() const {
+  ZLocker<ZConditionLock> locker(&_lock);
+  return !_stop;
+}
+
+void ZPreCommitter::run_service() {
+  size_t reserve;
+
+  while (wait(&reserve)) {
+    size_t precommitted = 0;
+
+    while (should_continue()) {
+      // Pre-commit chunk
+      const size_t committed = _page_allocator->pre_commit(reserve);
+      if (committed == 0) {
+        // Done
+        break;
+      }
+
+      precommitted += committed;
+    }
+
+    if (precommitted > 0) {
+      // Update statistics
+      ZStatInc(ZCounterPreCommit, precommitted);
+      log_debug(gc, heap)("Pre-committed: " SIZE_FORMAT "M, Reserve: " SIZE_FORMAT "M",
+                          precommitted / M, reserve / M);
+    }
+  }
+}
+
+void ZPreCommitter::request(size_t reserve) {
+  if (!ZPreCommit || reserve == 0) {
+    return;
+  }
+
+  ZLocker<ZConditionLock> locker(&_lock);
+  _reserve = reserve;
+  _lock.notify_all();
+}
+
+void ZPreCommitter::stop_service() {
+  ZLocker<ZConditionLock> locker(&_lock);
+  _stop = true;
+  _lock.notify_all();
+}
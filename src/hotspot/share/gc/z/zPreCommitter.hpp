@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_GC_Z_ZPRECOMMITTER_HPP
+#define SHARE_GC_Z_ZPRECOMMITTER_HPP
+
+#include "gc/shared/concurrentGCThread.hpp"
+#include "gc/z/zLock.hpp"
+
+class ZPageAllocator;
+
+// Commits, maps and pre-touches memory ahead of demand, so that allocating
+// threads find it in the page cache instead of committing it themselves.
+// The director requests a reserve based on the predicted allocation rate.
+class ZPreCommitter : public ConcurrentGCThread {
+private:
+  ZPageAllocator* const  _page_allocator;
+  mutable ZConditionLock _lock;
+  size_t                 _reserve;
+  bool                   _stop;
+
+  bool wait(size_t* reserve);
+  bool should_continue() const;
+
+protected:
+  virtual void run_service();
+  virtual void stop_service();
+
+public:
+  ZPreCommitter(ZPageAllocator* page_allocator);
+
+  void request(size_t reserve);
+};
+
+#endif // SHARE_GC_Z_ZPRECOMMITTER_HPP
@@ -277,8 +277,26 @@ private:
   Allocator* const _allocator;
   ZForwarding*     _forwarding;
   ZPage*           _target;
+  ZPage*           _hot_target;
 
-  bool relocate_object(uintptr_t from_addr) const {
+  uintptr_t alloc_hot_object(size_t size) {
+    const uintptr_t addr = _allocator->alloc_object(_hot_target, size);
+    if (addr != 0) {
+      return addr;
+    }
+
+    // Start a new hot page. If none is available, the object is
+    // relocated together with the other survivors instead.
+    ZPage* const page = alloc_page(_forwarding);
+    if (page == NULL) {
+      return 0;
+    }
+
+    _hot_target = page;
+    return _allocator->alloc_object(_hot_target, size);
+  }
+
+  bool relocate_object(uintptr_t from_addr) {
     ZForwardingCursor cursor;
 
     // Lookup forwarding
@@ -287,9 +305,21 @@ private:
       return true;
     }
 
-    // Allocate object
+    // Allocate object, in a hot page if the application accessed
+    // it during marking
     const size_t size = ZUtils::object_size(from_addr);
-    const uintptr_t to_addr = _allocator->alloc_object(_target, size);
+    ZPage* target = _target;
+    uintptr_t to_addr = 0;
+    if (ZRelocateHotObjectsApart && !_forwarding->in_place() &&
+        _forwarding->is_object_hot(from_addr)) {
+      to_addr = alloc_hot_object(size);
+      if (to_addr != 0) {
+        target = _hot_target;
+      }
+    }
+    if (to_addr == 0) {
+      to_addr = _allocator->alloc_object(_target, size);
+    }
     if (to_addr == 0) {
       // Allocation failed
       return false;
@@ -306,7 +336,7 @@ private:
     // Insert forwarding
     if (forwarding_insert(_forwarding, from_addr, to_addr, &cursor) != to_addr) {
       // Already relocated, undo allocation
-      _allocator->undo_alloc_object(_target, to_addr, size);
+      _allocator->undo_alloc_object(target, to_addr, size);
     }
 
     return true;
@@ -338,10 +368,14 @@ public:
   ZRelocateClosure(Allocator* allocator) :
       _allocator(allocator),
       _forwarding(NULL),
-      _target(NULL) {}
+      _target(NULL),
+      _hot_target(NULL) {}
 
   ~ZRelocateClosure() {
     _allocator->free_target_page(_target);
+    if (should_free_target_page(_hot_target)) {
+      free_page(_hot_target);
+    }
   }
 
   void do_forwarding(ZForwarding* forwarding) {
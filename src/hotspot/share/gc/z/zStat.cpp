@@ -1067,6 +1067,7 @@ Ticks     ZStatCycle::_end_of_last;
 NumberSeq ZStatCycle::_serial_time(0.7 /* alpha */);
 NumberSeq ZStatCycle::_parallelizable_time(0.7 /* alpha */);
 uint      ZStatCycle::_last_active_workers = 0;
+double    ZStatCycle::_spike_tolerance_boost = 1.0;
 
 void ZStatCycle::at_start() {
   _start_of_last = Ticks::now();
@@ -1081,6 +1082,18 @@ void ZStatCycle::at_end(GCCause::Cause cause, uint active_workers) {
 
   _last_active_workers = active_workers;
 
+  if (ZAdaptiveSpikeTolerance) {
+    // A cycle triggered by an allocation stall means the allocation rate
+    // rule started the previous cycle too late. Double the boost applied
+    // to the spike tolerance, and let it decay back over cycles that
+    // were started in time.
+    if (cause == GCCause::_z_allocation_stall) {
+      _spike_tolerance_boost = MIN2(_spike_tolerance_boost * 2.0, 8.0);
+    } else {
+      _spike_tolerance_boost = MAX2(_spike_tolerance_boost * 0.75, 1.0);
+    }
+  }
+
   // Calculate serial and parallelizable GC cycle times
   const double duration = (_end_of_last - _start_of_last).seconds();
   const double workers_duration = ZStatWorkers::get_and_reset_duration();
@@ -1116,6 +1129,10 @@ uint ZStatCycle::last_active_workers() {
   return _last_active_workers;
 }
 
+double ZStatCycle::spike_tolerance_boost() {
+  return _spike_tolerance_boost;
+}
+
 double ZStatCycle::time_since_last() {
   if (_end_of_last.value() == 0) {
     // No end recorded yet, return time since VM start
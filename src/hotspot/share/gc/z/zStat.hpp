@@ -377,6 +377,7 @@ private:
   static NumberSeq _serial_time;
   static NumberSeq _parallelizable_time;
   static uint      _last_active_workers;
+  static double    _spike_tolerance_boost;
 
 public:
   static void at_start();
@@ -391,6 +392,8 @@ public:
 
   static uint last_active_workers();
 
+  static double spike_tolerance_boost();
+
   static double time_since_last();
 };
 
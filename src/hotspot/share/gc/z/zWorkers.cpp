@@ -24,6 +24,7 @@
 #include "precompiled.hpp"
 #include "gc/shared/gc_globals.hpp"
 #include "gc/shared/gcLogPrecious.hpp"
+#include "gc/shared/workerPolicy.hpp"
 #include "gc/z/zLock.inline.hpp"
 #include "gc/z/zStat.hpp"
 #include "gc/z/zTask.hpp"
@@ -90,6 +91,7 @@ uint ZWorkers::active_workers() const {
 }
 
 void ZWorkers::set_active_workers(uint nworkers) {
+  nworkers = MIN2(nworkers, WorkerPolicy::active_workers_limit());
   log_info(gc, task)("Using %u workers", nworkers);
   _workers.update_active_workers(nworkers);
 }
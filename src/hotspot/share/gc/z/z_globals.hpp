@@ -35,6 +35,10 @@
   product(double, ZAllocationSpikeTolerance, 2.0,                           \
           "Allocation spike tolerance factor")                              \
                                                                             \
+  product(bool, ZAdaptiveSpikeTolerance, false, EXPERIMENTAL,               \
+          "Raise the allocation spike tolerance after cycles triggered by " \
+          "allocation stalls, and let it decay over stall-free cycles")     \
+                                                                            \
   product(double, ZFragmentationLimit, 25.0,                                \
           "Maximum allowed heap fragmentation")                             \
                                                                             \
@@ -48,6 +52,10 @@
   product(bool, ZProactive, true,                                           \
           "Enable proactive GC cycles")                                     \
                                                                             \
+  product(bool, ZPreCommit, false, EXPERIMENTAL,                            \
+          "Commit and pre-touch memory on a background thread ahead of "    \
+          "the predicted allocation rate")                                  \
+                                                                            \
   product(bool, ZUncommit, true,                                            \
           "Uncommit unused memory")                                         \
                                                                             \
@@ -59,6 +67,10 @@
           "Time between statistics print outs (in seconds)")                \
           range(1, (uint)-1)                                                \
                                                                             \
+  product(bool, ZRelocateHotObjectsApart, false, EXPERIMENTAL,              \
+          "Relocate small objects that the application accessed during "    \
+          "marking into separate pages from the other survivors")           \
+                                                                            \
   product(bool, ZStressRelocateInPlace, false, DIAGNOSTIC,                  \
           "Always relocate pages in-place")                                 \
                                                                             \
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#ifndef _JAVA_CRENGINE_H_
+#define _JAVA_CRENGINE_H_
+
+/*
+ * Interface of a checkpoint/restore engine loaded into the JVM process.
+ *
+ * -XX:CREngine names either an executable, which the JVM runs as
+ * "<engine> checkpoint|restore <image dir> [options]", or a shared library
+ * exporting CRENGINE_GET_API. A library engine runs in the JVM process, so
+ * there is no fork and exec on checkpoint and restore.
+ *
+ * Bump CRENGINE_API_VERSION on any incompatible change of crengine_api.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CRENGINE_API_VERSION 1
+
+#define CRENGINE_GET_API "crengine_get_api"
+
+typedef struct crengine_api {
+  /* CRENGINE_API_VERSION the engine was built against. */
+  int version;
+
+  /*
+   * Called once after the library is loaded with the NULL-terminated options
+   * that follow the library in -XX:CREngine. Returns 0 on success.
+   */
+  int (*init)(const char* const* options);
+
+  /*
+   * Called at a safepoint to checkpoint the process to image_dir. Returns when
+   * the process continues, either restored or after the checkpoint when the
+   * engine leaves the process running. Returns a negative value on failure,
+   * otherwise the id of the shared memory with new restore parameters written
+   * by the restoring JVM, which the restore passes in CRAC_NEW_ARGS_ID, or 0.
+   */
+  int (*checkpoint)(const char* image_dir);
+
+  /*
+   * Called early in a JVM started with -XX:CRaCRestoreFrom to replace the
+   * process with the one checkpointed to image_dir. Only returns on failure.
+   */
+  int (*restore)(const char* image_dir);
+} crengine_api_t;
+
+typedef const crengine_api_t* (*crengine_get_api_t)(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /* _JAVA_CRENGINE_H_ */
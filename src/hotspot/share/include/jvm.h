@@ -1142,6 +1142,18 @@ enum cr_fail_type {
 JNIEXPORT jobjectArray JNICALL
 JVM_Checkpoint(JNIEnv *env, jarray fd_arr, jobjectArray obj_arr, jboolean dry_run, jlong jcmd_stream);
 
+/*
+ * Hooks of a native library for what it holds that cannot be checkpointed,
+ * like device descriptors or connections. before_checkpoint is called by the
+ * checkpointing thread before the VM checks for open files, after_restore
+ * after the restore or after a failed checkpoint. Either one may be NULL.
+ * Returns JNI_FALSE if there are too many hooks already.
+ */
+typedef void (JNICALL *JVM_CheckpointHook)(JNIEnv *env, void *data);
+
+JNIEXPORT jboolean JNICALL
+JVM_RegisterCheckpointHook(JVM_CheckpointHook before_checkpoint, JVM_CheckpointHook after_restore, void *data);
+
 #ifdef __cplusplus
 } /* extern "C" */
 
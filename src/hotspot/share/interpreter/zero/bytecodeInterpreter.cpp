@@ -584,10 +584,11 @@ void BytecodeInterpreter::run(interpreterState istate) {
 /* 0xD8 */ &&opc_fast_fputfield,&&opc_fast_iputfield,   &&opc_fast_lputfield, &&opc_fast_sputfield,
 /* 0xDC */ &&opc_fast_aload_0,  &&opc_fast_iaccess_0,   &&opc_fast_aaccess_0, &&opc_fast_faccess_0,
 
-/* 0xE0 */ &&opc_fast_iload,    &&opc_fast_iload2,      &&opc_fast_icaload,   &&opc_fast_invokevfinal,
-/* 0xE4 */ &&opc_default,       &&opc_default,          &&opc_fast_aldc,      &&opc_fast_aldc_w,
-/* 0xE8 */ &&opc_return_register_finalizer,
-                                &&opc_invokehandle,     &&opc_default,        &&opc_default,
+/* 0xE0 */ &&opc_fast_iload,    &&opc_fast_iload2,      &&opc_fast_icaload,   &&opc_fast_ibaload,
+/* 0xE4 */ &&opc_fast_invokevfinal,
+                                &&opc_default,          &&opc_default,        &&opc_fast_aldc,
+/* 0xE8 */ &&opc_fast_aldc_w,   &&opc_return_register_finalizer,
+                                                        &&opc_invokehandle,   &&opc_default,
 /* 0xEC */ &&opc_default,       &&opc_default,          &&opc_default,        &&opc_default,
 
 /* 0xF0 */ &&opc_default,       &&opc_default,          &&opc_default,        &&opc_default,
@@ -627,7 +628,7 @@ void BytecodeInterpreter::run(interpreterState istate) {
         // Traditional lightweight locking.
         markWord displaced = rcvr->mark().set_unlocked();
         mon->lock()->set_displaced_header(displaced);
-        bool call_vm = UseHeavyMonitors;
+        bool call_vm = UseHeavyMonitors || UseLightweightLocking;
         if (call_vm || rcvr->cas_set_mark(markWord::from_pointer(mon), displaced) != displaced) {
           // Is it simple recursive case?
           if (!call_vm && THREAD->is_lock_owned((address) displaced.clear_lock_bits().to_pointer())) {
@@ -723,7 +724,7 @@ void BytecodeInterpreter::run(interpreterState istate) {
       // traditional lightweight locking
       markWord displaced = lockee->mark().set_unlocked();
       entry->lock()->set_displaced_header(displaced);
-      bool call_vm = UseHeavyMonitors;
+      bool call_vm = UseHeavyMonitors || UseLightweightLocking;
       if (call_vm || lockee->cas_set_mark(markWord::from_pointer(entry), displaced) != displaced) {
         // Is it simple recursive case?
         if (!call_vm && THREAD->is_lock_owned((address) displaced.clear_lock_bits().to_pointer())) {
@@ -835,6 +836,7 @@ run:
         if (REWRITE_BYTECODES) {
           // Attempt to rewrite iload, iload -> fast_iload2
           //                    iload, caload -> fast_icaload
+          //                    iload, baload -> fast_ibaload
           // Normal iloads will be rewritten to fast_iload to avoid checking again.
           switch (*(pc + 2)) {
             case Bytecodes::_fast_iload:
@@ -843,6 +845,9 @@ run:
             case Bytecodes::_caload:
               REWRITE_AT_PC(Bytecodes::_fast_icaload);
               break;
+            case Bytecodes::_baload:
+              REWRITE_AT_PC(Bytecodes::_fast_ibaload);
+              break;
             case Bytecodes::_iload:
               // Wait until rewritten to _fast_iload.
               break;
@@ -1533,6 +1538,15 @@ run:
           UPDATE_PC_AND_TOS_AND_CONTINUE(3, 0);
       }
 
+      CASE(_fast_ibaload): {
+          // Custom fast access for iload,baload pair.
+          arrayOop arrObj = (arrayOop) STACK_OBJECT(-1);
+          jint index = LOCALS_INT(pc[1]);
+          ARRAY_INDEX_CHECK(arrObj, index);
+          SET_STACK_INT(*(jbyte *)(((address) arrObj->base(T_BYTE)) + index * sizeof(jbyte)), -1);
+          UPDATE_PC_AND_TOS_AND_CONTINUE(3, 0);
+      }
+
       /* 32-bit stores. These handle conversion to < 32-bit types */
 #define ARRAY_STOREFROM32(T, T2, format, stackSrc, extra)                            \
       {                                                                              \
@@ -1633,7 +1647,7 @@ run:
           // traditional lightweight locking
           markWord displaced = lockee->mark().set_unlocked();
           entry->lock()->set_displaced_header(displaced);
-          bool call_vm = UseHeavyMonitors;
+          bool call_vm = UseHeavyMonitors || UseLightweightLocking;
           if (call_vm || lockee->cas_set_mark(markWord::from_pointer(entry), displaced) != displaced) {
             // Is it simple recursive case?
             if (!call_vm && THREAD->is_lock_owned((address) displaced.clear_lock_bits().to_pointer())) {
@@ -1665,7 +1679,7 @@ run:
             assert(!UseBiasedLocking, "Not implemented");
 
             // If it isn't recursive we either must swap old header or call the runtime
-            bool call_vm = UseHeavyMonitors;
+            bool call_vm = UseHeavyMonitors || UseLightweightLocking;
             if (header.to_pointer() != NULL || call_vm) {
               markWord old_header = markWord::encode(lock);
               if (call_vm || lockee->cas_set_mark(header, old_header) != old_header) {
@@ -3144,7 +3158,7 @@ run:
               illegal_state_oop = Handle(THREAD, THREAD->pending_exception());
               THREAD->clear_pending_exception();
             }
-          } else if (UseHeavyMonitors) {
+          } else if (UseHeavyMonitors || UseLightweightLocking) {
             InterpreterRuntime::monitorexit(base);
             if (THREAD->has_pending_exception()) {
               if (!suppress_error) illegal_state_oop = Handle(THREAD, THREAD->pending_exception());
@@ -104,6 +104,16 @@ void Jfr::on_vm_error_report(outputStream* st) {
   }
 }
 
+void Jfr::before_checkpoint(JavaThread* jt) {
+  if (JfrRecorder::is_recording()) {
+    JfrRepository::before_checkpoint(jt);
+  }
+}
+
+void Jfr::after_restore(JavaThread* jt) {
+  JfrRepository::after_restore(jt);
+}
+
 bool Jfr::on_flight_recorder_option(const JavaVMOption** option, char* delimiter) {
   return JfrOptionSet::parse_flight_recorder_option(option, delimiter);
 }
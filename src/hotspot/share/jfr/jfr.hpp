@@ -52,6 +52,8 @@ class Jfr : AllStatic {
   static bool on_flight_recorder_option(const JavaVMOption** option, char* delimiter);
   static bool on_start_flight_recording_option(const JavaVMOption** option, char* delimiter);
   static void on_vm_error_report(outputStream* st);
+  static void before_checkpoint(JavaThread* jt);
+  static void after_restore(JavaThread* jt);
   static void exclude_thread(Thread* thread);
   static bool is_excluded(Thread* thread);
   static void include_thread(Thread* thread);
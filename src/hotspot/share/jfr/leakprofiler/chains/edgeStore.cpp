@@ -26,6 +26,7 @@
 #include "jfr/leakprofiler/chains/edgeStore.hpp"
 #include "jfr/leakprofiler/chains/edgeUtils.hpp"
 #include "jfr/leakprofiler/sampling/objectSample.hpp"
+#include "jfr/leakprofiler/utilities/granularTimer.hpp"
 #include "jfr/leakprofiler/utilities/unifiedOopRef.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/safepoint.hpp"
@@ -219,7 +220,7 @@ bool EdgeStore::put_edges(StoredEdge** previous, const Edge** current, size_t li
 
 static GrowableArray<const StoredEdge*>* _leak_context_edges = nullptr;
 
-EdgeStore::EdgeStore() : _edges(new EdgeHashTable(this)) {}
+EdgeStore::EdgeStore() : _edges(new EdgeHashTable(this)), _nof_chains(0), _max_chains(0) {}
 
 EdgeStore::~EdgeStore() {
   assert(_edges != NULL, "invariant");
@@ -321,6 +322,10 @@ void EdgeStore::put_chain(const Edge* chain, size_t length) {
   assert(leak_context_edge != NULL, "invariant");
   assert(leak_context_edge->parent() == NULL, "invariant");
 
+  if (++_nof_chains == _max_chains) {
+    GranularTimer::finish();
+  }
+
   if (1 == length) {
     store_gc_root_id_in_leak_context_edge(leak_context_edge, leak_context_edge);
     return;
@@ -73,6 +73,8 @@ class EdgeStore : public CHeapObj<mtTracing> {
  private:
   static traceid _edge_id_counter;
   EdgeHashTable* _edges;
+  size_t _nof_chains;
+  size_t _max_chains;
 
   // Hash table callbacks
   void on_link(EdgeEntry* entry);
@@ -106,6 +108,9 @@ class EdgeStore : public CHeapObj<mtTracing> {
   bool is_empty() const;
   traceid get_id(const Edge* edge) const;
   void put_chain(const Edge* chain, size_t length);
+  // Once max_chains chains are stored, all samples have been found and
+  // the search is ended through the GranularTimer.
+  void set_max_chains(size_t max_chains) { _max_chains = max_chains; }
 };
 
 #endif // SHARE_JFR_LEAKPROFILER_CHAINS_EDGESTORE_HPP
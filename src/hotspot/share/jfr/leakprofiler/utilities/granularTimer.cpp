@@ -47,6 +47,16 @@ void GranularTimer::stop() {
     _finish_time_ticks = JfrTicks::now();
   }
 }
+void GranularTimer::finish() {
+  assert(_granularity != 0, "GranularTimer::finish must be called after GranularTimer::start");
+  if (!_finished) {
+    _finish_time_ticks = JfrTicks::now();
+    _finished = true;
+  }
+  // seen at the next is_finished()
+  _counter = 1;
+}
+
 const JfrTicks& GranularTimer::start_time() {
   return _start_time_ticks;
 }
@@ -38,6 +38,8 @@ class GranularTimer : public AllStatic {
  public:
   static void start(jlong duration_ticks, long granularity);
   static void stop();
+  // Ends the period now, for when there is nothing left to search for.
+  static void finish();
   static const JfrTicks& start_time();
   static const JfrTicks& end_time();
   static bool is_finished();
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "jvm.h"
+#include "classfile/classLoader.hpp"
 #include "classfile/classLoaderDataGraph.hpp"
 #include "classfile/classLoaderStats.hpp"
 #include "classfile/javaClasses.hpp"
@@ -32,6 +33,7 @@
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
 #include "compiler/compileBroker.hpp"
+#include "gc/shared/allocationSiteSampler.hpp"
 #include "gc/shared/gcConfiguration.hpp"
 #include "gc/shared/gcTrace.hpp"
 #include "gc/shared/gcVMOperations.hpp"
@@ -59,6 +61,7 @@
 #include "runtime/os_perf.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/sweeper.hpp"
+#include "runtime/timer.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vm_version.hpp"
 #include "services/classLoadingService.hpp"
@@ -343,6 +346,10 @@ TRACE_REQUEST_FUNC(G1HeapRegionInformation) {
   G1GC_ONLY(G1HeapRegionEventSender::send_events());
 }
 
+TRACE_REQUEST_FUNC(AllocationSiteStatistics) {
+  AllocationSiteSampler::send_events();
+}
+
 // Java Mission Control (JMC) uses (Java) Long.MIN_VALUE to describe that a
 // long value is undefined.
 static jlong jmc_undefined_long = min_jlong;
@@ -479,6 +486,10 @@ TRACE_REQUEST_FUNC(ClassLoadingStatistics) {
 }
 
 class JfrClassLoaderStatsClosure : public ClassLoaderStatsClosure {
+  static jlong event_nanos(ClassLoaderStats const& cls, int type) {
+    return (jlong)(TimeHelper::counter_to_seconds(cls._class_event_ticks[type]) * NANOSECS_PER_SEC);
+  }
+
 public:
   JfrClassLoaderStatsClosure() : ClassLoaderStatsClosure(NULL) {}
 
@@ -497,6 +508,10 @@ public:
     event.set_hiddenClassCount(cls._hidden_classes_count);
     event.set_hiddenChunkSize(cls._hidden_chunk_sz);
     event.set_hiddenBlockSize(cls._hidden_block_sz);
+    event.set_parseTime(event_nanos(cls, PerfClassTraceTime::CLASS_PARSE));
+    event.set_linkTime(event_nanos(cls, PerfClassTraceTime::CLASS_LINK));
+    event.set_verifyTime(event_nanos(cls, PerfClassTraceTime::CLASS_VERIFY));
+    event.set_initTime(event_nanos(cls, PerfClassTraceTime::CLASS_CLINIT));
     event.commit();
     return true;
   }
@@ -0,0 +1,518 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/javaThreadStatus.hpp"
+#include "jfr/jfrEvents.hpp"
+#include "jfr/periodic/sampling/jfrAsyncSampler.hpp"
+#include "jfr/periodic/sampling/jfrCallTrace.hpp"
+#include "jfr/recorder/service/jfrOptionSet.hpp"
+#include "jfr/recorder/stacktrace/jfrStackTrace.hpp"
+#include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
+#include "jfr/support/jfrThreadId.hpp"
+#include "jfr/support/jfrThreadLocal.hpp"
+#include "jfr/utilities/jfrAllocation.hpp"
+#include "jfr/utilities/jfrTime.hpp"
+#include "logging/log.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/frame.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/threadSMR.hpp"
+
+#ifdef LINUX
+
+#include <errno.h>
+#include <signal.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+static const int SAMPLE_SIGNAL = SIGPROF;
+
+// Samples a thread holds until they are drained. A thread is sampled at most
+// once per period of its CPU time and the buffers are drained once per period
+// of wall clock time, so this leaves room for a late drain.
+static const uint NR_OF_SLOTS = 4;
+
+// Events committed per batch, Threads_lock is released in between.
+static const uint MAX_NR_OF_DRAINED_SAMPLES = 64;
+
+enum SlotState {
+  SLOT_FREE,   // owned by the sampled thread
+  SLOT_READY   // owned by the drain
+};
+
+enum TimerState {
+  TIMER_DISARMED,
+  TIMER_BUSY,   // being created, changed or deleted
+  TIMER_ARMED,
+  TIMER_DEAD    // the thread has exited
+};
+
+class JfrAsyncSampleBuffer : public JfrCHeapObj {
+ public:
+  struct Slot {
+    volatile int _state;
+    u4 _nr_of_frames;
+    bool _reached_root;
+    uint64_t _safepoint_counter;
+    JfrTicks _time;
+    JfrAsyncStackFrame* _frames;
+  };
+
+ private:
+  Slot _slots[NR_OF_SLOTS];
+  JfrAsyncStackFrame* const _frames;
+  const u4 _max_frames;
+  uint _next;  // only accessed by the owning thread
+  timer_t _timer;
+  volatile int _timer_state;
+
+ public:
+  JfrAsyncSampleBuffer(u4 max_frames) :
+    _frames(JfrCHeapObj::new_array<JfrAsyncStackFrame>(NR_OF_SLOTS * max_frames)),
+    _max_frames(max_frames),
+    _next(0),
+    _timer(),
+    _timer_state(TIMER_DISARMED) {
+    for (uint i = 0; i < NR_OF_SLOTS; ++i) {
+      _slots[i]._state = SLOT_FREE;
+      _slots[i]._nr_of_frames = 0;
+      _slots[i]._reached_root = false;
+      _slots[i]._safepoint_counter = 0;
+      _slots[i]._frames = _frames + i * max_frames;
+    }
+  }
+
+  ~JfrAsyncSampleBuffer() {
+    JfrCHeapObj::free(_frames, sizeof(JfrAsyncStackFrame) * NR_OF_SLOTS * _max_frames);
+  }
+
+  u4 max_frames() const { return _max_frames; }
+  Slot* slot(uint index) { return &_slots[index]; }
+
+  Slot* next_free_slot() {
+    Slot* const slot = &_slots[_next];
+    return Atomic::load_acquire(&slot->_state) == SLOT_FREE ? slot : NULL;
+  }
+
+  void publish(Slot* slot) {
+    assert(slot == &_slots[_next], "invariant");
+    Atomic::release_store(&slot->_state, (int)SLOT_READY);
+    _next = (_next + 1) % NR_OF_SLOTS;
+  }
+
+  bool drain(Slot* slot, JavaThread* jt, uint64_t safepoint_counter,
+             JfrStackFrame* frames, u4 max_frames, EventExecutionSample* event);
+
+  bool arm(JavaThread* jt, int64_t period_millis);
+  void disarm();
+  void kill();
+};
+
+static volatile bool _active = false;
+static volatile int64_t _period_millis = 0;
+static uint _drain_index = 0;
+
+static bool is_excluded(JavaThread* jt) {
+  return jt->is_hidden_from_external_view() || jt->in_deopt_handler() || jt->jfr_thread_local()->is_excluded();
+}
+
+//
+// Timers
+//
+
+static struct itimerspec timer_spec(int64_t period_millis) {
+  struct itimerspec spec;
+  spec.it_interval.tv_sec = period_millis / MILLIUNITS;
+  spec.it_interval.tv_nsec = (period_millis % MILLIUNITS) * (NANOUNITS / MILLIUNITS);
+  spec.it_value = spec.it_interval;
+  return spec;
+}
+
+bool JfrAsyncSampleBuffer::arm(JavaThread* jt, int64_t period_millis) {
+  assert(period_millis > 0, "invariant");
+  const struct itimerspec spec = timer_spec(period_millis);
+  if (Atomic::cmpxchg(&_timer_state, (int)TIMER_ARMED, (int)TIMER_BUSY) == TIMER_ARMED) {
+    // new period
+    timer_settime(_timer, 0, &spec, NULL);
+    Atomic::release_store(&_timer_state, (int)TIMER_ARMED);
+    return true;
+  }
+  if (Atomic::cmpxchg(&_timer_state, (int)TIMER_DISARMED, (int)TIMER_BUSY) != TIMER_DISARMED) {
+    // dead, or armed concurrently
+    return false;
+  }
+  clockid_t clock;
+  if (os::Linux::pthread_getcpuclockid(jt->osthread()->pthread_id(), &clock) != 0) {
+    Atomic::release_store(&_timer_state, (int)TIMER_DISARMED);
+    return false;
+  }
+  struct sigevent event;
+  memset(&event, 0, sizeof(event));
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SAMPLE_SIGNAL;
+  event.sigev_notify_thread_id = (pid_t)jt->osthread()->thread_id();
+  if (timer_create(clock, &event, &_timer) != 0) {
+    log_debug(jfr, system)("Failed to create sampling timer: %s", os::strerror(errno));
+    Atomic::release_store(&_timer_state, (int)TIMER_DISARMED);
+    return false;
+  }
+  timer_settime(_timer, 0, &spec, NULL);
+  Atomic::release_store(&_timer_state, (int)TIMER_ARMED);
+  return true;
+}
+
+void JfrAsyncSampleBuffer::disarm() {
+  if (Atomic::cmpxchg(&_timer_state, (int)TIMER_ARMED, (int)TIMER_BUSY) == TIMER_ARMED) {
+    timer_delete(_timer);
+    Atomic::release_store(&_timer_state, (int)TIMER_DISARMED);
+  }
+}
+
+void JfrAsyncSampleBuffer::kill() {
+  while (true) {
+    const int state = Atomic::load_acquire(&_timer_state);
+    if (state == TIMER_DEAD) {
+      return;
+    }
+    if (state != TIMER_BUSY && Atomic::cmpxchg(&_timer_state, state, (int)TIMER_DEAD) == state) {
+      if (state == TIMER_ARMED) {
+        timer_delete(_timer);
+      }
+      return;
+    }
+    SpinPause();
+  }
+}
+
+static JfrAsyncSampleBuffer* install_buffer(JavaThread* jt) {
+  JfrThreadLocal* const tl = jt->jfr_thread_local();
+  JfrAsyncSampleBuffer* const buffer = tl->async_samples();
+  if (buffer != NULL) {
+    return buffer;
+  }
+  JfrAsyncSampleBuffer* const new_buffer = new JfrAsyncSampleBuffer(JfrOptionSet::stackdepth());
+  if (!tl->install_async_samples(new_buffer)) {
+    // installed concurrently
+    delete new_buffer;
+  }
+  return tl->async_samples();
+}
+
+static void arm(JavaThread* jt, int64_t period_millis) {
+  if (jt->is_Compiler_thread() || jt->osthread() == NULL) {
+    return;
+  }
+  install_buffer(jt)->arm(jt, period_millis);
+}
+
+static void disarm(JavaThread* jt) {
+  JfrAsyncSampleBuffer* const buffer = jt->jfr_thread_local()->async_samples();
+  if (buffer != NULL) {
+    buffer->disarm();
+  }
+}
+
+//
+// Sampling, in the signal handler of the sampled thread
+//
+
+class JfrAsyncSampleCallback : public os::CrashProtectionCallback {
+ public:
+  JfrAsyncSampleCallback(JavaThread* jt, void* ucontext, JfrAsyncSampleBuffer::Slot* slot, u4 max_frames) :
+    _jt(jt), _ucontext(ucontext), _slot(slot), _max_frames(max_frames), _success(false) {}
+
+  virtual void call() {
+    JfrGetCallTrace trace(true, _jt);
+    frame topframe;
+    if (trace.get_topframe(_ucontext, topframe)) {
+      _success = JfrStackTrace::record_async_frames(*_jt, topframe, _slot->_frames, _max_frames,
+                                                    &_slot->_nr_of_frames, &_slot->_reached_root);
+    }
+  }
+  bool success() const { return _success; }
+
+ private:
+  JavaThread* const _jt;
+  void* const _ucontext;
+  JfrAsyncSampleBuffer::Slot* const _slot;
+  const u4 _max_frames;
+  bool _success;
+};
+
+/*
+* Runs on the sampled thread, interrupted at an arbitrary point. Don't take
+* locks, allocate memory or load trace ids, and walk the stack only under crash
+* protection. If the drain lags behind, the sample is dropped.
+*/
+static void sample_current_thread(JavaThread* jt, void* ucontext) {
+  if (jt->thread_state() != _thread_in_Java || is_excluded(jt)) {
+    return;
+  }
+  JfrAsyncSampleBuffer* const buffer = jt->jfr_thread_local()->async_samples();
+  if (buffer == NULL) {
+    return;
+  }
+  JfrAsyncSampleBuffer::Slot* const slot = buffer->next_free_slot();
+  if (slot == NULL) {
+    return;
+  }
+  // Read before the walk. This thread is in Java, so a safepoint can not
+  // complete until the handler returns.
+  slot->_safepoint_counter = SafepointSynchronize::safepoint_counter();
+  slot->_time = JfrTicks::now();
+  JfrAsyncSampleCallback cb(jt, ucontext, slot, buffer->max_frames());
+  if (JfrOptionSet::sample_protection()) {
+    os::ThreadCrashProtection crash_protection;
+    if (!crash_protection.call(cb)) {
+      return;
+    }
+  } else {
+    cb.call();
+  }
+  if (cb.success()) {
+    buffer->publish(slot);
+  }
+}
+
+static void async_sample_handler(int sig, siginfo_t* info, void* ucontext) {
+  const int saved_errno = errno;
+  Thread* const t = Thread::current_or_null_safe();
+  if (t != NULL && t->is_Java_thread()) {
+    sample_current_thread(t->as_Java_thread(), ucontext);
+  }
+  errno = saved_errno;
+}
+
+enum HandlerState {
+  HANDLER_NOT_INSTALLED,
+  HANDLER_INSTALLED,
+  HANDLER_FAILED
+};
+
+static HandlerState _handler_state = HANDLER_NOT_INSTALLED;
+
+static bool install_signal_handler() {
+  if (_handler_state != HANDLER_NOT_INSTALLED) {
+    return _handler_state == HANDLER_INSTALLED;
+  }
+  _handler_state = HANDLER_FAILED;
+  struct sigaction old_action;
+  if (sigaction(SAMPLE_SIGNAL, NULL, &old_action) != 0) {
+    return false;
+  }
+  const void* const old_handler = (old_action.sa_flags & SA_SIGINFO) != 0 ?
+    CAST_FROM_FN_PTR(void*, old_action.sa_sigaction) : CAST_FROM_FN_PTR(void*, old_action.sa_handler);
+  if (old_handler != CAST_FROM_FN_PTR(void*, SIG_DFL) && old_handler != CAST_FROM_FN_PTR(void*, SIG_IGN)) {
+    log_warning(jfr, system)("SIGPROF is in use, execution sampling suspends threads instead");
+    return false;
+  }
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  sigemptyset(&action.sa_mask);
+  action.sa_sigaction = async_sample_handler;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  if (sigaction(SAMPLE_SIGNAL, &action, NULL) != 0) {
+    log_warning(jfr, system)("Failed to install SIGPROF handler, execution sampling suspends threads instead");
+    return false;
+  }
+  _handler_state = HANDLER_INSTALLED;
+  return true;
+}
+
+//
+// Draining, by the JFR sampler thread
+//
+
+bool JfrAsyncSampleBuffer::drain(Slot* slot, JavaThread* jt, uint64_t safepoint_counter,
+                                 JfrStackFrame* frames, u4 max_frames, EventExecutionSample* event) {
+  if (slot->_safepoint_counter != safepoint_counter) {
+    // methods may have been deallocated at the safepoint
+    return false;
+  }
+  u4 nr_of_frames = slot->_nr_of_frames;
+  bool reached_root = slot->_reached_root;
+  if (nr_of_frames > max_frames) {
+    nr_of_frames = max_frames;
+    reached_root = false;
+  }
+  JfrStackTrace stacktrace(frames, max_frames);
+  if (!stacktrace.record_async(slot->_frames, nr_of_frames, reached_root)) {
+    return false;
+  }
+  const traceid id = JfrStackTraceRepository::add(stacktrace);
+  assert(id != 0, "Stacktrace id should not be 0");
+  event->set_starttime(slot->_time);
+  event->set_endtime(slot->_time); // fake to not take an end time
+  event->set_sampledThread(JFR_THREAD_ID(jt));
+  event->set_state(static_cast<u8>(JavaThreadStatus::RUNNABLE));
+  event->set_stackTrace(id);
+  return true;
+}
+
+// Drains what fits into one batch of events, starting with the thread at _drain_index.
+// Returns true if samples were left behind.
+static bool drain_batch(JfrStackFrame* frames, u4 max_frames) {
+  EventExecutionSample events[MAX_NR_OF_DRAINED_SAMPLES];
+  uint nr_of_events = 0;
+  bool full = false;
+  {
+    MutexLocker tlock(Threads_lock);
+    ThreadsListHandle tlh;
+    // No safepoint can start while Threads_lock is held.
+    const uint64_t safepoint_counter = SafepointSynchronize::safepoint_counter();
+    const uint length = tlh.list()->length();
+    if (_drain_index >= length) {
+      _drain_index = 0;
+    }
+    for (uint n = 0; n < length; ++n) {
+      JavaThread* const jt = tlh.list()->thread_at(_drain_index);
+      JfrAsyncSampleBuffer* const buffer = jt->jfr_thread_local()->async_samples();
+      if (buffer != NULL) {
+        for (uint i = 0; i < NR_OF_SLOTS; ++i) {
+          JfrAsyncSampleBuffer::Slot* const slot = buffer->slot(i);
+          if (Atomic::load_acquire(&slot->_state) != SLOT_READY) {
+            continue;
+          }
+          if (nr_of_events == MAX_NR_OF_DRAINED_SAMPLES) {
+            // continue with this thread in the next batch
+            full = true;
+            break;
+          }
+          if (buffer->drain(slot, jt, safepoint_counter, frames, max_frames, &events[nr_of_events])) {
+            nr_of_events++;
+          }
+          Atomic::release_store(&slot->_state, (int)SLOT_FREE);
+        }
+      }
+      if (full) {
+        break;
+      }
+      _drain_index = (_drain_index + 1) % length;
+    }
+  }
+  if (EventExecutionSample::is_enabled()) {
+    for (uint i = 0; i < nr_of_events; ++i) {
+      events[i].commit();
+    }
+  }
+  return full;
+}
+
+bool JfrAsyncSampler::is_supported() {
+  return true;
+}
+
+bool JfrAsyncSampler::is_active() {
+  return Atomic::load_acquire(&_active);
+}
+
+bool JfrAsyncSampler::start(int64_t period_millis) {
+  assert(period_millis > 0, "invariant");
+  if (!install_signal_handler()) {
+    return false;
+  }
+  Atomic::store(&_period_millis, period_millis);
+  Atomic::release_store_fence(&_active, true);
+  for (JavaThreadIteratorWithHandle jtiwh; JavaThread* jt = jtiwh.next(); ) {
+    arm(jt, period_millis);
+  }
+  log_trace(jfr)("Async execution sampling every " INT64_FORMAT " ms of thread CPU time", period_millis);
+  return true;
+}
+
+void JfrAsyncSampler::stop() {
+  if (!is_active()) {
+    return;
+  }
+  Atomic::release_store_fence(&_active, false);
+  for (JavaThreadIteratorWithHandle jtiwh; JavaThread* jt = jtiwh.next(); ) {
+    disarm(jt);
+  }
+  log_trace(jfr)("Async execution sampling stopped");
+}
+
+void JfrAsyncSampler::drain(JfrStackFrame* frames, u4 max_frames) {
+  while (drain_batch(frames, max_frames)) {}
+}
+
+void JfrAsyncSampler::on_thread_start(JavaThread* jt) {
+  if (!is_active()) {
+    return;
+  }
+  arm(jt, Atomic::load(&_period_millis));
+  OrderAccess::fence();
+  if (!is_active()) {
+    // raced with stop()
+    disarm(jt);
+  }
+}
+
+void JfrAsyncSampler::on_thread_exit(JavaThread* jt) {
+  JfrAsyncSampleBuffer* const buffer = jt->jfr_thread_local()->async_samples();
+  if (buffer != NULL) {
+    buffer->kill();
+  }
+}
+
+void JfrAsyncSampler::release(JfrThreadLocal* tl) {
+  JfrAsyncSampleBuffer* const buffer = tl->async_samples();
+  if (buffer != NULL) {
+    buffer->kill();
+    delete buffer;
+  }
+}
+
+#else // !LINUX
+
+bool JfrAsyncSampler::is_supported() {
+  return false;
+}
+
+bool JfrAsyncSampler::is_active() {
+  return false;
+}
+
+bool JfrAsyncSampler::start(int64_t period_millis) {
+  return false;
+}
+
+void JfrAsyncSampler::stop() {}
+
+void JfrAsyncSampler::drain(JfrStackFrame* frames, u4 max_frames) {}
+
+void JfrAsyncSampler::on_thread_start(JavaThread* jt) {}
+
+void JfrAsyncSampler::on_thread_exit(JavaThread* jt) {}
+
+void JfrAsyncSampler::release(JfrThreadLocal* tl) {}
+
+#endif // LINUX
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_JFR_PERIODIC_SAMPLING_JFRASYNCSAMPLER_HPP
+#define SHARE_JFR_PERIODIC_SAMPLING_JFRASYNCSAMPLER_HPP
+
+#include "jfr/utilities/jfrTypes.hpp"
+#include "memory/allocation.hpp"
+
+class JavaThread;
+class JfrAsyncSampleBuffer;
+class JfrStackFrame;
+class JfrThreadLocal;
+
+//
+// Execution sampling without suspending the sampled threads.
+//
+// Each Java thread gets a timer on its own CPU time clock that delivers a
+// signal to the thread itself. The signal handler walks the stack of the
+// interrupted thread under os::ThreadCrashProtection and stores the raw frames
+// in a small per-thread buffer, without taking locks or allocating memory.
+// The JFR sampler thread periodically drains the buffers into the stack trace
+// repository and commits ExecutionSample events. A sample is dropped if a
+// safepoint happened since it was taken, since the methods it refers to may
+// have been deallocated.
+//
+// Enabled with -XX:FlightRecorderOptions:asyncsampling=true, Linux only.
+//
+class JfrAsyncSampler : AllStatic {
+ public:
+  static bool is_supported();
+  static bool start(int64_t period_millis);
+  static void stop();
+  static bool is_active();
+
+  // Called by the JFR sampler thread.
+  static void drain(JfrStackFrame* frames, u4 max_frames);
+
+  static void on_thread_start(JavaThread* jt);
+  static void on_thread_exit(JavaThread* jt);
+  static void release(JfrThreadLocal* tl);
+};
+
+#endif // SHARE_JFR_PERIODIC_SAMPLING_JFRASYNCSAMPLER_HPP
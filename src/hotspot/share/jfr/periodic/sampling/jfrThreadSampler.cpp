@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "jfr/jfrEvents.hpp"
 #include "jfr/recorder/jfrRecorder.hpp"
+#include "jfr/periodic/sampling/jfrAsyncSampler.hpp"
 #include "jfr/periodic/sampling/jfrCallTrace.hpp"
 #include "jfr/periodic/sampling/jfrThreadSampler.hpp"
 #include "jfr/recorder/service/jfrOptionSet.hpp"
@@ -530,7 +531,12 @@ void JfrThreadSampler::run() {
     }
 
     if ((next_j - sleep_to_next) <= 0) {
-      task_stacktrace(JAVA_SAMPLE, &_last_thread_java);
+      if (JfrAsyncSampler::is_active()) {
+        // Java threads sample themselves, collect what they recorded.
+        JfrAsyncSampler::drain(_frames, _max_frames);
+      } else {
+        task_stacktrace(JAVA_SAMPLE, &_last_thread_java);
+      }
       last_java_ms = get_monotonic_ms();
     }
     if ((next_n - sleep_to_next) <= 0) {
@@ -615,6 +621,7 @@ void JfrThreadSampling::destroy() {
 JfrThreadSampling::JfrThreadSampling() : _sampler(NULL) {}
 
 JfrThreadSampling::~JfrThreadSampling() {
+  JfrAsyncSampler::stop();
   if (_sampler != NULL) {
     _sampler->disenroll();
   }
@@ -640,7 +647,22 @@ void JfrThreadSampling::create_sampler(int64_t java_period_millis, int64_t nativ
   _sampler->enroll();
 }
 
+static void update_async_sampling(int64_t java_period_millis) {
+  if (!JfrOptionSet::async_sampling()) {
+    return;
+  }
+  if (java_period_millis > 0) {
+    if (!JfrAsyncSampler::is_supported() || !JfrAsyncSampler::start(java_period_millis)) {
+      log_info(jfr)("Async execution sampling is not available, suspending threads instead");
+      JfrOptionSet::set_async_sampling(JNI_FALSE);
+    }
+  } else {
+    JfrAsyncSampler::stop();
+  }
+}
+
 void JfrThreadSampling::update_run_state(int64_t java_period_millis, int64_t native_period_millis) {
+  update_async_sampling(java_period_millis);
   if (java_period_millis > 0 || native_period_millis > 0) {
     if (_sampler == nullptr) {
       create_sampler(java_period_millis, native_period_millis);
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "jfr/recorder/repository/jfrChunkStreamer.hpp"
+#include "jfr/recorder/service/jfrOptionSet.hpp"
+#include "logging/log.hpp"
+#include "memory/allocation.hpp"
+#include "runtime/os.hpp"
+#include "utilities/vmError.hpp"
+
+#ifndef _WINDOWS
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+
+static const size_t BUFFER_SIZE = 64 * K;
+
+// Only used by the thread rotating chunks.
+static int _socket = -1;
+static char* _buffer = NULL;
+static bool _warned = false;
+
+#ifndef _WINDOWS
+static bool connect_socket(const char* path) {
+  struct sockaddr_un addr;
+  if (strlen(path) >= sizeof(addr.sun_path)) {
+    return false;
+  }
+  const int s = os::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (s < 0) {
+    return false;
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  if (os::connect(s, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+    os::socket_close(s);
+    return false;
+  }
+  _socket = s;
+  _warned = false;
+  log_info(jfr)("Streaming chunks to %s", path);
+  return true;
+}
+
+static bool send_fully(char* buf, size_t len) {
+  while (len > 0) {
+    const int n = os::send(_socket, buf, len, 0);
+    if (n <= 0) {
+      return false;
+    }
+    buf += n;
+    len -= n;
+  }
+  return true;
+}
+#endif // !_WINDOWS
+
+void JfrChunkStreamer::stream(fio_fd fd, int64_t size) {
+  const char* const path = JfrOptionSet::stream_socket();
+  // Don't risk blocking on the collector while writing an emergency dump.
+  if (path == NULL || size <= 0 || VMError::is_error_reported()) {
+    return;
+  }
+#ifdef _WINDOWS
+  if (!_warned) {
+    log_warning(jfr)("streamsocket is not supported on Windows");
+    _warned = true;
+  }
+#else
+  // The collector may come and go, try to reconnect for every chunk.
+  if (_socket < 0 && !connect_socket(path)) {
+    if (!_warned) {
+      log_warning(jfr)("Failed to connect to %s, chunks are not streamed until it can be reached", path);
+      _warned = true;
+    }
+    return;
+  }
+  if (_buffer == NULL) {
+    _buffer = NEW_C_HEAP_ARRAY(char, BUFFER_SIZE, mtTracing);
+  }
+  int64_t offset = 0;
+  while (offset < size) {
+    const unsigned int len = (unsigned int)MIN2((int64_t)BUFFER_SIZE, size - offset);
+    const ssize_t n = os::read_at(fd, _buffer, len, offset);
+    if (n <= 0) {
+      // Half a chunk would leave the rest of the stream unreadable.
+      log_warning(jfr)("Failed to read chunk at offset " INT64_FORMAT " for streaming to %s", offset, path);
+      close();
+      return;
+    }
+    if (!send_fully(_buffer, (size_t)n)) {
+      // The collector has gone, it has to read this chunk from the repository.
+      log_warning(jfr)("Lost connection to %s after sending " INT64_FORMAT " of " INT64_FORMAT " bytes of a chunk",
+                       path, offset, size);
+      close();
+      return;
+    }
+    offset += n;
+  }
+#endif // _WINDOWS
+}
+
+void JfrChunkStreamer::close() {
+#ifndef _WINDOWS
+  if (_socket >= 0) {
+    os::socket_close(_socket);
+    _socket = -1;
+  }
+#endif
+  if (_buffer != NULL) {
+    FREE_C_HEAP_ARRAY(char, _buffer);
+    _buffer = NULL;
+  }
+}
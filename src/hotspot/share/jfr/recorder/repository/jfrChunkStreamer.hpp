@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_JFR_RECORDER_REPOSITORY_JFRCHUNKSTREAMER_HPP
+#define SHARE_JFR_RECORDER_REPOSITORY_JFRCHUNKSTREAMER_HPP
+
+#include "jfr/utilities/jfrTypes.hpp"
+#include "memory/allStatic.hpp"
+
+// Sends each completed chunk to the Unix domain socket given with
+// -XX:FlightRecorderOptions:streamsocket=<path>, so a collector in another
+// process can consume the recording without reading the repository. The
+// socket carries the chunks back to back, which is itself a valid
+// recording. Together with a repository on tmpfs this keeps continuous
+// recordings off the disk.
+class JfrChunkStreamer : AllStatic {
+ public:
+  // Called by the chunk writer with the final contents of the chunk in fd.
+  static void stream(fio_fd fd, int64_t size);
+  static void close();
+};
+
+#endif // SHARE_JFR_RECORDER_REPOSITORY_JFRCHUNKSTREAMER_HPP
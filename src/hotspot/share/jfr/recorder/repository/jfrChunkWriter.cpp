@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "jfr/recorder/repository/jfrChunk.hpp"
+#include "jfr/recorder/repository/jfrChunkStreamer.hpp"
 #include "jfr/recorder/repository/jfrChunkWriter.hpp"
 #include "jfr/utilities/jfrTime.hpp"
 #include "jfr/utilities/jfrTypes.hpp"
@@ -287,6 +288,8 @@ bool JfrChunkWriter::open() {
 int64_t JfrChunkWriter::close() {
   assert(this->has_valid_fd(), "invariant");
   const int64_t size_written = flush_chunk(false);
+  this->flush();
+  JfrChunkStreamer::stream(this->fd(), size_written);
   this->close_fd();
   assert(!this->is_valid(), "invariant");
   return size_written;
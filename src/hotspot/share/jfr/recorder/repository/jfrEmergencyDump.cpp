@@ -388,17 +388,18 @@ void JfrEmergencyDump::on_vm_error(const char* repository_path) {
   }
 }
 
-static const char* create_emergency_chunk_path(const char* repository_path) {
+static const char* create_emergency_chunk_path(const char* repository_path, const char* tag = "") {
   const size_t repository_path_len = strlen(repository_path);
   char date_time_buffer[32] = { 0 };
   date_time(date_time_buffer, sizeof(date_time_buffer));
   // append the individual substrings
   const int result = jio_snprintf(_path_buffer,
                                   JVM_MAXPATHLEN,
-                                  "%s%s%s%s",
+                                  "%s%s%s%s%s",
                                   repository_path,
                                   os::file_separator(),
                                   date_time_buffer,
+                                  tag,
                                   chunk_file_jfr_ext);
   return result == -1 ? NULL : _path_buffer;
 }
@@ -417,6 +418,12 @@ const char* JfrEmergencyDump::chunk_path(const char* repository_path) {
   return create_emergency_chunk_path(repository_path);
 }
 
+const char* JfrEmergencyDump::chunk_path(const char* repository_path, const char* tag) {
+  assert(repository_path != NULL, "invariant");
+  assert(tag != NULL, "invariant");
+  return create_emergency_chunk_path(repository_path, tag);
+}
+
 /*
 * We are just about to exit the VM, so we will be very aggressive
 * at this point in order to increase overall success of dumping jfr data.
@@ -34,6 +34,8 @@
 class JfrEmergencyDump : AllStatic {
  public:
   static const char* chunk_path(const char* repository_path);
+  // A chunk path in the repository with the given tag after the timestamp.
+  static const char* chunk_path(const char* repository_path, const char* tag);
   static void on_vm_error(const char* repository_path);
   static void on_vm_error_report(outputStream* st, const char* repository_path);
   static void on_vm_shutdown(bool exception_handler);
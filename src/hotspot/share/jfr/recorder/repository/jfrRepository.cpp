@@ -23,9 +23,11 @@
  */
 
 #include "precompiled.hpp"
+#include "jvm_io.h"
 #include "jfr/jfr.hpp"
 #include "jfr/jni/jfrJavaSupport.hpp"
 #include "jfr/recorder/jfrRecorder.hpp"
+#include "jfr/recorder/repository/jfrChunkStreamer.hpp"
 #include "jfr/recorder/repository/jfrChunkWriter.hpp"
 #include "jfr/recorder/repository/jfrEmergencyDump.hpp"
 #include "jfr/recorder/repository/jfrRepository.hpp"
@@ -67,6 +69,7 @@ JfrRepository::~JfrRepository() {
     delete _chunkwriter;
     _chunkwriter = NULL;
   }
+  JfrChunkStreamer::close();
 }
 
 JfrRepository* JfrRepository::create(JfrPostBox& post_box) {
@@ -160,6 +163,50 @@ void JfrRepository::set_path(jstring location, JavaThread* jt) {
   }
 }
 
+static bool _closed_for_checkpoint = false;
+
+// The image must not keep the chunk file open, and a restored instance
+// must not keep appending to the chunk of the checkpointed process. Events
+// recorded meanwhile stay in memory and go to the chunk opened on restore.
+void JfrRepository::before_checkpoint(JavaThread* jt) {
+  DEBUG_ONLY(JfrJavaSupport::check_java_thread_in_vm(jt));
+  if (!Jfr::is_recording() || !_chunkwriter->is_valid()) {
+    return;
+  }
+  instance().set_chunk_path(NULL);
+  notify_on_new_chunk_path();
+  JfrChunkStreamer::close();
+  _closed_for_checkpoint = true;
+  log_info(jfr)("Closed the current chunk before checkpoint");
+}
+
+void JfrRepository::after_restore(JavaThread* jt) {
+  DEBUG_ONLY(JfrJavaSupport::check_java_thread_in_vm(jt));
+  if (!_closed_for_checkpoint) {
+    return;
+  }
+  _closed_for_checkpoint = false;
+  const char* const repository = instance()._path;
+  if (!Jfr::is_recording() || repository == NULL || _chunkwriter->is_valid()) {
+    return;
+  }
+  // Replicas restored from the same image share the pid and possibly the
+  // repository, so the new chunk is named after the host as well.
+  char tag[64] = "_restored";
+  char host[48];
+  if (os::get_host_name(host, sizeof(host))) {
+    jio_snprintf(tag, sizeof(tag), "_%s_%d", host, os::current_process_id());
+  }
+  const char* const path = JfrEmergencyDump::chunk_path(repository, tag);
+  if (path == NULL) {
+    return;
+  }
+  // The chunk is timestamped with the time base corrected on restore.
+  instance().set_chunk_path(path);
+  notify_on_new_chunk_path();
+  log_info(jfr)("Opened chunk %s after restore", path);
+}
+
 bool JfrRepository::open_chunk(bool vm_error /* false */) {
   if (vm_error) {
     _chunkwriter->set_path(JfrEmergencyDump::chunk_path(_path));
@@ -74,6 +74,8 @@ class JfrRepository : public JfrCHeapObj {
   static void flush(JavaThread* jt);
   static jlong current_chunk_start_nanos();
   static void on_vm_error_report(outputStream* st);
+  static void before_checkpoint(JavaThread* jt);
+  static void after_restore(JavaThread* jt);
 };
 
 #endif // SHARE_JFR_RECORDER_REPOSITORY_JFRREPOSITORY_HPP
@@ -144,6 +144,29 @@ void JfrOptionSet::set_sample_protection(jboolean protection) {
 }
 #endif
 
+bool JfrOptionSet::async_sampling() {
+  return _async_sampling == JNI_TRUE;
+}
+
+void JfrOptionSet::set_async_sampling(jboolean value) {
+  _async_sampling = value;
+}
+
+const char* JfrOptionSet::stream_socket() {
+  return _stream_socket;
+}
+
+bool JfrOptionSet::set_stream_socket(const char* path) {
+  assert(_stream_socket == NULL, "invariant");
+  const size_t len = strlen(path);
+  _stream_socket = JfrCHeapObj::new_array<char>(len + 1);
+  if (_stream_socket == NULL) {
+    return false;
+  }
+  strncpy(_stream_socket, path, len + 1);
+  return true;
+}
+
 bool JfrOptionSet::compressed_integers() {
   // Set this to false for debugging purposes.
   return true;
@@ -172,6 +195,8 @@ const char* const default_sample_threads = "true";
 const char* const default_stack_depth = "64";
 const char* const default_retransform = "true";
 const char* const default_old_object_queue_size = "256";
+const char* const default_async_sampling = "false";
+const char* const default_stream_socket = NULL;
 DEBUG_ONLY(const char* const default_sample_protection = "false";)
 
 // statics
@@ -254,6 +279,20 @@ static DCmdArgument<bool> _dcmd_retransform(
   true,
   default_retransform);
 
+static DCmdArgument<bool> _dcmd_async_sampling(
+  "asyncsampling",
+  "If Java threads sample their own stacks from a CPU time timer signal, without being suspended (Linux only, by default false)",
+  "BOOLEAN",
+  false,
+  default_async_sampling);
+
+static DCmdArgument<char*> _dcmd_streamsocket(
+  "streamsocket",
+  "Unix domain socket that each completed repository chunk is also sent to (not on Windows)",
+  "STRING",
+  false,
+  default_stream_socket);
+
 static DCmdParser _parser;
 
 static void register_parser_options() {
@@ -267,6 +306,8 @@ static void register_parser_options() {
   _parser.add_dcmd_option(&_dcmd_sample_threads);
   _parser.add_dcmd_option(&_dcmd_retransform);
   _parser.add_dcmd_option(&_dcmd_old_object_queue_size);
+  _parser.add_dcmd_option(&_dcmd_async_sampling);
+  _parser.add_dcmd_option(&_dcmd_streamsocket);
   DEBUG_ONLY(_parser.add_dcmd_option(&_dcmd_sample_protection);)
 }
 
@@ -313,6 +354,8 @@ jboolean JfrOptionSet::_sample_protection = JNI_FALSE;
 #else
 jboolean JfrOptionSet::_sample_protection = JNI_TRUE;
 #endif
+jboolean JfrOptionSet::_async_sampling = JNI_FALSE;
+char* JfrOptionSet::_stream_socket = NULL;
 
 bool JfrOptionSet::initialize(JavaThread* thread) {
   register_parser_options();
@@ -323,6 +366,12 @@ bool JfrOptionSet::initialize(JavaThread* thread) {
     set_retransform(_dcmd_retransform.value());
   }
   set_old_object_queue_size(_dcmd_old_object_queue_size.value());
+  if (_dcmd_async_sampling.is_set()) {
+    set_async_sampling(_dcmd_async_sampling.value());
+  }
+  if (_dcmd_streamsocket.is_set() && !set_stream_socket(_dcmd_streamsocket.value())) {
+    return false;
+  }
   return adjust_memory_options();
 }
 
@@ -222,6 +222,69 @@ bool JfrStackTrace::record_thread(JavaThread& thread, frame& frame) {
   return true;
 }
 
+// Signal handler variant of record_thread(). Only walks the stack and
+// validates methods, everything else is left to record_async().
+bool JfrStackTrace::record_async_frames(JavaThread& thread, frame& frame, JfrAsyncStackFrame* frames,
+                                        u4 max_frames, u4* nr_of_frames, bool* reached_root) {
+  vframeStreamSamples st(&thread, frame, false);
+  u4 count = 0;
+  *reached_root = true;
+  while (!st.at_end()) {
+    if (count >= max_frames) {
+      *reached_root = false;
+      break;
+    }
+    const Method* method = st.method();
+    if (!Method::is_valid_method(method)) {
+      return false;
+    }
+    int type = st.is_interpreted_frame() ? JfrStackFrame::FRAME_INTERPRETER : JfrStackFrame::FRAME_JIT;
+    int bci = 0;
+    if (method->is_native()) {
+      type = JfrStackFrame::FRAME_NATIVE;
+    } else {
+      bci = st.bci();
+    }
+
+    intptr_t* frame_id = st.frame_id();
+    st.samples_next();
+    if (type == JfrStackFrame::FRAME_JIT && !st.at_end() && frame_id == st.frame_id()) {
+      type = JfrStackFrame::FRAME_INLINE;
+    }
+    frames[count]._method = method;
+    frames[count]._bci = bci;
+    frames[count]._type = (u1)type;
+    count++;
+  }
+  *nr_of_frames = count;
+  return true;
+}
+
+// Resolves frames recorded by record_async_frames(). The caller guarantees
+// that no safepoint, and hence no metadata deallocation, happened since.
+bool JfrStackTrace::record_async(const JfrAsyncStackFrame* frames, u4 nr_of_frames, bool reached_root) {
+  assert(nr_of_frames <= _max_frames, "invariant");
+  _hash = 1;
+  for (u4 i = 0; i < nr_of_frames; ++i) {
+    const Method* const method = frames[i]._method;
+    if (!Method::is_valid_method(method)) {
+      return false;
+    }
+    const traceid mid = JfrTraceId::load(method);
+    const int bci = frames[i]._bci;
+    const int type = frames[i]._type;
+    const int lineno = method->line_number_from_bci(bci);
+    _hash = (_hash * 31) + mid;
+    _hash = (_hash * 31) + bci;
+    _hash = (_hash * 31) + type;
+    _frames[i] = JfrStackFrame(mid, bci, type, lineno, method->method_holder());
+  }
+  _reached_root = reached_root;
+  _lineno = true;
+  _nr_of_frames = nr_of_frames;
+  return true;
+}
+
 void JfrStackFrame::resolve_lineno() const {
   assert(_klass, "no klass pointer");
   assert(_line == 0, "already have linenumber");
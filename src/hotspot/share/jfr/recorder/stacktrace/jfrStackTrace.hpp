@@ -33,6 +33,7 @@ class InstanceKlass;
 class JavaThread;
 class JfrCheckpointWriter;
 class JfrChunkWriter;
+class Method;
 
 class JfrStackFrame {
   friend class ObjectSampleCheckpoint;
@@ -61,7 +62,18 @@ class JfrStackFrame {
   };
 };
 
+// A frame recorded by a thread sampling itself from a signal handler.
+// Trace ids can not be loaded there, so the raw method is kept until
+// the sample is drained, see jfrAsyncSampler.hpp.
+struct JfrAsyncStackFrame {
+  const Method* _method;
+  int _bci;
+  u1 _type;
+};
+
 class JfrStackTrace : public JfrCHeapObj {
+  friend class JfrAsyncSampleBuffer;
+  friend class JfrAsyncSampleCallback;
   friend class JfrNativeSamplerCallback;
   friend class JfrStackTraceRepository;
   friend class ObjectSampleCheckpoint;
@@ -81,6 +93,7 @@ class JfrStackTrace : public JfrCHeapObj {
   mutable bool _written;
 
   const JfrStackTrace* next() const { return _next; }
+  void set_next(const JfrStackTrace* next) { _next = next; }
 
   bool should_write() const { return !_written; }
   void write(JfrChunkWriter& cw) const;
@@ -95,6 +108,9 @@ class JfrStackTrace : public JfrCHeapObj {
 
   bool record_thread(JavaThread& thread, frame& frame);
   bool record_safe(JavaThread* thread, int skip);
+  bool record_async(const JfrAsyncStackFrame* frames, u4 nr_of_frames, bool reached_root);
+  static bool record_async_frames(JavaThread& thread, frame& frame, JfrAsyncStackFrame* frames,
+                                  u4 max_frames, u4* nr_of_frames, bool* reached_root);
 
   bool have_lineno() const { return _lineno; }
   bool full_stacktrace() const { return _reached_root; }
@@ -28,7 +28,9 @@
 #include "jfr/recorder/repository/jfrChunkWriter.hpp"
 #include "jfr/recorder/stacktrace/jfrStackTraceRepository.hpp"
 #include "jfr/support/jfrThreadLocal.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "utilities/globalCounter.inline.hpp"
 
 /*
  * There are two separate repository instances.
@@ -39,7 +41,7 @@
 
 static JfrStackTraceRepository* _instance = NULL;
 static JfrStackTraceRepository* _leak_profiler_instance = NULL;
-static traceid _next_id = 0;
+static volatile traceid _next_id = 0;
 
 JfrStackTraceRepository& JfrStackTraceRepository::instance() {
   assert(_instance != NULL, "invariant");
@@ -52,7 +54,8 @@ static JfrStackTraceRepository& leak_profiler_instance() {
 }
 
 JfrStackTraceRepository::JfrStackTraceRepository() : _last_entries(0), _entries(0) {
-  memset(_table, 0, sizeof(_table));
+  memset((void*)_table, 0, sizeof(_table));
+  memset(_detached, 0, sizeof(_detached));
 }
 
 JfrStackTraceRepository* JfrStackTraceRepository::create() {
@@ -102,47 +105,62 @@ size_t JfrStackTraceRepository::write(JfrChunkWriter& sw, bool clear) {
   if (_entries == 0) {
     return 0;
   }
+  if (clear) {
+    return remove_all(&sw);
+  }
   int count = 0;
   for (u4 i = 0; i < TABLE_SIZE; ++i) {
-    JfrStackTrace* stacktrace = _table[i];
+    const JfrStackTrace* stacktrace = Atomic::load_acquire(&_table[i]);
     while (stacktrace != NULL) {
-      JfrStackTrace* next = const_cast<JfrStackTrace*>(stacktrace->next());
       if (stacktrace->should_write()) {
         stacktrace->write(sw);
         ++count;
       }
-      if (clear) {
-        delete stacktrace;
-      }
-      stacktrace = next;
+      stacktrace = stacktrace->next();
     }
   }
-  if (clear) {
-    memset(_table, 0, sizeof(_table));
-    _entries = 0;
-  }
   _last_entries = _entries;
   return count;
 }
 
-size_t JfrStackTraceRepository::clear(JfrStackTraceRepository& repo) {
-  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
-  if (repo._entries == 0) {
-    return 0;
+// Unlinks all traces, writing the ones not written yet if cw is given.
+// Traces added meanwhile go to the emptied buckets and are kept.
+size_t JfrStackTraceRepository::remove_all(JfrChunkWriter* cw) {
+  assert_lock_strong(JfrStacktrace_lock);
+  size_t count = 0;
+  u4 removed = 0;
+  for (u4 i = 0; i < TABLE_SIZE; ++i) {
+    _detached[i] = Atomic::xchg(&_table[i], (JfrStackTrace*)NULL);
+    for (const JfrStackTrace* stacktrace = _detached[i]; stacktrace != NULL; stacktrace = stacktrace->next()) {
+      if (cw != NULL && stacktrace->should_write()) {
+        stacktrace->write(*cw);
+        ++count;
+      }
+      ++removed;
+    }
   }
+  // Wait for the threads that may still be traversing the detached traces.
+  GlobalCounter::write_synchronize();
   for (u4 i = 0; i < TABLE_SIZE; ++i) {
-    JfrStackTrace* stacktrace = repo._table[i];
+    JfrStackTrace* stacktrace = _detached[i];
     while (stacktrace != NULL) {
       JfrStackTrace* next = const_cast<JfrStackTrace*>(stacktrace->next());
       delete stacktrace;
       stacktrace = next;
     }
+    _detached[i] = NULL;
   }
-  memset(repo._table, 0, sizeof(repo._table));
-  const size_t processed = repo._entries;
-  repo._entries = 0;
-  repo._last_entries = 0;
-  return processed;
+  Atomic::sub(&_entries, removed);
+  _last_entries = _entries;
+  return cw != NULL ? count : removed;
+}
+
+size_t JfrStackTraceRepository::clear(JfrStackTraceRepository& repo) {
+  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
+  if (repo._entries == 0) {
+    return 0;
+  }
+  return repo.remove_all(NULL);
 }
 
 traceid JfrStackTraceRepository::record(Thread* thread, int skip /* 0 */) {
@@ -196,25 +214,46 @@ void JfrStackTraceRepository::record_for_leak_profiler(JavaThread* thread, int s
   }
 }
 
+// Returns the trace in the list from first up to, but not including, last.
+static const JfrStackTrace* find(const JfrStackTrace* first, const JfrStackTrace* last, const JfrStackTrace& stacktrace) {
+  for (const JfrStackTrace* entry = first; entry != last; entry = entry->next()) {
+    if (entry->equals(stacktrace)) {
+      return entry;
+    }
+  }
+  return NULL;
+}
+
 traceid JfrStackTraceRepository::add_trace(const JfrStackTrace& stacktrace) {
-  MutexLocker lock(JfrStacktrace_lock, Mutex::_no_safepoint_check_flag);
   const size_t index = stacktrace._hash % TABLE_SIZE;
-  const JfrStackTrace* table_entry = _table[index];
-
-  while (table_entry != NULL) {
-    if (table_entry->equals(stacktrace)) {
-      return table_entry->id();
-    }
-    table_entry = table_entry->next();
+  GlobalCounter::CriticalSection cs(Thread::current());
+  JfrStackTrace* head = Atomic::load_acquire(&_table[index]);
+  const JfrStackTrace* const table_entry = find(head, NULL, stacktrace);
+  if (table_entry != NULL) {
+    return table_entry->id();
   }
 
   if (!stacktrace.have_lineno()) {
     return 0;
   }
 
-  traceid id = ++_next_id;
-  _table[index] = new JfrStackTrace(id, stacktrace, _table[index]);
-  ++_entries;
+  const traceid id = Atomic::add(&_next_id, (traceid)1);
+  JfrStackTrace* const entry = new JfrStackTrace(id, stacktrace, head);
+  while (true) {
+    JfrStackTrace* const witness = Atomic::cmpxchg(&_table[index], head, entry);
+    if (witness == head) {
+      break;
+    }
+    // Another thread pushed first, possibly the same trace.
+    const JfrStackTrace* const other = find(witness, head, stacktrace);
+    if (other != NULL) {
+      delete entry;
+      return other->id();
+    }
+    head = witness;
+    entry->set_next(head);
+  }
+  Atomic::inc(&_entries);
   return id;
 }
 
@@ -45,9 +45,13 @@ class JfrStackTraceRepository : public JfrCHeapObj {
 
  private:
   static const u4 TABLE_SIZE = 2053;
-  JfrStackTrace* _table[TABLE_SIZE];
+  // Traces are pushed on the buckets with a CAS and looked up without
+  // locking. JfrStacktrace_lock serializes writing and clearing, which free
+  // the traces only after a GlobalCounter synchronization.
+  JfrStackTrace* volatile _table[TABLE_SIZE];
+  JfrStackTrace* _detached[TABLE_SIZE];
   u4 _last_entries;
-  u4 _entries;
+  volatile u4 _entries;
 
   JfrStackTraceRepository();
   static JfrStackTraceRepository& instance();
@@ -59,6 +63,7 @@ class JfrStackTraceRepository : public JfrCHeapObj {
   static size_t clear();
   static size_t clear(JfrStackTraceRepository& repo);
   size_t write(JfrChunkWriter& cw, bool clear);
+  size_t remove_all(JfrChunkWriter* cw);
 
   static const JfrStackTrace* lookup_for_leak_profiler(unsigned int hash, traceid id);
   static void record_for_leak_profiler(JavaThread* thread, int skip = 0);
@@ -27,6 +27,7 @@
 #include "jfr/jni/jfrJavaSupport.hpp"
 #include "jfr/leakprofiler/checkpoint/objectSampleCheckpoint.hpp"
 #include "jfr/periodic/jfrThreadCPULoadEvent.hpp"
+#include "jfr/periodic/sampling/jfrAsyncSampler.hpp"
 #include "jfr/recorder/checkpoint/jfrCheckpointManager.hpp"
 #include "jfr/recorder/checkpoint/types/traceid/jfrTraceIdEpoch.hpp"
 #include "jfr/recorder/jfrRecorder.hpp"
@@ -35,6 +36,7 @@
 #include "jfr/support/jfrThreadLocal.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/arena.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
 #include "runtime/thread.inline.hpp"
 #include "utilities/sizes.hpp"
@@ -47,6 +49,7 @@ JfrThreadLocal::JfrThreadLocal() :
   _load_barrier_buffer_epoch_0(NULL),
   _load_barrier_buffer_epoch_1(NULL),
   _stackframes(NULL),
+  _async_samples(NULL),
   _dcmd_arena(nullptr),
   _trace_id(JfrTraceId::assign_thread_id()),
   _thread(),
@@ -64,6 +67,16 @@ JfrThreadLocal::JfrThreadLocal() :
   _parent_trace_id = thread != NULL ? thread->jfr_thread_local()->trace_id() : (traceid)0;
 }
 
+JfrThreadLocal::~JfrThreadLocal() {
+  // Freed only here, the drain may still look at the samples of an exited thread.
+  JfrAsyncSampler::release(this);
+}
+
+bool JfrThreadLocal::install_async_samples(JfrAsyncSampleBuffer* buffer) {
+  assert(buffer != NULL, "invariant");
+  return Atomic::cmpxchg(&_async_samples, (JfrAsyncSampleBuffer*)NULL, buffer) == NULL;
+}
+
 u8 JfrThreadLocal::add_data_lost(u8 value) {
   _data_lost += value;
   return _data_lost;
@@ -101,6 +114,9 @@ void JfrThreadLocal::on_start(Thread* t) {
       }
     }
   }
+  if (t->is_Java_thread()) {
+    JfrAsyncSampler::on_thread_start(t->as_Java_thread());
+  }
   if (t->jfr_thread_local()->has_cached_stack_trace()) {
     t->jfr_thread_local()->clear_cached_stack_trace();
   }
@@ -164,6 +180,9 @@ void JfrThreadLocal::on_exit(Thread* t) {
   assert(t != NULL, "invariant");
   JfrThreadLocal * const tl = t->jfr_thread_local();
   assert(!tl->is_dead(), "invariant");
+  if (t->is_Java_thread()) {
+    JfrAsyncSampler::on_thread_exit(t->as_Java_thread());
+  }
   if (JfrRecorder::is_recording()) {
     if (t->is_Java_thread()) {
       JavaThread* const jt = t->as_Java_thread();
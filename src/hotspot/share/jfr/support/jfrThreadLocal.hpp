@@ -30,6 +30,7 @@
 
 class Arena;
 class JavaThread;
+class JfrAsyncSampleBuffer;
 class JfrBuffer;
 class JfrStackFrame;
 class Thread;
@@ -43,6 +44,7 @@ class JfrThreadLocal {
   JfrBuffer* _load_barrier_buffer_epoch_0;
   JfrBuffer* _load_barrier_buffer_epoch_1;
   mutable JfrStackFrame* _stackframes;
+  JfrAsyncSampleBuffer* volatile _async_samples;
   Arena* _dcmd_arena;
   mutable traceid _trace_id;
   JfrBlobHandle _thread;
@@ -66,6 +68,7 @@ class JfrThreadLocal {
 
  public:
   JfrThreadLocal();
+  ~JfrThreadLocal();
 
   JfrBuffer* native_buffer() const {
     return _native_buffer != NULL ? _native_buffer : install_native_buffer();
@@ -119,6 +122,12 @@ class JfrThreadLocal {
     _stackframes = frames;
   }
 
+  JfrAsyncSampleBuffer* async_samples() const {
+    return _async_samples;
+  }
+
+  bool install_async_samples(JfrAsyncSampleBuffer* buffer);
+
   u4 stackdepth() const;
 
   void set_stackdepth(u4 depth) {
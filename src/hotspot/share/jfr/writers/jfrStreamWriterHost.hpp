@@ -47,6 +47,7 @@ class StreamWriterHost : public MemoryWriterHost<Adapter, AP> {
   void write_bytes(void* dest, const void* src, intptr_t len);
   void flush(size_t size);
   bool has_valid_fd() const;
+  fio_fd fd() const { return _fd; }
 
  public:
   int64_t current_offset() const;
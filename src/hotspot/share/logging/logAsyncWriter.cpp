@@ -29,6 +29,8 @@
 #include "logging/logHandle.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/os.inline.hpp"
+#include "runtime/thread.hpp"
+#include "utilities/powerOfTwo.hpp"
 
 class AsyncLogWriter::AsyncLogLocker : public StackObj {
  public:
@@ -42,60 +44,170 @@ class AsyncLogWriter::AsyncLogLocker : public StackObj {
   }
 };
 
-void AsyncLogWriter::enqueue_locked(const AsyncLogMessage& msg) {
-  if (_buffer.size() >= _buffer_max_size) {
-    bool p_created;
-    uint32_t* counter = _stats.add_if_absent(msg.output(), 0, &p_created);
-    *counter = *counter + 1;
+AsyncLogMessage* AsyncLogMessage::create(LogFileStreamOutput* output, const LogDecorations& decorations, const char* msg) {
+  size_t len = strlen(msg) + 1;
+  char* mem = (char*)os::malloc(sizeof(AsyncLogMessage) + len, mtLogging);
+  if (mem == nullptr) {
+    return nullptr;
+  }
+  char* text = mem + sizeof(AsyncLogMessage);
+  memcpy(text, msg, len);
+  return ::new (mem) AsyncLogMessage(output, decorations, os::javaTimeNanos(), text);
+}
+
+void AsyncLogMessage::destroy(AsyncLogMessage* m) {
+  m->~AsyncLogMessage();
+  os::free(m);
+}
+
+AsyncLogStripe::AsyncLogStripe(size_t capacity)
+  : _slots(NEW_C_HEAP_ARRAY(Slot, capacity, mtLogging)),
+    _capacity(capacity),
+    _enqueue_pos(0),
+    _pending(0),
+    _dequeue_pos(0) {
+  assert(is_power_of_2(capacity), "must be");
+  for (size_t i = 0; i < capacity; i++) {
+    _slots[i]._seq = i;
+    _slots[i]._message = nullptr;
+  }
+}
+
+bool AsyncLogStripe::try_reserve(size_t lines) {
+  size_t pending = Atomic::load(&_pending);
+  while (pending + lines <= _capacity) {
+    size_t old = Atomic::cmpxchg(&_pending, pending, pending + lines);
+    if (old == pending) {
+      return true;
+    }
+    pending = old;
+  }
+  return false;
+}
+
+void AsyncLogStripe::release(size_t lines) {
+  assert(Atomic::load(&_pending) >= lines, "released more than reserved");
+  Atomic::sub(&_pending, lines);
+}
+
+// The slot for position pos is free when its sequence number is pos, and
+// holds a message when it is pos + 1. Since each message has at least one
+// reserved line, a producer with a reservation always finds a free slot.
+void AsyncLogStripe::push(AsyncLogMessage* m) {
+  size_t pos = Atomic::fetch_and_add(&_enqueue_pos, (size_t)1);
+  Slot* slot = &_slots[pos & (_capacity - 1)];
+  while (Atomic::load_acquire(&slot->_seq) != pos) {
+    // The previous message in this slot still holds its reservation, so it
+    // has already been taken; wait until that is visible.
+    SpinPause();
+  }
+  slot->_message = m;
+  Atomic::release_store(&slot->_seq, pos + 1);
+}
+
+AsyncLogMessage* AsyncLogStripe::pop() {
+  Slot* slot = &_slots[_dequeue_pos & (_capacity - 1)];
+  if (Atomic::load_acquire(&slot->_seq) != _dequeue_pos + 1) {
+    return nullptr;
+  }
+  AsyncLogMessage* m = slot->_message;
+  Atomic::release_store(&slot->_seq, _dequeue_pos + _capacity);
+  _dequeue_pos++;
+  return m;
+}
+
+AsyncLogStripe* AsyncLogWriter::current_stripe() {
+  // Threads not attached to the VM share the first stripe.
+  uintptr_t hash = (uintptr_t)Thread::current_or_null();
+  hash ^= hash >> 12;
+  return _stripes[(hash >> 6) % stripe_count];
+}
+
+void AsyncLogWriter::notify() {
+  if (!Atomic::load(&_data_available) &&
+      !Atomic::cmpxchg(&_data_available, false, true)) {
+    _data_sem.signal();
+  }
+}
+
+void AsyncLogWriter::enqueue(AsyncLogStripe* stripe, AsyncLogMessage* msgs, size_t lines) {
+  if (!stripe->try_reserve(lines)) {
     // drop the enqueueing message.
-    os::free(msg.message());
+    LogFileStreamOutput* output = msgs->output();
+    while (msgs != nullptr) {
+      AsyncLogMessage* next = msgs->next();
+      AsyncLogMessage::destroy(msgs);
+      msgs = next;
+    }
+    AsyncLogLocker locker;
+    bool p_created;
+    uint32_t* counter = _stats.add_if_absent(output, 0, &p_created);
+    *counter = *counter + (uint32_t)lines;
     return;
   }
 
-  _buffer.push_back(msg);
-  _data_available = true;
-  _lock.notify();
+  stripe->push(msgs);
+  notify();
 }
 
 void AsyncLogWriter::enqueue(LogFileStreamOutput& output, const LogDecorations& decorations, const char* msg) {
-  AsyncLogMessage m(&output, decorations, os::strdup(msg));
-
-  { // critical area
-    AsyncLogLocker locker;
-    enqueue_locked(m);
+  AsyncLogMessage* m = AsyncLogMessage::create(&output, decorations, msg);
+  if (m != nullptr) {
+    enqueue(current_stripe(), m, 1);
   }
 }
 
 // LogMessageBuffer consists of a multiple-part/multiple-line messsage.
-// The lock here guarantees its integrity.
+// Its lines are enqueued as one chain to guarantee its integrity.
 void AsyncLogWriter::enqueue(LogFileStreamOutput& output, LogMessageBuffer::Iterator msg_iterator) {
-  AsyncLogLocker locker;
+  AsyncLogMessage* head = nullptr;
+  AsyncLogMessage* tail = nullptr;
+  size_t lines = 0;
 
   for (; !msg_iterator.is_at_end(); msg_iterator++) {
-    AsyncLogMessage m(&output, msg_iterator.decorations(), os::strdup(msg_iterator.message()));
-    enqueue_locked(m);
+    AsyncLogMessage* m = AsyncLogMessage::create(&output, msg_iterator.decorations(), msg_iterator.message());
+    if (m == nullptr) {
+      continue;
+    }
+    if (tail == nullptr) {
+      head = m;
+    } else {
+      tail->set_next(m);
+    }
+    tail = m;
+    lines++;
+  }
+
+  if (head != nullptr) {
+    enqueue(current_stripe(), head, lines);
   }
 }
 
 AsyncLogWriter::AsyncLogWriter()
-  : _flush_sem(0), _lock(), _block_async(), _data_available(false),
-    _initialized(false),
+  : _flush_sem(0), _data_sem(0), _lock(), _block_async(), _data_available(false),
+    _flush_requests(0), _initialized(false),
     _stats(17 /*table_size*/) {
+  size_t stripe_capacity = round_up_power_of_2(MAX2(_buffer_max_size / stripe_count, (size_t)16));
+  for (uint i = 0; i < stripe_count; i++) {
+    _stripes[i] = new AsyncLogStripe(stripe_capacity);
+  }
+
   if (os::create_thread(this, os::asynclog_thread)) {
     _initialized = true;
   } else {
     log_warning(logging, thread)("AsyncLogging failed to create thread. Falling back to synchronous logging.");
   }
 
-  log_info(logging)("The maximum entries of AsyncLogBuffer: " SIZE_FORMAT ", estimated memory use: " SIZE_FORMAT " bytes",
-                    _buffer_max_size, AsyncLogBufferSize);
+  log_info(logging)("The maximum entries of AsyncLogBuffer: " SIZE_FORMAT " in %u stripes, estimated memory use: " SIZE_FORMAT " bytes",
+                    stripe_capacity * stripe_count, stripe_count, AsyncLogBufferSize);
 }
 
 class AsyncLogMapIterator {
-  AsyncLogBuffer& _logs;
+  AsyncLogMessage* _head;
+  AsyncLogMessage* _tail;
 
  public:
-  AsyncLogMapIterator(AsyncLogBuffer& logs) :_logs(logs) {}
+  AsyncLogMapIterator() : _head(nullptr), _tail(nullptr) {}
   bool do_entry(LogFileStreamOutput* output, uint32_t* counter) {
     using none = LogTagSetMapping<LogTag::__NO_TAG>;
 
@@ -103,66 +215,84 @@ class AsyncLogMapIterator {
       LogDecorations decorations(LogLevel::Warning, none::tagset(), LogDecorators::All);
       stringStream ss;
       ss.print(UINT32_FORMAT_W(6) " messages dropped due to async logging", *counter);
-      AsyncLogMessage msg(output, decorations, ss.as_string(true /*c_heap*/));
-      _logs.push_back(msg);
+      AsyncLogMessage* msg = AsyncLogMessage::create(output, decorations, ss.base());
+      if (msg != nullptr) {
+        if (_tail == nullptr) {
+          _head = msg;
+        } else {
+          _tail->set_next(msg);
+        }
+        _tail = msg;
+      }
       *counter = 0;
     }
 
     return true;
   }
-};
 
-void AsyncLogWriter::write() {
-  // Use kind of copy-and-swap idiom here.
-  // Empty 'logs' swaps the content with _buffer.
-  // Along with logs destruction, all processed messages are deleted.
-  //
-  // The operation 'pop_all()' is done in O(1). All I/O jobs are then performed without
-  // lock protection. This guarantees I/O jobs don't block logsites.
-  AsyncLogBuffer logs;
-
-  { // critical region
-    AsyncLogLocker locker;
+  AsyncLogMessage* messages() const { return _head; }
+};
 
-    _buffer.pop_all(&logs);
-    // append meta-messages of dropped counters
-    AsyncLogMapIterator dropped_counters_iter(logs);
-    _stats.iterate(&dropped_counters_iter);
-    _data_available = false;
+// Writes the lines of a message, returns the number of lines.
+static size_t write_message(AsyncLogMessage* m) {
+  size_t lines = 0;
+  while (m != nullptr) {
+    AsyncLogMessage* next = m->next();
+    m->output()->write_blocking(m->decorations(), m->message());
+    AsyncLogMessage::destroy(m);
+    m = next;
+    lines++;
   }
+  return lines;
+}
 
-  LinkedListIterator<AsyncLogMessage> it(logs.head());
-
-  int req = 0;
-  while (!it.is_empty()) {
-    AsyncLogMessage* e = it.next();
-    char* msg = e->message();
-
-    if (msg != nullptr) {
-      e->output()->write_blocking(e->decorations(), msg);
-      os::free(msg);
-    } else if (e->output() == nullptr) {
-      // This is a flush token. Record that we found it and then
-      // signal the flushing thread after the loop.
-      req++;
+void AsyncLogWriter::write() {
+  // A log site or flush() that finds _data_available cleared signals again.
+  // Messages and flush requests from before that are seen below.
+  Atomic::release_store_fence(&_data_available, false);
+  int flush_requests = Atomic::load_acquire(&_flush_requests);
+
+  // The messages of each stripe are in the order they were enqueued.
+  // All I/O jobs are performed without lock protection. This guarantees
+  // I/O jobs don't block logsites.
+  AsyncLogMessage* heads[stripe_count];
+  for (uint i = 0; i < stripe_count; i++) {
+    heads[i] = _stripes[i]->pop();
+  }
+  while (true) {
+    uint next = stripe_count;
+    for (uint i = 0; i < stripe_count; i++) {
+      if (heads[i] != nullptr &&
+          (next == stripe_count || heads[i]->timestamp() < heads[next]->timestamp())) {
+        next = i;
+      }
+    }
+    if (next == stripe_count) {
+      break;
     }
+    AsyncLogMessage* m = heads[next];
+    heads[next] = _stripes[next]->pop();
+    _stripes[next]->release(write_message(m));
+  }
+
+  // append meta-messages of dropped counters
+  AsyncLogMapIterator dropped_counters_iter;
+  {
+    AsyncLogLocker locker;
+    _stats.iterate(&dropped_counters_iter);
   }
+  write_message(dropped_counters_iter.messages());
 
-  if (req > 0) {
-    assert(req == 1, "AsyncLogWriter::flush() is NOT MT-safe!");
-    _flush_sem.signal(req);
+  if (flush_requests > 0) {
+    assert(flush_requests == 1, "AsyncLogWriter::flush() is NOT MT-safe!");
+    Atomic::sub(&_flush_requests, flush_requests);
+    _flush_sem.signal(flush_requests);
   }
 }
 
 void AsyncLogWriter::run() {
   while (true) {
-    {
-      AsyncLogLocker locker;
-
-      while (!_data_available) {
-        _lock.wait(0/* no timeout */);
-      }
-    }
+    _data_sem.wait();
 
     write();
 
@@ -196,23 +326,14 @@ AsyncLogWriter* AsyncLogWriter::instance() {
   return _instance;
 }
 
-// Inserts a flush token into the async output buffer and waits until the AsyncLog thread
-// signals that it has seen it and completed all dequeued message processing.
+// Requests a flush and waits until the AsyncLog thread signals that it has written
+// all messages enqueued before the request.
 // This method is not MT-safe in itself, but is guarded by another lock in the usual
 // usecase - see the comments in the header file for more details.
 void AsyncLogWriter::flush() {
   if (_instance != nullptr) {
-    {
-      using none = LogTagSetMapping<LogTag::__NO_TAG>;
-      AsyncLogLocker locker;
-      LogDecorations d(LogLevel::Off, none::tagset(), LogDecorators::None);
-      AsyncLogMessage token(nullptr, d, nullptr);
-
-      // Push directly in-case we are at logical max capacity, as this must not get dropped.
-      _instance->_buffer.push_back(token);
-      _instance->_data_available = true;
-      _instance->_lock.notify();
-    }
+    Atomic::inc(&_instance->_flush_requests);
+    _instance->notify();
 
     _instance->_flush_sem.wait();
   }
@@ -26,6 +26,7 @@
 #include "logging/log.hpp"
 #include "logging/logDecorations.hpp"
 #include "logging/logMessageBuffer.hpp"
+#include "memory/padded.hpp"
 #include "memory/resourceArea.hpp"
 #include "runtime/nonJavaThread.hpp"
 #include "runtime/semaphore.hpp"
@@ -93,31 +94,69 @@ class LinkedListDeque : private LinkedListImpl<E, ResourceObj::C_HEAP, F> {
 // Forward declaration
 class LogFileStreamOutput;
 
+// A log line waiting to be written. The lines of a multi-part message are
+// chained, so that they are written together.
 class AsyncLogMessage {
   LogFileStreamOutput* _output;
   const LogDecorations _decorations;
+  const jlong _timestamp;   // to write the stripes in order
+  AsyncLogMessage* _next;
   char* _message;
 
-public:
-  AsyncLogMessage(LogFileStreamOutput* output, const LogDecorations& decorations, char* msg)
-    : _output(output), _decorations(decorations), _message(msg) {}
+  AsyncLogMessage(LogFileStreamOutput* output, const LogDecorations& decorations, jlong timestamp, char* msg)
+    : _output(output), _decorations(decorations), _timestamp(timestamp), _next(nullptr), _message(msg) {}
 
-  // placeholder for LinkedListImpl.
-  bool equals(const AsyncLogMessage& o) const { return false; }
+public:
+  // The message text is copied into the same allocation.
+  static AsyncLogMessage* create(LogFileStreamOutput* output, const LogDecorations& decorations, const char* msg);
+  static void destroy(AsyncLogMessage* m);
 
   LogFileStreamOutput* output() const { return _output; }
   const LogDecorations& decorations() const { return _decorations; }
+  jlong timestamp() const { return _timestamp; }
   char* message() const { return _message; }
+
+  AsyncLogMessage* next() const { return _next; }
+  void set_next(AsyncLogMessage* m) { _next = m; }
+};
+
+// A bounded multi-producer, single-consumer ring of messages. The log sites
+// are spread over a few of them by thread, so that they rarely contend.
+// Producers reserve room for their lines before pushing, and the AsyncLog
+// Thread releases it once the lines are written.
+class AsyncLogStripe : public CHeapObj<mtLogging> {
+  struct Slot {
+    volatile size_t _seq;
+    AsyncLogMessage* _message;
+  };
+
+  Slot* const _slots;
+  const size_t _capacity;
+  DEFINE_PAD_MINUS_SIZE(0, DEFAULT_CACHE_LINE_SIZE, sizeof(Slot*) + sizeof(size_t));
+  volatile size_t _enqueue_pos;
+  volatile size_t _pending;   // number of lines reserved
+  DEFINE_PAD_MINUS_SIZE(1, DEFAULT_CACHE_LINE_SIZE, 2 * sizeof(size_t));
+  size_t _dequeue_pos;        // only used by the AsyncLog Thread
+
+ public:
+  AsyncLogStripe(size_t capacity);
+
+  bool try_reserve(size_t lines);
+  void release(size_t lines);
+
+  void push(AsyncLogMessage* m);
+  AsyncLogMessage* pop();
 };
 
-typedef LinkedListDeque<AsyncLogMessage, mtLogging> AsyncLogBuffer;
 typedef KVHashtable<LogFileStreamOutput*, uint32_t, mtLogging> AsyncLogMap;
 
 //
 // ASYNC LOGGING SUPPORT
 //
 // Summary:
-// Async Logging is working on the basis of singleton AsyncLogWriter, which manages an intermediate buffer and a flushing thread.
+// Async Logging is working on the basis of singleton AsyncLogWriter, which manages intermediate buffers and a flushing thread.
+// The log sites push their messages into one of a few lock-free stripes, chosen by thread. The flushing thread takes the
+// messages from all stripes and writes them merged by the time they were enqueued.
 //
 // Interface:
 //
@@ -128,7 +167,7 @@ typedef KVHashtable<LogFileStreamOutput*, uint32_t, mtLogging> AsyncLogMap;
 // successfully initialized. Clients can use its return value to determine async logging is established or not.
 //
 // enqueue() is the basic operation of AsyncLogWriter. Two overloading versions of it are provided to match LogOutput::write().
-// They are both MT-safe and non-blocking. Derived classes of LogOutput can invoke the corresponding enqueue() in write() and
+// They are both MT-safe and non-blocking. If the stripe of the log site is full, the message is dropped and counted. Derived classes of LogOutput can invoke the corresponding enqueue() in write() and
 // return 0. AsyncLogWriter is responsible of copying neccessary data.
 //
 // flush() ensures that all pending messages have been written out before it returns. It is not MT-safe in itself. When users
@@ -138,22 +177,28 @@ class AsyncLogWriter : public NonJavaThread {
   class AsyncLogLocker;
 
   static AsyncLogWriter* _instance;
+  static const uint stripe_count = 8;
+
   Semaphore _flush_sem;
+  Semaphore _data_sem;
   // Can't use a Monitor here as we need a low-level API that can be used without Thread::current().
-  os::PlatformMonitor _lock;
+  os::PlatformMonitor _lock;  // guards _stats
   // for asynchronous thread run()
   os::PlatformMonitor _block_async;
-  bool _data_available;
+  volatile bool _data_available;
+  volatile int _flush_requests;
   volatile bool _initialized;
   AsyncLogMap _stats; // statistics for dropped messages
-  AsyncLogBuffer _buffer;
+  AsyncLogStripe* _stripes[stripe_count];
 
   // The memory use of each AsyncLogMessage (payload) consists of itself and a variable-length c-str message.
   // A regular logging message is smaller than vwrite_buffer_size, which is defined in logtagset.cpp
   const size_t _buffer_max_size = {AsyncLogBufferSize / (sizeof(AsyncLogMessage) + vwrite_buffer_size)};
 
   AsyncLogWriter();
-  void enqueue_locked(const AsyncLogMessage& msg);
+  AsyncLogStripe* current_stripe();
+  void enqueue(AsyncLogStripe* stripe, AsyncLogMessage* msgs, size_t lines);
+  void notify();
   void write();
   void run() override;
   void pre_run() override {
@@ -570,6 +570,8 @@ void LogConfiguration::print_command_line_help(outputStream* out) {
   out->print_cr("   filecount=.. - Number of files to keep in rotation (not counting the active file)."
                                     " If set to 0, log rotation is disabled."
                                     " This will cause existing log files to be overwritten.");
+  out->print_cr("   format=..    - text (default) or binary, which writes undecorated records"
+                                    " that src/utils/logdecode prints as text.");
   out->cr();
   out->print_cr("\nAsynchronous logging (off by default):");
   out->print_cr(" -Xlog:async");
@@ -64,6 +64,14 @@ class LogDecorations {
     _level = level;
   }
 
+  // The resolved values, 0 for decorators that were not requested
+  jlong millis() const              { return _millis; }
+  jlong nanos() const               { return _nanos; }
+  double elapsed_seconds() const    { return _elapsed_seconds; }
+  intx tid() const                  { return _tid; }
+  LogLevelType level() const        { return _level; }
+  const LogTagSet& tagset() const   { return _tagset; }
+
   void print_decoration(LogDecorators::Decorator decorator, outputStream* st) const;
   const char* decoration(LogDecorators::Decorator decorator, char* buf, size_t buflen) const;
 
@@ -40,6 +40,7 @@ const char* const LogFileOutput::TimestampFilenamePlaceholder = "%t";
 const char* const LogFileOutput::TimestampFormat = "%Y-%m-%d_%H-%M-%S";
 const char* const LogFileOutput::FileSizeOptionKey = "filesize";
 const char* const LogFileOutput::FileCountOptionKey = "filecount";
+const char* const LogFileOutput::FormatOptionKey = "format";
 char        LogFileOutput::_pid_str[PidBufferSize];
 char        LogFileOutput::_vm_start_time_str[StartTimeBufferSize];
 
@@ -211,6 +212,16 @@ bool LogFileOutput::parse_options(const char* options, outputStream* errstream)
         break;
       }
       _rotate_size = static_cast<size_t>(value);
+    } else if (strcmp(FormatOptionKey, key) == 0) {
+      if (strcmp(value_str, "binary") == 0) {
+        _binary = true;
+      } else if (strcmp(value_str, "text") == 0) {
+        _binary = false;
+      } else {
+        errstream->print_cr("Invalid option: %s must be text or binary", FormatOptionKey);
+        success = false;
+        break;
+      }
     } else {
       errstream->print_cr("Invalid option '%s' for log file output.", key);
       success = false;
@@ -277,9 +288,21 @@ bool LogFileOutput::initialize(const char* options, outputStream* errstream) {
     os::ftruncate(os::get_fileno(_stream), 0);
   }
 
+  begin_file();
   return true;
 }
 
+// Binary files are self-describing, in case the file gets reopened or
+// rotated they start over with the tagset ids.
+void LogFileOutput::begin_file() {
+  if (_binary) {
+    int written = write_binary_prologue();
+    if (written > 0) {
+      _current_size += written;
+    }
+  }
+}
+
 class RotationLocker : public StackObj {
   Semaphore& _sem;
 
@@ -401,6 +424,7 @@ void LogFileOutput::rotate() {
   // Reset accumulated size, increase current file counter, and check for file count wrap-around.
   _current_size = 0;
   increment_file_count();
+  begin_file();
 }
 
 char* LogFileOutput::make_file_name(const char* file_name,
@@ -494,6 +518,9 @@ void LogFileOutput::describe(outputStream *out) {
              byte_size_in_proper_unit(_rotate_size),
              proper_unit_for_byte_size(_rotate_size),
              LogConfiguration::is_async_mode() ? "true" : "false");
+  if (_binary) {
+    out->print(",%s=binary", FormatOptionKey);
+  }
 }
 
 int LogFileOutput::fd_get() const {
@@ -527,4 +554,5 @@ void LogFileOutput::reopen() {
 
   // _current_size still keeps how much data we wrote for the rotation purposes.
   // The log file may contain more data now.
+  begin_file();
 }
@@ -28,6 +28,7 @@
 #include "logging/logDecorations.hpp"
 #include "logging/logFileStreamOutput.hpp"
 #include "logging/logMessageBuffer.hpp"
+#include "logging/logTagSet.hpp"
 #include "memory/allocation.inline.hpp"
 #include "utilities/defaultStream.hpp"
 
@@ -118,8 +119,56 @@ bool LogFileStreamOutput::flush() {
   total += result;                                            \
 }
 
+struct BinaryMessageHeader {
+  jlong millis;
+  jlong uptime_nanos;
+  jlong tid;
+  u2 tagset;
+  u1 level;
+};
+
+int LogFileStreamOutput::write_binary_record(u1 kind, const void* header, size_t header_size, const char* str) {
+  size_t str_len = strlen(str);
+  u4 length = (u4)(sizeof(kind) + header_size + str_len);
+  if (fwrite(&length, sizeof(length), 1, _stream) != 1 ||
+      fwrite(&kind, sizeof(kind), 1, _stream) != 1 ||
+      (header_size > 0 && fwrite(header, header_size, 1, _stream) != 1) ||
+      (str_len > 0 && fwrite(str, str_len, 1, _stream) != 1)) {
+    return -1;
+  }
+  return (int)(sizeof(length) + length);
+}
+
+int LogFileStreamOutput::write_binary_prologue() {
+  int written = 0;
+  const u2 format[] = { BinaryFormatVersion, 0x0102 };
+  WRITE_LOG_WITH_RESULT_CHECK(write_binary_record(BinaryFormatRecord, format, sizeof(format), ""), written);
+
+  char label[128];
+  for (LogTagSet* ts = LogTagSet::first(); ts != NULL; ts = ts->next()) {
+    const u2 id = (u2)ts->id();
+    ts->label(label, sizeof(label));
+    WRITE_LOG_WITH_RESULT_CHECK(write_binary_record(BinaryTagSetRecord, &id, sizeof(id), label), written);
+  }
+  return written;
+}
+
 int LogFileStreamOutput::write_internal(const LogDecorations& decorations, const char* msg) {
   int written = 0;
+
+  if (_binary) {
+    BinaryMessageHeader header;
+    header.millis = decorations.millis();
+    header.uptime_nanos = (jlong)(decorations.elapsed_seconds() * NANOSECS_PER_SEC);
+    header.tid = decorations.tid();
+    header.tagset = (u2)decorations.tagset().id();
+    header.level = (u1)decorations.level();
+    // Without the trailing padding; the fields are naturally aligned.
+    const size_t header_size = offset_of(BinaryMessageHeader, level) + sizeof(header.level);
+    WRITE_LOG_WITH_RESULT_CHECK(write_binary_record(BinaryMessageRecord, &header, header_size, msg), written);
+    return written;
+  }
+
   const bool use_decorations = !_decorators.is_empty();
 
   if (use_decorations) {
@@ -39,21 +39,43 @@ class LogFileStreamInitializer {
 static LogFileStreamInitializer log_stream_initializer;
 
 // Base class for all FileStream-based log outputs.
+//
+// With the binary format, the decorations are not formatted. The stream is a
+// sequence of records in native byte order, each a u4 length of the rest of
+// the record, a u1 record kind and the payload:
+//  - BinaryFormatRecord:  u2 version, u2 0x0102 to tell the byte order
+//  - BinaryTagSetRecord:  u2 tagset id, the tagset label
+//  - BinaryMessageRecord: s8 time in ms, s8 uptime in ns, s8 tid, u2 tagset
+//                         id, u1 level, the message
+// The first two are written whenever a file is opened. Decorators that are
+// not configured for the output are written as 0. src/utils/logdecode
+// prints such a file as text.
 class LogFileStreamOutput : public LogOutput {
  private:
   bool                _write_error_is_shown;
 
  protected:
+  enum BinaryRecordKind {
+    BinaryFormatRecord,
+    BinaryTagSetRecord,
+    BinaryMessageRecord
+  };
+  static const u2 BinaryFormatVersion = 1;
+
   FILE*               _stream;
   size_t              _decorator_padding[LogDecorators::Count];
+  bool                _binary;
 
-  LogFileStreamOutput(FILE *stream) : _write_error_is_shown(false), _stream(stream) {
+  LogFileStreamOutput(FILE *stream) : _write_error_is_shown(false), _stream(stream), _binary(false) {
     for (size_t i = 0; i < LogDecorators::Count; i++) {
       _decorator_padding[i] = 0;
     }
   }
 
   int write_decorations(const LogDecorations& decorations);
+  int write_binary_record(u1 kind, const void* header, size_t header_size, const char* str);
+  // Writes the format and tagset records that start a binary file
+  int write_binary_prologue();
   int write_internal(const LogDecorations& decorations, const char* msg);
   bool flush();
 
@@ -40,7 +40,7 @@ size_t      LogTagSet::_ntagsets  = 0;
 // This constructor is called only during static initialization.
 // See the declaration in logTagSet.hpp for more information.
 LogTagSet::LogTagSet(PrefixWriter prefix_writer, LogTagType t0, LogTagType t1, LogTagType t2, LogTagType t3, LogTagType t4)
-    : _next(_list), _write_prefix(prefix_writer) {
+    : _next(_list), _id((uint)_ntagsets), _write_prefix(prefix_writer) {
   _tag[0] = t0;
   _tag[1] = t1;
   _tag[2] = t2;
@@ -44,6 +44,7 @@ class LogTagSet {
   static size_t _ntagsets;
 
   LogTagSet* const _next;
+  const uint _id;   // identifies the tagset in binary log files
   size_t _ntags;
   LogTagType _tag[LogTag::MaxTags];
 
@@ -83,6 +84,10 @@ class LogTagSet {
     return _next;
   }
 
+  uint id() const {
+    return _id;
+  }
+
   size_t ntags() const {
     return _ntags;
   }
@@ -28,6 +28,7 @@
 #include "memory/resourceArea.hpp"
 #include "runtime/os.hpp"
 #include "runtime/task.hpp"
+#include "runtime/thread.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/memTracker.hpp"
 #include "runtime/trimNativeHeap.hpp"
@@ -44,11 +45,8 @@ class ChunkPool: public CHeapObj<mtInternal> {
   size_t       _num_used;     // number of chunks currently checked out
   const size_t _size;         // size of each chunk (must be uniform)
 
-  // Our four static pools
-  static ChunkPool* _large_pool;
-  static ChunkPool* _medium_pool;
-  static ChunkPool* _small_pool;
-  static ChunkPool* _tiny_pool;
+  // Our four static pools: large, medium, small and tiny
+  static ChunkPool* _pools[ChunkCache::num_pools];
 
   // return first element or null
   void* get_first() {
@@ -93,69 +91,135 @@ class ChunkPool: public CHeapObj<mtInternal> {
     _num_chunks++;
   }
 
-  // Prune the pool
-  void free_all_but(size_t n) {
+  // Prune the pool, returns the number of bytes freed
+  size_t free_all_but(size_t n) {
     Chunk* cur = NULL;
     Chunk* next;
+    size_t freed = 0;
     {
       // if we have more than n chunks, free all of them
       ThreadCritical tc;
       if (_num_chunks > n) {
-        // free chunks at end of queue, for better locality
-        cur = _first;
-        for (size_t i = 0; i < (n - 1) && cur != NULL; i++) cur = cur->next();
-
-        if (cur != NULL) {
-          next = cur->next();
-          cur->set_next(NULL);
-          cur = next;
-
-          // Free all remaining chunks while in ThreadCritical lock
-          // so NMT adjustment is stable.
-          while(cur != NULL) {
+        if (n == 0) {
+          cur = _first;
+          _first = NULL;
+        } else {
+          // free chunks at end of queue, for better locality
+          cur = _first;
+          for (size_t i = 0; i < (n - 1) && cur != NULL; i++) cur = cur->next();
+
+          if (cur != NULL) {
             next = cur->next();
-            os::free(cur);
-            _num_chunks--;
+            cur->set_next(NULL);
             cur = next;
           }
         }
+
+        // Free all remaining chunks while in ThreadCritical lock
+        // so NMT adjustment is stable.
+        while(cur != NULL) {
+          next = cur->next();
+          os::free(cur);
+          _num_chunks--;
+          freed += _size;
+          cur = next;
+        }
       }
     }
+    return freed;
+  }
+
+  // Index of the pool for chunks of the given length, or -1 if not pooled
+  static int index_for(size_t length) {
+    switch (length) {
+     case Chunk::size:        return 0;
+     case Chunk::medium_size: return 1;
+     case Chunk::init_size:   return 2;
+     case Chunk::tiny_size:   return 3;
+     default:                 return -1;
+    }
   }
 
-  // Accessors to preallocated pool's
-  static ChunkPool* large_pool()  { assert(_large_pool  != NULL, "must be initialized"); return _large_pool;  }
-  static ChunkPool* medium_pool() { assert(_medium_pool != NULL, "must be initialized"); return _medium_pool; }
-  static ChunkPool* small_pool()  { assert(_small_pool  != NULL, "must be initialized"); return _small_pool;  }
-  static ChunkPool* tiny_pool()   { assert(_tiny_pool   != NULL, "must be initialized"); return _tiny_pool;   }
+  // Accessor to preallocated pool's
+  static ChunkPool* pool_at(int index) {
+    assert(index >= 0 && index < ChunkCache::num_pools, "bad index");
+    assert(_pools[index] != NULL, "must be initialized");
+    return _pools[index];
+  }
 
   static void initialize() {
-    _large_pool  = new ChunkPool(Chunk::size        + Chunk::aligned_overhead_size());
-    _medium_pool = new ChunkPool(Chunk::medium_size + Chunk::aligned_overhead_size());
-    _small_pool  = new ChunkPool(Chunk::init_size   + Chunk::aligned_overhead_size());
-    _tiny_pool   = new ChunkPool(Chunk::tiny_size   + Chunk::aligned_overhead_size());
+    _pools[0] = new ChunkPool(Chunk::size        + Chunk::aligned_overhead_size());
+    _pools[1] = new ChunkPool(Chunk::medium_size + Chunk::aligned_overhead_size());
+    _pools[2] = new ChunkPool(Chunk::init_size   + Chunk::aligned_overhead_size());
+    _pools[3] = new ChunkPool(Chunk::tiny_size   + Chunk::aligned_overhead_size());
   }
 
   static void clean() {
     NativeHeapTrimmer::SuspendMark sm("chunk pool cleaner");
     enum { BlocksToKeep = 5 };
-     _tiny_pool->free_all_but(BlocksToKeep);
-     _small_pool->free_all_but(BlocksToKeep);
-     _medium_pool->free_all_but(BlocksToKeep);
-     _large_pool->free_all_but(BlocksToKeep);
+    for (int i = ChunkCache::num_pools - 1; i >= 0; i--) {
+      _pools[i]->free_all_but(BlocksToKeep);
+    }
+  }
+
+  static size_t purge() {
+    NativeHeapTrimmer::SuspendMark sm("chunk pool purge");
+    size_t freed = 0;
+    for (int i = ChunkCache::num_pools - 1; i >= 0; i--) {
+      freed += _pools[i]->free_all_but(0);
+    }
+    return freed;
   }
 };
 
-ChunkPool* ChunkPool::_large_pool  = NULL;
-ChunkPool* ChunkPool::_medium_pool = NULL;
-ChunkPool* ChunkPool::_small_pool  = NULL;
-ChunkPool* ChunkPool::_tiny_pool   = NULL;
+ChunkPool* ChunkPool::_pools[ChunkCache::num_pools] = { NULL, NULL, NULL, NULL };
 
 void chunkpool_init() {
   ChunkPool::initialize();
 }
 
 
+//--------------------------------------------------------------------------------------
+// ChunkCache implementation
+
+ChunkCache::ChunkCache() : _enabled(false) {
+  for (int i = 0; i < num_pools; i++) {
+    _chunks[i] = NULL;
+  }
+}
+
+ChunkCache* ChunkCache::current() {
+  Thread* thread = Thread::current_or_null();
+  if (thread == NULL || !thread->chunk_cache()->_enabled) {
+    return NULL;
+  }
+  return thread->chunk_cache();
+}
+
+void ChunkCache::flush() {
+  _enabled = false;
+  for (int i = 0; i < num_pools; i++) {
+    if (_chunks[i] != NULL) {
+      ChunkPool::pool_at(i)->free(_chunks[i]);
+      _chunks[i] = NULL;
+    }
+  }
+}
+
+Chunk* ChunkCache::take(int index) {
+  Chunk* chunk = _chunks[index];
+  _chunks[index] = NULL;
+  return chunk;
+}
+
+bool ChunkCache::put(int index, Chunk* chunk) {
+  if (_chunks[index] != NULL) {
+    return false;
+  }
+  _chunks[index] = chunk;
+  return true;
+}
+
 //--------------------------------------------------------------------------------------
 // ChunkPoolCleaner implementation
 //
@@ -180,31 +244,35 @@ void* Chunk::operator new (size_t requested_size, AllocFailType alloc_failmode,
   // expect requested_size but if sizeof(Chunk) doesn't match isn't proper size we must align it.
   assert(ARENA_ALIGN(requested_size) == aligned_overhead_size(), "Bad alignment");
   size_t bytes = ARENA_ALIGN(requested_size) + length;
-  switch (length) {
-   case Chunk::size:        return ChunkPool::large_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::medium_size: return ChunkPool::medium_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::init_size:   return ChunkPool::small_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::tiny_size:   return ChunkPool::tiny_pool()->allocate(bytes, alloc_failmode);
-   default: {
-     void* p = os::malloc(bytes, mtChunk, CALLER_PC);
-     if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
-       vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "Chunk::new");
-     }
-     return p;
-   }
+  int index = ChunkPool::index_for(length);
+  if (index >= 0) {
+    ChunkCache* cache = ChunkCache::current();
+    if (cache != NULL) {
+      Chunk* c = cache->take(index);
+      if (c != NULL) {
+        return c;
+      }
+    }
+    return ChunkPool::pool_at(index)->allocate(bytes, alloc_failmode);
   }
+  void* p = os::malloc(bytes, mtChunk, CALLER_PC);
+  if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
+    vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "Chunk::new");
+  }
+  return p;
 }
 
 void Chunk::operator delete(void* p) {
   Chunk* c = (Chunk*)p;
-  switch (c->length()) {
-   case Chunk::size:        ChunkPool::large_pool()->free(c); break;
-   case Chunk::medium_size: ChunkPool::medium_pool()->free(c); break;
-   case Chunk::init_size:   ChunkPool::small_pool()->free(c); break;
-   case Chunk::tiny_size:   ChunkPool::tiny_pool()->free(c); break;
-   default:
-     ThreadCritical tc;  // Free chunks under TC lock so that NMT adjustment is stable.
-     os::free(c);
+  int index = ChunkPool::index_for(c->length());
+  if (index >= 0) {
+    ChunkCache* cache = ChunkCache::current();
+    if (cache == NULL || !cache->put(index, c)) {
+      ChunkPool::pool_at(index)->free(c);
+    }
+  } else {
+    ThreadCritical tc;  // Free chunks under TC lock so that NMT adjustment is stable.
+    os::free(c);
   }
 }
 
@@ -238,6 +306,10 @@ void Chunk::start_chunk_pool_cleaner_task() {
   cleaner->enroll();
 }
 
+size_t Chunk::purge_chunk_pools() {
+  return ChunkPool::purge();
+}
+
 //------------------------------Arena------------------------------------------
 
 Arena::Arena(MEMFLAGS flag, size_t init_size) : _flags(flag), _size_in_bytes(0)  {
@@ -292,11 +364,11 @@ void* Arena::operator new (size_t size, const std::nothrow_t&  nothrow_constant)
 
   // dynamic memory type binding
 void* Arena::operator new(size_t size, MEMFLAGS flags) throw() {
-  return (void *) AllocateHeap(size, flags, CALLER_PC);
+  return (void *) AllocateHeap(size, flags, CALLER_PC_FOR_MALLOC(size));
 }
 
 void* Arena::operator new(size_t size, const std::nothrow_t& nothrow_constant, MEMFLAGS flags) throw() {
-  return (void*)AllocateHeap(size, flags, CALLER_PC, AllocFailStrategy::RETURN_NULL);
+  return (void*)AllocateHeap(size, flags, CALLER_PC_FOR_MALLOC(size), AllocFailStrategy::RETURN_NULL);
 }
 
 void Arena::operator delete(void* p) {
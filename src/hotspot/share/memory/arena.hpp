@@ -85,6 +85,34 @@ class Chunk: CHeapObj<mtChunk> {
 
   // Start the chunk_pool cleaner task
   static void start_chunk_pool_cleaner_task();
+  // Frees all cached chunks, returns the number of bytes freed
+  static size_t purge_chunk_pools();
+};
+
+//------------------------------ChunkCache-------------------------------------
+// A thread's private cache of pooled chunks, at most one of each pool size.
+// Threads which churn through arenas, like the compiler threads, take their
+// chunks from here and so stay off the lock guarding the shared pools.
+class ChunkCache {
+ public:
+  enum { num_pools = 4 };
+
+ private:
+  Chunk* _chunks[num_pools];
+  bool   _enabled;
+
+ public:
+  ChunkCache();
+
+  // The cache of the current thread, or NULL if it does not cache chunks
+  static ChunkCache* current();
+
+  void enable() { _enabled = true; }
+  // Returns the cached chunks to the shared pools and stops caching
+  void flush();
+
+  Chunk* take(int index);
+  bool   put(int index, Chunk* chunk);
 };
 
 //------------------------------Arena------------------------------------------
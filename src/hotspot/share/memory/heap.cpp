@@ -374,6 +374,35 @@ void CodeHeap::deallocate(void* p) {
   NOT_PRODUCT(verify());
 }
 
+// Replace the pages in [from, to) with fresh zero pages, which are not resident.
+static size_t discard_pages(char* from, char* to) {
+  char* start = align_up(from, os::vm_page_size());
+  char* end = align_down(to, os::vm_page_size());
+  if (start >= end) {
+    return 0;
+  }
+  if (!os::uncommit_memory(start, end - start, ExecMem)) {
+    return 0;
+  }
+  os::commit_memory_or_exit(start, end - start, ExecMem, "CodeHeap discard");
+  return end - start;
+}
+
+size_t CodeHeap::discard_free_memory() {
+  assert_locked_or_safepoint(CodeCache_lock);
+  if (_memory.special()) {
+    // pinned large pages cannot be uncommitted
+    return 0;
+  }
+  size_t discarded = 0;
+  for (FreeBlock* b = _freelist; b != NULL; b = b->link()) {
+    // the header keeps the free list
+    discarded += discard_pages((char*)b + sizeof(FreeBlock), (char*)b + segments_to_size(b->length()));
+  }
+  discarded += discard_pages((char*)address_for(_next_segment), high());
+  return discarded;
+}
+
 /**
  * The segment map is used to quickly find the the start (header) of a
  * code block (e.g. nmethod) when only a pointer to a location inside the
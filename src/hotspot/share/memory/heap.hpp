@@ -160,6 +160,9 @@ class CodeHeap : public CHeapObj<mtCode> {
   //            wasted after the interpreter generation because we don't know the interpreter size
   //            beforehand and we also can't easily relocate the interpreter to a new location.
   void  deallocate_tail(void* p, size_t used_size);
+  // Discard the contents of free blocks and of the unused committed tail, keeping
+  // the memory committed. Returns the number of bytes discarded.
+  size_t discard_free_memory();
 
   // Boundaries of committed space.
   char* low()  const                             { return _memory.low(); }
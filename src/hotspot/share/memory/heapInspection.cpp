@@ -79,6 +79,19 @@ int KlassInfoEntry::compare(KlassInfoEntry* e1, KlassInfoEntry* e2) {
   }
 }
 
+void KlassInfoEntry::add_concurrently(uint64_t ct, size_t wds) {
+  // A CAS loop, as not all 32-bit platforms have a 64-bit Atomic::add.
+  uint64_t old_count = Atomic::load(&_instance_count);
+  while (true) {
+    uint64_t witness = Atomic::cmpxchg(&_instance_count, old_count, old_count + ct);
+    if (witness == old_count) {
+      break;
+    }
+    old_count = witness;
+  }
+  Atomic::add(&_instance_words, wds);
+}
+
 const char* KlassInfoEntry::name() const {
   const char* name;
   if (_klass->name() != NULL) {
@@ -139,6 +152,38 @@ KlassInfoEntry* KlassInfoBucket::lookup(Klass* const k) {
   return elt;
 }
 
+KlassInfoEntry* KlassInfoBucket::lookup_concurrently(Klass* const k) {
+  if (k->java_mirror_no_keepalive() == NULL) {
+    return NULL;
+  }
+
+  KlassInfoEntry* head = Atomic::load_acquire(&_list);
+  KlassInfoEntry* elt = NULL;
+  while (true) {
+    for (KlassInfoEntry* e = head; e != NULL; e = e->next()) {
+      if (e->is_equal(k)) {
+        // Another thread added it while we were trying to.
+        delete elt;
+        return e;
+      }
+    }
+    if (elt == NULL) {
+      elt = new (std::nothrow) KlassInfoEntry(k, head);
+      // We may be out of space to allocate the new entry.
+      if (elt == NULL) {
+        return NULL;
+      }
+    } else {
+      elt->set_next(head);
+    }
+    KlassInfoEntry* witness = Atomic::cmpxchg(&_list, head, elt);
+    if (witness == head) {
+      return elt;
+    }
+    head = witness;
+  }
+}
+
 void KlassInfoBucket::iterate(KlassInfoClosure* cic) {
   KlassInfoEntry* elt = _list;
   while (elt != NULL) {
@@ -274,6 +319,41 @@ bool KlassInfoTable::merge(KlassInfoTable* table) {
   return closure.success();
 }
 
+bool KlassInfoTable::merge_entry_concurrently(const KlassInfoEntry* cie) {
+  Klass*          k = cie->klass();
+  KlassInfoEntry* elt = _buckets[hash(k) % _num_buckets].lookup_concurrently(k);
+  if (elt != NULL) {
+    elt->add_concurrently(cie->count(), cie->words());
+    return true;
+  }
+  return false;
+}
+
+class KlassInfoTableConcurrentMergeClosure : public KlassInfoClosure {
+private:
+  KlassInfoTable* _dest;
+  size_t _words;
+  bool _success;
+public:
+  KlassInfoTableConcurrentMergeClosure(KlassInfoTable* table) : _dest(table), _words(0), _success(true) {}
+  void do_cinfo(KlassInfoEntry* cie) {
+    if (_dest->merge_entry_concurrently(cie)) {
+      _words += cie->words();
+    } else {
+      _success = false;
+    }
+  }
+  size_t words() const { return _words; }
+  bool success() const { return _success; }
+};
+
+bool KlassInfoTable::merge_concurrently(KlassInfoTable* table) {
+  KlassInfoTableConcurrentMergeClosure closure(this);
+  table->iterate(&closure);
+  Atomic::add(&_size_of_instances_in_words, closure.words());
+  return closure.success();
+}
+
 int KlassInfoHisto::sort_helper(KlassInfoEntry** e1, KlassInfoEntry** e2) {
   return (*e1)->compare(*e1,*e2);
 }
@@ -560,10 +640,7 @@ void ParHeapInspectTask::work(uint worker_id) {
   RecordInstanceClosure ric(&cit, _filter);
   _poi->object_iterate(&ric, worker_id);
   missed_count = ric.missed_count();
-  {
-    MutexLocker x(&_mutex);
-    merge_success = _shared_cit->merge(&cit);
-  }
+  merge_success = _shared_cit->merge_concurrently(&cit);
   if (merge_success) {
     Atomic::add(&_missed_count, missed_count);
   } else {
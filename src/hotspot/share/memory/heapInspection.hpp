@@ -67,12 +67,14 @@ class KlassInfoEntry: public CHeapObj<mtInternal> {
   {}
   ~KlassInfoEntry();
   KlassInfoEntry* next() const   { return _next; }
+  void set_next(KlassInfoEntry* next) { _next = next; }
   bool is_equal(const Klass* k)  { return k == _klass; }
   Klass* klass()  const          { return _klass; }
   uint64_t count()    const      { return _instance_count; }
   void set_count(uint64_t ct)    { _instance_count = ct; }
   size_t words()  const          { return _instance_words; }
   void set_words(size_t wds)     { _instance_words = wds; }
+  void add_concurrently(uint64_t ct, size_t wds);
   void set_index(int64_t index)  { _index = index; }
   int64_t index()    const       { return _index; }
   GrowableArray<KlassInfoEntry*>* subclasses() const { return _subclasses; }
@@ -97,6 +99,7 @@ class KlassInfoBucket: public CHeapObj<mtInternal> {
   void set_list(KlassInfoEntry* l) { _list = l; }
  public:
   KlassInfoEntry* lookup(Klass* k);
+  KlassInfoEntry* lookup_concurrently(Klass* k);
   void initialize() { _list = NULL; }
   void empty();
   void iterate(KlassInfoClosure* cic);
@@ -127,6 +130,9 @@ class KlassInfoTable: public StackObj {
   size_t size_of_instances_in_words() const;
   bool merge(KlassInfoTable* table);
   bool merge_entry(const KlassInfoEntry* cie);
+  // Like merge, but several tables may be merged into this one at once.
+  bool merge_concurrently(KlassInfoTable* table);
+  bool merge_entry_concurrently(const KlassInfoEntry* cie);
 
   friend class KlassInfoHisto;
   friend class KlassHierarchy;
@@ -233,7 +239,6 @@ class ParHeapInspectTask : public AbstractGangTask {
   BoolObjectClosure* _filter;
   uintx _missed_count;
   bool _success;
-  Mutex _mutex;
 
  public:
   ParHeapInspectTask(ParallelObjectIterator* poi,
@@ -244,8 +249,7 @@ class ParHeapInspectTask : public AbstractGangTask {
       _shared_cit(shared_cit),
       _filter(filter),
       _missed_count(0),
-      _success(true),
-      _mutex(Mutex::leaf, "Parallel heap iteration data merge lock") {}
+      _success(true) {}
 
   uintx missed_count() const {
     return _missed_count;
@@ -348,6 +348,15 @@ void MetaspaceReporter::print_report(outputStream* out, size_t scale, int flags)
   print_scaled_words_and_percentage(out, committed_in_free_chunks, committed_words, scale, 6);
   out->cr();
 
+  // Free chunks smaller than a commit granule cannot be uncommitted until their
+  // buddies are freed too and merge with them. How much is committed in them
+  // measures how fragmented dead and live loaders have left the space.
+  const size_t committed_in_small_free_chunks =
+      total_cm_stat.total_committed_word_size_below(Settings::commit_granule_words());
+  out->print("   of which below granule size: ");
+  print_scaled_words_and_percentage(out, committed_in_small_free_chunks, committed_words, scale, 6);
+  out->cr();
+
   // Print waste in deallocated blocks.
   const uintx free_blocks_num =
       cl._stats_total._arena_stats_nonclass._free_blocks_num +
@@ -58,6 +58,17 @@ size_t ChunkManagerStats::total_committed_word_size() const {
   return s;
 }
 
+// Returns total committed word size of all chunks smaller than word_size.
+size_t ChunkManagerStats::total_committed_word_size_below(size_t word_size) const {
+  size_t s = 0;
+  for (chunklevel_t l = chunklevel::LOWEST_CHUNK_LEVEL; l <= chunklevel::HIGHEST_CHUNK_LEVEL; l++) {
+    if (chunklevel::word_size_for_level(l) < word_size) {
+      s += _committed_word_size[l];
+    }
+  }
+  return s;
+}
+
 void ChunkManagerStats::print_on(outputStream* st, size_t scale) const {
   // Note: used as part of MetaspaceReport so formatting matters.
   size_t total_size = 0;
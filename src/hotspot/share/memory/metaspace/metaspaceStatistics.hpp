@@ -60,6 +60,9 @@ struct ChunkManagerStats {
   // Returns total committed word size of all chunks in this manager.
   size_t total_committed_word_size() const;
 
+  // Returns total committed word size of all chunks smaller than word_size.
+  size_t total_committed_word_size_below(size_t word_size) const;
+
   void print_on(outputStream* st, size_t scale) const;
 
   DEBUG_ONLY(void verify() const;)
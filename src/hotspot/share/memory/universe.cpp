@@ -27,6 +27,7 @@
 #include "cds/metaspaceShared.hpp"
 #include "classfile/classLoader.hpp"
 #include "classfile/classLoaderDataGraph.hpp"
+#include "classfile/fieldLayoutBuilder.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
@@ -775,6 +776,7 @@ jint universe_init() {
     SymbolTable::create_table();
     StringTable::create_table();
   }
+  FieldLayoutBuilder::load_hot_fields();
 
 #if INCLUDE_CDS
   if (Arguments::is_dumping_archive()) {
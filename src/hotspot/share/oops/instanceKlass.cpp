@@ -43,6 +43,7 @@
 #include "code/codeCache.hpp"
 #include "code/dependencyContext.hpp"
 #include "compiler/compilationPolicy.hpp"
+#include "compiler/compilationRecorder.hpp"
 #include "compiler/compileBroker.hpp"
 #include "gc/shared/collectedHeap.inline.hpp"
 #include "interpreter/oopMapCache.hpp"
@@ -897,7 +898,8 @@ bool InstanceKlass::link_class_impl(TRAPS) {
                              ClassLoader::perf_classes_linked(),
                              jt->get_thread_stat()->perf_recursion_counts_addr(),
                              jt->get_thread_stat()->perf_timers_addr(),
-                             PerfClassTraceTime::CLASS_LINK);
+                             PerfClassTraceTime::CLASS_LINK,
+                             class_loader_data());
 
   // verification & rewriting
   {
@@ -1181,8 +1183,17 @@ void InstanceKlass::initialize_impl(TRAPS) {
                                ClassLoader::perf_classes_inited(),
                                jt->get_thread_stat()->perf_recursion_counts_addr(),
                                jt->get_thread_stat()->perf_timers_addr(),
-                               PerfClassTraceTime::CLASS_CLINIT);
+                               PerfClassTraceTime::CLASS_CLINIT,
+                               class_loader_data());
+      EventClassInitialize event;
+      jlong start = os::elapsed_counter();
       call_class_initializer(THREAD);
+      ClassLoader::record_class_init_time(this, os::elapsed_counter() - start);
+      if (event.should_commit()) {
+        event.set_initializedClass(this);
+        event.set_initializingClassLoader(class_loader_data());
+        event.commit();
+      }
     } else {
       // The elapsed time is so small it's not worth counting.
       if (UsePerfData) {
@@ -1196,6 +1207,7 @@ void InstanceKlass::initialize_impl(TRAPS) {
   if (!HAS_PENDING_EXCEPTION) {
     set_initialization_state_and_notify(fully_initialized, CHECK);
     debug_only(vtable().verify(tty, true);)
+    CompilationRecorder::class_initialized(this, THREAD);
   }
   else {
     // Step 10 and 11
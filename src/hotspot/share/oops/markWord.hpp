@@ -229,7 +229,9 @@ class markWord {
 
   // Special temporary state of the markWord while being inflated.
   // Code that looks at mark outside a lock need to take this into account.
-  bool is_being_inflated() const { return (value() == 0); }
+  // Lightweight locking never inflates through INFLATING, and 0 is a
+  // valid fast-locked mark.
+  bool is_being_inflated() const { return !UseLightweightLocking && (value() == 0); }
 
   // Distinguished markword value - used when inflating over
   // an existing stack-lock.  0 indicates the markword is "BUSY".
@@ -268,7 +270,7 @@ class markWord {
     return markWord(value() | unlocked_value);
   }
   bool has_locker() const {
-    return ((value() & lock_mask_in_place) == locked_value);
+    return !UseLightweightLocking && ((value() & lock_mask_in_place) == locked_value);
   }
   BasicLock* locker() const {
     assert(has_locker(), "check");
@@ -283,7 +285,9 @@ class markWord {
     return (ObjectMonitor*) (value() ^ monitor_value);
   }
   bool has_displaced_mark_helper() const {
-    return ((value() & unlocked_value) == 0);
+    uintptr_t lockbits = value() & lock_mask_in_place;
+    return UseLightweightLocking ? lockbits == monitor_value          // monitor?
+                                 : (lockbits & unlocked_value) == 0;  // monitor | stack-locked?
   }
   markWord displaced_mark_helper() const;
   void set_displaced_mark_helper(markWord m) const;
@@ -292,6 +296,15 @@ class markWord {
     tmp |= ((hash & hash_mask) << hash_shift);
     return markWord(tmp);
   }
+  // Lightweight locking: the lock bits of an object fast-locked by the
+  // thread that has it on its lock stack. The rest of the mark word is
+  // the unlocked header.
+  bool is_fast_locked() const {
+    return (value() & lock_mask_in_place) == locked_value;
+  }
+  markWord set_fast_locked() const {
+    return markWord(value() & ~lock_mask_in_place);
+  }
   // it is only used to be stored into BasicLock as the
   // indicator that the lock is using heavyweight monitor
   static markWord unused_mark() {
@@ -90,7 +90,8 @@ class Method : public Metadata {
     _has_injected_profile  = 1 << 4,
     _intrinsic_candidate   = 1 << 5,
     _reserved_stack_access = 1 << 6,
-    _scoped                = 1 << 7
+    _scoped                = 1 << 7,
+    _recorded_hot          = 1 << 8
   };
   mutable u2 _flags;
 
@@ -846,6 +847,15 @@ public:
     _flags = x ? (_flags | _scoped) : (_flags & ~_scoped);
   }
 
+  // Compiled at the highest tier in the run that wrote PrecompileMethodsFile.
+  bool is_recorded_hot() const {
+    return (_flags & _recorded_hot) != 0;
+  }
+
+  void set_recorded_hot(bool x) {
+    _flags = x ? (_flags | _recorded_hot) : (_flags & ~_recorded_hot);
+  }
+
   bool intrinsic_candidate() {
     return (_flags & _intrinsic_candidate) != 0;
   }
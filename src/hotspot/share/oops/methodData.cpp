@@ -1299,6 +1299,9 @@ void MethodData::init() {
   _backedge_mask = right_n_bits(CompilerConfig::scaled_freq_log(Tier0BackedgeNotifyFreqLog, scale)) << InvocationCounter::count_shift;
 
   _tenure_traps = 0;
+  _last_recompile_trap = 0;
+  _recompile_backoff_until = 0;
+  _recompile_backoff_level = 0;
   _num_loops = 0;
   _num_blocks = 0;
   _would_profile = unknown;
@@ -1327,6 +1330,29 @@ void MethodData::init() {
   clear_escape_info();
 }
 
+jlong MethodData::record_recompile_trap(jlong now) {
+  // A storm lasts as long as traps keep coming within the window after the
+  // previous trap, or after the end of the backoff it caused
+  const bool first = _last_recompile_trap == 0;
+  const jlong since = now - MAX2(_last_recompile_trap, _recompile_backoff_until);
+  _last_recompile_trap = now;
+  if (first || since >= (jlong)DeoptimizationStormWindow) {
+    _recompile_backoff_level = 0;
+    return 0;
+  }
+  if (_recompile_backoff_level < BitsPerJLong) {
+    _recompile_backoff_level++;
+  }
+  const jlong limit = (jlong)DeoptimizationBackoffLimit;
+  jlong backoff = (jlong)DeoptimizationStormWindow;
+  for (int i = 1; i < _recompile_backoff_level && backoff < limit; i++) {
+    backoff *= 2;
+  }
+  backoff = MIN2(backoff, limit);
+  _recompile_backoff_until = now + backoff;
+  return backoff;
+}
+
 // Get a measure of how much mileage the method has on it.
 int MethodData::mileage_of(Method* method) {
   return MAX2(method->invocation_count(), method->backedge_count());
@@ -2059,6 +2059,10 @@ private:
   int               _invocation_counter_start;
   int               _backedge_counter_start;
   uint              _tenure_traps;
+  // Deoptimization storm backoff, see record_recompile_trap()
+  jlong             _last_recompile_trap;     // ms of the last trap making the code not entrant
+  jlong             _recompile_backoff_until; // ms until which C2 does not recompile the method
+  int               _recompile_backoff_level; // number of doublings of the backoff
   int               _invoke_mask;      // per-method Tier0InvokeNotifyFreqLog
   int               _backedge_mask;    // per-method Tier0BackedgeNotifyFreqLog
 
@@ -2404,6 +2408,17 @@ public:
     _tenure_traps += 1;
   }
 
+  // Records a trap which made the compiled code of the method not entrant.
+  // Returns the ms to wait before recompiling it, or 0 if the trap does not
+  // follow a previous one within DeoptimizationStormWindow.
+  jlong record_recompile_trap(jlong now);
+  bool is_recompile_backoff(jlong now) const {
+    return now < _recompile_backoff_until;
+  }
+  int recompile_backoff_level() const {
+    return _recompile_backoff_level;
+  }
+
   // Return pointer to area dedicated to parameters in MDO
   ParametersTypeData* parameters_type_data() const {
     assert(_parameters_type_data_di != parameters_uninitialized, "called too early");
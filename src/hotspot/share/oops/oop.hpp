@@ -288,6 +288,9 @@ class oopDesc {
   // safepoint if called on a biased object. Calling code must be aware of that.
   inline intptr_t identity_hash();
   intptr_t slow_identity_hash();
+  // Returns true if the object is known to have no identity hash, without
+  // looking at a displaced header or computing the hash.
+  inline bool fast_no_hash_check();
 
   // marks are forwarded to stack when object is locked
   inline bool     has_displaced_mark() const;
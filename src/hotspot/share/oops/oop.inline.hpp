@@ -380,6 +380,13 @@ intptr_t oopDesc::identity_hash() {
   }
 }
 
+bool oopDesc::fast_no_hash_check() {
+  markWord mrk = mark_acquire();
+  assert(!mrk.is_marked(), "should never be marked");
+  // Installing a hash revokes the bias, so a biased object has none.
+  return (mrk.is_unlocked() && mrk.has_no_hash()) || mrk.has_bias_pattern();
+}
+
 bool oopDesc::has_displaced_mark() const {
   return mark().has_displaced_mark_helper();
 }
@@ -390,6 +390,17 @@
   product(bool, UseOnlyInlinedBimorphic, true,                              \
           "Don't use BimorphicInlining if can't inline a second method")    \
                                                                             \
+  product(intx, PolymorphicInliningLimit, 0,                                \
+          "Inline up to this many profiled receivers at a polymorphic "     \
+          "call site behind a chain of klass checks, at most "              \
+          "TypeProfileWidth; 0 disables")                                   \
+          range(0, 8)                                                       \
+                                                                            \
+  product(intx, PolymorphicInliningMinPercent, 10,                          \
+          "Min percentage of the calls at a polymorphic site a receiver "   \
+          "must take to be inlined")                                        \
+          range(0, 100)                                                     \
+                                                                            \
   develop(bool, SubsumeLoads, true,                                         \
           "Attempt to compile while subsuming loads into machine "          \
           "instructions.")                                                  \
@@ -417,6 +428,11 @@
           "Maximum number of nodes")                                        \
           range(1000, max_jint / 3)                                         \
                                                                             \
+  product(intx, C2CompileTimeBudget, 0,                                    \
+          "If positive, abandon a C2 compilation that takes longer than "   \
+          "this many milliseconds and leave the method to C1")              \
+          range(0, max_jint)                                                \
+                                                                            \
   product(intx, NodeLimitFudgeFactor, 2000,                                 \
           "Fudge Factor for certain optimizations")                         \
           constraint(NodeLimitFudgeFactorConstraintFunc, AfterErgo)         \
@@ -490,6 +506,15 @@
   notproduct(bool, PrintEliminateAllocations, false,                        \
           "Print out when allocations are eliminated")                      \
                                                                             \
+  product(bool, ReduceCardMarksForNewObjects, true, DIAGNOSTIC,             \
+          "With ReduceInitialCardMarks, also elide the card marks of "      \
+          "stores into an object allocated in the same compiled method "    \
+          "when no safepoint or call lies between the allocation and the "  \
+          "store")                                                          \
+                                                                            \
+  notproduct(bool, PrintEliminateCardMarks, false,                          \
+          "Print out when card marks for new objects are eliminated")       \
+                                                                            \
   product(intx, EliminateAllocationArraySizeLimit, 64,                      \
           "Array size (number of elements) limit for scalar replacement")   \
           range(0, max_jint)                                                \
@@ -526,6 +526,9 @@ void PhaseChaitin::Register_Allocate() {
         return;
       }
     }
+    if (C->check_compile_time_budget()) {
+      return;
+    }
 
     if (!_lrg_map.max_lrg_id()) {
       return;
@@ -605,7 +605,9 @@ Compile::Compile( ciEnv* ci_env, ciMethod* target, int osr_bci,
                   _replay_inline_data(nullptr),
                   _java_calls(0),
                   _inner_loops(0),
-                  _interpreter_frame_size(0)
+                  _interpreter_frame_size(0),
+                  _compile_time_budget_end(C2CompileTimeBudget > 0 ?
+                                           os::javaTimeNanos() + C2CompileTimeBudget * NANOSECS_PER_MILLISEC : 0)
 #ifndef PRODUCT
                   , _in_dump_cnt(0)
 #endif
@@ -896,6 +898,7 @@ Compile::Compile( ciEnv* ci_env,
     _java_calls(0),
     _inner_loops(0),
     _interpreter_frame_size(0),
+    _compile_time_budget_end(0),
 #ifndef PRODUCT
     _in_dump_cnt(0),
 #endif
@@ -2024,7 +2027,7 @@ bool Compile::optimize_loops(PhaseIterGVN& igvn, LoopOptsMode mode) {
       TracePhase tp("idealLoop", &timers[_t_idealLoop]);
       PhaseIdealLoop::optimize(igvn, mode);
       _loop_opts_cnt--;
-      if (failing())  return false;
+      if (failing() || check_compile_time_budget())  return false;
       if (major_progress()) print_method(PHASE_PHASEIDEALLOOP_ITERATIONS, 2);
     }
   }
@@ -2723,7 +2726,7 @@ void Compile::Code_Gen() {
 
   // If you have too many nodes, or if matching has failed, bail out
   check_node_count(0, "out of nodes matching instructions");
-  if (failing()) {
+  if (failing() || check_compile_time_budget()) {
     return;
   }
 
@@ -2735,7 +2738,7 @@ void Compile::Code_Gen() {
   {
     TracePhase tp("scheduler", &timers[_t_scheduler]);
     bool success = cfg.do_global_code_motion();
-    if (!success) {
+    if (!success || check_compile_time_budget()) {
       return;
     }
 
@@ -481,6 +481,7 @@ class Compile : public Phase {
   Arena*                _indexSet_arena;        // control IndexSet allocation within PhaseChaitin
   void*                 _indexSet_free_block_list; // free list of IndexSet bit blocks
   int                   _interpreter_frame_size;
+  jlong                 _compile_time_budget_end; // os::javaTimeNanos() deadline, see C2CompileTimeBudget
 
   PhaseOutput*          _output;
 
@@ -752,6 +753,16 @@ class Compile : public Phase {
     // Record failure reason.
     record_failure(reason);
   }
+  // Give up on the method for C2 once the compilation has run past
+  // C2CompileTimeBudget. The method stays not C2-compilable, so tiered
+  // policy keeps it in C1 instead of retrying the expensive compilation.
+  bool check_compile_time_budget() {
+    if (_compile_time_budget_end != 0 && os::javaTimeNanos() > _compile_time_budget_end) {
+      record_method_not_compilable("exceeded C2 compile time budget");
+      return true;
+    }
+    return false;
+  }
   bool check_node_count(uint margin, const char* reason) {
     if (live_nodes() + margin > max_node_limit()) {
       record_method_not_compilable(reason);
@@ -876,6 +887,8 @@ class Compile : public Phase {
   CallGenerator*    call_generator(ciMethod* call_method, int vtable_index, bool call_does_dispatch,
                                    JVMState* jvms, bool allow_inline, float profile_factor, ciKlass* speculative_receiver_type = nullptr,
                                    bool allow_intrinsics = true);
+  CallGenerator*    call_generator_polymorphic(ciMethod* callee, int vtable_index, JVMState* jvms,
+                                               bool allow_inline, float profile_factor, ciCallProfile& profile);
   bool should_delay_inlining(ciMethod* call_method, JVMState* jvms) {
     return should_delay_string_inlining(call_method, jvms) ||
            should_delay_boxing_inlining(call_method, jvms) ||
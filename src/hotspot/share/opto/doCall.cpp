@@ -63,6 +63,57 @@ void trace_type_profile(Compile* C, ciMethod *method, int depth, int bci, ciMeth
   }
 }
 
+// Inline the receivers of a polymorphic call site that take at least
+// PolymorphicInliningMinPercent of its calls behind a chain of exact klass
+// checks, most frequent first. Other receivers take the virtual call.
+CallGenerator* Compile::call_generator_polymorphic(ciMethod* callee, int vtable_index, JVMState* jvms,
+                                                   bool allow_inline, float prof_factor, ciCallProfile& profile) {
+  ciMethod* caller = jvms->method();
+  const int limit = MIN2((int)PolymorphicInliningLimit, (int)TypeProfileWidth);
+
+  ciKlass*       receivers[ciCallProfile::ReceiverLimit];
+  ciMethod*      targets[ciCallProfile::ReceiverLimit];
+  CallGenerator* hit_cgs[ciCallProfile::ReceiverLimit];
+  float          hit_probs[ciCallProfile::ReceiverLimit];
+  int n = 0;
+  float miss_prob = 1.0f;
+  for (int i = 0; i < limit && profile.has_receiver(i); i++) {
+    float prob = profile.receiver_prob(i);
+    if (100.0f * prob < (float)PolymorphicInliningMinPercent) {
+      break; // receivers are sorted by count
+    }
+    // Fails for receivers which cannot reach this call site
+    ciMethod* target = callee->resolve_invoke(caller->holder(), profile.receiver(i));
+    if (target == nullptr) {
+      continue;
+    }
+    CallGenerator* hit_cg = call_generator(target, vtable_index, false, jvms, allow_inline, prof_factor);
+    if (hit_cg == nullptr || !hit_cg->is_inline()) {
+      // A direct call does not pay for the klass check in front of it
+      continue;
+    }
+    receivers[n] = profile.receiver(i);
+    targets[n] = target;
+    hit_cgs[n] = hit_cg;
+    // Probability to hit given that the checks of the previous receivers missed
+    hit_probs[n] = MIN2(prob / miss_prob, (float)PROB_MAX);
+    miss_prob = MAX2(miss_prob - prob, (float)PROB_MIN);
+    n++;
+  }
+  if (n == 0) {
+    return nullptr;
+  }
+
+  CallGenerator* cg = (IncrementalInlineVirtual ? CallGenerator::for_late_inline_virtual(callee, vtable_index, prof_factor)
+                                                : CallGenerator::for_virtual_call(callee, vtable_index));
+  for (int i = n - 1; i >= 0 && cg != nullptr; i--) {
+    trace_type_profile(this, caller, jvms->depth() - 1, jvms->bci(), targets[i], receivers[i],
+                       profile.count(), profile.receiver_count(i));
+    cg = CallGenerator::for_predicted_call(receivers[i], cg, hit_cgs[i], hit_probs[i]);
+  }
+  return cg;
+}
+
 CallGenerator* Compile::call_generator(ciMethod* callee, int vtable_index, bool call_does_dispatch,
                                        JVMState* jvms, bool allow_inline,
                                        float prof_factor, ciKlass* speculative_receiver_type,
@@ -293,6 +344,10 @@ CallGenerator* Compile::call_generator(ciMethod* callee, int vtable_index, bool
           }
         }
       }
+      if (receiver_method == nullptr && morphism == 0 && PolymorphicInliningLimit > 0) {
+        CallGenerator* cg = call_generator_polymorphic(callee, vtable_index, jvms, allow_inline, prof_factor, profile);
+        if (cg != nullptr)  return cg;
+      }
     }
 
     // If there is only one implementor of this interface then we
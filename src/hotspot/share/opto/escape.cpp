@@ -1723,7 +1723,7 @@ int ConnectionGraph::find_init_values_null(JavaObjectNode* pta, PhaseTransform*
   }
   InitializeNode* ini = alloc->as_Allocate()->initialization();
   bool visited_bottom_offset = false;
-  GrowableArray<int> offsets_worklist;
+  GrowableArrayWithInline<int, 8> offsets_worklist;
   int new_edges = 0;
 
   // Check if an oop field's initializing value is recorded and add
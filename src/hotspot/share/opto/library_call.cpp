@@ -3843,10 +3843,13 @@ bool LibraryCallKit::inline_native_hashcode(bool is_virtual, bool is_static) {
   Node* no_ctrl = nullptr;
   Node* header = make_load(no_ctrl, header_addr, TypeX_X, TypeX_X->basic_type(), MemNode::unordered);
 
-  // Test the header to see if it is unlocked.
-  Node *lock_mask      = _gvn.MakeConX(markWord::biased_lock_mask_in_place);
+  // Test the header to see if it is unlocked. With lightweight locking the
+  // header of a fast-locked object is in place as well, so only inflated
+  // objects need the slow path.
+  Node *lock_mask      = _gvn.MakeConX(UseLightweightLocking ? markWord::monitor_value
+                                                              : markWord::biased_lock_mask_in_place);
   Node *lmasked_header = _gvn.transform(new AndXNode(header, lock_mask));
-  Node *unlocked_val   = _gvn.MakeConX(markWord::unlocked_value);
+  Node *unlocked_val   = _gvn.MakeConX(UseLightweightLocking ? 0 : markWord::unlocked_value);
   Node *chk_unlocked   = _gvn.transform(new CmpXNode( lmasked_header, unlocked_val));
   Node *test_unlocked  = _gvn.transform(new BoolNode( chk_unlocked, BoolTest::ne));
 
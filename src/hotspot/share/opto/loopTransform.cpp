@@ -2634,6 +2634,72 @@ bool PhaseIdealLoop::is_scaled_iv_plus_offset(Node* exp, Node* iv, int* p_scale,
   return false;
 }
 
+//------------------------------is_scaled_long_iv----------------------------
+// Return true if exp is a constant times the long induction var
+bool PhaseIdealLoop::is_scaled_long_iv(Node* exp, Node* iv, jlong* p_scale) {
+  exp = exp->uncast();
+  if (exp == iv) {
+    *p_scale = 1;
+    return true;
+  }
+  int opc = exp->Opcode();
+  if (opc == Op_MulL) {
+    if (exp->in(1)->uncast() == iv && exp->in(2)->is_Con()) {
+      *p_scale = exp->in(2)->get_long();
+      return true;
+    }
+    if (exp->in(2)->uncast() == iv && exp->in(1)->is_Con()) {
+      *p_scale = exp->in(1)->get_long();
+      return true;
+    }
+  } else if (opc == Op_LShiftL) {
+    if (exp->in(1)->uncast() == iv && exp->in(2)->is_Con()) {
+      *p_scale = CONST64(1) << (exp->in(2)->get_int() & (BitsPerJavaLong - 1));
+      return true;
+    }
+  }
+  return false;
+}
+
+//---------------------------is_scaled_long_iv_plus_offset-------------------
+// Return true if exp is a long induction variable expression: k1*iv + invar
+bool PhaseIdealLoop::is_scaled_long_iv_plus_offset(Node* exp, Node* iv, jlong* p_scale, Node** p_offset) {
+  if (is_scaled_long_iv(exp, iv, p_scale)) {
+    Node* zero = _igvn.longcon(0);
+    set_ctrl(zero, C->root());
+    *p_offset = zero;
+    return true;
+  }
+  exp = exp->uncast();
+  int opc = exp->Opcode();
+  if (opc == Op_AddL) {
+    if (is_scaled_long_iv(exp->in(1), iv, p_scale)) {
+      *p_offset = exp->in(2);
+      return true;
+    }
+    if (is_scaled_long_iv(exp->in(2), iv, p_scale)) {
+      *p_offset = exp->in(1);
+      return true;
+    }
+  } else if (opc == Op_SubL) {
+    if (is_scaled_long_iv(exp->in(1), iv, p_scale)) {
+      Node* zero = _igvn.longcon(0);
+      set_ctrl(zero, C->root());
+      Node* ctrl_off = get_ctrl(exp->in(2));
+      Node* offset = new SubLNode(zero, exp->in(2));
+      register_new_node(offset, ctrl_off);
+      *p_offset = offset;
+      return true;
+    }
+    if (is_scaled_long_iv(exp->in(2), iv, p_scale)) {
+      *p_scale *= -1;
+      *p_offset = exp->in(1);
+      return true;
+    }
+  }
+  return false;
+}
+
 // Same as PhaseIdealLoop::duplicate_predicates() but for range checks
 // eliminated by iteration splitting.
 Node* PhaseIdealLoop::add_range_check_predicate(IdealLoopTree* loop, CountedLoopNode* cl,
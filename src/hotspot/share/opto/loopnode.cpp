@@ -525,7 +525,7 @@ static bool condition_stride_ok(BoolTest::mask bt, jlong stride_con) {
   return true;
 }
 
-void PhaseIdealLoop::long_loop_replace_long_iv(Node* iv_to_replace, Node* inner_iv, Node* outer_phi, Node* inner_head) {
+Node* PhaseIdealLoop::long_loop_replace_long_iv(Node* iv_to_replace, Node* inner_iv, Node* outer_phi, Node* inner_head) {
   Node* iv_as_long = new ConvI2LNode(inner_iv, TypeLong::INT);
   register_new_node(iv_as_long, inner_head);
   Node* iv_replacement = new AddLNode(outer_phi, iv_as_long);
@@ -546,6 +546,7 @@ void PhaseIdealLoop::long_loop_replace_long_iv(Node* iv_to_replace, Node* inner_
     int nb = u->replace_edge(iv_to_replace, iv_replacement, &_igvn);
     i -= nb;
   }
+  return iv_replacement;
 }
 
 void PhaseIdealLoop::add_empty_predicate(Deoptimization::DeoptReason reason, Node* inner_head, IdealLoopTree* loop, SafePointNode* sfpt) {
@@ -816,6 +817,12 @@ bool PhaseIdealLoop::transform_long_counted_loop(IdealLoopTree* loop, Node_List
   assert(phi_t->_hi >= phi_t->_lo, "dead phi?");
   iters_limit = (int)MIN2((julong)iters_limit, (julong)(phi_t->_hi - phi_t->_lo));
 
+  // Long range checks in the loop body can be turned into int range
+  // checks on the inner loop iv if the inner loop is short enough
+  // for scale * inner iv to not overflow an int.
+  Node_List range_checks;
+  iters_limit = extract_long_range_checks(loop, stride_con, iters_limit, phi, range_checks);
+
   LongCountedLoopEndNode* exit_test = head->loopexit();
   BoolTest::mask bt = exit_test->test_trip();
 
@@ -914,7 +921,7 @@ bool PhaseIdealLoop::transform_long_counted_loop(IdealLoopTree* loop, Node_List
 
   // Replace inner loop long iv phi as inner loop int iv phi + outer
   // loop iv phi
-  long_loop_replace_long_iv(phi, inner_phi, outer_phi, head);
+  Node* iv_add = long_loop_replace_long_iv(phi, inner_phi, outer_phi, head);
 
   // Replace inner loop long iv incr with inner loop int incr + outer
   // loop iv phi
@@ -1001,6 +1008,10 @@ bool PhaseIdealLoop::transform_long_counted_loop(IdealLoopTree* loop, Node_List
     add_empty_predicate(Deoptimization::Reason_loop_limit_check, inner_head, outer_ilt, cloned_sfpt);
   }
 
+  // Take advantage of the loop nest to transform range checks
+  transform_long_range_checks((int)stride_con, range_checks, outer_phi, inner_iters_actual_int,
+                              inner_phi, iv_add, inner_head);
+
 #ifndef PRODUCT
   Atomic::inc(&_long_loop_nests);
 #endif
@@ -1011,6 +1022,204 @@ bool PhaseIdealLoop::transform_long_counted_loop(IdealLoopTree* loop, Node_List
   return true;
 }
 
+// Collect the range checks of the form:
+//
+// if (scale * phi + offset <u range) {
+// } else {
+//   trap();
+// }
+//
+// with scale, offset and range loop invariant and long. Return the
+// inner loop iteration limit reduced so scale * inner_phi can't
+// overflow an int.
+int PhaseIdealLoop::extract_long_range_checks(IdealLoopTree* loop, jlong stride_con, int iters_limit, PhiNode* phi,
+                                              Node_List& range_checks) {
+  const jlong min_iters = 2;
+  jlong reduced_iters_limit = iters_limit;
+  jlong original_iters_limit = iters_limit;
+  for (uint i = 0; i < loop->_body.size(); i++) {
+    Node* c = loop->_body.at(i);
+    if (!c->is_IfTrue() || !c->in(0)->is_RangeCheck()) {
+      continue;
+    }
+    if (c->as_IfProj()->is_uncommon_trap_if_pattern(Deoptimization::Reason_none) == nullptr) {
+      continue;
+    }
+    RangeCheckNode* rc = c->in(0)->as_RangeCheck();
+    if (!loop->is_loop_exit(rc) || !rc->in(1)->is_Bool()) {
+      continue;
+    }
+    BoolNode* bol = rc->in(1)->as_Bool();
+    if (bol->_test._test != BoolTest::lt || bol->in(1)->Opcode() != Op_CmpUL) {
+      continue;
+    }
+    Node* cmp = bol->in(1);
+    Node* range = cmp->in(2);
+    const TypeLong* range_t = _igvn.type(range)->isa_long();
+    if (range_t == nullptr || range_t->empty() || range_t->_lo < 0 || !loop->is_invariant(range)) {
+      continue;
+    }
+    jlong scale = 0;
+    Node* offset = nullptr;
+    if (!is_scaled_long_iv_plus_offset(cmp->in(1), phi, &scale, &offset) || !loop->is_invariant(offset)) {
+      continue;
+    }
+    // scale is used as an int constant in the transformed check
+    if (scale == 0 || scale != (jint)scale || scale == min_jint ||
+        original_iters_limit / ABS(scale * stride_con) < min_iters) {
+      continue;
+    }
+    reduced_iters_limit = MIN2(reduced_iters_limit, original_iters_limit / ABS(scale));
+    range_checks.push(c);
+  }
+
+  return (int)reduced_iters_limit;
+}
+
+// For a loop nest of the form:
+//
+// for (long j = ...; ...; j += inner_iters_actual) {
+//   for (int i = 0; i < inner_iters_actual; i += stride) {
+//     rc(scale * (j + i) + offset <u range)
+//   }
+// }
+//
+// the range check in the inner loop is:
+//
+//   i*K + Q <u64 R    where Q = j*K + offset is inner loop invariant
+//
+// Q_min and Q_max are the smallest and largest values of i*K + Q in
+// the inner loop. i*K + Q <u64 R is equivalent to:
+//
+//   i*K + Q - L_clamp <u32 clamp(R, L_clamp, H_clamp) - L_clamp
+//
+// with L_clamp = MAX(Q_min, 0) and H_clamp = Q_max + 1 (max_jlong if
+// that overflows). Both sides fit in an int because the inner loop is
+// short enough for (Q_max - Q_min) to fit in an int. The resulting
+// int range check is on the inner loop iv and can be predicated or
+// eliminated once the inner loop is a counted loop.
+void PhaseIdealLoop::transform_long_range_checks(int stride_con, const Node_List &range_checks, Node* outer_phi,
+                                                 Node* inner_iters_actual_int, Node* inner_phi,
+                                                 Node* iv_add, LoopNode* inner_head) {
+  Node* long_zero = _igvn.longcon(0);
+  set_ctrl(long_zero, C->root());
+  Node* int_zero = _igvn.intcon(0);
+  set_ctrl(int_zero, C->root());
+  Node* long_one = _igvn.longcon(1);
+  set_ctrl(long_one, C->root());
+  Node* int_stride = _igvn.intcon(stride_con);
+  set_ctrl(int_stride, C->root());
+
+  for (uint i = 0; i < range_checks.size(); i++) {
+    ProjNode* proj = range_checks.at(i)->as_Proj();
+    RangeCheckNode* rc = proj->in(0)->as_RangeCheck();
+    Node* rc_bol = rc->in(1);
+    Node* rc_cmp = rc_bol->in(1);
+    if (rc_cmp->Opcode() == Op_CmpU) {
+      // could be shared and have already been taken care of
+      continue;
+    }
+    jlong scale = 0;
+    Node* offset = nullptr;
+    bool ok = is_scaled_long_iv_plus_offset(rc_cmp->in(1), iv_add, &scale, &offset);
+    assert(ok, "inconsistent: was tested before");
+    if (!ok) {
+      continue;
+    }
+    Node* range = rc_cmp->in(2);
+    Node* c = rc->in(0);
+    Node* entry_control = inner_head->in(LoopNode::EntryControl);
+
+    Node* R = range;
+    Node* K = _igvn.longcon(scale);
+    set_ctrl(K, C->root());
+
+    // Q_first = outer_phi * K + offset, the value of the range check
+    // expression for the first inner loop iteration
+    Node* Q_first = new MulLNode(outer_phi, K);
+    register_new_node(Q_first, entry_control);
+    Q_first = new AddLNode(Q_first, offset);
+    register_new_node(Q_first, entry_control);
+
+    Node* Q_min = Q_first;
+
+    // Value of the inner iv on the last iteration of the inner loop
+    Node* B_2 = new LoopLimitNode(C, int_zero, inner_iters_actual_int, int_stride);
+    register_new_node(B_2, entry_control);
+    B_2 = new SubINode(B_2, int_stride);
+    register_new_node(B_2, entry_control);
+    B_2 = new ConvI2LNode(B_2);
+    register_new_node(B_2, entry_control);
+
+    Node* Q_max = new MulLNode(B_2, K);
+    register_new_node(Q_max, entry_control);
+    Q_max = new AddLNode(Q_max, Q_first);
+    register_new_node(Q_max, entry_control);
+
+    if (scale * stride_con < 0) {
+      swap(Q_min, Q_max);
+    }
+
+    // L_clamp = Q_min < 0 ? 0 : Q_min
+    Node* Q_min_cmp = new CmpLNode(Q_min, long_zero);
+    register_new_node(Q_min_cmp, entry_control);
+    Node* Q_min_bool = new BoolNode(Q_min_cmp, BoolTest::lt);
+    register_new_node(Q_min_bool, entry_control);
+    Node* L_clamp = new CMoveLNode(Q_min_bool, Q_min, long_zero, TypeLong::LONG);
+    register_new_node(L_clamp, entry_control);
+
+    Node* Q_max_plus_one = new AddLNode(Q_max, long_one);
+    register_new_node(Q_max_plus_one, entry_control);
+
+    // H_clamp = Q_max+1 < Q_min ? max_jlong : Q_max+1
+    Node* max_jlong_long = _igvn.longcon(max_jlong);
+    set_ctrl(max_jlong_long, C->root());
+    Node* Q_max_cmp = new CmpLNode(Q_max_plus_one, Q_min);
+    register_new_node(Q_max_cmp, entry_control);
+    Node* Q_max_bool = new BoolNode(Q_max_cmp, BoolTest::lt);
+    register_new_node(Q_max_bool, entry_control);
+    Node* H_clamp = new CMoveLNode(Q_max_bool, Q_max_plus_one, max_jlong_long, TypeLong::LONG);
+    register_new_node(H_clamp, entry_control);
+
+    // R_2 = clamp(R, L_clamp, H_clamp) - L_clamp
+    Node* R_2 = clamp(R, L_clamp, H_clamp);
+    R_2 = new SubLNode(R_2, L_clamp);
+    register_new_node(R_2, entry_control);
+    R_2 = new ConvL2INode(R_2, TypeInt::POS);
+    register_new_node(R_2, entry_control);
+
+    // L_2 = Q_first - L_clamp
+    Node* L_2 = new SubLNode(Q_first, L_clamp);
+    register_new_node(L_2, entry_control);
+    L_2 = new ConvL2INode(L_2, TypeInt::INT);
+    register_new_node(L_2, entry_control);
+
+    // Transform the range check from:
+    //   (j + i)*K + offset <u64 R
+    // to:
+    //   i*K + L_2 <u32 R_2
+    Node* K_int = _igvn.intcon((int)scale);
+    set_ctrl(K_int, C->root());
+    Node* scaled_iv = new MulINode(inner_phi, K_int);
+    register_new_node(scaled_iv, c);
+    Node* scaled_iv_plus_offset = new AddINode(scaled_iv, L_2);
+    register_new_node(scaled_iv_plus_offset, c);
+
+    Node* new_rc_cmp = new CmpUNode(scaled_iv_plus_offset, R_2);
+    register_new_node(new_rc_cmp, c);
+
+    _igvn.replace_input_of(rc_bol, 1, new_rc_cmp);
+  }
+}
+
+Node* PhaseIdealLoop::clamp(Node* R, Node* L, Node* H) {
+  Node* min = MaxNode::signed_min(R, H, TypeLong::LONG, _igvn);
+  set_subtree_ctrl(min, true);
+  Node* max = MaxNode::signed_max(L, min, TypeLong::LONG, _igvn);
+  set_subtree_ctrl(max, true);
+  return max;
+}
+
 LoopNode* PhaseIdealLoop::create_inner_head(IdealLoopTree* loop, LongCountedLoopNode* head,
                                             LongCountedLoopEndNode* exit_test) {
   LoopNode* new_inner_head = new LoopNode(head->in(1), head->in(2));
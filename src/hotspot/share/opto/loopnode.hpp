@@ -1171,8 +1171,14 @@ public:
 
   bool is_counted_loop(Node* x, IdealLoopTree*&loop, BasicType iv_bt);
 
-  void long_loop_replace_long_iv(Node* iv_to_replace, Node* inner_iv, Node* outer_phi, Node* inner_head);
+  Node* long_loop_replace_long_iv(Node* iv_to_replace, Node* inner_iv, Node* outer_phi, Node* inner_head);
   bool transform_long_counted_loop(IdealLoopTree* loop, Node_List &old_new);
+  int extract_long_range_checks(IdealLoopTree* loop, jlong stride_con, int iters_limit, PhiNode* phi,
+                                Node_List &range_checks);
+  void transform_long_range_checks(int stride_con, const Node_List &range_checks, Node* outer_phi,
+                                   Node* inner_iters_actual_int, Node* inner_phi,
+                                   Node* iv_add, LoopNode* inner_head);
+  Node* clamp(Node* R, Node* L, Node* H);
 #ifdef ASSERT
   bool convert_to_long_loop(Node* cmp, Node* phi, IdealLoopTree* loop);
 #endif
@@ -1278,6 +1284,10 @@ public:
   // Return true if exp is a scaled induction var plus (or minus) constant
   bool is_scaled_iv_plus_offset(Node* exp, Node* iv, int* p_scale, Node** p_offset, int depth = 0);
 
+  // Same as above for a long induction var
+  bool is_scaled_long_iv(Node* exp, Node* iv, jlong* p_scale);
+  bool is_scaled_long_iv_plus_offset(Node* exp, Node* iv, jlong* p_scale, Node** p_offset);
+
   // Create a new if above the uncommon_trap_if_pattern for the predicate to be promoted
   ProjNode* create_new_if_for_predicate(ProjNode* cont_proj, Node* new_entry, Deoptimization::DeoptReason reason,
                                         int opcode, bool rewire_uncommon_proj_phi_inputs = false,
@@ -2170,7 +2170,16 @@ void PhaseMacroExpand::expand_lock_node(LockNode *lock) {
   Node *mem_phi;
   Node *slow_path;
 
-  if (UseOptoBiasInlining) {
+  if (UseLightweightLocking) {
+    // Lightweight locking is done in the runtime: always take the slow path.
+    region  = new RegionNode(3);
+    // create a Phi for the memory state
+    mem_phi = new PhiNode( region, Type::MEMORY, TypeRawPtr::BOTTOM);
+    region->init_req(2, C->top());
+    mem_phi->init_req(2, C->top());
+    slow_path = ctrl;
+
+  } else if (UseOptoBiasInlining) {
     /*
      *  See the full description in MacroAssembler::biased_locking_enter().
      *
@@ -2427,10 +2436,17 @@ void PhaseMacroExpand::expand_unlock_node(UnlockNode *unlock) {
     mem_phi = new PhiNode( region, Type::MEMORY, TypeRawPtr::BOTTOM);
   }
 
-  FastUnlockNode *funlock = new FastUnlockNode( ctrl, obj, box );
-  funlock = transform_later( funlock )->as_FastUnlock();
-  // Optimize test; set region slot 2
-  Node *slow_path = opt_bits_test(ctrl, region, 2, funlock, 0, 0);
+  Node *slow_path;
+  if (UseLightweightLocking) {
+    // Lightweight unlocking is done in the runtime: always take the slow path.
+    region->init_req(2, C->top());
+    slow_path = ctrl;
+  } else {
+    FastUnlockNode *funlock = new FastUnlockNode( ctrl, obj, box );
+    funlock = transform_later( funlock )->as_FastUnlock();
+    // Optimize test; set region slot 2
+    slow_path = opt_bits_test(ctrl, region, 2, funlock, 0, 0);
+  }
   Node *thread = transform_later(new ThreadLocalNode());
 
   CallNode *call = make_slow_call((CallNode *) unlock, OptoRuntime::complete_monitor_exit_Type(),
@@ -2456,7 +2472,7 @@ void PhaseMacroExpand::expand_unlock_node(UnlockNode *unlock) {
 
   Node *memproj = transform_later(new ProjNode(call, TypeFunc::Memory) );
   mem_phi->init_req(1, memproj );
-  mem_phi->init_req(2, mem);
+  mem_phi->init_req(2, UseLightweightLocking ? C->top() : mem);
   transform_later(mem_phi);
   _igvn.replace_node(_callprojs.fallthrough_memproj, mem_phi);
 }
@@ -64,6 +64,7 @@ class StringConcat : public ResourceObj {
   enum {
     StringMode,
     IntMode,
+    LongMode,
     CharMode,
     StringNullCheckMode,
     NegativeIntCheckMode
@@ -136,6 +137,10 @@ class StringConcat : public ResourceObj {
     push(value, IntMode);
   }
 
+  void push_long(Node* value) {
+    push(value, LongMode);
+  }
+
   void push_char(Node* value) {
     push(value, CharMode);
   }
@@ -441,14 +446,17 @@ StringConcat* PhaseStringOpts::build_candidate(CallStaticJavaNode* call) {
   ciMethod* m = call->method();
   ciSymbol* string_sig;
   ciSymbol* int_sig;
+  ciSymbol* long_sig;
   ciSymbol* char_sig;
   if (m->holder() == C->env()->StringBuilder_klass()) {
     string_sig = ciSymbols::String_StringBuilder_signature();
     int_sig = ciSymbols::int_StringBuilder_signature();
+    long_sig = ciSymbols::long_StringBuilder_signature();
     char_sig = ciSymbols::char_StringBuilder_signature();
   } else if (m->holder() == C->env()->StringBuffer_klass()) {
     string_sig = ciSymbols::String_StringBuffer_signature();
     int_sig = ciSymbols::int_StringBuffer_signature();
+    long_sig = ciSymbols::long_StringBuffer_signature();
     char_sig = ciSymbols::char_StringBuffer_signature();
   } else {
     return nullptr;
@@ -585,7 +593,8 @@ StringConcat* PhaseStringOpts::build_candidate(CallStaticJavaNode* call) {
                cnode->method()->name() == ciSymbols::append_name() &&
                (cnode->method()->signature()->as_symbol() == string_sig ||
                 cnode->method()->signature()->as_symbol() == char_sig ||
-                cnode->method()->signature()->as_symbol() == int_sig)) {
+                cnode->method()->signature()->as_symbol() == int_sig ||
+                cnode->method()->signature()->as_symbol() == long_sig)) {
       sc->add_control(cnode);
       Node* arg = cnode->in(TypeFunc::Parms + 1);
       if (arg == nullptr || arg->is_top()) {
@@ -599,6 +608,8 @@ StringConcat* PhaseStringOpts::build_candidate(CallStaticJavaNode* call) {
       }
       if (cnode->method()->signature()->as_symbol() == int_sig) {
         sc->push_int(arg);
+      } else if (cnode->method()->signature()->as_symbol() == long_sig) {
+        sc->push_long(arg);
       } else if (cnode->method()->signature()->as_symbol() == char_sig) {
         sc->push_char(arg);
       } else {
@@ -1505,6 +1516,249 @@ Node* PhaseStringOpts::int_getChars(GraphKit& kit, Node* arg, Node* dst_array, N
   return end;
 }
 
+Node* PhaseStringOpts::long_stringSize(GraphKit& kit, Node* arg) {
+  if (arg->is_Con()) {
+    // Constant long. Count the digits of the negated value, min_jlong can't be negated.
+    jlong arg_val = arg->get_long();
+    int count = (arg_val < 0) ? 2 : 1;
+    jlong x = (arg_val < 0) ? arg_val : -arg_val;
+    while (x <= -10) {
+      x /= 10;
+      count++;
+    }
+    return __ intcon(count);
+  }
+
+  // int d = 1;
+  // if (x >= 0) {
+  //     d = 0;
+  //     x = -x;
+  // }
+  IfNode* iff = kit.create_and_map_if(kit.control(), __ Bool(__ CmpL(arg, __ longcon(0)), BoolTest::lt),
+                                      PROB_FAIR, COUNT_UNKNOWN);
+  RegionNode* r = new RegionNode(3);
+  kit.gvn().set_type(r, Type::CONTROL);
+  Node* x = new PhiNode(r, TypeLong::LONG);
+  kit.gvn().set_type(x, TypeLong::LONG);
+  Node* d = new PhiNode(r, TypeInt::INT);
+  kit.gvn().set_type(d, TypeInt::INT);
+  r->init_req(1, __ IfTrue(iff));
+  x->init_req(1, arg);
+  d->init_req(1, __ intcon(1));
+  r->init_req(2, __ IfFalse(iff));
+  x->init_req(2, kit.gvn().transform(new SubLNode(__ longcon(0), arg)));
+  d->init_req(2, __ intcon(0));
+  kit.set_control(r);
+  C->record_for_igvn(r);
+  C->record_for_igvn(x);
+  C->record_for_igvn(d);
+
+  // long p = -10;
+  // for (int i = 1; i < 19; i++) {
+  //     if (x > p)
+  //         return i + d;
+  //     p = 10 * p;
+  // }
+  // return 19 + d;
+
+  // Add loop predicate first.
+  kit.add_empty_predicates();
+  C->set_has_loops(true);
+
+  RegionNode* final_merge = new RegionNode(3);
+  kit.gvn().set_type(final_merge, Type::CONTROL);
+  Node* final_size = new PhiNode(final_merge, TypeInt::INT);
+  kit.gvn().set_type(final_size, TypeInt::INT);
+
+  RegionNode* loop = new RegionNode(3);
+  loop->init_req(1, kit.control());
+  kit.gvn().set_type(loop, Type::CONTROL);
+  Node* i = new PhiNode(loop, TypeInt::INT);
+  i->init_req(1, __ intcon(1));
+  kit.gvn().set_type(i, TypeInt::INT);
+  Node* p = new PhiNode(loop, TypeLong::LONG);
+  p->init_req(1, __ longcon(-10));
+  kit.gvn().set_type(p, TypeLong::LONG);
+  kit.set_control(loop);
+
+  iff = kit.create_and_map_if(kit.control(), __ Bool(__ CmpL(x, p), BoolTest::gt),
+                              PROB_FAIR, COUNT_UNKNOWN);
+  final_merge->init_req(1, __ IfTrue(iff));
+  final_size->init_req(1, __ AddI(i, d));
+
+  kit.set_control(__ IfFalse(iff));
+  Node* next_i = __ AddI(i, __ intcon(1));
+  iff = kit.create_and_map_if(kit.control(), __ Bool(__ CmpI(next_i, __ intcon(19)), BoolTest::lt),
+                              PROB_LIKELY_MAG(3), COUNT_UNKNOWN);
+  loop->init_req(2, __ IfTrue(iff));
+  i->init_req(2, next_i);
+  p->init_req(2, kit.gvn().transform(new MulLNode(p, __ longcon(10))));
+  final_merge->init_req(2, __ IfFalse(iff));
+  final_size->init_req(2, __ AddI(d, __ intcon(19)));
+
+  C->record_for_igvn(loop);
+  C->record_for_igvn(i);
+  C->record_for_igvn(p);
+
+  kit.set_control(final_merge);
+  C->record_for_igvn(final_merge);
+  C->record_for_igvn(final_size);
+
+  return final_size;
+}
+
+// Simplified version of Long.getChars. The digits are computed from the
+// negated value, so Long.MIN_VALUE needs no special case.
+void PhaseStringOpts::getChars_long(GraphKit& kit, Node* arg, Node* dst_array, BasicType bt, Node* end, Node* final_merge, Node* final_mem, int merge_index) {
+  // if (i >= 0) {
+  //     i = -i;
+  // }
+  IfNode* iff = kit.create_and_map_if(kit.control(), __ Bool(__ CmpL(arg, __ longcon(0)), BoolTest::lt),
+                                      PROB_FAIR, COUNT_UNKNOWN);
+
+  RegionNode* merge = new RegionNode(3);
+  kit.gvn().set_type(merge, Type::CONTROL);
+  Node* i = new PhiNode(merge, TypeLong::LONG);
+  kit.gvn().set_type(i, TypeLong::LONG);
+
+  merge->init_req(1, __ IfTrue(iff));
+  i->init_req(1, arg);
+  merge->init_req(2, __ IfFalse(iff));
+  i->init_req(2, kit.gvn().transform(new SubLNode(__ longcon(0), arg)));
+
+  kit.set_control(merge);
+
+  C->record_for_igvn(merge);
+  C->record_for_igvn(i);
+
+  // do {
+  //     q = i / 10;
+  //     buf [--charPos] = '0' + (int)(q * 10 - i);
+  //     i = q;
+  // } while (i != 0);
+
+  // Add loop predicate first.
+  kit.add_empty_predicates();
+
+  C->set_has_loops(true);
+  RegionNode* head = new RegionNode(3);
+  head->init_req(1, kit.control());
+
+  kit.gvn().set_type(head, Type::CONTROL);
+  Node* i_phi = new PhiNode(head, TypeLong::LONG);
+  i_phi->init_req(1, i);
+  kit.gvn().set_type(i_phi, TypeLong::LONG);
+  Node* charPos = new PhiNode(head, TypeInt::INT);
+  charPos->init_req(1, end);
+  kit.gvn().set_type(charPos, TypeInt::INT);
+  Node* mem = PhiNode::make(head, kit.memory(byte_adr_idx), Type::MEMORY, TypeAryPtr::BYTES);
+  kit.gvn().set_type(mem, Type::MEMORY);
+
+  kit.set_control(head);
+  kit.set_memory(mem, byte_adr_idx);
+
+  Node* q = kit.gvn().transform(new DivLNode(nullptr, i_phi, __ longcon(10)));
+  Node* r = kit.gvn().transform(new SubLNode(kit.gvn().transform(new MulLNode(q, __ longcon(10))), i_phi));
+  Node* index = __ SubI(charPos, __ intcon((bt == T_BYTE) ? 1 : 2));
+  Node* ch = __ AddI(__ ConvL2I(r), __ intcon('0'));
+  Node* st = __ store_to_memory(kit.control(), kit.array_element_address(dst_array, index, T_BYTE),
+                                ch, bt, byte_adr_idx, MemNode::unordered, false /* require_atomic_access */,
+                                false /* unaligned */, (bt != T_BYTE) /* mismatched */);
+
+  iff = kit.create_and_map_if(head, __ Bool(__ CmpL(q, __ longcon(0)), BoolTest::ne),
+                              PROB_FAIR, COUNT_UNKNOWN);
+  Node* ne = __ IfTrue(iff);
+  Node* eq = __ IfFalse(iff);
+
+  head->init_req(2, ne);
+  mem->init_req(2, st);
+
+  i_phi->init_req(2, q);
+  charPos->init_req(2, index);
+  charPos = index;
+
+  kit.set_control(eq);
+  kit.set_memory(st, byte_adr_idx);
+
+  C->record_for_igvn(head);
+  C->record_for_igvn(mem);
+  C->record_for_igvn(i_phi);
+  C->record_for_igvn(charPos);
+
+  // if (arg < 0) {
+  //     buf [--charPos] = '-';
+  // }
+  iff = kit.create_and_map_if(kit.control(), __ Bool(__ CmpL(arg, __ longcon(0)), BoolTest::lt),
+                              PROB_FAIR, COUNT_UNKNOWN);
+
+  final_merge->init_req(merge_index + 2, __ IfFalse(iff));
+  final_mem->init_req(merge_index + 2, kit.memory(byte_adr_idx));
+
+  kit.set_control(__ IfTrue(iff));
+  if (kit.stopped()) {
+    final_merge->init_req(merge_index + 1, C->top());
+    final_mem->init_req(merge_index + 1, C->top());
+  } else {
+    Node* index = __ SubI(charPos, __ intcon((bt == T_BYTE) ? 1 : 2));
+    st = __ store_to_memory(kit.control(), kit.array_element_address(dst_array, index, T_BYTE),
+                            __ intcon('-'), bt, byte_adr_idx, MemNode::unordered, false /* require_atomic_access */,
+                            false /* unaligned */, (bt != T_BYTE) /* mismatched */);
+
+    final_merge->init_req(merge_index + 1, kit.control());
+    final_mem->init_req(merge_index + 1, st);
+  }
+}
+
+// Copy the characters representing the long arg into dst_array starting at start
+Node* PhaseStringOpts::long_getChars(GraphKit& kit, Node* arg, Node* dst_array, Node* dst_coder, Node* start, Node* size) {
+  bool dcon = dst_coder->is_Con();
+  bool dbyte = dcon ? (dst_coder->get_int() == java_lang_String::CODER_LATIN1) : false;
+  Node* end = __ AddI(start, __ LShiftI(size, dst_coder));
+
+  // The final_merge node has 3 entries in case the encoding is known:
+  // (0) Control, (1) result w/ sign, (2) result w/o sign
+  // or 5 entries in case the encoding is not known:
+  // (0) Control, (1) Latin1 w/ sign, (2) Latin1 w/o sign, (3) UTF16 w/ sign, (4) UTF16 w/o sign
+  RegionNode* final_merge = new RegionNode(dcon ? 3 : 5);
+  kit.gvn().set_type(final_merge, Type::CONTROL);
+
+  Node* final_mem = PhiNode::make(final_merge, kit.memory(byte_adr_idx), Type::MEMORY, TypeAryPtr::BYTES);
+  kit.gvn().set_type(final_mem, Type::MEMORY);
+
+  IfNode* iff = nullptr;
+  Node* old_mem = kit.memory(byte_adr_idx);
+  if (!dcon) {
+    // Check encoding of destination
+    iff = kit.create_and_map_if(kit.control(), __ Bool(__ CmpI(dst_coder, __ intcon(0)), BoolTest::eq),
+                                PROB_FAIR, COUNT_UNKNOWN);
+  }
+  if (!dcon || dbyte) {
+    // Destination is Latin1,
+    if (!dcon) {
+      kit.set_control(__ IfTrue(iff));
+    }
+    getChars_long(kit, arg, dst_array, T_BYTE, end, final_merge, final_mem);
+  }
+  if (!dcon || !dbyte) {
+    // Destination is UTF16
+    int merge_index = 0;
+    if (!dcon) {
+      kit.set_control(__ IfFalse(iff));
+      kit.set_memory(old_mem, byte_adr_idx);
+      merge_index = 2; // Account for Latin1 case
+    }
+    getChars_long(kit, arg, dst_array, T_CHAR, end, final_merge, final_mem, merge_index);
+  }
+
+  // Final merge point for Latin1 and UTF16 case
+  kit.set_control(final_merge);
+  kit.set_memory(final_mem, byte_adr_idx);
+
+  C->record_for_igvn(final_merge);
+  C->record_for_igvn(final_mem);
+  return end;
+}
+
 // Copy 'count' bytes/chars from src_array to dst_array starting at index start
 void PhaseStringOpts::arraycopy(GraphKit& kit, IdealKit& ideal, Node* src_array, Node* dst_array, BasicType elembt, Node* start, Node* count) {
   assert(elembt == T_BYTE || elembt == T_CHAR, "Invalid type for arraycopy");
@@ -1877,6 +2131,16 @@ void PhaseStringOpts::replace_string_concat(StringConcat* sc) {
         string_sizes->init_req(argi, string_size);
         break;
       }
+      case StringConcat::LongMode: {
+        Node* string_size = long_stringSize(kit, arg);
+
+        // accumulate total
+        length = __ AddI(length, string_size);
+
+        // Cache this value for the use by long_getChars
+        string_sizes->init_req(argi, string_size);
+        break;
+      }
       case StringConcat::StringNullCheckMode: {
         const Type* type = kit.gvn().type(arg);
         assert(type != TypePtr::NULL_PTR, "missing check");
@@ -2042,6 +2306,10 @@ void PhaseStringOpts::replace_string_concat(StringConcat* sc) {
             start = int_getChars(kit, arg, dst_array, coder, start, string_sizes->in(argi));
             break;
           }
+          case StringConcat::LongMode: {
+            start = long_getChars(kit, arg, dst_array, coder, start, string_sizes->in(argi));
+            break;
+          }
           case StringConcat::StringNullCheckMode:
           case StringConcat::StringMode: {
             start = copy_string(kit, arg, dst_array, coder, start);
@@ -71,6 +71,15 @@ class PhaseStringOpts : public Phase {
   // Copy the characters representing arg into dst_array starting at start
   Node* int_getChars(GraphKit& kit, Node* arg, Node* dst_array, Node* dst_coder, Node* start, Node* size);
 
+  // Compute the number of characters required to represent the long value
+  Node* long_stringSize(GraphKit& kit, Node* value);
+
+  // Simplified version of Long.getChars
+  void getChars_long(GraphKit& kit, Node* arg, Node* dst_array, BasicType bt, Node* end, Node* final_merge, Node* final_mem, int merge_index = 0);
+
+  // Copy the characters representing the long arg into dst_array starting at start
+  Node* long_getChars(GraphKit& kit, Node* arg, Node* dst_array, Node* dst_coder, Node* start, Node* size);
+
   // Copy contents of the String str into dst_array starting at index start.
   Node* copy_string(GraphKit& kit, Node* str, Node* dst_array, Node* dst_coder, Node* start);
 
@@ -1884,8 +1884,13 @@ Node_List* CMoveKit::make_cmovevd_pack(Node_List* cmovd_pk) {
   if (!cmovd->is_CMove()) {
     return nullptr;
   }
-  if (cmovd->Opcode() != Op_CMoveF && cmovd->Opcode() != Op_CMoveD) {
-    return nullptr;
+  int cmov_opc = cmovd->Opcode();
+  if (cmov_opc != Op_CMoveF && cmov_opc != Op_CMoveD) {
+    // Integral CMoves are vectorized into a VectorMaskCmp and a VectorBlend
+    if ((cmov_opc != Op_CMoveI && cmov_opc != Op_CMoveL) ||
+        !is_blend_implemented(_sw->velt_basic_type(cmovd), cmovd_pk->size())) {
+      return nullptr;
+    }
   }
   if (pack(cmovd) != nullptr) { // already in the cmov pack
     return nullptr;
@@ -1922,6 +1927,13 @@ Node_List* CMoveKit::make_cmovevd_pack(Node_List* cmovd_pk) {
   if (cmpd_pk->size() != cmovd_pk->size() ) {
     return nullptr;
   }
+  // Only signed compares of the same type as the CMove have a VectorMaskCmp
+  // equivalent.
+  if ((cmov_opc == Op_CMoveI && cmpd->Opcode() != Op_CmpI) ||
+      (cmov_opc == Op_CMoveL && cmpd->Opcode() != Op_CmpL)) {
+    NOT_PRODUCT(if(_sw->is_trace_cmov()) {tty->print("CMoveKit::make_cmovevd_pack: Cmp %d does not fit CMove %d for building vector, escaping...", cmpd->_idx, cmovd->_idx); cmpd->dump();})
+    return nullptr;
+  }
 
   if (!test_cmpd_pack(cmpd_pk, cmovd_pk)) {
     NOT_PRODUCT(if(_sw->is_trace_cmov()) {tty->print("CMoveKit::make_cmovevd_pack: cmpd pack for CmpD %d failed vectorization test", cmpd->_idx); cmpd->dump();})
@@ -1951,6 +1963,11 @@ Node_List* CMoveKit::make_cmovevd_pack(Node_List* cmovd_pk) {
   return new_cmpd_pk;
 }
 
+bool CMoveKit::is_blend_implemented(BasicType bt, uint vlen) {
+  return Matcher::match_rule_supported_vector(Op_VectorMaskCmp, vlen, bt) &&
+         Matcher::match_rule_supported_vector(Op_VectorBlend, vlen, bt);
+}
+
 bool CMoveKit::test_cmpd_pack(Node_List* cmpd_pk, Node_List* cmovd_pk) {
   Node* cmpd0 = cmpd_pk->at(0);
   assert(cmpd0->is_Cmp(), "CMoveKit::test_cmpd_pack: should be CmpDNode");
@@ -2618,8 +2635,19 @@ bool SuperWord::output() {
         }
         BasicType bt = velt_basic_type(n);
         const TypeVect* vt = TypeVect::make(bt, vlen);
-        assert(bt == T_FLOAT || bt == T_DOUBLE, "Only vectorization for FP cmovs is supported");
-        if (bt == T_FLOAT) {
+        if (bt == T_INT || bt == T_LONG) {
+          // The compare has the same inputs as the CMove, possibly swapped,
+          // see CMoveKit::test_cmpd_pack.
+          Node* cmp = bol->in(1);
+          bool swapped = cmp->in(1) != n->in(CMoveNode::IfFalse);
+          BoolTest::mask pred = bol->as_Bool()->_test._test;
+          Node* mask = new VectorMaskCmpNode(pred, swapped ? src2 : src1, swapped ? src1 : src2,
+                                             _igvn.intcon(pred), TypeVect::makemask(bt, vlen));
+          _igvn.register_new_node_with_optimizer(mask);
+          _phase->set_ctrl(mask, _phase->get_ctrl(p->at(0)));
+          vn = new VectorBlendNode(src1, src2, mask);
+          vlen_in_bytes = vn->as_Vector()->length_in_bytes();
+        } else if (bt == T_FLOAT) {
           vn = new CMoveVFNode(cc, src1, src2, vt);
         } else {
           assert(bt == T_DOUBLE, "Expected double");
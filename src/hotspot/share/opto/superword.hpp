@@ -217,6 +217,7 @@ class CMoveKit {
   Node* is_CmpD_candidate(Node* nd) const; // otherwise return null
   Node_List* make_cmovevd_pack(Node_List* cmovd_pk);
   bool test_cmpd_pack(Node_List* cmpd_pk, Node_List* cmovd_pk);
+  static bool is_blend_implemented(BasicType bt, uint vlen);
 };//class CMoveKit
 
 // JVMCI: OrderedPair is moved up to deal with compilation issues on Windows
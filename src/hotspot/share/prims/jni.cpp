@@ -2803,9 +2803,11 @@ JNI_ENTRY(void, jni_GetStringUTFRegion(JNIEnv *env, jstring string, jsize start,
   }
 JNI_END
 
+// Whether an object can be pinned must not change between the lock and the
+// unlock call for it. It does not, as pinnable objects are never moved.
 static oop lock_gc_or_pin_object(JavaThread* thread, jobject obj) {
-  if (Universe::heap()->supports_object_pinning()) {
-    const oop o = JNIHandles::resolve_non_null(obj);
+  const oop o = JNIHandles::resolve_non_null(obj);
+  if (Universe::heap()->can_pin_object(o)) {
     return Universe::heap()->pin_object(thread, o);
   } else {
     GCLocker::lock_critical(thread);
@@ -2814,8 +2816,8 @@ static oop lock_gc_or_pin_object(JavaThread* thread, jobject obj) {
 }
 
 static void unlock_gc_or_unpin_object(JavaThread* thread, jobject obj) {
-  if (Universe::heap()->supports_object_pinning()) {
-    const oop o = JNIHandles::resolve_non_null(obj);
+  const oop o = JNIHandles::resolve_non_null(obj);
+  if (Universe::heap()->can_pin_object(o)) {
     return Universe::heap()->unpin_object(thread, o);
   } else {
     GCLocker::unlock_critical(thread);
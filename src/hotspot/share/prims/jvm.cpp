@@ -42,6 +42,7 @@
 #include "classfile/stringTable.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
+#include "classfile/verifier.hpp"
 #include "classfile/vmClasses.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "gc/shared/collectedHeap.inline.hpp"
@@ -1665,6 +1666,17 @@ JVM_END
 
 // New (JDK 1.4) reflection implementation /////////////////////////////////////
 
+// Linking is only needed before reflecting on methods if the rewriter may
+// still replace some of them, which it does for methods with jsr. Neither
+// jsr nor ret is allowed in class files of version 51 or later.
+static void link_for_reflection(InstanceKlass* k, bool methods, TRAPS) {
+  if (LazyReflectionLinking &&
+      (!methods || k->major_version() >= Verifier::INVOKEDYNAMIC_MAJOR_VERSION)) {
+    return;
+  }
+  k->link_class(CHECK);
+}
+
 JVM_ENTRY(jobjectArray, JVM_GetClassDeclaredFields(JNIEnv *env, jclass ofClass, jboolean publicOnly))
 {
   JvmtiVMObjectAllocEventCollector oam;
@@ -1682,7 +1694,7 @@ JVM_ENTRY(jobjectArray, JVM_GetClassDeclaredFields(JNIEnv *env, jclass ofClass,
   constantPoolHandle cp(THREAD, k->constants());
 
   // Ensure class is linked
-  k->link_class(CHECK_NULL);
+  link_for_reflection(k, false, CHECK_NULL);
 
   // Allocate result
   int num_fields;
@@ -1790,7 +1802,7 @@ static jobjectArray get_class_declared_methods_helper(
   InstanceKlass* k = InstanceKlass::cast(java_lang_Class::as_Klass(ofMirror));
 
   // Ensure class is linked
-  k->link_class(CHECK_NULL);
+  link_for_reflection(k, true, CHECK_NULL);
 
   Array<Method*>* methods = k->methods();
   int methods_length = methods->length();
@@ -3856,3 +3868,7 @@ JVM_ENTRY(jobjectArray, JVM_Checkpoint(JNIEnv *env, jarray fd_arr, jobjectArray
   Handle ret = crac::checkpoint(fd_arr, obj_arr, dry_run, jcmd_stream, CHECK_NULL);
   return (jobjectArray) JNIHandles::make_local(THREAD, ret());
 JVM_END
+
+JVM_ENTRY_NO_ENV(jboolean, JVM_RegisterCheckpointHook(JVM_CheckpointHook before_checkpoint, JVM_CheckpointHook after_restore, void *data))
+  return crac::register_checkpoint_hook(before_checkpoint, after_restore, data) ? JNI_TRUE : JNI_FALSE;
+JVM_END
@@ -984,6 +984,10 @@ JvmtiEnvBase::get_object_monitor_usage(JavaThread* calling_thread, jobject objec
 
         if (mark.has_locker()) {
           owner = (address)mark.locker(); // save the address of the Lock word
+        } else if (UseLightweightLocking && mark.is_fast_locked()) {
+          // the object is on the lock stack of its owner
+          owning_thread = Threads::owning_thread_from_object(tlh.list(), hobj());
+          assert(owning_thread != NULL, "owning JavaThread must not be NULL");
         }
         // implied else: no owner
       } else {
@@ -1002,13 +1006,18 @@ JvmtiEnvBase::get_object_monitor_usage(JavaThread* calling_thread, jobject objec
 
     if (owner != NULL) {
       // This monitor is owned so we have to find the owning JavaThread.
-      owning_thread = Threads::owning_thread_from_monitor_owner(tlh.list(), owner);
+      if (mon != NULL) {
+        owning_thread = Threads::owning_thread_from_monitor(tlh.list(), mon);
+      } else {
+        owning_thread = Threads::owning_thread_from_monitor_owner(tlh.list(), owner);
+      }
       assert(owning_thread != NULL, "owning JavaThread must not be NULL");
-      Handle     th(current_thread, owning_thread->threadObj());
-      ret.owner = (jthread)jni_reference(calling_thread, th);
     }
 
     if (owning_thread != NULL) {  // monitor is owned
+      Handle     th(current_thread, owning_thread->threadObj());
+      ret.owner = (jthread)jni_reference(calling_thread, th);
+
       // The recursions field of a monitor does not reflect recursions
       // as lightweight locks before inflating the monitor are not included.
       // We have to count the number of recursive monitor entries the hard way.
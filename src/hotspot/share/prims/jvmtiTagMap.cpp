@@ -49,7 +49,6 @@
 #include "prims/jvmtiImpl.hpp"
 #include "prims/jvmtiTagMap.hpp"
 #include "prims/jvmtiTagMapTable.hpp"
-#include "runtime/biasedLocking.hpp"
 #include "runtime/deoptimization.hpp"
 #include "runtime/frame.inline.hpp"
 #include "runtime/handles.inline.hpp"
@@ -67,6 +66,7 @@
 #include "runtime/vmThread.hpp"
 #include "runtime/vmOperations.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/objectBitSet.inline.hpp"
 
 bool JvmtiTagMap::_has_object_free_events = false;
 
@@ -75,7 +75,6 @@ JvmtiTagMap::JvmtiTagMap(JvmtiEnv* env) :
   _env(env),
   _lock(Mutex::nonleaf+1, "JvmtiTagMap_lock", Mutex::_allow_vm_block_flag,
         Mutex::_safepoint_check_never),
-  _needs_rehashing(false),
   _needs_cleaning(false),
   _posting_events(false) {
 
@@ -135,7 +134,7 @@ bool JvmtiTagMap::is_empty() {
   return hashmap()->is_empty();
 }
 
-// This checks for posting and rehashing before operations that
+// This checks for posting before operations that use
 // this tagmap table.
 void JvmtiTagMap::check_hashmap(GrowableArray<jlong>* objects) {
   assert(is_locked(), "checking");
@@ -147,14 +146,9 @@ void JvmtiTagMap::check_hashmap(GrowableArray<jlong>* objects) {
       env()->is_enabled(JVMTI_EVENT_OBJECT_FREE)) {
     remove_dead_entries_locked(objects);
   }
-  if (_needs_rehashing) {
-    log_info(jvmti, table)("TagMap table needs rehashing");
-    hashmap()->rehash();
-    _needs_rehashing = false;
-  }
 }
 
-// This checks for posting and rehashing and is called from the heap walks.
+// This checks for posting and is called from the heap walks.
 void JvmtiTagMap::check_hashmaps_for_heapwalk(GrowableArray<jlong>* objects) {
   assert(SafepointSynchronize::is_at_safepoint(), "called from safepoints");
 
@@ -175,14 +169,7 @@ void JvmtiTagMap::check_hashmaps_for_heapwalk(GrowableArray<jlong>* objects) {
 // not tagged
 //
 static inline jlong tag_for(JvmtiTagMap* tag_map, oop o) {
-  JvmtiTagMapEntry* entry = tag_map->hashmap()->find(o);
-  if (entry == NULL) {
-    return 0;
-  } else {
-    jlong tag = entry->tag();
-    assert(tag != 0, "should not be zero");
-    return entry->tag();
-  }
+  return tag_map->hashmap()->find_tag(o);
 }
 
 
@@ -350,14 +337,18 @@ class TwoOopCallbackWrapper : public CallbackWrapper {
 //
 // This function is performance critical. If many threads attempt to tag objects
 // around the same time then it's possible that the Mutex associated with the
-// tag map will be a hot lock.
+// tag map will be a hot lock. Only writers take it, get_tag() doesn't.
 void JvmtiTagMap::set_tag(jobject object, jlong tag) {
-  MutexLocker ml(lock(), Mutex::_no_safepoint_check_flag);
+  if (tag != 0) {
+    // The table is keyed by the identity hash. Installing it may revoke a bias
+    // and safepoint, which can't be done with the hashmap lock held.
+    JNIHandles::resolve_non_null(object)->identity_hash();
+  }
 
-  // SetTag should not post events because the JavaThread has to
+  // SetTag doesn't post events because the JavaThread has to
   // transition to native for the callback and this cannot stop for
   // safepoints with the hashmap lock held.
-  check_hashmap(NULL);  /* don't collect dead objects */
+  MutexLocker ml(lock(), Mutex::_no_safepoint_check_flag);
 
   // resolve the object
   oop o = JNIHandles::resolve_non_null(object);
@@ -386,14 +377,10 @@ void JvmtiTagMap::set_tag(jobject object, jlong tag) {
 }
 
 // get the tag for an object
+//
+// Lookups in the hashmap are lock-free. GetTag doesn't post events either,
+// the dead entries are removed by the ServiceThread or before a heap walk.
 jlong JvmtiTagMap::get_tag(jobject object) {
-  MutexLocker ml(lock(), Mutex::_no_safepoint_check_flag);
-
-  // GetTag should not post events because the JavaThread has to
-  // transition to native for the callback and this cannot stop for
-  // safepoints with the hashmap lock held.
-  check_hashmap(NULL); /* don't collect dead objects */
-
   // resolve the object
   oop o = JNIHandles::resolve_non_null(object);
 
@@ -1357,40 +1344,15 @@ jvmtiError JvmtiTagMap::get_objects_with_tags(const jlong* tags,
 // ObjectMarker is used to support the marking objects when walking the
 // heap.
 //
-// This implementation uses the existing mark bits in an object for
-// marking. Objects that are marked must later have their headers restored.
-// As most objects are unlocked and don't have their identity hash computed
-// we don't have to save their headers. Instead we save the headers that
-// are "interesting". Later when the headers are restored this implementation
-// restores all headers to their initial value and then restores the few
-// objects that had interesting headers.
-//
-// Future work: This implementation currently uses growable arrays to save
-// the oop and header of interesting objects. As an optimization we could
-// use the same technique as the GC and make use of the unused area
-// between top() and end().
-//
-
-// An ObjectClosure used to restore the mark bits of an object
-class RestoreMarksClosure : public ObjectClosure {
- public:
-  void do_object(oop o) {
-    if (o != NULL) {
-      markWord mark = o->mark();
-      if (mark.is_marked()) {
-        o->init_mark();
-      }
-    }
-  }
-};
+// The marks are kept in a side bitmap rather than in the object headers,
+// so a heap walk neither destroys nor has to restore the mark words. This
+// keeps the identity hashes intact, which the tag map uses to find objects
+// while the callbacks of the walk query and update tags.
 
 // ObjectMarker provides the mark and visited functions
 class ObjectMarker : AllStatic {
  private:
-  // saved headers
-  static GrowableArray<oop>* _saved_oop_stack;
-  static GrowableArray<markWord>* _saved_mark_stack;
-  static bool _needs_reset;                  // do we need to reset mark bits?
+  static ObjectBitSet<mtServiceability>* _bitset;
 
  public:
   static void init();                       // initialize
@@ -1398,86 +1360,40 @@ class ObjectMarker : AllStatic {
 
   static inline void mark(oop o);           // mark an object
   static inline bool visited(oop o);        // check if object has been visited
-
-  static inline bool needs_reset()            { return _needs_reset; }
-  static inline void set_needs_reset(bool v)  { _needs_reset = v; }
 };
 
-GrowableArray<oop>* ObjectMarker::_saved_oop_stack = NULL;
-GrowableArray<markWord>* ObjectMarker::_saved_mark_stack = NULL;
-bool ObjectMarker::_needs_reset = true;  // need to reset mark bits by default
+ObjectBitSet<mtServiceability>* ObjectMarker::_bitset = NULL;
 
 // initialize ObjectMarker - prepares for object marking
 void ObjectMarker::init() {
   assert(Thread::current()->is_VM_thread(), "must be VMThread");
   assert(SafepointSynchronize::is_at_safepoint(), "must be at a safepoint");
+  assert(_bitset == NULL, "already marking");
 
-  // prepare heap for iteration
-  Universe::heap()->ensure_parsability(false);  // no need to retire TLABs
-
-  // create stacks for interesting headers
-  _saved_mark_stack = new (ResourceObj::C_HEAP, mtServiceability) GrowableArray<markWord>(4000, mtServiceability);
-  _saved_oop_stack = new (ResourceObj::C_HEAP, mtServiceability) GrowableArray<oop>(4000, mtServiceability);
-
-  if (UseBiasedLocking) {
-    BiasedLocking::preserve_marks();
-  }
+  _bitset = new ObjectBitSet<mtServiceability>();
 }
 
-// Object marking is done so restore object headers
+// Object marking is done so free the marks
 void ObjectMarker::done() {
-  // iterate over all objects and restore the mark bits to
-  // their initial value
-  RestoreMarksClosure blk;
-  if (needs_reset()) {
-    Universe::heap()->object_iterate(&blk);
-  } else {
-    // We don't need to reset mark bits on this call, but reset the
-    // flag to the default for the next call.
-    set_needs_reset(true);
-  }
-
-  // now restore the interesting headers
-  for (int i = 0; i < _saved_oop_stack->length(); i++) {
-    oop o = _saved_oop_stack->at(i);
-    markWord mark = _saved_mark_stack->at(i);
-    o->set_mark(mark);
-  }
-
-  if (UseBiasedLocking) {
-    BiasedLocking::restore_marks();
-  }
-
-  // free the stacks
-  delete _saved_oop_stack;
-  delete _saved_mark_stack;
+  delete _bitset;
+  _bitset = NULL;
 }
 
 // mark an object
 inline void ObjectMarker::mark(oop o) {
   assert(Universe::heap()->is_in(o), "sanity check");
-  assert(!o->mark().is_marked(), "should only mark an object once");
-
-  // object's mark word
-  markWord mark = o->mark();
-
-  if (o->mark_must_be_preserved(mark)) {
-    _saved_mark_stack->push(mark);
-    _saved_oop_stack->push(o);
-  }
-
-  // mark the object
-  o->set_mark(markWord::prototype().set_marked());
+  assert(!visited(o), "should only mark an object once");
+  _bitset->mark_obj(o);
 }
 
 // return true if object is marked
 inline bool ObjectMarker::visited(oop o) {
-  return o->mark().is_marked();
+  return _bitset->is_marked(o);
 }
 
 // Stack allocated class to help ensure that ObjectMarker is used
 // correctly. Constructor initializes ObjectMarker, destructor calls
-// ObjectMarker's done() function to restore object headers.
+// ObjectMarker's done() function to free the marks.
 class ObjectMarkerController : public StackObj {
  public:
   ObjectMarkerController() {
@@ -2965,20 +2881,12 @@ void VM_HeapWalkOperation::doit() {
 
   // the heap walk starts with an initial object or the heap roots
   if (initial_object().is_null()) {
-    // If either collect_stack_roots() or collect_simple_roots()
-    // returns false at this point, then there are no mark bits
-    // to reset.
-    ObjectMarker::set_needs_reset(false);
-
     // Calling collect_stack_roots() before collect_simple_roots()
     // can result in a big performance boost for an agent that is
     // focused on analyzing references in the thread stacks.
     if (!collect_stack_roots()) return;
 
     if (!collect_simple_roots()) return;
-
-    // no early return so enable heap traversal to reset the mark bits
-    ObjectMarker::set_needs_reset(true);
   } else {
     visit_stack()->push(initial_object()());
   }
@@ -3066,21 +2974,6 @@ void JvmtiTagMap::follow_references(jint heap_filter,
   post_dead_objects(&dead_objects);
 }
 
-// Concurrent GC needs to call this in relocation pause, so after the objects are moved
-// and have their new addresses, the table can be rehashed.
-void JvmtiTagMap::set_needs_rehashing() {
-  assert(SafepointSynchronize::is_at_safepoint(), "called in gc pause");
-  assert(Thread::current()->is_VM_thread(), "should be the VM thread");
-
-  JvmtiEnvIterator it;
-  for (JvmtiEnv* env = it.first(); env != NULL; env = it.next(env)) {
-    JvmtiTagMap* tag_map = env->tag_map_acquire();
-    if (tag_map != NULL) {
-      tag_map->_needs_rehashing = true;
-    }
-  }
-}
-
 // Verify gc_notification follows set_needs_cleaning.
 DEBUG_ONLY(static bool notified_needs_cleaning = false;)
 
@@ -40,7 +40,6 @@ class JvmtiTagMap :  public CHeapObj<mtInternal> {
   JvmtiEnv*             _env;                       // the jvmti environment
   Monitor               _lock;                      // lock for this tag map
   JvmtiTagMapTable*     _hashmap;                   // the hashmap for tags
-  bool                  _needs_rehashing;
   bool                  _needs_cleaning;
   bool                  _posting_events;
 
@@ -115,7 +114,6 @@ class JvmtiTagMap :  public CHeapObj<mtInternal> {
   void post_dead_objects(GrowableArray<jlong>* const objects);
 
   static void check_hashmaps_for_heapwalk(GrowableArray<jlong>* objects);
-  static void set_needs_rehashing() NOT_JVMTI_RETURN;
   static void set_needs_cleaning() NOT_JVMTI_RETURN;
   static void gc_notification(size_t num_dead_entries) NOT_JVMTI_RETURN;
 
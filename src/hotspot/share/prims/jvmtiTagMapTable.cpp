@@ -35,233 +35,282 @@
 #include "prims/jvmtiEventController.inline.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "prims/jvmtiTagMapTable.hpp"
-#include "utilities/hashtable.inline.hpp"
+#include "runtime/safepoint.hpp"
+#include "utilities/concurrentHashTable.inline.hpp"
 #include "utilities/macros.hpp"
 
+// 2^24 is max size
+static const size_t END_SIZE = 24;
+// If a chain gets to 32 something might be wrong
+static const size_t GROW_HINT = 32;
+// Average chain length that makes the table grow
+static const size_t GROW_LOAD_FACTOR = 4;
+
+static const size_t JvmtiTagMapTableSizeLog = 10;
+
 oop JvmtiTagMapEntry::object() {
-  return literal().resolve();
+  return _wh.resolve();
 }
 
 oop JvmtiTagMapEntry::object_no_keepalive() {
   // Just peek at the object without keeping it alive.
-  return literal().peek();
+  return _wh.peek();
 }
 
-JvmtiTagMapTable::JvmtiTagMapTable()
-  : Hashtable<WeakHandle, mtServiceability>(_table_size, sizeof(JvmtiTagMapEntry)) {}
+class JvmtiTagMapTableConfig : public AllStatic {
+ public:
+  typedef JvmtiTagMapEntry Value;
 
-void JvmtiTagMapTable::clear() {
-  // Clear this table
-  log_debug(jvmti, table)("JvmtiTagMapTable cleared");
-  for (int i = 0; i < table_size(); ++i) {
-    for (JvmtiTagMapEntry* m = bucket(i); m != NULL;) {
-      JvmtiTagMapEntry* entry = m;
-      // read next before freeing.
-      m = m->next();
-      free_entry(entry);
+  // The hash is taken from the entry, so the object is not needed. Dead
+  // entries are never reported here, they are only removed by
+  // remove_dead_entries() which collects their tags for ObjectFree events.
+  static uintx get_hash(Value const& value, bool* is_dead) {
+    *is_dead = false;
+    return value.hash();
+  }
+
+  // We use default allocation/deallocation but counted
+  static void* allocate_node(void* context, size_t size, Value const& value) {
+    ((JvmtiTagMapTable*)context)->item_added();
+    return AllocateHeap(size, mtServiceability);
+  }
+  static void free_node(void* context, void* memory, Value const& value) {
+    value.weak_handle().release(JvmtiExport::weak_tag_storage()); // release to OopStorage
+    FreeHeap(memory);
+    ((JvmtiTagMapTable*)context)->item_removed();
+  }
+};
+
+class JvmtiTagMapTableLookup : StackObj {
+ private:
+  oop   _obj;
+  uintx _hash;
+
+ public:
+  JvmtiTagMapTableLookup(oop obj, uintx hash) : _obj(obj), _hash(hash) {}
+
+  uintx get_hash() const {
+    return _hash;
+  }
+  bool equals(JvmtiTagMapEntry* value) {
+    // Peek the object to check if it is the right target.
+    if (value->hash() != _hash || value->object_no_keepalive() != _obj) {
+      return false;
     }
-    JvmtiTagMapEntry** p = bucket_addr(i);
-    *p = NULL; // clear out buckets.
+    // The object() accessor makes sure the target object is kept alive before
+    // leaking out.
+    (void)value->object();
+    return true;
   }
-  assert(number_of_entries() == 0, "should have removed all entries");
-}
+  bool is_dead(JvmtiTagMapEntry* value) {
+    // See JvmtiTagMapTableConfig::get_hash().
+    return false;
+  }
+};
 
-JvmtiTagMapTable::~JvmtiTagMapTable() {
-  clear();
-  // base class ~BasicHashtable deallocates the buckets.
+// Returns false if obj cannot be in the table. Every tagged object got its
+// identity hash installed by add(), so an object without one is not tagged
+// and the lookup doesn't install a hash as a side effect.
+static bool lookup_hash(oop obj, uintx* hash) {
+  assert(obj != NULL, "Cannot search for a NULL object");
+  if (obj->fast_no_hash_check()) {
+    return false;
+  }
+  *hash = (uintx)obj->identity_hash();
+  return true;
 }
 
-// Entries are C_Heap allocated
-JvmtiTagMapEntry* JvmtiTagMapTable::new_entry(unsigned int hash, WeakHandle w, jlong tag) {
-  JvmtiTagMapEntry* entry = (JvmtiTagMapEntry*)Hashtable<WeakHandle, mtServiceability>::new_entry(hash, w);
-  entry->set_tag(tag);
-  return entry;
+JvmtiTagMapTable::JvmtiTagMapTable() : _items_count(0) {
+  _table = new JvmtiTagMapTableHash(JvmtiTagMapTableSizeLog, END_SIZE, GROW_HINT, this);
 }
 
-void JvmtiTagMapTable::free_entry(JvmtiTagMapEntry* entry) {
-  entry->literal().release(JvmtiExport::weak_tag_storage()); // release to OopStorage
-  BasicHashtable<mtServiceability>::free_entry(entry);
+class JvmtiTagMapTableAll : StackObj {
+ public:
+  bool operator()(JvmtiTagMapEntry* value) {
+    return true;
+  }
+};
+
+class JvmtiTagMapTableNoop : StackObj {
+ public:
+  void operator()(JvmtiTagMapEntry* value) {}
+};
+
+void JvmtiTagMapTable::clear() {
+  // Clear this table
+  log_debug(jvmti, table)("JvmtiTagMapTable cleared");
+  JvmtiTagMapTableAll all;
+  JvmtiTagMapTableNoop noop;
+  _table->bulk_delete(Thread::current(), all, noop);
+  assert(is_empty(), "should have removed all entries");
 }
 
-unsigned int JvmtiTagMapTable::compute_hash(oop obj) {
-  assert(obj != NULL, "obj is null");
-  return Universe::heap()->hash_oop(obj);
+JvmtiTagMapTable::~JvmtiTagMapTable() {
+  // The ConcurrentHashTable frees the remaining nodes, which releases
+  // their weak handles.
+  delete _table;
 }
 
-JvmtiTagMapEntry* JvmtiTagMapTable::find(int index, unsigned int hash, oop obj) {
-  assert(obj != NULL, "Cannot search for a NULL object");
+class JvmtiTagMapTableGetEntry : StackObj {
+  JvmtiTagMapEntry* _entry;
+ public:
+  JvmtiTagMapTableGetEntry() : _entry(NULL) {}
+  void operator()(JvmtiTagMapEntry* value) {
+    _entry = value;
+  }
+  JvmtiTagMapEntry* entry() const { return _entry; }
+};
 
-  for (JvmtiTagMapEntry* p = bucket(index); p != NULL; p = p->next()) {
-    if (p->hash() == hash) {
-
-      // Peek the object to check if it is the right target.
-      oop target = p->object_no_keepalive();
-
-      // The obj is in the table as a target already
-      if (target == obj) {
-        ResourceMark rm;
-        log_trace(jvmti, table)("JvmtiTagMap entry found for %s index %d",
-                                obj->print_value_string(), index);
-        // The object() accessor makes sure the target object is kept alive before
-        // leaking out.
-        (void)p->object();
-        return p;
-      }
-    }
+class JvmtiTagMapTableGetTag : StackObj {
+  jlong _tag;
+ public:
+  JvmtiTagMapTableGetTag() : _tag(0) {}
+  void operator()(JvmtiTagMapEntry* value) {
+    // Read while the entry is protected by the critical section of the lookup.
+    _tag = value->tag();
+    assert(_tag != 0, "should not be zero");
+  }
+  jlong tag() const { return _tag; }
+};
+
+jlong JvmtiTagMapTable::find_tag(oop obj) {
+  uintx hash;
+  if (is_empty() || !lookup_hash(obj, &hash)) {
+    return 0;
   }
-  return NULL;
+  JvmtiTagMapTableLookup lookup(obj, hash);
+  JvmtiTagMapTableGetTag get;
+  _table->get(Thread::current(), lookup, get);
+  return get.tag();
 }
 
+// The returned entry is only stable while no other thread can remove it,
+// that is with the tag map lock held or at a safepoint.
 JvmtiTagMapEntry* JvmtiTagMapTable::find(oop obj) {
-  unsigned int hash = compute_hash(obj);
-  int index = hash_to_index(hash);
-  return find(index, hash, obj);
+  uintx hash;
+  if (is_empty() || !lookup_hash(obj, &hash)) {
+    return NULL;
+  }
+  JvmtiTagMapTableLookup lookup(obj, hash);
+  JvmtiTagMapTableGetEntry get;
+  if (_table->get(Thread::current(), lookup, get)) {
+    ResourceMark rm;
+    log_trace(jvmti, table)("JvmtiTagMap entry found for %s", obj->print_value_string());
+  }
+  return get.entry();
 }
 
-JvmtiTagMapEntry* JvmtiTagMapTable::add(oop obj, jlong tag) {
-  unsigned int hash = compute_hash(obj);
-  int index = hash_to_index(hash);
-  // One was added while acquiring the lock
-  assert(find(index, hash, obj) == NULL, "shouldn't already be present");
+void JvmtiTagMapTable::add(oop obj, jlong tag) {
+  Thread* thread = Thread::current();
+  // Installs the identity hash if the object doesn't have one yet. Java
+  // threads must have done that before taking the tag map lock, since this
+  // may revoke a bias (see JvmtiTagMap::set_tag).
+  assert(!thread->is_Java_thread() || !obj->mark().has_bias_pattern(), "may safepoint");
+  uintx hash = (uintx)obj->identity_hash();
 
   // obj was read with AS_NO_KEEPALIVE, or equivalent.
   // The object needs to be kept alive when it is published.
   Universe::heap()->keep_alive(obj);
 
   WeakHandle w(JvmtiExport::weak_tag_storage(), obj);
-  JvmtiTagMapEntry* p = new_entry(hash, w, tag);
-  Hashtable<WeakHandle, mtServiceability>::add_entry(index, p);
+  JvmtiTagMapTableLookup lookup(obj, hash);
+  bool grow_hint = false;
+  bool inserted = _table->insert(thread, lookup, JvmtiTagMapEntry(w, hash, tag), &grow_hint);
+  // One was added while acquiring the lock
+  assert(inserted, "shouldn't already be present");
+  if (!inserted) {
+    w.release(JvmtiExport::weak_tag_storage());
+    return;
+  }
   ResourceMark rm;
-  log_trace(jvmti, table)("JvmtiTagMap entry added for %s index %d",
-                          obj->print_value_string(), index);
-
-  // Resize if the table is getting too big.
-  resize_if_needed();
+  log_trace(jvmti, table)("JvmtiTagMap entry added for %s", obj->print_value_string());
 
-  return p;
+  // Grow if the table is getting too loaded.
+  grow_if_needed(grow_hint);
 }
 
-void JvmtiTagMapTable::remove(oop obj) {
-  unsigned int hash = compute_hash(obj);
-  int index = hash_to_index(hash);
-  JvmtiTagMapEntry** p = bucket_addr(index);
-  JvmtiTagMapEntry* entry = bucket(index);
-  while (entry != NULL) {
-    oop target = entry->object_no_keepalive();
-    if (target != NULL && target == obj) {
-      log_trace(jvmti, table)("JvmtiTagMap entry removed for index %d", index);
-      *p = entry->next();
-      free_entry(entry);
-      return; // done
-    }
-    // get next entry and address
-    p = entry->next_addr();
-    entry = entry->next();
+void JvmtiTagMapTable::grow_if_needed(bool grow_hint) {
+  if (_table->is_max_size_reached()) {
+    return;
   }
-}
-
-void JvmtiTagMapTable::entry_iterate(JvmtiTagMapEntryClosure* closure) {
-  for (int i = 0; i < table_size(); ++i) {
-    for (JvmtiTagMapEntry* p = bucket(i); p != NULL; p = p->next()) {
-      closure->do_entry(p);
+  Thread* thread = Thread::current();
+  size_t table_size = (size_t)1 << _table->get_size_log2(thread);
+  if (grow_hint || Atomic::load(&_items_count) > GROW_LOAD_FACTOR * table_size) {
+    if (_table->grow(thread)) {
+      log_info(jvmti, table)("JvmtiTagMap table resized to " SIZE_FORMAT,
+                             (size_t)1 << _table->get_size_log2(thread));
     }
   }
 }
 
-const int _resize_load_trigger = 5;       // load factor that will trigger the resize
-static bool _resizable = true;
-
-void JvmtiTagMapTable::resize_if_needed() {
-  if (_resizable && number_of_entries() > (_resize_load_trigger*table_size())) {
-    int desired_size = calculate_resize(true);
-    if (desired_size == table_size()) {
-      _resizable = false; // hit max
-    } else {
-      if (!resize(desired_size)) {
-        // Something went wrong, turn resizing off
-        _resizable = false;
-      }
-      log_info(jvmti, table) ("JvmtiTagMap table resized to %d", table_size());
-    }
+void JvmtiTagMapTable::remove(oop obj) {
+  uintx hash;
+  if (is_empty() || !lookup_hash(obj, &hash)) {
+    return;
+  }
+  JvmtiTagMapTableLookup lookup(obj, hash);
+  if (_table->remove(Thread::current(), lookup)) {
+    log_trace(jvmti, table)("JvmtiTagMap entry removed");
   }
 }
 
-// Serially remove entries for dead oops from the table and store dead oops'
-// tag in objects array if provided.
-void JvmtiTagMapTable::remove_dead_entries(GrowableArray<jlong>* objects) {
-  int oops_removed = 0;
-  int oops_counted = 0;
-  for (int i = 0; i < table_size(); ++i) {
-    JvmtiTagMapEntry** p = bucket_addr(i);
-    JvmtiTagMapEntry* entry = bucket(i);
-    while (entry != NULL) {
-      oops_counted++;
-      oop l = entry->object_no_keepalive();
-      if (l != NULL) {
-        p = entry->next_addr();
-      } else {
-        // Entry has been removed.
-        oops_removed++;
-        log_trace(jvmti, table)("JvmtiTagMap entry removed for index %d", i);
-        jlong tag = entry->tag();
-        *p = entry->next();
-        free_entry(entry);
-
-        // collect object tags for posting JVMTI events later
-        if (objects != NULL) {
-          objects->append(tag);
-        }
-      }
-      // get next entry
-      entry = *p;
-    }
+class JvmtiTagMapTableScan : StackObj {
+  JvmtiTagMapEntryClosure* _closure;
+ public:
+  JvmtiTagMapTableScan(JvmtiTagMapEntryClosure* closure) : _closure(closure) {}
+  bool operator()(JvmtiTagMapEntry* value) {
+    _closure->do_entry(value);
+    return true;
   }
+};
 
-  log_info(jvmti, table) ("JvmtiTagMap entries counted %d removed %d",
-                          oops_counted, oops_removed);
+void JvmtiTagMapTable::entry_iterate(JvmtiTagMapEntryClosure* closure) {
+  JvmtiTagMapTableScan scan(closure);
+  if (SafepointSynchronize::is_at_safepoint()) {
+    _table->do_safepoint_scan(scan);
+  } else {
+    _table->do_scan(Thread::current(), scan);
+  }
 }
 
-// Rehash oops in the table
-void JvmtiTagMapTable::rehash() {
-  ResourceMark rm;
-  GrowableArray<JvmtiTagMapEntry*> moved_entries;
-
-  int oops_counted = 0;
-  for (int i = 0; i < table_size(); ++i) {
-    JvmtiTagMapEntry** p = bucket_addr(i);
-    JvmtiTagMapEntry* entry = bucket(i);
-    while (entry != NULL) {
-      oops_counted++;
-      oop l = entry->object_no_keepalive();
-      if (l != NULL) {
-        // Check if oop has moved, ie its hashcode is different
-        // than the one entered in the table.
-        unsigned int new_hash = compute_hash(l);
-        if (entry->hash() != new_hash) {
-          *p = entry->next();
-          entry->set_hash(new_hash);
-          unlink_entry(entry);
-          moved_entries.push(entry);
-        } else {
-          p = entry->next_addr();
-        }
-      } else {
-        // Skip removed oops. They may still have to be posted.
-        p = entry->next_addr();
-      }
-      // get next entry
-      entry = *p;
+class JvmtiTagMapTableIsDead : StackObj {
+ public:
+  bool operator()(JvmtiTagMapEntry* value) {
+    return value->object_no_keepalive() == NULL;
+  }
+};
+
+class JvmtiTagMapTableDeleteDead : StackObj {
+  GrowableArray<jlong>* _objects;
+  int _removed;
+ public:
+  JvmtiTagMapTableDeleteDead(GrowableArray<jlong>* objects) : _objects(objects), _removed(0) {}
+  void operator()(JvmtiTagMapEntry* value) {
+    _removed++;
+    // collect object tags for posting JVMTI events later
+    if (_objects != NULL) {
+      _objects->append(value->tag());
     }
   }
+  int removed() const { return _removed; }
+};
 
-  int rehash_len = moved_entries.length();
-  // Now add back in the entries that were removed.
-  for (int i = 0; i < rehash_len; i++) {
-    JvmtiTagMapEntry* moved_entry = moved_entries.at(i);
-    int index = hash_to_index(moved_entry->hash());
-    Hashtable<WeakHandle, mtServiceability>::add_entry(index, moved_entry);
+// Remove entries for dead oops from the table and store dead oops'
+// tag in objects array if provided.
+void JvmtiTagMapTable::remove_dead_entries(GrowableArray<jlong>* objects) {
+  size_t oops_counted = Atomic::load(&_items_count);
+  JvmtiTagMapTableIsDead is_dead;
+  JvmtiTagMapTableDeleteDead del(objects);
+  Thread* thread = Thread::current();
+  if (SafepointSynchronize::is_at_safepoint()) {
+    // Resizing is done by the writers, which hold the tag map lock
+    // and can't be stopped in the middle of it at a safepoint.
+    bool deleted = _table->try_bulk_delete(thread, is_dead, del);
+    assert(deleted, "the table must not be resized at a safepoint");
+  } else {
+    _table->bulk_delete(thread, is_dead, del);
   }
 
-  log_info(jvmti, table) ("JvmtiTagMap entries counted %d rehashed %d",
-                          oops_counted, rehash_len);
+  log_info(jvmti, table) ("JvmtiTagMap entries counted " SIZE_FORMAT " removed %d",
+                          oops_counted, del.removed());
 }
@@ -26,70 +26,72 @@
 #define SHARE_VM_PRIMS_TAGMAPTABLE_HPP
 
 #include "oops/weakHandle.hpp"
-#include "utilities/hashtable.hpp"
+#include "runtime/atomic.hpp"
+#include "utilities/concurrentHashTable.hpp"
+#include "utilities/growableArray.hpp"
 
 class JvmtiEnv;
-
-// Hashtable to record oops used for JvmtiTagMap
 class JvmtiTagMapEntryClosure;
-
-class JvmtiTagMapEntry : public HashtableEntry<WeakHandle, mtServiceability> {
-  jlong _tag;                           // the tag
+class JvmtiTagMapTableConfig;
+
+// Entry of the JvmtiTagMapTable. The object is held by a weak handle and
+// the entry is keyed by the identity hash of the object, which doesn't
+// change when a collector moves the object, so the table never needs
+// to be rehashed.
+class JvmtiTagMapEntry {
+  WeakHandle     _wh;                   // the tagged object
+  uintx          _hash;                 // identity hash of the object
+  volatile jlong _tag;                  // the tag
  public:
-  JvmtiTagMapEntry* next() const {
-    return (JvmtiTagMapEntry*)HashtableEntry<WeakHandle, mtServiceability>::next();
-  }
+  JvmtiTagMapEntry(WeakHandle wh, uintx hash, jlong tag) : _wh(wh), _hash(hash), _tag(tag) {}
 
-  JvmtiTagMapEntry** next_addr() {
-    return (JvmtiTagMapEntry**)HashtableEntry<WeakHandle, mtServiceability>::next_addr();
-  }
+  WeakHandle weak_handle() const { return _wh; }
+  uintx hash() const             { return _hash; }
 
   oop object();
   oop object_no_keepalive();
-  jlong tag() const       { return _tag; }
-  void set_tag(jlong tag) { _tag = tag; }
+  jlong tag() const              { return Atomic::load(&_tag); }
+  void set_tag(jlong tag)        { Atomic::store(&_tag, tag); }
 };
 
-class JvmtiTagMapTable : public Hashtable<WeakHandle, mtServiceability> {
-  enum Constants {
-    _table_size  = 1007
-  };
-
-private:
-  JvmtiTagMapEntry* bucket(int i) {
-    return (JvmtiTagMapEntry*) Hashtable<WeakHandle, mtServiceability>::bucket(i);
-  }
+typedef ConcurrentHashTable<JvmtiTagMapTableConfig, mtServiceability> JvmtiTagMapTableHash;
 
-  JvmtiTagMapEntry** bucket_addr(int i) {
-    return (JvmtiTagMapEntry**) Hashtable<WeakHandle, mtServiceability>::bucket_addr(i);
-  }
+// Hashtable to record oops used for JvmtiTagMap.
+//
+// Lookups of a tag (find_tag) are lock-free and may run concurrently with
+// everything else. All other operations modify the table or hand out entries,
+// so they must be called with the tag map lock held or by the VM thread at a
+// safepoint.
+class JvmtiTagMapTable : public CHeapObj<mtServiceability> {
+  friend class JvmtiTagMapTableConfig;
 
-  JvmtiTagMapEntry* new_entry(unsigned int hash, WeakHandle w, jlong tag);
-  void free_entry(JvmtiTagMapEntry* entry);
+  JvmtiTagMapTableHash* _table;
+  volatile size_t       _items_count;
 
-  unsigned int compute_hash(oop obj);
+  void item_added()   { Atomic::inc(&_items_count); }
+  void item_removed() { Atomic::dec(&_items_count); }
 
-  JvmtiTagMapEntry* find(int index, unsigned int hash, oop obj);
-
-  void resize_if_needed();
+  void grow_if_needed(bool grow_hint);
 
 public:
   JvmtiTagMapTable();
   ~JvmtiTagMapTable();
 
+  // Return the tag of obj, or 0 if obj is not tagged. Doesn't need the lock.
+  jlong find_tag(oop obj);
+
   JvmtiTagMapEntry* find(oop obj);
-  JvmtiTagMapEntry* add(oop obj, jlong tag);
+  void add(oop obj, jlong tag);
 
   void remove(oop obj);
 
   // iterate over all entries in the hashmap
   void entry_iterate(JvmtiTagMapEntryClosure* closure);
 
-  bool is_empty() const { return number_of_entries() == 0; }
+  bool is_empty() const { return Atomic::load(&_items_count) == 0; }
 
   // Cleanup cleared entries and store dead object tags in objects array
   void remove_dead_entries(GrowableArray<jlong>* objects);
-  void rehash();
   void clear();
 };
 
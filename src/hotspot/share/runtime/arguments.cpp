@@ -1551,6 +1551,20 @@ void Arguments::set_use_compressed_oops() {
   // to use UseCompressedOops are InitialHeapSize and MinHeapSize.
   size_t max_heap_size = MAX3(MaxHeapSize, InitialHeapSize, MinHeapSize);
 
+  // Doubling the object alignment doubles the heap that compressed oops can
+  // address, for heaps a little beyond 32G the padding costs less than
+  // uncompressed oops do. ZGC does not use compressed oops.
+  if (max_heap_size > max_heap_for_compressed_oops() &&
+      max_heap_size <= 2 * max_heap_for_compressed_oops() &&
+      UseLargerObjectAlignmentForCompressedOops &&
+      FLAG_IS_DEFAULT(ObjectAlignmentInBytes) && ObjectAlignmentInBytes == 8 &&
+      (UseCompressedOops || FLAG_IS_DEFAULT(UseCompressedOops)) && !UseZGC) {
+    FLAG_SET_ERGO(ObjectAlignmentInBytes, 16);
+    set_object_alignment();
+    log_info(gc, heap, coops)("Object alignment raised to " INTX_FORMAT " bytes for compressed oops",
+                              ObjectAlignmentInBytes);
+  }
+
   if (max_heap_size <= max_heap_for_compressed_oops()) {
     if (FLAG_IS_DEFAULT(UseCompressedOops)) {
       FLAG_SET_ERGO(UseCompressedOops, true);
@@ -4141,6 +4155,21 @@ jint Arguments::apply_ergo() {
     UseBiasedLocking = false;
   }
 
+#if INCLUDE_JVMCI
+  if (UseLightweightLocking && EnableJVMCI) {
+    // JVMCI compilers emit their own stack locking code
+    warning("UseLightweightLocking is not supported with JVMCI; ignoring UseLightweightLocking flag.");
+    FLAG_SET_DEFAULT(UseLightweightLocking, false);
+  }
+#endif
+  if (UseLightweightLocking) {
+    if (!FLAG_IS_DEFAULT(UseBiasedLocking) && UseBiasedLocking) {
+      warning("Biased Locking is not supported with UseLightweightLocking"
+              "; ignoring UseBiasedLocking flag." );
+    }
+    UseBiasedLocking = false;
+  }
+
 #ifdef ZERO
   // Clear flags not supported on zero.
   FLAG_SET_DEFAULT(ProfileInterpreter, false);
@@ -23,29 +23,92 @@
 
 #include "precompiled.hpp"
 #include "classfile/classLoader.hpp"
+#include "classfile/classLoaderDataGraph.hpp"
+#include "classfile/metadataOnStackMark.hpp"
+#include "code/codeCache.hpp"
+#include "code/nmethod.hpp"
+#include "compiler/compileBroker.hpp"
+#include "crengine.h"
+#include "gc/shared/collectedHeap.hpp"
+#include "gc/shared/gcArguments.hpp"
+#include "gc/shared/workerPolicy.hpp"
+#include "interpreter/linkResolver.hpp"
+#include "jfr/jfrEvents.hpp"
 #include "jvm.h"
 #include "logging/logAsyncWriter.hpp"
 #include "logging/logConfiguration.hpp"
+#include "memory/arena.hpp"
+#include "memory/heapInspection.hpp"
+#include "memory/iterator.hpp"
+#include "memory/metadataFactory.hpp"
+#include "memory/metaspace.hpp"
+#include "memory/metaspaceUtils.hpp"
 #include "memory/oopFactory.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/universe.hpp"
+#include "oops/constantPool.inline.hpp"
+#include "oops/cpCache.inline.hpp"
+#include "oops/method.inline.hpp"
+#include "oops/methodData.hpp"
+#include "oops/oop.inline.hpp"
 #include "oops/typeArrayOop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/crac_structs.hpp"
 #include "runtime/crac.hpp"
+#include "runtime/globals_extension.hpp"
+#include "runtime/handles.inline.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
 #include "runtime/jniHandles.hpp"
 #include "runtime/jniHandles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/nonJavaThread.hpp"
+#include "runtime/perfData.hpp"
+#include "runtime/safefetch.hpp"
+#include "runtime/sweeper.hpp"
 #include "runtime/vm_version.hpp"
 #include "runtime/vmThread.hpp"
+#include "services/attachListener.hpp"
 #include "services/heapDumper.hpp"
 #include "services/writeableFlags.hpp"
 #include "utilities/decoder.hpp"
+#include "utilities/growableArray.hpp"
+#include "utilities/macros.hpp"
 #include "os.inline.hpp"
+#if INCLUDE_JFR
+#include "jfr/jfr.hpp"
+#endif
+#ifdef LINUX
+#include "memoryPressure_linux.hpp"
+#include "osContainer_linux.hpp"
+#endif
 
 static const char* _crengine = NULL;
 static char* _crengine_arg_str = NULL;
 static unsigned int _crengine_argc = 0;
 static const char* _crengine_args[32];
+// Set when CREngine is a shared library running in the VM process
+static const crengine_api_t* _crengine_lib = NULL;
 static jlong _restore_start_time;
 static jlong _restore_start_nanos;
+// Durations of the last checkpoint, until the engine is called, and of the
+// last restore, from the start of the restoring VM until Java code resumes.
+// They are kept in the image, so a restored VM knows them from its origin.
+static jlong _checkpoint_start_nanos;
+static jlong _last_checkpoint_nanos = -1;
+static jlong _last_restore_nanos = -1;
+
+static const int max_time_jump_funcs = 8;
+static crac::time_jump_func_t _time_jump_funcs[max_time_jump_funcs];
+static int _num_time_jump_funcs = 0;
+
+struct CheckpointHook {
+  JVM_CheckpointHook _before_checkpoint;
+  JVM_CheckpointHook _after_restore;
+  void* _data;
+};
+static const int max_checkpoint_hooks = 16;
+static CheckpointHook _checkpoint_hooks[max_checkpoint_hooks];
+static int _num_checkpoint_hooks = 0;
 
 // Timestamps recorded before checkpoint
 jlong crac::checkpoint_millis;
@@ -55,6 +118,89 @@ char crac::checkpoint_bootid[UUID_LENGTH];
 // System.nanoTime() close to actual wall-clock time difference.
 jlong crac::javaTimeNanos_offset = 0;
 
+// Phases of checkpoint and of the following restore. Each one is accounted
+// in a sun.rt.crac.<name>Time PerfData counter and reported as a CracPhase
+// JFR event.
+#define CRAC_PHASES_DO(f)                 \
+  f(resolveCallSites)                     \
+  f(compileQueueDrain)                    \
+  f(gc)                                   \
+  f(trimNativeHeap)                       \
+  f(codeSweep)                            \
+  f(preDump)                              \
+  f(checkFds)                             \
+  f(metadataCleanup)                      \
+  f(heapDump)                             \
+  f(recordWarmup)                         \
+  f(memoryCheckpoint)                     \
+  f(coordinatorPrepare)                   \
+  f(engine)                               \
+  f(cpuFeatures)                          \
+  f(readShm)                              \
+  f(memoryRestore)                        \
+  f(coordinatorRelease)                   \
+  f(wakeupThreads)                        \
+  f(warmup)
+
+class CracPhase : public StackObj {
+public:
+#define CRAC_PHASE_ENUM(name) name,
+  enum Id {
+    CRAC_PHASES_DO(CRAC_PHASE_ENUM)
+    num_phases
+  };
+#undef CRAC_PHASE_ENUM
+
+private:
+  static const char* const _names[num_phases];
+  static PerfCounter* _counters[num_phases];
+  // Time spent by the engine to bring the image back, from the moment
+  // crac::restore() is called in the restoring VM
+  static PerfCounter* _restore_engine_counter;
+
+  const Id _id;
+  const jlong _start;
+  EventCracPhase _event;
+
+public:
+  CracPhase(Id id) : _id(id), _start(os::elapsed_counter()) {}
+
+  ~CracPhase() {
+    if (_counters[_id] != NULL) {
+      _counters[_id]->inc(os::elapsed_counter() - _start);
+    }
+    if (_event.should_commit()) {
+      _event.set_phase(_names[_id]);
+      _event.commit();
+    }
+  }
+
+  static void initialize(TRAPS) {
+    if (!UsePerfData || _counters[0] != NULL) {
+      return;
+    }
+    for (int i = 0; i < num_phases; i++) {
+      char name[64];
+      jio_snprintf(name, sizeof(name), "crac.%sTime", _names[i]);
+      _counters[i] = PerfDataManager::create_counter(SUN_RT, name, PerfData::U_Ticks, CHECK);
+    }
+    _restore_engine_counter = PerfDataManager::create_counter(SUN_RT, "crac.restoreEngineTime",
+                                                              PerfData::U_Ticks, CHECK);
+  }
+
+  static void record_restore_engine(jlong nanos) {
+    if (_restore_engine_counter != NULL && nanos > 0) {
+      _restore_engine_counter->inc((jlong)(nanos * ((double)os::elapsed_frequency() / NANOSECS_PER_SEC)));
+    }
+  }
+};
+
+#define CRAC_PHASE_NAME(name) #name,
+const char* const CracPhase::_names[] = { CRAC_PHASES_DO(CRAC_PHASE_NAME) };
+#undef CRAC_PHASE_NAME
+PerfCounter* CracPhase::_counters[] = { NULL };
+PerfCounter* CracPhase::_restore_engine_counter = NULL;
+
 jlong crac::restore_start_time() {
   if (!_restore_start_time) {
     return -1;
@@ -121,12 +267,127 @@ static size_t cr_util_path(char* path, int len) {
   return after_elem - path;
 }
 
+// The manifest lets a restore reject an unusable image before the engine reads
+// it. The VM writes the line identifying its build and a "libjvm <size>
+// <mtime> <path>" line that lets the launcher check the build without loading
+// the VM. The engine may append "file <name> <size>" lines for the image files
+// it has written and a "parent <dir>" line for an image that is a delta
+// against another one.
+#define CRAC_MANIFEST "crac.manifest"
+
+static void write_manifest() {
+  char path[JVM_MAXPATHLEN];
+  jio_snprintf(path, sizeof(path), "%s%s" CRAC_MANIFEST, CRaCCheckpointTo, os::file_separator());
+  FILE* f = os::fopen(path, "w");
+  if (f == NULL) {
+    warning("cannot write %s: %s", path, os::strerror(errno));
+    return;
+  }
+  fprintf(f, "vm %s\n", VM_Version::internal_vm_info_string());
+  char jvm_path[JVM_MAXPATHLEN];
+  os::jvm_path(jvm_path, sizeof(jvm_path));
+  struct stat st;
+  if (os::stat(jvm_path, &st) == 0) {
+    fprintf(f, "libjvm " JLONG_FORMAT " " JLONG_FORMAT " %s\n", (jlong)st.st_size, (jlong)st.st_mtime, jvm_path);
+  }
+  fclose(f);
+}
+
+// Images without a manifest are accepted as valid. The parent of a delta image
+// is returned in parent, which is empty otherwise.
+static bool check_image_manifest(const char* imagedir, char* parent, size_t parent_len) {
+  parent[0] = '\0';
+  char path[JVM_MAXPATHLEN];
+  jio_snprintf(path, sizeof(path), "%s%s" CRAC_MANIFEST, imagedir, os::file_separator());
+  FILE* f = os::fopen(path, "r");
+  if (f == NULL) {
+    return true;
+  }
+
+  bool ok = true;
+  char line[JVM_MAXPATHLEN + 64];
+  while (ok && fgets(line, sizeof(line), f) != NULL) {
+    line[strcspn(line, "\n")] = '\0';
+    if (!strncmp(line, "vm ", 3)) {
+      if (strcmp(line + 3, VM_Version::internal_vm_info_string())) {
+        warning("%s was created by a different VM: %s", imagedir, line + 3);
+        ok = false;
+      }
+    } else if (!strncmp(line, "file ", 5)) {
+      char* sep = strrchr(line + 5, ' ');
+      if (sep == NULL) {
+        warning("%s: malformed line: %s", path, line);
+        ok = false;
+        break;
+      }
+      *sep = '\0';
+      julong size = (julong)strtoull(sep + 1, NULL, 10);
+      char file[JVM_MAXPATHLEN];
+      jio_snprintf(file, sizeof(file), "%s%s%s", imagedir, os::file_separator(), line + 5);
+      struct stat st;
+      if (os::stat(file, &st) != 0) {
+        warning("%s: missing image file %s", imagedir, line + 5);
+        ok = false;
+      } else if ((julong)st.st_size != size) {
+        warning("%s: image file %s has size " JULONG_FORMAT ", expected " JULONG_FORMAT,
+                imagedir, line + 5, (julong)st.st_size, size);
+        ok = false;
+      }
+    } else if (!strncmp(line, "parent ", 7)) {
+      jio_snprintf(parent, parent_len, "%s", line + 7);
+    }
+  }
+  fclose(f);
+  return ok;
+}
+
+static bool check_manifest(const char* imagedir) {
+  const int max_chain = 64;
+  char dir[JVM_MAXPATHLEN];
+  char parent[JVM_MAXPATHLEN];
+  jio_snprintf(dir, sizeof(dir), "%s", imagedir);
+  for (int i = 0; i < max_chain; ++i) {
+    if (!check_image_manifest(dir, parent, sizeof(parent))) {
+      return false;
+    }
+    if (parent[0] == '\0') {
+      return true;
+    }
+    strcpy(dir, parent);
+  }
+  warning("%s: chain of parent images is too long", imagedir);
+  return false;
+}
+
+static bool load_crengine_lib() {
+  char ebuf[1024];
+  void* handle = os::dll_load(_crengine, ebuf, sizeof(ebuf));
+  if (handle == NULL) {
+    warning("cannot load %s: %s", _crengine, ebuf);
+    return false;
+  }
+  crengine_get_api_t get_api = CAST_TO_FN_PTR(crengine_get_api_t, os::dll_lookup(handle, CRENGINE_GET_API));
+  const crengine_api_t* api = get_api != NULL ? get_api() : NULL;
+  if (api == NULL || api->version != CRENGINE_API_VERSION) {
+    warning("%s does not provide " CRENGINE_GET_API " version %d", _crengine, CRENGINE_API_VERSION);
+    return false;
+  }
+  // options start after the slot for the action of an executable engine
+  if (api->init(_crengine_args + 2) != 0) {
+    warning("cannot initialize %s", _crengine);
+    return false;
+  }
+  _crengine_lib = api;
+  return true;
+}
+
 static bool compute_crengine() {
   // release possible old copies
   os::free((char *) _crengine); // NULL is allowed
   _crengine = NULL;
   os::free((char *) _crengine_arg_str);
   _crengine_arg_str = NULL;
+  _crengine_lib = NULL;
 
   if (!CREngine) {
     return true;
@@ -156,6 +417,7 @@ static bool compute_crengine() {
   }
   _crengine_args[0] = _crengine;
   _crengine_argc = 2;
+  _crengine_args[_crengine_argc] = NULL;
 
   if (_crengine_arg_str != NULL) {
     char *arg = _crengine_arg_str;
@@ -185,6 +447,13 @@ static bool compute_crengine() {
     _crengine_args[_crengine_argc++] = arg;
     _crengine_args[_crengine_argc] = NULL;
   }
+
+  const char* ext = os::dll_file_extension();
+  const size_t len = strlen(_crengine);
+  const size_t ext_len = strlen(ext);
+  if (len > ext_len && !strcmp(_crengine + len - ext_len, ext)) {
+    return load_crengine_lib();
+  }
   return true;
 }
 
@@ -206,16 +475,24 @@ static int call_crengine() {
   return os::exec_child_process_and_wait(_crengine, _crengine_args);
 }
 
-static int checkpoint_restore(int *shmid) {
-  crac::record_time_before_checkpoint();
+// Lets the engine copy memory while Java threads keep running, so that the
+// checkpoint at the safepoint only has to write pages changed since then.
+// The engine reports completion with RESTORE_SIGNAL.
+static bool call_crengine_predump(JavaThread* current) {
+#ifdef LINUX
+  if (!_crengine || _crengine_lib != NULL) {
+    return false;
+  }
+  _crengine_args[1] = "predump";
+  add_crengine_arg(CRaCCheckpointTo);
 
-  int cres = call_crengine();
+  ThreadToNativeFromVM ttn(current);
+  int cres = os::exec_child_process_and_wait(_crengine, _crengine_args);
+  _crengine_args[--_crengine_argc] = NULL;
   if (cres < 0) {
-    tty->print_cr("CRaC error executing: %s\n", _crengine);
-    return JVM_CHECKPOINT_ERROR;
+    return false;
   }
 
-#ifdef LINUX
   sigset_t waitmask;
   sigemptyset(&waitmask);
   sigaddset(&waitmask, RESTORE_SIGNAL);
@@ -226,19 +503,156 @@ static int checkpoint_restore(int *shmid) {
     sig = sigwaitinfo(&waitmask, &info);
   } while (sig == -1 && errno == EINTR);
   assert(sig == RESTORE_SIGNAL, "got what requested");
+  return info.si_code == SI_QUEUE && info.si_int == 0;
+#else
+  return false;
+#endif //LINUX
+}
+
+class LinkedClassesClosure : public KlassClosure {
+  GrowableArray<InstanceKlass*>* _classes;
+public:
+  LinkedClassesClosure(GrowableArray<InstanceKlass*>* classes) : _classes(classes) {}
 
+  void do_klass(Klass* k) {
+    if (k->is_instance_klass() && InstanceKlass::cast(k)->is_linked()) {
+      _classes->append(InstanceKlass::cast(k));
+    }
+  }
+};
+
+// A LinkageError is remembered by the constant pool and thrown again when
+// the bytecode is executed, so the exception is only logged and cleared here.
+static void count_resolution(InstanceKlass* ik, int index, int* resolved, int* failed, JavaThread* current) {
+  if (!current->has_pending_exception()) {
+    (*resolved)++;
+    return;
+  }
+  (*failed)++;
+  if (log_is_enabled(Debug, crac)) {
+    ResourceMark rm(current);
+    log_debug(crac)("Cannot resolve %s constant pool entry %d: %s", ik->external_name(), index,
+                    current->pending_exception()->klass()->external_name());
+  }
+  current->clear_pending_exception();
+}
+
+static void resolve_class_call_sites(InstanceKlass* ik, int* resolved, int* failed, TRAPS) {
+  constantPoolHandle pool(THREAD, ik->constants());
+  ConstantPoolCache* cache = pool->cache();
+  if (cache == NULL) {
+    return;
+  }
+
+  for (int i = 1; i < pool->length(); i++) {
+    constantTag tag = pool->tag_at(i);
+    if (tag.is_method_handle() || tag.is_method_type() || tag.is_dynamic_constant()) {
+      if (pool->resolved_references()->obj_at(pool->cp_to_object_index(i)) == NULL) {
+        pool->resolve_possibly_cached_constant_at(i, THREAD);
+        count_resolution(ik, i, resolved, failed, THREAD);
+      }
+    } else if (tag.is_double() || tag.is_long()) {
+      i++;
+    }
+  }
+
+  for (int i = 0; i < cache->length(); i++) {
+    ConstantPoolCacheEntry* cpce = cache->entry_at(i);
+    if (!pool->tag_at(cpce->constant_pool_index()).is_invoke_dynamic() ||
+        cpce->is_resolved(Bytecodes::_invokedynamic) || cpce->indy_resolution_failed()) {
+      continue;
+    }
+    int indy_index = ConstantPool::encode_invokedynamic_index(i);
+    CallInfo info;
+    LinkResolver::resolve_invoke(info, Handle(), pool, indy_index, Bytecodes::_invokedynamic, THREAD);
+    if (!HAS_PENDING_EXCEPTION) {
+      cpce->set_dynamic_call(pool, info);
+    }
+    count_resolution(ik, cpce->constant_pool_index(), resolved, failed, THREAD);
+  }
+}
+
+// Runs the bootstrap methods of call sites and constants not executed yet,
+// so that the first execution after restore takes the linked fast path in the
+// interpreter and in compiled code instead of upcalling into Java.
+static void resolve_call_sites(JavaThread* current) {
+  ResourceMark rm(current);
+  HandleMark hm(current);
+  GrowableArray<InstanceKlass*> classes;
+  GrowableArray<Handle> mirrors;
+  {
+    MutexLocker ml(current, ClassLoaderDataGraph_lock);
+    LinkedClassesClosure closure(&classes);
+    ClassLoaderDataGraph::loaded_classes_do(&closure);
+    // Keep the classes alive while bootstrap methods run
+    for (int i = 0; i < classes.length(); i++) {
+      mirrors.append(Handle(current, classes.at(i)->java_mirror()));
+    }
+  }
+
+  int resolved = 0;
+  int failed = 0;
+  for (int i = 0; i < classes.length(); i++) {
+    resolve_class_call_sites(classes.at(i), &resolved, &failed, current);
+  }
+  log_info(crac)("Resolved %d call sites and constants of %d classes before checkpoint, %d failed",
+                 resolved, classes.length(), failed);
+}
+
+// The process continues after the engine has checkpointed it, either restored
+// or left running.
+static void after_checkpoint() {
+#ifdef LINUX
   if (CRaCCPUCountInit) {
     os::Linux::initialize_cpu_count();
   }
-#else
-  // TODO add sync processing
 #endif //LINUX
 
   crac::update_javaTimeNanos_offset();
+  crac::notify_time_jump();
 
   if (CRTraceStartupTime) {
     tty->print_cr("STARTUPTIME " JLONG_FORMAT " restore-native", os::javaTimeNanos());
   }
+}
+
+static int checkpoint_restore(int *shmid) {
+  crac::record_time_before_checkpoint();
+  write_manifest();
+
+  if (_crengine_lib != NULL) {
+    int ret = _crengine_lib->checkpoint(CRaCCheckpointTo);
+    if (ret < 0) {
+      tty->print_cr("CRaC error in engine: %s\n", _crengine);
+      return JVM_CHECKPOINT_ERROR;
+    }
+    after_checkpoint();
+    *shmid = ret;
+    return JVM_CHECKPOINT_OK;
+  }
+
+  int cres = call_crengine();
+  if (cres < 0) {
+    tty->print_cr("CRaC error executing: %s\n", _crengine);
+    return JVM_CHECKPOINT_ERROR;
+  }
+
+#ifdef LINUX
+  sigset_t waitmask;
+  sigemptyset(&waitmask);
+  sigaddset(&waitmask, RESTORE_SIGNAL);
+
+  siginfo_t info;
+  int sig;
+  do {
+    sig = sigwaitinfo(&waitmask, &info);
+  } while (sig == -1 && errno == EINTR);
+  assert(sig == RESTORE_SIGNAL, "got what requested");
+#else
+  // TODO add sync processing
+#endif //LINUX
+
+  after_checkpoint();
 
 #ifdef LINUX
   if (info.si_code != SI_QUEUE || info.si_int < 0) {
@@ -271,15 +685,26 @@ bool VM_Crac::read_shm(int shmid) {
   return ret;
 }
 
+static int compare_fds(const jint& fd1, const jint& fd2) {
+  return fd1 < fd2 ? -1 : (fd1 > fd2 ? 1 : 0);
+}
+
+static int compare_fd_ptrs(jint* fd1, jint* fd2) {
+  return compare_fds(*fd1, *fd2);
+}
+
 bool VM_Crac::is_claimed_fd(int fd) {
-  typeArrayOop claimed_fds = typeArrayOop(JNIHandles::resolve_non_null(_fd_arr));
-  for (int j = 0; j < claimed_fds->length(); ++j) {
-    jint cfd = claimed_fds->int_at(j);
-    if (fd == cfd) {
-      return true;
+  if (_claimed_fds == NULL) {
+    typeArrayOop claimed_fds = typeArrayOop(JNIHandles::resolve_non_null(_fd_arr));
+    _claimed_fds = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<jint>(claimed_fds->length(), mtInternal);
+    for (int j = 0; j < claimed_fds->length(); ++j) {
+      _claimed_fds->append(claimed_fds->int_at(j));
     }
+    _claimed_fds->sort(compare_fd_ptrs);
   }
-  return false;
+  bool found;
+  _claimed_fds->find_sorted<jint, compare_fds>(fd, found);
+  return found;
 }
 
 class WakeupClosure: public ThreadClosure {
@@ -304,17 +729,357 @@ static void wakeup_threads_in_timedwait() {
   WatcherThread::watcher_thread()->unpark();
 }
 
+// The heap reservation is part of the image, so the restoring VM cannot grow
+// past MaxHeapSize. Within that, pick the size ergonomics would have chosen for
+// the memory of the restoring host (e.g. a smaller container) and publish it as
+// SoftMaxHeapSize, which ZGC and Shenandoah follow.
+static void resize_heap_on_restore() {
+  if (!CRaCResizeHeapOnRestore) {
+    return;
+  }
+#ifdef LINUX
+  os::Linux::initialize_physical_memory();
+#endif
+  julong phys_mem = os::physical_memory();
+  size_t soft_max = GCArguments::soft_max_heap_size_for(phys_mem);
+
+  if (FLAG_IS_CMDLINE(SoftMaxHeapSize)) {
+    log_info(crac)("SoftMaxHeapSize set on command line, not resizing heap to " SIZE_FORMAT "M",
+                   soft_max / M);
+    return;
+  }
+  if (soft_max == SoftMaxHeapSize) {
+    return;
+  }
+  log_info(crac)("Resizing heap for " JULONG_FORMAT "M of memory: SoftMaxHeapSize " SIZE_FORMAT "M -> " SIZE_FORMAT "M",
+                 phys_mem / M, SoftMaxHeapSize / M, soft_max / M);
+  FLAG_SET_ERGO(SoftMaxHeapSize, soft_max);
+  if (!UseZGC && !UseShenandoahGC && soft_max < Universe::heap()->capacity()) {
+    log_warning(crac)("%s does not follow SoftMaxHeapSize; committed heap " SIZE_FORMAT "M exceeds " SIZE_FORMAT "M",
+                      Universe::heap()->name(), Universe::heap()->capacity() / M, soft_max / M);
+  }
+}
+
+// GC worker gangs and their per-worker data are sized at startup and cannot
+// grow, but the number of active workers can follow the restoring host.
+static void resize_gc_workers_on_restore() {
+  if (!CRaCResizeGCWorkersOnRestore) {
+    return;
+  }
+  uint ncpus = (uint)os::active_processor_count();
+  WorkerPolicy::set_active_workers_limit(ncpus);
+  log_info(crac)("Limiting active GC workers to %u processors", ncpus);
+  if (ncpus > ParallelGCThreads || ncpus > ConcGCThreads) {
+    log_info(crac)("Only %u parallel and %u concurrent GC workers are available on %u processors",
+                   ParallelGCThreads, ConcGCThreads, ncpus);
+  }
+}
+
+static void remap_code_cache_on_restore() {
+  if (!CRaCCodeCacheLargePagesOnRestore) {
+    return;
+  }
+  CodeCache::realign_to_large_pages();
+}
+
+static int _discarded_mdo_count = 0;
+static size_t _discarded_mdo_bytes = 0;
+
+static void discard_method_data(Method* m) {
+  MethodData* mdo = m->method_data();
+  if (mdo == NULL || m->on_stack() || m->code() != NULL) {
+    return;
+  }
+  _discarded_mdo_count++;
+  _discarded_mdo_bytes += mdo->size() * wordSize;
+  m->set_method_data(NULL);
+  MetadataFactory::free_metadata(m->method_holder()->class_loader_data(), mdo);
+}
+
+// Frees the MethodData of methods that are neither running nor referenced
+// from compiled code, inlined or not. These are the methods that went cold,
+// or never got hot enough to be compiled. Returns false if nothing was done.
+static bool discard_cold_method_data() {
+  // The compilers read profiles outside of safepoints
+  if (!CRaCDiscardColdMethodData || CompileBroker::is_compilation_in_progress()) {
+    return false;
+  }
+  _discarded_mdo_count = 0;
+  _discarded_mdo_bytes = 0;
+  MetadataOnStackMark md_on_stack(/*walk_all_metadata*/true, /*redefinition_walk*/true);
+  ClassLoaderDataGraph::methods_do(discard_method_data);
+  return true;
+}
+
+// The dump is written by the safepoint workers and piped through the
+// compression backend, so a named pipe can stream it to another process.
+static void heap_dump_on_checkpoint_error() {
+  CollectedHeap* heap = Universe::heap();
+  const size_t used = heap->used();
+  if (CRHeapDumpMaxSize != 0 && used > CRHeapDumpMaxSize) {
+    tty->print_cr("Heap usage " SIZE_FORMAT "M exceeds CRHeapDumpMaxSize=" SIZE_FORMAT "M, "
+                  "printing a class histogram instead of a heap dump",
+                  used / M, CRHeapDumpMaxSize / M);
+    heap->ensure_parsability(false);
+    HeapInspection inspect;
+    inspect.heap_inspection(tty, heap->safepoint_workers());
+    return;
+  }
+
+  if (CRHeapDumpPath == NULL || CRHeapDumpPath[0] == '\0') {
+    HeapDumper::dump_heap();
+    return;
+  }
+
+  // Errors are reported on tty by the dumper.
+  HeapDumper dumper(false /* no GC before heap dump */);
+  dumper.dump(CRHeapDumpPath, tty, CRHeapDumpGzipLevel, true /* overwrite */);
+}
+
+// Warmup after restore. At checkpoint the hottest nmethods and the pages of
+// the first live heap objects are recorded. After restore a background
+// thread reads them, so that the page faults of a lazily restored image and
+// the misses of the cold caches and TLBs are taken before the application
+// serves requests. Reading the code only brings it into the data side and
+// the shared cache levels; the instruction caches warm up as it runs.
+class CracWarmup : AllStatic {
+  friend class CracWarmupThread;
+
+  struct HotCode {
+    nmethod* _nm;
+    jlong _count;
+  };
+
+  static GrowableArrayCHeap<HotCode, mtInternal>* _code;
+  static GrowableArrayCHeap<address, mtInternal>* _pages;
+  static NamedThread* _thread;
+  // Guarded by CracWarmup_lock
+  static bool _requested;
+  static bool _running;
+  static volatile bool _abort;
+  // 1 from restore until the warmup is done, for readiness probes
+  static PerfVariable* _in_progress;
+
+  static int compare_count(HotCode* a, HotCode* b) {
+    return a->_count < b->_count ? 1 : (a->_count > b->_count ? -1 : 0);
+  }
+
+  static void record_code();
+  static void record_heap();
+  static void discard();
+  static void set_in_progress(bool value) {
+    if (_in_progress != NULL) {
+      _in_progress->set_value(value ? 1 : 0);
+    }
+  }
+
+  static void run();
+  static void warm_up();
+
+public:
+  static void initialize(TRAPS) {
+    if (!UsePerfData || _in_progress != NULL) {
+      return;
+    }
+    _in_progress = PerfDataManager::create_variable(SUN_RT, "crac.warmupInProgress",
+                                                    PerfData::U_None, (jlong)0, CHECK);
+  }
+
+  static void record();
+  static void start();
+  static void stop();
+};
+
+GrowableArrayCHeap<CracWarmup::HotCode, mtInternal>* CracWarmup::_code = NULL;
+GrowableArrayCHeap<address, mtInternal>* CracWarmup::_pages = NULL;
+NamedThread* CracWarmup::_thread = NULL;
+bool CracWarmup::_requested = false;
+bool CracWarmup::_running = false;
+volatile bool CracWarmup::_abort = false;
+PerfVariable* CracWarmup::_in_progress = NULL;
+
+class CracWarmupThread : public NamedThread {
+public:
+  CracWarmupThread() {
+    set_name("CRaC Warmup");
+    if (os::create_thread(this, os::os_thread)) {
+      os::start_thread(this);
+    }
+  }
+
+  void run() override {
+    CracWarmup::run();
+  }
+};
+
+class CracWarmupPagesClosure : public ObjectClosure {
+  GrowableArrayCHeap<address, mtInternal>* const _pages;
+  const int _max_pages;
+  const size_t _page_size;
+  address _last;
+
+public:
+  CracWarmupPagesClosure(GrowableArrayCHeap<address, mtInternal>* pages, int max_pages) :
+    _pages(pages), _max_pages(max_pages), _page_size(os::vm_page_size()), _last(NULL) {}
+
+  void do_object(oop obj) {
+    address start = align_down(cast_from_oop<address>(obj), _page_size);
+    address end = cast_from_oop<address>(obj) + obj->size() * HeapWordSize;
+    for (address page = start; page < end && _pages->length() < _max_pages; page += _page_size) {
+      if (page != _last) {
+        _pages->append(page);
+        _last = page;
+      }
+    }
+  }
+};
+
+void CracWarmup::discard() {
+  delete _code;
+  _code = NULL;
+  delete _pages;
+  _pages = NULL;
+}
+
+void CracWarmup::record_code() {
+  _code = new GrowableArrayCHeap<HotCode, mtInternal>();
+  if (CRaCWarmupMethods == 0) {
+    return;
+  }
+  MutexLocker ml(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+  NMethodIterator iter(NMethodIterator::only_alive_and_not_unloading);
+  while (iter.next()) {
+    nmethod* nm = iter.method();
+    Method* m = nm->method();
+    if (m == NULL) {
+      continue;
+    }
+    HotCode hc = { nm, (jlong)m->invocation_count() + m->backedge_count() };
+    _code->append(hc);
+  }
+  _code->sort(compare_count);
+  if (_code->length() > (int)CRaCWarmupMethods) {
+    _code->trunc_to((int)CRaCWarmupMethods);
+  }
+}
+
+void CracWarmup::record_heap() {
+  _pages = new GrowableArrayCHeap<address, mtInternal>();
+  const size_t max_pages = MIN2(CRaCWarmupHeapSize / os::vm_page_size(), (size_t)max_jint);
+  if (max_pages == 0) {
+    return;
+  }
+  Universe::heap()->ensure_parsability(false);
+  CracWarmupPagesClosure cl(_pages, (int)max_pages);
+  Universe::heap()->object_iterate(&cl);
+}
+
+void CracWarmup::record() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be");
+  discard();
+  if (!CRaCWarmupOnRestore) {
+    return;
+  }
+  record_code();
+  record_heap();
+  log_info(crac)("Recorded %d nmethods and %d heap pages for warmup after restore",
+                 _code->length(), _pages->length());
+}
+
+void CracWarmup::start() {
+  if (!CRaCWarmupOnRestore || _code == NULL) {
+    discard();
+    return;
+  }
+  MonitorLocker ml(CracWarmup_lock, Mutex::_no_safepoint_check_flag);
+  if (_thread == NULL) {
+    _thread = new CracWarmupThread();
+  }
+  Atomic::store(&_abort, false);
+  _requested = true;
+  set_in_progress(true);
+  ml.notify_all();
+}
+
+// The recorded data is replaced at the next checkpoint, which must not
+// happen while the thread still reads it.
+void CracWarmup::stop() {
+  if (_thread == NULL) {
+    return;
+  }
+  MonitorLocker ml(CracWarmup_lock, Mutex::_no_safepoint_check_flag);
+  _requested = false;
+  Atomic::store(&_abort, true);
+  while (_running) {
+    ml.wait(0);
+  }
+}
+
+void CracWarmup::run() {
+  while (true) {
+    {
+      MonitorLocker ml(CracWarmup_lock, Mutex::_no_safepoint_check_flag);
+      while (!_requested) {
+        ml.wait(0);
+      }
+      _requested = false;
+      _running = true;
+    }
+
+    {
+      CracPhase phase(CracPhase::warmup);
+      warm_up();
+    }
+
+    MonitorLocker ml(CracWarmup_lock, Mutex::_no_safepoint_check_flag);
+    _running = false;
+    set_in_progress(false);
+    ml.notify_all();
+  }
+}
+
+void CracWarmup::warm_up() {
+  const jlong start = os::javaTimeNanos();
+  int code_done = 0;
+  for (int i = 0; i < _code->length() && !Atomic::load(&_abort); i++) {
+    nmethod* nm = _code->at(i)._nm;
+    // The lock keeps the sweeper from freeing the nmethod while it is read
+    MutexLocker ml(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+    if (CodeCache::find_blob_unsafe(nm) != nm || !nm->is_alive()) {
+      continue;
+    }
+    for (address p = align_down(nm->code_begin(), DEFAULT_CACHE_LINE_SIZE); p < nm->code_end(); p += DEFAULT_CACHE_LINE_SIZE) {
+      (void)*(volatile char*)p;
+    }
+    code_done++;
+  }
+
+  // The heap may have been uncommitted in places since the checkpoint
+  int pages_done = 0;
+  for (int i = 0; i < _pages->length() && !Atomic::load(&_abort); i++) {
+    SafeFetch32((int*)_pages->at(i), 0);
+    pages_done++;
+  }
+
+  log_info(crac)("Warmed up %d nmethods and %d heap pages in " JLONG_FORMAT " ms",
+                 code_done, pages_done, (os::javaTimeNanos() - start) / NANOSECS_PER_MILLISEC);
+}
+
 void VM_Crac::doit() {
   // dry-run fails checkpoint
   bool ok = true;
 
   Decoder::before_checkpoint();
-  if (!check_fds()) {
-    ok = false;
+  {
+    CracPhase phase(CracPhase::checkFds);
+    if (!check_fds()) {
+      ok = false;
+    }
   }
 
   if ((!ok || _dry_run) && CRHeapDumpOnCheckpointException) {
-    HeapDumper::dump_heap();
+    CracPhase phase(CracPhase::heapDump);
+    heap_dump_on_checkpoint_error();
   }
 
   if (!ok && CRPauseOnCheckpointError) {
@@ -328,16 +1093,50 @@ void VM_Crac::doit() {
     return;
   }
 
-  if (!memory_checkpoint()) {
-    return;
+  {
+    CracPhase phase(CracPhase::metadataCleanup);
+    const size_t metaspace_before = MetaspaceUtils::committed_bytes();
+    if (discard_cold_method_data()) {
+      print_resources("JVM: discarded %d cold method data, " SIZE_FORMAT "K\n",
+                      _discarded_mdo_count, _discarded_mdo_bytes / K);
+    }
+    Metaspace::purge();
+    const size_t metaspace_after = MetaspaceUtils::committed_bytes();
+    const size_t code_discarded = CodeCache::discard_free_memory();
+    print_resources("JVM: metaspace committed " SIZE_FORMAT "K->" SIZE_FORMAT "K, "
+                    "discarded " SIZE_FORMAT "K of free code cache\n",
+                    metaspace_before / K, metaspace_after / K, code_discarded / K);
+  }
+
+  {
+    CracPhase phase(CracPhase::recordWarmup);
+    CracWarmup::record();
+  }
+
+  {
+    CracPhase phase(CracPhase::memoryCheckpoint);
+    if (!memory_checkpoint()) {
+      return;
+    }
   }
 
   int shmid = 0;
   if (CRAllowToSkipCheckpoint) {
     trace_cr("Skip Checkpoint");
   } else {
+    bool committed;
+    {
+      CracPhase phase(CracPhase::coordinatorPrepare);
+      committed = coordinator_prepare();
+    }
+    if (!committed) {
+      memory_restore();
+      return;
+    }
     trace_cr("Checkpoint ...");
     report_ok_to_jcmd_if_any();
+    _last_checkpoint_nanos = os::javaTimeNanos() - _checkpoint_start_nanos;
+    CracPhase phase(CracPhase::engine);
     int ret = checkpoint_restore(&shmid);
     if (ret == JVM_CHECKPOINT_ERROR) {
       memory_restore();
@@ -345,14 +1144,23 @@ void VM_Crac::doit() {
     }
   }
 
-  // It needs to check CPU features before any other code (such as VM_Crac::read_shm) depends on them.
-  VM_Version::crac_restore();
+  {
+    // It needs to check CPU features before any other code (such as VM_Crac::read_shm) depends on them.
+    CracPhase phase(CracPhase::cpuFeatures);
+    VM_Version::crac_restore();
+  }
 
-  if (shmid <= 0 || !VM_Crac::read_shm(shmid)) {
+  bool restored_by_launcher;
+  {
+    CracPhase phase(CracPhase::readShm);
+    restored_by_launcher = shmid > 0 && VM_Crac::read_shm(shmid);
+  }
+  if (!restored_by_launcher) {
     _restore_start_time = os::javaTimeMillis();
     _restore_start_nanos = os::javaTimeNanos();
   } else {
     _restore_start_nanos += crac::monotonic_time_offset();
+    CracPhase::record_restore_engine(os::javaTimeNanos() - _restore_start_nanos);
   }
 
   if (CRaCResetStartTime) {
@@ -361,10 +1169,26 @@ void VM_Crac::doit() {
 
   // VM_Crac::read_shm needs to be already called to read RESTORE_SETTABLE parameters.
   VM_Version::crac_restore_finalize();
+  resize_heap_on_restore();
+  resize_gc_workers_on_restore();
+  remap_code_cache_on_restore();
+  Universe::heap()->after_restore();
+  host_restore();
+
+  {
+    CracPhase phase(CracPhase::memoryRestore);
+    memory_restore();
+  }
 
-  memory_restore();
+  if (!CRAllowToSkipCheckpoint) {
+    CracPhase phase(CracPhase::coordinatorRelease);
+    coordinator_release();
+  }
 
-  wakeup_threads_in_timedwait_vm();
+  {
+    CracPhase phase(CracPhase::wakeupThreads);
+    wakeup_threads_in_timedwait_vm();
+  }
 
   _ok = true;
 }
@@ -421,14 +1245,47 @@ Handle crac::checkpoint(jarray fd_arr, jobjectArray obj_arr, bool dry_run, jlong
     return ret_cr(JVM_CHECKPOINT_NONE, Handle(), Handle(), Handle(), Handle(), THREAD);
   }
 
-  Universe::heap()->set_cleanup_unused(true);
-  Universe::heap()->collect(GCCause::_full_gc_alot);
-  Universe::heap()->set_cleanup_unused(false);
-  Universe::heap()->finish_collection();
+  CracPhase::initialize(CHECK_NH);
+  CracWarmup::initialize(CHECK_NH);
+  _checkpoint_start_nanos = os::javaTimeNanos();
+  CracWarmup::stop();
+
+  if (CRaCResolveCallSites) {
+    CracPhase phase(CracPhase::resolveCallSites);
+    resolve_call_sites(THREAD);
+  }
+
+  if (CRaCCompileQueueDrainTimeout > 0 && UseCompiler) {
+    CracPhase phase(CracPhase::compileQueueDrain);
+    if (!CompileBroker::wait_for_compile_queues_empty((jlong)CRaCCompileQueueDrainTimeout, THREAD)) {
+      log_info(crac)("Compile queues not drained in " UINTX_FORMAT " ms, checkpointing with pending compilations",
+                     CRaCCompileQueueDrainTimeout);
+    }
+  }
+
+  {
+    CracPhase phase(CracPhase::gc);
+    const bool cleanup_unused = Universe::heap()->do_cleanup_unused();
+    Universe::heap()->set_cleanup_unused(true);
+    Universe::heap()->collect(GCCause::_full_gc_alot);
+    Universe::heap()->set_cleanup_unused(cleanup_unused);
+    Universe::heap()->finish_collection();
+  }
+
+  if (MethodFlushing && UseCompiler) {
+    // Flush nmethods the sweeper has already found unused, so their space is free
+    CracPhase phase(CracPhase::codeSweep);
+    NMethodSweeper::force_sweep();
+  }
+
+  {
+    CracPhase phase(CracPhase::trimNativeHeap);
+    // Cached chunks are freed first, so that trimming can return them to the OS
+    size_t chunks = Chunk::purge_chunk_pools();
+    log_info(crac)("Freed " SIZE_FORMAT "K of cached arena chunks before checkpoint", chunks / K);
 
-  if (os::can_trim_native_heap()) {
     os::size_change_t sc;
-    if (os::trim_native_heap(&sc)) {
+    if (os::can_trim_native_heap() && os::trim_native_heap(&sc)) {
       if (sc.after != SIZE_MAX) {
         const size_t delta = sc.after < sc.before ? (sc.before - sc.after) : (sc.after - sc.before);
         const char sign = sc.after < sc.before ? '-' : '+';
@@ -438,6 +1295,25 @@ Handle crac::checkpoint(jarray fd_arr, jobjectArray obj_arr, bool dry_run, jlong
     }
   }
 
+  if (CRaCPreDump && !dry_run) {
+    CracPhase phase(CracPhase::preDump);
+    if (!call_crengine_predump(THREAD)) {
+      log_info(crac)("Pre-dump failed, all memory is written at the checkpoint");
+    }
+  }
+
+  // Rotating the chunk needs the recorder thread, so it cannot be done in VM_Crac.
+  JFR_ONLY(Jfr::before_checkpoint(THREAD);)
+
+  // Their inotify and PSI descriptors cannot be checkpointed
+  LINUX_ONLY(OSContainer::before_checkpoint();)
+  LINUX_ONLY(MemoryPressureMonitor::before_checkpoint();)
+  // Nor can the attach listener socket, it is re-opened for the new pid on restore
+  LINUX_ONLY(AttachListener::before_checkpoint();)
+
+  // Before the log is closed, so that hooks can log
+  const int num_hooks = call_before_checkpoint_hooks(THREAD);
+
   AsyncLogWriter* aio_writer = AsyncLogWriter::instance();
   if (aio_writer) {
     aio_writer->stop();
@@ -454,8 +1330,22 @@ Handle crac::checkpoint(jarray fd_arr, jobjectArray obj_arr, bool dry_run, jlong
   if (aio_writer) {
     aio_writer->resume();
   }
+  LINUX_ONLY(AttachListener::after_restore();)
+  LINUX_ONLY(OSContainer::after_restore();)
+  LINUX_ONLY(MemoryPressureMonitor::after_restore();)
+
+  JFR_ONLY(Jfr::after_restore(THREAD);)
+
+  if (cr.ok() && !dry_run && !CRAllowToSkipCheckpoint) {
+    CracWarmup::start();
+  }
+
+  call_after_restore_hooks(THREAD, num_hooks);
 
   if (cr.ok()) {
+    if (!dry_run && !CRAllowToSkipCheckpoint) {
+      _last_restore_nanos = crac::uptime_since_restore();
+    }
     oop new_args = NULL;
     if (cr.new_args()) {
       new_args = java_lang_String::create_oop_from_str(cr.new_args(), CHECK_NH);
@@ -469,7 +1359,10 @@ Handle crac::checkpoint(jarray fd_arr, jobjectArray obj_arr, bool dry_run, jlong
       props->obj_at_put(i, propObj);
     }
 
-    wakeup_threads_in_timedwait();
+    {
+      CracPhase phase(CracPhase::wakeupThreads);
+      wakeup_threads_in_timedwait();
+    }
 
     return ret_cr(JVM_CHECKPOINT_OK, Handle(THREAD, new_args), props, Handle(), Handle(), THREAD);
   }
@@ -491,12 +1384,49 @@ Handle crac::checkpoint(jarray fd_arr, jobjectArray obj_arr, bool dry_run, jlong
   return ret_cr(JVM_CHECKPOINT_ERROR, Handle(), Handle(), codes, msgs, THREAD);
 }
 
+static void print_duration(outputStream* st, const char* what, jlong nanos) {
+  if (nanos < 0) {
+    st->print_cr("  %-32s none before", what);
+  } else {
+    st->print_cr("  %-32s " JLONG_FORMAT " ms", what, nanos / NANOSECS_PER_MILLISEC);
+  }
+}
+
+void crac::print_checkpoint_report(outputStream* st, int jcmd_fd) {
+  if (!CRaCCheckpointTo) {
+    st->print_cr("CRaCCheckpointTo is not set, a checkpoint would not be taken");
+    st->cr();
+  }
+  st->print_cr("Memory accounted by the JVM:");
+  st->print_cr("  %-32s " SIZE_FORMAT_W(10) "K used, " SIZE_FORMAT_W(10) "K committed", "Java heap",
+               Universe::heap()->used() / K, Universe::heap()->capacity() / K);
+  st->print_cr("  %-32s " SIZE_FORMAT_W(10) "K used, " SIZE_FORMAT_W(10) "K committed", "Metaspace",
+               MetaspaceUtils::used_bytes() / K, MetaspaceUtils::committed_bytes() / K);
+  st->print_cr("  %-32s " SIZE_FORMAT_W(10) "K used, " SIZE_FORMAT_W(10) "K committed", "Code cache",
+               (CodeCache::capacity() - CodeCache::unallocated_capacity()) / K, CodeCache::capacity() / K);
+  st->cr();
+  // The heap shrinks by the GC done at checkpoint, so it is an upper bound
+  st->print_cr("Expected image size, before the GC done at checkpoint:");
+  print_image_estimate(st);
+  st->cr();
+  st->print_cr("Open file descriptors that fail the checkpoint unless closed or claimed by Java code:");
+  print_blocking_fds(st, jcmd_fd);
+  st->cr();
+  st->print_cr("Previous checkpoint and restore:");
+  print_duration(st, "Checkpoint, until the engine", _last_checkpoint_nanos);
+  print_duration(st, "Restore", _last_restore_nanos);
+}
+
 void crac::restore() {
   jlong restore_time = os::javaTimeMillis();
   jlong restore_nanos = os::javaTimeNanos();
 
   compute_crengine();
 
+  if (!check_manifest(CRaCRestoreFrom)) {
+    return;
+  }
+
   const int id = os::current_process_id();
 
   CracSHM shm(id);
@@ -516,7 +1446,10 @@ void crac::restore() {
     close(shmfd);
   }
 
-  if (_crengine) {
+  if (_crengine_lib != NULL) {
+    _crengine_lib->restore(CRaCRestoreFrom);
+    warning("cannot restore with %s", _crengine);
+  } else if (_crengine) {
     _crengine_args[1] = "restore";
     add_crengine_arg(CRaCRestoreFrom);
     os::execv(_crengine, _crengine_args);
@@ -531,17 +1464,30 @@ bool CracRestoreParameters::read_from(int fd) {
     return false;
   }
 
-  char *contents = NEW_C_HEAP_ARRAY(char, st.st_size, mtInternal);
-  if (read(fd, contents, st.st_size) < 0) {
-    perror("read (ignoring restore parameters)");
-    FREE_C_HEAP_ARRAY(char, contents);
+  if ((size_t)st.st_size < sizeof(header)) {
+    fprintf(stderr, "restore parameters truncated (ignoring restore parameters)\n");
+    return false;
+  }
+
+  // Private mapping: parsing below terminates flag names in place
+  char *contents = os::map_memory(fd, NULL, 0, NULL, st.st_size, false, false, mtInternal);
+  if (contents == NULL) {
+    perror("mmap (ignoring restore parameters)");
+    return false;
+  }
+
+  header* hdr = (header*)contents;
+  if (hdr->_magic != MAGIC || hdr->_version != VERSION || hdr->_size != st.st_size) {
+    fprintf(stderr, "restore parameters version %d, expected %d (ignoring restore parameters)\n",
+            hdr->_magic == MAGIC ? hdr->_version : -1, VERSION);
+    os::unmap_memory(contents, st.st_size);
     return false;
   }
 
   _raw_content = contents;
+  _raw_size = st.st_size;
 
   // parse the contents to read new system properties and arguments
-  header* hdr = (header*)_raw_content;
   char* cursor = _raw_content + sizeof(header);
 
   ::_restore_start_time = hdr->_restore_time;
@@ -602,6 +1548,61 @@ void crac::record_time_before_checkpoint() {
   read_bootid(checkpoint_bootid);
 }
 
+void crac::register_time_jump_func(time_jump_func_t func) {
+  // Only called during VM startup, by the main thread
+  guarantee(_num_time_jump_funcs < max_time_jump_funcs, "too many time jump functions");
+  _time_jump_funcs[_num_time_jump_funcs++] = func;
+}
+
+bool crac::register_checkpoint_hook(JVM_CheckpointHook before_checkpoint,
+                                    JVM_CheckpointHook after_restore, void* data) {
+  MutexLocker ml(CracHooks_lock, Mutex::_no_safepoint_check_flag);
+  if (_num_checkpoint_hooks == max_checkpoint_hooks) {
+    log_warning(crac)("Too many checkpoint hooks, cannot register another one");
+    return false;
+  }
+  CheckpointHook hook = { before_checkpoint, after_restore, data };
+  _checkpoint_hooks[_num_checkpoint_hooks++] = hook;
+  return true;
+}
+
+// Hooks registered later are called first before and last after the
+// checkpoint. They run in native, so they can call into Java; the hooks of
+// the checkpoint are the ones registered when it started.
+static int call_before_checkpoint_hooks(JavaThread* current) {
+  int num_hooks;
+  {
+    MutexLocker ml(CracHooks_lock, Mutex::_no_safepoint_check_flag);
+    num_hooks = _num_checkpoint_hooks;
+  }
+  ThreadToNativeFromVM ttn(current);
+  for (int i = num_hooks - 1; i >= 0; i--) {
+    if (_checkpoint_hooks[i]._before_checkpoint != NULL) {
+      _checkpoint_hooks[i]._before_checkpoint(current->jni_environment(), _checkpoint_hooks[i]._data);
+    }
+  }
+  return num_hooks;
+}
+
+static void call_after_restore_hooks(JavaThread* current, int num_hooks) {
+  ThreadToNativeFromVM ttn(current);
+  for (int i = 0; i < num_hooks; i++) {
+    if (_checkpoint_hooks[i]._after_restore != NULL) {
+      _checkpoint_hooks[i]._after_restore(current->jni_environment(), _checkpoint_hooks[i]._data);
+    }
+  }
+}
+
+void crac::notify_time_jump() {
+  const jlong jump = os::javaTimeNanos() - checkpoint_nanos;
+  if (jump <= 0) {
+    return;
+  }
+  for (int i = 0; i < _num_time_jump_funcs; i++) {
+    _time_jump_funcs[i](jump);
+  }
+}
+
 void crac::update_javaTimeNanos_offset() {
   char buf[UUID_LENGTH];
   // We will change the nanotime offset only if this is not the same boot
@@ -24,10 +24,13 @@
 #ifndef SHARE_RUNTIME_CRAC_HPP
 #define SHARE_RUNTIME_CRAC_HPP
 
+#include "jvm.h"
 #include "memory/allStatic.hpp"
 #include "runtime/handles.hpp"
 #include "utilities/macros.hpp"
 
+class outputStream;
+
 // xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
 #define UUID_LENGTH 36
 
@@ -38,12 +41,31 @@ public:
   static Handle checkpoint(jarray fd_arr, jobjectArray obj_arr, bool dry_run, jlong jcmd_stream, TRAPS);
   static void restore();
 
+  // Reports what a checkpoint would write and what would make it fail,
+  // without checkpointing. jcmd_fd is the socket of the reporting jcmd or -1.
+  static void print_checkpoint_report(outputStream* st, int jcmd_fd);
+
   static jlong restore_start_time();
   static jlong uptime_since_restore();
 
   static void record_time_before_checkpoint();
   static void update_javaTimeNanos_offset();
 
+  // Subsystems that keep deadlines in os::javaTimeNanos() or os::elapsed_counter()
+  // time register a function to move them after restore. Both clocks advance
+  // over a checkpoint by the time the VM was stored, which would otherwise make
+  // all those deadlines expire at once. The functions are called by the VM
+  // thread, at the safepoint of the checkpoint, with the size of the jump.
+  typedef void (*time_jump_func_t)(jlong jump_nanos);
+  static void register_time_jump_func(time_jump_func_t func);
+  static void notify_time_jump();
+
+  // Native libraries register hooks to release what cannot be checkpointed
+  // before the checkpoint and to set it up again after, see
+  // JVM_RegisterCheckpointHook.
+  static bool register_checkpoint_hook(JVM_CheckpointHook before_checkpoint,
+                                       JVM_CheckpointHook after_restore, void* data);
+
   static jlong monotonic_time_offset() {
     return javaTimeNanos_offset;
   }
@@ -53,6 +75,9 @@ public:
 private:
   static bool read_bootid(char *dest);
 
+  static void print_image_estimate(outputStream* st);
+  static void print_blocking_fds(outputStream* st, int jcmd_fd);
+
   static jlong checkpoint_millis;
   static jlong checkpoint_nanos;
   static char checkpoint_bootid[UUID_LENGTH];
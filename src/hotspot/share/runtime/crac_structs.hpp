@@ -51,10 +51,17 @@ struct CracFailDep {
 
 class CracRestoreParameters : public CHeapObj<mtInternal> {
   char* _raw_content;
+  size_t _raw_size;
   GrowableArray<const char *>* _properties;
   const char* _args;
 
+  // The parameters are passed as a single blob: the header followed by
+  // NUL-terminated flags, properties, environment variables and the command.
+  // The restored VM maps the blob and uses the strings in place.
   struct header {
+    jint _magic;
+    jint _version;
+    jlong _size;
     jlong _restore_time;
     jlong _restore_nanos;
     int _nflags;
@@ -62,9 +69,13 @@ class CracRestoreParameters : public CHeapObj<mtInternal> {
     int _env_memory_size;
   };
 
-  static bool write_check_error(int fd, const void *buf, int count) {
-    int wret = write(fd, buf, count);
-    if (wret != count) {
+  static const jint MAGIC = 0x43524143; // "CRAC"
+  // Increment on any change of the blob layout
+  static const jint VERSION = 1;
+
+  static bool write_check_error(int fd, const void *buf, size_t count) {
+    ssize_t wret = write(fd, buf, count);
+    if (wret < 0 || (size_t)wret != count) {
       if (wret < 0) {
         perror("shm error");
       } else {
@@ -92,19 +103,26 @@ class CracRestoreParameters : public CHeapObj<mtInternal> {
     return len;
   }
 
+  static char* append(char* cursor, const char* str) {
+    size_t len = strlen(str);
+    memcpy(cursor, str, len);
+    return cursor + len;
+  }
+
  public:
   const char *args() const { return _args; }
   GrowableArray<const char *>* properties() const { return _properties; }
 
   CracRestoreParameters() :
     _raw_content(NULL),
+    _raw_size(0),
     _properties(new (ResourceObj::C_HEAP, mtInternal) GrowableArray<const char *>(0, mtInternal)),
     _args(NULL)
   {}
 
   ~CracRestoreParameters() {
     if (_raw_content) {
-      FREE_C_HEAP_ARRAY(char, _raw_content);
+      os::unmap_memory(_raw_content, _raw_size);
     }
     delete _properties;
   }
@@ -115,43 +133,58 @@ class CracRestoreParameters : public CHeapObj<mtInternal> {
       const char *args,
       jlong restore_time,
       jlong restore_nanos) {
+    const char* const* env = os::get_environ();
     header hdr = {
+      MAGIC,
+      VERSION,
+      0,
       restore_time,
       restore_nanos,
       num_flags,
       system_props_length(props),
-      env_vars_size(os::get_environ())
+      env_vars_size(env)
     };
 
-    if (!write_check_error(fd, (void *)&hdr, sizeof(header))) {
-      return false;
+    size_t size = sizeof(header);
+    for (int i = 0; i < num_flags; ++i) {
+      size += strlen(flags[i]) + 1;
+    }
+    for (const SystemProperty* p = props; p != NULL; p = p->next()) {
+      size += strlen(p->key()) + 1 + (p->value() != NULL ? strlen(p->value()) : 0) + 1;
     }
+    size += hdr._env_memory_size + strlen(args) + 1;
+    hdr._size = size;
+
+    char* blob = NEW_C_HEAP_ARRAY(char, size, mtInternal);
+    memcpy(blob, &hdr, sizeof(header));
+    char* cursor = blob + sizeof(header);
 
     for (int i = 0; i < num_flags; ++i) {
-      if (!write_check_error(fd, flags[i], (int)strlen(flags[i]) + 1)) {
-        return false;
-      }
+      cursor = append(cursor, flags[i]);
+      *cursor++ = '\0';
     }
 
-    const SystemProperty* p = props;
-    while (p != NULL) {
-      char prop[4096];
-      int len = snprintf(prop, sizeof(prop), "%s=%s", p->key(), p->value());
-      guarantee((0 < len) && ((unsigned)len < sizeof(prop)), "property does not fit temp buffer");
-      if (!write_check_error(fd, prop, len+1)) {
-        return false;
+    for (const SystemProperty* p = props; p != NULL; p = p->next()) {
+      cursor = append(cursor, p->key());
+      *cursor++ = '=';
+      if (p->value() != NULL) {
+        cursor = append(cursor, p->value());
       }
-      p = p->next();
+      *cursor++ = '\0';
     }
 
-    // Write env vars
-    for (char** env = os::get_environ(); *env; ++env) {
-      if (!write_check_error(fd, *env, (int)strlen(*env) + 1)) {
-        return false;
-      }
+    for (; *env; ++env) {
+      cursor = append(cursor, *env);
+      *cursor++ = '\0';
     }
 
-    return write_check_error(fd, args, (int)strlen(args)+1); // +1 for null char
+    cursor = append(cursor, args);
+    *cursor++ = '\0';
+    assert(cursor == blob + size, "blob size mismatch");
+
+    bool ok = write_check_error(fd, blob, size);
+    FREE_C_HEAP_ARRAY(char, blob);
+    return ok;
   }
 
   bool read_from(int fd);
@@ -160,6 +193,8 @@ class CracRestoreParameters : public CHeapObj<mtInternal> {
 
 class VM_Crac: public VM_Operation {
   jarray _fd_arr;
+  // Sorted copy of _fd_arr, created on first lookup
+  GrowableArray<jint>* _claimed_fds;
   const bool _dry_run;
   bool _ok;
   GrowableArray<CracFailDep>* _failures;
@@ -172,6 +207,7 @@ class VM_Crac: public VM_Operation {
 public:
   VM_Crac(jarray fd_arr, jobjectArray obj_arr, bool dry_run, bufferedStream* jcmd_stream) :
     _fd_arr(fd_arr),
+    _claimed_fds(NULL),
     _dry_run(dry_run),
     _ok(false),
     _failures(new (ResourceObj::C_HEAP, mtInternal) GrowableArray<CracFailDep>(0, mtInternal)),
@@ -183,6 +219,7 @@ public:
   { }
 
   ~VM_Crac() {
+    delete _claimed_fds;
     delete _failures;
   }
 
@@ -191,6 +228,8 @@ public:
   const char* new_args() { return _restore_parameters.args(); }
   GrowableArray<const char *>* new_properties() { return _restore_parameters.properties(); }
   virtual bool allow_nested_vm_operations() const  { return true; }
+  // A dry run only checks for resources that prevent a checkpoint.
+  virtual bool can_coalesce() const  { return _dry_run; }
   VMOp_Type type() const { return VMOp_VM_Crac; }
   void doit();
   bool read_shm(int shmid);
@@ -204,6 +243,12 @@ private:
   bool check_fds();
   bool memory_checkpoint();
   void memory_restore();
+  // Drops state the C library cached from the checkpointing host.
+  void host_restore();
+  // Two-phase checkpoint of a group of VMs by the CRaCCoordinator: waits
+  // for the commit of the checkpoint, then, after restore, for the release.
+  bool coordinator_prepare();
+  void coordinator_release();
 };
 
 class CracSHM {
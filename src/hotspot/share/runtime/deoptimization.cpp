@@ -34,16 +34,19 @@
 #include "code/pcDesc.hpp"
 #include "code/scopeDesc.hpp"
 #include "compiler/compilationPolicy.hpp"
+#include "compiler/compilerDirectives.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "interpreter/bytecode.hpp"
 #include "interpreter/interpreter.hpp"
 #include "interpreter/oopMapCache.hpp"
+#include "logging/log.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/oopFactory.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
 #include "oops/constantPool.hpp"
 #include "oops/method.hpp"
+#include "oops/methodData.hpp"
 #include "oops/objArrayKlass.hpp"
 #include "oops/objArrayOop.inline.hpp"
 #include "oops/oop.inline.hpp"
@@ -384,6 +387,9 @@ Deoptimization::UnrollBlock* Deoptimization::fetch_unroll_info_helper(JavaThread
   assert(current->deopt_compiled_method() == NULL, "Pending deopt!");
   CompiledMethod* cm = deoptee.cb()->as_compiled_method_or_null();
   current->set_deopt_compiled_method(cm);
+  if (cm != NULL && cm->method() != NULL) {
+    DirectivesStack::record_deoptimization(methodHandle(current, cm->method()));
+  }
 
   if (VerifyStack) {
     current->validate_frame_layout();
@@ -1940,6 +1946,38 @@ static void post_deoptimization_event(CompiledMethod* nm,
 
 #endif // INCLUDE_JFR
 
+// Reports a delayed recompilation with the trap counts per reason of the method.
+static void log_recompile_backoff(CompiledMethod* nm, MethodData* mdo, jlong backoff) {
+  bool log = log_is_enabled(Info, jit, deoptimization);
+  bool event = false;
+  JFR_ONLY(event = EventDeoptimizationBackoff::is_enabled();)
+  if (!log && !event) {
+    return;
+  }
+  ResourceMark rm;
+  stringStream reasons;
+  for (int reason = 0; reason < Deoptimization::Reason_TRAP_HISTORY_LENGTH; reason++) {
+    uint count = mdo->trap_count(reason);
+    if (count > 0) {
+      reasons.print("%s%s=%u", reasons.size() > 0 ? " " : "", Deoptimization::trap_reason_name(reason), count);
+    }
+  }
+  if (log) {
+    log_info(jit, deoptimization)("Delaying recompilation of %s by " JLONG_FORMAT " ms after deoptimization storm (level %d): %s",
+                             nm->method()->external_name(), backoff, mdo->recompile_backoff_level(), reasons.as_string());
+  }
+#if INCLUDE_JFR
+  if (event) {
+    EventDeoptimizationBackoff e;
+    e.set_method(nm->method());
+    e.set_level(mdo->recompile_backoff_level());
+    e.set_backoff(backoff);
+    e.set_reasons(reasons.as_string());
+    e.commit();
+  }
+#endif
+}
+
 JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* current, jint trap_request)) {
   HandleMark hm(current);
 
@@ -2334,6 +2372,14 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* current, jint tr
         return; // the call did not change nmethod's state
       }
 
+      MethodData* nm_mdo = nm->method()->method_data();
+      if (DeoptimizationStormWindow > 0 && nm_mdo != NULL) {
+        jlong backoff = nm_mdo->record_recompile_trap(nanos_to_millis(os::javaTimeNanos()));
+        if (backoff > 0) {
+          log_recompile_backoff(nm, nm_mdo, backoff);
+        }
+      }
+
       if (pdata != NULL) {
         // Record the recompilation event, if any.
         int tstate0 = pdata->trap_state();
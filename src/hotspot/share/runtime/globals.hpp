@@ -135,7 +135,11 @@ const size_t minimumSymbolTableSize = 1024;
   product(intx, ObjectAlignmentInBytes, 8,                                  \
           "Default object alignment in bytes, 8 is minimum")                \
           range(8, 256)                                                     \
-          constraint(ObjectAlignmentInBytesConstraintFunc, AtParse)
+          constraint(ObjectAlignmentInBytesConstraintFunc, AtParse)         \
+                                                                            \
+  product(bool, UseLargerObjectAlignmentForCompressedOops, true,            \
+          "Raise the default ObjectAlignmentInBytes to 16 when that lets "  \
+          "the maximum heap size use compressed oops")
 
 #else
 // !_LP64
@@ -150,6 +154,7 @@ const size_t minimumSymbolTableSize = 1024;
 const bool UseCompressedOops = false;
 const bool UseCompressedClassPointers = false;
 const intx ObjectAlignmentInBytes = 8;
+const bool UseLargerObjectAlignmentForCompressedOops = false;
 
 #endif // _LP64
 
@@ -451,6 +456,10 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, BytecodeVerificationLocal, false, DIAGNOSTIC,               \
           "Enable the Java bytecode verifier for local classes")            \
                                                                             \
+  product(bool, LazyReflectionLinking, false,                               \
+          "Do not link a class when its fields, or its methods if they "    \
+          "cannot contain jsr, are reflected on")                           \
+                                                                            \
   develop(bool, VerifyStackAtCalls, false,                                  \
           "Verify that the stack pointer is unchanged after calls")         \
                                                                             \
@@ -556,9 +565,19 @@ const intx ObjectAlignmentInBytes = 8;
           "compression. Otherwise the level must be between 1 and 9.")      \
           range(0, 9)                                                       \
                                                                             \
+  product(bool, HeapDumpParallel, false,                                    \
+          "Dump heap objects with the safepoint workers, each writing "     \
+          "heap dump segments to a temporary file next to the dump, and "   \
+          "append the files to the dump afterwards")                        \
+                                                                            \
   product(ccstr, NativeMemoryTracking, DEBUG_ONLY("summary") NOT_DEBUG("off"), \
           "Native memory tracking options")                                 \
                                                                             \
+  product(size_t, NativeMemoryTrackingSampleInterval, 0,                    \
+          "Average number of bytes malloc'd between the call sites "        \
+          "recorded in detail native memory tracking. The sites report "    \
+          "estimates scaled from the samples. 0 records every call site")   \
+                                                                            \
   product(bool, PrintNMTStatistics, false, DIAGNOSTIC,                      \
           "Print native memory tracking summary data if it is on")          \
                                                                             \
@@ -697,6 +716,10 @@ const intx ObjectAlignmentInBytes = 8;
           "Allow parallel defineClass requests for class loaders "          \
           "registering as parallel capable")                                \
                                                                             \
+  product(bool, CacheBootLoaderMisses, true, DIAGNOSTIC,                    \
+          "Remember the names the boot loader failed to find, so that "     \
+          "repeated lookups of missing classes return early")               \
+                                                                            \
   product_pd(bool, DontYieldALot,                                           \
           "Throw away obvious excess yield calls")                          \
                                                                             \
@@ -734,6 +757,11 @@ const intx ObjectAlignmentInBytes = 8;
           "The maximum number of monitors to unlink in one batch. ")        \
           range(1, max_jint)                                                \
                                                                             \
+  product(uint, MonitorDeflationThreads, 0, DIAGNOSTIC,                     \
+          "Number of threads that deflate, unlink and delete idle "         \
+          "monitors in parallel (0 means chosen from the number of CPUs)")  \
+          range(0, 64)                                                      \
+                                                                            \
   product(intx, MonitorUsedDeflationThreshold, 90, DIAGNOSTIC,              \
           "Percentage of used monitors before triggering deflation (0 is "  \
           "off). The check is performed on GuaranteedSafepointInterval, "   \
@@ -746,6 +774,13 @@ const intx ObjectAlignmentInBytes = 8;
           "before adjusting the in_use_list_ceiling up (0 is off).")        \
           range(0, max_uintx)                                               \
                                                                             \
+  product(intx, MonitorSpinParkCost, 0, EXPERIMENTAL,                       \
+          "Estimated cost in nanoseconds of parking and unparking a "       \
+          "thread. If set, a thread contending for a monitor spins only "   \
+          "while the owners of that monitor recently released it sooner "   \
+          "than this (0 is off)")                                           \
+          range(0, max_jint)                                                \
+                                                                            \
   product(intx, hashCode, 5, EXPERIMENTAL,                                  \
                "(Unstable) select hashCode generation algorithm")           \
                                                                             \
@@ -816,6 +851,11 @@ const intx ObjectAlignmentInBytes = 8;
           range(0, 8192)                                                    \
           constraint(ContendedPaddingWidthConstraintFunc,AfterErgo)         \
                                                                             \
+  product(ccstr, HotFieldsFile, NULL,                                       \
+          "File of \"class field\" lines naming frequently accessed "       \
+          "instance fields, which are laid out together at the start of "   \
+          "their class' fields")                                            \
+                                                                            \
   product(bool, EnableContended, true,                                      \
           "Enable @Contended annotation support")                           \
                                                                             \
@@ -1122,6 +1162,11 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, UseHeavyMonitors, false,                                    \
           "use heavyweight instead of lightweight Java monitors")           \
                                                                             \
+  product(bool, UseLightweightLocking, false, EXPERIMENTAL,                 \
+          "Lock uncontended Java monitors with a per-thread lock stack "    \
+          "and a CAS of the mark word lock bits instead of stack locking "  \
+          "with displaced headers. Implies -XX:-UseBiasedLocking")          \
+                                                                            \
   product(bool, PrintStringTableStatistics, false,                          \
           "print statistics about the StringTable and SymbolTable")         \
                                                                             \
@@ -1367,6 +1412,13 @@ const intx ObjectAlignmentInBytes = 8;
           "Delay in milliseconds for option SafepointTimeout")              \
           range(0, max_intx LP64_ONLY(/MICROUNITS))                         \
                                                                             \
+  product(intx, SafepointStragglerDelay, 10,                                \
+          "Report threads that have not reached a safepoint this many "     \
+          "milliseconds after it started, with the location where they "    \
+          "stopped, through -Xlog:safepoint and the "                      \
+          "jdk.SafepointStragglers event (0 means never)")                  \
+          range(0, max_intx LP64_ONLY(/MICROUNITS))                         \
+                                                                            \
   product(intx, NmethodSweepActivity, 10,                                   \
           "Removes cold nmethods from code cache if > 0. Higher values "    \
           "result in more aggressive sweeping")                             \
@@ -1452,6 +1504,15 @@ const intx ObjectAlignmentInBytes = 8;
           "Limit on traps (of one kind) at a particular BCI")               \
           range(0, max_jint)                                                \
                                                                             \
+  product(uintx, DeoptimizationStormWindow, 0,                              \
+          "Milliseconds within which another trap making the compiled "     \
+          "code of a method not entrant doubles the delay of its "          \
+          "recompilation; 0 disables the backoff")                          \
+                                                                            \
+  product(uintx, DeoptimizationBackoffLimit, 60000,                         \
+          "Max milliseconds the recompilation of a method is delayed "      \
+          "after a deoptimization storm")                                   \
+                                                                            \
   product(intx, SpecTrapLimitExtraEntries,  3, EXPERIMENTAL,                \
           "Extra method data trap entries for speculation")                 \
                                                                             \
@@ -1626,6 +1687,17 @@ const intx ObjectAlignmentInBytes = 8;
           "Size of code heap with non-profiled methods (in bytes)")         \
           range(0, max_uintx)                                               \
                                                                             \
+  product(uintx, HotCodeHeapSize, 0,                                        \
+          "Size of the code heap for tier 4 nmethods of frequently invoked "\
+          "methods, taken from the non-profiled code heap (in bytes). "     \
+          "0 disables it. Requires SegmentedCodeCache")                     \
+          range(0, max_uintx)                                               \
+                                                                            \
+  product(intx, HotCodeMinInvocations, 100000,                              \
+          "Invocation count a method needs when its tier 4 compilation "    \
+          "is installed to be placed in the hot code heap")                 \
+          range(0, max_jint)                                                \
+                                                                            \
   product_pd(uintx, ProfiledCodeHeapSize,                                   \
           "Size of code heap with profiled methods (in bytes)")             \
           range(0, max_uintx)                                               \
@@ -1828,6 +1900,12 @@ const intx ObjectAlignmentInBytes = 8;
           "up to a multiple of the native os page size.")                   \
           range(128, 32*64*K)                                               \
                                                                             \
+  product(intx, PerfDataMaxMemorySize, 0,                                   \
+          "Size up to which the performance data memory region grows, in "  \
+          "steps of PerfDataMemorySize, when it is full. The region is "    \
+          "reserved at this size. 0 means it does not grow")                \
+          range(0, 64*M)                                                    \
+                                                                            \
   product(intx, PerfMaxStringConstLength, 1024,                             \
           "Maximum PerfStringConstant string length before truncation")     \
           range(32, 32*K)                                                   \
@@ -1860,6 +1938,12 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, PrintConcurrentLocks, false, MANAGEABLE,                    \
           "Print java.util.concurrent locks in thread dump")                \
                                                                             \
+  product(bool, ThreadDumpWithHandshakes, false, MANAGEABLE,                \
+          "Take thread dumps without a safepoint by printing each Java "    \
+          "thread in its own handshake. Lock ownership between threads "    \
+          "may be inconsistent. Not used when java.util.concurrent locks "  \
+          "are printed")                                                    \
+                                                                            \
   /* Shared spaces */                                                       \
                                                                             \
   product(bool, UseSharedSpaces, true,                                      \
@@ -2018,6 +2102,15 @@ const intx ObjectAlignmentInBytes = 8;
   product(ccstr, ExtraSharedClassListFile, NULL,                            \
           "Extra classlist for building the CDS archive file")              \
                                                                             \
+  product(ccstr, PreloadClassListFile, NULL,                                \
+          "Load and link the classes named in this class list, such as "    \
+          "one written by DumpLoadedClassList, on background threads "      \
+          "during startup")                                                 \
+                                                                            \
+  product(uint, PreloadClassThreads, 2,                                     \
+          "Number of threads loading the classes of PreloadClassListFile")  \
+          range(1, 64)                                                      \
+                                                                            \
   product(intx, ArchiveRelocationMode, 1, DIAGNOSTIC,                       \
            "(0) first map at preferred address, and if "                    \
            "unsuccessful, map at alternative address; "                     \
@@ -2026,6 +2119,16 @@ const intx ObjectAlignmentInBytes = 8;
            "do not map the archive")                                        \
            range(0, 2)                                                      \
                                                                             \
+  product(bool, SharedArchiveLargePages, false,                             \
+          "Read the CDS archive regions into anonymous memory backed by "   \
+          "transparent huge pages instead of mapping the archive file. "    \
+          "Requires UseTransparentHugePages")                               \
+                                                                            \
+  product(bool, SharedArchivePrefault, false,                               \
+          "Touch every page of the mapped CDS archive regions on a "        \
+          "background thread to take the page faults off the startup "      \
+          "path")                                                           \
+                                                                            \
   product(size_t, ArrayAllocatorMallocLimit, (size_t)-1, EXPERIMENTAL,      \
           "Allocation less than this value will be allocated "              \
           "using malloc. Larger allocations will use mmap.")                \
@@ -2106,7 +2209,8 @@ const intx ObjectAlignmentInBytes = 8;
       "optional extra parameters as a comma-separated list: "               \
       "-XX:CREngine=program,--key,value,--anotherkey results in calling "   \
       "'program --key value --anotherkey'. Commas used as part of args "    \
-      "should be escaped with a backslash character ('\\').")               \
+      "should be escaped with a backslash character ('\\'). A shared "      \
+      "library implementing crengine.h is loaded and run in the process.")  \
                                                                             \
   product(bool, CRaCIgnoreRestoreIfUnavailable, false, RESTORE_SETTABLE,    \
       "Ignore -XX:CRaCRestoreFrom and continue initialization if restore "  \
@@ -2131,6 +2235,21 @@ const intx ObjectAlignmentInBytes = 8;
       "Dump heap on CheckpointException thrown because of C/RaC "          \
        "precondition failed")                                               \
                                                                             \
+  product(ccstr, CRHeapDumpPath, NULL, DIAGNOSTIC,                          \
+      "File or named pipe the CRHeapDumpOnCheckpointException dump is "     \
+      "written to, compressed with CRHeapDumpGzipLevel. By default the "    \
+      "dump goes where HeapDumpPath and HeapDumpGzipLevel say")             \
+                                                                            \
+  product(int, CRHeapDumpGzipLevel, 1, DIAGNOSTIC,                          \
+      "Gzip compression level of the dump written to CRHeapDumpPath, "      \
+      "0 writes it uncompressed")                                           \
+      range(0, 9)                                                           \
+                                                                            \
+  product(size_t, CRHeapDumpMaxSize, 0, DIAGNOSTIC,                         \
+      "Print a class histogram instead of the "                             \
+      "CRHeapDumpOnCheckpointException dump when more than this many "      \
+      "bytes of the heap are used; 0 means no limit")                       \
+                                                                            \
   product(bool, CRPrintResourcesOnCheckpoint, false, DIAGNOSTIC,            \
       "Print resources to decide CheckpointException")                      \
                                                                             \
@@ -2145,6 +2264,79 @@ const intx ObjectAlignmentInBytes = 8;
   product(bool, CRPauseOnCheckpointError, false, DIAGNOSTIC,                \
       "Pauses the checkpoint when a problem is found on VM level.")         \
                                                                             \
+  product(uintx, CRaCCompileQueueDrainTimeout, 0,                           \
+      "Milliseconds to wait on checkpoint for compile queues to drain and " \
+      "in-progress compilations to finish; 0 does not wait")                \
+                                                                            \
+  product(bool, CRaCResolveCallSites, false,                                \
+      "Before the checkpoint, resolve invokedynamic call sites and "        \
+      "method handle, method type and dynamic constants of linked "         \
+      "classes, so that their bootstrap methods do not run after restore")  \
+                                                                            \
+  product(bool, CRaCDiscardColdMethodData, false,                           \
+      "Before the checkpoint, free the profiles of methods that are "      \
+      "neither running nor referenced from compiled code; they are "       \
+      "rebuilt if the methods get hot again after restore")                \
+                                                                            \
+  product(bool, CRaCPreDump, false,                                         \
+      "Before the checkpoint, let the CREngine copy memory while Java "     \
+      "threads keep running so the checkpoint itself only writes pages "    \
+      "changed since (requires CREngine support, e.g. criuengine)")         \
+                                                                            \
+  product(ccstr, CRaCCoordinator, NULL, RESTORE_SETTABLE,                   \
+      "Path of a UNIX domain socket of a coordinator that checkpoints a "   \
+      "group of VMs together. At the checkpoint safepoint the VM reports "  \
+      "it is ready and waits for the coordinator to commit or to abort "    \
+      "the checkpoint. After restore it waits to be released together "     \
+      "with the rest of the group")                                         \
+                                                                            \
+  product(uintx, CRaCCoordinatorTimeout, 60000, RESTORE_SETTABLE,           \
+      "Milliseconds to wait for the answer of the CRaCCoordinator. The "    \
+      "checkpoint fails if it is not committed in time, a restored VM "     \
+      "resumes if it is not released in time")                              \
+      range(1, max_jint)                                                    \
+                                                                            \
+  product(bool, CRaCShareReadOnlyFiles, true,                               \
+      "Leave unmodified pages of read-only file mappings, such as the CDS " \
+      "archive and lib/modules, out of the checkpoint image. After "        \
+      "restore they are read from the files again")                         \
+                                                                            \
+  product(bool, CRaCUseNewCPUFeatures, false,                               \
+      EXPERIMENTAL | RESTORE_SETTABLE,                                      \
+      "On restore, enable instructions the CPU has in addition to those "   \
+      "of the checkpoint and deoptimize compiled code to pick them up "     \
+      "(x86 only)")                                                         \
+                                                                            \
+  product(bool, CRaCResizeHeapOnRestore, false, RESTORE_SETTABLE,         \
+      "On restore, recompute the heap size from the memory available on "  \
+      "the restoring host and apply it as SoftMaxHeapSize (up to the "      \
+      "MaxHeapSize reserved at checkpoint)")                                \
+                                                                            \
+  product(bool, CRaCResizeGCWorkersOnRestore, false, RESTORE_SETTABLE,      \
+      "On restore, limit active GC workers to the processor count of the "  \
+      "restoring host. The gangs keep the size chosen at checkpoint, "      \
+      "set ParallelGCThreads/ConcGCThreads there to allow more workers")    \
+                                                                            \
+  product(bool, CRaCCodeCacheLargePagesOnRestore, false, RESTORE_SETTABLE,  \
+      "On restore, re-apply large page backing to the committed code "      \
+      "heaps, which the restore may have mapped with small pages (Linux "   \
+      "with UseTransparentHugePages)")                                      \
+                                                                            \
+  product(bool, CRaCWarmupOnRestore, false, RESTORE_SETTABLE,               \
+      "At checkpoint, record the hottest compiled methods and the pages "   \
+      "of the first live heap objects, and read them from a background "    \
+      "thread after restore. The sun.rt.crac.warmupInProgress counter is "  \
+      "1 until it is done")                                                 \
+                                                                            \
+  product(uint, CRaCWarmupMethods, 1000,                                    \
+      "Number of the hottest compiled methods CRaCWarmupOnRestore "         \
+      "records")                                                            \
+      range(0, max_jint)                                                    \
+                                                                            \
+  product(size_t, CRaCWarmupHeapSize, 64 * M,                               \
+      "Size of the heap pages CRaCWarmupOnRestore records, 0 records "      \
+      "none")                                                               \
+                                                                            \
   JFR_ONLY(product(ccstr, StartFlightRecording, NULL,                       \
           "Start flight recording with options"))                           \
                                                                             \
@@ -345,6 +345,38 @@ void Handshake::execute(HandshakeClosure* hs_cl) {
   VMThread::execute(&handshake);
 }
 
+// Runs a batch of closures for a thread, see Handshake::execute(HandshakeClosure* const*, uint).
+class HandshakeBatchClosure : public HandshakeClosure {
+  HandshakeClosure* const* const _closures;
+  const uint _count;
+ public:
+  HandshakeBatchClosure(HandshakeClosure* const* closures, uint count) :
+    HandshakeClosure("HandshakeBatch"), _closures(closures), _count(count) {}
+
+  void do_thread(Thread* thread) {
+    for (uint i = 0; i < _count; i++) {
+      _closures[i]->do_thread(thread);
+    }
+  }
+};
+
+void Handshake::execute(HandshakeClosure* const* hs_cls, uint count) {
+  if (count == 0) {
+    return;
+  }
+  if (count == 1) {
+    execute(hs_cls[0]);
+    return;
+  }
+  for (uint i = 0; i < count; i++) {
+    assert(!hs_cls[i]->is_async() && !hs_cls[i]->is_suspend(), "%s can not be batched", hs_cls[i]->name());
+    log_debug(handshake)("Handshake batch " INTPTR_FORMAT " [%u]: %s", p2i(hs_cls), i, hs_cls[i]->name());
+  }
+  // One pass over the ThreadsList and one poll per thread for all closures.
+  HandshakeBatchClosure batch(hs_cls, count);
+  execute(&batch);
+}
+
 void Handshake::execute(HandshakeClosure* hs_cl, JavaThread* target) {
   JavaThread* self = JavaThread::current();
   HandshakeOperation op(hs_cl, target, Thread::current());
@@ -406,7 +438,14 @@ void Handshake::execute(AsyncHandshakeClosure* hs_cl, JavaThread* target) {
 
   ThreadsListHandle tlh;
   if (tlh.includes(target)) {
-    target->handshake_state()->add_operation(op);
+    if (hs_cl->can_coalesce()) {
+      if (!target->handshake_state()->add_coalescable_operation(op)) {
+        log_handshake_info(start_time_ns, op->name(), 0, 0, "(coalesced)");
+        delete op;
+      }
+    } else {
+      target->handshake_state()->add_operation(op);
+    }
   } else {
     log_handshake_info(start_time_ns, op->name(), 0, 0, "(thread dead)");
     delete op;
@@ -429,6 +468,30 @@ void HandshakeState::add_operation(HandshakeOperation* op) {
   SafepointMechanism::arm_local_poll_release(_handshakee);
 }
 
+bool HandshakeState::MatchCoalescable::operator()(HandshakeOperation* op) {
+  // Closures of the same type share a name.
+  return op != _op && op->is_async() && strcmp(op->name(), _op->name()) == 0;
+}
+
+bool HandshakeState::add_coalescable_operation(HandshakeOperation* op) {
+  assert(op->is_async(), "only async operations are coalesced");
+  if (_lock.owned_by_self()) {
+    // Installed by a closure executing for this thread, which may be the
+    // matching operation itself.
+    add_operation(op);
+    return true;
+  }
+  MutexLocker ml(&_lock, Mutex::_no_safepoint_check_flag);
+  // Ops are removed under the lock after they have been executed. A matching
+  // op is thus still to be executed and then covers this one.
+  MatchCoalescable mc(op);
+  if (_queue.contains(mc)) {
+    return false;
+  }
+  add_operation(op);
+  return true;
+}
+
 bool HandshakeState::operation_pending(HandshakeOperation* op) {
   MutexLocker ml(&_lock, Mutex::_no_safepoint_check_flag);
   MatchOp mo(op);
@@ -58,6 +58,9 @@ class AsyncHandshakeClosure : public HandshakeClosure {
    AsyncHandshakeClosure(const char* name) : HandshakeClosure(name) {}
    virtual ~AsyncHandshakeClosure() {}
    virtual bool is_async()          { return true; }
+   // If true, the closure is dropped when the target already has a pending
+   // closure of the same name, i.e. executing it twice is the same as once.
+   virtual bool can_coalesce()      { return false; }
 };
 
 class Handshake : public AllStatic {
@@ -66,6 +69,10 @@ class Handshake : public AllStatic {
   static void execute(HandshakeClosure*       hs_cl);
   static void execute(HandshakeClosure*       hs_cl, JavaThread* target);
   static void execute(AsyncHandshakeClosure*  hs_cl, JavaThread* target);
+  // Executes all closures, in order, for each thread in a single handshake.
+  // Unlike separate handshakes, a closure may run for one thread before the
+  // previous closure has run for all threads.
+  static void execute(HandshakeClosure* const* hs_cls, uint count);
 };
 
 class JvmtiRawMonitor;
@@ -109,10 +116,19 @@ class HandshakeState {
     }
   };
 
+  class MatchCoalescable {
+    HandshakeOperation* _op;
+   public:
+    MatchCoalescable(HandshakeOperation* op) : _op(op) {}
+    bool operator()(HandshakeOperation* op);
+  };
+
  public:
   HandshakeState(JavaThread* thread);
 
   void add_operation(HandshakeOperation* op);
+  // Adds op unless an equivalent async operation is already pending.
+  bool add_coalescable_operation(HandshakeOperation* op);
 
   bool has_operation() {
     return !_queue.is_empty();
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_RUNTIME_LOCKSTACK_HPP
+#define SHARE_RUNTIME_LOCKSTACK_HPP
+
+#include "oops/oopsHierarchy.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class OopClosure;
+class outputStream;
+
+// The objects locked by a thread with lightweight locking
+// (-XX:+UseLightweightLocking). An object is fast-locked when its mark
+// word has the locked_value lock bits and it is on the lock stack of the
+// owning thread; the rest of the mark word is the unlocked header, so no
+// displaced header is needed. Recursive locking and locking with a full
+// lock stack inflate the lock to an ObjectMonitor.
+//
+// The lock stack is only modified by its owner, or by another thread
+// while the owner is stopped in a safepoint or handshake.
+class LockStack {
+  friend class VMStructs;
+ public:
+  static const int CAPACITY = 8;
+
+ private:
+  int _top;
+  oop _base[CAPACITY];
+
+ public:
+  LockStack() : _top(0) {}
+
+  bool is_empty() const { return _top == 0; }
+  bool is_full() const  { return _top == CAPACITY; }
+  int size() const      { return _top; }
+
+  inline void push(oop o);
+  inline oop pop();
+  inline bool contains(oop o) const;
+  // Remove o which may be anywhere on the lock stack.
+  inline void remove(oop o);
+
+  // GC support
+  void oops_do(OopClosure* cl);
+
+  void print_on(outputStream* st) const;
+};
+
+#endif // SHARE_RUNTIME_LOCKSTACK_HPP
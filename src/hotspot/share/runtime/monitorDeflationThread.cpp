@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "jvm_io.h"
 #include "classfile/javaClasses.hpp"
 #include "classfile/vmClasses.hpp"
 #include "classfile/vmSymbols.hpp"
@@ -33,10 +34,26 @@
 #include "runtime/monitorDeflationThread.hpp"
 #include "runtime/mutexLocker.hpp"
 
+MonitorDeflationThread::TaskFunction MonitorDeflationThread::_task = NULL;
+uint MonitorDeflationThread::_task_generation = 0;
+uint MonitorDeflationThread::_active_workers = 0;
+
 void MonitorDeflationThread::initialize() {
   EXCEPTION_MARK;
 
-  const char* name = "Monitor Deflation Thread";
+  create_thread(0, &monitor_deflation_thread_entry, CHECK);
+  for (uint i = 1; i < MonitorDeflationThreads; i++) {
+    create_thread(i, &monitor_deflation_worker_entry, CHECK);
+  }
+}
+
+void MonitorDeflationThread::create_thread(uint worker_id, ThreadFunction entry_point, TRAPS) {
+  char name[64];
+  if (worker_id == 0) {
+    jio_snprintf(name, sizeof(name), "Monitor Deflation Thread");
+  } else {
+    jio_snprintf(name, sizeof(name), "Monitor Deflation Thread#%u", worker_id);
+  }
   Handle string = java_lang_String::create_from_str(name, CHECK);
 
   // Initialize thread_oop to put it into the system threadGroup
@@ -48,12 +65,65 @@ void MonitorDeflationThread::initialize() {
                           string,
                           CHECK);
 
-  MonitorDeflationThread* thread = new MonitorDeflationThread(&monitor_deflation_thread_entry);
+  MonitorDeflationThread* thread = new MonitorDeflationThread(entry_point, worker_id);
   JavaThread::vm_exit_on_osthread_failure(thread);
 
   JavaThread::start_internal_daemon(THREAD, thread, thread_oop, NearMaxPriority);
 }
 
+void MonitorDeflationThread::run_task(JavaThread* current, TaskFunction task) {
+  assert(current->is_monitor_deflation_thread() &&
+         ((MonitorDeflationThread*)current)->_worker_id == 0, "only the first thread hands out tasks");
+  {
+    MonitorLocker ml(MonitorDeflation_lock, Mutex::_no_safepoint_check_flag);
+    _task = task;
+    _active_workers = MonitorDeflationThreads - 1;
+    _task_generation++;
+    ml.notify_all();
+  }
+
+  task(0);
+
+  {
+    // Wait for the other threads in a safepoint safe state.
+    ThreadBlockInVM tbivm(current);
+
+    MonitorLocker ml(MonitorDeflation_lock, Mutex::_no_safepoint_check_flag);
+    while (_active_workers > 0) {
+      ml.wait();
+    }
+  }
+}
+
+void MonitorDeflationThread::monitor_deflation_worker_entry(JavaThread* jt, TRAPS) {
+  uint worker_id = ((MonitorDeflationThread*)jt)->_worker_id;
+  uint seen_generation = 0;
+
+  while (true) {
+    TaskFunction task;
+    {
+      ThreadBlockInVM tbivm(jt);
+
+      MonitorLocker ml(MonitorDeflation_lock, Mutex::_no_safepoint_check_flag);
+      while (_task_generation == seen_generation) {
+        // Wait until the first thread hands out a task.
+        ml.wait();
+      }
+      seen_generation = _task_generation;
+      task = _task;
+    }
+
+    task(worker_id);
+
+    {
+      MonitorLocker ml(MonitorDeflation_lock, Mutex::_no_safepoint_check_flag);
+      if (--_active_workers == 0) {
+        ml.notify_all();
+      }
+    }
+  }
+}
+
 void MonitorDeflationThread::monitor_deflation_thread_entry(JavaThread* jt, TRAPS) {
 
   // We wait for the lowest of these three intervals:
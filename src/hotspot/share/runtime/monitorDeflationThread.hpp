@@ -28,17 +28,35 @@
 #include "runtime/thread.hpp"
 
 // A hidden from external view JavaThread for deflating idle monitors.
+// With MonitorDeflationThreads > 1, the first thread runs the deflation
+// cycles and the other threads help it with the tasks it hands out.
 
 class MonitorDeflationThread : public JavaThread {
   friend class VMStructs;
+ public:
+  typedef void (*TaskFunction)(uint worker_id);
+
  private:
+  uint _worker_id;
+
+  // The current task, protected by MonitorDeflation_lock.
+  static TaskFunction _task;
+  static uint _task_generation;
+  static uint _active_workers;
 
   static void monitor_deflation_thread_entry(JavaThread* thread, TRAPS);
-  MonitorDeflationThread(ThreadFunction entry_point) : JavaThread(entry_point) {};
+  static void monitor_deflation_worker_entry(JavaThread* thread, TRAPS);
+  static void create_thread(uint worker_id, ThreadFunction entry_point, TRAPS);
+  MonitorDeflationThread(ThreadFunction entry_point, uint worker_id) :
+    JavaThread(entry_point), _worker_id(worker_id) {};
 
  public:
   static void initialize();
 
+  // Runs task on all the MonitorDeflationThreads, the calling first
+  // thread included, and returns when all of them have finished it.
+  static void run_task(JavaThread* current, TaskFunction task);
+
   // Hide this thread from external view.
   bool is_hidden_from_external_view() const { return true; }
   bool is_monitor_deflation_thread() const { return true; }
@@ -43,7 +43,9 @@ Mutex*   Patching_lock                = NULL;
 Mutex*   CompiledMethod_lock          = NULL;
 Monitor* SystemDictionary_lock        = NULL;
 Mutex*   SharedDictionary_lock        = NULL;
+Mutex*   BootLoaderMissCache_lock     = NULL;
 Monitor* ClassInitError_lock          = NULL;
+Mutex*   ClassInitTimes_lock          = NULL;
 Mutex*   Module_lock                  = NULL;
 Mutex*   CompiledIC_lock              = NULL;
 Mutex*   InlineCacheBuffer_lock       = NULL;
@@ -144,6 +146,9 @@ Monitor* ThreadsSMRDelete_lock        = NULL;
 Mutex*   ThreadIdTableCreate_lock     = NULL;
 Mutex*   SharedDecoder_lock           = NULL;
 Mutex*   DCmdFactory_lock             = NULL;
+#if INCLUDE_SERVICES
+Monitor* AttachListener_lock          = NULL;
+#endif
 #if INCLUDE_NMT
 Mutex*   NMTQuery_lock                = NULL;
 #endif
@@ -158,6 +163,8 @@ Mutex*   ClassListFile_lock           = NULL;
 Mutex*   LambdaFormInvokers_lock      = NULL;
 #endif // INCLUDE_CDS
 Mutex*   Bootclasspath_lock           = NULL;
+Mutex*   CracHooks_lock               = NULL;
+Monitor* CracWarmup_lock              = NULL;
 
 #if INCLUDE_JVMCI
 Monitor* JVMCI_lock                   = NULL;
@@ -256,7 +263,9 @@ void mutex_init() {
 
   def(SystemDictionary_lock        , PaddedMonitor, leaf,        true,  _safepoint_check_always);
   def(SharedDictionary_lock        , PaddedMutex  , leaf,        true,  _safepoint_check_always);
+  def(BootLoaderMissCache_lock     , PaddedMutex  , leaf,        true,  _safepoint_check_never);
   def(ClassInitError_lock          , PaddedMonitor, leaf+1,      true,  _safepoint_check_always);
+  def(ClassInitTimes_lock          , PaddedMutex  , leaf,        true,  _safepoint_check_never);
   def(Module_lock                  , PaddedMutex  , leaf+2,      false, _safepoint_check_always);
   def(InlineCacheBuffer_lock       , PaddedMutex  , leaf,        true,  _safepoint_check_never);
   def(VMStatistic_lock             , PaddedMutex  , leaf,        false, _safepoint_check_always);
@@ -336,6 +345,9 @@ void mutex_init() {
   def(ThreadIdTableCreate_lock     , PaddedMutex  , leaf,        false, _safepoint_check_always);
   def(SharedDecoder_lock           , PaddedMutex  , native,      true,  _safepoint_check_never);
   def(DCmdFactory_lock             , PaddedMutex  , leaf,        true,  _safepoint_check_never);
+#if INCLUDE_SERVICES
+  def(AttachListener_lock          , PaddedMonitor, leaf,        true,  _safepoint_check_never);
+#endif
 #if INCLUDE_NMT
   def(NMTQuery_lock                , PaddedMutex  , max_nonleaf, false, _safepoint_check_always);
 #endif
@@ -350,6 +362,8 @@ void mutex_init() {
   def(LambdaFormInvokers_lock      , PaddedMutex  , nonleaf+2,   false, _safepoint_check_always);
 #endif // INCLUDE_CDS
   def(Bootclasspath_lock           , PaddedMutex  , leaf,        false, _safepoint_check_never);
+  def(CracHooks_lock               , PaddedMutex  , leaf,        false, _safepoint_check_never);
+  def(CracWarmup_lock              , PaddedMonitor, leaf,        true,  _safepoint_check_never);
 
 #if INCLUDE_JVMCI
   def(JVMCI_lock                   , PaddedMonitor, nonleaf+2,   true,  _safepoint_check_always);
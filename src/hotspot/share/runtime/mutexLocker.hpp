@@ -35,7 +35,9 @@ extern Mutex*   Patching_lock;                   // a lock used to guard code pa
 extern Mutex*   CompiledMethod_lock;             // a lock used to guard a compiled method and OSR queues
 extern Monitor* SystemDictionary_lock;           // a lock on the system dictionary
 extern Mutex*   SharedDictionary_lock;           // a lock on the CDS shared dictionary
+extern Mutex*   BootLoaderMissCache_lock;        // a lock on the names the boot loader failed to find
 extern Monitor* ClassInitError_lock;             // a lock on the class initialization error table
+extern Mutex*   ClassInitTimes_lock;             // a lock on the slowest class initializers
 extern Mutex*   Module_lock;                     // a lock on module and package related data structures
 extern Mutex*   CompiledIC_lock;                 // a lock used to guard compiled IC patching and access
 extern Mutex*   InlineCacheBuffer_lock;          // a lock used to guard the InlineCacheBuffer
@@ -122,6 +124,9 @@ extern Monitor* ThreadsSMRDelete_lock;           // Used by ThreadsSMRSupport to
 extern Mutex*   ThreadIdTableCreate_lock;        // Used by ThreadIdTable to lazily create the thread id table
 extern Mutex*   SharedDecoder_lock;              // serializes access to the decoder during normal (not error reporting) use
 extern Mutex*   DCmdFactory_lock;                // serialize access to DCmdFactory information
+#if INCLUDE_SERVICES
+extern Monitor* AttachListener_lock;             // a lock on closing and re-opening the attach listener around a checkpoint
+#endif
 #if INCLUDE_NMT
 extern Mutex*   NMTQuery_lock;                   // serialize NMT Dcmd queries
 #endif
@@ -159,6 +164,8 @@ extern Monitor* JVMCI_lock;                      // Monitor to control initializ
 #endif
 
 extern Mutex*   Bootclasspath_lock;
+extern Mutex*   CracHooks_lock;                  // protects the checkpoint hooks of native libraries
+extern Monitor* CracWarmup_lock;                 // hands the post-restore warmup to its thread
 
 extern Mutex* tty_lock;                          // lock to synchronize output.
 
@@ -27,6 +27,7 @@
 #include "gc/shared/barrierSet.hpp"
 #include "gc/shared/gcId.hpp"
 #include "runtime/atomic.hpp"
+#include "runtime/crac.hpp"
 #include "runtime/jniHandles.hpp"
 #include "runtime/nonJavaThread.hpp"
 #include "runtime/osThread.hpp"
@@ -157,6 +158,7 @@ void NamedThread::print_on(outputStream* st) const {
 WatcherThread* WatcherThread::_watcher_thread   = NULL;
 bool WatcherThread::_startable = false;
 volatile bool  WatcherThread::_should_terminate = false;
+volatile jlong WatcherThread::_time_jump_nanos = 0;
 
 WatcherThread::WatcherThread() : NonJavaThread() {
   assert(watcher_thread() == NULL, "we can only allocate one WatcherThread");
@@ -195,10 +197,13 @@ int WatcherThread::sleep() const {
   OSThreadWaitState osts(this->osthread(), false /* not Object.wait() */);
 
   jlong time_before_loop = os::javaTimeNanos();
+  Atomic::store(&_time_jump_nanos, (jlong)0);
 
   while (true) {
     bool timedout = ml.wait(remaining);
     jlong now = os::javaTimeNanos();
+    // The time spent checkpointed is not slept, or all tasks would be due at once
+    time_before_loop += Atomic::xchg(&_time_jump_nanos, (jlong)0);
 
     if (remaining == 0) {
       // if we didn't have any tasks we could have waited for a long time
@@ -304,6 +309,11 @@ void WatcherThread::start() {
 void WatcherThread::make_startable() {
   assert(PeriodicTask_lock->owned_by_self(), "PeriodicTask_lock required");
   _startable = true;
+  crac::register_time_jump_func(&WatcherThread::time_jumped);
+}
+
+void WatcherThread::time_jumped(jlong jump_nanos) {
+  Atomic::add(&_time_jump_nanos, jump_nanos);
 }
 
 void WatcherThread::stop() {
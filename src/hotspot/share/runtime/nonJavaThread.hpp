@@ -131,6 +131,10 @@ class WatcherThread: public NonJavaThread {
   static bool _startable;
   // volatile due to at least one lock-free read
   volatile static bool _should_terminate;
+  // Time the clocks jumped over a checkpoint during the current sleep
+  static volatile jlong _time_jump_nanos;
+
+  static void time_jumped(jlong jump_nanos);
  public:
   enum SomeConstants {
     delay_interval = 10                          // interrupt delay in milliseconds
@@ -51,6 +51,7 @@
 #include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/timer.hpp"
 #include "services/threadService.hpp"
 #include "utilities/dtrace.hpp"
 #include "utilities/macros.hpp"
@@ -119,6 +120,8 @@ static int Knob_Poverty             = 1000;
 static int Knob_FixedSpin           = 0;
 static int Knob_PreSpin             = 10;      // 20-100 likely better
 
+jlong ObjectMonitor::_spin_park_cost_ticks = 0;
+
 DEBUG_ONLY(static volatile bool InitDone = false;)
 
 OopStorage* ObjectMonitor::_oop_storage = NULL;
@@ -269,6 +272,7 @@ ObjectMonitor::ObjectMonitor(oop object) :
   _Responsible(NULL),
   _Spinner(0),
   _SpinDuration(ObjectMonitor::Knob_SpinLimit),
+  _hold_ticks(0),
   _contentions(0),
   _WaitSet(NULL),
   _waiters(0),
@@ -473,6 +477,7 @@ bool ObjectMonitor::enter(JavaThread* current) {
   }
   if (event.should_commit()) {
     event.set_previousOwner((uintptr_t)_previous_owner_tid);
+    event.set_holdTime((s8)(TimeHelper::counter_to_seconds(Atomic::load(&_hold_ticks)) * NANOSECS_PER_SEC));
     event.commit();
   }
   OM_PERFDATA_OP(ContendedLockAttempts, inc());
@@ -1881,6 +1886,20 @@ int ObjectMonitor::TrySpin(JavaThread* current) {
     return 0;
   }
 
+  // With MonitorSpinParkCost, spin only if the owners of this monitor
+  // recently released it sooner than parking and unparking would take.
+  // Decay the estimate on each refusal, so that not spinning does not
+  // become an absorbing state either.
+  jlong spin_start = 0;
+  if (_spin_park_cost_ticks > 0) {
+    jlong hold_ticks = Atomic::load(&_hold_ticks);
+    if (hold_ticks > _spin_park_cost_ticks) {
+      Atomic::store(&_hold_ticks, hold_ticks - (hold_ticks >> 3));
+      return 0;
+    }
+    spin_start = os::elapsed_counter();
+  }
+
   // We're good to spin ... spin ingress.
   // CONSIDER: use Prefetch::write() to avoid RTS->RTO upgrades
   // when preparing to LD...CAS _owner, etc and the CAS is likely
@@ -1910,6 +1929,14 @@ int ObjectMonitor::TrySpin(JavaThread* current) {
       if (SafepointMechanism::should_process(current)) {
         goto Abort;           // abrupt spin egress
       }
+      if (spin_start != 0) {
+        // Spinning for longer than a park and unpark would take is futile.
+        jlong spun = os::elapsed_counter() - spin_start;
+        if (spun > _spin_park_cost_ticks) {
+          record_hold_time(spun);
+          break;              // spin failure with prejudice
+        }
+      }
       SpinPause();
     }
 
@@ -1945,6 +1972,9 @@ int ObjectMonitor::TrySpin(JavaThread* current) {
           if (x < Knob_Poverty) x = Knob_Poverty;
           _SpinDuration = x + Knob_Bonus;
         }
+        if (spin_start != 0) {
+          record_hold_time(os::elapsed_counter() - spin_start);
+        }
         return 1;
       }
 
@@ -1959,6 +1989,9 @@ int ObjectMonitor::TrySpin(JavaThread* current) {
 
     // Did lock ownership change hands ?
     if (ox != prv && prv != NULL) {
+      if (spin_start != 0) {
+        record_hold_time(os::elapsed_counter() - spin_start);
+      }
       goto Abort;
     }
     prv = ox;
@@ -2002,6 +2035,14 @@ int ObjectMonitor::TrySpin(JavaThread* current) {
   return 0;
 }
 
+// Fold the time a spinner waited for the owner to release the monitor
+// into the monitor's moving average. Like _SpinDuration, the average is
+// updated without synchronization: a lost update only loses a sample.
+void ObjectMonitor::record_hold_time(jlong ticks) {
+  jlong hold_ticks = Atomic::load(&_hold_ticks);
+  Atomic::store(&_hold_ticks, hold_ticks + ((ticks - hold_ticks) >> 3));
+}
+
 // NotRunnable() -- informed spinning
 //
 // Don't bother spinning if the owner is not eligible to drop the lock.
@@ -2144,6 +2185,8 @@ PerfCounter * ObjectMonitor::_sync_Parks                       = NULL;
 PerfCounter * ObjectMonitor::_sync_Notifications               = NULL;
 PerfCounter * ObjectMonitor::_sync_Inflations                  = NULL;
 PerfCounter * ObjectMonitor::_sync_Deflations                  = NULL;
+PerfCounter * ObjectMonitor::_sync_DeflationCycles             = NULL;
+PerfCounter * ObjectMonitor::_sync_DeflationTime               = NULL;
 PerfLongVariable * ObjectMonitor::_sync_MonExtant              = NULL;
 
 // One-shot global initialization for the sync subsystem.
@@ -2161,6 +2204,8 @@ void ObjectMonitor::Initialize() {
     Knob_FixedSpin = -1;
   }
 
+  _spin_park_cost_ticks = MonitorSpinParkCost * os::elapsed_frequency() / NANOSECS_PER_SEC;
+
   if (UsePerfData) {
     EXCEPTION_MARK;
 #define NEWPERFCOUNTER(n)                                                \
@@ -2175,6 +2220,9 @@ void ObjectMonitor::Initialize() {
   }
     NEWPERFCOUNTER(_sync_Inflations);
     NEWPERFCOUNTER(_sync_Deflations);
+    NEWPERFCOUNTER(_sync_DeflationCycles);
+    _sync_DeflationTime = PerfDataManager::create_counter(SUN_RT, "_sync_DeflationTime",
+                                                          PerfData::U_Ticks, CHECK);
     NEWPERFCOUNTER(_sync_ContendedLockAttempts);
     NEWPERFCOUNTER(_sync_FutileWakeups);
     NEWPERFCOUNTER(_sync_Parks);
@@ -147,6 +147,9 @@ class ObjectMonitor : public CHeapObj<mtObjectMonitor> {
                         sizeof(WeakHandle));
   // Used by async deflation as a marker in the _owner field:
   #define DEFLATER_MARKER reinterpret_cast<void*>(-1)
+  // Used by lightweight locking as the owner of a monitor inflated by a
+  // thread that does not own the lock, until the owner claims it:
+  #define ANONYMOUS_OWNER reinterpret_cast<void*>(1)
   void* volatile _owner;            // pointer to owning thread OR BasicLock
   volatile jlong _previous_owner_tid;  // thread id of the previous owner of the monitor
   // Separate _owner and _next_om on different cache lines since
@@ -167,6 +170,7 @@ class ObjectMonitor : public CHeapObj<mtObjectMonitor> {
 
   volatile int _Spinner;            // for exit->spinner handoff optimization
   volatile int _SpinDuration;
+  volatile jlong _hold_ticks;       // Average time contending spinners waited for the owner
 
   jint  _contentions;               // Number of active contentions in enter(). It is used by is_busy()
                                     // along with other fields to determine if an ObjectMonitor can be
@@ -199,9 +203,12 @@ class ObjectMonitor : public CHeapObj<mtObjectMonitor> {
   static PerfCounter * _sync_Notifications;
   static PerfCounter * _sync_Inflations;
   static PerfCounter * _sync_Deflations;
+  static PerfCounter * _sync_DeflationCycles;
+  static PerfCounter * _sync_DeflationTime;
   static PerfLongVariable * _sync_MonExtant;
 
   static int Knob_SpinLimit;
+  static jlong _spin_park_cost_ticks;  // MonitorSpinParkCost in ticks
 
   // TODO-FIXME: the "offset" routines should return a type of off_t instead of int ...
   // ByteSize would also be an appropriate type.
@@ -263,6 +270,12 @@ class ObjectMonitor : public CHeapObj<mtObjectMonitor> {
   // _owner field. Returns the prior value of the _owner field.
   void*     try_set_owner_from(void* old_value, void* new_value);
 
+  // Lightweight locking support for monitors inflated while the lock is
+  // on the lock stack of another thread.
+  void      set_owner_anonymous();
+  bool      is_owner_anonymous() const;
+  void      set_owner_from_anonymous(Thread* owner);
+
   // Simply get _next_om field.
   ObjectMonitor* next_om() const;
   // Get _next_om field with acquire semantics.
@@ -342,6 +355,7 @@ class ObjectMonitor : public CHeapObj<mtObjectMonitor> {
   int       TryLock(JavaThread* current);
   int       NotRunnable(JavaThread* current, JavaThread* Owner);
   int       TrySpin(JavaThread* current);
+  void      record_hold_time(jlong ticks);
   void      ExitEpilog(JavaThread* current, ObjectWaiter* Wakee);
 
   // Deflation support
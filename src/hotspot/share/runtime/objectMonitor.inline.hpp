@@ -146,6 +146,18 @@ inline void* ObjectMonitor::try_set_owner_from(void* old_value, void* new_value)
   return prev;
 }
 
+inline void ObjectMonitor::set_owner_anonymous() {
+  set_owner_from(NULL, ANONYMOUS_OWNER);
+}
+
+inline bool ObjectMonitor::is_owner_anonymous() const {
+  return owner_raw() == ANONYMOUS_OWNER;
+}
+
+inline void ObjectMonitor::set_owner_from_anonymous(Thread* owner) {
+  set_owner_from(ANONYMOUS_OWNER, owner);
+}
+
 // The _next_om field can be concurrently read and modified so we
 // use Atomic operations to disable compiler optimizations that
 // might try to elide loading and/or storing this field.
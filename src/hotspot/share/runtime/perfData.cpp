@@ -181,6 +181,10 @@ void PerfData::create_entry(BasicType dtype, size_t dsize, size_t vlen) {
   _pdep = pdep;
   _valuep = valuep;
 
+  if (!is_on_c_heap()) {
+    PerfMemory::publish(psmp, size);
+  }
+
   // mark the PerfData memory region as having been updated.
   PerfMemory::mark_updated();
 }
@@ -38,6 +38,7 @@
 #include "runtime/statSampler.hpp"
 #include "utilities/align.hpp"
 #include "utilities/globalDefinitions.hpp"
+#include "utilities/spinYield.hpp"
 
 // Prefix of performance data file.
 const char               PERFDATA_NAME[] = "hsperfdata";
@@ -93,18 +94,21 @@ void PerfMemory::initialize() {
     // initialization already performed
     return;
 
-  size_t capacity = align_up(PerfDataMemorySize,
+  size_t initial_size = align_up(PerfDataMemorySize,
+                                 os::vm_allocation_granularity());
+  size_t capacity = align_up(MAX2((size_t)PerfDataMaxMemorySize, initial_size),
                              os::vm_allocation_granularity());
 
   log_debug(perf, memops)("PerfDataMemorySize = " SIZE_FORMAT ","
                           " os::vm_allocation_granularity = %d,"
-                          " adjusted size = " SIZE_FORMAT,
+                          " adjusted size = " SIZE_FORMAT ","
+                          " reserved size = " SIZE_FORMAT,
                           PerfDataMemorySize,
                           os::vm_allocation_granularity(),
-                          capacity);
+                          initial_size, capacity);
 
   // allocate PerfData memory region
-  create_memory_region(capacity);
+  create_memory_region(capacity, initial_size);
 
   if (_start == NULL) {
 
@@ -132,7 +136,7 @@ void PerfMemory::initialize() {
                             _capacity);
 
     _prologue = (PerfDataPrologue *)_start;
-    _end = _start + _capacity;
+    _end = _start + initial_size;
     _top = _start + sizeof(PerfDataPrologue);
   }
 
@@ -152,7 +156,7 @@ void PerfMemory::initialize() {
 
   _prologue->entry_offset = sizeof(PerfDataPrologue);
   _prologue->num_entries = 0;
-  _prologue->used = 0;
+  _prologue->used = (_start != NULL) ? (jint)used() : 0;
   _prologue->overflow = 0;
   _prologue->mod_time_stamp = 0;
 
@@ -208,28 +212,78 @@ char* PerfMemory::alloc(size_t size) {
 
   if (!UsePerfData) return NULL;
 
-  MutexLocker ml(PerfDataMemAlloc_lock);
-
   assert(is_usable(), "called before init or after destroy");
 
-  // check that there is enough memory for this request
-  if ((_top + size) >= _end) {
+  char* result = Atomic::load(&_top);
+  while (true) {
+    // check that there is enough memory for this request
+    if ((result + size) >= Atomic::load_acquire(&_end)) {
+      if (!expand(result + size)) {
+        Atomic::add(&_prologue->overflow, (jint)size);
+        return NULL;
+      }
+      result = Atomic::load(&_top);
+      continue;
+    }
+    char* prev = Atomic::cmpxchg(&_top, result, result + size);
+    if (prev == result) {
+      break;
+    }
+    result = prev;
+  }
 
-    _prologue->overflow += (jint)size;
+  assert(contains(result), "PerfData memory pointer out of range");
 
-    return NULL;
+  return result;
+}
+
+// Grows the usable part of the region past addr, in steps of the initial
+// size. Only the growing is serialized.
+bool PerfMemory::expand(char* addr) {
+  if (_start == NULL) {
+    return false;
   }
 
-  char* result = _top;
+  MutexLocker ml(PerfDataMemAlloc_lock);
 
-  _top += size;
+  size_t old_size = (size_t)(_end - _start);
+  if (addr < _end) {
+    // another thread grew the region
+    return true;
+  }
+  size_t needed = (size_t)(addr - _start) + 1;
+  if (needed > _capacity) {
+    return false;
+  }
+  size_t step = align_up(PerfDataMemorySize, os::vm_allocation_granularity());
+  size_t new_size = old_size;
+  while (new_size < needed) {
+    new_size += step;
+  }
+  new_size = MIN2(new_size, _capacity);
+  if (!expand_memory_region(old_size, new_size)) {
+    return false;
+  }
 
-  assert(contains(result), "PerfData memory pointer out of range");
+  log_debug(perf, memops)("PerfMemory expanded from " SIZE_FORMAT " to " SIZE_FORMAT " bytes",
+                          old_size, new_size);
+  Atomic::release_store(&_end, _start + new_size);
+  return true;
+}
 
-  _prologue->used = (jint)used();
-  _prologue->num_entries = _prologue->num_entries + 1;
+// The monitoring tools walk the entries up to num_entries, so an entry
+// is published only once it is initialized and all entries allocated
+// before it are published.
+void PerfMemory::publish(char* entry, size_t size) {
+  assert(contains(entry), "not a PerfData memory entry");
 
-  return result;
+  jint offset = (jint)(entry - _start);
+  SpinYield spin;
+  while (Atomic::load_acquire(&_prologue->used) != offset) {
+    spin.wait();
+  }
+  _prologue->num_entries = _prologue->num_entries + 1;
+  Atomic::release_store(&_prologue->used, offset + (jint)size);
 }
 
 void PerfMemory::mark_updated() {
@@ -124,8 +124,13 @@ class PerfMemory : AllStatic {
     static int    _initialized;
     static bool   _destroyed;
 
-    static void create_memory_region(size_t sizep);
+    // The region is reserved for size bytes, of which the first
+    // initial_size are usable.
+    static void create_memory_region(size_t size, size_t initial_size);
+    // Makes the first new_size bytes usable
+    static bool expand_memory_region(size_t old_size, size_t new_size);
     static void delete_memory_region();
+    static bool expand(char* addr);
 
   public:
     enum PerfMemoryMode {
@@ -133,7 +138,10 @@ class PerfMemory : AllStatic {
       PERF_MODE_RW = 1
     };
 
+    // Allocation is lock-free, and entries are published in the prologue
+    // in allocation order once they are initialized.
     static char* alloc(size_t size);
+    static void publish(char* entry, size_t size);
     static char* start() { return _start; }
     static char* end() { return _end; }
     static size_t used() { return (size_t) (_top - _start); }
@@ -142,7 +150,7 @@ class PerfMemory : AllStatic {
     static bool is_destroyed() { return _destroyed; }
     static bool is_usable() { return is_initialized() && !is_destroyed(); }
     static bool contains(char* addr) {
-      return ((_start != NULL) && (addr >= _start) && (addr < _end));
+      return ((_start != NULL) && (addr >= _start) && (addr < _start + _capacity));
     }
     static void mark_updated();
 
@@ -40,6 +40,7 @@
 #include "gc/shared/workgroup.hpp"
 #include "interpreter/interpreter.hpp"
 #include "jfr/jfrEvents.hpp"
+#include "jfr/support/jfrThreadId.hpp"
 #include "logging/log.hpp"
 #include "logging/logStream.hpp"
 #include "memory/resourceArea.hpp"
@@ -66,6 +67,7 @@
 #include "runtime/threadSMR.hpp"
 #include "runtime/threadWXSetters.inline.hpp"
 #include "runtime/timerTrace.hpp"
+#include "runtime/vframe.inline.hpp"
 #include "services/runtimeService.hpp"
 #include "utilities/events.hpp"
 #include "utilities/macros.hpp"
@@ -205,7 +207,8 @@ static void back_off(int64_t start_time) {
   }
 }
 
-int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int nof_threads, int* initial_running)
+int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, jlong straggler_limit_time,
+                                              int nof_threads, int* initial_running, int* stragglers)
 {
   JavaThreadIteratorWithHandle jtiwh;
 
@@ -250,6 +253,9 @@ int SafepointSynchronize::synchronize_threads(jlong safepoint_limit_time, int no
     if (SafepointTimeout && safepoint_limit_time < os::javaTimeNanos()) {
       print_safepoint_timeout();
     }
+    if (straggler_limit_time != 0 && *stragglers == 0 && straggler_limit_time < os::javaTimeNanos()) {
+      *stragglers = mark_stragglers(tss_head);
+    }
 
     p_prev = &tss_head;
     ThreadSafepointState *cur_tss = tss_head;
@@ -370,14 +376,22 @@ void SafepointSynchronize::begin() {
     timeout_error_printed = false;
   }
 
+  jlong straggler_limit_time = 0;
+  if (SafepointStragglerDelay > 0 &&
+      (log_is_enabled(Info, safepoint) || EventSafepointStragglers::is_enabled())) {
+    straggler_limit_time = SafepointTracing::start_of_safepoint() + (jlong)SafepointStragglerDelay * (NANOUNITS / MILLIUNITS);
+  }
+
   EventSafepointStateSynchronization sync_event;
   int initial_running = 0;
+  int stragglers = 0;
 
   // Arms the safepoint, _current_jni_active_count and _waiting_to_block must be set before.
   arm_safepoint();
 
   // Will spin until all threads are safe.
-  int iterations = synchronize_threads(safepoint_limit_time, nof_threads, &initial_running);
+  int iterations = synchronize_threads(safepoint_limit_time, straggler_limit_time, nof_threads,
+                                       &initial_running, &stragglers);
   assert(_waiting_to_block == 0, "No thread should be running");
 
 #ifndef PRODUCT
@@ -419,6 +433,10 @@ void SafepointSynchronize::begin() {
   // Update the count of active JNI critical regions
   GCLocker::set_jni_lock_count(_current_jni_active_count);
 
+  if (stragglers > 0) {
+    report_stragglers(stragglers);
+  }
+
   post_safepoint_synchronize_event(sync_event,
                                    _safepoint_id,
                                    initial_running,
@@ -560,6 +578,20 @@ public:
     return MAX2<uint>(1, workers);
   }
 
+  // Rehashing moves every entry of a table. Rather than leave that to a
+  // single cleanup worker, it is done on all workers before the cleanup.
+  static void rehash_tables(WorkGang* workers) {
+    if (SymbolTable::rehash_table_expects_safepoint_rehashing()) {
+      Tracer t("rehashing symbol table");
+      SymbolTable::rehash_table(workers);
+    }
+
+    if (StringTable::rehash_table_expects_safepoint_rehashing()) {
+      Tracer t("rehashing string table");
+      StringTable::rehash_table(workers);
+    }
+  }
+
   void work(uint worker_id) {
     // These tasks are ordered by relative length of time to execute so that potentially longer tasks start first.
     if (_subtasks.try_claim_task(SafepointSynchronize::SAFEPOINT_CLEANUP_SYMBOL_TABLE_REHASH)) {
@@ -619,8 +651,11 @@ void SafepointSynchronize::do_cleanup_tasks() {
 
   CollectedHeap* heap = Universe::heap();
   assert(heap != NULL, "heap not initialized yet?");
-  ParallelCleanupTask cleanup;
   WorkGang* cleanup_workers = heap->safepoint_workers();
+  if (cleanup_workers != nullptr) {
+    ParallelCleanupTask::rehash_tables(cleanup_workers);
+  }
+  ParallelCleanupTask cleanup;
   const uint expected_num_workers = cleanup.expected_num_workers();
   if (cleanup_workers != nullptr && expected_num_workers > 1) {
     // Parallel cleanup using GC provided thread pool.
@@ -831,11 +866,81 @@ void SafepointSynchronize::print_safepoint_timeout() {
   }
 }
 
+// Marks the threads still running, they are reported once synchronized.
+int SafepointSynchronize::mark_stragglers(ThreadSafepointState* tss_head) {
+  int count = 0;
+  for (ThreadSafepointState* cur_tss = tss_head; cur_tss != NULL; cur_tss = cur_tss->get_next()) {
+    cur_tss->set_straggler(true);
+    count++;
+  }
+  return count;
+}
+
+static void post_safepoint_stragglers_event(uint64_t safepoint_id, JavaThread* thread, int stragglers,
+                                            const Method* method, int bci, int line, bool at_poll) {
+  EventSafepointStragglers event;
+  if (event.should_commit()) {
+    event.set_safepointId(safepoint_id);
+    event.set_straggler(JFR_THREAD_ID(thread));
+    event.set_stragglerCount(stragglers);
+    event.set_method(method);
+    event.set_bci(bci);
+    event.set_lineNumber(line);
+    event.set_atPoll(at_poll);
+    event.commit();
+  }
+}
+
+// Reports where the stragglers stopped. A thread stopped at a poll in compiled
+// code is resolved through the PcDesc of the poll, which is typically right
+// after the loop or the long sequence of code that has no poll. Other threads
+// are reported with their top Java frame.
+void SafepointSynchronize::report_stragglers(int stragglers) {
+  assert(_state == _synchronized, "threads must be stopped");
+  ResourceMark rm;
+  for (JavaThreadIteratorWithHandle jtiwh; JavaThread *cur = jtiwh.next(); ) {
+    ThreadSafepointState* const cur_state = cur->safepoint_state();
+    if (!cur_state->is_straggler()) {
+      continue;
+    }
+    cur_state->set_straggler(false);
+
+    const Method* method = NULL;
+    int bci = -1;
+    address pc = NULL;
+    const bool at_poll = cur_state->is_at_poll_safepoint();
+    if (at_poll) {
+      pc = cur->saved_exception_pc();
+      CompiledMethod* const cm = CodeCache::find_compiled(pc);
+      if (cm != NULL && cm->pc_desc_at(pc) != NULL) {
+        ScopeDesc* const sd = cm->scope_desc_at(pc);
+        method = sd->method();
+        bci = sd->bci();
+      }
+    }
+    if (method == NULL && cur->has_last_Java_frame()) {
+      vframeStream vfs(cur, false /* stop_at_java_call_stub */, false /* process_frames */);
+      if (!vfs.at_end()) {
+        method = vfs.method();
+        bci = vfs.bci();
+      }
+    }
+    const int line = method != NULL ? method->line_number_from_bci(bci) : -1;
+
+    log_info(safepoint)("Straggler \"%s\" (" INTPTR_FORMAT ") delayed safepoint " UINT64_FORMAT
+                        " by more than " INTX_FORMAT " ms, stopped in %s @ %d (line %d)%s, pc " INTPTR_FORMAT,
+                        cur->name(), p2i(cur), _safepoint_id, SafepointStragglerDelay,
+                        method != NULL ? method->external_name() : "<unknown>", bci, line,
+                        at_poll ? " at poll" : "", p2i(pc));
+    post_safepoint_stragglers_event(_safepoint_id, cur, stragglers, method, bci, line, at_poll);
+  }
+}
+
 // -------------------------------------------------------------------------------------------------------
 // Implementation of ThreadSafepointState
 
 ThreadSafepointState::ThreadSafepointState(JavaThread *thread)
-  : _at_poll_safepoint(false), _thread(thread), _safepoint_safe(false),
+  : _at_poll_safepoint(false), _thread(thread), _safepoint_safe(false), _straggler(false),
     _safepoint_id(SafepointSynchronize::InactiveSafepointCounter), _next(NULL) {
 }
 
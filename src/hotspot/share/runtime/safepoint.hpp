@@ -111,10 +111,13 @@ class SafepointSynchronize : AllStatic {
 
   // For debug long safepoint
   static void print_safepoint_timeout();
+  static int mark_stragglers(ThreadSafepointState* tss_head);
+  static void report_stragglers(int stragglers);
 
   // Helper methods for safepoint procedure:
   static void arm_safepoint();
-  static int synchronize_threads(jlong safepoint_limit_time, int nof_threads, int* initial_running);
+  static int synchronize_threads(jlong safepoint_limit_time, jlong straggler_limit_time,
+                                 int nof_threads, int* initial_running, int* stragglers);
   static void disarm_safepoint();
   static void increment_jni_active_count();
   static void decrement_waiting_to_block();
@@ -203,6 +206,8 @@ class ThreadSafepointState: public CHeapObj<mtThread> {
   volatile bool                   _at_poll_safepoint;
   JavaThread*                     _thread;
   bool                            _safepoint_safe;
+  // Still running after SafepointStragglerDelay:
+  bool                            _straggler;
   volatile uint64_t               _safepoint_id;
 
   ThreadSafepointState*           _next;
@@ -232,6 +237,8 @@ class ThreadSafepointState: public CHeapObj<mtThread> {
   // Support for safepoint timeout (debugging)
   bool is_at_poll_safepoint()           { return _at_poll_safepoint; }
   void set_at_poll_safepoint(bool val)  { _at_poll_safepoint = val; }
+  bool is_straggler() const             { return _straggler; }
+  void set_straggler(bool val)          { _straggler = val; }
 
   void handle_polling_page_exception();
 
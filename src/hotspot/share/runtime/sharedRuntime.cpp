@@ -600,7 +600,7 @@ oop SharedRuntime::retrieve_receiver( Symbol* sig, frame caller ) {
 
 
 void SharedRuntime::throw_and_post_jvmti_exception(JavaThread* current, Handle h_exception) {
-  if (JvmtiExport::can_post_on_exceptions()) {
+  if (JvmtiExport::can_post_on_exceptions() && current->should_post_on_exceptions_flag()) {
     vframeStream vfst(current, true);
     methodHandle method = methodHandle(current, vfst.method());
     address bcp = method()->bcp_from(vfst.bci());
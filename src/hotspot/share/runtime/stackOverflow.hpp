@@ -51,6 +51,8 @@ class StackOverflow {
     _stack_guard_state(stack_guard_unused),
     _stack_overflow_limit(nullptr),
     _reserved_stack_activation(nullptr),  // stack base not known yet
+    _shadow_zone_safe_limit(nullptr),
+    _shadow_zone_growth_watermark(nullptr),
     _stack_base(nullptr), _stack_end(nullptr) {}
 
   // Initialization after thread is started.
@@ -58,6 +60,7 @@ class StackOverflow {
      _stack_base = base;
      _stack_end = end;
     set_stack_overflow_limit();
+    set_shadow_zone_limits();
     set_reserved_stack_activation(base);
   }
  private:
@@ -69,6 +72,13 @@ class StackOverflow {
   address          _stack_overflow_limit;
   address          _reserved_stack_activation;
 
+  // The interpreter bangs the shadow zone only when the stack pointer goes
+  // below the watermark, the lowest stack pointer it has banged the whole
+  // shadow zone from. The watermark is moved only while above the safe limit,
+  // below which a bang may hit the guard zone and must always be done.
+  address          _shadow_zone_safe_limit;
+  address          _shadow_zone_growth_watermark;
+
   // Support for stack overflow handling, copied down from thread.
   address          _stack_base;
   address          _stack_end;
@@ -242,6 +252,17 @@ class StackOverflow {
     _stack_overflow_limit =
       stack_end() + MAX2(stack_guard_zone_size(), stack_shadow_zone_size());
   }
+
+  void set_shadow_zone_limits() {
+    _shadow_zone_safe_limit =
+      stack_end() + stack_guard_zone_size() + stack_shadow_zone_size();
+    _shadow_zone_growth_watermark = stack_base();
+  }
+
+  address shadow_zone_safe_limit() const {
+    assert(_shadow_zone_safe_limit != nullptr, "Don't call this before the field is initialized.");
+    return _shadow_zone_safe_limit;
+  }
 };
 
 #endif // SHARE_RUNTIME_STACKOVERFLOW_HPP
@@ -35,9 +35,12 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/biasedLocking.hpp"
+#include "runtime/globals_extension.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/handshake.hpp"
 #include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/lockStack.inline.hpp"
+#include "runtime/monitorDeflationThread.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/objectMonitor.hpp"
 #include "runtime/objectMonitor.inline.hpp"
@@ -57,14 +60,27 @@
 #include "utilities/align.hpp"
 #include "utilities/dtrace.hpp"
 #include "utilities/events.hpp"
+#include "utilities/powerOfTwo.hpp"
 #include "utilities/preserveException.hpp"
 
-void MonitorList::add(ObjectMonitor* m) {
+void MonitorList::set_num_partitions(uint num_partitions) {
+  assert(count() == 0, "must be set before monitors are added");
+  assert(is_power_of_2(num_partitions) && num_partitions <= MaxPartitions,
+         "invalid number of partitions: %u", num_partitions);
+  _num_partitions = num_partitions;
+}
+
+void MonitorList::add(Thread* current, ObjectMonitor* m) {
+  // Thread addresses are aligned and far apart, so fold in the higher bits.
+  uintptr_t hash = p2i(current) >> 6;
+  hash ^= hash >> 9;
+  Partition* partition = &_partitions[hash & (_num_partitions - 1)];
+
   ObjectMonitor* head;
   do {
-    head = Atomic::load(&_head);
+    head = Atomic::load(&partition->_head);
     m->set_next_om(head);
-  } while (Atomic::cmpxchg(&_head, head, m) != head);
+  } while (Atomic::cmpxchg(&partition->_head, head, m) != head);
 
   size_t count = Atomic::add(&_count, 1u);
   if (count > max()) {
@@ -80,15 +96,17 @@ size_t MonitorList::max() const {
   return Atomic::load(&_max);
 }
 
-// Walk the in-use list and unlink deflated ObjectMonitors.
+// Walk a partition of the in-use list and unlink deflated ObjectMonitors.
 // Returns the number of unlinked ObjectMonitors.
-size_t MonitorList::unlink_deflated(Thread* current, LogStream* ls,
+size_t MonitorList::unlink_deflated(uint partition, Thread* current, LogStream* ls,
                                     elapsedTimer* timer_p,
                                     size_t deflated_count,
                                     GrowableArray<ObjectMonitor*>* unlinked_list) {
+  assert(partition < _num_partitions, "invalid partition: %u", partition);
+  ObjectMonitor* volatile* head = &_partitions[partition]._head;
   size_t unlinked_count = 0;
   ObjectMonitor* prev = nullptr;
-  ObjectMonitor* m = Atomic::load_acquire(&_head);
+  ObjectMonitor* m = Atomic::load_acquire(head);
 
   // The in-use list head can be null during the final audit.
   while (m != nullptr) {
@@ -110,7 +128,7 @@ size_t MonitorList::unlink_deflated(Thread* current, LogStream* ls,
           // Reached the max batch, so bail out of the gathering loop.
           break;
         }
-        if (prev == nullptr && Atomic::load(&_head) != m) {
+        if (prev == nullptr && Atomic::load(head) != m) {
           // Current batch used to be at head, but it is not at head anymore.
           // Bail out and figure out where we currently are. This avoids long
           // walks searching for new prev during unlink under heavy list inserts.
@@ -122,7 +140,7 @@ size_t MonitorList::unlink_deflated(Thread* current, LogStream* ls,
       if (prev == nullptr) {
         // The current batch is the first batch, so there is a chance that it starts at head.
         // Optimistically assume no inserts happened, and try to unlink the entire batch from the head.
-        ObjectMonitor* prev_head = Atomic::cmpxchg(&_head, m, next);
+        ObjectMonitor* prev_head = Atomic::cmpxchg(head, m, next);
         if (prev_head != m) {
           // Something must have updated the head. Figure out the actual prev for this batch.
           for (ObjectMonitor* n = prev_head; n != m; n = n->next_om()) {
@@ -134,7 +152,7 @@ size_t MonitorList::unlink_deflated(Thread* current, LogStream* ls,
       } else {
         // The current batch is preceded by another batch. This guarantees the current batch
         // does not start at head. Unlink the entire current batch without updating the head.
-        assert(Atomic::load(&_head) != m, "Sanity");
+        assert(Atomic::load(head) != m, "Sanity");
         prev->set_next_om(next);
       }
 
@@ -163,7 +181,7 @@ size_t MonitorList::unlink_deflated(Thread* current, LogStream* ls,
   // The code that runs after this unlinking does not expect deflated monitors.
   // Notably, attempting to deflate the already deflated monitor would break.
   {
-    ObjectMonitor* m = Atomic::load_acquire(&_head);
+    ObjectMonitor* m = Atomic::load_acquire(head);
     while (m != nullptr) {
       assert(!m->is_being_async_deflated(), "All deflated monitors should be unlinked");
       m = m->next_om();
@@ -176,12 +194,34 @@ size_t MonitorList::unlink_deflated(Thread* current, LogStream* ls,
 }
 
 MonitorList::Iterator MonitorList::iterator() const {
-  return Iterator(Atomic::load_acquire(&_head));
+  return Iterator(this, 0, _num_partitions - 1);
+}
+
+MonitorList::Iterator MonitorList::iterator(uint partition) const {
+  assert(partition < _num_partitions, "invalid partition: %u", partition);
+  return Iterator(this, partition, partition);
+}
+
+MonitorList::Iterator::Iterator(const MonitorList* list, uint first_partition,
+                                uint last_partition) :
+  _list(list),
+  _current(Atomic::load_acquire(&list->_partitions[first_partition]._head)),
+  _partition(first_partition),
+  _last_partition(last_partition) {
+  skip_empty_partitions();
+}
+
+void MonitorList::Iterator::skip_empty_partitions() {
+  while (_current == NULL && _partition < _last_partition) {
+    _partition++;
+    _current = Atomic::load_acquire(&_list->_partitions[_partition]._head);
+  }
 }
 
 ObjectMonitor* MonitorList::Iterator::next() {
   ObjectMonitor* current = _current;
   _current = current->next_om();
+  skip_empty_partitions();
   return current;
 }
 
@@ -246,6 +286,13 @@ int dtrace_waited_probe(ObjectMonitor* monitor, Handle obj, Thread* thr) {
 static const int NINFLATIONLOCKS = 256;
 static os::PlatformMutex* gInflationLocks[NINFLATIONLOCKS];
 
+// State shared by the MonitorDeflationThreads during a parallel
+// deflation cycle; see deflate_idle_monitors().
+static volatile uint _deflation_next_partition = 0;
+static volatile size_t _deflation_count = 0;
+// Per MonitorDeflationThread list of the ObjectMonitors it unlinked.
+static GrowableArray<ObjectMonitor*>** _deflation_unlinked_lists = NULL;
+
 void ObjectSynchronizer::initialize() {
   for (int i = 0; i < NINFLATIONLOCKS; i++) {
     gInflationLocks[i] = new os::PlatformMutex();
@@ -253,6 +300,21 @@ void ObjectSynchronizer::initialize() {
   // Start the ceiling with the estimate for one thread.
   set_in_use_list_ceiling(AvgMonitorsPerThreadEstimate);
 
+  // One in-use list partition per CPU, so that inflating threads rarely
+  // share a list head, and a parallel deflation has enough partitions to
+  // balance over the MonitorDeflationThreads.
+  uint ncpus = (uint)MAX2(os::initial_active_processor_count(), 1);
+  _in_use_list.set_num_partitions(MIN2(round_up_power_of_2(ncpus), MonitorList::MaxPartitions));
+  if (FLAG_IS_DEFAULT(MonitorDeflationThreads)) {
+    FLAG_SET_ERGO(MonitorDeflationThreads, clamp(ncpus / 8, 1u, 4u));
+  }
+  if (MonitorDeflationThreads > 1) {
+    _deflation_unlinked_lists = NEW_C_HEAP_ARRAY(GrowableArray<ObjectMonitor*>*, MonitorDeflationThreads, mtSynchronizer);
+    for (uint i = 0; i < MonitorDeflationThreads; i++) {
+      _deflation_unlinked_lists[i] = new (ResourceObj::C_HEAP, mtSynchronizer) GrowableArray<ObjectMonitor*>(0, mtSynchronizer);
+    }
+  }
+
   // Start the timer for deflations, so it does not trigger immediately.
   _last_async_deflation_time_ns = os::javaTimeNanos();
 }
@@ -307,13 +369,42 @@ static bool _no_progress_skip_increment = false;
 // the monitorexit operation.  In that case the JIT could fuse the operations
 // into a single notifyAndExit() runtime primitive.
 
+// Lightweight locking: returns true if obj is fast-locked by current.
+static bool is_fast_locked_by(markWord mark, oop obj, JavaThread* current) {
+  return UseLightweightLocking && mark.is_fast_locked() && current->lock_stack().contains(obj);
+}
+
+// Lightweight locking: try to fast-lock an unlocked obj by swinging its
+// lock bits to locked_value and pushing it on the lock stack of current.
+static bool fast_lock(oop obj, JavaThread* current) {
+  assert(UseLightweightLocking, "Only with lightweight locking");
+  LockStack& lock_stack = current->lock_stack();
+  if (lock_stack.is_full()) {
+    return false;
+  }
+  markWord mark = obj->mark_acquire();
+  while (mark.is_neutral()) {
+    // A failed CAS may also be caused by a concurrent hash installation,
+    // so retry until the lock state changes.
+    assert(!lock_stack.contains(obj), "thread must not already hold the lock");
+    markWord old_mark = obj->cas_set_mark(mark.set_fast_locked(), mark);
+    if (old_mark == mark) {
+      lock_stack.push(obj);
+      return true;
+    }
+    mark = old_mark;
+  }
+  return false;
+}
+
 bool ObjectSynchronizer::quick_notify(oopDesc* obj, JavaThread* current, bool all) {
   assert(current->thread_state() == _thread_in_Java, "invariant");
   NoSafepointVerifier nsv;
   if (obj == NULL) return false;  // slow-path for invalid obj
   const markWord mark = obj->mark();
 
-  if (mark.has_locker() && current->is_lock_owned((address)mark.locker())) {
+  if ((mark.has_locker() && current->is_lock_owned((address)mark.locker())) ||
+      is_fast_locked_by(mark, obj, current)) {
     // Degenerate notify
     // stack-locked by caller so by definition the implied waitset is empty.
     return true;
@@ -366,6 +457,13 @@ bool ObjectSynchronizer::quick_enter(oop obj, JavaThread* current,
 
   const markWord mark = obj->mark();
 
+  if (UseLightweightLocking && mark.is_neutral()) {
+    // Compiled code has no lightweight locking fast path and gets here
+    // first; fast-lock without a thread state transition.
+    lock->set_displaced_header(markWord::unused_mark());
+    return fast_lock(obj, current);
+  }
+
   if (mark.has_monitor()) {
     ObjectMonitor* const m = mark.monitor();
     // An async deflation or GC can race us before we manage to make
@@ -481,7 +579,16 @@ void ObjectSynchronizer::enter(Handle obj, BasicLock* lock, JavaThread* current)
   markWord mark = obj->mark();
   assert(!mark.has_bias_pattern(), "should not see bias pattern here");
 
-  if (mark.is_neutral()) {
+  if (UseLightweightLocking) {
+    // Lightweight locking does not use the BasicLock. Make it look like
+    // the lock uses a heavyweight monitor so stack walkers ignore it.
+    lock->set_displaced_header(markWord::unused_mark());
+    if (fast_lock(obj(), current)) {
+      return;
+    }
+    // Recursive locking, contention and a full lock stack fall through
+    // to inflate() ...
+  } else if (mark.is_neutral()) {
     // Anticipate successful CAS -- the ST of the displaced mark must
     // be visible <= the ST performed by the CAS.
     lock->set_displaced_header(mark);
@@ -515,6 +622,34 @@ void ObjectSynchronizer::enter(Handle obj, BasicLock* lock, JavaThread* current)
 
 void ObjectSynchronizer::exit(oop object, BasicLock* lock, JavaThread* current) {
   markWord mark = object->mark();
+  if (UseLightweightLocking) {
+    if (mark.is_fast_locked()) {
+      assert(current->lock_stack().contains(object), "must be fast-locked by current");
+      markWord old_mark = object->cas_set_mark(mark.set_unlocked(), mark);
+      while (old_mark != mark && old_mark.is_fast_locked()) {
+        // A hash was installed in the header while we held the lock
+        mark = old_mark;
+        old_mark = object->cas_set_mark(mark.set_unlocked(), mark);
+      }
+      current->lock_stack().remove(object);
+      if (old_mark != mark) {
+        // Another thread inflated the lock while it was on our lock
+        // stack. Claim the anonymously owned monitor and exit it so the
+        // contending threads are woken up.
+        assert(old_mark.has_monitor(), "must have monitor");
+        ObjectMonitor* monitor = old_mark.monitor();
+        assert(monitor->is_owner_anonymous(), "must be anonymous owner");
+        monitor->set_owner_from_anonymous(current);
+        monitor->exit(current);
+      }
+      return;
+    }
+    // The monitor can't be async deflated until ownership is dropped
+    // inside exit(); inflate() claims it if it is anonymously owned.
+    ObjectMonitor* monitor = inflate(current, object, inflate_cause_vm_internal);
+    monitor->exit(current);
+    return;
+  }
   // We cannot check for Biased Locking if we are racing an inflation.
   assert(mark == markWord::INFLATING() ||
          !mark.has_bias_pattern(), "should not see bias pattern here");
@@ -726,7 +861,8 @@ void ObjectSynchronizer::notify(Handle obj, TRAPS) {
   }
 
   markWord mark = obj->mark();
-  if (mark.has_locker() && current->is_lock_owned((address)mark.locker())) {
+  if ((mark.has_locker() && current->is_lock_owned((address)mark.locker())) ||
+      is_fast_locked_by(mark, obj(), current)) {
     // Not inflated so there can't be any waiters to notify.
     return;
   }
@@ -745,7 +881,8 @@ void ObjectSynchronizer::notifyall(Handle obj, TRAPS) {
   }
 
   markWord mark = obj->mark();
-  if (mark.has_locker() && current->is_lock_owned((address)mark.locker())) {
+  if ((mark.has_locker() && current->is_lock_owned((address)mark.locker())) ||
+      is_fast_locked_by(mark, obj(), current)) {
     // Not inflated so there can't be any waiters to notify.
     return;
   }
@@ -930,10 +1067,10 @@ intptr_t ObjectSynchronizer::FastHashCode(Thread* current, oop obj) {
       if (test == mark) {                  // if the hash was installed, return it
         return hash;
       }
-      // Failed to install the hash. It could be that another thread
-      // installed the hash just before our attempt or inflation has
-      // occurred or... so we fall thru to inflate the monitor for
-      // stability and then install the hash.
+      // Failed to install the hash. Another thread installed a hash or
+      // locked the object just before our attempt, so look at the new
+      // header instead of inflating.
+      continue;
     } else if (mark.has_monitor()) {
       monitor = mark.monitor();
       temp = monitor->header();
@@ -961,7 +1098,25 @@ intptr_t ObjectSynchronizer::FastHashCode(Thread* current, oop obj) {
       }
       // Fall thru so we only have one place that installs the hash in
       // the ObjectMonitor.
-    } else if (current->is_Java_thread()
+    } else if (UseLightweightLocking) {
+      if (mark.is_fast_locked()) {
+        // The mark word of a fast-locked object is the unlocked header,
+        // so a hash can be read from it whoever owns the lock.
+        hash = mark.hash();
+        if (hash != 0) {
+          return hash;
+        }
+        // Install the hash in the locked header. The owner unlocks by
+        // clearing the lock bits of whatever header it finds, see exit().
+        hash = get_next_hash(current, obj);
+        temp = mark.copy_set_hash(hash);
+        test = obj->cas_set_mark(temp, mark);
+        if (test == mark) {
+          return hash;
+        }
+        continue;
+      }
+    } else if (mark.has_locker() && current->is_Java_thread()
                && current->as_Java_thread()->is_lock_owned((address)mark.locker())) {
       // This is a stack lock owned by the calling thread so fetch the
       // displaced markWord from the BasicLock on the stack.
@@ -1043,11 +1198,18 @@ bool ObjectSynchronizer::current_thread_holds_lock(JavaThread* current,
   if (mark.has_locker()) {
     return current->is_lock_owned((address)mark.locker());
   }
+  // Uncontended case, object on the lock stack of its owner
+  if (UseLightweightLocking && mark.is_fast_locked()) {
+    return current->lock_stack().contains(obj);
+  }
   // Contended case, header points to ObjectMonitor (tagged pointer)
   if (mark.has_monitor()) {
     // The first stage of async deflation does not affect any field
     // used by this comparison so the ObjectMonitor* is usable here.
     ObjectMonitor* monitor = mark.monitor();
+    if (UseLightweightLocking && monitor->is_owner_anonymous()) {
+      return current->lock_stack().contains(obj);
+    }
     return monitor->is_entered(current) != 0;
   }
   // Unlocked case, header in place
@@ -1076,12 +1238,20 @@ JavaThread* ObjectSynchronizer::get_lock_owner(ThreadsList * t_list, Handle h_ob
     owner = (address) mark.locker();
   }
 
+  // Uncontended case, object on the lock stack of its owner
+  else if (UseLightweightLocking && mark.is_fast_locked()) {
+    return Threads::owning_thread_from_object(t_list, obj);
+  }
+
   // Contended case, header points to ObjectMonitor (tagged pointer)
   else if (mark.has_monitor()) {
     // The first stage of async deflation does not affect any field
     // used by this comparison so the ObjectMonitor* is usable here.
     ObjectMonitor* monitor = mark.monitor();
     assert(monitor != NULL, "monitor should be non-null");
+    if (UseLightweightLocking && monitor->is_owner_anonymous()) {
+      return Threads::owning_thread_from_object(t_list, obj);
+    }
     owner = (address) monitor->owner();
   }
 
@@ -1292,6 +1462,7 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* current, oop object,
     // The mark can be in one of the following states:
     // *  Inflated     - just return
     // *  Stack-locked - coerce it to inflated
+    // *  Fast-locked  - coerce it to inflated (lightweight locking)
     // *  INFLATING    - busy wait for conversion to complete
     // *  Neutral      - aggressively inflate the object.
     // *  BIASED       - Illegal.  We should never see this
@@ -1301,16 +1472,62 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* current, oop object,
       ObjectMonitor* inf = mark.monitor();
       markWord dmw = inf->header();
       assert(dmw.is_neutral(), "invariant: header=" INTPTR_FORMAT, dmw.value());
+      if (UseLightweightLocking && inf->is_owner_anonymous() &&
+          current->is_Java_thread() && current->as_Java_thread()->lock_stack().contains(object)) {
+        // Inflated by another thread while on our lock stack: claim it.
+        inf->set_owner_from_anonymous(current);
+        current->as_Java_thread()->lock_stack().remove(object);
+      }
       return inf;
     }
 
-    // CASE: inflation in progress - inflating over a stack-lock.
-    // Some other thread is converting from stack-locked to inflated.
-    // Only that thread can complete inflation -- other threads must wait.
-    // The INFLATING value is transient.
-    // Currently, we spin/yield/park and poll the markword, waiting for inflation to finish.
-    // We could always eliminate polling by parking the thread on some auxiliary list.
-    if (mark == markWord::INFLATING()) {
+    LogStreamHandle(Trace, monitorinflation) lsh;
+
+    // CASE: fast-locked (lightweight locking)
+    // Could be fast-locked either by this thread or by some other thread.
+    // There is no displaced header to fetch, so the mark word is swung
+    // directly from fast-locked to inflated. If another thread owns the
+    // lock the monitor is owned anonymously until the owner claims it.
+    if (UseLightweightLocking) {
+      if (mark.is_fast_locked()) {
+        ObjectMonitor* m = new ObjectMonitor(object);
+        m->set_header(mark.set_unlocked());
+        bool own = current->is_Java_thread() && current->as_Java_thread()->lock_stack().contains(object);
+        if (own) {
+          m->set_owner_from(NULL, current);
+        } else {
+          m->set_owner_anonymous();
+        }
+        if (object->cas_set_mark(markWord::encode(m), mark) != mark) {
+          delete m;
+          continue;       // Interference -- just retry
+        }
+        if (own) {
+          current->as_Java_thread()->lock_stack().remove(object);
+        }
+        // Once ObjectMonitor is configured and the object is associated
+        // with the ObjectMonitor, it is safe to allow async deflation:
+        _in_use_list.add(current, m);
+
+        OM_PERFDATA_OP(Inflations, inc());
+        if (log_is_enabled(Trace, monitorinflation)) {
+          ResourceMark rm(current);
+          lsh.print_cr("inflate(fast_locked): object=" INTPTR_FORMAT ", mark="
+                       INTPTR_FORMAT ", type='%s'", p2i(object),
+                       object->mark().value(), object->klass()->external_name());
+        }
+        if (event.should_commit()) {
+          post_monitor_inflate_event(&event, object, cause);
+        }
+        return m;
+      }
+    } else if (mark == markWord::INFLATING()) {
+      // CASE: inflation in progress - inflating over a stack-lock.
+      // Some other thread is converting from stack-locked to inflated.
+      // Only that thread can complete inflation -- other threads must wait.
+      // The INFLATING value is transient.
+      // Currently, we spin/yield/park and poll the markword, waiting for inflation to finish.
+      // We could always eliminate polling by parking the thread on some auxiliary list.
       read_stable_mark(object);
       continue;
     }
@@ -1325,8 +1542,6 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* current, oop object,
     // the interval in which INFLATING appeared in the mark, thus increasing
     // the odds of inflation contention.
 
-    LogStreamHandle(Trace, monitorinflation) lsh;
-
     if (mark.has_locker()) {
       ObjectMonitor* m = new ObjectMonitor(object);
       // Optimistically prepare the ObjectMonitor - anticipate successful CAS
@@ -1393,7 +1608,7 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* current, oop object,
 
       // Once ObjectMonitor is configured and the object is associated
       // with the ObjectMonitor, it is safe to allow async deflation:
-      _in_use_list.add(m);
+      _in_use_list.add(current, m);
 
       // Hopefully the performance counters are allocated on distinct cache lines
       // to avoid false sharing on MP systems ...
@@ -1437,7 +1652,7 @@ ObjectMonitor* ObjectSynchronizer::inflate(Thread* current, oop object,
 
     // Once the ObjectMonitor is configured and object is associated
     // with the ObjectMonitor, it is safe to allow async deflation:
-    _in_use_list.add(m);
+    _in_use_list.add(current, m);
 
     // Hopefully the performance counters are allocated on distinct
     // cache lines to avoid false sharing on MP systems ...
@@ -1484,15 +1699,18 @@ void ObjectSynchronizer::chk_for_block_req(JavaThread* current, const char* op_n
   }
 }
 
-// Walk the in-use list and deflate (at most MonitorDeflationMax) idle
-// ObjectMonitors. Returns the number of deflated ObjectMonitors.
-size_t ObjectSynchronizer::deflate_monitor_list(Thread* current, LogStream* ls,
-                                                elapsedTimer* timer_p) {
-  MonitorList::Iterator iter = _in_use_list.iterator();
+// Walk a partition of the in-use list and deflate (at most max_count) idle
+// ObjectMonitors, then unlink them to unlinked_list. Returns the number of
+// deflated ObjectMonitors.
+size_t ObjectSynchronizer::deflate_partition(uint partition, size_t max_count,
+                                             Thread* current, LogStream* ls,
+                                             elapsedTimer* timer_p,
+                                             GrowableArray<ObjectMonitor*>* unlinked_list) {
+  MonitorList::Iterator iter = _in_use_list.iterator(partition);
   size_t deflated_count = 0;
 
   while (iter.has_next()) {
-    if (deflated_count >= (size_t)MonitorDeflationMax) {
+    if (deflated_count >= max_count) {
       break;
     }
     ObjectMonitor* mid = iter.next();
@@ -1507,9 +1725,69 @@ size_t ObjectSynchronizer::deflate_monitor_list(Thread* current, LogStream* ls,
     }
   }
 
+  if (deflated_count > 0 || is_final_audit()) {
+    // There are ObjectMonitors that have been deflated or this is the
+    // final audit and all the remaining ObjectMonitors have been
+    // deflated, BUT the MonitorDeflationThread blocked for the final
+    // safepoint during unlinking.
+    _in_use_list.unlink_deflated(partition, current, ls, timer_p,
+                                 deflated_count, unlinked_list);
+  }
+
   return deflated_count;
 }
 
+// Deflate (at most MonitorDeflationMax) idle ObjectMonitors in all the
+// partitions of the in-use list and unlink them to unlinked_list.
+// Returns the number of deflated ObjectMonitors.
+size_t ObjectSynchronizer::deflate_monitor_list(Thread* current, LogStream* ls,
+                                                elapsedTimer* timer_p,
+                                                GrowableArray<ObjectMonitor*>* unlinked_list) {
+  size_t deflated_count = 0;
+  for (uint i = 0; i < _in_use_list.num_partitions(); i++) {
+    if (deflated_count >= (size_t)MonitorDeflationMax) {
+      break;
+    }
+    deflated_count += deflate_partition(i, MonitorDeflationMax - deflated_count,
+                                        current, ls, timer_p, unlinked_list);
+  }
+  return deflated_count;
+}
+
+// Run by each of the MonitorDeflationThreads: claim partitions of the
+// in-use list until all are done or MonitorDeflationMax is reached.
+void ObjectSynchronizer::parallel_deflation_work(uint worker_id) {
+  Thread* current = Thread::current();
+  GrowableArray<ObjectMonitor*>* unlinked_list = _deflation_unlinked_lists[worker_id];
+  uint partition;
+  while ((partition = Atomic::fetch_and_add(&_deflation_next_partition, 1u)) <
+         _in_use_list.num_partitions()) {
+    size_t deflated_count = Atomic::load(&_deflation_count);
+    if (deflated_count >= (size_t)MonitorDeflationMax) {
+      break;
+    }
+    deflated_count = deflate_partition(partition, MonitorDeflationMax - deflated_count,
+                                       current, NULL, NULL, unlinked_list);
+    Atomic::add(&_deflation_count, deflated_count);
+  }
+}
+
+// Run by each of the MonitorDeflationThreads after the handshake: free
+// the ObjectMonitors the thread unlinked in parallel_deflation_work().
+void ObjectSynchronizer::parallel_deletion_work(uint worker_id) {
+  JavaThread* current = JavaThread::current();
+  GrowableArray<ObjectMonitor*>* unlinked_list = _deflation_unlinked_lists[worker_id];
+  size_t deleted_count = 0;
+  for (ObjectMonitor* monitor: *unlinked_list) {
+    delete monitor;
+    deleted_count++;
+
+    // A JavaThread must check for a safepoint/handshake and honor it.
+    chk_for_block_req(current, "deletion", "deleted_count", deleted_count, NULL, NULL);
+  }
+  unlinked_list->clear_and_deallocate();
+}
+
 class HandshakeForDeflation : public HandshakeClosure {
  public:
   HandshakeForDeflation() : HandshakeClosure("HandshakeForDeflation") {}
@@ -1540,6 +1818,7 @@ size_t ObjectSynchronizer::deflate_idle_monitors() {
     ls = &lsh_info;
   }
 
+  jlong start_ticks = os::elapsed_counter();
   elapsedTimer timer;
   if (ls != NULL) {
     ls->print_cr("begin deflating: in_use_list stats: ceiling=" SIZE_FORMAT ", count=" SIZE_FORMAT ", max=" SIZE_FORMAT,
@@ -1547,20 +1826,29 @@ size_t ObjectSynchronizer::deflate_idle_monitors() {
     timer.start();
   }
 
-  // Deflate some idle ObjectMonitors.
-  size_t deflated_count = deflate_monitor_list(current, ls, &timer);
-  if (deflated_count > 0 || is_final_audit()) {
-    // There are ObjectMonitors that have been deflated or this is the
-    // final audit and all the remaining ObjectMonitors have been
-    // deflated, BUT the MonitorDeflationThread blocked for the final
-    // safepoint during unlinking.
+  // The MonitorDeflationThreads deflate, unlink and delete in parallel.
+  // The VMThread does the final audit on its own.
+  const bool parallel = MonitorDeflationThreads > 1 && current->is_monitor_deflation_thread();
+
+  // Deflate some idle ObjectMonitors and unlink them from the in-use list.
+  ResourceMark rm;
+  GrowableArray<ObjectMonitor*> delete_list;
+  size_t deflated_count;
+  size_t unlinked_count = 0;
+  if (parallel) {
+    Atomic::store(&_deflation_next_partition, 0u);
+    Atomic::store(&_deflation_count, (size_t)0);
+    MonitorDeflationThread::run_task(current->as_Java_thread(), parallel_deflation_work);
+    deflated_count = Atomic::load(&_deflation_count);
+    for (uint i = 0; i < MonitorDeflationThreads; i++) {
+      unlinked_count += _deflation_unlinked_lists[i]->length();
+    }
+  } else {
+    deflated_count = deflate_monitor_list(current, ls, &timer, &delete_list);
+    unlinked_count = delete_list.length();
+  }
 
-    // Unlink deflated ObjectMonitors from the in-use list.
-    ResourceMark rm;
-    GrowableArray<ObjectMonitor*> delete_list((int)deflated_count);
-    size_t unlinked_count = _in_use_list.unlink_deflated(current, ls, &timer,
-                                                         deflated_count,
-                                                         &delete_list);
+  if (unlinked_count > 0) {
     if (current->is_Java_thread()) {
       if (ls != NULL) {
         timer.stop();
@@ -1588,15 +1876,19 @@ size_t ObjectSynchronizer::deflate_idle_monitors() {
 
     // After the handshake, safely free the ObjectMonitors that were
     // deflated in this cycle.
-    size_t deleted_count = 0;
-    for (ObjectMonitor* monitor: delete_list) {
-      delete monitor;
-      deleted_count++;
-
-      if (current->is_Java_thread()) {
-        // A JavaThread must check for a safepoint/handshake and honor it.
-        chk_for_block_req(current->as_Java_thread(), "deletion", "deleted_count",
-                          deleted_count, ls, &timer);
+    if (parallel) {
+      MonitorDeflationThread::run_task(current->as_Java_thread(), parallel_deletion_work);
+    } else {
+      size_t deleted_count = 0;
+      for (ObjectMonitor* monitor: delete_list) {
+        delete monitor;
+        deleted_count++;
+
+        if (current->is_Java_thread()) {
+          // A JavaThread must check for a safepoint/handshake and honor it.
+          chk_for_block_req(current->as_Java_thread(), "deletion", "deleted_count",
+                            deleted_count, ls, &timer);
+        }
       }
     }
   }
@@ -1613,6 +1905,8 @@ size_t ObjectSynchronizer::deflate_idle_monitors() {
 
   OM_PERFDATA_OP(MonExtant, set_value(_in_use_list.count()));
   OM_PERFDATA_OP(Deflations, inc(deflated_count));
+  OM_PERFDATA_OP(DeflationCycles, inc());
+  OM_PERFDATA_OP(DeflationTime, inc(os::elapsed_counter() - start_ticks));
 
   GVars.stw_random = os::random();
 
@@ -35,31 +35,59 @@ class LogStream;
 class ObjectMonitor;
 class ThreadsList;
 
+// The in-use list of ObjectMonitors is split into partitions so that
+// inflating threads do not all CAS the same list head and so that the
+// MonitorDeflationThreads can deflate and unlink partitions in parallel.
+// A monitor is added to the partition picked by the inflating thread.
 class MonitorList {
   friend class VMStructs;
 
+public:
+  static const uint MaxPartitions = 64;
+
 private:
-  ObjectMonitor* volatile _head;
+  struct Partition {
+    ObjectMonitor* volatile _head;
+    DEFINE_PAD_MINUS_SIZE(0, DEFAULT_CACHE_LINE_SIZE, sizeof(ObjectMonitor*));
+
+    Partition() : _head(NULL) {}
+  };
+
+  Partition _partitions[MaxPartitions];
+  uint _num_partitions;
   volatile size_t _count;
   volatile size_t _max;
 
 public:
-  void add(ObjectMonitor* monitor);
-  size_t unlink_deflated(Thread* current, LogStream* ls, elapsedTimer* timer_p,
-                         size_t deflated_count,
+  MonitorList() : _num_partitions(1), _count(0), _max(0) {}
+
+  // Must be called before there are any monitors in the list.
+  void set_num_partitions(uint num_partitions);
+  uint num_partitions() const { return _num_partitions; }
+
+  void add(Thread* current, ObjectMonitor* monitor);
+  size_t unlink_deflated(uint partition, Thread* current, LogStream* ls,
+                         elapsedTimer* timer_p, size_t deflated_count,
                          GrowableArray<ObjectMonitor*>* unlinked_list);
   size_t count() const;
   size_t max() const;
 
   class Iterator;
+  // Iterates over all partitions.
   Iterator iterator() const;
+  Iterator iterator(uint partition) const;
 };
 
 class MonitorList::Iterator {
+  const MonitorList* _list;
   ObjectMonitor* _current;
+  uint _partition;
+  uint _last_partition;
+
+  void skip_empty_partitions();
 
 public:
-  Iterator(ObjectMonitor* head) : _current(head) {}
+  Iterator(const MonitorList* list, uint first_partition, uint last_partition);
   bool has_next() const { return _current != NULL; }
   ObjectMonitor* next();
 };
@@ -148,7 +176,14 @@ class ObjectSynchronizer : AllStatic {
                                 const char* cnt_name, size_t cnt, LogStream* ls,
                                 elapsedTimer* timer_p);
   static size_t deflate_monitor_list(Thread* current, LogStream* ls,
-                                     elapsedTimer* timer_p);
+                                     elapsedTimer* timer_p,
+                                     GrowableArray<ObjectMonitor*>* unlinked_list);
+  static size_t deflate_partition(uint partition, size_t max_count,
+                                  Thread* current, LogStream* ls,
+                                  elapsedTimer* timer_p,
+                                  GrowableArray<ObjectMonitor*>* unlinked_list);
+  static void parallel_deflation_work(uint worker_id);
+  static void parallel_deletion_work(uint worker_id);
   static size_t in_use_list_ceiling();
   static void dec_in_use_list_ceiling();
   static void inc_in_use_list_ceiling();
@@ -28,6 +28,7 @@
 #include "cds/dynamicArchive.hpp"
 #include "cds/metaspaceShared.hpp"
 #include "classfile/classLoader.hpp"
+#include "classfile/classPreloader.hpp"
 #include "classfile/javaClasses.hpp"
 #include "classfile/javaThreadStatus.hpp"
 #include "classfile/systemDictionary.hpp"
@@ -35,9 +36,11 @@
 #include "classfile/vmSymbols.hpp"
 #include "code/codeCache.hpp"
 #include "code/scopeDesc.hpp"
+#include "compiler/compilationRecorder.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compileTask.hpp"
 #include "compiler/compilerThread.hpp"
+#include "gc/shared/allocationSiteSampler.hpp"
 #include "gc/shared/barrierSet.hpp"
 #include "gc/shared/collectedHeap.hpp"
 #include "gc/shared/gcId.hpp"
@@ -90,10 +93,11 @@
 #include "runtime/javaCalls.hpp"
 #include "runtime/jniHandles.inline.hpp"
 #include "runtime/jniPeriodicChecker.hpp"
+#include "runtime/lockStack.inline.hpp"
 #include "runtime/monitorDeflationThread.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/nonJavaThread.hpp"
-#include "runtime/objectMonitor.hpp"
+#include "runtime/objectMonitor.inline.hpp"
 #include "runtime/orderAccess.hpp"
 #include "runtime/osThread.hpp"
 #include "runtime/prefetch.inline.hpp"
@@ -150,6 +154,10 @@
 #if INCLUDE_JFR
 #include "jfr/jfr.hpp"
 #endif
+#ifdef LINUX
+#include "memoryPressure_linux.hpp"
+#include "osContainer_linux.hpp"
+#endif
 
 // Initialization after module runtime initialization
 void universe_post_module_init();  // must happen after call_initPhase2
@@ -268,6 +276,8 @@ Thread::Thread() {
   NOT_PRODUCT(_skip_gcalot = false;)
   _jvmti_env_iteration_count = 0;
   set_allocated_bytes(0);
+  _allocation_sites = NULL;
+  _nmt_bytes_until_sample = 0;
   _current_pending_raw_monitor = NULL;
 
   // thread-specific hashCode stream generator state - Marsaglia shift-xor form
@@ -444,6 +454,10 @@ Thread::~Thread() {
 
   delete handle_area();
   delete metadata_handles();
+  delete _allocation_sites;
+
+  // Hand the chunks freed above to the shared pools
+  _chunk_cache.flush();
 
   // osthread() can be NULL, if creation of thread failed.
   if (osthread() != NULL) os::free_thread(osthread());
@@ -1979,6 +1993,8 @@ void JavaThread::oops_do_no_frames(OopClosure* f, CodeBlobClosure* cf) {
   f->do_oop((oop*) &_jvmci_reserved_oop0);
 #endif
 
+  _lock_stack.oops_do(f);
+
   if (jvmti_thread_state() != NULL) {
     jvmti_thread_state()->oops_do(f, cf);
   }
@@ -3044,6 +3060,8 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   // cache the system and platform class loaders
   SystemDictionary::compute_java_loaders(CHECK_JNI_ERR);
 
+  ClassPreloader::initialize(CHECK_JNI_ERR);
+
 #if INCLUDE_CDS
   // capture the module path info from the ModuleEntryTable
   ClassLoader::initialize_module_path(THREAD);
@@ -3060,10 +3078,15 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   }
 #endif
 
+  CompilationRecorder::initialize(CHECK_JNI_ERR);
+
   if (NativeHeapTrimmer::enabled()) {
     NativeHeapTrimmer::initialize();
   }
 
+  LINUX_ONLY(OSContainer::init_watcher();)
+  LINUX_ONLY(MemoryPressureMonitor::initialize();)
+
   // Always call even when there are not JVMTI environments yet, since environments
   // may be attached late and JVMTI must track phases of VM execution
   JvmtiExport::enter_live_phase();
@@ -3746,6 +3769,23 @@ JavaThread *Threads::owning_thread_from_monitor_owner(ThreadsList * t_list,
   return the_owner;
 }
 
+JavaThread* Threads::owning_thread_from_object(ThreadsList * t_list, oop obj) {
+  assert(UseLightweightLocking, "Only with lightweight locking");
+  DO_JAVA_THREADS(t_list, q) {
+    if (q->lock_stack().contains(obj)) {
+      return q;
+    }
+  }
+  return NULL;
+}
+
+JavaThread* Threads::owning_thread_from_monitor(ThreadsList* t_list, ObjectMonitor* monitor) {
+  if (UseLightweightLocking && monitor->is_owner_anonymous()) {
+    return owning_thread_from_object(t_list, monitor->object());
+  }
+  return owning_thread_from_monitor_owner(t_list, (address)monitor->owner());
+}
+
 class PrintOnClosure : public ThreadClosure {
 private:
   outputStream* _st;
@@ -3809,6 +3849,61 @@ void Threads::print_on(outputStream* st, bool print_stacks,
   st->flush();
 }
 
+class PrintThreadHandshakeClosure : public HandshakeClosure {
+  stringStream* _st;
+  bool _print_extended_info;
+  bool _executed;
+ public:
+  PrintThreadHandshakeClosure(stringStream* st, bool print_extended_info) :
+    HandshakeClosure("PrintThread"),
+    _st(st), _print_extended_info(print_extended_info), _executed(false) {}
+
+  void do_thread(Thread* thread) {
+    JavaThread* jt = thread->as_Java_thread();
+    ResourceMark rm;
+    jt->print_on(_st, _print_extended_info);
+    jt->print_stack_on(_st);
+    _executed = true;
+  }
+
+  bool executed() const { return _executed; }
+};
+
+// Threads::print_on_with_handshakes() prints the same dump as print_on()
+// without concurrent locks, but stops only one Java thread at a time. Each
+// stack is consistent, while monitors may change owners between threads.
+void Threads::print_on_with_handshakes(outputStream* st, bool print_extended_info) {
+  char buf[32];
+  st->print_raw_cr(os::local_time_string(buf, sizeof(buf)));
+
+  st->print_cr("Full thread dump %s (%s %s):",
+               VM_Version::vm_name(),
+               VM_Version::vm_release(),
+               VM_Version::vm_info_string());
+  st->print_cr("Threads were printed one at a time in handshakes;"
+               " lock ownership between threads is best-effort.");
+  st->cr();
+
+  ThreadsSMRSupport::print_info_on(st);
+  st->cr();
+
+  ThreadsListHandle tlh;
+  for (uint i = 0; i < tlh.length(); i++) {
+    stringStream ss;
+    PrintThreadHandshakeClosure cl(&ss, print_extended_info);
+    Handshake::execute(&cl, tlh.thread_at(i));
+    // A thread that exited meanwhile is left out
+    if (cl.executed()) {
+      st->print_raw(ss.base(), ss.size());
+      st->cr();
+    }
+  }
+
+  PrintOnClosure cl(st);
+  non_java_threads_do(&cl);
+  st->flush();
+}
+
 void Threads::print_on_error(Thread* this_thread, outputStream* st, Thread* current, char* buf,
                              int buflen, bool* found_current) {
   if (this_thread != NULL) {
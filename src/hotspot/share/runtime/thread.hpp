@@ -30,12 +30,14 @@
 #include "gc/shared/gcThreadLocalData.hpp"
 #include "gc/shared/threadLocalAllocBuffer.hpp"
 #include "memory/allocation.hpp"
+#include "memory/arena.hpp"
 #include "oops/oop.hpp"
 #include "oops/oopHandle.hpp"
 #include "runtime/frame.hpp"
 #include "runtime/globals.hpp"
 #include "runtime/handshake.hpp"
 #include "runtime/javaFrameAnchor.hpp"
+#include "runtime/lockStack.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "runtime/park.hpp"
@@ -54,6 +56,7 @@
 #include "jfr/support/jfrThreadExtension.hpp"
 #endif
 
+class AllocationSiteTable;
 class SafeThreadsListPtr;
 class ThreadSafepointState;
 class ThreadsList;
@@ -289,6 +292,8 @@ class Thread: public ThreadShadow {
   jlong _allocated_bytes;                       // Cumulative number of bytes allocated on
                                                 // the Java heap
   ThreadHeapSampler _heap_sampler;              // For use when sampling the memory.
+  AllocationSiteTable* _allocation_sites;       // Sampled allocation sites, see AllocationSiteSampling
+  size_t _nmt_bytes_until_sample;               // See NativeMemoryTrackingSampleInterval
 
   ThreadStatisticalInfo _statistical_info;      // Statistics about the thread
 
@@ -415,6 +420,8 @@ class Thread: public ThreadShadow {
   ResourceArea* resource_area() const            { return _resource_area; }
   void set_resource_area(ResourceArea* area)     { _resource_area = area; }
 
+  ChunkCache* chunk_cache()                      { return &_chunk_cache; }
+
   OSThread* osthread() const                     { return _osthread;   }
   void set_osthread(OSThread* thread)            { _osthread = thread; }
 
@@ -442,6 +449,11 @@ class Thread: public ThreadShadow {
 
   ThreadHeapSampler& heap_sampler()     { return _heap_sampler; }
 
+  AllocationSiteTable* allocation_sites() const           { return _allocation_sites; }
+  void set_allocation_sites(AllocationSiteTable* table)   { _allocation_sites = table; }
+
+  size_t& nmt_bytes_until_sample()      { return _nmt_bytes_until_sample; }
+
   ThreadStatisticalInfo& statistical_info() { return _statistical_info; }
 
   JFR_ONLY(DEFINE_THREAD_LOCAL_ACCESSOR_JFR;)
@@ -541,6 +553,9 @@ protected:
   // Thread local resource area for temporary allocation within the VM
   ResourceArea* _resource_area;
 
+  // Thread local cache of arena chunks
+  ChunkCache _chunk_cache;
+
   DEBUG_ONLY(ResourceMark* _current_resource_mark;)
 
   // Thread local handle area for allocation of handles within the VM
@@ -660,6 +675,15 @@ protected:
     Thread *cur = Thread::current_or_null_safe();
     return cur != nullptr && cur->in_asgct();
   }
+
+#ifndef _WINDOWS
+ private:
+  // Installed by os::ThreadCrashProtection::call() while this thread runs protected code.
+  os::ThreadCrashProtection* volatile _crash_protection = nullptr;
+ public:
+  os::ThreadCrashProtection* crash_protection() const { return _crash_protection; }
+  void set_crash_protection(os::ThreadCrashProtection* value) { _crash_protection = value; }
+#endif
 };
 
 class ThreadInAsgct {
@@ -1206,6 +1230,13 @@ class JavaThread: public Thread {
   // Stack-locking support
   bool is_lock_owned(address adr) const;
 
+ private:
+  LockStack _lock_stack;
+
+ public:
+  // Lightweight locking support
+  LockStack& lock_stack() { return _lock_stack; }
+
   // Accessors for vframe array top
   // The linked list of vframe arrays are sorted on sp. This means when we
   // unpack the head must contain the vframe array to unpack.
@@ -1331,6 +1362,12 @@ class JavaThread: public Thread {
   static ByteSize reserved_stack_activation_offset() {
     return byte_offset_of(JavaThread, _stack_overflow_state._reserved_stack_activation);
   }
+  static ByteSize shadow_zone_safe_limit_offset() {
+    return byte_offset_of(JavaThread, _stack_overflow_state._shadow_zone_safe_limit);
+  }
+  static ByteSize shadow_zone_growth_watermark_offset() {
+    return byte_offset_of(JavaThread, _stack_overflow_state._shadow_zone_growth_watermark);
+  }
 
   static ByteSize suspend_flags_offset()         { return byte_offset_of(JavaThread, _suspend_flags); }
 
@@ -1740,6 +1777,7 @@ class Threads: AllStatic {
   // Verification
   static void verify();
   static void print_on(outputStream* st, bool print_stacks, bool internal_format, bool print_concurrent_locks, bool print_extended_info);
+  static void print_on_with_handshakes(outputStream* st, bool print_extended_info);
   static void print(bool print_stacks, bool internal_format) {
     // this function is only used by debug.cpp
     print_on(tty, print_stacks, internal_format, false /* no concurrent lock printed */, false /* simple format */);
@@ -1756,6 +1794,10 @@ class Threads: AllStatic {
   // Get owning Java thread from the monitor's owner field.
   static JavaThread *owning_thread_from_monitor_owner(ThreadsList * t_list,
                                                       address owner);
+  // Returns the thread with obj on its lock stack, for lightweight locking.
+  static JavaThread* owning_thread_from_object(ThreadsList* t_list, oop obj);
+  // Returns the owner of monitor, also when it is anonymously owned.
+  static JavaThread* owning_thread_from_monitor(ThreadsList* t_list, ObjectMonitor* monitor);
 
   // Number of threads on the active threads list
   static int number_of_threads()                 { return _number_of_threads; }
@@ -96,6 +96,12 @@ uint64_t              ThreadsSMRSupport::_java_thread_list_alloc_cnt = 1;
 // Impl note: See _java_thread_list_alloc_cnt note.
 uint64_t              ThreadsSMRSupport::_java_thread_list_free_cnt = 0;
 
+// # of JavaThread pointers copied into new ThreadsLists over VM lifetime.
+// Every Threads::add() and Threads::remove() copies the current list, so
+// this is the O(n) part of their cost.
+// Impl note: See _java_thread_list_alloc_cnt note.
+uint64_t              ThreadsSMRSupport::_java_thread_list_copy_cnt = 0;
+
 // Max size ThreadsList allocated.
 // Impl note: Max # of threads alive at one time should fit in unsigned 32-bit.
 uint                  ThreadsSMRSupport::_java_thread_list_max = 0;
@@ -105,6 +111,10 @@ uint                  ThreadsSMRSupport::_java_thread_list_max = 0;
 // 16-bit, but there is no nice 16-bit _FORMAT support.
 uint                  ThreadsSMRSupport::_nested_thread_list_max = 0;
 
+// # of hazard ptr scans done by free_list() over VM lifetime.
+// Impl note: See _java_thread_list_alloc_cnt note.
+uint64_t              ThreadsSMRSupport::_free_list_scan_cnt = 0;
+
 // # of ThreadsListHandles deleted over VM lifetime.
 // Impl note: Atomically incremented over VM lifetime so use unsigned for
 // more range. There will be fewer ThreadsListHandles than threads so
@@ -134,6 +144,8 @@ uint                  ThreadsSMRSupport::_to_delete_list_cnt = 0;
 // Impl note: See _to_delete_list_cnt note.
 uint                  ThreadsSMRSupport::_to_delete_list_max = 0;
 
+uint                  ThreadsSMRSupport::_to_delete_list_unscanned = 0;
+
 // 'inline' functions first so the definitions are before first use:
 
 inline void ThreadsSMRSupport::add_deleted_thread_times(uint add_value) {
@@ -148,6 +160,10 @@ inline void ThreadsSMRSupport::inc_java_thread_list_alloc_cnt() {
   _java_thread_list_alloc_cnt++;
 }
 
+inline void ThreadsSMRSupport::add_java_thread_list_copy_cnt(uint add_value) {
+  _java_thread_list_copy_cnt += add_value;
+}
+
 inline bool ThreadsSMRSupport::is_bootstrap_list(ThreadsList* list) {
   return list == &_bootstrap_list;
 }
@@ -836,6 +852,7 @@ void ThreadsSMRSupport::add_thread(JavaThread *thread){
   ThreadsList *new_list = ThreadsList::add_thread(get_java_thread_list(), thread);
   if (EnableThreadSMRStatistics) {
     inc_java_thread_list_alloc_cnt();
+    add_java_thread_list_copy_cnt(new_list->length() - 1);
     update_java_thread_list_max(new_list->length());
   }
   // Initial _java_thread_list will not generate a "Threads::add" mesg.
@@ -868,6 +885,9 @@ bool ThreadsSMRSupport::delete_notify() {
 // The specified ThreadsList may not get deleted during this call if it
 // is still in-use (referenced by a hazard ptr). Other ThreadsLists
 // in the chain may get deleted by this call if they are no longer in-use.
+// The hazard ptr scan that decides this is batched: it is only done when
+// FreeListScanBatch ThreadsLists were added since the previous scan, so
+// unreferenced ThreadsLists may stay on the to-delete list for a while.
 void ThreadsSMRSupport::free_list(ThreadsList* threads) {
   assert_locked_or_safepoint(Threads_lock);
 
@@ -887,6 +907,15 @@ void ThreadsSMRSupport::free_list(ThreadsList* threads) {
     }
   }
 
+  if (++_to_delete_list_unscanned < FreeListScanBatch) {
+    log_debug(thread, smr)("tid=" UINTX_FORMAT ": ThreadsSMRSupport::free_list: threads=" INTPTR_FORMAT " is pending.", os::current_thread_id(), p2i(threads));
+    return;
+  }
+  _to_delete_list_unscanned = 0;
+  if (EnableThreadSMRStatistics) {
+    _free_list_scan_cnt++;
+  }
+
   // Gather a hash table of the current hazard ptrs:
   ThreadScanHashtable *scan_table = new ThreadScanHashtable();
   ScanHazardPtrGatherThreadsListClosure scan_cl(scan_table);
@@ -1007,6 +1036,7 @@ void ThreadsSMRSupport::remove_thread(JavaThread *thread) {
   ThreadsList *new_list = ThreadsList::remove_thread(ThreadsSMRSupport::get_java_thread_list(), thread);
   if (EnableThreadSMRStatistics) {
     ThreadsSMRSupport::inc_java_thread_list_alloc_cnt();
+    ThreadsSMRSupport::add_java_thread_list_copy_cnt(new_list->length());
     // This list is smaller so no need to check for a "longest" update.
   }
 
@@ -1217,6 +1247,12 @@ void ThreadsSMRSupport::print_info_on(outputStream* st) {
                  _java_thread_list_free_cnt,
                  _java_thread_list_max,
                  _nested_thread_list_max);
+    st->print_cr("_java_thread_list_copy_cnt=" UINT64_FORMAT ", "
+                 "avg_java_thread_list_copy=%0.2f, "
+                 "_free_list_scan_cnt=" UINT64_FORMAT,
+                 _java_thread_list_copy_cnt,
+                 ((double) _java_thread_list_copy_cnt / _java_thread_list_alloc_cnt),
+                 _free_list_scan_cnt);
     if (_tlh_cnt > 0) {
       st->print_cr("_tlh_cnt=%u"
                    ", _tlh_times=%u"
@@ -112,14 +112,23 @@ class ThreadsSMRSupport : AllStatic {
   static ThreadsList* volatile _java_thread_list;
   static uint64_t              _java_thread_list_alloc_cnt;
   static uint64_t              _java_thread_list_free_cnt;
+  static uint64_t              _java_thread_list_copy_cnt;
   static uint                  _java_thread_list_max;
   static uint                  _nested_thread_list_max;
+  static uint64_t              _free_list_scan_cnt;
   static volatile uint         _tlh_cnt;
   static volatile uint         _tlh_time_max;
   static volatile uint         _tlh_times;
   static ThreadsList*          _to_delete_list;
   static uint                  _to_delete_list_cnt;
   static uint                  _to_delete_list_max;
+  // # of ThreadsLists added to the to-delete list since the last hazard
+  // ptr scan. Not a statistic: free_list() uses it to batch the scans.
+  static uint                  _to_delete_list_unscanned;
+
+  // A hazard ptr scan walks all threads, so free_list() only scans once
+  // this many ThreadsLists are waiting on the to-delete list.
+  static const uint            FreeListScanBatch = 8;
 
   static ThreadsList *acquire_stable_list_fast_path(Thread *self);
   static ThreadsList *acquire_stable_list_nested_path(Thread *self);
@@ -130,6 +139,7 @@ class ThreadsSMRSupport : AllStatic {
   static void free_list(ThreadsList* threads);
   static void inc_deleted_thread_cnt();
   static void inc_java_thread_list_alloc_cnt();
+  static void add_java_thread_list_copy_cnt(uint add_value);
   static void inc_tlh_cnt();
   static void release_stable_list_wake_up(bool is_nested);
   static void set_delete_notify();
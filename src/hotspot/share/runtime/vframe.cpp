@@ -40,6 +40,7 @@
 #include "prims/jvmtiExport.hpp"
 #include "runtime/frame.inline.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/lockStack.inline.hpp"
 #include "runtime/objectMonitor.hpp"
 #include "runtime/objectMonitor.inline.hpp"
 #include "runtime/osThread.hpp"
@@ -261,7 +262,9 @@ void javaVFrame::print_lock_info_on(outputStream* st, int frame_count) {
               ( // we have marked ourself as pending on this monitor
                 mark.monitor() == thread()->current_pending_monitor() ||
                 // we are not the owner of this monitor
-                !mark.monitor()->is_entered(thread())
+                (!mark.monitor()->is_entered(thread()) &&
+                 // nor the owner of an anonymously owned monitor
+                 !(UseLightweightLocking && thread()->lock_stack().contains(monitor->owner())))
               )) {
             lock_state = "waiting to lock";
           }
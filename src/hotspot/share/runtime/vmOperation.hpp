@@ -52,6 +52,7 @@
   template(DeoptimizeTheWorld)                    \
   template(CollectForMetadataAllocation)          \
   template(GC_HeapInspection)                     \
+  template(PrintAllocationSites)                  \
   template(GenCollectFull)                        \
   template(GenCollectFullConcurrent)              \
   template(GenCollectForAllocation)               \
@@ -62,6 +63,8 @@
   template(G1PauseRemark)                         \
   template(G1PauseCleanup)                        \
   template(G1TryInitiateConcMark)                 \
+  template(G1PrintRegionStats)                    \
+  template(EpsilonResetToWatermark)               \
   template(ZMarkStart)                            \
   template(ZMarkEnd)                              \
   template(ZRelocateStart)                        \
@@ -162,6 +165,12 @@ class VM_Operation : public StackObj {
   // or concurrently with Java threads running.
   virtual bool evaluate_at_safepoint() const { return true; }
 
+  // A safepoint operation requested while another one is waiting for or
+  // executing its safepoint may be evaluated in that safepoint instead of
+  // starting its own. Override this to return true only if the operation
+  // just needs some safepoint that began after it was requested.
+  virtual bool can_coalesce() const { return false; }
+
   // Debugging
   virtual void print_on_error(outputStream* st) const;
   virtual const char* name() const  { return _names[type()]; }
@@ -65,6 +65,7 @@ class VM_ForceSafepoint: public VM_Operation {
  public:
   void doit()         {}
   VMOp_Type type() const { return VMOp_ForceSafepoint; }
+  bool can_coalesce() const { return true; }
 };
 
 // empty vm op, when forcing a safepoint to suspend a thread
@@ -160,6 +161,7 @@ class VM_PrintThreads: public VM_Operation {
   void doit();
   bool doit_prologue();
   void doit_epilogue();
+  bool can_coalesce() const { return true; }
 };
 
 class VM_PrintJNI: public VM_Operation {
@@ -204,6 +206,7 @@ class VM_FindDeadlocks: public VM_Operation {
   DeadlockCycle* result()      { return _deadlocks; };
   VMOp_Type type() const       { return VMOp_FindDeadlocks; }
   void doit();
+  bool can_coalesce() const    { return true; }
 };
 
 class ThreadDumpResult;
@@ -238,6 +241,7 @@ class VM_ThreadDump : public VM_Operation {
   void doit();
   bool doit_prologue();
   void doit_epilogue();
+  bool can_coalesce() const { return true; }
 };
 
 
@@ -887,7 +887,8 @@ typedef HashtableEntry<InstanceKlass*, mtClass>  KlassHashtableEntry;
   nonstatic_field(BasicObjectLock,             _lock,                                         BasicLock)                             \
   nonstatic_field(BasicObjectLock,             _obj,                                          oop)                                   \
   static_field(ObjectSynchronizer,             _in_use_list,                                  MonitorList)                           \
-  volatile_nonstatic_field(MonitorList,        _head,                                         ObjectMonitor*)                        \
+  unchecked_nonstatic_field(MonitorList,       _partitions,                                   sizeof(MonitorList::Partition) * MonitorList::MaxPartitions) \
+  nonstatic_field(MonitorList,                 _num_partitions,                               uint)                                  \
                                                                                                                                      \
   /*********************/                                                                                                            \
   /* Matcher (C2 only) */                                                                                                            \
@@ -92,6 +92,10 @@ VMThread*         VMThread::_vm_thread          = NULL;
 VM_Operation*     VMThread::_cur_vm_operation   = NULL;
 VM_Operation*     VMThread::_next_vm_operation  = &cleanup_op; // Prevent any thread from setting an operation until VM thread is ready.
 PerfCounter*      VMThread::_perf_accumulated_vm_operation_time = NULL;
+PerfCounter*      VMThread::_perf_coalesced_vm_operations = NULL;
+VM_Operation*     VMThread::_coalesce_queue[CoalesceQueueSize];
+uint              VMThread::_coalesce_queue_length = 0;
+VM_Operation*     VMThread::_coalesced_vm_operation = NULL;
 VMOperationTimeoutTask* VMThread::_timeout_task = NULL;
 
 
@@ -123,6 +127,9 @@ void VMThread::create() {
     _perf_accumulated_vm_operation_time =
                  PerfDataManager::create_counter(SUN_THREADS, "vmOperationTime",
                                                  PerfData::U_Ticks, CHECK);
+    _perf_coalesced_vm_operations =
+                 PerfDataManager::create_counter(SUN_THREADS, "vmOperationsCoalesced",
+                                                 PerfData::U_Events, CHECK);
   }
 }
 
@@ -337,6 +344,46 @@ bool VMThread::set_next_operation(VM_Operation *op) {
   return true;
 }
 
+bool VMThread::add_coalescable_operation(VM_Operation* op) {
+  assert_lock_strong(VMOperation_lock);
+  if (!op->can_coalesce() || !op->evaluate_at_safepoint() ||
+      _coalesce_queue_length == CoalesceQueueSize) {
+    return false;
+  }
+  log_debug(vmthread)("Adding coalescable VM operation: %s", op->name());
+
+  _coalesce_queue[_coalesce_queue_length++] = op;
+
+  HOTSPOT_VMOPS_REQUEST(
+                   (char *) op->name(), strlen(op->name()),
+                   op->evaluate_at_safepoint() ? 0 : 1);
+  return true;
+}
+
+VM_Operation* VMThread::remove_coalescable_operation(uint index) {
+  assert_lock_strong(VMOperation_lock);
+  assert(index < _coalesce_queue_length, "out of bounds");
+  VM_Operation* op = _coalesce_queue[index];
+  _coalesce_queue_length--;
+  for (uint i = index; i < _coalesce_queue_length; i++) {
+    _coalesce_queue[i] = _coalesce_queue[i + 1];
+  }
+  return op;
+}
+
+bool VMThread::is_pending(VM_Operation* op) {
+  assert_lock_strong(VMOperation_lock);
+  if (_next_vm_operation == op || _coalesced_vm_operation == op) {
+    return true;
+  }
+  for (uint i = 0; i < _coalesce_queue_length; i++) {
+    if (_coalesce_queue[i] == op) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void VMThread::wait_until_executed(VM_Operation* op) {
   MonitorLocker ml(VMOperation_lock,
                    Thread::current()->is_Java_thread() ?
@@ -345,7 +392,8 @@ void VMThread::wait_until_executed(VM_Operation* op) {
   {
     TraceTime timer("Installing VM operation", TRACETIME_LOG(Trace, vmthread));
     while (true) {
-      if (VMThread::vm_thread()->set_next_operation(op)) {
+      if (VMThread::vm_thread()->set_next_operation(op) ||
+          VMThread::vm_thread()->add_coalescable_operation(op)) {
         ml.notify_all();
         break;
       }
@@ -358,8 +406,9 @@ void VMThread::wait_until_executed(VM_Operation* op) {
     // Wait until the operation has been processed
     TraceTime timer("Waiting for VM operation to be completed", TRACETIME_LOG(Trace, vmthread));
     // _next_vm_operation is cleared holding VMOperation_lock after it has been
-    // executed. We wait until _next_vm_operation is not our op.
-    while (_next_vm_operation == op) {
+    // executed, as is _coalesced_vm_operation. We wait until our op is
+    // neither of them nor queued for coalescing.
+    while (is_pending(op)) {
       // VM Thread can process it once we unlock the mutex on wait.
       ml.wait();
     }
@@ -402,8 +451,14 @@ void VMThread::inner_execute(VM_Operation* op) {
                       _cur_vm_operation->name());
 
   bool end_safepoint = false;
+  uint coalesce_limit = 0;
   if (_cur_vm_operation->evaluate_at_safepoint() &&
       !SafepointSynchronize::is_at_safepoint()) {
+    {
+      // Only operations requested before this safepoint begins may use it.
+      MutexLocker ml(VMOperation_lock, Mutex::_no_safepoint_check_flag);
+      coalesce_limit = _coalesce_queue_length;
+    }
     SafepointSynchronize::begin();
     if (_timeout_task != NULL) {
       _timeout_task->arm();
@@ -414,6 +469,7 @@ void VMThread::inner_execute(VM_Operation* op) {
   evaluate_operation(_cur_vm_operation);
 
   if (end_safepoint) {
+    coalesce_operations(_cur_vm_operation, coalesce_limit);
     if (_timeout_task != NULL) {
       _timeout_task->disarm();
     }
@@ -423,6 +479,44 @@ void VMThread::inner_execute(VM_Operation* op) {
   _cur_vm_operation = prev_vm_operation;
 }
 
+// Evaluates up to the first limit queued coalescable operations in the
+// safepoint of op, saving each of them a safepoint of its own.
+void VMThread::coalesce_operations(VM_Operation* op, uint limit) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at a safepoint");
+  assert(_cur_vm_operation == op, "must be the current operation");
+  if (limit == 0) {
+    return;
+  }
+  MonitorLocker ml(VMOperation_lock, Mutex::_no_safepoint_check_flag);
+  // Operations queued while unlocked below are appended and thus never
+  // among the first limit entries still to examine, starting at index.
+  uint index = 0;
+  for (; limit > 0 && index < _coalesce_queue_length; limit--) {
+    if (op->skip_thread_oop_barriers() &&
+        !_coalesce_queue[index]->skip_thread_oop_barriers()) {
+      // The safepoint did not process thread oops for this operation.
+      index++;
+      continue;
+    }
+    _coalesced_vm_operation = remove_coalescable_operation(index);
+    {
+      MutexUnlocker mul(VMOperation_lock, Mutex::_no_safepoint_check_flag);
+      _cur_vm_operation = _coalesced_vm_operation;
+      HandleMark hm(VMThread::vm_thread());
+      EventMarkVMOperation em("Executing coalesced VM operation: %s", _cur_vm_operation->name());
+      log_debug(vmthread)("Evaluating coalesced VM operation: %s in safepoint of %s",
+                          _cur_vm_operation->name(), op->name());
+      evaluate_operation(_cur_vm_operation);
+      _cur_vm_operation = op;
+      if (UsePerfData) {
+        _perf_coalesced_vm_operations->inc();
+      }
+    }
+    _coalesced_vm_operation = NULL;
+    ml.notify_all();
+  }
+}
+
 void VMThread::wait_for_operation() {
   assert(Thread::current()->is_VM_thread(), "Must be the VM thread");
   MonitorLocker ml_op_lock(VMOperation_lock, Mutex::_no_safepoint_check_flag);
@@ -438,6 +532,11 @@ void VMThread::wait_for_operation() {
     if (_next_vm_operation != NULL) {
       return;
     }
+    if (_coalesce_queue_length > 0) {
+      // Nothing to coalesce with, the oldest queued operation goes next.
+      _next_vm_operation = remove_coalescable_operation(0);
+      return;
+    }
     if (handshake_alot()) {
       {
         MutexUnlocker mul(VMOperation_lock);
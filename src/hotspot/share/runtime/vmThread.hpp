@@ -65,6 +65,7 @@ class VMThread: public NamedThread {
   static bool _terminated;
   static Monitor * _terminate_lock;
   static PerfCounter* _perf_accumulated_vm_operation_time;
+  static PerfCounter* _perf_coalesced_vm_operations;
 
   static VMOperationTimeoutTask* _timeout_task;
 
@@ -73,6 +74,7 @@ class VMThread: public NamedThread {
 
   void evaluate_operation(VM_Operation* op);
   void inner_execute(VM_Operation* op);
+  void coalesce_operations(VM_Operation* op, uint limit);
   void wait_for_operation();
 
  public:
@@ -135,7 +137,17 @@ class VMThread: public NamedThread {
   static VM_Operation*     _cur_vm_operation;   // Current VM operation
   static VM_Operation*     _next_vm_operation;  // Next VM operation
 
+  // Operations that can_coalesce() and found _next_vm_operation taken wait
+  // here, in request order, to be evaluated in the next safepoint.
+  static const uint        CoalesceQueueSize = 16;
+  static VM_Operation*     _coalesce_queue[CoalesceQueueSize];
+  static uint              _coalesce_queue_length;
+  static VM_Operation*     _coalesced_vm_operation; // Dequeued, not evaluated yet
+
   bool set_next_operation(VM_Operation *op);    // Set the _next_vm_operation if possible.
+  bool add_coalescable_operation(VM_Operation* op);
+  static bool is_pending(VM_Operation* op);
+  static VM_Operation* remove_coalescable_operation(uint index);
 
   // Pointer to single-instance of VM thread
   static VMThread*     _vm_thread;
@@ -39,6 +39,7 @@
 #include "runtime/java.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/os.hpp"
+#include "runtime/thread.hpp"
 #include "runtime/vmOperations.hpp"
 #include "services/attachListener.hpp"
 #include "services/diagnosticCommand.hpp"
@@ -184,8 +185,12 @@ static jint thread_dump(AttachOperation* op, outputStream* out) {
   }
 
   // thread stacks
-  VM_PrintThreads op1(out, print_concurrent_locks, print_extended_info);
-  VMThread::execute(&op1);
+  if (ThreadDumpWithHandshakes && !print_concurrent_locks) {
+    Threads::print_on_with_handshakes(out, print_extended_info);
+  } else {
+    VM_PrintThreads op1(out, print_concurrent_locks, print_extended_info);
+    VMThread::execute(&op1);
+  }
 
   // JNI global handles
   VM_PrintJNI op2(out);
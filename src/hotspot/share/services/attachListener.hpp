@@ -76,6 +76,10 @@ class AttachListener: AllStatic {
   // indicates if we have a trigger to start the Attach Listener
   static bool is_init_trigger() NOT_SERVICES_RETURN_(false);
 
+  // close the listener before a checkpoint and re-open it after restore (Linux only)
+  static void before_checkpoint() NOT_SERVICES_RETURN;
+  static void after_restore() NOT_SERVICES_RETURN;
+
 #if !INCLUDE_SERVICES
   static bool is_attach_supported()             { return false; }
 #else
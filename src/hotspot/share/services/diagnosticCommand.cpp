@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "jvm.h"
+#include "classfile/classLoader.hpp"
 #include "classfile/classLoaderHierarchyDCmd.hpp"
 #include "classfile/classLoaderStats.hpp"
 #include "classfile/javaClasses.hpp"
@@ -32,13 +33,16 @@
 #include "code/codeCache.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/directivesParser.hpp"
+#include "gc/shared/allocationSiteSampler.hpp"
 #include "gc/shared/gcVMOperations.hpp"
+#include "gc/shared/tlab_globals.hpp"
 #include "memory/metaspace/metaspaceDCmd.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
 #include "oops/objArrayOop.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/typeArrayOop.inline.hpp"
+#include "runtime/crac.hpp"
 #include "runtime/fieldDescriptor.inline.hpp"
 #include "runtime/flags/jvmFlag.hpp"
 #include "runtime/handles.inline.hpp"
@@ -46,6 +50,7 @@
 #include "runtime/javaCalls.hpp"
 #include "runtime/jniHandles.hpp"
 #include "runtime/os.hpp"
+#include "runtime/thread.hpp"
 #include "runtime/vmOperations.hpp"
 #include "runtime/vm_version.hpp"
 #include "services/diagnosticArgument.hpp"
@@ -65,6 +70,12 @@
 #ifdef LINUX
 #include "trimCHeapDCmd.hpp"
 #endif
+#if INCLUDE_EPSILONGC
+#include "gc/epsilon/epsilonResetDCmd.hpp"
+#endif
+#if INCLUDE_G1GC
+#include "gc/g1/g1RegionStatsDCmd.hpp"
+#endif
 
 static void loadAgentModule(TRAPS) {
   ResourceMark rm(THREAD);
@@ -100,6 +111,13 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<RunFinalizationDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapInfoDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<FinalizerInfoDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<AllocationSitesDCmd>(full_export, true, false));
+#if INCLUDE_G1GC
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<G1RegionStatsDCmd>(full_export, true, false));
+#endif // INCLUDE_G1GC
+#if INCLUDE_EPSILONGC
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<EpsilonResetDCmd>(full_export, true, false));
+#endif // INCLUDE_EPSILONGC
 #if INCLUDE_SERVICES
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HeapDumpDCmd>(DCmd_Source_Internal | DCmd_Source_AttachAPI, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassHistogramDCmd>(full_export, true, false));
@@ -118,6 +136,7 @@ void DCmdRegistrant::register_dcmds(){
 #endif // INCLUDE_JVMTI
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ThreadDumpDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassLoaderStatsDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassLoadTimesDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassLoaderHierarchyDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompileQueueDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeListDCmd>(full_export, true, false));
@@ -132,8 +151,10 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompilerDirectivesPrintDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompilerDirectivesAddDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompilerDirectivesRemoveDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompilerDirectivesReplaceDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CompilerDirectivesClearDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CheckpointDCmd>(full_export, true,false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CheckpointReportDCmd>(full_export, true, false));
 
   // Enhanced JMX Agent Support
   // These commands won't be exported via the DiagnosticCommandMBean until an
@@ -421,6 +442,10 @@ void HeapInfoDCmd::execute(DCmdSource source, TRAPS) {
   Universe::heap()->print_on(output());
 }
 
+void ClassLoadTimesDCmd::execute(DCmdSource source, TRAPS) {
+  ClassLoader::print_class_load_times(output());
+}
+
 void FinalizerInfoDCmd::execute(DCmdSource source, TRAPS) {
   ResourceMark rm(THREAD);
 
@@ -536,6 +561,26 @@ void ClassHistogramDCmd::execute(DCmdSource source, TRAPS) {
 
 #endif // INCLUDE_SERVICES
 
+AllocationSitesDCmd::AllocationSitesDCmd(outputStream* output, bool heap) :
+                                         DCmdWithParser(output, heap),
+  _top("-top", "Number of sites to print", "INT", false, "20"),
+  _reset("-reset", "Clear the sampled sites after printing", "BOOLEAN", false, "false") {
+  _dcmdparser.add_dcmd_option(&_top);
+  _dcmdparser.add_dcmd_option(&_reset);
+}
+
+void AllocationSitesDCmd::execute(DCmdSource source, TRAPS) {
+  jlong top = _top.value();
+  if (top < 0) {
+    output()->print_cr("Number of sites out of range (>=0): " JLONG_FORMAT, top);
+    return;
+  }
+  if (!AllocationSiteSampling) {
+    output()->print_cr("Allocation site sampling is disabled, enable it with -XX:+AllocationSiteSampling");
+  }
+  AllocationSiteSampler::print_top(output(), (uint)MIN2(top, (jlong)max_juint), _reset.value());
+}
+
 ThreadDumpDCmd::ThreadDumpDCmd(outputStream* output, bool heap) :
                                DCmdWithParser(output, heap),
   _locks("-l", "print java.util.concurrent locks", "BOOLEAN", false, "false"),
@@ -546,8 +591,12 @@ ThreadDumpDCmd::ThreadDumpDCmd(outputStream* output, bool heap) :
 
 void ThreadDumpDCmd::execute(DCmdSource source, TRAPS) {
   // thread stacks
-  VM_PrintThreads op1(output(), _locks.value(), _extended.value());
-  VMThread::execute(&op1);
+  if (ThreadDumpWithHandshakes && !_locks.value()) {
+    Threads::print_on_with_handshakes(output(), _extended.value());
+  } else {
+    VM_PrintThreads op1(output(), _locks.value(), _extended.value());
+    VMThread::execute(&op1);
+  }
 
   // JNI global handles
   VM_PrintJNI op2(output());
@@ -905,6 +954,16 @@ void CompilerDirectivesAddDCmd::execute(DCmdSource source, TRAPS) {
   DirectivesParser::parse_from_file(_filename.value(), output());
 }
 
+CompilerDirectivesReplaceDCmd::CompilerDirectivesReplaceDCmd(outputStream* output, bool heap) :
+                               DCmdWithParser(output, heap),
+  _filename("filename","Name of the directives file", "STRING",true) {
+  _dcmdparser.add_dcmd_argument(&_filename);
+}
+
+void CompilerDirectivesReplaceDCmd::execute(DCmdSource source, TRAPS) {
+  DirectivesParser::parse_from_file(_filename.value(), output(), true /* replace */);
+}
+
 void CompilerDirectivesRemoveDCmd::execute(DCmdSource source, TRAPS) {
   DirectivesStack::pop(1);
 }
@@ -1072,3 +1131,14 @@ void CheckpointDCmd::execute(DCmdSource source, TRAPS) {
     }
   }
 }
+
+void CheckpointReportDCmd::execute(DCmdSource source, TRAPS) {
+  int jcmd_fd = -1;
+#if defined(LINUX) && INCLUDE_SERVICES
+  // The connection of this jcmd is closed before a real checkpoint
+  if (source == DCmd_Source_AttachAPI && LinuxAttachListener::get_current_op() != NULL) {
+    jcmd_fd = LinuxAttachListener::get_current_op()->socket();
+  }
+#endif // LINUX && INCLUDE_SERVICES
+  crac::print_checkpoint_report(output(), jcmd_fd);
+}
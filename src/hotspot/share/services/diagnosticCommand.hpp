@@ -288,6 +288,26 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class ClassLoadTimesDCmd : public DCmd {
+public:
+  ClassLoadTimesDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
+  static const char* name() { return "VM.class_load_times"; }
+  static const char* description() {
+    return "Print the time spent parsing, defining, linking, verifying and initializing "
+           "classes per class loader, and the slowest class initializers.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+      "monitor", NULL};
+      return p;
+  }
+
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class FinalizerInfoDCmd : public DCmd {
 public:
   FinalizerInfoDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
@@ -360,6 +380,30 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class AllocationSitesDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<jlong> _top;
+  DCmdArgument<bool> _reset;
+public:
+  AllocationSitesDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "GC.allocation_sites";
+  }
+  static const char* description() {
+    return "Print the allocation sites sampled with -XX:+AllocationSiteSampling, "
+           "ordered by sampled bytes.";
+  }
+  static const char* impact() {
+    return "Medium: Depends on the number of threads and sampled sites.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class ClassHierarchyDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _print_interfaces; // true if inherited interfaces should be printed.
@@ -729,6 +773,29 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class CompilerDirectivesReplaceDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<char*> _filename;
+public:
+  CompilerDirectivesReplaceDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "Compiler.directives_replace";
+  }
+  static const char* description() {
+    return "Replace all compiler directives with the ones from file and deoptimize "
+           "the compiled methods matching the old or the new directives.";
+  }
+  static const char* impact() {
+    return "Medium: Deoptimized methods run interpreted until they are recompiled.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class CompilerDirectivesClearDCmd : public DCmd {
 public:
   CompilerDirectivesClearDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
@@ -916,4 +983,25 @@ public:
     virtual void execute(DCmdSource source, TRAPS);
 };
 
+class CheckpointReportDCmd : public DCmd {
+public:
+  CheckpointReportDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
+  static const char* name() { return "JDK.checkpoint_report"; }
+  static const char* description() {
+    return "Report the expected checkpoint image size, the open file descriptors "
+           "that would fail a checkpoint and the duration of the previous "
+           "checkpoint and restore, without checkpointing.";
+  }
+  static const char* impact() {
+    return "Medium: Depends on the number of memory mappings and threads";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments() { return 0; }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 #endif // SHARE_SERVICES_DIAGNOSTICCOMMAND_HPP
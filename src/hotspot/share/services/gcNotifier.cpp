@@ -98,6 +98,11 @@ static Handle getGcInfoBuilder(GCMemoryManager *gcManager,TRAPS) {
   return Handle(THREAD, result.get_oop());
 }
 
+static bool same_usage(const MemoryUsage& a, const MemoryUsage& b) {
+  return a.init_size() == b.init_size() && a.used() == b.used() &&
+         a.committed() == b.committed() && a.max_size() == b.max_size();
+}
+
 static Handle createGcInfo(GCMemoryManager *gcManager, GCStatInfo *gcStatInfo,TRAPS) {
 
   // Fill the arrays of MemoryUsage objects with before and after GC
@@ -115,7 +120,8 @@ static Handle createGcInfo(GCMemoryManager *gcManager, GCStatInfo *gcStatInfo,TR
   objArrayHandle usage_after_gc_ah(THREAD, au);
 
   for (int i = 0; i < MemoryService::num_memory_pools(); i++) {
-    Handle before_usage = MemoryService::create_MemoryUsage_obj(gcStatInfo->before_gc_usage_for_pool(i), CHECK_NH);
+    MemoryUsage b = gcStatInfo->before_gc_usage_for_pool(i);
+    Handle before_usage = MemoryService::create_MemoryUsage_obj(b, CHECK_NH);
     Handle after_usage;
 
     MemoryUsage u = gcStatInfo->after_gc_usage_for_pool(i);
@@ -124,6 +130,10 @@ static Handle createGcInfo(GCMemoryManager *gcManager, GCStatInfo *gcStatInfo,TR
       // Set max size = -1 since the pools will be swapped after GC.
       MemoryUsage usage(u.init_size(), u.used(), u.committed(), (size_t)-1);
       after_usage = MemoryService::create_MemoryUsage_obj(usage, CHECK_NH);
+    } else if (same_usage(b, u)) {
+      // MemoryUsage is immutable, so pools the collection did not touch
+      // (old gen in a young GC, metaspace, code cache) share one object.
+      after_usage = before_usage;
     } else {
         after_usage = MemoryService::create_MemoryUsage_obj(u, CHECK_NH);
     }
@@ -42,6 +42,7 @@
 #include "oops/objArrayOop.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/typeArrayOop.inline.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/frame.inline.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/javaCalls.hpp"
@@ -59,6 +60,10 @@
 #include "utilities/macros.hpp"
 #include "utilities/ostream.hpp"
 
+#ifndef O_BINARY       // if defined (Win32) use binary files.
+#define O_BINARY 0     // otherwise do nothing.
+#endif
+
 /*
  * HPROF binary format - description copied from:
  *   src/share/demo/jvmti/hprof/hprof_io.c
@@ -1446,12 +1451,85 @@ void HeapObjectDumper::do_object(oop o) {
   }
 }
 
+// Dumps the heap objects in parallel. Each worker writes complete
+// HPROF_HEAP_DUMP_SEGMENT records to its own segment file, which
+// VM_HeapDumper then appends to the dump.
+class HeapSegmentDumpTask : public AbstractGangTask {
+ private:
+  ParallelObjectIterator* _poi;
+  const char*             _base_path;
+  const uint              _num_segments;
+  bool*                   _dumped;
+  volatile uint           _num_dumped;
+  char const* volatile    _error;
+
+ public:
+  HeapSegmentDumpTask(ParallelObjectIterator* poi, const char* base_path, uint num_segments) :
+    AbstractGangTask("dump heap segments"),
+    _poi(poi),
+    _base_path(base_path),
+    _num_segments(num_segments),
+    _dumped(NEW_C_HEAP_ARRAY(bool, num_segments, mtServiceability)),
+    _num_dumped(0),
+    _error(NULL) {
+    for (uint i = 0; i < num_segments; i++) {
+      _dumped[i] = false;
+    }
+  }
+
+  ~HeapSegmentDumpTask() {
+    FREE_C_HEAP_ARRAY(bool, _dumped);
+  }
+
+  // Returns false if the path does not fit into the buffer.
+  static bool segment_path(char* buf, size_t len, const char* base_path, uint worker_id) {
+    int ret = jio_snprintf(buf, len, "%s.p%u", base_path, worker_id);
+    return ret >= 0 && (size_t)ret < len;
+  }
+
+  uint num_segments() const        { return _num_segments; }
+  bool dumped(uint worker_id) const { return _dumped[worker_id]; }
+  uint num_dumped() const          { return Atomic::load(&_num_dumped); }
+  char const* error() const        { return Atomic::load(&_error); }
+
+  void work(uint worker_id) {
+    char path[JVM_MAXPATHLEN];
+    if (!segment_path(path, sizeof(path), _base_path, worker_id)) {
+      return;
+    }
+
+    DumpWriter writer(new (std::nothrow) FileWriter(path, true /* overwrite */), NULL);
+    if (writer.error() != NULL) {
+      // Without claiming any part of the heap, the other workers dump
+      // everything this worker would have dumped.
+      return;
+    }
+
+    HeapObjectDumper obj_dumper(&writer);
+    _poi->object_iterate(&obj_dumper, worker_id);
+    writer.finish_dump_segment();
+    writer.deactivate();
+
+    if (writer.error() != NULL) {
+      // The objects this worker claimed are lost.
+      Atomic::cmpxchg(&_error, (char const*)NULL, writer.error());
+      return;
+    }
+
+    _dumped[worker_id] = true;
+    Atomic::inc(&_num_dumped);
+  }
+};
+
 // The VM operation that performs the heap dump
 class VM_HeapDumper : public VM_GC_Operation, public AbstractGangTask {
  private:
   static VM_HeapDumper* _global_dumper;
   static DumpWriter*    _global_writer;
   DumpWriter*           _local_writer;
+  const char*           _path;
+  HeapSegmentDumpTask*  _segments;
+  char const*           _segment_error;
   JavaThread*           _oome_thread;
   Method*               _oome_constructor;
   bool _gc_before_heap_dump;
@@ -1498,14 +1576,20 @@ class VM_HeapDumper : public VM_GC_Operation, public AbstractGangTask {
   // HPROF_TRACE and HPROF_FRAME records
   void dump_stack_traces();
 
+  // Appends the segment files written by the HeapSegmentDumpTask
+  void merge_segments();
+
  public:
-  VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome) :
+  VM_HeapDumper(DumpWriter* writer, const char* path, bool gc_before_heap_dump, bool oome) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
                     GCCause::_heap_dump /* GC Cause */,
                     0 /* total full collections, dummy, ignored */,
                     gc_before_heap_dump),
     AbstractGangTask("dump heap") {
     _local_writer = writer;
+    _path = path;
+    _segments = NULL;
+    _segment_error = NULL;
     _gc_before_heap_dump = gc_before_heap_dump;
     _klass_map = new (ResourceObj::C_HEAP, mtServiceability) GrowableArray<Klass*>(INITIAL_CLASS_COUNT, mtServiceability);
     _stack_traces = NULL;
@@ -1536,6 +1620,9 @@ class VM_HeapDumper : public VM_GC_Operation, public AbstractGangTask {
   VMOp_Type type() const { return VMOp_HeapDumper; }
   void doit();
   void work(uint worker_id);
+
+  // Error of a segment writer, which makes the dump incomplete
+  char const* segment_error() const { return _segment_error; }
 };
 
 
@@ -1771,7 +1858,24 @@ void VM_HeapDumper::doit() {
   if (gang == NULL) {
     work(0);
   } else {
-    gang->run_task(this, gang->active_workers(), true);
+    if (HeapDumpParallel && gang->active_workers() > 1) {
+      // Dump the heap objects to segment files first, work() appends them
+      // where it would otherwise iterate over the heap.
+      ParallelObjectIterator poi(gang->active_workers());
+      HeapSegmentDumpTask task(&poi, _path, gang->active_workers());
+      gang->run_task(&task);
+      if (task.num_dumped() > 0) {
+        _segments = &task;
+        _segment_error = task.error();
+        gang->run_task(this, gang->active_workers(), true);
+        _segments = NULL;
+      } else {
+        // No worker could create its segment file, dump serially
+        gang->run_task(this, gang->active_workers(), true);
+      }
+    } else {
+      gang->run_task(this, gang->active_workers(), true);
+    }
   }
 
   // Now we clear the global variables, so that a future dumper can run.
@@ -1823,8 +1927,12 @@ void VM_HeapDumper::work(uint worker_id) {
   // segment is started.
   // The HPROF_GC_CLASS_DUMP and HPROF_GC_INSTANCE_DUMP are the vast bulk
   // of the heap dump.
-  HeapObjectDumper obj_dumper(writer());
-  Universe::heap()->object_iterate(&obj_dumper);
+  if (_segments != NULL) {
+    merge_segments();
+  } else {
+    HeapObjectDumper obj_dumper(writer());
+    Universe::heap()->object_iterate(&obj_dumper);
+  }
 
   // HPROF_GC_ROOT_THREAD_OBJ + frames + jni locals
   do_threads();
@@ -1849,6 +1957,47 @@ void VM_HeapDumper::work(uint worker_id) {
   writer()->deactivate();
 }
 
+void VM_HeapDumper::merge_segments() {
+  const size_t buffer_size = 1*M;
+  char* buffer = NEW_C_HEAP_ARRAY_RETURN_NULL(char, buffer_size, mtServiceability);
+  if (buffer == NULL && _segment_error == NULL) {
+    _segment_error = "Could not allocate heap dump merge buffer";
+  }
+
+  // The segment files hold complete dump segments, so the current one
+  // has to be closed before appending them.
+  writer()->finish_dump_segment();
+
+  for (uint i = 0; i < _segments->num_segments(); i++) {
+    char path[JVM_MAXPATHLEN];
+    if (!HeapSegmentDumpTask::segment_path(path, sizeof(path), _path, i)) {
+      continue;
+    }
+
+    if (_segments->dumped(i) && buffer != NULL) {
+      int fd = os::open(path, O_RDONLY | O_BINARY, 0);
+      if (fd < 0) {
+        if (_segment_error == NULL) {
+          _segment_error = "Could not open heap dump segment file";
+        }
+      } else {
+        ssize_t n;
+        while ((n = os::read(fd, buffer, (unsigned int)buffer_size)) > 0) {
+          writer()->write_raw(buffer, (size_t)n);
+        }
+        if (n < 0 && _segment_error == NULL) {
+          _segment_error = "Could not read heap dump segment file";
+        }
+        os::close(fd);
+      }
+    }
+
+    remove(path);
+  }
+
+  FREE_C_HEAP_ARRAY(char, buffer);
+}
+
 void VM_HeapDumper::dump_stack_traces() {
   // write a HPROF_TRACE record without any frames to be referenced as object alloc sites
   DumperSupport::write_header(writer(), HPROF_TRACE, 3*sizeof(u4));
@@ -1940,7 +2089,7 @@ int HeapDumper::dump(const char* path, outputStream* out, int compression, bool
   }
 
   // generate the dump
-  VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome);
+  VM_HeapDumper dumper(&writer, path, _gc_before_heap_dump, _oome);
   if (Thread::current()->is_VM_thread()) {
     assert(SafepointSynchronize::is_at_safepoint(), "Expected to be called at a safepoint");
     dumper.doit();
@@ -1948,8 +2097,8 @@ int HeapDumper::dump(const char* path, outputStream* out, int compression, bool
     VMThread::execute(&dumper);
   }
 
-  // record any error that the writer may have encountered
-  set_error(writer.error());
+  // record any error that the writer or a segment writer may have encountered
+  set_error(writer.error() != NULL ? writer.error() : dumper.segment_error());
 
   // emit JFR event
   if (error() == NULL) {
@@ -1967,11 +2116,11 @@ int HeapDumper::dump(const char* path, outputStream* out, int compression, bool
       out->print_cr("Heap dump file created [" JULONG_FORMAT " bytes in %3.3f secs]",
                     writer.bytes_written(), timer()->seconds());
     } else {
-      out->print_cr("Dump file is incomplete: %s", writer.error());
+      out->print_cr("Dump file is incomplete: %s", error());
     }
   }
 
-  return (writer.error() == NULL) ? 0 : -1;
+  return (error() == NULL) ? 0 : -1;
 }
 
 // stop timer (if still active), and free any error string we might be holding
@@ -44,8 +44,20 @@ class MallocSite : public AllocationSite {
   MallocSite(const NativeCallStack& stack, MEMFLAGS flags) :
     AllocationSite(stack, flags) {}
 
-  void allocate(size_t size)      { _c.allocate(size);   }
-  void deallocate(size_t size)    { _c.deallocate(size); }
+  void allocate(size_t size, size_t count) {
+    if (count == 1) {
+      _c.allocate(size);
+    } else {
+      _c.add((ssize_t)count, (ssize_t)size);
+    }
+  }
+  void deallocate(size_t size, size_t count) {
+    if (count == 1) {
+      _c.deallocate(size);
+    } else {
+      _c.add(-(ssize_t)count, -(ssize_t)size);
+    }
+  }
 
   // Memory allocated from this code path
   size_t size()  const { return _c.size(); }
@@ -86,8 +98,8 @@ class MallocSiteHashtableEntry : public CHeapObj<mtNMT> {
   inline MallocSite* data()             { return &_malloc_site; }
 
   // Allocation/deallocation on this allocation site
-  inline void allocate(size_t size)   { _malloc_site.allocate(size);   }
-  inline void deallocate(size_t size) { _malloc_site.deallocate(size); }
+  inline void allocate(size_t size, size_t count)   { _malloc_site.allocate(size, count);   }
+  inline void deallocate(size_t size, size_t count) { _malloc_site.deallocate(size, count); }
   // Memory counters
   inline size_t size() const  { return _malloc_site.size();  }
   inline size_t count() const { return _malloc_site.count(); }
@@ -156,19 +168,20 @@ class MallocSiteTable : AllStatic {
   // Return false only occurs under rare scenarios:
   //  1. out of memory
   //  2. overflow hash bucket
-  static inline bool allocation_at(const NativeCallStack& stack, size_t size,
+  // A sampled allocation stands for count allocations of size bytes in total.
+  static inline bool allocation_at(const NativeCallStack& stack, size_t size, size_t count,
       uint32_t* marker, MEMFLAGS flags) {
     MallocSite* site = lookup_or_add(stack, marker, flags);
-    if (site != NULL) site->allocate(size);
+    if (site != NULL) site->allocate(size, count);
     return site != NULL;
   }
 
   // Record memory deallocation. marker indicates where the allocation
   // information was recorded.
-  static inline bool deallocation_at(size_t size, uint32_t marker) {
+  static inline bool deallocation_at(size_t size, size_t count, uint32_t marker) {
     MallocSite* site = malloc_site(marker);
     if (site != NULL) {
-      site->deallocate(size);
+      site->deallocate(size, count);
       return true;
     }
     return false;
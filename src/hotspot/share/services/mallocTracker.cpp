@@ -25,6 +25,7 @@
 
 #include "runtime/atomic.hpp"
 #include "runtime/os.hpp"
+#include "runtime/thread.hpp"
 #include "services/mallocSiteTable.hpp"
 #include "services/mallocTracker.hpp"
 #include "services/memTracker.hpp"
@@ -32,6 +33,7 @@
 #include "utilities/ostream.hpp"
 
 size_t MallocMemorySummary::_snapshot[CALC_OBJ_SIZE_IN_TYPE(MallocMemorySnapshot, size_t)];
+PaddedEnd<MallocCounterStripe> MallocMemorySummary::_stripes[MallocMemorySummary::stripe_count];
 
 void MemoryCounter::update_peak(size_t size, size_t cnt) {
   size_t peak_sz = peak_size();
@@ -72,6 +74,45 @@ void MallocMemorySummary::initialize() {
   ::new ((void*)_snapshot)MallocMemorySnapshot();
 }
 
+MallocCounterStripe* MallocMemorySummary::current_stripe() {
+  // Threads not attached to the VM share the first stripe.
+  uintptr_t hash = (uintptr_t)Thread::current_or_null();
+  hash ^= hash >> 12;
+  return &_stripes[(hash >> 6) % stripe_count];
+}
+
+static inline ssize_t take(volatile ssize_t* counter) {
+  return Atomic::load(counter) == 0 ? 0 : Atomic::xchg(counter, (ssize_t)0);
+}
+
+// Moves the changes collected in the stripes into the snapshot. The changes
+// of each type are summed over all stripes first, since a block may be
+// allocated and freed by threads on different stripes.
+void MallocMemorySummary::fold_stripes() {
+  MallocMemorySnapshot* snapshot = as_snapshot();
+  ssize_t all_count = 0;
+  ssize_t all_size = 0;
+  for (int index = 0; index < mt_number_of_types; index ++) {
+    ssize_t malloc_count = 0;
+    ssize_t malloc_size = 0;
+    ssize_t arena_count = 0;
+    ssize_t arena_size = 0;
+    for (int i = 0; i < stripe_count; i++) {
+      MallocCounterStripe* stripe = &_stripes[i];
+      malloc_count += take(&stripe->_malloc_count[index]);
+      malloc_size += take(&stripe->_malloc_size[index]);
+      arena_count += take(&stripe->_arena_count[index]);
+      arena_size += take(&stripe->_arena_size[index]);
+    }
+    snapshot->_malloc[index].record_changes(malloc_count, malloc_size, arena_count, arena_size);
+    all_count += malloc_count;
+    all_size += malloc_size;
+  }
+  if (all_count != 0 || all_size != 0) {
+    snapshot->_all_mallocs.add(all_count, all_size);
+  }
+}
+
 void MallocHeader::mark_block_as_dead() {
   _canary = _header_canary_dead_mark;
   NOT_LP64(_alt_canary = _header_alt_canary_dead_mark);
@@ -172,7 +213,56 @@ void MallocHeader::check_block_integrity() const {
 }
 
 bool MallocHeader::get_stack(NativeCallStack& stack) const {
-  return MallocSiteTable::access_stack(stack, _mst_marker);
+  return has_site() && MallocSiteTable::access_stack(stack, _mst_marker);
+}
+
+// The call sites are sampled like allocations in heap profilers: the distance
+// to the next sampled byte is drawn from an exponential distribution with
+// NativeMemoryTrackingSampleInterval as mean.
+static size_t _unattached_bytes_until_sample = 0;
+
+static size_t& bytes_until_sample() {
+  Thread* thread = Thread::current_or_null();
+  // Threads not attached to the VM share an unsynchronized countdown,
+  // which only makes their samples less even.
+  return thread != NULL ? thread->nmt_bytes_until_sample() : _unattached_bytes_until_sample;
+}
+
+static size_t next_sample_distance() {
+  // Uniformly distributed in (0, 1]
+  double u = ((double)os::random() + 1.0) / ((double)max_jint + 1.0);
+  return (size_t)(-log(u) * (double)NativeMemoryTrackingSampleInterval) + 1;
+}
+
+bool MallocTracker::will_sample(size_t size) {
+  return NativeMemoryTrackingSampleInterval == 0 ||
+         MAX2((size_t)1, size) >= bytes_until_sample();
+}
+
+static bool sample(size_t size) {
+  if (NativeMemoryTrackingSampleInterval == 0) {
+    return true;
+  }
+  size_t& remaining = bytes_until_sample();
+  if (size < remaining) {
+    remaining -= size;
+    return false;
+  }
+  remaining = next_sample_distance();
+  return true;
+}
+
+// The number of allocations and bytes a sampled allocation of the given
+// size stands for: it is sampled with probability 1 - e^(-size / interval).
+static void sample_weight(size_t size, size_t* count, size_t* amount) {
+  if (NativeMemoryTrackingSampleInterval == 0) {
+    *count = 1;
+    *amount = size;
+    return;
+  }
+  double weight = 1.0 / (1.0 - exp(-(double)size / (double)NativeMemoryTrackingSampleInterval));
+  *count = (size_t)(weight + 0.5);
+  *amount = (size_t)((double)size * weight + 0.5);
 }
 
 bool MallocTracker::initialize(NMT_TrackingLevel level) {
@@ -195,12 +285,16 @@ void* MallocTracker::record_malloc(void* malloc_base, size_t size, MEMFLAGS flag
 
   MallocMemorySummary::record_malloc(size, flags);
   uint32_t mst_marker = 0;
-  if (MemTracker::tracking_level() == NMT_detail) {
-    MallocSiteTable::allocation_at(stack, size, &mst_marker, flags);
+  bool has_site = false;
+  if (MemTracker::tracking_level() == NMT_detail && sample(size) &&
+      (NativeMemoryTrackingSampleInterval == 0 || !stack.is_empty())) {
+    size_t count, amount;
+    sample_weight(size, &count, &amount);
+    has_site = MallocSiteTable::allocation_at(stack, amount, count, &mst_marker, flags);
   }
 
   // Uses placement global new operator to initialize malloc header
-  MallocHeader* const header = ::new (malloc_base)MallocHeader(size, flags, stack, mst_marker);
+  MallocHeader* const header = ::new (malloc_base)MallocHeader(size, flags, stack, mst_marker, has_site);
   void* const memblock = (void*)((char*)malloc_base + sizeof(MallocHeader));
 
   // The alignment check: 8 bytes alignment for 32 bit systems.
@@ -228,8 +322,10 @@ void* MallocTracker::record_free(void* memblock) {
   header->check_block_integrity();
 
   MallocMemorySummary::record_free(header->size(), header->flags());
-  if (MemTracker::tracking_level() == NMT_detail) {
-    MallocSiteTable::deallocation_at(header->size(), header->mst_marker());
+  if (MemTracker::tracking_level() == NMT_detail && header->has_site()) {
+    size_t count, amount;
+    sample_weight(header->size(), &count, &amount);
+    MallocSiteTable::deallocation_at(amount, count, header->mst_marker());
   }
 
   header->mark_block_as_dead();
@@ -28,6 +28,7 @@
 #if INCLUDE_NMT
 
 #include "memory/allocation.hpp"
+#include "memory/padded.hpp"
 #include "runtime/atomic.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/nmtCommon.hpp"
@@ -77,6 +78,15 @@ class MemoryCounter {
     }
   }
 
+  // Applies the changes collected from the counter stripes
+  inline void add(ssize_t cnt, ssize_t sz) {
+    size_t c = Atomic::add(&_count, size_t(cnt), memory_order_relaxed);
+    size_t sum = Atomic::add(&_size, size_t(sz), memory_order_relaxed);
+    if (sz > 0) {
+      update_peak(sum, c);
+    }
+  }
+
   inline size_t count() const { return Atomic::load(&_count); }
   inline size_t size()  const { return Atomic::load(&_size);  }
 
@@ -122,6 +132,16 @@ class MallocMemory {
     _arena.resize(sz);
   }
 
+  inline void record_changes(ssize_t malloc_count, ssize_t malloc_size,
+                             ssize_t arena_count, ssize_t arena_size) {
+    if (malloc_count != 0 || malloc_size != 0) {
+      _malloc.add(malloc_count, malloc_size);
+    }
+    if (arena_count != 0 || arena_size != 0) {
+      _arena.add(arena_count, arena_size);
+    }
+  }
+
   inline size_t malloc_size()  const { return _malloc.size(); }
   inline size_t malloc_peak_size()  const { return _malloc.peak_size(); }
   inline size_t malloc_count() const { return _malloc.count();}
@@ -183,45 +203,73 @@ class MallocMemorySnapshot : public ResourceObj {
 };
 
 /*
- * This class is for collecting malloc statistics at summary level
+ * Changes to the malloc statistics not yet folded into the summary.
+ * Threads are spread over the stripes so that they do not contend on
+ * the same cache lines.
+ */
+struct MallocCounterStripe {
+  volatile ssize_t _malloc_count[mt_number_of_types];
+  volatile ssize_t _malloc_size[mt_number_of_types];
+  volatile ssize_t _arena_count[mt_number_of_types];
+  volatile ssize_t _arena_size[mt_number_of_types];
+};
+
+/*
+ * This class is for collecting malloc statistics at summary level.
+ * The statistics are recorded into the counter stripes and folded into
+ * the snapshot when it is read, so peaks are as of the last fold.
  */
 class MallocMemorySummary : AllStatic {
  private:
   // Reserve memory for placement of MallocMemorySnapshot object
   static size_t _snapshot[CALC_OBJ_SIZE_IN_TYPE(MallocMemorySnapshot, size_t)];
 
+  static const int stripe_count = 16;
+  static PaddedEnd<MallocCounterStripe> _stripes[stripe_count];
+
+  static MallocCounterStripe* current_stripe();
+  static void fold_stripes();
+
  public:
    static void initialize();
 
    static inline void record_malloc(size_t size, MEMFLAGS flag) {
-     as_snapshot()->by_type(flag)->record_malloc(size);
-     as_snapshot()->_all_mallocs.allocate(size);
+     MallocCounterStripe* stripe = current_stripe();
+     int index = NMTUtil::flag_to_index(flag);
+     Atomic::inc(&stripe->_malloc_count[index], memory_order_relaxed);
+     Atomic::add(&stripe->_malloc_size[index], (ssize_t)size, memory_order_relaxed);
    }
 
    static inline void record_free(size_t size, MEMFLAGS flag) {
-     as_snapshot()->by_type(flag)->record_free(size);
-     as_snapshot()->_all_mallocs.deallocate(size);
+     MallocCounterStripe* stripe = current_stripe();
+     int index = NMTUtil::flag_to_index(flag);
+     Atomic::dec(&stripe->_malloc_count[index], memory_order_relaxed);
+     Atomic::sub(&stripe->_malloc_size[index], (ssize_t)size, memory_order_relaxed);
    }
 
    static inline void record_new_arena(MEMFLAGS flag) {
-     as_snapshot()->by_type(flag)->record_new_arena();
+     Atomic::inc(&current_stripe()->_arena_count[NMTUtil::flag_to_index(flag)], memory_order_relaxed);
    }
 
    static inline void record_arena_free(MEMFLAGS flag) {
-     as_snapshot()->by_type(flag)->record_arena_free();
+     Atomic::dec(&current_stripe()->_arena_count[NMTUtil::flag_to_index(flag)], memory_order_relaxed);
    }
 
    static inline void record_arena_size_change(ssize_t size, MEMFLAGS flag) {
-     as_snapshot()->by_type(flag)->record_arena_size_change(size);
+     if (size != 0) {
+       Atomic::add(&current_stripe()->_arena_size[NMTUtil::flag_to_index(flag)], size, memory_order_relaxed);
+     }
    }
 
    static void snapshot(MallocMemorySnapshot* s) {
+     fold_stripes();
      as_snapshot()->copy_to(s);
      s->make_adjustment();
    }
 
    // The memory used by malloc tracking headers
    static inline size_t tracking_overhead() {
+     fold_stripes();
      return as_snapshot()->malloc_overhead();
    }
 
@@ -261,7 +309,7 @@ class MallocMemorySummary : AllStatic {
  *
  *           8        9        10       11       12       13       14       15          16 ++
  *       +--------+--------+--------+--------+--------+--------+--------+--------+  ------------------------
- *  ...  |   malloc site table marker        | flags  | unused |     canary      |  ... User payload ....
+ *  ...  |   malloc site table marker        | flags  |  site  |     canary      |  ... User payload ....
  *       +--------+--------+--------+--------+--------+--------+--------+--------+  ------------------------
  *
  * Layout on 32-bit:
@@ -273,7 +321,7 @@ class MallocMemorySummary : AllStatic {
  *
  *           8        9        10       11       12       13       14       15          16 ++
  *       +--------+--------+--------+--------+--------+--------+--------+--------+  ------------------------
- *  ...  |   malloc site table marker        | flags  | unused |     canary      |  ... User payload ....
+ *  ...  |   malloc site table marker        | flags  |  site  |     canary      |  ... User payload ....
  *       +--------+--------+--------+--------+--------+--------+--------+--------+  ------------------------
  *
  * Notes:
@@ -291,7 +339,7 @@ class MallocHeader {
   const size_t _size;
   const uint32_t _mst_marker;
   const uint8_t _flags;
-  const uint8_t _unused;
+  const uint8_t _has_site;
   uint16_t _canary;
 
   static const uint16_t _header_canary_life_mark = 0xE99E;
@@ -314,9 +362,9 @@ class MallocHeader {
 
  public:
 
-  MallocHeader(size_t size, MEMFLAGS flags, const NativeCallStack& stack, uint32_t mst_marker)
+  MallocHeader(size_t size, MEMFLAGS flags, const NativeCallStack& stack, uint32_t mst_marker, bool has_site)
     : _size(size), _mst_marker(mst_marker), _flags(NMTUtil::flag_to_index(flags)),
-      _unused(0), _canary(_header_canary_life_mark)
+      _has_site(has_site ? 1 : 0), _canary(_header_canary_life_mark)
   {
     assert(size < max_reasonable_malloc_size, "Too large allocation size?");
     // On 32-bit we have some bits more, use them for a second canary
@@ -328,6 +376,8 @@ class MallocHeader {
   inline size_t   size()  const { return _size; }
   inline MEMFLAGS flags() const { return (MEMFLAGS)_flags; }
   inline uint32_t mst_marker() const { return _mst_marker; }
+  // Whether the allocation was recorded in the malloc site table
+  inline bool has_site() const { return _has_site != 0; }
   bool get_stack(NativeCallStack& stack) const;
 
   void mark_block_as_dead();
@@ -368,6 +418,10 @@ class MallocTracker : AllStatic {
   static void* record_malloc(void* malloc_base, size_t size, MEMFLAGS flags,
     const NativeCallStack& stack);
 
+  // Whether the next malloc of the given size by the current thread
+  // records its call site, see NativeMemoryTrackingSampleInterval
+  static bool will_sample(size_t size);
+
   // Record free on specified memory block
   static void* record_free(void* memblock);
 
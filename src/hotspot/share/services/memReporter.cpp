@@ -243,7 +243,7 @@ void MemSummaryReporter::report_summary_of_type(MEMFLAGS flag,
     }
 
     if (amount_in_current_scale(malloc_memory->arena_size()) > 0
-        DEBUG_ONLY(|| amount_in_current_scale(malloc_memory->arena_peak_size()) > 0)) {
+        || amount_in_current_scale(malloc_memory->arena_peak_size()) > 0) {
       print_arena_line(malloc_memory->arena_counter());
     }
 
@@ -34,6 +34,7 @@
 
 #define CURRENT_PC   NativeCallStack::empty_stack()
 #define CALLER_PC    NativeCallStack::empty_stack()
+#define CALLER_PC_FOR_MALLOC(size) NativeCallStack::empty_stack()
 
 class Tracker : public StackObj {
  public:
@@ -93,6 +94,10 @@ class MemTracker : AllStatic {
                     NativeCallStack(0) : FAKE_CALLSTACK)
 #define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail) ?  \
                     NativeCallStack(1) : FAKE_CALLSTACK)
+// Only walks the stack if the malloc of the given size is going to be sampled
+#define CALLER_PC_FOR_MALLOC(size) ((MemTracker::tracking_level() == NMT_detail) ? \
+                    (MallocTracker::will_sample(size) ? NativeCallStack(1) : NativeCallStack::empty_stack()) : \
+                    FAKE_CALLSTACK)
 
 class MemBaseline;
 
@@ -213,6 +213,14 @@ inline BitMap::idx_t BitMap::get_next_bit_impl(idx_t l_index, idx_t r_index) con
         ? to_words_align_down(r_index) // Miniscule savings when aligned.
         : to_words_align_up(r_index);
       while (++index < limit) {
+        // Sparse maps have long runs of uninteresting words, so skip
+        // them a block of words at a time.
+        while ((index + 4 <= limit) &&
+               (((map(index) ^ flip) | (map(index + 1) ^ flip) |
+                 (map(index + 2) ^ flip) | (map(index + 3) ^ flip)) == 0)) {
+          index += 4;
+        }
+        if (index >= limit) break;
         cword = map(index) ^ flip;
         if (cword != 0) {
           idx_t result = bit_index(index) + count_trailing_zeros(cword);
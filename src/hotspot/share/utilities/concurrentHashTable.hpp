@@ -49,9 +49,12 @@ class ConcurrentHashTable : public CHeapObj<F> {
    private:
     Node * volatile _next;
     VALUE _value;
+    // The hash of _value, compared before LOOKUP_FUNC::equals() so that walking
+    // a bucket does not dereference the values of the colliding nodes.
+    uintx _hash;
    public:
-    Node(const VALUE& value, Node* next = NULL)
-      : _next(next), _value(value) {
+    Node(const VALUE& value, uintx hash, Node* next = NULL)
+      : _next(next), _value(value), _hash(hash) {
       assert((((uintptr_t)this) & ((uintptr_t)0x3)) == 0,
              "Must 16 bit aligned.");
     }
@@ -62,9 +65,12 @@ class ConcurrentHashTable : public CHeapObj<F> {
 
     VALUE* value()                    { return &_value; }
 
+    uintx hash() const                { return _hash; }
+    void set_hash(uintx hash)         { _hash = hash; }
+
     // Creates a node.
-    static Node* create_node(void* context, const VALUE& value, Node* next = NULL) {
-      return new (CONFIG::allocate_node(context, sizeof(Node), value)) Node(value, next);
+    static Node* create_node(void* context, const VALUE& value, uintx hash, Node* next = NULL) {
+      return new (CONFIG::allocate_node(context, sizeof(Node), value)) Node(value, hash, next);
     }
     // Destroys a node.
     static void destroy_node(void* context, Node* node) {
@@ -284,7 +290,7 @@ class ConcurrentHashTable : public CHeapObj<F> {
   // Return correct bucket for updates and handles resizing.
   Bucket* get_bucket_locked(Thread* thread, const uintx hash);
 
-  // Finds a node.
+  // Finds a node. Dead nodes are only looked for when have_dead is not NULL.
   template <typename LOOKUP_FUNC>
   Node* get_node(const Bucket* const bucket, LOOKUP_FUNC& lookup_f,
                  bool* have_dead, size_t* loops = NULL) const;
@@ -303,6 +309,10 @@ class ConcurrentHashTable : public CHeapObj<F> {
   bool internal_grow_prolog(Thread* thread, size_t log2_size);
   void internal_grow_epilog(Thread* thread);
   void internal_grow_range(Thread* thread, size_t start, size_t stop);
+
+  // Moves the nodes in buckets [start, stop) to to_cht, which other threads
+  // may be moving nodes to at the same time but which is otherwise unused.
+  void internal_move_range(size_t start, size_t stop, ConcurrentHashTable<CONFIG, F>* to_cht);
   bool internal_grow(Thread* thread, size_t log2_size);
 
   // Get a value.
@@ -512,6 +522,7 @@ class ConcurrentHashTable : public CHeapObj<F> {
  public:
   class BulkDeleteTask;
   class GrowTask;
+  class MoveTask;
 };
 
 #endif // SHARE_UTILITIES_CONCURRENTHASHTABLE_HPP
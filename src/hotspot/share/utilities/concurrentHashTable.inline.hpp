@@ -453,8 +453,9 @@ inline bool ConcurrentHashTable<CONFIG, F>::
   assert(bucket->is_locked(), "Must be locked.");
   Node* const volatile * rem_n_prev = bucket->first_ptr();
   Node* rem_n = bucket->first();
+  uintx hash = lookup_f.get_hash();
   while (rem_n != NULL) {
-    if (lookup_f.equals(rem_n->value())) {
+    if (rem_n->hash() == hash && lookup_f.equals(rem_n->value())) {
       bucket->release_assign_node_ptr(rem_n_prev, rem_n->next());
       break;
     } else {
@@ -617,13 +618,14 @@ ConcurrentHashTable<CONFIG, F>::
            bool* have_dead, size_t* loops) const
 {
   size_t loop_count = 0;
+  uintx hash = lookup_f.get_hash();
   Node* node = bucket->first();
   while (node != NULL) {
     ++loop_count;
-    if (lookup_f.equals(node->value())) {
+    if (node->hash() == hash && lookup_f.equals(node->value())) {
       break;
     }
-    if (!(*have_dead) && lookup_f.is_dead(node->value())) {
+    if (have_dead != NULL && !(*have_dead) && lookup_f.is_dead(node->value())) {
       *have_dead = true;
     }
     node = node->next();
@@ -862,12 +864,12 @@ template <typename LOOKUP_FUNC>
 inline typename CONFIG::Value* ConcurrentHashTable<CONFIG, F>::
   internal_get(Thread* thread, LOOKUP_FUNC& lookup_f, bool* grow_hint)
 {
-  bool clean = false;
   size_t loops = 0;
   VALUE* ret = NULL;
 
+  // Lookups do not clean, so they do not look for dead nodes either.
   const Bucket* bucket = get_bucket(lookup_f.get_hash());
-  Node* node = get_node(bucket, lookup_f, &clean, &loops);
+  Node* node = get_node(bucket, lookup_f, NULL, &loops);
   if (node != NULL) {
     ret = node->value();
   }
@@ -890,7 +892,7 @@ inline bool ConcurrentHashTable<CONFIG, F>::
   size_t loops = 0;
   size_t i = 0;
   uintx hash = lookup_f.get_hash();
-  Node* new_node = Node::create_node(_context, value, NULL);
+  Node* new_node = Node::create_node(_context, value, hash, NULL);
 
   while (true) {
     {
@@ -1090,7 +1092,7 @@ inline bool ConcurrentHashTable<CONFIG, F>::
   InternalTable* table = get_table();
   Bucket* bucket = get_bucket_in(table, hash);
   assert(!bucket->have_redirect() && !bucket->is_locked(), "bad");
-  Node* new_node = Node::create_node(_context, value, bucket->first());
+  Node* new_node = Node::create_node(_context, value, hash, bucket->first());
   if (!bucket->cas_first(new_node, bucket->first())) {
     assert(false, "bad");
   }
@@ -1268,7 +1270,16 @@ inline bool ConcurrentHashTable<CONFIG, F>::
     return false;
   }
   assert(_new_table == NULL || _new_table == POISON_PTR, "Must be NULL");
-  for (size_t bucket_it = 0; bucket_it < _table->_size; bucket_it++) {
+  internal_move_range(0, _table->_size, to_cht);
+  unlock_resize_lock(thread);
+  return true;
+}
+
+template <typename CONFIG, MEMFLAGS F>
+inline void ConcurrentHashTable<CONFIG, F>::
+  internal_move_range(size_t start, size_t stop, ConcurrentHashTable<CONFIG, F>* to_cht)
+{
+  for (size_t bucket_it = start; bucket_it < stop; bucket_it++) {
     Bucket* bucket = _table->get_bucket(bucket_it);
     assert(!bucket->have_redirect() && !bucket->is_locked(), "Table must be uncontended");
     while (bucket->first() != NULL) {
@@ -1279,15 +1290,18 @@ inline bool ConcurrentHashTable<CONFIG, F>::
       size_t insert_hash = CONFIG::get_hash(*move_node->value(), &dead_hash);
       if (!dead_hash) {
         Bucket* insert_bucket = to_cht->get_bucket(insert_hash);
-        assert(!bucket->have_redirect() && !bucket->is_locked(), "Not bit should be present");
-        move_node->set_next(insert_bucket->first());
-        ok = insert_bucket->cas_first(move_node, insert_bucket->first());
-        assert(ok, "Uncontended cas must work");
+        assert(!insert_bucket->have_redirect() && !insert_bucket->is_locked(), "Not bit should be present");
+        // The target table may hash differently, e.g. with an alternate hash.
+        move_node->set_hash(insert_hash);
+        // Threads moving other ranges may insert into the same bucket.
+        Node* first;
+        do {
+          first = insert_bucket->first();
+          move_node->set_next(first);
+        } while (!insert_bucket->cas_first(move_node, first));
       }
     }
   }
-  unlock_resize_lock(thread);
-  return true;
 }
 
 #endif // SHARE_UTILITIES_CONCURRENTHASHTABLE_INLINE_HPP
@@ -31,8 +31,8 @@
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/concurrentHashTable.inline.hpp"
 
-// This inline file contains BulkDeleteTask and GrowTasks which are both bucket
-// operations, which they are serialized with each other.
+// This inline file contains BulkDeleteTask, GrowTask and MoveTask which are all
+// bucket operations, which they are serialized with each other.
 
 // Base class for pause and/or parallel bulk operations.
 template <typename CONFIG, MEMFLAGS F>
@@ -202,4 +202,49 @@ class ConcurrentHashTable<CONFIG, F>::GrowTask :
   }
 };
 
+// For moving all nodes to another table in parallel, e.g. to one that hashes
+// differently. The other table must not be used by anyone else meanwhile.
+template <typename CONFIG, MEMFLAGS F>
+class ConcurrentHashTable<CONFIG, F>::MoveTask :
+  public BucketsOperation
+{
+  ConcurrentHashTable<CONFIG, F>* _to_cht;
+ public:
+  MoveTask(ConcurrentHashTable<CONFIG, F>* cht, ConcurrentHashTable<CONFIG, F>* to_cht)
+    : BucketsOperation(cht, true), _to_cht(to_cht) {
+  }
+  // Before start prepare must be called.
+  bool prepare(Thread* thread) {
+    bool lock = BucketsOperation::_cht->try_resize_lock(thread);
+    if (!lock) {
+      return false;
+    }
+    assert(BucketsOperation::_cht->_new_table == NULL ||
+           BucketsOperation::_cht->_new_table == POISON_PTR, "Must be NULL");
+    this->setup(thread);
+    return true;
+  }
+
+  // Moves the nodes of one range. Any thread may call this, as long as
+  // prepare and done are called by the same one. Returns true if there is
+  // more work.
+  bool do_task(Thread* thread) {
+    size_t start, stop;
+    assert(BucketsOperation::_cht->_resize_lock_owner != NULL,
+           "Should be locked");
+    if (!this->claim(&start, &stop)) {
+      return false;
+    }
+    BucketsOperation::_cht->internal_move_range(start, stop, _to_cht);
+    return true;
+  }
+
+  // Must be called after ranges are done.
+  void done(Thread* thread) {
+    this->thread_owns_resize_lock(thread);
+    BucketsOperation::_cht->unlock_resize_lock(thread);
+    this->thread_do_not_own_resize_lock(thread);
+  }
+};
+
 #endif // SHARE_UTILITIES_CONCURRENTHASHTABLETASKS_INLINE_HPP
@@ -486,7 +486,8 @@ void GrowableArrayWithAllocator<E, Derived>::grow(int j) {
   // j < _max
   E* newData = static_cast<Derived*>(this)->allocate();
   int i = 0;
-  for (     ; i < this->_len; i++) ::new ((void*)&newData[i]) E(this->_data[i]);
+  // the old elements are destroyed right after, so they can be moved from
+  for (     ; i < this->_len; i++) ::new ((void*)&newData[i]) E(static_cast<E&&>(this->_data[i]));
   for (     ; i < this->_max; i++) ::new ((void*)&newData[i]) E();
   for (i = 0; i < old_max; i++) this->_data[i].~E();
   if (this->_data != NULL) {
@@ -750,6 +751,50 @@ public:
   }
 };
 
+// Storage for the inline elements of a GrowableArrayWithInline. It is a
+// base class so that it exists before GrowableArrayWithAllocator constructs
+// the elements in it.
+template <typename E, int N>
+class GrowableArrayInlineStorage {
+  alignas(E) char _storage[N * sizeof(E)];
+
+protected:
+  E* inline_data() { return reinterpret_cast<E*>(_storage); }
+};
+
+// Resource GrowableArray with room for N elements inside the instance.
+// The elements stay inline until the array grows beyond N, and only then
+// spill into the resource area, so small transient lists don't allocate.
+// Only for stack allocation; pass it around as a GrowableArrayView.
+template <typename E, int N>
+class GrowableArrayWithInline : private GrowableArrayInlineStorage<E, N>,
+                                public GrowableArrayWithAllocator<E, GrowableArrayWithInline<E, N> > {
+  friend class GrowableArrayWithAllocator<E, GrowableArrayWithInline<E, N> >;
+
+  STATIC_ASSERT(N > 0);
+
+  // resource area nesting at creation
+  debug_only(GrowableArrayNestingCheck _nesting_check;)
+
+  NONCOPYABLE(GrowableArrayWithInline);
+
+  E* allocate() {
+    debug_only(_nesting_check.on_stack_alloc());
+    return (E*)GrowableArrayResourceAllocator::allocate(this->_max, sizeof(E));
+  }
+
+  void deallocate(E* mem) {
+    // Neither the inline data nor resource allocations are freed
+  }
+
+public:
+  GrowableArrayWithInline() :
+      GrowableArrayInlineStorage<E, N>(),
+      GrowableArrayWithAllocator<E, GrowableArrayWithInline<E, N> >(
+          this->inline_data(), N)
+      debug_only(COMMA _nesting_check(true)) {}
+};
+
 // Custom STL-style iterator to iterate over GrowableArrays
 // It is constructed by invoking GrowableArray::begin() and GrowableArray::end()
 template <typename E>
@@ -22,8 +22,8 @@
  *
  */
 
-#ifndef SHARE_JFR_LEAKPROFILER_CHAINS_BITSET_HPP
-#define SHARE_JFR_LEAKPROFILER_CHAINS_BITSET_HPP
+#ifndef SHARE_UTILITIES_OBJECTBITSET_HPP
+#define SHARE_UTILITIES_OBJECTBITSET_HPP
 
 #include "memory/allocation.hpp"
 #include "oops/oop.hpp"
@@ -31,24 +31,33 @@
 #include "utilities/bitMap.hpp"
 #include "utilities/hashtable.hpp"
 
-class JfrVirtualMemory;
 class MemRegion;
 
-class BitSet : public CHeapObj<mtTracing> {
+/*
+ * ObjectBitSet is a sparse bitmap for marking objects in the Java heap.
+ * It holds one bit for every possible object start in the Java heap.
+ * The bitmap is implemented as a set of fragments, an individual
+ * fragment is allocated on demand when an address in the range of
+ * the fragment is first marked.
+ * Marking does not touch the object headers, so it can be used with
+ * any collector and leaves the mark words (and identity hashes) intact.
+ */
+template<MEMFLAGS F>
+class ObjectBitSet : public CHeapObj<F> {
   const static size_t _bitmap_granularity_shift = 26; // 64M
   const static size_t _bitmap_granularity_size = (size_t)1 << _bitmap_granularity_shift;
   const static size_t _bitmap_granularity_mask = _bitmap_granularity_size - 1;
 
   class BitMapFragment;
 
-  class BitMapFragmentTable : public BasicHashtable<mtTracing> {
-    class Entry : public BasicHashtableEntry<mtTracing> {
+  class BitMapFragmentTable : public BasicHashtable<F> {
+    class Entry : public BasicHashtableEntry<F> {
     public:
       uintptr_t _key;
       CHeapBitMap* _value;
 
       Entry* next() {
-        return (Entry*)BasicHashtableEntry<mtTracing>::next();
+        return (Entry*)BasicHashtableEntry<F>::next();
       }
     };
 
@@ -63,11 +72,11 @@ class BitSet : public CHeapObj<mtTracing> {
     }
 
     unsigned hash_to_index(unsigned hash) {
-      return hash & (BasicHashtable<mtTracing>::table_size() - 1);
+      return hash & (BasicHashtable<F>::table_size() - 1);
     }
 
   public:
-    BitMapFragmentTable(int table_size) : BasicHashtable<mtTracing>(table_size, sizeof(Entry)) {}
+    BitMapFragmentTable(int table_size) : BasicHashtable<F>(table_size, sizeof(Entry)) {}
     ~BitMapFragmentTable();
     void add(uintptr_t key, CHeapBitMap* value);
     CHeapBitMap** lookup(uintptr_t key);
@@ -81,8 +90,8 @@ class BitSet : public CHeapObj<mtTracing> {
   uintptr_t _last_fragment_granule;
 
  public:
-  BitSet();
-  ~BitSet();
+  ObjectBitSet();
+  ~ObjectBitSet();
 
   BitMap::idx_t addr_to_bit(uintptr_t addr) const;
 
@@ -99,7 +108,8 @@ class BitSet : public CHeapObj<mtTracing> {
   }
 };
 
-class BitSet::BitMapFragment : public CHeapObj<mtTracing> {
+template<MEMFLAGS F>
+class ObjectBitSet<F>::BitMapFragment : public CHeapObj<F> {
   CHeapBitMap _bits;
   BitMapFragment* _next;
 
@@ -115,4 +125,4 @@ public:
   }
 };
 
-#endif // SHARE_JFR_LEAKPROFILER_CHAINS_BITSET_HPP
+#endif // SHARE_UTILITIES_OBJECTBITSET_HPP
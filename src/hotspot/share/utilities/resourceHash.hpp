@@ -26,45 +26,47 @@
 #define SHARE_UTILITIES_RESOURCEHASH_HPP
 
 #include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
 
+template<typename K, typename V>
+class ResourceHashtableNode : public ResourceObj {
+public:
+  unsigned _hash;
+  K _key;
+  V _value;
+  ResourceHashtableNode* _next;
+
+  ResourceHashtableNode(unsigned hash, K const& key, V const& value) :
+      _hash(hash), _key(key), _value(value), _next(NULL) {}
+
+  // Create a node with a default-constructed value.
+  ResourceHashtableNode(unsigned hash, K const& key) :
+      _hash(hash), _key(key), _value(), _next(NULL) {}
+};
+
+// The table operations, on top of a STORAGE that provides the buckets:
+//  - unsigned STORAGE::table_size() const
+//  - Node** STORAGE::table() const
+//  - void STORAGE::grow_if_needed(int number_of_entries)
 template<
+    class STORAGE,
     typename K, typename V,
-    // xlC does not compile this:
-    // http://stackoverflow.com/questions/8532961/template-argument-of-type-that-is-defined-by-inner-typedef-from-other-template-c
-    //typename ResourceHashtableFns<K>::hash_fn   HASH   = primitive_hash<K>,
-    //typename ResourceHashtableFns<K>::equals_fn EQUALS = primitive_equals<K>,
-    unsigned (*HASH)  (K const&)           = primitive_hash<K>,
-    bool     (*EQUALS)(K const&, K const&) = primitive_equals<K>,
-    unsigned SIZE = 256,
-    ResourceObj::allocation_type ALLOC_TYPE = ResourceObj::RESOURCE_AREA,
-    MEMFLAGS MEM_TYPE = mtInternal
+    ResourceObj::allocation_type ALLOC_TYPE,
+    MEMFLAGS MEM_TYPE,
+    unsigned (*HASH)  (K const&),
+    bool     (*EQUALS)(K const&, K const&)
     >
-class ResourceHashtable : public ResourceObj {
+class ResourceHashtableBase : public STORAGE {
  private:
+  typedef ResourceHashtableNode<K, V> Node;
 
-  class Node : public ResourceObj {
-   public:
-    unsigned _hash;
-    K _key;
-    V _value;
-    Node* _next;
-
-    Node(unsigned hash, K const& key, V const& value) :
-        _hash(hash), _key(key), _value(value), _next(NULL) {}
-
-    // Create a node with a default-constructed value.
-    Node(unsigned hash, K const& key) :
-        _hash(hash), _key(key), _value(), _next(NULL) {}
-
-  };
-
-  Node* _table[SIZE];
+  int _number_of_entries;
 
   // Returns a pointer to where the node where the value would reside if
   // it's in the table.
   Node** lookup_node(unsigned hash, K const& key) {
-    unsigned index = hash % SIZE;
-    Node** ptr = &_table[index];
+    unsigned index = hash % STORAGE::table_size();
+    Node** ptr = &STORAGE::table()[index];
     while (*ptr != NULL) {
       Node* node = *ptr;
       if (node->_hash == hash && EQUALS(key, node->_key)) {
@@ -77,16 +79,27 @@ class ResourceHashtable : public ResourceObj {
 
   Node const** lookup_node(unsigned hash, K const& key) const {
     return const_cast<Node const**>(
-        const_cast<ResourceHashtable*>(this)->lookup_node(hash, key));
+        const_cast<ResourceHashtableBase*>(this)->lookup_node(hash, key));
   }
 
- public:
-  ResourceHashtable() { memset(_table, 0, SIZE * sizeof(Node*)); }
+  // Links in a new node where lookup_node() found no match
+  V* add_node(Node** ptr, Node* node) {
+    *ptr = node;
+    _number_of_entries++;
+    STORAGE::grow_if_needed(_number_of_entries);
+    return &node->_value;
+  }
+
+ protected:
+  ResourceHashtableBase() : STORAGE(), _number_of_entries(0) {}
+  ResourceHashtableBase(unsigned size, unsigned max_size) :
+      STORAGE(size, max_size), _number_of_entries(0) {}
 
-  ~ResourceHashtable() {
-    if (ALLOC_TYPE == C_HEAP) {
-      Node* const* bucket = _table;
-      while (bucket < &_table[SIZE]) {
+  ~ResourceHashtableBase() {
+    if (ALLOC_TYPE == ResourceObj::C_HEAP) {
+      Node* const* bucket = STORAGE::table();
+      const unsigned size = STORAGE::table_size();
+      while (bucket < &STORAGE::table()[size]) {
         Node* node = *bucket;
         while (node != NULL) {
           Node* cur = node;
@@ -98,6 +111,10 @@ class ResourceHashtable : public ResourceObj {
     }
   }
 
+ public:
+  unsigned table_size() const { return STORAGE::table_size(); }
+  int number_of_entries() const { return _number_of_entries; }
+
   bool contains(K const& key) const {
     return get(key) != NULL;
   }
@@ -124,7 +141,7 @@ class ResourceHashtable : public ResourceObj {
       (*ptr)->_value = value;
       return false;
     } else {
-      *ptr = new (ALLOC_TYPE, MEM_TYPE) Node(hv, key, value);
+      add_node(ptr, new (ALLOC_TYPE, MEM_TYPE) Node(hv, key, value));
       return true;
     }
   }
@@ -138,12 +155,12 @@ class ResourceHashtable : public ResourceObj {
     unsigned hv = HASH(key);
     Node** ptr = lookup_node(hv, key);
     if (*ptr == NULL) {
-      *ptr = new (ALLOC_TYPE, MEM_TYPE) Node(hv, key);
       *p_created = true;
+      return add_node(ptr, new (ALLOC_TYPE, MEM_TYPE) Node(hv, key));
     } else {
       *p_created = false;
+      return &(*ptr)->_value;
     }
-    return &(*ptr)->_value;
   }
 
   // Look up the key.
@@ -155,12 +172,12 @@ class ResourceHashtable : public ResourceObj {
     unsigned hv = HASH(key);
     Node** ptr = lookup_node(hv, key);
     if (*ptr == NULL) {
-      *ptr = new (ALLOC_TYPE, MEM_TYPE) Node(hv, key, value);
       *p_created = true;
+      return add_node(ptr, new (ALLOC_TYPE, MEM_TYPE) Node(hv, key, value));
     } else {
       *p_created = false;
+      return &(*ptr)->_value;
     }
-    return &(*ptr)->_value;
   }
 
 
@@ -171,9 +188,10 @@ class ResourceHashtable : public ResourceObj {
     Node* node = *ptr;
     if (node != NULL) {
       *ptr = node->_next;
-      if (ALLOC_TYPE == C_HEAP) {
+      if (ALLOC_TYPE == ResourceObj::C_HEAP) {
         delete node;
       }
+      _number_of_entries--;
       return true;
     }
     return false;
@@ -184,8 +202,9 @@ class ResourceHashtable : public ResourceObj {
   // the iteration is cancelled.
   template<class ITER>
   void iterate(ITER* iter) const {
-    Node* const* bucket = _table;
-    while (bucket < &_table[SIZE]) {
+    Node* const* bucket = STORAGE::table();
+    const unsigned size = STORAGE::table_size();
+    while (bucket < &STORAGE::table()[size]) {
       Node* node = *bucket;
       while (node != NULL) {
         bool cont = iter->do_entry(node->_key, node->_value);
@@ -201,8 +220,9 @@ class ResourceHashtable : public ResourceObj {
   // the entry is deleted.
   template<class ITER>
   void unlink(ITER* iter) {
-    Node** bucket =  const_cast<Node**>(_table);
-    while (bucket < &_table[SIZE]) {
+    Node** bucket = STORAGE::table();
+    const unsigned size = STORAGE::table_size();
+    while (bucket < &STORAGE::table()[size]) {
       Node** ptr = bucket;
       while (*ptr != NULL) {
         Node* node = *ptr;
@@ -213,6 +233,7 @@ class ResourceHashtable : public ResourceObj {
           if (ALLOC_TYPE == ResourceObj::C_HEAP) {
             delete node;
           }
+          _number_of_entries--;
         } else {
           ptr = &(node->_next);
         }
@@ -220,8 +241,124 @@ class ResourceHashtable : public ResourceObj {
       ++bucket;
     }
   }
+};
 
+// Buckets of a table with a size fixed at compile time.
+template<unsigned TABLE_SIZE, typename K, typename V>
+class FixedResourceHashtableStorage : public ResourceObj {
+  typedef ResourceHashtableNode<K, V> Node;
+
+  Node* _table[TABLE_SIZE];
+
+ protected:
+  FixedResourceHashtableStorage() { memset(_table, 0, TABLE_SIZE * sizeof(Node*)); }
+
+  unsigned table_size() const { return TABLE_SIZE; }
+  Node** table() const { return const_cast<Node**>(_table); }
+  void grow_if_needed(int number_of_entries) {}
 };
 
+template<
+    typename K, typename V,
+    // xlC does not compile this:
+    // http://stackoverflow.com/questions/8532961/template-argument-of-type-that-is-defined-by-inner-typedef-from-other-template-c
+    //typename ResourceHashtableFns<K>::hash_fn   HASH   = primitive_hash<K>,
+    //typename ResourceHashtableFns<K>::equals_fn EQUALS = primitive_equals<K>,
+    unsigned (*HASH)  (K const&)           = primitive_hash<K>,
+    bool     (*EQUALS)(K const&, K const&) = primitive_equals<K>,
+    unsigned SIZE = 256,
+    ResourceObj::allocation_type ALLOC_TYPE = ResourceObj::RESOURCE_AREA,
+    MEMFLAGS MEM_TYPE = mtInternal
+    >
+class ResourceHashtable : public ResourceHashtableBase<
+  FixedResourceHashtableStorage<SIZE, K, V>,
+    K, V, ALLOC_TYPE, MEM_TYPE, HASH, EQUALS> {
+ public:
+  ResourceHashtable() : ResourceHashtableBase<FixedResourceHashtableStorage<SIZE, K, V>,
+                                              K, V, ALLOC_TYPE, MEM_TYPE, HASH, EQUALS>() {}
+};
+
+// Buckets of a table that doubles its size, up to max_size, whenever it
+// holds more than two entries per bucket. The nodes don't move when the
+// table grows, so pointers to values stay valid.
+template<typename K, typename V,
+         ResourceObj::allocation_type ALLOC_TYPE,
+         MEMFLAGS MEM_TYPE>
+class ResizeableResourceHashtableStorage : public ResourceObj {
+  typedef ResourceHashtableNode<K, V> Node;
+
+  unsigned _table_size;
+  const unsigned _max_size;
+  Node** _table;
+
+  static Node** allocate_table(unsigned size) {
+    Node** table;
+    if (ALLOC_TYPE == ResourceObj::C_HEAP) {
+      table = NEW_C_HEAP_ARRAY(Node*, size, MEM_TYPE);
+    } else {
+      table = NEW_RESOURCE_ARRAY(Node*, size);
+    }
+    memset(table, 0, size * sizeof(Node*));
+    return table;
+  }
+
+  static void free_table(Node** table) {
+    if (ALLOC_TYPE == ResourceObj::C_HEAP) {
+      FREE_C_HEAP_ARRAY(Node*, table);
+    }
+  }
+
+ protected:
+  ResizeableResourceHashtableStorage(unsigned size, unsigned max_size) :
+      _table_size(size), _max_size(MAX2(size, max_size)), _table(allocate_table(size)) {
+    assert(size > 0, "must have buckets");
+  }
+
+  ~ResizeableResourceHashtableStorage() {
+    free_table(_table);
+  }
+
+  unsigned table_size() const { return _table_size; }
+  Node** table() const { return _table; }
+
+  void grow_if_needed(int number_of_entries) {
+    if ((unsigned)number_of_entries <= 2 * _table_size || _table_size >= _max_size) {
+      return;
+    }
+    unsigned new_size = MIN2(2 * _table_size, _max_size);
+    Node** new_table = allocate_table(new_size);
+    for (unsigned index = 0; index < _table_size; index++) {
+      Node* node = _table[index];
+      while (node != NULL) {
+        Node* next = node->_next;
+        unsigned new_index = node->_hash % new_size;
+        node->_next = new_table[new_index];
+        new_table[new_index] = node;
+        node = next;
+      }
+    }
+    free_table(_table);
+    _table = new_table;
+    _table_size = new_size;
+  }
+};
+
+// A ResourceHashtable that starts with size buckets and grows with its
+// number of entries, for tables whose size is not known up front.
+template<
+    typename K, typename V,
+    unsigned (*HASH)  (K const&)           = primitive_hash<K>,
+    bool     (*EQUALS)(K const&, K const&) = primitive_equals<K>,
+    ResourceObj::allocation_type ALLOC_TYPE = ResourceObj::RESOURCE_AREA,
+    MEMFLAGS MEM_TYPE = mtInternal
+    >
+class ResizeableResourceHashtable : public ResourceHashtableBase<
+  ResizeableResourceHashtableStorage<K, V, ALLOC_TYPE, MEM_TYPE>,
+    K, V, ALLOC_TYPE, MEM_TYPE, HASH, EQUALS> {
+ public:
+  ResizeableResourceHashtable(unsigned size, unsigned max_size) :
+      ResourceHashtableBase<ResizeableResourceHashtableStorage<K, V, ALLOC_TYPE, MEM_TYPE>,
+                            K, V, ALLOC_TYPE, MEM_TYPE, HASH, EQUALS>(size, max_size) {}
+};
 
 #endif // SHARE_UTILITIES_RESOURCEHASH_HPP
@@ -87,10 +87,11 @@ void ImageDecompressor::image_decompressor_init() {
     if (_decompressors == NULL) {
         ZipInflateFully = (ZipInflateFully_t) findEntry("ZIP_InflateFully");
      assert(ZipInflateFully != NULL && "ZIP decompressor not found.");
-        _decompressors_num = 2;
+        _decompressors_num = 3;
         _decompressors = new ImageDecompressor*[_decompressors_num];
         _decompressors[0] = new ZipDecompressor("zip");
         _decompressors[1] = new SharedStringDecompressor("compact-cp");
+        _decompressors[2] = new Lz4Decompressor("lz4");
     }
 }
 
@@ -166,8 +167,13 @@ void ImageDecompressor::decompress_resource(u1* compressed, u1* uncompressed,
         compressed_resource += 1;
         has_header = _header._magic == ResourceHeader::resource_header_magic;
         if (has_header) {
-            // decompressed_resource array contains the result of decompression
-            decompressed_resource = new u1[(size_t) _header._uncompressed_size];
+            // decompressed_resource array contains the result of decompression.
+            // A stage that yields the whole resource, usually the only one,
+            // writes straight into the caller's buffer unless it reads from it.
+            bool into_caller = compressed_resource_base != uncompressed &&
+                               _header._uncompressed_size == uncompressed_size;
+            decompressed_resource = into_caller ? uncompressed :
+                                    new u1[(size_t) _header._uncompressed_size];
             // Retrieve the decompressor name
             const char* decompressor_name = strings->get(_header._decompressor_name_offset);
             assert(decompressor_name && "image decompressor not found");
@@ -177,14 +183,17 @@ void ImageDecompressor::decompress_resource(u1* compressed, u1* uncompressed,
             // Ask the decompressor to decompress the compressed content
             decompressor->decompress_resource(compressed_resource, decompressed_resource,
                 &_header, strings);
-            if (compressed_resource_base != compressed) {
+            if (compressed_resource_base != compressed &&
+                compressed_resource_base != uncompressed) {
                 delete[] compressed_resource_base;
             }
             compressed_resource = decompressed_resource;
         }
     } while (has_header);
-    memcpy(uncompressed, decompressed_resource, (size_t) uncompressed_size);
-    delete[] decompressed_resource;
+    if (decompressed_resource != uncompressed) {
+        memcpy(uncompressed, decompressed_resource, (size_t) uncompressed_size);
+        delete[] decompressed_resource;
+    }
 }
 
 // Zip decompressor
@@ -203,6 +212,76 @@ jboolean ZipDecompressor::decompress(void *in, u8 inSize, void *out, u8 outSize,
 
 // END Zip Decompressor
 
+// LZ4 decompressor
+
+void Lz4Decompressor::decompress_resource(u1* data, u1* uncompressed,
+                ResourceHeader* header, const ImageStrings* strings) {
+    bool res = Lz4Decompressor::decompress(data, header->_size, uncompressed,
+                    header->_uncompressed_size);
+    assert(res && "decompression failed");
+}
+
+/*
+ * Decodes an LZ4 block: a list of sequences, each a token byte, literals
+ * and a match. The high nibble of the token is the literal length and
+ * the low nibble the match length minus 4; 15 means that more length
+ * bytes follow, up to the first that is not 255. A match is a 2 byte
+ * little endian offset back into the output. The last sequence has
+ * literals only. Returns false if the block is malformed.
+ */
+bool Lz4Decompressor::decompress(const u1* in, u8 inSize, u1* out, u8 outSize) {
+    const u1* in_end = in + inSize;
+    u1* const out_start = out;
+    u1* const out_end = out + outSize;
+    while (in < in_end) {
+        u1 token = *in++;
+        u8 length = token >> 4;
+        if (length == 15) {
+            u1 b;
+            do {
+                if (in == in_end) return false;
+                b = *in++;
+                length += b;
+            } while (b == 255);
+        }
+        if (length > (u8)(in_end - in) || length > (u8)(out_end - out)) return false;
+        memcpy(out, in, (size_t)length);
+        in += length;
+        out += length;
+        if (in == in_end) {
+            break;
+        }
+        if (in_end - in < 2) return false;
+        size_t offset = in[0] | (in[1] << 8);
+        in += 2;
+        if (offset == 0 || offset > (size_t)(out - out_start)) return false;
+        length = (token & 15) + 4;
+        if ((token & 15) == 15) {
+            u1 b;
+            do {
+                if (in == in_end) return false;
+                b = *in++;
+                length += b;
+            } while (b == 255);
+        }
+        if (length > (u8)(out_end - out)) return false;
+        const u1* match = out - offset;
+        if (offset >= length) {
+            memcpy(out, match, (size_t)length);
+            out += length;
+        } else {
+            // The match overlaps the bytes it produces.
+            u1* end = out + length;
+            while (out < end) {
+                *out++ = *match++;
+            }
+        }
+    }
+    return out == out_end;
+}
+
+// END LZ4 decompressor
+
 // Shared String decompressor
 
 // array index is the constant pool tag. value is size.
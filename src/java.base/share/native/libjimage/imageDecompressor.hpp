@@ -127,6 +127,18 @@ public:
     static jboolean decompress(void *in, u8 inSize, void *out, u8 outSize, char **pmsg);
 };
 
+/**
+ * LZ4 decompressor. The compressed content is a single LZ4 block, which
+ * decompresses several times faster than zip at a slightly lower ratio.
+ */
+class Lz4Decompressor : public ImageDecompressor {
+public:
+    Lz4Decompressor(const char* sym) : ImageDecompressor(sym) { }
+    void decompress_resource(u1* data, u1* uncompressed, ResourceHeader* header,
+        const ImageStrings* strings);
+    static bool decompress(const u1* in, u8 inSize, u1* out, u8 outSize);
+};
+
 /*
  * Shared Strings decompressor. This decompressor reconstruct the class
  * constant pool UTF_U entries by retrieving strings stored in jimage strings table.
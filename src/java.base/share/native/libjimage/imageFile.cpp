@@ -538,10 +538,13 @@ void ImageFileReader::get_resource(ImageLocation& location, u1* uncompressed_dat
     // If the resource is compressed.
     if (compressed_size != 0) {
         u1* compressed_data;
+        // Most compressed classes fit here, which saves an allocation per read.
+        u1 small_buffer[8 * 1024];
         // If not memory mapped read in bytes.
         if (!memory_map_image) {
             // Allocate buffer for compression.
-            compressed_data = new u1[(size_t)compressed_size];
+            compressed_data = compressed_size <= sizeof(small_buffer) ? small_buffer :
+                              new u1[(size_t)compressed_size];
             assert(compressed_data != NULL && "allocation failed");
             // Read bytes from offset beyond the image index.
             bool is_read = read_at(compressed_data, compressed_size, _index_size + offset);
@@ -555,7 +558,7 @@ void ImageFileReader::get_resource(ImageLocation& location, u1* uncompressed_dat
         ImageDecompressor::decompress_resource(compressed_data, uncompressed_data, uncompressed_size,
                         &strings, _endian);
         // If not memory mapped then release temporary buffer.
-        if (!memory_map_image) {
+        if (!memory_map_image && compressed_data != small_buffer) {
                 delete[] compressed_data;
         }
     } else {
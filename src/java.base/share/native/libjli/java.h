@@ -118,6 +118,13 @@ GetApplicationHomeFromDll(char *buf, jint bufsize);
 
 #define GetArch() GetArchPath(CURRENT_DATA_MODEL)
 
+/*
+ * Restores the CRaC image named by -XX:CRaCRestoreFrom without loading the
+ * VM when the command line allows it. Returns if the VM has to be loaded,
+ * which then does the restore or reports why it cannot.
+ */
+void CracRestoreFromLauncher(int argc, char **argv, const char *jvmpath);
+
 /*
  * Different platforms will implement this, here
  * pargc is a pointer to the original argc,
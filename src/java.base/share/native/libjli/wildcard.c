@@ -89,12 +89,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <sys/types.h>
+#include <time.h>
 #include "java.h"       /* Strictly for PATH_SEPARATOR/FILE_SEPARATOR */
 #include "jli_util.h"
 
 #ifdef _WIN32
 #include <windows.h>
+#include <process.h>
 #else /* Unix */
 #include <unistd.h>
 #include <dirent.h>
@@ -280,6 +283,227 @@ isWildcard(const char *filename)
         (! exists(filename));
 }
 
+/*
+ * Optional cache of wildcard expansions, enabled by naming a cache file
+ * in the _JAVA_LAUNCHER_WILDCARD_CACHE environment variable.  An entry
+ * records the jar files found in one wildcard directory together with
+ * the modification time of the directory and is used for as long as that
+ * time is unchanged, which saves listing directories of many jar files
+ * on every launch.  Directories modified within the last
+ * WILDCARD_CACHE_SETTLE seconds are not cached, as a further change in
+ * the same second would go unnoticed.
+ */
+#define WILDCARD_CACHE_ENV_ENTRY "_JAVA_LAUNCHER_WILDCARD_CACHE"
+#define WILDCARD_CACHE_HEADER "# JLI wildcard cache 1"
+#define WILDCARD_CACHE_SETTLE 2
+
+typedef struct WildcardCacheEntry_
+{
+    char *dir;        /* absolute path of the directory */
+    jlong mtime;
+    JLI_List files;   /* basenames of the jar files */
+} WildcardCacheEntry;
+
+static const char *wildcardCachePath = NULL;
+static WildcardCacheEntry *wildcardCacheEntries = NULL;
+static size_t wildcardCacheSize = 0;
+static size_t wildcardCacheCapacity = 0;
+static int wildcardCacheDirty = 0;
+
+/*
+ * Returns the absolute path of the wildcard's directory, which keys its
+ * cache entry, and the directory's modification time; NULL on failure.
+ */
+static char *
+wildcardDirKey(const char *wildcard, jlong *mtime)
+{
+    struct stat st;
+    int wildlen = (int)JLI_StrLen(wildcard);
+    char *dirname = JLI_StringDup(wildlen < 2 ? "." : wildcard);
+    char *key = NULL;
+    if (wildlen >= 2) {
+        /* Drop the '*' and, unless it names a root, the separator */
+        dirname[wildlen - 1] = '\0';
+        if (wildlen > 2 && dirname[wildlen - 3] != ':')
+            dirname[wildlen - 2] = '\0';
+    }
+    if (stat(dirname, &st) == 0) {
+        *mtime = (jlong)st.st_mtime;
+#ifdef _WIN32
+        key = _fullpath(NULL, dirname, 0);
+#else
+        key = realpath(dirname, NULL);
+#endif
+    }
+    JLI_MemFree(dirname);
+    return key;
+}
+
+static WildcardCacheEntry *
+wildcardCacheFind(const char *dir)
+{
+    size_t i;
+    for (i = 0; i < wildcardCacheSize; i++)
+        if (equal(wildcardCacheEntries[i].dir, dir))
+            return &wildcardCacheEntries[i];
+    return NULL;
+}
+
+static void
+wildcardCachePut(const char *dir, jlong mtime, JLI_List files)
+{
+    WildcardCacheEntry *entry = wildcardCacheFind(dir);
+    if (entry == NULL) {
+        if (wildcardCacheSize == wildcardCacheCapacity) {
+            wildcardCacheCapacity = wildcardCacheCapacity * 2 + 8;
+            wildcardCacheEntries = (WildcardCacheEntry *)
+                JLI_MemRealloc(wildcardCacheEntries,
+                               wildcardCacheCapacity * sizeof(WildcardCacheEntry));
+        }
+        entry = &wildcardCacheEntries[wildcardCacheSize++];
+        entry->dir = JLI_StringDup(dir);
+    } else {
+        JLI_List_free(entry->files);
+    }
+    entry->mtime = mtime;
+    entry->files = files;
+}
+
+/* Reads the cache file; a file that does not parse is ignored entirely. */
+static void
+wildcardCacheLoad(void)
+{
+    FILE *f = fopen(wildcardCachePath, "rb");
+    char *buf, *line, *next, *end;
+    long len;
+    if (f == NULL)
+        return;
+    if (fseek(f, 0, SEEK_END) != 0 || (len = ftell(f)) <= 0 ||
+        fseek(f, 0, SEEK_SET) != 0) {
+        fclose(f);
+        return;
+    }
+    buf = (char *) JLI_MemAlloc(len + 1);
+    if (fread(buf, 1, len, f) != (size_t)len) {
+        fclose(f);
+        JLI_MemFree(buf);
+        return;
+    }
+    fclose(f);
+    buf[len] = '\0';
+
+    line = buf;
+    next = JLI_StrChr(line, '\n');
+    if (next == NULL ||
+        JLI_StrNCmp(line, WILDCARD_CACHE_HEADER, next - line) != 0) {
+        JLI_MemFree(buf);
+        return;
+    }
+    for (line = next + 1; *line != '\0'; line = next + 1) {
+        /* W <mtime> <count> <dir>, followed by <count> basename lines */
+        jlong mtime;
+        long count;
+        JLI_List files;
+        if ((next = JLI_StrChr(line, '\n')) == NULL || line[0] != 'W' || line[1] != ' ')
+            break;
+        *next = '\0';
+        mtime = (jlong)strtoll(line + 2, &end, 10);
+        if (*end != ' ')
+            break;
+        count = strtol(end + 1, &end, 10);
+        if (*end != ' ' || count < 0)
+            break;
+        files = JLI_List_new(count + 1);
+        while (count-- > 0) {
+            line = next + 1;
+            if ((next = JLI_StrChr(line, '\n')) == NULL)
+                break;
+            JLI_List_addSubstring(files, line, next - line);
+        }
+        if (count >= 0) {
+            JLI_List_free(files);
+            break;
+        }
+        wildcardCachePut(end + 1, mtime, files);
+    }
+    JLI_MemFree(buf);
+}
+
+/* Writes the cache to a private file first and renames it into place. */
+static void
+wildcardCacheStore(void)
+{
+    size_t tmplen = JLI_StrLen(wildcardCachePath) + 16;
+    char *tmp = (char *) JLI_MemAlloc(tmplen);
+    FILE *f;
+    size_t i, j;
+    int ok;
+    JLI_Snprintf(tmp, tmplen, "%s.%d", wildcardCachePath, (int)getpid());
+    if ((f = fopen(tmp, "wb")) == NULL) {
+        JLI_MemFree(tmp);
+        return;
+    }
+    ok = fprintf(f, "%s\n", WILDCARD_CACHE_HEADER) > 0;
+    for (i = 0; ok && i < wildcardCacheSize; i++) {
+        WildcardCacheEntry *entry = &wildcardCacheEntries[i];
+        ok = fprintf(f, "W %lld %d %s\n", (long long)entry->mtime,
+                     (int)entry->files->size, entry->dir) > 0;
+        for (j = 0; ok && j < entry->files->size; j++)
+            ok = fprintf(f, "%s\n", entry->files->elements[j]) > 0;
+    }
+    ok = (fclose(f) == 0) && ok;
+#ifdef _WIN32
+    if (ok)
+        remove(wildcardCachePath); /* rename() does not replace on Windows */
+#endif
+    if (!ok || rename(tmp, wildcardCachePath) != 0)
+        remove(tmp);
+    JLI_MemFree(tmp);
+}
+
+static JLI_List
+wildcardCachedFileList(const char *wildcard)
+{
+    WildcardCacheEntry *entry;
+    JLI_List fl, basenames;
+    jlong mtime;
+    size_t i, dirlen;
+    char *dir;
+
+    if (wildcardCachePath == NULL ||
+        (dir = wildcardDirKey(wildcard, &mtime)) == NULL)
+        return wildcardFileList(wildcard);
+    entry = wildcardCacheFind(dir);
+    if (entry != NULL && entry->mtime == mtime) {
+        free(dir);
+        fl = JLI_List_new(entry->files->size + 1);
+        for (i = 0; i < entry->files->size; i++)
+            JLI_List_add(fl, wildcardConcat(wildcard, entry->files->elements[i]));
+        return fl;
+    }
+
+    fl = wildcardFileList(wildcard);
+    if (fl != NULL && (jlong)time(NULL) - mtime >= WILDCARD_CACHE_SETTLE &&
+        JLI_StrChr(dir, '\n') == NULL) {
+        /* Elements are the wildcard with its '*' replaced by a basename */
+        dirlen = JLI_StrLen(wildcard) - 1;
+        basenames = JLI_List_new(fl->size + 1);
+        for (i = 0; i < fl->size; i++) {
+            if (JLI_StrChr(fl->elements[i], '\n') != NULL)
+                break;
+            JLI_List_add(basenames, JLI_StringDup(fl->elements[i] + dirlen));
+        }
+        if (i == fl->size) {
+            wildcardCachePut(dir, mtime, basenames);
+            wildcardCacheDirty = 1;
+        } else {
+            JLI_List_free(basenames);
+        }
+    }
+    free(dir);
+    return fl;
+}
+
 static int
 FileList_expandWildcards(JLI_List fl)
 {
@@ -287,7 +511,7 @@ FileList_expandWildcards(JLI_List fl)
     int expandedCnt = 0;
     for (i = 0; i < fl->size; i++) {
         if (isWildcard(fl->elements[i])) {
-            JLI_List expanded = wildcardFileList(fl->elements[i]);
+            JLI_List expanded = wildcardCachedFileList(fl->elements[i]);
             if (expanded != NULL && expanded->size > 0) {
                 expandedCnt++;
                 JLI_MemFree(fl->elements[i]);
@@ -315,10 +539,21 @@ JLI_WildcardExpandClasspath(const char *classpath)
 
     if (JLI_StrChr(classpath, '*') == NULL)
         return classpath;
+    if (wildcardCachePath == NULL &&
+        (wildcardCachePath = getenv(WILDCARD_CACHE_ENV_ENTRY)) != NULL) {
+        if (*wildcardCachePath == '\0')
+            wildcardCachePath = NULL;
+        else if (wildcardCacheSize == 0)
+            wildcardCacheLoad();
+    }
     fl = JLI_List_split(classpath, PATH_SEPARATOR);
     expanded = FileList_expandWildcards(fl) ?
         JLI_List_join(fl, PATH_SEPARATOR) : classpath;
     JLI_List_free(fl);
+    if (wildcardCacheDirty) {
+        wildcardCacheStore();
+        wildcardCacheDirty = 0;
+    }
     if (getenv(JLDEBUG_ENV_ENTRY) != 0)
         printf("Expanded wildcards:\n"
                "    before: \"%s\"\n"
@@ -588,7 +588,7 @@ readCEN(jzfile *zip, jint knownTotal)
     unsigned char endbuf[ENDHDR];
     jint endhdrlen = ENDHDR;
     jzcell *entries;
-    jint *table;
+    jzslot *table;
 
     /* Clear previous zip error */
     zip->msg = NULL;
@@ -688,15 +688,19 @@ readCEN(jzfile *zip, jint knownTotal)
      * the Zip64 enabled.
      */
     total = (knownTotal != -1) ? knownTotal : total;
+    /* Fill at most 3/4 of the slots, which keeps probe sequences short
+     * and leaves at least one slot empty to end every lookup. */
+    if (total > (jint)(0x7ffffffe / 4 * 3))
+        goto Catch;
     entries  = zip->entries  = calloc(total, sizeof(entries[0]));
-    tablelen = zip->tablelen = ((total/2) | 1); // Odd -> fewer collisions
+    tablelen = zip->tablelen = ((total + total/3 + 1) | 1); // Odd -> fewer collisions
     table    = zip->table    = malloc(tablelen * sizeof(table[0]));
     /* According to ISO C it is perfectly legal for malloc to return zero
      * if called with a zero argument. We check this for 'entries' but not
      * for 'table' because 'tablelen' can't be zero (see computation above). */
     if ((entries == NULL && total != 0) || table == NULL) goto Catch;
     for (j = 0; j < tablelen; j++)
-        table[j] = ZIP_ENDCHAIN;
+        table[j].index = ZIP_EMPTYSLOT;
 
     /* Iterate through the entries in the central directory */
     for (i = 0, cp = cenbuf; cp <= cenend - CENHDR; i++, cp += CENSIZE(cp)) {
@@ -732,14 +736,15 @@ readCEN(jzfile *zip, jint knownTotal)
             if (addMetaName(zip, (char *)cp+CENHDR, nlen) != 0)
                 goto Catch;
 
-        /* Record the CEN offset and the name hash in our hash cell. */
+        /* Record the CEN offset in our cell. */
         entries[i].cenpos = cenpos + (cp - cenbuf);
-        entries[i].hash = hashN((char *)cp+CENHDR, nlen);
 
-        /* Add the entry to the hash table */
-        hsh = entries[i].hash % tablelen;
-        entries[i].next = table[hsh];
-        table[hsh] = i;
+        /* Add the entry to the first free slot from its name hash on */
+        hsh = hashN((char *)cp+CENHDR, nlen);
+        for (j = hsh % tablelen; table[j].index != ZIP_EMPTYSLOT; )
+            if (++j == tablelen) j = 0;
+        table[j].hash = hsh;
+        table[j].index = i;
     }
     if (cp != cenend) {
         ZIP_FORMAT_ERROR("invalid CEN header (bad header size)");
@@ -1179,7 +1184,7 @@ jzentry *
 ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
 {
     unsigned int hsh = hashN(name, ulen);
-    jint idx;
+    jint slot;
     jzentry *ze = 0;
 
     ZIP_Lock(zip);
@@ -1187,7 +1192,7 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         goto Finally;
     }
 
-    idx = zip->table[hsh % zip->tablelen];
+    slot = hsh % zip->tablelen;
 
     /*
      * This while loop is an optimization where a double lookup
@@ -1208,13 +1213,13 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         ze = 0;
 
         /*
-         * Search down the target hash chain for a cell whose
-         * 32 bit hash matches the hashed name.
+         * Probe the slots from the hashed one up to an empty one for
+         * an entry whose 32 bit hash matches the hashed name.
          */
-        while (idx != ZIP_ENDCHAIN) {
-            jzcell *zc = &zip->entries[idx];
+        while (zip->table[slot].index != ZIP_EMPTYSLOT) {
+            jzslot *zs = &zip->table[slot];
 
-            if (zc->hash == hsh) {
+            if (zs->hash == hsh) {
                 /*
                  * OK, we've found a ZIP entry whose 32 bit hashcode
                  * matches the name we're looking for.  Try to read
@@ -1224,7 +1229,7 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
                  * If the names don't match (which should be very rare)
                  * we keep searching.
                  */
-                ze = newEntry(zip, zc, ACCESS_RANDOM);
+                ze = newEntry(zip, &zip->entries[zs->index], ACCESS_RANDOM);
                 if (ze && equals(ze->name, ze->nlen, name, ulen)) {
                     break;
                 }
@@ -1236,7 +1241,7 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
                 }
                 ze = 0;
             }
-            idx = zc->next;
+            if (++slot == zip->tablelen) slot = 0;
         }
 
         /* Entry found, return it */
@@ -1258,7 +1263,7 @@ ZIP_GetEntry2(jzfile *zip, char *name, jint ulen, jboolean addSlash)
         name[ulen++] = '/';
         name[ulen] = '\0';
         hsh = hash_append(hsh, '/');
-        idx = zip->table[hsh % zip->tablelen];
+        slot = hsh % zip->tablelen;
         addSlash = JNI_FALSE;
     }
 
@@ -174,18 +174,25 @@ typedef struct jzentry {  /* Zip file entry */
 } jzentry;
 
 /*
- * In-memory hash table cell.
+ * In-memory cell of an entry, in central directory order.
  * In a typical system we have a *lot* of these, as we have one for
  * every entry in every active JAR.
- * Note that in order to save space we don't keep the name in memory,
- * but merely remember a 32 bit hash.
  */
 typedef struct jzcell {
-    unsigned int hash;    /* 32 bit hashcode on name */
-    unsigned int next;    /* hash chain: index into jzfile->entries */
     jlong cenpos;         /* Offset of central directory file header */
 } jzcell;
 
+/*
+ * Slot of the open-addressed hash table on entry names. Lookups probe
+ * consecutive slots, so they rarely touch more than one cache line.
+ * Note that in order to save space we don't keep the name in memory,
+ * but merely remember a 32 bit hash.
+ */
+typedef struct jzslot {
+    unsigned int hash;    /* 32 bit hashcode on name */
+    jint index;           /* index into jzfile->entries, or ZIP_EMPTYSLOT */
+} jzslot;
+
 typedef struct cencache {
     char *data;           /* A cached page of CEN headers */
     jlong pos;            /* file offset of data */
@@ -222,10 +229,10 @@ typedef struct jzfile {   /* Zip file */
     char *comment;        /* zip file comment */
     jint clen;            /* length of the zip file comment */
     char *msg;            /* zip error message */
-    jzcell *entries;      /* array of hash cells */
+    jzcell *entries;      /* array of entry cells */
     jint total;           /* total number of entries */
-    jint *table;          /* Hash chain heads: indexes into entries */
-    jint tablelen;        /* number of hash heads */
+    jzslot *table;        /* hash table on entry names */
+    jint tablelen;        /* number of hash slots */
     struct jzfile *next;  /* next zip file in search list */
     jzentry *cache;       /* we cache the most recently freed jzentry */
     /* Information on metadata names in META-INF directory */
@@ -237,9 +244,9 @@ typedef struct jzfile {   /* Zip file */
 } jzfile;
 
 /*
- * Index representing end of hash chain
+ * Index representing an empty hash slot
  */
-#define ZIP_ENDCHAIN ((jint)-1)
+#define ZIP_EMPTYSLOT ((jint)-1)
 
 JNIEXPORT jzentry *
 ZIP_FindEntry(jzfile *zip, char *name, jint *sizeP, jint *nameLenP);
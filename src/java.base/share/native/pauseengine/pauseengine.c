@@ -24,6 +24,7 @@
  * questions.
  */
 
+#include <errno.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -44,6 +45,35 @@ static int kickjvm(pid_t jvm, int code) {
     return 0;
 }
 
+// Start time of the process in clock ticks since boot, to tell the paused JVM
+// from a process that got its pid after the JVM has died. 0 if unknown.
+static unsigned long long starttime(pid_t pid) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        return 0;
+    }
+    char buf[1024];
+    size_t len = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[len] = '\0';
+
+    // the command name may contain spaces and parens, fields follow the last ')'
+    char *p = strrchr(buf, ')');
+    unsigned long long start = 0;
+    if (p) {
+        // starttime is the 22nd field, the state after ')' is the 3rd
+        for (int field = 2; field < 22 && p; ++field) {
+            p = strchr(p + 1, ' ');
+        }
+        if (p) {
+            start = strtoull(p + 1, NULL, 10);
+        }
+    }
+    return start;
+}
+
 int main(int argc, char *argv[]) {
     char* action = argv[1];
     char* imagedir = argv[2];
@@ -54,28 +84,61 @@ int main(int argc, char *argv[]) {
     }
 
     if (!strcmp(action, "checkpoint")) {
+        // The JVM stays paused until kicked by the restore action, so it can
+        // be kept as a warm standby. The pid file is published by a rename,
+        // a restore never sees it partially written.
         pid_t jvm = getppid();
-        FILE *pidfile = fopen(pidpath, "w");
+        char *tmppath;
+        if (-1 == asprintf(&tmppath, "%s.tmp", pidpath)) {
+            kickjvm(jvm, -1);
+            return 1;
+        }
+        FILE *pidfile = fopen(tmppath, "w");
         if (!pidfile) {
             perror("fopen pidfile");
             kickjvm(jvm, -1);
             return 1;
         }
-        fprintf(pidfile, "%d\n", jvm);
-        fclose(pidfile);
+        fprintf(pidfile, "%d %llu\n", jvm, starttime(jvm));
+        if (fclose(pidfile) || rename(tmppath, pidpath)) {
+            perror("write pidfile");
+            unlink(tmppath);
+            kickjvm(jvm, -1);
+            return 1;
+        }
      } else if (!strcmp(action, "restore")) {
-        FILE *pidfile = fopen(pidpath, "r");
+        // Claim the paused JVM by renaming its pid file, so that each one is
+        // activated by a single restore when several race for a pool.
+        char *claimpath;
+        if (-1 == asprintf(&claimpath, "%s.%d", pidpath, getpid())) {
+            return 1;
+        }
+        if (rename(pidpath, claimpath)) {
+            if (errno == ENOENT) {
+                fprintf(stderr, "no paused JVM in %s (already restored?)\n", imagedir);
+            } else {
+                perror("rename pidfile");
+            }
+            return 1;
+        }
+        FILE *pidfile = fopen(claimpath, "r");
         if (!pidfile) {
             perror("fopen pidfile");
             return 1;
         }
         pid_t jvm;
-        if (1 != fscanf(pidfile, "%d", &jvm)) {
-            fclose(pidfile);
+        unsigned long long start = 0;
+        int n = fscanf(pidfile, "%d %llu", &jvm, &start);
+        fclose(pidfile);
+        unlink(claimpath);
+        if (n < 1) {
             fprintf(stderr, "cannot read pid\n");
             return 1;
         }
-        fclose(pidfile);
+        if (start != 0 && start != starttime(jvm)) {
+            fprintf(stderr, "paused JVM %d is gone\n", jvm);
+            return 1;
+        }
 
         char *strid = getenv("CRAC_NEW_ARGS_ID");
         if (kickjvm(jvm, strid ? atoi(strid) : 0)) {
@@ -36,6 +36,9 @@
 #include <fcntl.h>
 #include <getopt.h>
 #include <signal.h>
+#include <dirent.h>
+#include <inttypes.h>
+#include <sys/mman.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
 
@@ -44,6 +47,8 @@
 #define PERFDATA_NAME "perfdata"
 
 #define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
+#define STR_(x) #x
+#define STR(x) STR_(x)
 
 #define SUPPRESS_ERROR_IN_PARENT 77
 
@@ -52,6 +57,54 @@ static int g_pid;
 static char *verbosity = NULL; // default differs for checkpoint and restore
 static char *log_file = NULL;
 
+#define PAGES_PREFIX "pages-"
+#define IMG_SUFFIX ".img"
+
+struct compressor {
+    const char *name;
+    const char *suffix;
+    // output file is given with -o rather than as the second positional argument
+    bool output_opt;
+};
+
+static const struct compressor compressors[] = {
+    { "zstd", ".zst", true },
+    { "lz4",  ".lz4", false },
+};
+
+static const struct compressor *compressor = NULL;
+static long compress_threads = 0; // 0 means number of online CPUs
+
+static bool lazy_pages = false;
+
+static const char *page_store = NULL;
+static long page_store_chunk = 2 * 1024 * 1024;
+
+#define CHUNKS_SUFFIX ".chunks"
+
+#define LAZY_PAGES_SOCKET "lazy-pages.socket"
+#define LAZY_PAGES_WAIT_USEC (5 * 1000 * 1000)
+
+// Image the checkpoint is a delta against, and the link criu leaves to it in the image
+static const char *parent_image = NULL;
+#define PARENT_LINK "parent"
+// Bounds walking the chain of parent images
+#define MAX_IMAGE_CHAIN 64
+
+// Ranges of page images to read ahead on restore, one "<file> <offset> <length>" per line
+#define PREFETCH_LIST "prefetch.list"
+static bool prefetch = false;
+static long prefetch_threads = 0; // 0 means number of online CPUs
+
+// Written by the JVM, the engine appends the image files for validation on restore
+#define MANIFEST_NAME "crac.manifest"
+#define LOG_SUFFIX ".log"
+
+// Images of "predump", relative to the image directory as criu expects for --prev-images-dir
+#define PREDUMP_DIR "predump"
+// Records the pid of the pre-dumped JVM to not use a stale pre-dump of another process
+#define PREDUMP_PID_FILE PREDUMP_DIR "/jvm.pid"
+
 static int kickjvm(pid_t jvm, int code) {
     union sigval sv = { .sival_int = code };
     if (-1 == sigqueue(jvm, RESTORE_SIGNAL, sv)) {
@@ -118,16 +171,385 @@ static const char *path_abs2(const char *rel1, const char *rel2) {
     return join_path(path_abs(rel1), rel2);
 }
 
-static int checkpoint(pid_t jvm,
-        const char *basedir,
-        const char *self,
-        const char *criu,
-        const char *imagedir) {
+static bool ends_with(const char *str, const char *suffix) {
+    size_t len = strlen(str);
+    size_t suffix_len = strlen(suffix);
+    return suffix_len <= len && !strcmp(str + len - suffix_len, suffix);
+}
+
+static bool is_page_image(const char *name, bool compressed) {
+    if (strncmp(name, PAGES_PREFIX, strlen(PAGES_PREFIX))) {
+        return false;
+    }
+    if (!compressed) {
+        return ends_with(name, IMG_SUFFIX);
+    }
+    if (!ends_with(name, compressor->suffix)) {
+        return false;
+    }
+    // strip the compressor suffix and check what remains is a raw image name
+    char stem[NAME_MAX + 1];
+    snprintf(stem, sizeof(stem), "%.*s", (int)(strlen(name) - strlen(compressor->suffix)), name);
+    return ends_with(stem, IMG_SUFFIX);
+}
+
+static pid_t spawn_compressor(bool decompress, const char *in, const char *out) {
+    pid_t child = fork();
+    if (child) {
+        if (child == -1) {
+            perror("fork compressor");
+        }
+        return child;
+    }
+
+    const char *args[16];
+    const char **arg = args;
+    *arg++ = compressor->name;
+    *arg++ = "-q";
+    *arg++ = "-f";
+    if (decompress) {
+        *arg++ = "-d";
+    } else {
+        // compressed file replaces the raw one
+        *arg++ = "--rm";
+    }
+    *arg++ = in;
+    if (compressor->output_opt) {
+        *arg++ = "-o";
+    }
+    *arg++ = out;
+    *arg++ = NULL;
+
+    execvp(compressor->name, (char**)args);
+    fprintf(stderr, "Cannot execute compressor \"");
+    print_args_to_stderr(args);
+    fprintf(stderr, "\": %s\n", strerror(errno));
+    exit(SUPPRESS_ERROR_IN_PARENT);
+}
+
+static bool wait_compressor(void) {
+    int status;
+    pid_t child;
+    do {
+        child = wait(&status);
+    } while (child == -1 && errno == EINTR);
+    if (child == -1) {
+        perror("wait compressor");
+        return false;
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status)) {
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != SUPPRESS_ERROR_IN_PARENT) {
+            fprintf(stderr, "%s failed, waitpid status was %d\n", compressor->name, status);
+        }
+        return false;
+    }
+    return true;
+}
+
+// Runs up to compress_threads compressor processes at once, one stream per page image file.
+static int transform_page_images(const char *imagedir, bool decompress) {
+    DIR *dir = opendir(imagedir);
+    if (!dir) {
+        perror("opendir image dir");
+        return 1;
+    }
+
+    long workers = compress_threads;
+    if (workers <= 0) {
+        workers = sysconf(_SC_NPROCESSORS_ONLN);
+        if (workers <= 0) {
+            workers = 1;
+        }
+    }
+
+    bool ok = true;
+    long running = 0;
+    struct dirent *dp;
+    while (ok && (dp = readdir(dir))) {
+        if (!is_page_image(dp->d_name, decompress)) {
+            continue;
+        }
+        const char *in = join_path(imagedir, dp->d_name);
+        char *out;
+        int ret = decompress ?
+            asprintf(&out, "%s/%.*s", imagedir, (int)(strlen(dp->d_name) - strlen(compressor->suffix)), dp->d_name) :
+            asprintf(&out, "%s/%s%s", imagedir, dp->d_name, compressor->suffix);
+        if (ret == -1) {
+            perror("asprintf");
+            free((char *)in);
+            ok = false;
+            break;
+        }
+
+        if (running == workers) {
+            ok = wait_compressor();
+            --running;
+        }
+        if (ok) {
+            if (spawn_compressor(decompress, in, out) == -1) {
+                ok = false;
+            } else {
+                ++running;
+            }
+        }
+        free((char *)in);
+        free(out);
+    }
+    closedir(dir);
+
+    for (; running > 0; --running) {
+        if (!wait_compressor()) {
+            ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
+
+// Removes raw page images recreated for restore; compressed or deduplicated ones stay as the image.
+static void remove_raw_page_images(const char *imagedir) {
+    DIR *dir = opendir(imagedir);
+    if (!dir) {
+        perror("opendir image dir");
+        return;
+    }
+    struct dirent *dp;
+    while ((dp = readdir(dir))) {
+        if (!is_page_image(dp->d_name, false)) {
+            continue;
+        }
+        char *path;
+        if (asprintf(&path, "%s/%s", imagedir, dp->d_name) == -1) {
+            perror("asprintf");
+            break;
+        }
+        if (unlink(path)) {
+            perror("unlink decompressed page image");
+        }
+        free(path);
+    }
+    closedir(dir);
+}
+
+static uint64_t chunk_hash(const char *buf, size_t len) {
+    // FNV-1a; collisions are resolved by comparing contents in store_chunk()
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= (unsigned char)buf[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static bool same_contents(const char *path, const char *buf, size_t len, char *tmp) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        return false;
+    }
+    bool same = fread(tmp, 1, len, f) == len && fgetc(f) == EOF && !memcmp(tmp, buf, len);
+    fclose(f);
+    return same;
+}
+
+// Puts the chunk into the page store unless an identical one is there already,
+// and appends its name to the manifest.
+static int store_chunk(FILE *manifest, const char *buf, size_t len, char *tmp) {
+    const uint64_t hash = chunk_hash(buf, len);
+    char dir[PATH_MAX];
+    snprintf(dir, sizeof(dir), "%s/%02x", page_store, (unsigned)(hash >> 56));
+
+    for (unsigned collision = 0; ; ++collision) {
+        char name[64];
+        snprintf(name, sizeof(name), "%02x/%016" PRIx64 "-%zx-%u", (unsigned)(hash >> 56), hash, len, collision);
+        char path[PATH_MAX];
+        snprintf(path, sizeof(path), "%s/%s", page_store, name);
+
+        if (!access(path, F_OK)) {
+            if (!same_contents(path, buf, len, tmp)) {
+                continue;
+            }
+        } else {
+            if (mkdir(dir, 0755) && errno != EEXIST) {
+                perror("mkdir page store");
+                return 1;
+            }
+            // replicas may store the same chunk concurrently, publish it atomically
+            char tmppath[PATH_MAX + 16];
+            snprintf(tmppath, sizeof(tmppath), "%s.%d", path, getpid());
+            FILE *f = fopen(tmppath, "w");
+            if (!f) {
+                perror("fopen chunk");
+                return 1;
+            }
+            bool ok = fwrite(buf, 1, len, f) == len;
+            ok = !fclose(f) && ok;
+            if (!ok || rename(tmppath, path)) {
+                perror("write chunk");
+                unlink(tmppath);
+                return 1;
+            }
+        }
+        return fprintf(manifest, "%s\n", name) < 0;
+    }
+}
+
+// Replaces each pages-*.img by a manifest of chunks held in the shared page store.
+static int dedup_page_images(const char *imagedir) {
+    DIR *dir = opendir(imagedir);
+    if (!dir) {
+        perror("opendir image dir");
+        return 1;
+    }
+
+    if (mkdir(page_store, 0755) && errno != EEXIST) {
+        perror("mkdir page store");
+        closedir(dir);
+        return 1;
+    }
+
+    char *buf = malloc(page_store_chunk);
+    char *tmp = malloc(page_store_chunk);
+    int ret = buf && tmp ? 0 : 1;
+    struct dirent *dp;
+    while (!ret && (dp = readdir(dir))) {
+        if (!is_page_image(dp->d_name, false)) {
+            continue;
+        }
+        char in_path[PATH_MAX];
+        char manifest_path[PATH_MAX + sizeof(CHUNKS_SUFFIX)];
+        snprintf(in_path, sizeof(in_path), "%s/%s", imagedir, dp->d_name);
+        snprintf(manifest_path, sizeof(manifest_path), "%s" CHUNKS_SUFFIX, in_path);
 
+        FILE *in = fopen(in_path, "r");
+        FILE *manifest = fopen(manifest_path, "w");
+        if (!in || !manifest) {
+            perror("fopen page image");
+            ret = 1;
+        }
+        size_t len;
+        while (!ret && (len = fread(buf, 1, page_store_chunk, in)) > 0) {
+            ret = store_chunk(manifest, buf, len, tmp);
+        }
+        if (in) {
+            ret = ferror(in) || ret;
+            fclose(in);
+        }
+        if (manifest) {
+            ret = fclose(manifest) || ret;
+        }
+        if (!ret && unlink(in_path)) {
+            perror("unlink page image");
+            ret = 1;
+        }
+    }
+    closedir(dir);
+    free(buf);
+    free(tmp);
+    return ret;
+}
+
+// Reassembles pages-*.img from their chunk manifests.
+static int undedup_page_images(const char *imagedir) {
+    DIR *dir = opendir(imagedir);
+    if (!dir) {
+        perror("opendir image dir");
+        return 1;
+    }
+
+    char *buf = malloc(page_store_chunk);
+    int ret = buf ? 0 : 1;
+    struct dirent *dp;
+    while (!ret && (dp = readdir(dir))) {
+        const size_t name_len = strlen(dp->d_name);
+        if (strncmp(dp->d_name, PAGES_PREFIX, strlen(PAGES_PREFIX)) || !ends_with(dp->d_name, CHUNKS_SUFFIX)) {
+            continue;
+        }
+        char manifest_path[PATH_MAX];
+        char out_path[PATH_MAX];
+        snprintf(manifest_path, sizeof(manifest_path), "%s/%s", imagedir, dp->d_name);
+        snprintf(out_path, sizeof(out_path), "%s/%.*s", imagedir, (int)(name_len - strlen(CHUNKS_SUFFIX)), dp->d_name);
+
+        FILE *manifest = fopen(manifest_path, "r");
+        FILE *out = fopen(out_path, "w");
+        if (!manifest || !out) {
+            perror("fopen page image");
+            ret = 1;
+        }
+        char name[64];
+        while (!ret && fgets(name, sizeof(name), manifest)) {
+            name[strcspn(name, "\n")] = '\0';
+            char path[PATH_MAX];
+            snprintf(path, sizeof(path), "%s/%s", page_store, name);
+            FILE *chunk = fopen(path, "r");
+            if (!chunk) {
+                fprintf(stderr, "Missing chunk %s: %s\n", path, strerror(errno));
+                ret = 1;
+                break;
+            }
+            size_t len;
+            while ((len = fread(buf, 1, page_store_chunk, chunk)) > 0) {
+                if (fwrite(buf, 1, len, out) != len) {
+                    perror("write page image");
+                    ret = 1;
+                    break;
+                }
+            }
+            ret = ferror(chunk) || ret;
+            fclose(chunk);
+        }
+        if (manifest) {
+            fclose(manifest);
+        }
+        if (out) {
+            ret = fclose(out) || ret;
+        }
+    }
+    closedir(dir);
+    free(buf);
+    return ret;
+}
+
+// Lists the sizes of image files, so that the JVM can reject a truncated or
+// incomplete image before starting the restore. Logs are not listed as they
+// may be rewritten. A delta image also names its parent to be validated too.
+static int append_manifest(const char *imagedir, const char *parent) {
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%s", imagedir, MANIFEST_NAME);
+    DIR *dir = opendir(imagedir);
+    if (!dir) {
+        perror(imagedir);
+        return 1;
+    }
+    FILE *manifest = fopen(path, "a");
+    if (!manifest) {
+        perror(path);
+        closedir(dir);
+        return 1;
+    }
+
+    struct dirent *ent;
+    while ((ent = readdir(dir))) {
+        struct stat st;
+        if (!strcmp(ent->d_name, MANIFEST_NAME) || ends_with(ent->d_name, LOG_SUFFIX) ||
+                fstatat(dirfd(dir), ent->d_name, &st, 0) || !S_ISREG(st.st_mode)) {
+            continue;
+        }
+        fprintf(manifest, "file %s %lld\n", ent->d_name, (long long)st.st_size);
+    }
+    closedir(dir);
+    if (parent) {
+        fprintf(manifest, "parent %s\n", parent);
+    }
+    return fclose(manifest) ? 1 : 0;
+}
+
+// criu must not find the engine in the process tree it dumps. Returns false in the
+// original process once the intermediate child is gone, and true in a grand-child
+// that has been re-parented out of the JVM process hierarchy.
+static bool move_out_of_jvm_tree(pid_t jvm) {
     if (fork()) {
         // main process
         wait(NULL);
-        return 0;
+        return false;
     }
 
     pid_t parent_before = getpid();
@@ -150,6 +572,107 @@ static int checkpoint(pid_t jvm,
         kickjvm(jvm, -1);
         exit(0);
     }
+    return true;
+}
+
+static bool has_predump(const char *imagedir, pid_t jvm) {
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%s", imagedir, PREDUMP_PID_FILE);
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        return false;
+    }
+    int pid = 0;
+    bool match = fscanf(f, "%d", &pid) == 1 && pid == jvm;
+    fclose(f);
+    return match;
+}
+
+// Copies the memory of the running JVM into PREDUMP_DIR and tracks pages dirtied
+// after that, so the following checkpoint only writes the changed pages. The JVM
+// is frozen only while criu collects the pages; the result is sent as for
+// CRAC_CRIU_LEAVE_RUNNING.
+static int predump(pid_t jvm,
+        const char *criu,
+        const char *imagedir) {
+
+    if (!move_out_of_jvm_tree(jvm)) {
+        return 0;
+    }
+
+    char predumpdir[PATH_MAX];
+    snprintf(predumpdir, sizeof(predumpdir), "%s/%s", imagedir, PREDUMP_DIR);
+    char pidfile[PATH_MAX];
+    snprintf(pidfile, sizeof(pidfile), "%s/%s", imagedir, PREDUMP_PID_FILE);
+    // a stale pre-dump must not be a parent of the new one
+    unlink(pidfile);
+    if (mkdir(imagedir, 0700) && errno != EEXIST) {
+        fprintf(stderr, "Cannot create %s: %s\n", imagedir, strerror(errno));
+        kickjvm(jvm, -1);
+        exit(0);
+    }
+    if (mkdir(predumpdir, 0700) && errno != EEXIST) {
+        fprintf(stderr, "Cannot create %s: %s\n", predumpdir, strerror(errno));
+        kickjvm(jvm, -1);
+        exit(0);
+    }
+
+    char jvmpidchar[32];
+    snprintf(jvmpidchar, sizeof(jvmpidchar), "%d", jvm);
+
+    const char *log_local = log_file != NULL ? log_file : "predump4.log";
+    const char* args[] = {
+        criu,
+        "pre-dump",
+        "-t", jvmpidchar,
+        "-D", predumpdir,
+        "--shell-job",
+        verbosity != NULL ? verbosity : "-v4",
+        "-o", log_local,
+        // only pages changed since the parent are copied
+        parent_image ? "--prev-images-dir" : NULL,
+        parent_image,
+        NULL
+    };
+
+    pid_t child = fork();
+    if (!child) {
+        execv(criu, (char**)args);
+        fprintf(stderr, "Cannot execute CRIU \"");
+        print_args_to_stderr(args);
+        fprintf(stderr, "\": %s\n", strerror(errno));
+        exit(SUPPRESS_ERROR_IN_PARENT);
+    }
+
+    int status = 0;
+    if (child != waitpid(child, &status, 0) || !WIFEXITED(status) || WEXITSTATUS(status)) {
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != SUPPRESS_ERROR_IN_PARENT) {
+            fprintf(stderr, "CRIU pre-dump failed - check %s\n", path_abs2(predumpdir, log_local));
+            print_command_args_to_stderr(args);
+        }
+        kickjvm(jvm, -1);
+        exit(0);
+    }
+
+    FILE *f = fopen(pidfile, "w");
+    if (!f || fprintf(f, "%d\n", jvm) < 0 || fclose(f)) {
+        fprintf(stderr, "Cannot write %s: %s\n", pidfile, strerror(errno));
+        kickjvm(jvm, -1);
+        exit(0);
+    }
+    kickjvm(jvm, 0);
+    exit(0);
+}
+
+static int checkpoint(pid_t jvm,
+        const char *basedir,
+        const char *self,
+        const char *criu,
+        const char *imagedir) {
+
+    if (!move_out_of_jvm_tree(jvm)) {
+        return 0;
+    }
 
     char* leave_running = getenv("CRAC_CRIU_LEAVE_RUNNING");
 
@@ -174,6 +697,16 @@ static int checkpoint(pid_t jvm,
         *arg++ = "-R";
     }
 
+    const char *prev_images = has_predump(imagedir, jvm) ? PREDUMP_DIR : parent_image;
+    if (prev_images) {
+        *arg++ = "--prev-images-dir";
+        *arg++ = prev_images;
+    }
+    // a process left running can be checkpointed again as a delta against this image
+    if (prev_images || leave_running) {
+        *arg++ = "--track-mem";
+    }
+
     char *criuopts = getenv("CRAC_CRIU_OPTS");
     if (criuopts) {
         char* criuopt = strtok(criuopts, " ");
@@ -210,13 +743,256 @@ static int checkpoint(pid_t jvm,
             print_command_args_to_stderr(args);
         }
         kickjvm(jvm, -1);
-    } else if (leave_running) {
-        kickjvm(jvm, 0);
+    } else if (page_store && dedup_page_images(imagedir)) {
+        fprintf(stderr, "Cannot store page images of %s in %s\n", imagedir, page_store);
+        if (leave_running) {
+            kickjvm(jvm, -1);
+        }
+    } else if (compressor && transform_page_images(imagedir, false)) {
+        fprintf(stderr, "Cannot compress page images in %s\n", imagedir);
+        if (leave_running) {
+            kickjvm(jvm, -1);
+        }
+    } else {
+        if (append_manifest(imagedir, prev_images == parent_image ? parent_image : NULL)) {
+            fprintf(stderr, "Cannot write %s/%s, the image is not validated on restore\n", imagedir, MANIFEST_NAME);
+        }
+        if (leave_running) {
+            kickjvm(jvm, 0);
+        }
     }
 
     exit(0);
 }
 
+// Starts "criu lazy-pages" serving the image to the restored process from userfaultfd.
+// The daemon is detached from this process, which is about to become "criu restore",
+// and exits by itself once all pages are transferred.
+static int start_lazy_pages_daemon(const char *criu, const char *imagedir) {
+    unlink(LAZY_PAGES_SOCKET);
+
+    pid_t child = fork();
+    if (child == -1) {
+        perror("fork lazy-pages");
+        return 1;
+    }
+    if (child) {
+        int status;
+        if (child != waitpid(child, &status, 0) || !WIFEXITED(status) || WEXITSTATUS(status)) {
+            fprintf(stderr, "Cannot start CRIU lazy-pages daemon\n");
+            return 1;
+        }
+        // restore connects to the daemon's socket, so it has to be there first
+        struct stat st;
+        for (int waited = 0; stat(LAZY_PAGES_SOCKET, &st); waited += 1000) {
+            if (waited >= LAZY_PAGES_WAIT_USEC) {
+                fprintf(stderr, "CRIU lazy-pages daemon has not created %s\n", LAZY_PAGES_SOCKET);
+                return 1;
+            }
+            usleep(1000);
+        }
+        return 0;
+    }
+
+    if (fork()) {
+        exit(0);
+    }
+
+    const char* args[] = {
+        criu,
+        "lazy-pages",
+        "-W", ".",
+        "-D", imagedir,
+        verbosity != NULL ? verbosity : "-v1",
+        "-o", "lazy-pages.log",
+        NULL
+    };
+    execv(criu, (char**)args);
+    fprintf(stderr, "Cannot execute CRIU \"");
+    print_args_to_stderr(args);
+    fprintf(stderr, "\": %s\n", strerror(errno));
+    exit(1);
+}
+
+// Records which parts of the raw page images are in the page cache, e.g. after a
+// trial restore with lazy pages from a cold cache, which reads only the pages
+// the application touched.
+// Replaces dir with the image it is a delta against, returns false for a full image.
+static bool parent_of(char *dir) {
+    char parent[PATH_MAX];
+    snprintf(parent, sizeof(parent), "%s/%s", dir, PARENT_LINK);
+    char resolved[PATH_MAX];
+    if (!realpath(parent, resolved)) {
+        return false;
+    }
+    snprintf(dir, PATH_MAX, "%s", resolved);
+    return true;
+}
+
+static int record_prefetch(const char *imagedir) {
+    DIR *dir = opendir(imagedir);
+    if (!dir) {
+        perror(imagedir);
+        return 1;
+    }
+    char listpath[PATH_MAX];
+    snprintf(listpath, sizeof(listpath), "%s/%s", imagedir, PREFETCH_LIST);
+    FILE *list = fopen(listpath, "w");
+    if (!list) {
+        perror(listpath);
+        closedir(dir);
+        return 1;
+    }
+
+    const long page_size = sysconf(_SC_PAGESIZE);
+    int ret = 0;
+    struct dirent *ent;
+    while (!ret && (ent = readdir(dir))) {
+        if (!is_page_image(ent->d_name, false)) {
+            continue;
+        }
+        int fd = openat(dirfd(dir), ent->d_name, O_RDONLY);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st)) {
+            perror(ent->d_name);
+            ret = 1;
+        } else if (st.st_size > 0) {
+            size_t npages = (st.st_size + page_size - 1) / page_size;
+            void *addr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            unsigned char *vec = malloc(npages);
+            if (addr == MAP_FAILED || !vec || mincore(addr, st.st_size, vec)) {
+                perror(ent->d_name);
+                ret = 1;
+            } else {
+                for (size_t start = 0; start < npages; ) {
+                    if (!(vec[start] & 1)) {
+                        ++start;
+                        continue;
+                    }
+                    size_t end = start + 1;
+                    while (end < npages && (vec[end] & 1)) {
+                        ++end;
+                    }
+                    fprintf(list, "%s %zu %zu\n", ent->d_name, start * page_size, (end - start) * page_size);
+                    start = end;
+                }
+            }
+            free(vec);
+            if (addr != MAP_FAILED) {
+                munmap(addr, st.st_size);
+            }
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    closedir(dir);
+    if (fclose(list)) {
+        perror(listpath);
+        ret = 1;
+    }
+    return ret;
+}
+
+// Reads the share of worker out of nworkers of the ranges of PREFETCH_LIST,
+// or of the page images whole without a list, into the page cache.
+// Ranges are dealt out in turn so that all workers follow the listed order.
+static void prefetch_worker(const char *imagedir, long worker, long nworkers) {
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s/%s", imagedir, PREFETCH_LIST);
+    FILE *list = fopen(path, "r");
+    if (list) {
+        char name[NAME_MAX + 1];
+        char last[NAME_MAX + 1] = "";
+        unsigned long long offset, length;
+        int fd = -1;
+        for (long i = 0; fscanf(list, "%" STR(NAME_MAX) "s %llu %llu", name, &offset, &length) == 3; ++i) {
+            if (i % nworkers != worker) {
+                continue;
+            }
+            if (strcmp(name, last)) {
+                if (fd >= 0) {
+                    close(fd);
+                }
+                snprintf(path, sizeof(path), "%s/%s", imagedir, name);
+                fd = open(path, O_RDONLY);
+                strcpy(last, name);
+            }
+            if (fd >= 0) {
+                readahead(fd, offset, length);
+            }
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+        fclose(list);
+        return;
+    }
+
+    DIR *dir = opendir(imagedir);
+    if (!dir) {
+        return;
+    }
+    struct dirent *ent;
+    for (long i = 0; (ent = readdir(dir)); ) {
+        if (!is_page_image(ent->d_name, false) || i++ % nworkers != worker) {
+            continue;
+        }
+        int fd = openat(dirfd(dir), ent->d_name, O_RDONLY);
+        struct stat st;
+        if (fd >= 0 && !fstat(fd, &st)) {
+            readahead(fd, 0, st.st_size);
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    closedir(dir);
+}
+
+// Reads the page images into the page cache with prefetch_threads processes
+// while CRIU restores, so CRIU mostly copies pages from memory.
+static void start_prefetch(const char *imagedir) {
+    pid_t child = fork();
+    if (child == -1) {
+        perror("fork prefetch");
+        return;
+    }
+    if (child) {
+        waitpid(child, NULL, 0);
+        return;
+    }
+    // not a child of CRIU, which does not expect other children than the restored ones
+    if (fork()) {
+        exit(0);
+    }
+
+    long workers = prefetch_threads;
+    if (workers <= 0) {
+        workers = sysconf(_SC_NPROCESSORS_ONLN);
+        if (workers <= 0) {
+            workers = 1;
+        }
+    }
+    for (long w = 1; w < workers; ++w) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            prefetch_worker(imagedir, w, workers);
+            exit(0);
+        } else if (pid == -1) {
+            // the remaining shares are read by this process
+            for (long rest = w; rest < workers; ++rest) {
+                prefetch_worker(imagedir, rest, workers);
+            }
+            break;
+        }
+    }
+    prefetch_worker(imagedir, 0, workers);
+    while (wait(NULL) > 0) {
+    }
+    exit(0);
+}
+
 static int restore(const char *basedir,
         const char *self,
         const char *criu,
@@ -236,6 +1012,9 @@ static int restore(const char *basedir,
         *arg++ = "-o";
         *arg++ = log_file;
     }
+    if (lazy_pages) {
+        *arg++ = "--lazy-pages";
+    }
 
     const char* tail[] = {
         "--exec-cmd", "--", self, "restorewait",
@@ -255,6 +1034,37 @@ static int restore(const char *basedir,
 
     memcpy(arg, tail, sizeof(tail));
 
+    // CRIU reads pages of a delta image from the parent images, which need raw pages too
+    char chain[PATH_MAX] = "";
+    snprintf(chain, sizeof(chain), "%s", imagedir);
+    for (int depth = 0; depth < MAX_IMAGE_CHAIN && chain[0]; ++depth) {
+        if (compressor && transform_page_images(chain, true)) {
+            fprintf(stderr, "Cannot decompress page images in %s\n", chain);
+            return 1;
+        }
+        if (page_store && undedup_page_images(chain)) {
+            fprintf(stderr, "Cannot restore page images of %s from %s\n", chain, page_store);
+            return 1;
+        }
+        if (!parent_of(chain)) {
+            break;
+        }
+    }
+    // post-resume removes the raw pages once CRIU has read them;
+    // with lazy pages they are still being read after resume
+    if ((compressor || page_store) && !lazy_pages) {
+        setenv("CRAC_RAW_PAGES_IMAGE_DIR", path_abs(imagedir), 1);
+    }
+
+    if (lazy_pages && start_lazy_pages_daemon(criu, imagedir)) {
+        return 1;
+    }
+
+    // decompressed or reassembled page images have just been written and are cached
+    if (prefetch && !compressor && !page_store) {
+        start_prefetch(imagedir);
+    }
+
     fflush(stderr);
 
     execv(criu, (char**)args);
@@ -274,6 +1084,18 @@ static int post_resume(void) {
     }
     int pid = atoi(pidstr);
 
+    char *raw_pages_dir = getenv("CRAC_RAW_PAGES_IMAGE_DIR");
+    if (raw_pages_dir) {
+        char chain[PATH_MAX];
+        snprintf(chain, sizeof(chain), "%s", raw_pages_dir);
+        for (int depth = 0; depth < MAX_IMAGE_CHAIN; ++depth) {
+            remove_raw_page_images(chain);
+            if (!parent_of(chain)) {
+                break;
+            }
+        }
+    }
+
     char *strid = getenv("CRAC_NEW_ARGS_ID");
     return kickjvm(pid, strid ? atoi(strid) : 0);
 }
@@ -354,10 +1176,50 @@ static char *parse_options(int argc, char *argv[]) {
         .has_arg = 1,
         .flag = NULL,
         .val = 'o',
+    }, {
+        .name = "compress",
+        .has_arg = 1,
+        .flag = NULL,
+        .val = 'c',
+    }, {
+        .name = "compress-threads",
+        .has_arg = 1,
+        .flag = NULL,
+        .val = 't',
+    }, {
+        .name = "lazy-pages",
+        .has_arg = 0,
+        .flag = NULL,
+        .val = 'l',
+    }, {
+        .name = "page-store",
+        .has_arg = 1,
+        .flag = NULL,
+        .val = 's',
+    }, {
+        .name = "page-store-chunk",
+        .has_arg = 1,
+        .flag = NULL,
+        .val = 'k',
+    }, {
+        .name = "parent-image",
+        .has_arg = 1,
+        .flag = NULL,
+        .val = 'P',
+    }, {
+        .name = "prefetch",
+        .has_arg = 0,
+        .flag = NULL,
+        .val = 'p',
+    }, {
+        .name = "prefetch-threads",
+        .has_arg = 1,
+        .flag = NULL,
+        .val = 'T',
     }, { NULL, 0, NULL, 0} };
     bool processing = true;
     do {
-        switch (getopt_long(argc, argv, "v:o:", opts, NULL)) {
+        switch (getopt_long(argc, argv, "v:o:c:t:ls:k:pT:P:", opts, NULL)) {
             case -1:
             case '?':
                 processing = false;
@@ -371,6 +1233,50 @@ static char *parse_options(int argc, char *argv[]) {
             case 'o':
                 log_file = optarg;
                 break;
+            case 'c':
+                compressor = NULL;
+                for (size_t i = 0; i < ARRAY_SIZE(compressors); ++i) {
+                    if (!strcmp(compressors[i].name, optarg)) {
+                        compressor = &compressors[i];
+                    }
+                }
+                if (!compressor) {
+                    fprintf(stderr, "Unknown compressor %s, page images are not compressed\n", optarg);
+                }
+                break;
+            case 't':
+                compress_threads = strtol(optarg, NULL, 10);
+                break;
+            case 'l':
+                lazy_pages = true;
+                break;
+            case 'p':
+                prefetch = true;
+                break;
+            case 'T':
+                prefetch_threads = strtol(optarg, NULL, 10);
+                break;
+            case 'P':
+                // CRIU resolves a relative path against the image directory
+                parent_image = path_abs(optarg);
+                break;
+            case 's':
+                page_store = optarg;
+                break;
+            case 'k': {
+                char *unit;
+                page_store_chunk = strtol(optarg, &unit, 0);
+                switch (*unit) {
+                    case 'g': case 'G': page_store_chunk *= 1024; // fall through
+                    case 'm': case 'M': page_store_chunk *= 1024; // fall through
+                    case 'k': case 'K': page_store_chunk *= 1024;
+                }
+                if (page_store_chunk <= 0) {
+                    fprintf(stderr, "Invalid page store chunk size %s, using 2M\n", optarg);
+                    page_store_chunk = 2 * 1024 * 1024;
+                }
+                break;
+            }
         }
     } while (processing);
     return optind < argc ? argv[optind] : NULL;
@@ -381,6 +1287,14 @@ int main(int argc, char *argv[]) {
     if (argc >= 2 && (action = argv[1])) {
 
         char* imagedir = parse_options(argc, argv);
+        if (compressor && page_store) {
+            fprintf(stderr, "Warning: --compress is ignored when --page-store is used\n");
+            compressor = NULL;
+        }
+
+        if (!strcmp(action, "record-prefetch")) { // does not need CRIU
+            return record_prefetch(imagedir);
+        }
 
         char *basedir = dirname(strdup(argv[0]));
 
@@ -404,6 +1318,9 @@ int main(int argc, char *argv[]) {
         if (!strcmp(action, "checkpoint")) {
             pid_t jvm = getppid();
             return checkpoint(jvm, basedir, argv[0], criu, imagedir);
+        } else if (!strcmp(action, "predump")) {
+            pid_t jvm = getppid();
+            return predump(jvm, criu, imagedir);
         } else if (!strcmp(action, "restore")) {
             return restore(basedir, argv[0], criu, imagedir);
         } else if (!strcmp(action, "restorewait")) { // called by CRIU --exec-cmd
@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * Copyright (c) 2021, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.  Oracle designates this
+ * particular file as subject to the "Classpath" exception as provided
+ * by Oracle in the LICENSE file that accompanied this code.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * Restore of a CRaC image straight from the launcher.
+ *
+ * With -XX:CRaCRestoreFrom the VM does little more than hand its command line
+ * to the restored VM and exec the engine, but it does so only after libjvm is
+ * loaded and the arguments have been parsed. When the command line holds
+ * nothing the launcher cannot pass on by itself, it writes the restore
+ * parameters and execs the engine without loading the VM. Everything else
+ * takes the usual path through the VM, which also handles any failure here.
+ */
+
+#include "java.h"
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+extern char **environ;
+
+#define CRAC_RESTORE_FROM "-XX:CRaCRestoreFrom="
+#define CRAC_ENGINE "-XX:CREngine="
+#define CRAC_DEFAULT_ENGINE "criuengine"
+#define CRAC_MANIFEST "crac.manifest"
+#define CRAC_MAX_PARENTS 64
+#define CRAC_MAX_ENGINE_ARGS 32
+
+/* Must match CracRestoreParameters in hotspot's crac_structs.hpp */
+#define CRAC_PARAMS_MAGIC 0x43524143
+#define CRAC_PARAMS_VERSION 1
+struct CracParamsHeader {
+    jint magic;
+    jint version;
+    jlong size;
+    jlong restore_time;
+    jlong restore_nanos;
+    int nflags;
+    int nprops;
+    int env_memory_size;
+};
+
+/*
+ * Checks the manifests of the image and of its parents, as the VM does.
+ * Where the VM compares the build it was written by with its own, this
+ * compares the libjvm recorded with the one the launcher would load.
+ */
+static jboolean
+CheckManifest(const char *imagedir, const char *jvmpath)
+{
+    char dir[MAXPATHLEN];
+    char path[MAXPATHLEN];
+    char line[2 * MAXPATHLEN];
+    char realjvm[PATH_MAX];
+    int depth;
+
+    /* The VM records the canonical path */
+    if (realpath(jvmpath, realjvm) == NULL) {
+        return JNI_FALSE;
+    }
+
+    JLI_Snprintf(dir, sizeof(dir), "%s", imagedir);
+    for (depth = 0; depth < CRAC_MAX_PARENTS; depth++) {
+        jboolean has_vm = JNI_FALSE, has_libjvm = JNI_FALSE;
+        char parent[MAXPATHLEN];
+        FILE *f;
+
+        parent[0] = '\0';
+        if (JLI_Snprintf(path, sizeof(path), "%s/" CRAC_MANIFEST, dir) >= (int)sizeof(path)) {
+            return JNI_FALSE;
+        }
+        if ((f = fopen(path, "r")) == NULL) {
+            return JNI_TRUE; /* no manifest, accepted as by the VM */
+        }
+        while (fgets(line, sizeof(line), f) != NULL) {
+            struct stat st;
+            char *sep;
+            line[JLI_StrCSpn(line, "\n")] = '\0';
+            if (JLI_StrNCmp(line, "vm ", 3) == 0) {
+                has_vm = JNI_TRUE;
+            } else if (JLI_StrNCmp(line, "libjvm ", 7) == 0) {
+                long long size, mtime;
+                int pos = 0;
+                if (sscanf(line + 7, "%lld %lld %n", &size, &mtime, &pos) != 2 || pos == 0 ||
+                    JLI_StrCmp(line + 7 + pos, realjvm) != 0 ||
+                    stat(realjvm, &st) != 0 ||
+                    (long long)st.st_size != size || (long long)st.st_mtime != mtime) {
+                    break;
+                }
+                has_libjvm = JNI_TRUE;
+            } else if (JLI_StrNCmp(line, "file ", 5) == 0) {
+                if ((sep = JLI_StrRChr(line + 5, ' ')) == NULL) {
+                    break;
+                }
+                *sep = '\0';
+                if (JLI_Snprintf(path, sizeof(path), "%s/%s", dir, line + 5) >= (int)sizeof(path) ||
+                    stat(path, &st) != 0 ||
+                    (unsigned long long)st.st_size != strtoull(sep + 1, NULL, 10)) {
+                    break;
+                }
+            } else if (JLI_StrNCmp(line, "parent ", 7) == 0) {
+                JLI_Snprintf(parent, sizeof(parent), "%s", line + 7);
+            }
+        }
+        /* Stopped early on a mismatch */
+        if (!feof(f) || (has_vm && !has_libjvm)) {
+            fclose(f);
+            return JNI_FALSE;
+        }
+        fclose(f);
+        if (parent[0] == '\0') {
+            return JNI_TRUE;
+        }
+        JLI_StrCpy(dir, parent);
+    }
+    return JNI_FALSE;
+}
+
+/*
+ * Splits -XX:CREngine into the program and its options as the VM does:
+ * options are separated by commas, a backslash escapes the next character.
+ */
+static jboolean
+ParseEngine(const char *value, const char *jvmpath, char **args, int *argc)
+{
+    char *exec = JLI_StringDup(value);
+    char *comma = JLI_StrChr(exec, ',');
+    size_t len;
+
+    *argc = 2; /* program and action */
+    if (comma != NULL) {
+        char *c, *arg, *target;
+        jboolean escaped = JNI_FALSE;
+        *comma = '\0';
+        arg = target = comma + 1;
+        for (c = comma + 1; *c != '\0'; c++) {
+            if (!escaped) {
+                if (*c == '\\') {
+                    escaped = JNI_TRUE;
+                    continue;
+                }
+                if (*c == ',') {
+                    *target++ = '\0';
+                    if (*argc >= CRAC_MAX_ENGINE_ARGS - 2) {
+                        return JNI_FALSE;
+                    }
+                    args[(*argc)++] = arg;
+                    arg = target;
+                    continue;
+                }
+            }
+            escaped = JNI_FALSE;
+            *target++ = *c;
+        }
+        *target = '\0';
+        if (*argc >= CRAC_MAX_ENGINE_ARGS - 2) {
+            return JNI_FALSE;
+        }
+        args[(*argc)++] = arg;
+    }
+
+    /* An engine library is loaded by the VM */
+    len = JLI_StrLen(exec);
+    if (len > 3 && JLI_StrCmp(exec + len - 3, ".so") == 0) {
+        return JNI_FALSE;
+    }
+    if (exec[0] == '/') {
+        args[0] = exec;
+    } else {
+        /* Relative to the lib directory, the parent of libjvm's directory */
+        char path[MAXPATHLEN];
+        char *sep;
+        int i;
+        JLI_Snprintf(path, sizeof(path), "%s", jvmpath);
+        for (i = 0; i < 2; i++) {
+            if ((sep = JLI_StrRChr(path, '/')) == NULL) {
+                return JNI_FALSE;
+            }
+            *sep = '\0';
+        }
+        args[0] = JLI_MemAlloc(JLI_StrLen(path) + JLI_StrLen(exec) + 2);
+        sprintf(args[0], "%s/%s", path, exec);
+    }
+    args[1] = "restore";
+    return access(args[0], X_OK) == 0;
+}
+
+/*
+ * Writes the parameters for the restored VM to the shared memory object the
+ * VM names by the pid, as CracRestoreParameters::write_to does: the flags,
+ * the properties, the environment and the command.
+ */
+static jboolean
+WriteRestoreParameters(const char *shmpath, JLI_List flags, JLI_List props,
+                       const char *command, jlong restore_time, jlong restore_nanos)
+{
+    struct CracParamsHeader hdr;
+    size_t size, i;
+    char **env;
+    char *blob, *cursor;
+    int fd;
+    ssize_t written;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = CRAC_PARAMS_MAGIC;
+    hdr.version = CRAC_PARAMS_VERSION;
+    hdr.restore_time = restore_time;
+    hdr.restore_nanos = restore_nanos;
+    hdr.nflags = (int)flags->size;
+    hdr.nprops = (int)props->size;
+    for (env = environ; *env != NULL; env++) {
+        hdr.env_memory_size += (int)JLI_StrLen(*env) + 1;
+    }
+    size = sizeof(hdr) + hdr.env_memory_size + JLI_StrLen(command) + 1;
+    for (i = 0; i < flags->size; i++) {
+        size += JLI_StrLen(flags->elements[i]) + 1;
+    }
+    for (i = 0; i < props->size; i++) {
+        size += JLI_StrLen(props->elements[i]) + 1;
+    }
+    hdr.size = (jlong)size;
+
+    blob = JLI_MemAlloc(size);
+    memcpy(blob, &hdr, sizeof(hdr));
+    cursor = blob + sizeof(hdr);
+    for (i = 0; i < flags->size; i++) {
+        JLI_StrCpy(cursor, flags->elements[i]);
+        cursor += JLI_StrLen(cursor) + 1;
+    }
+    for (i = 0; i < props->size; i++) {
+        JLI_StrCpy(cursor, props->elements[i]);
+        cursor += JLI_StrLen(cursor) + 1;
+    }
+    for (env = environ; *env != NULL; env++) {
+        JLI_StrCpy(cursor, *env);
+        cursor += JLI_StrLen(cursor) + 1;
+    }
+    JLI_StrCpy(cursor, command);
+
+    /* shm_open() without librt: POSIX shared memory objects live in /dev/shm */
+    fd = open(shmpath, O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        JLI_MemFree(blob);
+        return JNI_FALSE;
+    }
+    written = write(fd, blob, size);
+    close(fd);
+    JLI_MemFree(blob);
+    if (written < 0 || (size_t)written != size) {
+        unlink(shmpath);
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+void
+CracRestoreFromLauncher(int argc, char **argv, const char *jvmpath)
+{
+    const char *imagedir = NULL;
+    const char *engine = CRAC_DEFAULT_ENGINE;
+    char *engine_args[CRAC_MAX_ENGINE_ARGS];
+    int engine_argc;
+    JLI_List flags, props;
+    char *command;
+    char shmpath[64];
+    char strid[32];
+    struct timeval tv;
+    struct timespec ts;
+    jlong restore_time, restore_nanos;
+    int i;
+
+    /* The VM reads more options from these */
+    if (getenv("JAVA_TOOL_OPTIONS") != NULL || getenv("_JAVA_OPTIONS") != NULL) {
+        return;
+    }
+
+    /* Record the start as the VM does before parsing its arguments */
+    gettimeofday(&tv, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    restore_time = (jlong)tv.tv_sec * 1000 + tv.tv_usec / 1000;
+    restore_nanos = (jlong)ts.tv_sec * 1000000000 + ts.tv_nsec;
+
+    /* Both flags are passed on to the restored VM, which can set them */
+    flags = JLI_List_new(2);
+    props = JLI_List_new(8);
+    for (i = 1; i < argc && argv[i][0] == '-'; i++) {
+        const char *arg = argv[i];
+        if (JLI_StrNCmp(arg, CRAC_RESTORE_FROM, JLI_StrLen(CRAC_RESTORE_FROM)) == 0) {
+            imagedir = arg + JLI_StrLen(CRAC_RESTORE_FROM);
+            JLI_List_add(flags, JLI_StringDup(arg + 4));
+        } else if (JLI_StrNCmp(arg, CRAC_ENGINE, JLI_StrLen(CRAC_ENGINE)) == 0) {
+            engine = arg + JLI_StrLen(CRAC_ENGINE);
+            JLI_List_add(flags, JLI_StringDup(arg + 4));
+        } else if (JLI_StrCmp(arg, "-cp") == 0 || JLI_StrCmp(arg, "-classpath") == 0 ||
+                   JLI_StrCmp(arg, "--class-path") == 0) {
+            /* Ignored by the restored VM, like -Djava.class.path */
+            if (++i == argc) {
+                break;
+            }
+        } else if (JLI_StrNCmp(arg, "-D", 2) == 0 && arg[2] != '\0') {
+            if (JLI_StrNCmp(arg + 2, "sun.java.command=", 17) == 0) {
+                /* Replaces the command, left to the VM */
+                imagedir = NULL;
+                break;
+            }
+            /* Dropped by the VM on restore */
+            if (JLI_StrNCmp(arg + 2, "java.class.path=", 16) != 0 &&
+                JLI_StrNCmp(arg + 2, "sun.java.launcher", 17) != 0) {
+                JLI_List_add(props, JLI_StringDup(arg + 2));
+            }
+        } else {
+            /* Only the VM knows which flags can be set on restore */
+            imagedir = NULL;
+            break;
+        }
+    }
+    if (imagedir == NULL || imagedir[0] == '\0' || !CheckManifest(imagedir, jvmpath) ||
+        !ParseEngine(engine, jvmpath, engine_args, &engine_argc)) {
+        JLI_List_free(flags);
+        JLI_List_free(props);
+        return;
+    }
+
+    /* The command is the main class and its arguments, as in sun.java.command */
+    {
+        JLI_List words = JLI_List_new(argc - i + 1);
+        for (; i < argc; i++) {
+            JLI_List_add(words, JLI_StringDup(argv[i]));
+        }
+        command = JLI_List_join(words, ' ');
+        JLI_List_free(words);
+    }
+
+    JLI_Snprintf(strid, sizeof(strid), "%d", (int)getpid());
+    JLI_Snprintf(shmpath, sizeof(shmpath), "/dev/shm/crac_%s", strid);
+    if (WriteRestoreParameters(shmpath, flags, props, command, restore_time, restore_nanos)) {
+        setenv("CRAC_NEW_ARGS_ID", strid, 1);
+    }
+    JLI_List_free(flags);
+    JLI_List_free(props);
+    JLI_MemFree(command);
+
+    engine_args[engine_argc++] = (char *)imagedir;
+    engine_args[engine_argc] = NULL;
+    JLI_TraceLauncher("Restoring %s with %s\n", imagedir, engine_args[0]);
+    execv(engine_args[0], engine_args);
+
+    /* Leave it to the VM, which tells why the engine cannot run */
+    JLI_TraceLauncher("Cannot execute %s: %s\n", engine_args[0], strerror(errno));
+    unlink(shmpath);
+    unsetenv("CRAC_NEW_ARGS_ID");
+}
+
+#else /* !__linux__ */
+
+void
+CracRestoreFromLauncher(int argc, char **argv, const char *jvmpath)
+{
+}
+
+#endif /* __linux__ */
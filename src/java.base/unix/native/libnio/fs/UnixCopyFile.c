@@ -31,6 +31,7 @@
 #include <errno.h>
 
 #if defined(__linux__)
+#include <dlfcn.h>
 #include <sys/sendfile.h>
 #elif defined(_ALLBSD_SOURCE)
 #include <copyfile.h>
@@ -51,6 +52,61 @@ static void throwUnixException(JNIEnv* env, int errnum) {
     }
 }
 
+#if defined(__linux__)
+typedef ssize_t copy_file_range_func(int, loff_t*, int, loff_t*, size_t,
+                                     unsigned int);
+
+// copy_file_range() if the C library has it (glibc 2.27 and later), looked
+// up on first use; racing threads find the same function
+static copy_file_range_func* copy_file_range_lookup()
+{
+    static copy_file_range_func* func = NULL;
+    static volatile int looked_up = 0;
+    if (!looked_up) {
+        func = (copy_file_range_func*)dlsym(RTLD_DEFAULT, "copy_file_range");
+        looked_up = 1;
+    }
+    return func;
+}
+
+// Copy with copy_file_range(), which lets the file system share or offload
+// the data. Returns 1 if done (or an exception is pending), 0 if the caller
+// should continue with sendfile() from the current file offsets.
+static int copy_range(JNIEnv* env, jint dst, jint src, size_t count,
+                      volatile jint* cancel)
+{
+    copy_file_range_func* my_copy_file_range = copy_file_range_lookup();
+    jboolean copied = JNI_FALSE;
+    ssize_t bytes_copied;
+    if (my_copy_file_range == NULL) {
+        return 0;
+    }
+    do {
+        RESTARTABLE(my_copy_file_range(src, NULL, dst, NULL, count, 0),
+                    bytes_copied);
+        if (bytes_copied == -1) {
+            if (errno == EXDEV || errno == EINVAL || errno == ENOSYS ||
+                errno == EOPNOTSUPP || errno == EBADF) {
+                // Not supported between these files
+                return 0;
+            }
+            throwUnixException(env, errno);
+            return 1;
+        }
+        if (cancel != NULL && *cancel != 0) {
+            throwUnixException(env, ECANCELED);
+            return 1;
+        }
+        if (bytes_copied > 0) {
+            copied = JNI_TRUE;
+        }
+    } while (bytes_copied > 0);
+    // Some kernels copy nothing from files such as those in /proc that
+    // report a size of zero, so let sendfile() confirm an empty source.
+    return copied ? 1 : 0;
+}
+#endif
+
 #if defined(_ALLBSD_SOURCE)
 int fcopyfile_callback(int what, int stage, copyfile_state_t state,
     const char* src, const char* dst, void* cancel)
@@ -102,8 +158,8 @@ void transfer(JNIEnv* env, jint dst, jint src, volatile jint* cancel)
 }
 
 /**
- * Transfer all bytes from src to dst within the kernel if possible (Linux),
- * otherwise via user-space buffers
+ * Transfer all bytes from src to dst within the kernel if possible (Linux,
+ * preferring copy_file_range over sendfile), otherwise via user-space buffers
  */
 JNIEXPORT void JNICALL
 Java_sun_nio_fs_UnixCopyFile_transfer
@@ -117,6 +173,9 @@ Java_sun_nio_fs_UnixCopyFile_transfer
         1048576 :   // 1 MB to give cancellation a chance
         0x7ffff000; // maximum number of bytes that sendfile() can transfer
     ssize_t bytes_sent;
+    if (copy_range(env, dst, src, count, cancel)) {
+        return;
+    }
     do {
         RESTARTABLE(sendfile64(dst, src, NULL, count), bytes_sent);
         if (bytes_sent == -1) {
@@ -151,6 +151,14 @@ IsJavaw()
     return _isjavaw;
 }
 
+/*
+ * CRaC images are restored by the VM only.
+ */
+void
+CracRestoreFromLauncher(int argc, char **argv, const char *jvmpath)
+{
+}
+
 /*
  *
  */
@@ -72,6 +72,12 @@ typedef struct {
     unsigned fontDataOffset;
     unsigned fontDataLength;
     unsigned fileSize;
+
+    /* Transform and size last applied to the face, so that consecutive
+       calls for the same context do not reset the face size. */
+    jboolean faceSizeValid;
+    FT_Matrix faceMatrix;
+    int facePtsz;
 } FTScalerInfo;
 
 typedef struct FTScalerContext {
@@ -585,6 +591,19 @@ static int setupFTContext(JNIEnv *env,
 
     if (context != NULL) {
         setupTransform(&matrix, context);
+
+        /* FT_Set_Char_Size recomputes the size metrics and, for hinted
+           TrueType fonts, reruns the prep program, so skip it when the
+           face is already set up for this transform and size. */
+        if (scalerInfo->faceSizeValid &&
+            scalerInfo->facePtsz == context->ptsz &&
+            scalerInfo->faceMatrix.xx == matrix.xx &&
+            scalerInfo->faceMatrix.xy == matrix.xy &&
+            scalerInfo->faceMatrix.yx == matrix.yx &&
+            scalerInfo->faceMatrix.yy == matrix.yy) {
+            return 0;
+        }
+
         FT_Set_Transform(scalerInfo->face, &matrix, NULL);
 
         errCode = FT_Set_Char_Size(scalerInfo->face, 0, context->ptsz, 72, 72);
@@ -594,6 +613,10 @@ static int setupFTContext(JNIEnv *env,
         }
 
         FT_Library_SetLcdFilter(scalerInfo->library, FT_LCD_FILTER_DEFAULT);
+
+        scalerInfo->faceSizeValid = (errCode == 0);
+        scalerInfo->faceMatrix = matrix;
+        scalerInfo->facePtsz = context->ptsz;
     }
 
     return errCode;
@@ -16,6 +16,12 @@
 #include "jinclude.h"
 #include "jpeglib.h"
 
+#if BITS_IN_JSAMPLE == 8 && \
+    (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64))
+#define YCC_RGB_SSE2
+#include <emmintrin.h>
+#endif
+
 
 /* Private subobject */
 
@@ -109,6 +115,73 @@ build_ycc_rgb_table (j_decompress_ptr cinfo)
 }
 
 
+#ifdef YCC_RGB_SSE2
+
+/*
+ * SSE2 version of the YCC->RGB inner loop, 8 pixels per iteration.
+ * It yields exactly the table results: each constant is split into a
+ * multiple of 2^16, which commutes with the right shift, and a 16-bit
+ * remainder that pmaddwd multiplies together with the rounding term.
+ *      1.40200 * 2^16 =  91881 =  1 * 2^16 + 26345
+ *      1.77200 * 2^16 = 116130 =  2 * 2^16 - 14942
+ *      0.71414 * 2^16 =  46802 =  1 * 2^16 - 18734
+ * Saturating packing to bytes does what range_limit does.
+ * Returns the number of pixels converted; the caller does the rest.
+ */
+
+LOCAL(JDIMENSION)
+ycc_rgb_convert_sse2 (JSAMPROW inptr0, JSAMPROW inptr1, JSAMPROW inptr2,
+                      JSAMPROW outptr, JDIMENSION num_cols)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i center = _mm_set1_epi16(CENTERJSAMPLE);
+  const __m128i half = _mm_set1_epi32(ONE_HALF);
+  /* Coefficient pairs applied to interleaved (Cb, Cr) */
+  const __m128i kr = _mm_set_epi16(26345, 0, 26345, 0, 26345, 0, 26345, 0);
+  const __m128i kg = _mm_set_epi16(18734, -22554, 18734, -22554,
+                                   18734, -22554, 18734, -22554);
+  const __m128i kb = _mm_set_epi16(0, -14942, 0, -14942, 0, -14942, 0, -14942);
+  JSAMPLE r[8], g[8], b[8];
+  JDIMENSION col;
+  int i;
+
+  for (col = 0; col + 8 <= num_cols; col += 8) {
+    __m128i y = _mm_unpacklo_epi8(
+        _mm_loadl_epi64((const __m128i *) (inptr0 + col)), zero);
+    __m128i cb = _mm_sub_epi16(_mm_unpacklo_epi8(
+        _mm_loadl_epi64((const __m128i *) (inptr1 + col)), zero), center);
+    __m128i cr = _mm_sub_epi16(_mm_unpacklo_epi8(
+        _mm_loadl_epi64((const __m128i *) (inptr2 + col)), zero), center);
+    __m128i lo = _mm_unpacklo_epi16(cb, cr);
+    __m128i hi = _mm_unpackhi_epi16(cb, cr);
+    __m128i rv, gv, bv;
+
+#define YCC_TERM(k) _mm_packs_epi32( \
+    _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(lo, k), half), SCALEBITS), \
+    _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(hi, k), half), SCALEBITS))
+
+    rv = _mm_add_epi16(_mm_add_epi16(y, cr), YCC_TERM(kr));
+    gv = _mm_add_epi16(_mm_sub_epi16(y, cr), YCC_TERM(kg));
+    bv = _mm_add_epi16(_mm_add_epi16(y, _mm_add_epi16(cb, cb)), YCC_TERM(kb));
+
+#undef YCC_TERM
+
+    _mm_storel_epi64((__m128i *) r, _mm_packus_epi16(rv, rv));
+    _mm_storel_epi64((__m128i *) g, _mm_packus_epi16(gv, gv));
+    _mm_storel_epi64((__m128i *) b, _mm_packus_epi16(bv, bv));
+    for (i = 0; i < 8; i++) {
+      outptr[RGB_RED] = r[i];
+      outptr[RGB_GREEN] = g[i];
+      outptr[RGB_BLUE] = b[i];
+      outptr += RGB_PIXELSIZE;
+    }
+  }
+  return col;
+}
+
+#endif /* YCC_RGB_SSE2 */
+
+
 /*
  * Convert some rows of samples to the output colorspace.
  *
@@ -145,7 +218,13 @@ ycc_rgb_convert (j_decompress_ptr cinfo,
     inptr2 = input_buf[2][input_row];
     input_row++;
     outptr = *output_buf++;
-    for (col = 0; col < num_cols; col++) {
+#ifdef YCC_RGB_SSE2
+    col = ycc_rgb_convert_sse2(inptr0, inptr1, inptr2, outptr, num_cols);
+    outptr += col * RGB_PIXELSIZE;
+#else
+    col = 0;
+#endif
+    for (; col < num_cols; col++) {
       y  = GETJSAMPLE(inptr0[col]);
       cb = GETJSAMPLE(inptr1[col]);
       cr = GETJSAMPLE(inptr2[col]);
@@ -77,8 +77,104 @@ JavaVM* jvm = NULL;
 
 jboolean debug = 0;
 
+/*
+ * Initialized modules are finalized before a CRaC checkpoint, which lets them
+ * close the devices and connections of their tokens, and are initialized
+ * again with the same arguments after it. Sessions, logins and objects of the
+ * tokens do not survive this, calls with handles obtained before fail with
+ * CKR_SESSION_HANDLE_INVALID or CKR_OBJECT_HANDLE_INVALID.
+ */
+typedef struct InitializedModule {
+    CK_FUNCTION_LIST_PTR ckpFunctions;
+    /* copy of the arguments to C_Initialize, if there were any */
+    CK_C_INITIALIZE_ARGS initArgs;
+    jboolean hasInitArgs;
+    /* finalized by the checkpoint and to be initialized again */
+    jboolean finalized;
+    struct InitializedModule *next;
+} InitializedModule;
+
+static InitializedModule *initializedModules = NULL;
+static jobject initializedModulesLock = NULL;
+
+static void addInitializedModule(JNIEnv *env, CK_FUNCTION_LIST_PTR ckpFunctions,
+                                 CK_C_INITIALIZE_ARGS_PTR ckpInitArgs)
+{
+    InitializedModule *module;
+
+    if (initializedModulesLock == NULL) { return; }
+    module = (InitializedModule *) calloc(1, sizeof(InitializedModule));
+    if (module == NULL) { return; }
+    module->ckpFunctions = ckpFunctions;
+    if (ckpInitArgs != NULL_PTR) {
+        memcpy(&module->initArgs, ckpInitArgs, sizeof(CK_C_INITIALIZE_ARGS));
+        module->hasInitArgs = JNI_TRUE;
+    }
+    (*env)->MonitorEnter(env, initializedModulesLock);
+    module->next = initializedModules;
+    initializedModules = module;
+    (*env)->MonitorExit(env, initializedModulesLock);
+}
+
+void removeInitializedModule(JNIEnv *env, CK_FUNCTION_LIST_PTR ckpFunctions)
+{
+    InitializedModule **link, *module = NULL;
+
+    if (initializedModulesLock == NULL) { return; }
+    (*env)->MonitorEnter(env, initializedModulesLock);
+    for (link = &initializedModules; *link != NULL; link = &(*link)->next) {
+        if ((*link)->ckpFunctions == ckpFunctions) {
+            module = *link;
+            *link = module->next;
+            break;
+        }
+    }
+    (*env)->MonitorExit(env, initializedModulesLock);
+    free(module);
+}
+
+static void JNICALL beforeCheckpoint(JNIEnv *env, void *data)
+{
+    InitializedModule *module;
+    CK_RV rv;
+
+    (*env)->MonitorEnter(env, initializedModulesLock);
+    for (module = initializedModules; module != NULL; module = module->next) {
+        rv = (*module->ckpFunctions->C_Finalize)(NULL_PTR);
+        TRACE1("DEBUG: C_Finalize before checkpoint, rv=0x%lX\n", rv);
+        module->finalized = (rv == CKR_OK) ? JNI_TRUE : JNI_FALSE;
+    }
+    /* Held until after the restore, so modules are not used meanwhile */
+}
+
+static void JNICALL afterRestore(JNIEnv *env, void *data)
+{
+    InitializedModule *module;
+    CK_RV rv;
+
+    for (module = initializedModules; module != NULL; module = module->next) {
+        if (module->finalized) {
+            rv = (*module->ckpFunctions->C_Initialize)(module->hasInitArgs ? &module->initArgs : NULL_PTR);
+            if (rv != CKR_OK) {
+                TRACE1("DEBUG: C_Initialize after restore failed, rv=0x%lX\n", rv);
+            }
+            module->finalized = JNI_FALSE;
+        }
+    }
+    (*env)->MonitorExit(env, initializedModulesLock);
+}
+
 JNIEXPORT jint JNICALL DEF_JNI_OnLoad(JavaVM *vm, void *reserved) {
+    JNIEnv *env;
     jvm = vm;
+    if ((*vm)->GetEnv(vm, (void **)&env, JNI_VERSION_1_4) == JNI_OK) {
+        initializedModulesLock = createLockObject(env);
+        if (initializedModulesLock != NULL) {
+            registerCheckpointHooks(&beforeCheckpoint, &afterRestore);
+        } else {
+            (*env)->ExceptionClear(env);
+        }
+    }
     return JNI_VERSION_1_4;
 }
 
@@ -230,6 +326,9 @@ Java_sun_security_pkcs11_wrapper_PKCS11_C_1Initialize
 
     rv = (*ckpFunctions->C_Initialize)(ckpInitArgs);
 
+    if (rv == CKR_OK) {
+        addInitializedModule(env, ckpFunctions, ckpInitArgs);
+    }
     free(ckpInitArgs);
 
     if (ckAssertReturnValueOK(env, rv) != CK_ASSERT_OK) {
@@ -266,6 +365,7 @@ Java_sun_security_pkcs11_wrapper_PKCS11_C_1Finalize
 
     rv = (*ckpFunctions->C_Finalize)(ckpReserved);
     if (ckAssertReturnValueOK(env, rv) != CK_ASSERT_OK) { return; }
+    removeInitializedModule(env, ckpFunctions);
 }
 #endif
 
@@ -119,6 +119,7 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
     CK_BYTE_PTR bufP;
     CK_ULONG ckSignatureLength;
     CK_BYTE BUF[MAX_STACK_BUFFER_LEN];
+    CK_BYTE DATABUF[MAX_STACK_BUFFER_LEN];
     jbyteArray jSignature = NULL;
     CK_RV rv;
 
@@ -128,8 +129,9 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
     TRACE0("DEBUG: C_Sign\n");
 
     ckSessionHandle = jLongToCKULong(jSessionHandle);
-    jByteArrayToCKByteArray(env, jData, &ckpData, &ckDataLength);
+    jByteArrayToCKByteArrayBuf(env, jData, DATABUF, MAX_STACK_BUFFER_LEN, &ckpData, &ckDataLength);
     if ((*env)->ExceptionCheck(env)) {
+        if (ckpData != DATABUF) { free(ckpData); }
         return NULL;
     }
 
@@ -160,7 +162,7 @@ JNIEXPORT jbyteArray JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Sign
     }
 
 cleanup:
-    free(ckpData);
+    if (ckpData != DATABUF) { free(ckpData); }
     if (bufP != BUF) { free(bufP); }
 
     TRACE0("FINISHED\n");
@@ -451,6 +453,8 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Verify
     CK_BYTE_PTR ckpSignature = NULL_PTR;
     CK_ULONG ckDataLength;
     CK_ULONG ckSignatureLength;
+    CK_BYTE DATABUF[MAX_STACK_BUFFER_LEN];
+    CK_BYTE SIGBUF[MAX_STACK_BUFFER_LEN];
     CK_RV rv = 0;
 
     CK_FUNCTION_LIST_PTR ckpFunctions = getFunctionList(env, obj);
@@ -458,12 +462,12 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Verify
 
     ckSessionHandle = jLongToCKULong(jSessionHandle);
 
-    jByteArrayToCKByteArray(env, jData, &ckpData, &ckDataLength);
+    jByteArrayToCKByteArrayBuf(env, jData, DATABUF, MAX_STACK_BUFFER_LEN, &ckpData, &ckDataLength);
     if ((*env)->ExceptionCheck(env)) {
-        return;
+        goto cleanup;
     }
 
-    jByteArrayToCKByteArray(env, jSignature, &ckpSignature, &ckSignatureLength);
+    jByteArrayToCKByteArrayBuf(env, jSignature, SIGBUF, MAX_STACK_BUFFER_LEN, &ckpSignature, &ckSignatureLength);
     if ((*env)->ExceptionCheck(env)) {
         goto cleanup;
     }
@@ -472,8 +476,8 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_C_1Verify
     rv = (*ckpFunctions->C_Verify)(ckSessionHandle, ckpData, ckDataLength, ckpSignature, ckSignatureLength);
 
 cleanup:
-    free(ckpData);
-    free(ckpSignature);
+    if (ckpData != DATABUF) { free(ckpData); }
+    if (ckpSignature != SIGBUF) { free(ckpSignature); }
 
     ckAssertReturnValueOK(env, rv);
 }
@@ -604,6 +604,33 @@ void jByteArrayToCKByteArray(JNIEnv *env, const jbyteArray jArray, CK_BYTE_PTR *
     }
 }
 
+/*
+ * converts a jbyteArray to a CK_BYTE array like jByteArrayToCKByteArray, but
+ * copies it into the given buffer if it fits. Only an array other than the
+ * buffer has to be freed after use!
+ *
+ * @param env - used to call JNI functions to get the array informtaion
+ * @param jArray - the Java array to convert
+ * @param buf - the buffer to use for arrays of up to bufLen bytes
+ * @param bufLen - the length of the buffer
+ * @param ckpArray - the reference, where the pointer to the CK_BYTE array will be stored
+ * @param ckpLength - the reference, where the array length will be stored
+ */
+void jByteArrayToCKByteArrayBuf(JNIEnv *env, const jbyteArray jArray, CK_BYTE_PTR buf, CK_ULONG bufLen,
+                                CK_BYTE_PTR *ckpArray, CK_ULONG_PTR ckpLength)
+{
+    if (jArray != NULL && sizeof(CK_BYTE) == sizeof(jbyte)) {
+        jsize len = (*env)->GetArrayLength(env, jArray);
+        if ((CK_ULONG) len <= bufLen) {
+            (*env)->GetByteArrayRegion(env, jArray, 0, len, (jbyte*) buf);
+            *ckpArray = buf;
+            *ckpLength = (CK_ULONG) len;
+            return;
+        }
+    }
+    jByteArrayToCKByteArray(env, jArray, ckpArray, ckpLength);
+}
+
 /*
  * converts a jlongArray to a CK_ULONG array. The allocated memory has to be freed after use!
  *
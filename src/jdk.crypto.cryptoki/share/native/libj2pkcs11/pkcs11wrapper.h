@@ -323,6 +323,7 @@ void freeCKMechanismPtr(CK_MECHANISM_PTR mechPtr);
 
 void jBooleanArrayToCKBBoolArray(JNIEnv *env, const jbooleanArray jArray, CK_BBOOL **ckpArray, CK_ULONG_PTR ckLength);
 void jByteArrayToCKByteArray(JNIEnv *env, const jbyteArray jArray, CK_BYTE_PTR *ckpArray, CK_ULONG_PTR ckLength);
+void jByteArrayToCKByteArrayBuf(JNIEnv *env, const jbyteArray jArray, CK_BYTE_PTR buf, CK_ULONG bufLen, CK_BYTE_PTR *ckpArray, CK_ULONG_PTR ckLength);
 void jLongArrayToCKULongArray(JNIEnv *env, const jlongArray jArray, CK_ULONG_PTR *ckpArray, CK_ULONG_PTR ckLength);
 void jCharArrayToCKCharArray(JNIEnv *env, const jcharArray jArray, CK_CHAR_PTR *ckpArray, CK_ULONG_PTR ckLength);
 void jCharArrayToCKUTF8CharArray(JNIEnv *env, const jcharArray jArray, CK_UTF8CHAR_PTR *ckpArray, CK_ULONG_PTR ckLength);
@@ -454,6 +455,12 @@ NotifyEncapsulation * removeNotifyEntry(JNIEnv *env, CK_SESSION_HANDLE hSession)
 NotifyEncapsulation * removeFirstNotifyEntry(JNIEnv *env);
 
 jobject createLockObject(JNIEnv *env);
+
+/* CRaC checkpoint support */
+
+void removeInitializedModule(JNIEnv *env, CK_FUNCTION_LIST_PTR ckpFunctions);
+void registerCheckpointHooks(void (JNICALL *beforeCheckpoint)(JNIEnv *env, void *data),
+                             void (JNICALL *afterRestore)(JNIEnv *env, void *data));
 void destroyLockObject(JNIEnv *env, jobject jLockObject);
 
 extern jfieldID pNativeDataID;
@@ -187,9 +187,30 @@ JNIEXPORT void JNICALL Java_sun_security_pkcs11_wrapper_PKCS11_disconnect
     moduleData = removeModuleEntry(env, obj);
 
     if (moduleData != NULL) {
+        removeInitializedModule(env, moduleData->ckFunctionListPtr);
         FreeLibrary(moduleData->hModule);
     }
 
     free(moduleData);
     TRACE0("FINISHED\n");
 }
+
+typedef jboolean (JNICALL *RegisterCheckpointHook_t)(
+        void (JNICALL *beforeCheckpoint)(JNIEnv *env, void *data),
+        void (JNICALL *afterRestore)(JNIEnv *env, void *data),
+        void *data);
+
+/*
+ * Registers the CRaC checkpoint hooks with the VM. They are looked up
+ * rather than linked to, as this library does not link against the VM.
+ */
+void registerCheckpointHooks(void (JNICALL *beforeCheckpoint)(JNIEnv *env, void *data),
+                             void (JNICALL *afterRestore)(JNIEnv *env, void *data))
+{
+    HMODULE hJvm = GetModuleHandle("jvm.dll");
+    RegisterCheckpointHook_t registerHook = (hJvm == NULL) ? NULL :
+        (RegisterCheckpointHook_t) GetProcAddress(hJvm, "JVM_RegisterCheckpointHook");
+    if (registerHook != NULL) {
+        (*registerHook)(beforeCheckpoint, afterRestore, NULL);
+    }
+}
@@ -69,6 +69,10 @@ typedef struct map_info {
    uintptr_t        vaddr;    // starting virtual address
    size_t           memsz;    // size of the mapping
    uint32_t         flags;    // acces flags
+   char*            mapped;   // file data at offset when mmap'ed, or NULL
+   char*            map_base; // mmap'ed region, page aligned
+   size_t           map_len;
+   bool             map_failed; // mmap was tried and failed, use pread
    struct map_info* next;
 } map_info;
 
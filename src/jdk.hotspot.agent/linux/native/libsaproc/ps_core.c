@@ -28,6 +28,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <elf.h>
 #include <link.h>
 #include "libproc_impl.h"
@@ -105,6 +107,40 @@ static bool sort_map_array(struct ps_prochandle* ph) {
 #define MIN(x, y) (((x) < (y))? (x): (y))
 #endif
 
+// Map the file data of a mapping on first access, so that reads are
+// served from the page cache without a system call each. Mappings whose
+// data is not all in the file (e.g. a truncated core) keep using pread,
+// since touching a page past the end of the file raises SIGBUS.
+static char* core_map_data(map_info* mp, int page_size) {
+  struct stat st;
+  off_t start;
+  size_t len;
+  void* base;
+
+  if (mp->mapped != NULL || mp->map_failed) {
+    return mp->mapped;
+  }
+  mp->map_failed = true;
+
+  if (mp->memsz == 0 || fstat(mp->fd, &st) != 0 ||
+      mp->offset < 0 || (uint64_t)mp->offset + mp->memsz > (uint64_t)st.st_size) {
+    return NULL;
+  }
+  start = mp->offset & ~((off_t)page_size - 1);
+  len = (size_t)(mp->offset - start) + mp->memsz;
+  base = mmap(NULL, len, PROT_READ, MAP_PRIVATE, mp->fd, start);
+  if (base == MAP_FAILED) {
+    print_debug("can't mmap %zu bytes at offset %ld\n", len, (long)start);
+    return NULL;
+  }
+
+  mp->map_failed = false;
+  mp->map_base = (char*)base;
+  mp->map_len = len;
+  mp->mapped = mp->map_base + (mp->offset - start);
+  return mp->mapped;
+}
+
 static bool core_read_data(struct ps_prochandle* ph, uintptr_t addr, char *buf, size_t size) {
    ssize_t resid = size;
    int page_size=sysconf(_SC_PAGE_SIZE);
@@ -114,6 +150,7 @@ static bool core_read_data(struct ps_prochandle* ph, uintptr_t addr, char *buf,
       ssize_t len, rem;
       off_t off;
       int fd;
+      char* data;
 
       if (mp == NULL) {
          break;  /* No mapping for this address */
@@ -124,7 +161,9 @@ static bool core_read_data(struct ps_prochandle* ph, uintptr_t addr, char *buf,
       len = MIN(resid, mp->memsz - mapoff);
       off = mp->offset + mapoff;
 
-      if ((len = pread(fd, buf, len, off)) <= 0) {
+      if ((data = core_map_data(mp, page_size)) != NULL) {
+         memcpy(buf, data + mapoff, len);
+      } else if ((len = pread(fd, buf, len, off)) <= 0) {
          break;
       }
 
@@ -424,6 +463,14 @@ static bool read_lib_segments(struct ps_prochandle* ph, int lib_fd, ELF_EHDR* li
         existing_map->fd = lib_fd;
         existing_map->offset = lib_php->p_offset;
         existing_map->memsz = ROUNDUP(lib_php->p_memsz, page_size);
+        // drop the view of the coredump data the map had so far
+        if (existing_map->map_base != NULL) {
+          munmap(existing_map->map_base, existing_map->map_len);
+        }
+        existing_map->mapped = NULL;
+        existing_map->map_base = NULL;
+        existing_map->map_len = 0;
+        existing_map->map_failed = false;
       }
     }
 
@@ -46,6 +46,10 @@ typedef struct symtab {
   size_t num_symbols;
   struct elf_symbol *symbols;
   struct hsearch_data *hash_table;
+  // named symbols sorted by offset for nearest_symbol, built on first use
+  struct elf_symbol **by_offset;
+  size_t num_by_offset;
+  uintptr_t max_size;
 } symtab_t;
 
 
@@ -527,6 +531,7 @@ void destroy_symtab(struct symtab* symtab) {
      hdestroy_r(symtab->hash_table);
      free(symtab->hash_table);
   }
+  if (symtab->by_offset) free(symtab->by_offset);
   free(symtab);
 }
 
@@ -555,17 +560,75 @@ quit:
   return (uintptr_t) NULL;
 }
 
+// Order by offset, then by position in the symbol table, so that a lookup
+// finds the same symbol as a scan of the table in order would.
+static int cmp_symbol_offset(const void *lhsp, const void *rhsp) {
+  const struct elf_symbol *lhs = *((const struct elf_symbol **)lhsp);
+  const struct elf_symbol *rhs = *((const struct elf_symbol **)rhsp);
+
+  if (lhs->offset != rhs->offset) {
+    return lhs->offset < rhs->offset ? -1 : 1;
+  }
+  return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+}
+
+static bool build_offset_index(struct symtab* symtab) {
+  size_t n, count = 0;
+
+  symtab->by_offset = (struct elf_symbol **)
+      malloc(symtab->num_symbols * sizeof(struct elf_symbol *));
+  if (symtab->by_offset == NULL) {
+    return false;
+  }
+  for (n = 0; n < symtab->num_symbols; n++) {
+    struct elf_symbol* sym = &(symtab->symbols[n]);
+    if (sym->name != NULL && sym->size > 0) {
+      symtab->by_offset[count++] = sym;
+      if (sym->size > symtab->max_size) {
+        symtab->max_size = sym->size;
+      }
+    }
+  }
+  qsort(symtab->by_offset, count, sizeof(struct elf_symbol *), cmp_symbol_offset);
+  symtab->num_by_offset = count;
+  return true;
+}
+
 const char* nearest_symbol(struct symtab* symtab, uintptr_t offset,
                            uintptr_t* poffset) {
-  int n = 0;
-  if (!symtab) return NULL;
-  for (; n < symtab->num_symbols; n++) {
-     struct elf_symbol* sym = &(symtab->symbols[n]);
-     if (sym->name != NULL &&
-         offset >= sym->offset && offset < sym->offset + sym->size) {
-        if (poffset) *poffset = (offset - sym->offset);
-        return sym->name;
-     }
+  struct elf_symbol* best = NULL;
+  size_t lo, hi;
+
+  if (!symtab || symtab->num_symbols == 0) return NULL;
+  if (symtab->by_offset == NULL && !build_offset_index(symtab)) return NULL;
+
+  // find the first symbol that starts after offset
+  lo = 0;
+  hi = symtab->num_by_offset;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    if (symtab->by_offset[mid]->offset <= offset) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+
+  // Walk back over the symbols that start at or before offset. None that
+  // starts more than max_size before offset can contain it.
+  while (lo-- > 0) {
+    struct elf_symbol* sym = symtab->by_offset[lo];
+    if (offset - sym->offset >= symtab->max_size) {
+      break;
+    }
+    if (offset < sym->offset + sym->size && (best == NULL || sym < best)) {
+      best = sym;
+    }
+  }
+
+  if (best != NULL) {
+    if (poffset) *poffset = (offset - best->offset);
+    return best->name;
   }
   return NULL;
 }
@@ -31,6 +31,7 @@
 #ifdef LINUX
 #include <elf.h>
 #include <link.h>
+#include <sys/mman.h>
 #include "proc_service.h"
 #include "salibelf.h"
 #endif
@@ -94,6 +95,11 @@ static void destroy_map_info(struct ps_prochandle* ph) {
   map_info* map = ph->core->maps;
   while (map) {
     map_info* next = map->next;
+#ifdef LINUX
+    if (map->map_base != NULL) {
+      munmap(map->map_base, map->map_len);
+    }
+#endif
     free(map);
     map = next;
   }
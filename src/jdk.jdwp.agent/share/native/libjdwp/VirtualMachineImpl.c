@@ -33,6 +33,7 @@
 #include "threadControl.h"
 #include "SDE.h"
 #include "FrameID.h"
+#include "classTrack.h"
 
 static char *versionName = "Java Debug Wire Protocol (Reference Implementation)";
 
@@ -132,6 +133,7 @@ classesForSignature(PacketInputStream *in, PacketOutputStream *out)
                 jclass clazz = theClasses[i];
                 jint status = classStatus(clazz);
                 char *candidate_signature = NULL;
+                jboolean owned = JNI_FALSE;
                 jint wanted =
                     (JVMTI_CLASS_STATUS_PREPARED|JVMTI_CLASS_STATUS_ARRAY|
                      JVMTI_CLASS_STATUS_PRIMITIVE);
@@ -141,15 +143,23 @@ classesForSignature(PacketInputStream *in, PacketOutputStream *out)
                     continue;
                 }
 
-                error = classSignature(clazz, &candidate_signature, NULL);
-                if (error != JVMTI_ERROR_NONE) {
-                  // Clazz become invalid since the time we get the class list
-                  // Skip this entry
-                  if (error == JVMTI_ERROR_INVALID_CLASS) {
-                    continue;
-                  }
-
-                  break;
+                /* Prepared classes have their signature recorded by
+                 * class tracking, which saves a GetClassSignature
+                 * call and a string copy for every loaded class.
+                 */
+                candidate_signature = classTrack_getSignature(clazz);
+                if (candidate_signature == NULL) {
+                    error = classSignature(clazz, &candidate_signature, NULL);
+                    if (error != JVMTI_ERROR_NONE) {
+                      // Clazz become invalid since the time we get the class list
+                      // Skip this entry
+                      if (error == JVMTI_ERROR_INVALID_CLASS) {
+                        continue;
+                      }
+
+                      break;
+                    }
+                    owned = JNI_TRUE;
                 }
 
                 if (strcmp(candidate_signature, signature) == 0) {
@@ -160,7 +170,9 @@ classesForSignature(PacketInputStream *in, PacketOutputStream *out)
                     theClasses[i] = theClasses[matchCount];
                     theClasses[matchCount++] = clazz;
                 }
-                jvmtiDeallocate(candidate_signature);
+                if (owned) {
+                    jvmtiDeallocate(candidate_signature);
+                }
             }
 
             /* At this point matching prepared classes occupy
@@ -83,6 +83,22 @@ classTrack_addPreparedClass(JNIEnv *env_unused, jclass klass)
     }
 }
 
+char *
+classTrack_getSignature(jclass klass)
+{
+    jlong tag = NOT_TAGGED;
+    jvmtiError error;
+
+    if (trackingEnv == NULL) {
+        return NULL;
+    }
+    error = JVMTI_FUNC_PTR(trackingEnv, GetTag)(trackingEnv, klass, &tag);
+    if (error != JVMTI_ERROR_NONE || tag == NOT_TAGGED) {
+        return NULL;
+    }
+    return (char*)jlong_to_ptr(tag);
+}
+
 static jboolean
 setupEvents()
 {
@@ -39,6 +39,14 @@ classTrack_processUnloads(JNIEnv *env);
 void
 classTrack_addPreparedClass(JNIEnv *env, jclass klass);
 
+/*
+ * Return the signature recorded for a prepared class, or NULL if the
+ * class is not tracked. The string is owned by class tracking and stays
+ * valid while the caller holds a reference to the class.
+ */
+char *
+classTrack_getSignature(jclass klass);
+
 /*
  * Initialize class tracking.
  */
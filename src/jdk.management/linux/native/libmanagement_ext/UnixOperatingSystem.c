@@ -36,14 +36,18 @@
 #include <dlfcn.h>
 #include <pthread.h>
 #include <inttypes.h>
+#include <time.h>
+#include "jni_util.h"
 #include "com_sun_management_internal_OperatingSystemImpl.h"
 
-#include <assert.h>
-
 struct ticks {
     uint64_t  used;
     uint64_t  usedKernel;
     uint64_t  total;
+    // Load computed at the last sample, reused within the sampling interval
+    uint64_t  sampledAt;
+    double    userLoad;
+    double    kernelLoad;
 };
 
 typedef struct ticks ticks;
@@ -62,6 +66,15 @@ static struct perfbuf {
 
 #define DEC_64 "%"SCNd64
 #define NS_PER_SEC 1000000000
+#define NS_PER_MS  1000000
+
+/**
+ * Minimum time between two reads of /proc for the same load value, set
+ * in milliseconds by the jdk.management.cpuLoadSamplingInterval property.
+ * Calls made within the interval return the load cached by the previous
+ * sample; 0 (the default) samples on every call. Negative until read.
+ */
+static int64_t samplingInterval = -1;
 
 static int next_line(FILE *f) {
     int c;
@@ -246,6 +259,49 @@ int perfInit() {
 
 static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
 
+static void init_sampling_interval(JNIEnv *env) {
+    int64_t interval = 0;
+    jstring name;
+    jstring value = NULL;
+
+    if (samplingInterval >= 0) {
+        return;
+    }
+
+    name = (*env)->NewStringUTF(env, "jdk.management.cpuLoadSamplingInterval");
+    if (name != NULL) {
+        value = JNU_CallStaticMethodByName(env, NULL, "java/lang/System",
+            "getProperty", "(Ljava/lang/String;)Ljava/lang/String;", name).l;
+        (*env)->DeleteLocalRef(env, name);
+    }
+    if ((*env)->ExceptionCheck(env)) {
+        // Keep sampling on every call rather than fail the load query
+        (*env)->ExceptionClear(env);
+    } else if (value != NULL) {
+        const char *chars = (*env)->GetStringUTFChars(env, value, NULL);
+        if (chars != NULL) {
+            char *end;
+            long long ms = strtoll(chars, &end, 10);
+            if (end != chars && *end == '\0' && ms > 0 && ms <= INT32_MAX) {
+                interval = (int64_t)ms * NS_PER_MS;
+            }
+            (*env)->ReleaseStringUTFChars(env, value, chars);
+        }
+    }
+    if (value != NULL) {
+        (*env)->DeleteLocalRef(env, value);
+    }
+    samplingInterval = interval;
+}
+
+static uint64_t now_nanos() {
+    struct timespec ts;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+        return 0;
+    }
+    return (uint64_t)ts.tv_sec * NS_PER_SEC + (uint64_t)ts.tv_nsec;
+}
+
 /**
  * Return the load of the CPU as a double. 1.0 means the CPU process uses all
  * available time for user or system processes, 0.0 means the CPU uses all time
@@ -259,6 +315,7 @@ static double get_cpuload_internal(int which, double *pkernelLoad, CpuLoadTarget
     ticks *pticks, tmp;
     double user_load = -1.0;
     int failed = 0;
+    uint64_t now = 0;
 
     *pkernelLoad = 0.0;
 
@@ -274,6 +331,19 @@ static double get_cpuload_internal(int which, double *pkernelLoad, CpuLoadTarget
             pticks = &counters.cpus[which];
         }
 
+        if (samplingInterval > 0) {
+            now = now_nanos();
+            // A clock that went backwards (e.g. after a CRaC restore on
+            // another host) invalidates the cached sample.
+            if (pticks->sampledAt != 0 && now >= pticks->sampledAt &&
+                now - pticks->sampledAt < (uint64_t)samplingInterval) {
+                *pkernelLoad = pticks->kernelLoad;
+                user_load = pticks->userLoad;
+                pthread_mutex_unlock(&lock);
+                return user_load;
+            }
+        }
+
         tmp = *pticks;
 
         if (target == CPU_LOAD_VM_ONLY) {
@@ -286,12 +356,14 @@ static double get_cpuload_internal(int which, double *pkernelLoad, CpuLoadTarget
 
         if (!failed) {
 
-            assert(pticks->usedKernel >= tmp.usedKernel);
             kdiff = pticks->usedKernel - tmp.usedKernel;
             tdiff = pticks->total - tmp.total;
             udiff = pticks->used - tmp.used;
 
-            if (tdiff == 0) {
+            if (tdiff == 0 || pticks->usedKernel < tmp.usedKernel ||
+                pticks->used < tmp.used || pticks->total < tmp.total) {
+                // Counters going backwards mean a new process or boot, as
+                // after a CRaC restore; the new ticks become the baseline.
                 user_load = 0;
             } else {
                 if (tdiff < (udiff + kdiff)) {
@@ -306,6 +378,9 @@ static double get_cpuload_internal(int which, double *pkernelLoad, CpuLoadTarget
                 user_load = MAX(user_load, 0.0);
                 user_load = MIN(user_load, 1.0);
             }
+            pticks->sampledAt = now;
+            pticks->userLoad = user_load;
+            pticks->kernelLoad = *pkernelLoad;
         }
     }
     pthread_mutex_unlock(&lock);
@@ -335,6 +410,7 @@ JNIEXPORT jdouble JNICALL
 Java_com_sun_management_internal_OperatingSystemImpl_getCpuLoad0
 (JNIEnv *env, jobject dummy)
 {
+    init_sampling_interval(env);
     if (perfInit() == 0) {
         return get_cpu_load(-1);
     } else {
@@ -346,6 +422,7 @@ JNIEXPORT jdouble JNICALL
 Java_com_sun_management_internal_OperatingSystemImpl_getProcessCpuLoad0
 (JNIEnv *env, jobject dummy)
 {
+    init_sampling_interval(env);
     if (perfInit() == 0) {
         return get_process_load();
     } else {
@@ -357,6 +434,7 @@ JNIEXPORT jdouble JNICALL
 Java_com_sun_management_internal_OperatingSystemImpl_getSingleCpuLoad0
 (JNIEnv *env, jobject mbean, jint cpu_number)
 {
+    init_sampling_interval(env);
     if (perfInit() == 0 && cpu_number >= 0 && cpu_number < counters.nProcs) {
         return get_cpu_load(cpu_number);
     } else {
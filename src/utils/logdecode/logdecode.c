@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * Prints a log file written with -Xlog:...:file=<name>::format=binary as
+ * text, one line per message with the decorations that were recorded:
+ *
+ *   logdecode <file>...
+ *
+ * See LogFileStreamOutput in src/hotspot/share/logging for the format.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+enum { FormatRecord, TagSetRecord, MessageRecord };
+
+#define MAX_TAGSETS 65536
+#define MESSAGE_HEADER_SIZE (3 * 8 + 2 + 1)
+
+static const char* levels[] = { "off", "trace", "debug", "info", "warning", "error" };
+static char* tagsets[MAX_TAGSETS];
+
+static void print_message(const unsigned char* p, size_t len) {
+  int64_t millis, uptime_nanos, tid;
+  uint16_t tagset;
+  uint8_t level;
+  memcpy(&millis, p, 8);
+  memcpy(&uptime_nanos, p + 8, 8);
+  memcpy(&tid, p + 16, 8);
+  memcpy(&tagset, p + 24, 2);
+  level = p[26];
+
+  if (millis != 0) {
+    time_t seconds = (time_t)(millis / 1000);
+    struct tm tm;
+    char buf[32];
+    localtime_r(&seconds, &tm);
+    strftime(buf, sizeof(buf), "%Y-%m-%dT%H:%M:%S", &tm);
+    printf("[%s.%03d]", buf, (int)(millis % 1000));
+  }
+  if (uptime_nanos != 0) {
+    printf("[%.3fs]", uptime_nanos / 1e9);
+  }
+  if (tid != 0) {
+    printf("[%" PRId64 "]", tid);
+  }
+  printf("[%s][%s] ",
+         level < sizeof(levels) / sizeof(levels[0]) ? levels[level] : "?",
+         tagsets[tagset] != NULL ? tagsets[tagset] : "?");
+  fwrite(p + MESSAGE_HEADER_SIZE, 1, len - MESSAGE_HEADER_SIZE, stdout);
+  putchar('\n');
+}
+
+static int decode(const char* name, FILE* f) {
+  unsigned char* buf = NULL;
+  size_t buf_size = 0;
+  uint32_t len;
+  int native_order = 0;
+
+  while (fread(&len, sizeof(len), 1, f) == 1) {
+    if (len == 0) {
+      fprintf(stderr, "%s: empty record\n", name);
+      return 1;
+    }
+    if (len > buf_size) {
+      buf_size = len;
+      buf = realloc(buf, buf_size + 1);
+      if (buf == NULL) {
+        fprintf(stderr, "%s: out of memory\n", name);
+        return 1;
+      }
+    }
+    if (fread(buf, len, 1, f) != 1) {
+      fprintf(stderr, "%s: truncated record\n", name);
+      break;
+    }
+    const unsigned char* payload = buf + 1;
+    size_t payload_len = len - 1;
+
+    switch (buf[0]) {
+    case FormatRecord: {
+      uint16_t version, order;
+      if (payload_len < 4) {
+        fprintf(stderr, "%s: bad format record\n", name);
+        return 1;
+      }
+      memcpy(&version, payload, 2);
+      memcpy(&order, payload + 2, 2);
+      if (order != 0x0102) {
+        fprintf(stderr, "%s: written with a different byte order\n", name);
+        return 1;
+      }
+      if (version != 1) {
+        fprintf(stderr, "%s: unsupported version %u\n", name, version);
+        return 1;
+      }
+      native_order = 1;
+      break;
+    }
+    case TagSetRecord: {
+      uint16_t id;
+      if (payload_len < 2) {
+        fprintf(stderr, "%s: bad tagset record\n", name);
+        return 1;
+      }
+      memcpy(&id, payload, 2);
+      free(tagsets[id]);
+      tagsets[id] = malloc(payload_len - 2 + 1);
+      if (tagsets[id] != NULL) {
+        memcpy(tagsets[id], payload + 2, payload_len - 2);
+        tagsets[id][payload_len - 2] = '\0';
+      }
+      break;
+    }
+    case MessageRecord:
+      if (!native_order || payload_len < MESSAGE_HEADER_SIZE) {
+        fprintf(stderr, "%s: bad message record\n", name);
+        return 1;
+      }
+      print_message(payload, payload_len);
+      break;
+    default:
+      // Skip records of later versions
+      break;
+    }
+  }
+  free(buf);
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  int result = 0;
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s <file>...\n", argv[0]);
+    return 2;
+  }
+  for (int i = 1; i < argc; i++) {
+    FILE* f = fopen(argv[i], "rb");
+    if (f == NULL) {
+      perror(argv[i]);
+      result = 1;
+      continue;
+    }
+    result |= decode(argv[i], f);
+    fclose(f);
+  }
+  return result;
+}
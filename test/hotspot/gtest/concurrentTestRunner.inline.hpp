@@ -25,8 +25,10 @@
 #define GTEST_CONCURRENT_TEST_RUNNER_INLINE_HPP
 
 #include "memory/allocation.hpp"
+#include "runtime/atomic.hpp"
 #include "runtime/semaphore.hpp"
 #include "runtime/thread.inline.hpp"
+#include "utilities/ostream.hpp"
 #include "threadHelper.inline.hpp"
 
 // This file contains helper classes to run unit tests concurrently in multiple threads.
@@ -43,19 +45,27 @@ public:
   // runnableArg - what to run
   // doneArg - a semaphore to notify when the thread is done running
   // testDurationArg - how long to run (in milliseconds)
-  UnitTestThread(TestRunnable* const runnableArg, Semaphore* doneArg, const long testDurationArg) :
-    JavaTestThread(doneArg), runnable(runnableArg), testDuration(testDurationArg) {}
+  // iterationsArg - where to add the number of runs when done, if not NULL
+  UnitTestThread(TestRunnable* const runnableArg, Semaphore* doneArg, const long testDurationArg,
+                 volatile size_t* iterationsArg = NULL) :
+    JavaTestThread(doneArg), runnable(runnableArg), testDuration(testDurationArg), iterations(iterationsArg) {}
 
   // from JavaTestThread
   void main_run() {
     long stopTime = os::javaTimeMillis() + testDuration;
+    size_t n = 0;
     while (os::javaTimeMillis() < stopTime) {
       runnable->runUnitTest();
+      n++;
+    }
+    if (iterations != NULL) {
+      Atomic::add(iterations, n);
     }
   }
 private:
   TestRunnable* const runnable;
   const long testDuration;
+  volatile size_t* const iterations;
 };
 
 // Helper class for running a given unit test concurrently in multiple threads.
@@ -69,13 +79,15 @@ public:
     nrOfThreads(nrOfThreadsArg),
     testDurationMillis(testDurationMillisArg) {}
 
-  void run() {
+  // Returns how many times the runnable ran in all threads together.
+  size_t run() {
     Semaphore done(0);
+    volatile size_t iterations = 0;
 
     UnitTestThread** t = NEW_C_HEAP_ARRAY(UnitTestThread*, nrOfThreads, mtInternal);
 
     for (int i = 0; i < nrOfThreads; i++) {
-      t[i] = new UnitTestThread(unitTestRunnable, &done, testDurationMillis);
+      t[i] = new UnitTestThread(unitTestRunnable, &done, testDurationMillis, &iterations);
     }
 
     for (int i = 0; i < nrOfThreads; i++) {
@@ -87,6 +99,7 @@ public:
     }
 
     FREE_C_HEAP_ARRAY(UnitTestThread**, t);
+    return Atomic::load(&iterations);
   }
 
 private:
@@ -95,4 +108,34 @@ private:
   const long testDurationMillis;
 };
 
+// Helper class for measuring the throughput of a unit test runnable with
+// 1, 2, 4, ... up to a maximum number of threads. Benchmarks are slow and
+// their results are only printed, so tests using this are DISABLED_ and run
+// with --gtest_also_run_disabled_tests.
+class ConcurrentBenchmarkRunner {
+public:
+  // name - printed with the results
+  // runnableArg - what to run
+  // opsPerRunArg - how many operations one runUnitTest() call does
+  ConcurrentBenchmarkRunner(const char* nameArg, TestRunnable* const runnableArg, int opsPerRunArg) :
+    name(nameArg), unitTestRunnable(runnableArg), opsPerRun(opsPerRunArg) {}
+
+  // Prints one "<name> threads=<n> ops/s=<ops>" line per thread count.
+  void run(int maxThreads, long testDurationMillis) {
+    for (int threads = 1; ; threads = MIN2(threads * 2, maxThreads)) {
+      ConcurrentTestRunner runner(unitTestRunnable, threads, testDurationMillis);
+      size_t ops = runner.run() * opsPerRun;
+      tty->print_cr("%s threads=%d ops/s=" SIZE_FORMAT, name, threads, ops * 1000 / testDurationMillis);
+      if (threads == maxThreads) {
+        break;
+      }
+    }
+  }
+
+private:
+  const char* const name;
+  TestRunnable* const unitTestRunnable;
+  const int opsPerRun;
+};
+
 #endif // GTEST_CONCURRENT_TEST_RUNNER_INLINE_HPP
@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/vmClasses.hpp"
+#include "gc/shared/oopStorage.inline.hpp"
+#include "gc/shared/taskqueue.inline.hpp"
+#include "memory/allocation.inline.hpp"
+#include "memory/universe.hpp"
+#include "oops/instanceKlass.hpp"
+#include "oops/oopHandle.inline.hpp"
+#include "runtime/atomic.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/interfaceSupport.inline.hpp"
+#include "runtime/mutex.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/synchronizer.hpp"
+#include "utilities/concurrentHashTable.inline.hpp"
+#include "utilities/globalCounter.inline.hpp"
+#include "utilities/lockFreeStack.hpp"
+#include "concurrentTestRunner.inline.hpp"
+#include "unittest.hpp"
+
+// Throughput of runtime synchronization primitives and concurrent data
+// structures with an increasing number of threads, as a baseline for
+// changes to them. The tests only print their results, run them with
+//   --gtest_filter='ConcurrentBenchmark.*' --gtest_also_run_disabled_tests
+
+static const long benchmark_duration_ms = 1000;
+static const int ops_per_run = 64;
+static const int benchmark_threads_limit = 32;
+
+static int benchmark_max_threads() {
+  return MAX2(1, MIN2(os::active_processor_count(), benchmark_threads_limit));
+}
+
+static void run_benchmark(const char* name, TestRunnable* runnable, int ops = ops_per_run) {
+  ConcurrentBenchmarkRunner runner(name, runnable, ops);
+  runner.run(benchmark_max_threads(), benchmark_duration_ms);
+}
+
+// Lock and unlock of one Mutex shared by all threads
+class MutexBenchmark : public TestRunnable {
+  Mutex* const _lock;
+public:
+  MutexBenchmark(Mutex* lock) : _lock(lock) {}
+
+  void runUnitTest() const {
+    for (int i = 0; i < ops_per_run; i++) {
+      MutexLocker ml(_lock, Mutex::_no_safepoint_check_flag);
+    }
+  }
+};
+
+TEST_VM(ConcurrentBenchmark, DISABLED_mutex) {
+  Mutex* lock = new Mutex(Mutex::leaf, "ConcurrentBenchmark_lock", false, Mutex::_safepoint_check_never);
+  MutexBenchmark benchmark(lock);
+  run_benchmark("Mutex", &benchmark);
+  delete lock;
+}
+
+// Java monitor enter and exit of one object shared by all threads, which
+// inflates to an ObjectMonitor once contended
+class ObjectMonitorBenchmark : public TestRunnable {
+  const OopHandle _obj;
+public:
+  ObjectMonitorBenchmark(OopHandle obj) : _obj(obj) {}
+
+  void runUnitTest() const {
+    JavaThread* current = JavaThread::current();
+    HandleMark hm(current);
+    Handle h(current, _obj.resolve());
+    for (int i = 0; i < ops_per_run; i++) {
+      ObjectLocker ol(h, current);
+    }
+  }
+};
+
+TEST_VM(ConcurrentBenchmark, DISABLED_object_monitor) {
+  JavaThread* THREAD = JavaThread::current();
+  OopHandle obj;
+  {
+    ThreadInVMfromNative invm(THREAD);
+    oop o = vmClasses::Object_klass()->allocate_instance(THREAD);
+    ASSERT_FALSE(HAS_PENDING_EXCEPTION);
+    obj = OopHandle(Universe::vm_global(), o);
+  }
+  ObjectMonitorBenchmark benchmark(obj);
+  run_benchmark("ObjectMonitor", &benchmark);
+  obj.release(Universe::vm_global());
+}
+
+// GlobalCounter read-side critical sections
+class GlobalCounterBenchmark : public TestRunnable {
+public:
+  void runUnitTest() const {
+    Thread* current = Thread::current();
+    for (int i = 0; i < ops_per_run; i++) {
+      GlobalCounter::CriticalSection cs(current);
+    }
+  }
+};
+
+TEST_VM(ConcurrentBenchmark, DISABLED_global_counter) {
+  GlobalCounterBenchmark benchmark;
+  run_benchmark("GlobalCounter", &benchmark);
+}
+
+class BenchmarkStackElement {
+  BenchmarkStackElement* volatile _next;
+
+  static BenchmarkStackElement* volatile* next_ptr(BenchmarkStackElement& e) { return &e._next; }
+
+public:
+  BenchmarkStackElement() : _next(NULL) {}
+
+  typedef LockFreeStack<BenchmarkStackElement, &next_ptr> Stack;
+};
+
+// Pops and pushes on one LockFreeStack. As pop() is subject to ABA, pops
+// are done in GlobalCounter critical sections and the popped elements are
+// pushed back only after a write_synchronize(), as the VM's users do.
+class LockFreeStackBenchmark : public TestRunnable {
+  BenchmarkStackElement::Stack* const _stack;
+public:
+  LockFreeStackBenchmark(BenchmarkStackElement::Stack* stack) : _stack(stack) {}
+
+  void runUnitTest() const {
+    Thread* current = Thread::current();
+    BenchmarkStackElement* popped[ops_per_run];
+    int n = 0;
+    for (int i = 0; i < ops_per_run; i++) {
+      GlobalCounter::CriticalSection cs(current);
+      BenchmarkStackElement* e = _stack->pop();
+      if (e != NULL) {
+        popped[n++] = e;
+      }
+    }
+    GlobalCounter::write_synchronize();
+    for (int i = 0; i < n; i++) {
+      _stack->push(*popped[i]);
+    }
+  }
+};
+
+TEST_VM(ConcurrentBenchmark, DISABLED_lock_free_stack) {
+  const int nelements = benchmark_threads_limit * ops_per_run;
+  BenchmarkStackElement* elements = new BenchmarkStackElement[nelements];
+  BenchmarkStackElement::Stack stack;
+  for (int i = 0; i < nelements; i++) {
+    stack.push(elements[i]);
+  }
+  LockFreeStackBenchmark benchmark(&stack);
+  run_benchmark("LockFreeStack", &benchmark, 2 * ops_per_run);
+  while (stack.pop() != NULL) {}
+  delete[] elements;
+}
+
+struct BenchmarkTableConfig : public AllStatic {
+  typedef uintptr_t Value;
+  static uintx get_hash(const Value& value, bool* dead_hash) {
+    return (uintx)value;
+  }
+  static void* allocate_node(void* context, size_t size, const Value& value) {
+    return AllocateHeap(size, mtInternal);
+  }
+  static void free_node(void* context, void* memory, const Value& value) {
+    FreeHeap(memory);
+  }
+};
+
+typedef ConcurrentHashTable<BenchmarkTableConfig, mtInternal> BenchmarkTable;
+
+struct BenchmarkTableLookup {
+  uintptr_t _value;
+  BenchmarkTableLookup(uintptr_t value) : _value(value) {}
+  uintx get_hash() { return _value; }
+  bool equals(const uintptr_t* value) { return _value == *value; }
+};
+
+struct BenchmarkTableGet {
+  void operator()(uintptr_t* value) {}
+};
+
+static const uintptr_t benchmark_table_entries = 4096;
+
+// Lookups of existing keys in a ConcurrentHashTable, one in sixteen
+// replaced by the insert and remove of a key unique to the thread
+class ConcurrentHashTableBenchmark : public TestRunnable {
+  BenchmarkTable* const _table;
+public:
+  ConcurrentHashTableBenchmark(BenchmarkTable* table) : _table(table) {}
+
+  void runUnitTest() const {
+    Thread* current = Thread::current();
+    uintptr_t own_key = benchmark_table_entries + 1 + (uintptr_t)current;
+    uintptr_t key = (uintptr_t)(uint)os::random() % benchmark_table_entries;
+    for (int i = 0; i < ops_per_run; i++) {
+      if (i % 16 == 0) {
+        BenchmarkTableLookup lookup(own_key);
+        _table->insert(current, lookup, own_key);
+        _table->remove(current, lookup);
+      } else {
+        BenchmarkTableLookup lookup(key + 1);
+        BenchmarkTableGet get;
+        _table->get(current, lookup, get);
+        key = (key + 7) % benchmark_table_entries;
+      }
+    }
+  }
+};
+
+TEST_VM(ConcurrentBenchmark, DISABLED_concurrent_hash_table) {
+  Thread* current = Thread::current();
+  BenchmarkTable* table = new BenchmarkTable(12);
+  for (uintptr_t v = 1; v <= benchmark_table_entries; v++) {
+    BenchmarkTableLookup lookup(v);
+    table->insert(current, lookup, v);
+  }
+  ConcurrentHashTableBenchmark benchmark(table);
+  run_benchmark("ConcurrentHashTable", &benchmark);
+  delete table;
+}
+
+// Allocation and release of entries in one OopStorage
+class OopStorageBenchmark : public TestRunnable {
+  OopStorage* const _storage;
+public:
+  OopStorageBenchmark(OopStorage* storage) : _storage(storage) {}
+
+  void runUnitTest() const {
+    for (int i = 0; i < ops_per_run; i++) {
+      oop* p = _storage->allocate();
+      if (p != NULL) {
+        _storage->release(p);
+      }
+    }
+  }
+};
+
+TEST_VM(ConcurrentBenchmark, DISABLED_oop_storage) {
+  OopStorage* storage = new OopStorage("ConcurrentBenchmark storage", mtInternal);
+  OopStorageBenchmark benchmark(storage);
+  run_benchmark("OopStorage", &benchmark);
+  delete storage;
+}
+
+typedef GenericTaskQueue<size_t, mtInternal> BenchmarkTaskQueue;
+typedef GenericTaskQueueSet<BenchmarkTaskQueue, mtInternal> BenchmarkTaskQueueSet;
+
+// Each thread owns a queue. Consecutive tickets give the threads of one
+// run distinct queues.
+static volatile uint _task_queue_ticket = 0;
+static THREAD_LOCAL uint _task_queue_id = 0;
+
+// Pushes and local pops on the thread's own GC task queue mixed with
+// steals from the others, as done by GC workers
+class TaskQueueBenchmark : public TestRunnable {
+  BenchmarkTaskQueueSet* const _queues;
+public:
+  TaskQueueBenchmark(BenchmarkTaskQueueSet* queues) : _queues(queues) {}
+
+  void runUnitTest() const {
+    if (_task_queue_id == 0) {
+      _task_queue_id = Atomic::add(&_task_queue_ticket, 1u) % _queues->size() + 1;
+    }
+    uint id = _task_queue_id - 1;
+    BenchmarkTaskQueue* queue = _queues->queue(id);
+    size_t task;
+    for (int i = 0; i < ops_per_run; i++) {
+      if (!queue->push(i) || !queue->push(i)) {
+        queue->pop_local(task);
+      }
+      queue->pop_local(task);
+      if (!_queues->steal(id, task)) {
+        queue->pop_local(task);
+      }
+    }
+  }
+};
+
+TEST_VM(ConcurrentBenchmark, DISABLED_task_queue) {
+  const uint nqueues = (uint)benchmark_max_threads();
+  BenchmarkTaskQueueSet* queues = new BenchmarkTaskQueueSet(nqueues);
+  for (uint i = 0; i < nqueues; i++) {
+    BenchmarkTaskQueue* queue = new BenchmarkTaskQueue();
+    queue->initialize();
+    queues->register_queue(i, queue);
+  }
+  TaskQueueBenchmark benchmark(queues);
+  run_benchmark("TaskQueue", &benchmark);
+  for (uint i = 0; i < nqueues; i++) {
+    delete queues->queue(i);
+  }
+  delete queues;
+}
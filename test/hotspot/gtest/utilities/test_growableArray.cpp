@@ -555,3 +555,27 @@ TEST(GrowableArrayCHeap, sanity) {
     delete a;
   }
 }
+
+TEST_VM(GrowableArrayWithInline, sanity) {
+  ResourceMark rm;
+  GrowableArrayWithInline<int, 4> a;
+  ASSERT_TRUE(a.is_empty());
+  ASSERT_EQ(a.max_length(), 4);
+
+  // Fills the inline elements
+  const int* inline_data = a.adr_at(0);
+  for (int i = 0; i < 4; i++) {
+    a.append(i);
+  }
+  ASSERT_EQ(a.adr_at(0), inline_data);
+
+  // Spills into the resource area
+  for (int i = 4; i < 10; i++) {
+    a.append(i);
+  }
+  ASSERT_NE(a.adr_at(0), inline_data);
+  ASSERT_EQ(a.length(), 10);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(a.at(i), i);
+  }
+}
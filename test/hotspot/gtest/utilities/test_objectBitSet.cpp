@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "memory/allocation.hpp"
+#include "utilities/objectBitSet.inline.hpp"
+#include "unittest.hpp"
+
+TEST_VM(ObjectBitSet, empty) {
+  ObjectBitSet<mtServiceability> obs;
+  uintptr_t addr = (uintptr_t)16 * M;
+  ASSERT_FALSE(obs.is_marked(addr));
+}
+
+TEST_VM(ObjectBitSet, mark_single) {
+  ObjectBitSet<mtServiceability> obs;
+  uintptr_t addr = (uintptr_t)16 * M;
+  obs.mark_obj(addr);
+  ASSERT_TRUE(obs.is_marked(addr));
+  ASSERT_FALSE(obs.is_marked(addr + MinObjAlignmentInBytes));
+  ASSERT_FALSE(obs.is_marked(addr - MinObjAlignmentInBytes));
+}
+
+TEST_VM(ObjectBitSet, mark_fragments) {
+  ObjectBitSet<mtServiceability> obs;
+  // Addresses in different 64M fragments, marked out of order.
+  uintptr_t addr1 = (uintptr_t)512 * M;
+  uintptr_t addr2 = (uintptr_t)64 * M;
+  uintptr_t addr3 = (uintptr_t)1024 * M + MinObjAlignmentInBytes;
+  obs.mark_obj(addr1);
+  obs.mark_obj(addr2);
+  obs.mark_obj(addr3);
+  ASSERT_TRUE(obs.is_marked(addr1));
+  ASSERT_TRUE(obs.is_marked(addr2));
+  ASSERT_TRUE(obs.is_marked(addr3));
+  // The same offset in another fragment is not marked.
+  ASSERT_FALSE(obs.is_marked(addr1 + 64 * M));
+  ASSERT_FALSE(obs.is_marked(addr3 - MinObjAlignmentInBytes));
+}
@@ -287,3 +287,31 @@ TEST_VM_F(GenericResourceHashtableTest, bad_hash_no_rm) {
 TEST_VM_F(GenericResourceHashtableTest, identity_hash_no_rm) {
   Runner<identity_hash, primitive_equals<K>, 1, ResourceObj::C_HEAP>::test(512);
 }
+
+class ResizeableResourceHashtableTest : public CommonResourceHashtableTest {
+};
+
+TEST_VM_F(ResizeableResourceHashtableTest, grow) {
+  ResizeableResourceHashtable<K, V, primitive_hash<K>, primitive_equals<K>,
+                              ResourceObj::C_HEAP, MEM_TYPE> rh(4, 256);
+  ASSERT_EQ(rh.table_size(), 4u);
+
+  bool created;
+  V* first = rh.put_if_absent(as_K(0), 0, &created);
+  ASSERT_TRUE(created);
+  for (uintptr_t i = 1; i < 1024; ++i) {
+    ASSERT_TRUE(rh.put(as_K(i), i));
+  }
+  ASSERT_EQ(rh.table_size(), 256u);
+  ASSERT_EQ(rh.number_of_entries(), 1024);
+
+  // Nodes don't move when the table grows
+  ASSERT_EQ(rh.get(as_K(0)), first);
+
+  EqualityTestIter et;
+  rh.iterate(&et);
+  for (uintptr_t i = 0; i < 1024; ++i) {
+    ASSERT_TRUE(rh.remove(as_K(i)));
+  }
+  ASSERT_EQ(rh.number_of_entries(), 0);
+}
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2023, Azul Systems, Inc. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+package org.openjdk.bench.vm.compiler;
+
+import org.openjdk.jmh.annotations.AuxCounters;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.lang.management.CompilationMXBean;
+import java.lang.management.ManagementFactory;
+import java.lang.management.MemoryPoolMXBean;
+import java.lang.reflect.Method;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Measures JIT compilation throughput and code size.
+ *
+ * Each invocation defines a fresh copy of {@link Workload} in its own class
+ * loader and runs it with -Xcomp, so every workload method is compiled once
+ * per invocation by the compiler selected by the benchmark. The time reported
+ * is dominated by compilation; the auxiliary counters report the compile time
+ * as seen by the VM, the number of compiled methods and the code cache bytes
+ * they use.
+ *
+ * -XX:+CITime makes each fork print the per-phase compiler timers
+ * (Compile::print_timers for C2) when it exits.
+ */
+@BenchmarkMode(Mode.SingleShotTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@State(Scope.Thread)
+@Warmup(iterations = 10)
+@Measurement(iterations = 40)
+public class CompileThroughput {
+
+    static final String WORKLOAD = CompileThroughput.class.getName() + "$Workload";
+
+    byte[] workloadBytes;
+    int workloadMethods;
+
+    @Setup
+    public void setup() throws IOException {
+        String resource = "/" + WORKLOAD.replace('.', '/') + ".class";
+        try (InputStream in = CompileThroughput.class.getResourceAsStream(resource)) {
+            workloadBytes = in.readAllBytes();
+        }
+        workloadMethods = Workload.class.getDeclaredMethods().length +
+                          Workload.class.getDeclaredConstructors().length;
+    }
+
+    @State(Scope.Thread)
+    @AuxCounters(AuxCounters.Type.EVENTS)
+    public static class Counters {
+        public long compiledMethods;
+        public long compileTimeMs;
+        public long codeBytes;
+
+        long startCompileTime;
+        long startCodeBytes;
+
+        @Setup(Level.Invocation)
+        public void start() {
+            startCompileTime = compileTime();
+            startCodeBytes = codeCacheUsed();
+        }
+
+        void stop(int methods) {
+            compiledMethods += methods;
+            compileTimeMs += compileTime() - startCompileTime;
+            codeBytes += Math.max(0, codeCacheUsed() - startCodeBytes);
+        }
+
+        static long compileTime() {
+            CompilationMXBean bean = ManagementFactory.getCompilationMXBean();
+            return bean.isCompilationTimeMonitoringSupported() ? bean.getTotalCompilationTime() : 0;
+        }
+
+        static long codeCacheUsed() {
+            long used = 0;
+            for (MemoryPoolMXBean pool : ManagementFactory.getMemoryPoolMXBeans()) {
+                String name = pool.getName();
+                if (name.startsWith("CodeHeap") || name.equals("CodeCache")) {
+                    used += pool.getUsage().getUsed();
+                }
+            }
+            return used;
+        }
+    }
+
+    @Benchmark
+    @Fork(value = 3, jvmArgsPrepend = { "-XX:TieredStopAtLevel=1" }, jvmArgsAppend = {
+        "-Xcomp",
+        "-XX:CompileCommand=quiet",
+        "-XX:CompileCommand=compileonly,org/openjdk/bench/vm/compiler/CompileThroughput$Workload.*",
+        "-XX:+CITime"
+    })
+    public Object c1(Counters counters) throws Exception {
+        Object result = compileWorkload();
+        counters.stop(workloadMethods);
+        return result;
+    }
+
+    @Benchmark
+    @Fork(value = 3, jvmArgsPrepend = { "-XX:-TieredCompilation" }, jvmArgsAppend = {
+        "-Xcomp",
+        "-XX:CompileCommand=quiet",
+        "-XX:CompileCommand=compileonly,org/openjdk/bench/vm/compiler/CompileThroughput$Workload.*",
+        "-XX:+CITime"
+    })
+    public Object c2(Counters counters) throws Exception {
+        Object result = compileWorkload();
+        counters.stop(workloadMethods);
+        return result;
+    }
+
+    Object compileWorkload() throws Exception {
+        Class<?> c = new WorkloadLoader(workloadBytes).loadClass(WORKLOAD);
+        Method run = c.getDeclaredMethod("run", int.class);
+        run.setAccessible(true);
+        return run.invoke(null, 16);
+    }
+
+    static class WorkloadLoader extends ClassLoader {
+        final byte[] bytes;
+
+        WorkloadLoader(byte[] bytes) {
+            super(CompileThroughput.class.getClassLoader());
+            this.bytes = bytes;
+        }
+
+        @Override
+        protected Class<?> loadClass(String name, boolean resolve) throws ClassNotFoundException {
+            if (name.equals(WORKLOAD)) {
+                synchronized (getClassLoadingLock(name)) {
+                    Class<?> c = findLoadedClass(name);
+                    if (c == null) {
+                        c = defineClass(name, bytes, 0, bytes.length);
+                    }
+                    return c;
+                }
+            }
+            return super.loadClass(name, resolve);
+        }
+    }
+
+    /**
+     * A mix of code shapes found in typical applications: loops over arrays,
+     * string building, collections, virtual calls, switches and exceptions.
+     * Has no nested classes and only depends on java.base so that a fresh
+     * copy can be defined in each invocation.
+     */
+    static class Workload {
+        static int run(int n) {
+            int result = 0;
+            result += sumArray(n);
+            result += buildString(n).length();
+            result += countWords("the quick brown fox jumps over the lazy dog the end");
+            result += totalLength(n);
+            result += dispatch(n);
+            result += parse("12345") + parse("not a number");
+            result += matrix(n);
+            return result;
+        }
+
+        static int sumArray(int n) {
+            int[] a = new int[n * 16];
+            for (int i = 0; i < a.length; i++) {
+                a[i] = i * 31 + (i >>> 3);
+            }
+            int sum = 0;
+            for (int v : a) {
+                sum += v;
+            }
+            return sum;
+        }
+
+        static String buildString(int n) {
+            StringBuilder sb = new StringBuilder();
+            for (int i = 0; i < n; i++) {
+                sb.append(i).append(':').append(Integer.toHexString(i * 7)).append(',');
+            }
+            return sb.toString();
+        }
+
+        static int countWords(String text) {
+            Map<String, Integer> counts = new HashMap<>();
+            for (String word : text.split(" ")) {
+                counts.merge(word, 1, Integer::sum);
+            }
+            return counts.getOrDefault("the", 0);
+        }
+
+        static int totalLength(int n) {
+            List<CharSequence> seqs = new ArrayList<>();
+            for (int i = 0; i < n; i++) {
+                seqs.add((i & 1) == 0 ? String.valueOf(i) : new StringBuilder().append(i).reverse());
+            }
+            int total = 0;
+            for (CharSequence s : seqs) {
+                total += s.length() + s.charAt(0);
+            }
+            return total;
+        }
+
+        static int dispatch(int n) {
+            int r = 0;
+            for (int i = 0; i < n; i++) {
+                switch (i % 6) {
+                    case 0 -> r += i;
+                    case 1 -> r -= i;
+                    case 2 -> r ^= i;
+                    case 3 -> r |= i;
+                    case 4 -> r *= 3;
+                    default -> r >>= 1;
+                }
+            }
+            return r;
+        }
+
+        static int parse(String s) {
+            try {
+                return Integer.parseInt(s);
+            } catch (NumberFormatException e) {
+                return -1;
+            }
+        }
+
+        static int matrix(int n) {
+            long[][] m = new long[n][n];
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    m[i][j] = (long) i * j;
+                }
+            }
+            long trace = 0;
+            for (int i = 0; i < n; i++) {
+                trace += m[i][i];
+            }
+            return (int) trace;
+        }
+    }
+}